@@ -16,6 +16,12 @@ endmacro()
 # ## Add all required libraries and dependencies to the given target so it has access to all available renderers.
 # #####################################
 function(ez_add_renderers TARGET_NAME)
+	# The null renderer has no dependencies and is available on all platforms.
+	target_link_libraries(${TARGET_NAME}
+		PRIVATE
+		RendererNull
+	)
+
 	# PLATFORM-TODO
 	if(EZ_BUILD_EXPERIMENTAL_VULKAN)
 		target_link_libraries(${TARGET_NAME}
@@ -48,6 +48,68 @@ void ezPrefabResource::InstantiatePrefab(ezWorld& ref_world, const ezTransform&
   }
 }
 
+void ezPrefabResource::InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues)
+{
+  if (GetLoadingState() != ezResourceState::Loaded || rootTransforms.IsEmpty())
+    return;
+
+  if (pExposedParamValues != nullptr && !pExposedParamValues->IsEmpty())
+  {
+    ezDynamicArray<ezGameObject*> createdRootObjects;
+    ezDynamicArray<ezGameObject*> createdChildObjects;
+
+    if (options.m_pCreatedRootObjectsOut == nullptr)
+    {
+      options.m_pCreatedRootObjectsOut = &createdRootObjects;
+    }
+
+    if (options.m_pCreatedChildObjectsOut == nullptr)
+    {
+      options.m_pCreatedChildObjectsOut = &createdChildObjects;
+    }
+
+    EZ_ASSERT_DEBUG(options.m_pCreatedRootObjectsOut != options.m_pCreatedChildObjectsOut, "These pointers must point to different arrays, otherwise applying exposed properties doesn't work correctly.");
+
+    const ezUInt32 uiFirstRootObject = options.m_pCreatedRootObjectsOut->GetCount();
+    const ezUInt32 uiFirstChildObject = options.m_pCreatedChildObjectsOut->GetCount();
+
+    m_WorldReader.InstantiatePrefabs(ref_world, rootTransforms, options);
+
+    // every copy appended the same number of objects
+    const ezUInt32 uiNumRootObjects = (options.m_pCreatedRootObjectsOut->GetCount() - uiFirstRootObject) / rootTransforms.GetCount();
+    const ezUInt32 uiNumChildObjects = (options.m_pCreatedChildObjectsOut->GetCount() - uiFirstChildObject) / rootTransforms.GetCount();
+
+    for (ezUInt32 i = 0; i < rootTransforms.GetCount(); ++i)
+    {
+      ApplyExposedParameterValues(pExposedParamValues,
+        options.m_pCreatedChildObjectsOut->GetArrayPtr().GetSubArray(uiFirstChildObject + i * uiNumChildObjects, uiNumChildObjects),
+        options.m_pCreatedRootObjectsOut->GetArrayPtr().GetSubArray(uiFirstRootObject + i * uiNumRootObjects, uiNumRootObjects));
+    }
+  }
+  else
+  {
+    m_WorldReader.InstantiatePrefabs(ref_world, rootTransforms, options);
+  }
+}
+
+ezPrefabResource::InstantiateResult ezPrefabResource::InstantiatePrefabs(const ezPrefabResourceHandle& hPrefab, bool bBlockTillLoaded, ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions options /*= {}*/, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues /*= nullptr*/)
+{
+  ezResourceLock<ezPrefabResource> pPrefab(hPrefab, bBlockTillLoaded ? ezResourceAcquireMode::BlockTillLoaded_NeverFail : ezResourceAcquireMode::AllowLoadingFallback_NeverFail);
+
+  switch (pPrefab.GetAcquireResult())
+  {
+    case ezResourceAcquireResult::Final:
+      pPrefab->InstantiatePrefabs(ref_world, rootTransforms, options, pExposedParamValues);
+      return InstantiateResult::Success;
+
+    case ezResourceAcquireResult::LoadingFallback:
+      return InstantiateResult::NotYetLoaded;
+
+    default:
+      return InstantiateResult::Error;
+  }
+}
+
 ezPrefabResource::InstantiateResult ezPrefabResource::InstantiatePrefab(const ezPrefabResourceHandle& hPrefab, bool bBlockTillLoaded, ezWorld& ref_world, const ezTransform& rootTransform, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues /*= nullptr*/)
 {
   ezResourceLock<ezPrefabResource> pPrefab(hPrefab, bBlockTillLoaded ? ezResourceAcquireMode::BlockTillLoaded_NeverFail : ezResourceAcquireMode::AllowLoadingFallback_NeverFail);
@@ -66,7 +128,7 @@ ezPrefabResource::InstantiateResult ezPrefabResource::InstantiatePrefab(const ez
   }
 }
 
-void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezDynamicArray<ezGameObject*>& createdChildObjects, const ezDynamicArray<ezGameObject*>& createdRootObjects) const
+void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, ezArrayPtr<ezGameObject* const> createdChildObjects, ezArrayPtr<ezGameObject* const> createdRootObjects) const
 {
   const ezUInt32 uiNumParamDescs = m_PrefabParamDescs.GetCount();
 
@@ -43,10 +43,19 @@ public:
   /// \brief Helper function to instantiate a prefab without having to deal with resource acquisition.
   static ezPrefabResource::InstantiateResult InstantiatePrefab(const ezPrefabResourceHandle& hPrefab, bool bBlockTillLoaded, ezWorld& ref_world, const ezTransform& rootTransform, ezPrefabInstantiationOptions options = {}, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues = nullptr);
 
+  /// \brief Helper function to instantiate a prefab multiple times without having to deal with resource acquisition. See InstantiatePrefabs().
+  static ezPrefabResource::InstantiateResult InstantiatePrefabs(const ezPrefabResourceHandle& hPrefab, bool bBlockTillLoaded, ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions options = {}, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues = nullptr);
+
   /// \brief Creates an instance of this prefab in the given world.
   void InstantiatePrefab(ezWorld& ref_world, const ezTransform& rootTransform, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues = nullptr);
 
-  void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezDynamicArray<ezGameObject*>& createdChildObjects, const ezDynamicArray<ezGameObject*>& createdRootObjects) const;
+  /// \brief Creates one instance of this prefab for every transform in \a rootTransforms.
+  ///
+  /// Prefer this over calling InstantiatePrefab() in a loop, when many copies are spawned at once. See ezWorldReader::InstantiatePrefabs().
+  /// The exposed parameter values are applied to every copy.
+  void InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues = nullptr);
+
+  void ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, ezArrayPtr<ezGameObject* const> createdChildObjects, ezArrayPtr<ezGameObject* const> createdRootObjects) const;
 
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
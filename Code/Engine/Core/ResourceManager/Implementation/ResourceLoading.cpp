@@ -6,6 +6,10 @@
 
 ezTypelessResourceHandle ezResourceManager::LoadResourceByType(const ezRTTI* pResourceType, ezStringView sResourceID)
 {
+  ezTypelessResourceHandle hResource;
+  if (TryGetResourceFromLookupShard(pResourceType, sResourceID, hResource))
+    return hResource;
+
   // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
   EZ_LOCK(s_ResourceMutex);
   return ezTypelessResourceHandle(GetResource(pResourceType, sResourceID, true));
@@ -29,6 +33,11 @@ void ezResourceManager::InternalPreloadResource(ezResource* pResource, bool bHig
     return;
   }
 
+  // the resource is already usable, only load higher quality levels while the memory budget has some headroom
+  // once the budget allows it again, the next acquire will trigger loading again
+  if (pResource->GetLoadingState() == ezResourceState::Loaded && IsLoadingBlockedByMemoryBudget(pResource))
+    return;
+
   EZ_ASSERT_DEV(!s_pState->m_bExportMode, "Resources should not be loaded in export mode");
 
   // if we are already loading this resource, early out
@@ -102,7 +111,7 @@ void ezResourceManager::RunWorkerTask(ezResource* pResource)
 
   SetupWorkerTasks();
 
-  if (s_pState->m_bAllowLaunchDataLoadTask && !s_pState->m_LoadingQueue.IsEmpty())
+  if (s_pState->m_bAllowLaunchDataLoadTask && IsAnyResourceWaitingForLoading())
   {
     s_pState->m_bAllowLaunchDataLoadTask = false;
 
@@ -128,69 +137,140 @@ void ezResourceManager::RunWorkerTask(ezResource* pResource)
   }
 }
 
-void ezResourceManager::ReverseBubbleSortStep(ezDeque<LoadingInfo>& data)
+void ezResourceManager::LoadingQueueSiftUp(ezUInt32 uiIndex)
 {
-  // Yep, it's really bubble sort!
-  // This will move the entry with the smallest value to the front and move all other values closer to their correct position,
-  // which is exactly what we need for the priority queue.
-  // We do this once a frame, which gives us nice iterative sorting, with relatively deterministic performance characteristics.
+  auto& heap = s_pState->m_LoadingQueue;
 
-  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+  while (uiIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (!(heap[uiIndex] < heap[uiParent]))
+      break;
+
+    ezMath::Swap(heap[uiIndex], heap[uiParent]);
+    uiIndex = uiParent;
+  }
+}
 
-  const ezUInt32 uiCount = data.GetCount();
+void ezResourceManager::LoadingQueueSiftDown(ezUInt32 uiIndex)
+{
+  auto& heap = s_pState->m_LoadingQueue;
+  const ezUInt32 uiCount = heap.GetCount();
 
-  for (ezUInt32 i = uiCount; i > 1; --i)
+  while (true)
   {
-    const ezUInt32 idx2 = i - 1;
-    const ezUInt32 idx1 = i - 2;
+    const ezUInt32 uiLeft = uiIndex * 2 + 1;
+    const ezUInt32 uiRight = uiLeft + 1;
+    ezUInt32 uiSmallest = uiIndex;
 
-    if (data[idx1].m_fPriority > data[idx2].m_fPriority)
-    {
-      ezMath::Swap(data[idx1], data[idx2]);
-    }
+    if (uiLeft < uiCount && heap[uiLeft] < heap[uiSmallest])
+      uiSmallest = uiLeft;
+
+    if (uiRight < uiCount && heap[uiRight] < heap[uiSmallest])
+      uiSmallest = uiRight;
+
+    if (uiSmallest == uiIndex)
+      break;
+
+    ezMath::Swap(heap[uiIndex], heap[uiSmallest]);
+    uiIndex = uiSmallest;
   }
 }
 
-void ezResourceManager::UpdateLoadingDeadlines()
+void ezResourceManager::LoadingQueuePush(const LoadingInfo& info)
 {
-  if (s_pState->m_LoadingQueue.IsEmpty())
-    return;
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+
+  s_pState->m_LoadingQueue.PushBack(info);
+  LoadingQueueSiftUp(s_pState->m_LoadingQueue.GetCount() - 1);
+}
 
+ezResource* ezResourceManager::LoadingQueuePop()
+{
   EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
 
-  EZ_PROFILE_SCOPE("UpdateLoadingDeadlines");
+  auto& heap = s_pState->m_LoadingQueue;
+  if (heap.IsEmpty())
+    return nullptr;
 
-  const ezUInt32 uiCount = s_pState->m_LoadingQueue.GetCount();
-  s_pState->m_uiLastResourcePriorityUpdateIdx = ezMath::Min(s_pState->m_uiLastResourcePriorityUpdateIdx, uiCount);
+  ezResource* pResource = heap[0].m_pResource;
 
-  ezUInt32 uiUpdateCount = ezMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
+  heap[0] = heap.PeekBack();
+  heap.PopBack();
 
-  if (uiUpdateCount == 0)
+  if (!heap.IsEmpty())
   {
-    s_pState->m_uiLastResourcePriorityUpdateIdx = 0;
-    uiUpdateCount = ezMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
+    LoadingQueueSiftDown(0);
   }
 
-  if (uiUpdateCount > 0)
+  return pResource;
+}
+
+bool ezResourceManager::LoadingQueueRemove(ezResource* pResource)
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+
+  LoadingInfo li;
+  li.m_pResource = pResource;
+
+  auto& heap = s_pState->m_LoadingQueue;
+  const ezUInt32 uiIndex = heap.IndexOf(li);
+
+  if (uiIndex == ezInvalidIndex)
+    return false;
+
+  heap[uiIndex] = heap.PeekBack();
+  heap.PopBack();
+
+  if (uiIndex < heap.GetCount())
   {
-    {
-      EZ_PROFILE_SCOPE("EvalLoadingDeadlines");
+    LoadingQueueSiftUp(uiIndex);
+    LoadingQueueSiftDown(uiIndex);
+  }
 
-      const ezTime tNow = ezTime::Now();
+  return true;
+}
 
-      for (ezUInt32 i = 0; i < uiUpdateCount; ++i)
-      {
-        auto& element = s_pState->m_LoadingQueue[s_pState->m_uiLastResourcePriorityUpdateIdx];
-        element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
-        ++s_pState->m_uiLastResourcePriorityUpdateIdx;
-      }
-    }
+bool ezResourceManager::IsAnyResourceWaitingForLoading()
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
 
-    {
-      EZ_PROFILE_SCOPE("SortLoadingDeadlines");
-      ReverseBubbleSortStep(s_pState->m_LoadingQueue);
-    }
+  return !s_pState->m_LoadingQueue.IsEmpty();
+}
+
+void ezResourceManager::UpdateLoadingDeadlines()
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+
+  if (s_pState->m_LoadingQueue.IsEmpty())
+    return;
+
+  EZ_PROFILE_SCOPE("UpdateLoadingDeadlines");
+
+  // re-evaluate a few entries every time, round-robin through the whole queue, and restore the heap order for each of them
+  // entries may move around while doing so, which just means that some get updated slightly earlier or later
+
+  const ezUInt32 uiCount = s_pState->m_LoadingQueue.GetCount();
+  ezUInt32 uiIndex = s_pState->m_uiLastResourcePriorityUpdateIdx < uiCount ? s_pState->m_uiLastResourcePriorityUpdateIdx : 0;
+
+  const ezTime tNow = ezTime::Now();
+
+  for (ezUInt32 i = 0; i < ezMath::Min(50u, uiCount); ++i)
+  {
+    auto& element = s_pState->m_LoadingQueue[uiIndex];
+    const float fOldPriority = element.m_fPriority;
+    element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
+
+    if (element.m_fPriority < fOldPriority)
+      LoadingQueueSiftUp(uiIndex);
+    else if (element.m_fPriority > fOldPriority)
+      LoadingQueueSiftDown(uiIndex);
+
+    uiIndex = (uiIndex + 1) % uiCount;
   }
+
+  s_pState->m_uiLastResourcePriorityUpdateIdx = uiIndex;
 }
 
 void ezResourceManager::PreloadResource(ezResource* pResource)
@@ -221,15 +301,13 @@ ezResult ezResourceManager::RemoveFromLoadingQueue(ezResource* pResource)
   if (!IsQueuedForLoading(pResource))
     return EZ_SUCCESS;
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
-  if (s_pState->m_LoadingQueue.RemoveAndSwap(li))
+  if (LoadingQueueRemove(pResource))
   {
     pResource->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
     return EZ_SUCCESS;
   }
 
+  // not in the queue anymore, so some task is already loading it
   return EZ_FAILURE;
 }
 
@@ -247,13 +325,13 @@ void ezResourceManager::AddToLoadingQueue(ezResource* pResource, bool bHighestPr
   {
     pResource->SetPriority(ezResourcePriority::Critical);
     li.m_fPriority = 0.0f;
-    s_pState->m_LoadingQueue.PushFront(li);
   }
   else
   {
     li.m_fPriority = pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate);
-    s_pState->m_LoadingQueue.PushBack(li);
   }
+
+  LoadingQueuePush(li);
 }
 
 bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
@@ -288,7 +366,7 @@ bool ezResourceManager::ReloadResource(ezResource* pResource, bool bForce)
     LoadingInfo li;
     li.m_pResource = pResource;
 
-    if (s_pState->m_LoadingQueue.IndexOf(li) == ezInvalidIndex)
+    if (!s_pState->m_LoadingQueue.Contains(li))
     {
       // the resource is marked as 'loading' but it is not in the queue anymore
       // that means some task is already working on loading it
@@ -6,6 +6,7 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Utilities/Stats.h>
 
 /// \todo Do not unload resources while they are acquired
 /// \todo Resource Type Memory Thresholds
@@ -317,6 +318,198 @@ void ezResourceManager::SetAutoFreeUnused(ezTime timeout, ezTime lastAcquireThre
   s_pState->m_AutoFreeUnusedThreshold = lastAcquireThreshold;
 }
 
+// Loading higher quality levels is only allowed while the usage is below this fraction of the budget.
+// The gap to the actual budget prevents that the same quality levels get discarded and reloaded over and over.
+static constexpr double s_fMemoryBudgetLoadingThreshold = 0.9;
+
+static bool IsOverMemoryBudget(const ezResourceManager::MemoryBudgetUsage& usage, double fFraction)
+{
+  if (usage.m_uiBudgetCPU > 0 && usage.m_uiUsedCPU > usage.m_uiBudgetCPU * fFraction)
+    return true;
+
+  if (usage.m_uiBudgetGPU > 0 && usage.m_uiUsedGPU > usage.m_uiBudgetGPU * fFraction)
+    return true;
+
+  return false;
+}
+
+static void PublishMemoryBudgetStats(ezStringView sPrefix, const ezResourceManager::MemoryBudgetUsage& usage)
+{
+  const double fToMB = 1.0 / (1024.0 * 1024.0);
+
+  ezStringBuilder sStatName;
+  sStatName.Set(sPrefix, "CPU Used (MB)");
+  ezStats::SetStat(sStatName, usage.m_uiUsedCPU * fToMB);
+  sStatName.Set(sPrefix, "GPU Used (MB)");
+  ezStats::SetStat(sStatName, usage.m_uiUsedGPU * fToMB);
+
+  if (usage.m_uiBudgetCPU > 0)
+  {
+    sStatName.Set(sPrefix, "CPU Budget (MB)");
+    ezStats::SetStat(sStatName, usage.m_uiBudgetCPU * fToMB);
+  }
+
+  if (usage.m_uiBudgetGPU > 0)
+  {
+    sStatName.Set(sPrefix, "GPU Budget (MB)");
+    ezStats::SetStat(sStatName, usage.m_uiBudgetGPU * fToMB);
+  }
+}
+
+void ezResourceManager::SetMemoryBudget(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  s_pState->m_MemoryBudget.m_uiBudgetCPU = uiBudgetCPU;
+  s_pState->m_MemoryBudget.m_uiBudgetGPU = uiBudgetGPU;
+
+  bool bAnyBudget = uiBudgetCPU > 0 || uiBudgetGPU > 0;
+  for (auto it = s_pState->m_TypeInfo.GetIterator(); it.IsValid(); ++it)
+  {
+    bAnyBudget |= it.Value().m_MemoryBudget.m_uiBudgetCPU > 0 || it.Value().m_MemoryBudget.m_uiBudgetGPU > 0;
+  }
+
+  s_pState->m_bAnyMemoryBudget = bAnyBudget;
+  s_pState->m_bMemoryBudgetBlocksLoading = IsOverMemoryBudget(s_pState->m_MemoryBudget, s_fMemoryBudgetLoadingThreshold);
+}
+
+void ezResourceManager::SetMemoryBudgetForResourceType(const ezRTTI* pResourceType, ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  auto& info = GetResourceTypeInfo(pResourceType);
+  info.m_MemoryBudget.m_uiBudgetCPU = uiBudgetCPU;
+  info.m_MemoryBudget.m_uiBudgetGPU = uiBudgetGPU;
+  info.m_bMemoryBudgetBlocksLoading = IsOverMemoryBudget(info.m_MemoryBudget, s_fMemoryBudgetLoadingThreshold);
+
+  // recomputes the 'any budget' flag
+  SetMemoryBudget(s_pState->m_MemoryBudget.m_uiBudgetCPU, s_pState->m_MemoryBudget.m_uiBudgetGPU);
+}
+
+ezResourceManager::MemoryBudgetUsage ezResourceManager::GetMemoryBudgetUsage(const ezRTTI* pResourceType)
+{
+  EZ_LOCK(s_ResourceMutex);
+
+  if (pResourceType == nullptr)
+    return s_pState->m_MemoryBudget;
+
+  if (auto it = s_pState->m_TypeInfo.Find(pResourceType); it.IsValid())
+    return it.Value().m_MemoryBudget;
+
+  return {};
+}
+
+bool ezResourceManager::IsLoadingBlockedByMemoryBudget(ezResource* pResource)
+{
+  if (!s_pState->m_bAnyMemoryBudget)
+    return false;
+
+  if (s_pState->m_bMemoryBudgetBlocksLoading)
+    return true;
+
+  return GetResourceTypeInfo(pResource->GetDynamicRTTI()).m_bMemoryBudgetBlocksLoading;
+}
+
+ezUInt32 ezResourceManager::EnforceMemoryBudgets()
+{
+  EZ_PROFILE_SCOPE("EnforceMemoryBudgets");
+
+  EZ_LOCK(s_ResourceMutex);
+
+  auto& globalUsage = s_pState->m_MemoryBudget;
+  globalUsage.m_uiUsedCPU = 0;
+  globalUsage.m_uiUsedGPU = 0;
+
+  auto& candidates = s_pState->m_MemoryBudgetCandidates;
+  candidates.Clear();
+
+  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    ResourceTypeInfo& typeInfo = GetResourceTypeInfo(itType.Key());
+    typeInfo.m_MemoryBudget.m_uiUsedCPU = 0;
+    typeInfo.m_MemoryBudget.m_uiUsedGPU = 0;
+
+    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    {
+      ezResource* pResource = it.Value();
+      const auto& mem = pResource->GetMemoryUsage();
+
+      typeInfo.m_MemoryBudget.m_uiUsedCPU += mem.m_uiMemoryCPU;
+      typeInfo.m_MemoryBudget.m_uiUsedGPU += mem.m_uiMemoryGPU;
+
+      // resources that are currently being loaded are off limits, their content is changed on another thread
+      if (pResource->GetLoadingState() == ezResourceState::Loaded && pResource->GetNumQualityLevelsDiscardable() > 0 &&
+          pResource->GetPriority() != ezResourcePriority::Critical && !IsQueuedForLoading(pResource))
+      {
+        candidates.PushBack({pResource, &typeInfo});
+      }
+    }
+
+    globalUsage.m_uiUsedCPU += typeInfo.m_MemoryBudget.m_uiUsedCPU;
+    globalUsage.m_uiUsedGPU += typeInfo.m_MemoryBudget.m_uiUsedGPU;
+  }
+
+  // lowest priority first, within the same priority the least recently acquired first
+  candidates.Sort([](const ezResourceManagerState::MemoryBudgetCandidate& a, const ezResourceManagerState::MemoryBudgetCandidate& b) {
+    if (a.m_pResource->GetPriority() != b.m_pResource->GetPriority())
+      return a.m_pResource->GetPriority() > b.m_pResource->GetPriority();
+
+    return a.m_pResource->GetLastAcquireTime() < b.m_pResource->GetLastAcquireTime();
+  });
+
+  ezUInt32 uiDiscardedLevels = 0;
+
+  for (const auto& candidate : candidates)
+  {
+    ezResource* pResource = candidate.m_pResource;
+    auto& typeUsage = candidate.m_pTypeInfo->m_MemoryBudget;
+
+    while (IsOverMemoryBudget(globalUsage, 1.0) || IsOverMemoryBudget(typeUsage, 1.0))
+    {
+      const ezUInt8 uiDiscardableBefore = pResource->GetNumQualityLevelsDiscardable();
+      if (uiDiscardableBefore == 0 || pResource->GetLoadingState() != ezResourceState::Loaded)
+        break;
+
+      pResource->CallUnloadData(ezResource::Unload::OneQualityLevel);
+
+      ezResource::MemoryUsage oldUsage = pResource->GetMemoryUsage();
+      pResource->UpdateMemoryUsage(pResource->m_MemoryUsage);
+
+      const ezResource::MemoryUsage& newUsage = pResource->GetMemoryUsage();
+      globalUsage.m_uiUsedCPU = globalUsage.m_uiUsedCPU - oldUsage.m_uiMemoryCPU + newUsage.m_uiMemoryCPU;
+      globalUsage.m_uiUsedGPU = globalUsage.m_uiUsedGPU - oldUsage.m_uiMemoryGPU + newUsage.m_uiMemoryGPU;
+      typeUsage.m_uiUsedCPU = typeUsage.m_uiUsedCPU - oldUsage.m_uiMemoryCPU + newUsage.m_uiMemoryCPU;
+      typeUsage.m_uiUsedGPU = typeUsage.m_uiUsedGPU - oldUsage.m_uiMemoryGPU + newUsage.m_uiMemoryGPU;
+
+      ++uiDiscardedLevels;
+
+      // the resource refused to discard anything
+      if (pResource->GetNumQualityLevelsDiscardable() >= uiDiscardableBefore)
+        break;
+    }
+  }
+
+  candidates.Clear();
+
+  s_pState->m_bMemoryBudgetBlocksLoading = IsOverMemoryBudget(globalUsage, s_fMemoryBudgetLoadingThreshold);
+  PublishMemoryBudgetStats("Resource Manager/Memory/", globalUsage);
+
+  ezStringBuilder sPrefix;
+  for (auto it = s_pState->m_TypeInfo.GetIterator(); it.IsValid(); ++it)
+  {
+    auto& typeInfo = it.Value();
+    typeInfo.m_bMemoryBudgetBlocksLoading = IsOverMemoryBudget(typeInfo.m_MemoryBudget, s_fMemoryBudgetLoadingThreshold);
+
+    if (typeInfo.m_MemoryBudget.m_uiBudgetCPU > 0 || typeInfo.m_MemoryBudget.m_uiBudgetGPU > 0)
+    {
+      sPrefix.Set("Resource Manager/Memory/", it.Key()->GetTypeName(), "/");
+      PublishMemoryBudgetStats(sPrefix, typeInfo.m_MemoryBudget);
+    }
+  }
+
+  return uiDiscardedLevels;
+}
+
 void ezResourceManager::AllowResourceTypeAcquireDuringUpdateContent(const ezRTTI* pTypeBeingUpdated, const ezRTTI* pTypeItWantsToAcquire)
 {
   auto& info = s_pState->m_TypeInfo[pTypeBeingUpdated];
@@ -386,6 +579,12 @@ ezResult ezResourceManager::DeallocateResource(ezResource* pResource)
 {
   // EZ_ASSERT_DEBUG(pResource->m_iLockCount == 0, "Resource '{0}' has a refcount of zero, but is still in an acquired state.", pResource->GetResourceID());
 
+  if (RemoveFromLookupShard(pResource).Failed())
+  {
+    // someone just got a new handle to this resource
+    return EZ_FAILURE;
+  }
+
   if (RemoveFromLoadingQueue(pResource).Failed())
   {
     // cannot deallocate resources that are currently queued for loading,
@@ -494,6 +693,10 @@ void ezResourceManager::PerFrameUpdate()
   {
     FreeUnusedResources(s_pState->m_AutoFreeUnusedTimeout, s_pState->m_AutoFreeUnusedThreshold);
   }
+  if (s_pState->m_bAnyMemoryBudget)
+  {
+    EnforceMemoryBudgets();
+  }
 }
 
 const ezEvent<const ezResourceEvent&, ezMutex>& ezResourceManager::GetResourceEvents()
@@ -597,7 +800,7 @@ bool ezResourceManager::IsAnyLoadingInProgress()
 {
   EZ_LOCK(s_ResourceMutex);
 
-  if (s_pState->m_LoadingQueue.GetCount() > 0)
+  if (IsAnyResourceWaitingForLoading())
   {
     return true;
   }
@@ -681,6 +884,8 @@ ezResource* ezResourceManager::GetResource(const ezRTTI* pRtti, ezStringView sRe
 
   EZ_ASSERT_DEV(s_ResourceMutex.IsLocked(), "Calling code must lock the mutex until the resource pointer is stored in a handle");
 
+  const ezRTTI* pRequestedRtti = pRtti;
+
   // redirect requested type to override type, if available
   pRtti = FindResourceTypeOverride(pRtti, sResourceID);
 
@@ -697,17 +902,28 @@ ezResource* ezResourceManager::GetResource(const ezRTTI* pRtti, ezStringView sRe
   ezResource* pResource = nullptr;
   ezTempHashedString sHashedResourceID(sResourceID);
 
+  // only direct lookups go into the lookup shards, redirected ones always take this path
+  bool bRedirected = pRtti != pRequestedRtti;
+
   ezHashedString* redirection;
   if (s_pState->m_NamedResources.TryGetValue(sHashedResourceID, redirection))
   {
     sHashedResourceID = *redirection;
     sResourceID = redirection->GetView();
+    bRedirected = true;
   }
 
   LoadedResources& lr = s_pState->m_LoadedResources[pRtti];
 
   if (lr.m_Resources.TryGetValue(sHashedResourceID, pResource))
+  {
+    if (!bRedirected)
+    {
+      AddToLookupShard(pResource);
+    }
+
     return pResource;
+  }
 
   ezResource* pNewResource = pRtti->GetAllocator()->Allocate<ezResource>();
   pNewResource->m_Priority = s_pState->m_ResourceTypePriorities.GetValueOrDefault(pRtti, ezResourcePriority::Medium);
@@ -716,11 +932,97 @@ ezResource* ezResourceManager::GetResource(const ezRTTI* pRtti, ezStringView sRe
 
   lr.m_Resources.Insert(sHashedResourceID, pNewResource);
 
+  if (!bRedirected)
+  {
+    AddToLookupShard(pNewResource);
+  }
+
   return pNewResource;
 }
 
+ezResourceManager::LookupShard& ezResourceManager::GetLookupShard(const LookupKey& key)
+{
+  // use the upper bits to select the shard, the hash tables inside the shards use the lower bits
+  static_assert(ezResourceManagerState::s_uiNumLookupShards == 16);
+  return s_pState->m_LookupShards[LookupKeyHashHelper::Hash(key) >> 28];
+}
+
+bool ezResourceManager::TryGetResourceFromLookupShard(const ezRTTI* pRtti, ezStringView sResourceID, ezTypelessResourceHandle& out_hResource)
+{
+  const LookupKey key = {pRtti, ezHashingUtils::StringHash(sResourceID)};
+  LookupShard& shard = GetLookupShard(key);
+
+  EZ_LOCK(shard.m_Mutex);
+
+  ezResource* pResource = nullptr;
+  if (!shard.m_Resources.TryGetValue(key, pResource))
+    return false;
+
+  // the handle has to be created while the shard is locked, see RemoveFromLookupShard()
+  out_hResource = ezTypelessResourceHandle(pResource);
+  return true;
+}
+
+void ezResourceManager::AddToLookupShard(ezResource* pResource)
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+
+  const LookupKey key = {pResource->GetDynamicRTTI(), pResource->GetResourceIDHash()};
+  LookupShard& shard = GetLookupShard(key);
+
+  EZ_LOCK(shard.m_Mutex);
+  shard.m_Resources.Insert(key, pResource);
+}
+
+ezResult ezResourceManager::RemoveFromLookupShard(ezResource* pResource)
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
+
+  const LookupKey key = {pResource->GetDynamicRTTI(), pResource->GetResourceIDHash()};
+  LookupShard& shard = GetLookupShard(key);
+
+  EZ_LOCK(shard.m_Mutex);
+
+  // another thread may have just looked up the resource and created a new handle to it
+  if (pResource->GetReferenceCount() != 0)
+    return EZ_FAILURE;
+
+  ezResource* pCached = nullptr;
+  if (shard.m_Resources.TryGetValue(key, pCached) && pCached == pResource)
+  {
+    shard.m_Resources.Remove(key);
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezResourceManager::ClearLookupShards(ezUInt64 uiResourceIDHash)
+{
+  for (LookupShard& shard : s_pState->m_LookupShards)
+  {
+    EZ_LOCK(shard.m_Mutex);
+
+    if (uiResourceIDHash == 0)
+    {
+      shard.m_Resources.Clear();
+      continue;
+    }
+
+    for (auto it = shard.m_Resources.GetIterator(); it.IsValid();)
+    {
+      if (it.Key().m_uiResourceIDHash == uiResourceIDHash)
+        it = shard.m_Resources.Remove(it);
+      else
+        ++it;
+    }
+  }
+}
+
 void ezResourceManager::RegisterResourceOverrideType(const ezRTTI* pDerivedTypeToUse, ezDelegate<bool(const ezStringBuilder&)> overrideDecider)
 {
+  // cached lookups may resolve to a different type now
+  ClearLookupShards();
+
   const ezRTTI* pParentType = pDerivedTypeToUse->GetParentType();
   while (pParentType != nullptr && pParentType != ezGetStaticRTTI<ezResource>())
   {
@@ -734,6 +1036,9 @@ void ezResourceManager::RegisterResourceOverrideType(const ezRTTI* pDerivedTypeT
 
 void ezResourceManager::UnregisterResourceOverrideType(const ezRTTI* pDerivedTypeToUse)
 {
+  // cached lookups may resolve to a different type now
+  ClearLookupShards();
+
   const ezRTTI* pParentType = pDerivedTypeToUse->GetParentType();
   while (pParentType != nullptr && pParentType != ezGetStaticRTTI<ezResource>())
   {
@@ -792,6 +1097,10 @@ ezTypelessResourceHandle ezResourceManager::GetExistingResourceByType(const ezRT
 {
   ezResource* pResource = nullptr;
 
+  ezTypelessResourceHandle hResource;
+  if (TryGetResourceFromLookupShard(pResourceType, sResourceID, hResource))
+    return hResource;
+
   const ezTempHashedString sResourceHash(sResourceID);
 
   EZ_LOCK(s_ResourceMutex);
@@ -846,6 +1155,9 @@ void ezResourceManager::RegisterNamedResource(ezStringView sLookupName, ezString
   redirection.Assign(sRedirectionResource);
 
   s_pState->m_NamedResources[lookup] = redirection;
+
+  // lookups of this name must not find a resource with the same ID anymore
+  ClearLookupShards(lookup.GetHash());
 }
 
 void ezResourceManager::UnregisterNamedResource(ezStringView sLookupName)
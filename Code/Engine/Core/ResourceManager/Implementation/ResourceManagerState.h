@@ -51,10 +51,17 @@ private:
   ezUInt32 m_uiForceNoFallbackAcquisition = 0;
 
   // resources in this queue are waiting for a task to load them
-  ezDeque<ezResourceManager::LoadingInfo> m_LoadingQueue;
+  // the queue is a binary heap sorted by loading priority, so picking the next resource doesn't require sorting the whole queue
+  // like all other loading state it is protected by the resource mutex
+  ezDynamicArray<ezResourceManager::LoadingInfo> m_LoadingQueue;
 
   ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> m_LoadedResources;
 
+  // caches which resources have been looked up through which type and ID
+  // each shard has its own mutex, so that looking up existing resources neither has to lock the resource mutex, nor other shards
+  static constexpr ezUInt32 s_uiNumLookupShards = 16;
+  ezResourceManager::LookupShard m_LookupShards[s_uiNumLookupShards];
+
   bool m_bAllowLaunchDataLoadTask = true;
   bool m_bShutdown = false;
 
@@ -101,5 +108,20 @@ private:
   ezTime m_AutoFreeUnusedTimeout = ezTime::MakeZero();
   ezTime m_AutoFreeUnusedThreshold = ezTime::MakeZero();
 
+  // Memory budgets
+  bool m_bAnyMemoryBudget = false;
+  bool m_bMemoryBudgetBlocksLoading = false;
+  ezResourceManager::MemoryBudgetUsage m_MemoryBudget;
+
+  struct MemoryBudgetCandidate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezResource* m_pResource;
+    ezResourceManager::ResourceTypeInfo* m_pTypeInfo;
+  };
+
+  ezDynamicArray<MemoryBudgetCandidate> m_MemoryBudgetCandidates;
+
   ezMap<const ezRTTI*, ezResourceManager::ResourceTypeInfo> m_TypeInfo;
 };
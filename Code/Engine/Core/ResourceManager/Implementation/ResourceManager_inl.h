@@ -11,6 +11,11 @@ ResourceType* ezResourceManager::GetResource(ezStringView sResourceID, bool bIsR
 template <typename ResourceType>
 ezTypedResourceHandle<ResourceType> ezResourceManager::LoadResource(ezStringView sResourceID)
 {
+  // resources that were looked up before can be found without locking the resource mutex
+  ezTypelessResourceHandle hExisting;
+  if (TryGetResourceFromLookupShard(ezGetStaticRTTI<ResourceType>(), sResourceID, hExisting))
+    return ezTypedResourceHandle<ResourceType>(static_cast<ResourceType*>(hExisting.m_pResource));
+
   // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
   EZ_LOCK(s_ResourceMutex);
   return ezTypedResourceHandle<ResourceType>(GetResource<ResourceType>(sResourceID, true));
@@ -19,12 +24,7 @@ ezTypedResourceHandle<ResourceType> ezResourceManager::LoadResource(ezStringView
 template <typename ResourceType>
 ezTypedResourceHandle<ResourceType> ezResourceManager::LoadResource(ezStringView sResourceID, ezTypedResourceHandle<ResourceType> hLoadingFallback)
 {
-  ezTypedResourceHandle<ResourceType> hResource;
-  {
-    // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
-    EZ_LOCK(s_ResourceMutex);
-    hResource = ezTypedResourceHandle<ResourceType>(GetResource<ResourceType>(sResourceID, true));
-  }
+  ezTypedResourceHandle<ResourceType> hResource = LoadResource<ResourceType>(sResourceID);
 
   if (hLoadingFallback.IsValid())
   {
@@ -37,6 +37,10 @@ ezTypedResourceHandle<ResourceType> ezResourceManager::LoadResource(ezStringView
 template <typename ResourceType>
 ezTypedResourceHandle<ResourceType> ezResourceManager::GetExistingResource(ezStringView sResourceID)
 {
+  ezTypelessResourceHandle hExisting;
+  if (TryGetResourceFromLookupShard(ezGetStaticRTTI<ResourceType>(), sResourceID, hExisting))
+    return ezTypedResourceHandle<ResourceType>(static_cast<ResourceType*>(hExisting.m_pResource));
+
   ezResource* pResource = nullptr;
 
   const ezTempHashedString sResourceHash(sResourceID);
@@ -3,6 +3,7 @@
 #include <Core/ResourceManager/Resource.h>
 #include <Core/ResourceManager/ResourceTypeLoader.h>
 #include <Foundation/Containers/Blob.h>
+#include <Foundation/IO/FileSystem/AsyncFileRead.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
@@ -51,7 +52,24 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   const ezUInt64 uiOffset = w.GetNumWrittenBytes();
 
-  File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  const ezString128 sAbsolutePath = File.GetFilePathAbsolute();
+  if (ezOSFile::ExistsFile(sAbsolutePath))
+  {
+    // read the content straight into the blob, this bypasses the read cache of the file reader and goes through io_uring where available
+    ezAsyncFileReadRequest request;
+    request.m_sFile = sAbsolutePath.GetView();
+    request.m_uiNumBytes = uiFileSize;
+    request.m_pDestination = pBlobPtr + uiOffset;
+
+    File.Close();
+
+    ezSharedPtr<ezAsyncFileRead> pRead = ezFileSystem::ReadAsync(request);
+    pRead->WaitForCompletion();
+  }
+  else
+  {
+    File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  }
 
   pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
   res.m_pDataStream = &pData->m_Reader;
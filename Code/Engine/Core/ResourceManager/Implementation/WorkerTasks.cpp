@@ -19,18 +19,18 @@ void ezResourceManagerWorkerDataLoad::Execute()
   {
     EZ_LOCK(ezResourceManager::s_ResourceMutex);
 
-    if (ezResourceManager::s_pState->m_LoadingQueue.IsEmpty())
+    ezResourceManager::UpdateLoadingDeadlines();
+    pResourceToLoad = ezResourceManager::LoadingQueuePop();
+
+    if (pResourceToLoad == nullptr)
     {
       ezResourceManager::s_pState->m_bAllowLaunchDataLoadTask = true;
+
+      // something may have been added after the queue was checked, but before the flag was reset
+      ezResourceManager::RunWorkerTask(nullptr);
       return;
     }
 
-    ezResourceManager::UpdateLoadingDeadlines();
-
-    auto it = ezResourceManager::s_pState->m_LoadingQueue.PeekFront();
-    pResourceToLoad = it.m_pResource;
-    ezResourceManager::s_pState->m_LoadingQueue.PopFront();
-
     if (pResourceToLoad->m_Flags.IsSet(ezResourceFlags::HasCustomDataLoader))
     {
       pCustomLoader = std::move(ezResourceManager::s_pState->m_CustomLoaders[pResourceToLoad]);
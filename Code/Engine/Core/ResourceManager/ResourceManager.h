@@ -239,6 +239,53 @@ public:
 private:
   static ezResult DeallocateResource(ezResource* pResource);
 
+  ///@}
+  /// \name Memory budgets
+  ///@{
+
+public:
+  /// \brief Sets the global CPU and GPU memory budget (in bytes) for all resources. Zero means unlimited.
+  ///
+  /// Once per frame, PerFrameUpdate() checks the memory usage of all resources against the budgets. If a budget is exceeded,
+  /// quality levels are discarded from resources, starting with the lowest priority and least recently acquired ones, until the usage is
+  /// back within the budget. Resources with ezResourcePriority::Critical are never touched.
+  /// Additionally, higher quality levels of already loaded resources are only loaded while there is enough headroom in the budget.
+  static void SetMemoryBudget(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU);
+
+  /// \brief Sets a CPU and GPU memory budget (in bytes) for resources of exactly the given type. Zero means unlimited.
+  ///
+  /// This works in addition to the global budget, see SetMemoryBudget().
+  template <typename ResourceType>
+  static void SetMemoryBudgetForResourceType(ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU)
+  {
+    SetMemoryBudgetForResourceType(ezGetStaticRTTI<ResourceType>(), uiBudgetCPU, uiBudgetGPU);
+  }
+
+  /// \copydoc SetMemoryBudgetForResourceType()
+  static void SetMemoryBudgetForResourceType(const ezRTTI* pResourceType, ezUInt64 uiBudgetCPU, ezUInt64 uiBudgetGPU);
+
+  struct MemoryBudgetUsage
+  {
+    ezUInt64 m_uiUsedCPU = 0;
+    ezUInt64 m_uiUsedGPU = 0;
+    ezUInt64 m_uiBudgetCPU = 0;
+    ezUInt64 m_uiBudgetGPU = 0;
+  };
+
+  /// \brief Returns the memory usage and budget of the given resource type, or the global one if pResourceType is nullptr.
+  ///
+  /// The usage is only updated by EnforceMemoryBudgets().
+  static MemoryBudgetUsage GetMemoryBudgetUsage(const ezRTTI* pResourceType = nullptr);
+
+  /// \brief Recomputes the memory usage of all resources and discards quality levels until all budgets are met.
+  ///
+  /// Returns the number of discarded quality levels. This is called automatically by PerFrameUpdate() whenever any budget is set.
+  /// Must be called on the main thread.
+  static ezUInt32 EnforceMemoryBudgets();
+
+private:
+  static bool IsLoadingBlockedByMemoryBudget(ezResource* pResource);
+
   ///@}
   /// \name Miscellaneous
   ///@{
@@ -471,7 +518,12 @@ private:
   static ezResource* GetResource(const ezRTTI* pRtti, ezStringView sResourceID, bool bIsReloadable);
   static void RunWorkerTask(ezResource* pResource);
   static void UpdateLoadingDeadlines();
-  static void ReverseBubbleSortStep(ezDeque<LoadingInfo>& data);
+  static void LoadingQueueSiftUp(ezUInt32 uiIndex);
+  static void LoadingQueueSiftDown(ezUInt32 uiIndex);
+  static void LoadingQueuePush(const LoadingInfo& info);
+  static ezResource* LoadingQueuePop();
+  static bool LoadingQueueRemove(ezResource* pResource);
+  static bool IsAnyResourceWaitingForLoading();
   static bool ReloadResource(ezResource* pResource, bool bForce);
 
   static void SetupWorkerTasks();
@@ -483,10 +535,43 @@ private:
   [[nodiscard]] static ezResult RemoveFromLoadingQueue(ezResource* pResource);
   static void AddToLoadingQueue(ezResource* pResource, bool bHighPriority);
 
+  // Lookup shards
+private:
+  struct LookupKey
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    const ezRTTI* m_pType;
+    ezUInt64 m_uiResourceIDHash;
+
+    EZ_ALWAYS_INLINE bool operator==(const LookupKey& rhs) const { return m_pType == rhs.m_pType && m_uiResourceIDHash == rhs.m_uiResourceIDHash; }
+  };
+
+  struct LookupKeyHashHelper
+  {
+    EZ_ALWAYS_INLINE static ezUInt32 Hash(const LookupKey& key) { return ezHashingUtils::CombineHashValues32(ezHashingUtils::StringHashTo32(key.m_uiResourceIDHash), ezHashHelper<const void*>::Hash(key.m_pType)); }
+    EZ_ALWAYS_INLINE static bool Equal(const LookupKey& a, const LookupKey& b) { return a == b; }
+  };
+
+  struct LookupShard
+  {
+    ezMutex m_Mutex;
+    ezHashTable<LookupKey, ezResource*, LookupKeyHashHelper> m_Resources;
+  };
+
+  static LookupShard& GetLookupShard(const LookupKey& key);
+  static bool TryGetResourceFromLookupShard(const ezRTTI* pRtti, ezStringView sResourceID, ezTypelessResourceHandle& out_hResource);
+  static void AddToLookupShard(ezResource* pResource);
+  [[nodiscard]] static ezResult RemoveFromLookupShard(ezResource* pResource);
+  static void ClearLookupShards(ezUInt64 uiResourceIDHash = 0);
+
   struct ResourceTypeInfo
   {
     bool m_bIncrementalUnload = true;
     bool m_bAllowNestedAcquireCached = false;
+    bool m_bMemoryBudgetBlocksLoading = false;
+
+    MemoryBudgetUsage m_MemoryBudget;
 
     ezHybridArray<const ezRTTI*, 8> m_NestedTypes;
   };
@@ -38,6 +38,9 @@ public:
   /// \brief Returns the number of components managed by this manager.
   ezUInt32 GetComponentCount() const;
 
+  /// \brief Makes sure that the given number of additional components can be created without growing the internal id table.
+  void ReserveComponents(ezUInt32 uiNumComponents);
+
   /// \brief Create a new component instance and returns a handle to it.
   ezComponentHandle CreateComponent(ezGameObject* pOwnerObject);
 
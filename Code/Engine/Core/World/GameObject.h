@@ -540,6 +540,9 @@ private:
   void UpdateGlobalTransformAndBoundsRecursive();
   void UpdateLastGlobalTransform();
 
+  // Flags a dynamic object for the next global transform update. Objects that are not flagged (and whose parents did not move) are skipped.
+  void MarkTransformDirty();
+
   void OnMsgDeleteGameObject(ezMsgDeleteGameObject& msg);
 
   void AddComponent(ezComponent* pComponent);
@@ -580,10 +583,13 @@ private:
 
     ezUInt32 m_uiStableRandomSeed = 0;
 
+    // Position of this data within its hierarchy level, i.e. block index * TRANSFORMATION_DATA_PER_BLOCK + index in block.
+    // Used to find the bits in the per-block dirty masks of the world.
+    ezUInt32 m_uiIndexInLevel = 0;
+
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
     ezUInt32 m_uiLastGlobalTransformUpdateCounter = 0;
-#else
-    ezUInt32 m_uiPadding2[1];
+    ezUInt32 m_uiPadding2[3];
 #endif
 
     /// \brief Recomputes the local transform from this object's global transform and, if available, the parent's global transform.
@@ -22,6 +22,11 @@ EZ_ALWAYS_INLINE ezUInt32 ezComponentManagerBase::GetComponentCount() const
   return static_cast<ezUInt32>(m_Components.GetCount());
 }
 
+EZ_ALWAYS_INLINE void ezComponentManagerBase::ReserveComponents(ezUInt32 uiNumComponents)
+{
+  m_Components.Reserve(m_Components.GetCount() + uiNumComponents);
+}
+
 template <typename ComponentType>
 EZ_ALWAYS_INLINE ezTypedComponentHandle<ComponentType> ezComponentManagerBase::CreateComponent(ezGameObject* pOwnerObject, ComponentType*& out_pComponent)
 {
@@ -274,6 +274,12 @@ void ezGameObject::UpdateGlobalTransformAndBoundsRecursive()
     SendMessage(msg);
   }
 
+  // dynamic children of a moved static object must also refresh their last global transform during the next update
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+
   for (auto it = GetChildren(); it.IsValid(); ++it)
   {
     it->UpdateGlobalTransformAndBoundsRecursive();
@@ -285,6 +291,13 @@ void ezGameObject::UpdateLastGlobalTransform()
   m_pTransformationData->UpdateLastGlobalTransform(GetWorld()->GetUpdateCounter());
 }
 
+void ezGameObject::MarkTransformDirty()
+{
+  EZ_ASSERT_DEBUG(IsDynamic(), "Only dynamic objects take part in the global transform update");
+
+  GetWorld()->m_Data.MarkTransformationDataDirty(m_uiHierarchyLevel, m_pTransformationData);
+}
+
 void ezGameObject::ConstChildIterator::Next()
 {
   m_pObject = m_pWorld->GetObjectUnchecked(m_pObject->m_uiNextSiblingIndex);
@@ -669,6 +682,11 @@ void ezGameObject::SetLastGlobalTransform(const ezSimdTransform& transform)
 {
   m_pTransformationData->m_lastGlobalTransform = transform;
   m_pTransformationData->m_uiLastGlobalTransformUpdateCounter = GetWorld()->GetUpdateCounter();
+
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
 }
 
 ezVec3 ezGameObject::GetLinearVelocity() const
@@ -735,6 +753,10 @@ void ezGameObject::UpdateLocalBounds()
   {
     m_pTransformationData->UpdateGlobalBounds(pSpatialSystem);
   }
+  else
+  {
+    MarkTransformDirty();
+  }
 }
 
 void ezGameObject::UpdateGlobalTransformAndBounds()
@@ -272,7 +272,11 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalPosition(const ezSimdVec4f& vPositio
 {
   m_pTransformationData->m_localPosition = vPosition;
 
-  if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+  else if (updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
     UpdateGlobalTransformAndBoundsRecursive();
   }
@@ -288,7 +292,11 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalRotation(const ezSimdQuat& qRotation
 {
   m_pTransformationData->m_localRotation = qRotation;
 
-  if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+  else if (updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
     UpdateGlobalTransformAndBoundsRecursive();
   }
@@ -306,7 +314,11 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalScaling(const ezSimdVec4f& vScaling,
   m_pTransformationData->m_localScaling = vScaling;
   m_pTransformationData->m_localScaling.SetW(uniformScale);
 
-  if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+  else if (updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
     UpdateGlobalTransformAndBoundsRecursive();
   }
@@ -322,7 +334,11 @@ EZ_ALWAYS_INLINE void ezGameObject::SetLocalUniformScaling(const ezSimdFloat& fS
 {
   m_pTransformationData->m_localScaling.SetW(fScaling);
 
-  if (IsStatic() && updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+  else if (updateBehavior == UpdateBehaviorIfStatic::UpdateImmediately)
   {
     UpdateGlobalTransformAndBoundsRecursive();
   }
@@ -348,7 +364,11 @@ EZ_ALWAYS_INLINE void ezGameObject::SetGlobalPosition(const ezSimdVec4f& vPositi
 
   m_pTransformationData->UpdateLocalTransform();
 
-  if (IsStatic())
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+  else
   {
     UpdateGlobalTransformAndBoundsRecursive();
   }
@@ -368,7 +388,11 @@ EZ_ALWAYS_INLINE void ezGameObject::SetGlobalRotation(const ezSimdQuat& qRotatio
 
   m_pTransformationData->UpdateLocalTransform();
 
-  if (IsStatic())
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+  else
   {
     UpdateGlobalTransformAndBoundsRecursive();
   }
@@ -388,7 +412,11 @@ EZ_ALWAYS_INLINE void ezGameObject::SetGlobalScaling(const ezSimdVec4f& vScaling
 
   m_pTransformationData->UpdateLocalTransform();
 
-  if (IsStatic())
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+  else
   {
     UpdateGlobalTransformAndBoundsRecursive();
   }
@@ -412,7 +440,11 @@ EZ_ALWAYS_INLINE void ezGameObject::SetGlobalTransform(const ezSimdTransform& tr
   m_pTransformationData->m_globalTransform.m_Scale.SetW(1.0f);
   m_pTransformationData->UpdateLocalTransform();
 
-  if (IsStatic())
+  if (IsDynamic())
+  {
+    MarkTransformDirty();
+  }
+  else
   {
     UpdateGlobalTransformAndBoundsRecursive();
   }
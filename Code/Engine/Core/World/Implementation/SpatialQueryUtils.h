@@ -0,0 +1,195 @@
+#pragma once
+
+#include <Foundation/Math/Frustum.h>
+#include <Foundation/SimdMath/SimdBBox.h>
+#include <Foundation/SimdMath/SimdBSphere.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
+#include <Foundation/Types/TagSet.h>
+
+/// \internal Helpers that are shared by the spatial system implementations.
+namespace ezInternal
+{
+  struct PlaneData
+  {
+    ezSimdVec4f m_x0x1x2x3;
+    ezSimdVec4f m_y0y1y2y3;
+    ezSimdVec4f m_z0z1z2z3;
+    ezSimdVec4f m_w0w1w2w3;
+
+    ezSimdVec4f m_x4x5x4x5;
+    ezSimdVec4f m_y4y5y4y5;
+    ezSimdVec4f m_z4z5z4z5;
+    ezSimdVec4f m_w4w5w4w5;
+
+    // x, y, z and w of every plane splatted to all four components, to test four spheres against one plane at a time
+    ezSimdVec4f m_Splatted[6][4];
+  };
+
+  inline void ComputePlaneData(const ezFrustum& frustum, PlaneData& out_planeData)
+  {
+    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
+    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
+    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
+    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
+    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
+    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
+    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
+
+    ezSimdMat4f helperMat;
+    helperMat.SetRows(plane0, plane1, plane2, plane3);
+
+    out_planeData.m_x0x1x2x3 = helperMat.m_col0;
+    out_planeData.m_y0y1y2y3 = helperMat.m_col1;
+    out_planeData.m_z0z1z2z3 = helperMat.m_col2;
+    out_planeData.m_w0w1w2w3 = helperMat.m_col3;
+
+    helperMat.SetRows(plane4, plane5, plane4, plane5);
+
+    out_planeData.m_x4x5x4x5 = helperMat.m_col0;
+    out_planeData.m_y4y5y4y5 = helperMat.m_col1;
+    out_planeData.m_z4z5z4z5 = helperMat.m_col2;
+    out_planeData.m_w4w5w4w5 = helperMat.m_col3;
+
+    const ezSimdVec4f planes[6] = {plane0, plane1, plane2, plane3, plane4, plane5};
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      out_planeData.m_Splatted[i][0] = planes[i].Get<ezSwizzle::XXXX>();
+      out_planeData.m_Splatted[i][1] = planes[i].Get<ezSwizzle::YYYY>();
+      out_planeData.m_Splatted[i][2] = planes[i].Get<ezSwizzle::ZZZZ>();
+      out_planeData.m_Splatted[i][3] = planes[i].Get<ezSwizzle::WWWW>();
+    }
+  }
+
+  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const PlaneData& planeData)
+  {
+    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
+    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
+    return (cmp_0123 || cmp_4545).NoneSet<4>();
+  }
+
+  /// Returns true if the sphere is completely inside of all six planes.
+  EZ_FORCE_INLINE bool SphereInsideFrustum(const ezSimdBSphere& sphere, const PlaneData& planeData)
+  {
+    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    ezSimdVec4f neg_rrrr = -ezSimdVec4f(sphere.m_CenterAndRadius.w());
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    ezSimdVec4b cmp_0123 = dot_0123 < neg_rrrr;
+    ezSimdVec4b cmp_4545 = dot_4545 < neg_rrrr;
+    return (cmp_0123 && cmp_4545).AllSet<4>();
+  }
+
+  /// Tests four consecutive spheres at once, the spheres are transposed so that every lane holds a different sphere.
+  /// Returns a bitmask with bit N set if sphere N intersects the frustum.
+  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect4(const ezSimdBSphere* pSpheres, const PlaneData& planeData)
+  {
+    ezSimdMat4f spheres;
+    spheres.SetRows(pSpheres[0].m_CenterAndRadius, pSpheres[1].m_CenterAndRadius, pSpheres[2].m_CenterAndRadius, pSpheres[3].m_CenterAndRadius);
+
+    const ezSimdVec4f& pos_xxxx = spheres.m_col0;
+    const ezSimdVec4f& pos_yyyy = spheres.m_col1;
+    const ezSimdVec4f& pos_zzzz = spheres.m_col2;
+    const ezSimdVec4f& pos_rrrr = spheres.m_col3;
+
+    ezSimdVec4b outside(false);
+
+    for (ezUInt32 i = 0; i < 6; ++i)
+    {
+      const ezSimdVec4f* pPlane = planeData.m_Splatted[i];
+
+      ezSimdVec4f dot = ezSimdVec4f::MulAdd(pos_xxxx, pPlane[0], pPlane[3]);
+      dot = ezSimdVec4f::MulAdd(pos_yyyy, pPlane[1], dot);
+      dot = ezSimdVec4f::MulAdd(pos_zzzz, pPlane[2], dot);
+
+      outside = outside || (dot > pos_rrrr);
+    }
+
+    // in most cells all objects are either completely inside or outside
+    if (outside.AllSet<4>())
+      return 0;
+
+    if (outside.NoneSet<4>())
+      return 0xF;
+
+    ezUInt32 result = outside.x() ? 0 : 1;
+    result |= outside.y() ? 0 : 2;
+    result |= outside.z() ? 0 : 4;
+    result |= outside.w() ? 0 : 8;
+
+    return result;
+  }
+
+  /// A ray segment, prepared for fast slab tests against boxes.
+  struct RayData
+  {
+    ezSimdVec4f m_vStart;
+    ezSimdVec4f m_vInvDir;
+    ezSimdFloat m_fMaxDistance;
+    ezSimdVec4b m_bParallel; ///< The axes along which the ray doesn't move.
+  };
+
+  inline void ComputeRayData(const ezVec3& vRayStart, const ezVec3& vRayDir, float fMaxDistance, RayData& out_rayData)
+  {
+    const ezSimdVec4f vDir = ezSimdConversion::ToVec3(vRayDir);
+
+    out_rayData.m_vStart = ezSimdConversion::ToVec3(vRayStart);
+    out_rayData.m_vInvDir = vDir.GetReciprocal();
+    out_rayData.m_fMaxDistance = fMaxDistance;
+    out_rayData.m_bParallel = vDir == ezSimdVec4f::MakeZero();
+  }
+
+  EZ_FORCE_INLINE bool RayBoxIntersect(const RayData& ray, const ezSimdBBox& box)
+  {
+    const ezSimdVec4f t0 = (box.m_Min - ray.m_vStart).CompMul(ray.m_vInvDir);
+    const ezSimdVec4f t1 = (box.m_Max - ray.m_vStart).CompMul(ray.m_vInvDir);
+
+    // A zero direction component gives 0 * inf = NaN if the ray starts exactly on a box plane.
+    // Those axes don't limit the ray segment, instead the start has to be within the slab.
+    const ezSimdVec4f vNear = ezSimdVec4f::Select(ray.m_bParallel, ezSimdVec4f(-ezMath::MaxValue<float>()), t0.CompMin(t1));
+    const ezSimdVec4f vFar = ezSimdVec4f::Select(ray.m_bParallel, ezSimdVec4f(ezMath::MaxValue<float>()), t0.CompMax(t1));
+    const ezSimdVec4b bInsideSlabs = (ray.m_vStart >= box.m_Min && ray.m_vStart <= box.m_Max) || !ray.m_bParallel;
+
+    const ezSimdFloat fNear = vNear.HorizontalMax<3>();
+    const ezSimdFloat fFar = vFar.HorizontalMin<3>();
+
+    return bInsideSlabs.AllSet<3>() && fNear <= fFar && fFar >= ezSimdFloat::MakeZero() && fNear <= ray.m_fMaxDistance;
+  }
+
+  EZ_ALWAYS_INLINE bool FilterByTags(const ezTagSet& tags, const ezTagSet* pIncludeTags, const ezTagSet* pExcludeTags)
+  {
+    if (pExcludeTags != nullptr && !pExcludeTags->IsEmpty() && pExcludeTags->IsAnySet(tags))
+      return true;
+
+    if (pIncludeTags != nullptr && !pIncludeTags->IsEmpty() && !pIncludeTags->IsAnySet(tags))
+      return true;
+
+    return false;
+  }
+} // namespace ezInternal
@@ -47,6 +47,20 @@ void ezSpatialSystem::FindObjectsInBox(const ezBoundingBox& box, const QueryPara
     });
 }
 
+void ezSpatialSystem::FindObjectsAlongRay(const ezVec3& vRayStart, const ezVec3& vRayDir, float fMaxDistance, const QueryParams& queryParams, ezDynamicArray<ezGameObject*>& out_objects) const
+{
+  out_objects.Clear();
+
+  FindObjectsAlongRay(
+    vRayStart, vRayDir, fMaxDistance, queryParams,
+    [&](ezGameObject* pObject)
+    {
+      out_objects.PushBack(pObject);
+
+      return ezVisitorExecution::Continue;
+    });
+}
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 void ezSpatialSystem::GetInternalStats(ezStringBuilder& ref_sSb) const
 {
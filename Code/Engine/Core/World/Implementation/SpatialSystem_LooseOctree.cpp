@@ -0,0 +1,876 @@
+#include <Core/CorePCH.h>
+
+#include <Core/World/Implementation/SpatialQueryUtils.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+
+using ezInternal::FilterByTags;
+
+namespace
+{
+  enum
+  {
+    ROOT_NODE_INDEX = 0,
+    NODE_FULLY_INSIDE = EZ_BIT(0),
+  };
+
+  EZ_ALWAYS_INLINE ezUInt32 GetChildIndex(const ezSimdVec4f& vNodeCenter, const ezSimdVec4f& vPosition)
+  {
+    const ezSimdVec4b cmp = vPosition >= vNodeCenter;
+
+    ezUInt32 uiChildIndex = cmp.x() ? 1 : 0;
+    uiChildIndex |= cmp.y() ? 2 : 0;
+    uiChildIndex |= cmp.z() ? 4 : 0;
+    return uiChildIndex;
+  }
+
+  EZ_ALWAYS_INLINE ezSimdVec4f GetChildCenter(const ezSimdVec4f& vNodeCenter, const ezSimdFloat& fChildHalfExtent, ezUInt32 uiChildIndex)
+  {
+    const ezSimdVec4f vSign((uiChildIndex & 1) ? 1.0f : -1.0f, (uiChildIndex & 2) ? 1.0f : -1.0f, (uiChildIndex & 4) ? 1.0f : -1.0f, 0.0f);
+    return ezSimdVec4f::MulAdd(vSign, ezSimdVec4f(fChildHalfExtent), vNodeCenter);
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_LooseOctree::Node
+{
+  Node(ezAllocator* pAlignedAlloctor, ezAllocator* pAllocator)
+    : m_BoundingSpheres(pAlignedAlloctor)
+    , m_BoundingBoxHalfExtents(pAlignedAlloctor)
+    , m_TagSets(pAllocator)
+    , m_ObjectPointers(pAllocator)
+    , m_DataIndices(pAllocator)
+  {
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      m_ChildIndices[i] = ezInvalidIndex;
+    }
+  }
+
+  EZ_FORCE_INLINE ezUInt32 AddData(const ezSimdBBoxSphere& bounds, const ezTagSet& tags, ezGameObject* pObject, ezUInt64 uiLastVisibleFrameIdxAndVisType, ezUInt32 uiDataIndex)
+  {
+    m_BoundingSpheres.PushBack(bounds.GetSphere());
+    m_BoundingBoxHalfExtents.PushBack(bounds.m_BoxHalfExtents);
+    m_TagSets.PushBack(tags);
+    m_ObjectPointers.PushBack(pObject);
+    m_DataIndices.PushBack(uiDataIndex);
+    m_LastVisibleFrameIdxAndVisType.PushBack(uiLastVisibleFrameIdxAndVisType);
+
+    return m_BoundingSpheres.GetCount() - 1;
+  }
+
+  // Returns the data index of the moved data
+  EZ_FORCE_INLINE ezUInt32 RemoveData(ezUInt32 uiNodeDataIndex)
+  {
+    ezUInt32 uiMovedDataIndex = m_DataIndices.PeekBack();
+
+    m_BoundingSpheres.RemoveAtAndSwap(uiNodeDataIndex);
+    m_BoundingBoxHalfExtents.RemoveAtAndSwap(uiNodeDataIndex);
+    m_TagSets.RemoveAtAndSwap(uiNodeDataIndex);
+    m_ObjectPointers.RemoveAtAndSwap(uiNodeDataIndex);
+    m_DataIndices.RemoveAtAndSwap(uiNodeDataIndex);
+    m_LastVisibleFrameIdxAndVisType.RemoveAtAndSwap(uiNodeDataIndex);
+
+    EZ_ASSERT_DEBUG(m_DataIndices.GetCount() == uiNodeDataIndex || m_DataIndices[uiNodeDataIndex] == uiMovedDataIndex, "Implementation error");
+
+    return uiMovedDataIndex;
+  }
+
+  EZ_ALWAYS_INLINE ezBoundingBox GetBoundingBox() const { return ezSimdConversion::ToBBox(m_LooseBounds); }
+
+  ezSimdVec4f m_vCenter;
+  ezSimdBBox m_LooseBounds;
+  ezSimdBSphere m_LooseSphere;
+
+  ezUInt32 m_uiParentIndex = ezInvalidIndex;
+  ezUInt32 m_ChildIndices[8];
+  ezUInt32 m_uiDepth = 0;
+
+  // Number of objects in this node and all its children, empty nodes are removed
+  ezUInt32 m_uiNumObjectsInSubTree = 0;
+
+  ezDynamicArray<ezSimdBSphere> m_BoundingSpheres;
+  ezDynamicArray<ezSimdVec4f> m_BoundingBoxHalfExtents;
+  ezDynamicArray<ezTagSet> m_TagSets;
+  ezDynamicArray<ezGameObject*> m_ObjectPointers;
+  mutable ezDynamicArray<ezAtomicInteger64> m_LastVisibleFrameIdxAndVisType;
+  ezDynamicArray<ezUInt32> m_DataIndices;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_LooseOctree::Stats
+{
+  ezUInt32 m_uiNumObjectsTested = 0;
+  ezUInt32 m_uiNumObjectsPassed = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_LooseOctree::Tree
+{
+  struct NodeDataMapping
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNodeIndex = ezInvalidIndex;
+    ezUInt32 m_uiNodeDataIndex = ezInvalidIndex;
+  };
+
+  Tree(ezSpatialSystem_LooseOctree& ref_system, ezSpatialData::Category category)
+    : m_System(ref_system)
+    , m_Nodes(&ref_system.m_Allocator)
+    , m_FreeNodeIndices(&ref_system.m_Allocator)
+    , m_NodeDataMappings(&ref_system.m_Allocator)
+    , m_Category(category)
+  {
+    // The root node accepts everything, objects that are outside of its area simply stay in it
+    const ezSimdFloat fHugeExtent = ref_system.m_fRootHalfExtent * 1024.0f;
+
+    Node& root = *m_Nodes[CreateNode(ezInvalidIndex, ezSimdVec4f::MakeZero(), 0)];
+    root.m_LooseBounds = ezSimdBBox::MakeFromCenterAndHalfExtents(ezSimdVec4f::MakeZero(), ezSimdVec4f(fHugeExtent));
+    root.m_LooseSphere = ezSimdBSphere(ezSimdVec4f::MakeZero(), fHugeExtent * ezSimdFloat(ezMath::Sqrt(3.0f)));
+  }
+
+  EZ_ALWAYS_INLINE ezSimdFloat GetHalfExtent(ezUInt32 uiDepth) const
+  {
+    return m_System.m_fRootHalfExtent / static_cast<float>(1u << uiDepth);
+  }
+
+  ezUInt32 CreateNode(ezUInt32 uiParentIndex, const ezSimdVec4f& vCenter, ezUInt32 uiDepth)
+  {
+    ezUInt32 uiNodeIndex = ezInvalidIndex;
+    if (!m_FreeNodeIndices.IsEmpty())
+    {
+      uiNodeIndex = m_FreeNodeIndices.PeekBack();
+      m_FreeNodeIndices.PopBack();
+    }
+    else
+    {
+      uiNodeIndex = m_Nodes.GetCount();
+      m_Nodes.ExpandAndGetRef();
+    }
+
+    // deleted nodes are kept alive to reuse the memory of their arrays
+    if (m_Nodes[uiNodeIndex] == nullptr)
+    {
+      m_Nodes[uiNodeIndex] = EZ_NEW(&m_System.m_AlignedAllocator, Node, &m_System.m_AlignedAllocator, &m_System.m_Allocator);
+    }
+
+    Node& node = *m_Nodes[uiNodeIndex];
+    node.m_vCenter = vCenter;
+    node.m_uiParentIndex = uiParentIndex;
+    node.m_uiDepth = uiDepth;
+
+    const ezSimdFloat fLooseHalfExtent = GetHalfExtent(uiDepth) * ezSimdFloat(2.0f);
+    node.m_LooseBounds = ezSimdBBox::MakeFromCenterAndHalfExtents(vCenter, ezSimdVec4f(fLooseHalfExtent));
+    node.m_LooseSphere = ezSimdBSphere(vCenter, fLooseHalfExtent * ezSimdFloat(ezMath::Sqrt(3.0f)));
+
+    ++m_uiNumActiveNodes;
+
+    return uiNodeIndex;
+  }
+
+  void DeleteNode(ezUInt32 uiNodeIndex)
+  {
+    EZ_ASSERT_DEBUG(uiNodeIndex != ROOT_NODE_INDEX, "The root node must not be deleted");
+
+    Node& node = *m_Nodes[uiNodeIndex];
+    EZ_ASSERT_DEBUG(node.m_BoundingSpheres.IsEmpty(), "Only empty nodes can be deleted");
+
+    node.m_uiParentIndex = ezInvalidIndex;
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      node.m_ChildIndices[i] = ezInvalidIndex;
+    }
+
+    m_FreeNodeIndices.PushBack(uiNodeIndex);
+
+    --m_uiNumActiveNodes;
+  }
+
+  // Returns the depth of the node that the given bounds belong into
+  ezUInt32 GetTargetDepth(const ezSimdBBoxSphere& bounds) const
+  {
+    // objects with their center outside of the root area can't be sorted into any child
+    if (!(bounds.m_CenterAndRadius.Abs() < ezSimdVec4f(m_System.m_fRootHalfExtent)).AllSet<3>())
+      return 0;
+
+    // An object fits into a node if it is not bigger than the node itself, the loose bounds take care of the rest.
+    // Use the sphere radius and not the box extents, since queries test against the bounding sphere.
+    const ezSimdFloat fObjectHalfExtent = bounds.m_CenterAndRadius.w();
+
+    ezUInt32 uiDepth = 0;
+    while (uiDepth < m_System.m_uiMaxDepth && fObjectHalfExtent <= GetHalfExtent(uiDepth + 1))
+    {
+      ++uiDepth;
+    }
+
+    return uiDepth;
+  }
+
+  // Walks down from the root towards the node at the given depth. Returns ezInvalidIndex if that node does not exist.
+  ezUInt32 FindNode(const ezSimdVec4f& vCenter, ezUInt32 uiTargetDepth) const
+  {
+    ezUInt32 uiNodeIndex = ROOT_NODE_INDEX;
+
+    for (ezUInt32 uiDepth = 1; uiDepth <= uiTargetDepth && uiNodeIndex != ezInvalidIndex; ++uiDepth)
+    {
+      const Node& node = *m_Nodes[uiNodeIndex];
+      uiNodeIndex = node.m_ChildIndices[GetChildIndex(node.m_vCenter, vCenter)];
+    }
+
+    return uiNodeIndex;
+  }
+
+  ezUInt32 GetOrCreateNode(const ezSimdVec4f& vCenter, ezUInt32 uiTargetDepth)
+  {
+    ezUInt32 uiNodeIndex = ROOT_NODE_INDEX;
+
+    for (ezUInt32 uiDepth = 1; uiDepth <= uiTargetDepth; ++uiDepth)
+    {
+      const Node& node = *m_Nodes[uiNodeIndex];
+      const ezUInt32 uiChildIndex = GetChildIndex(node.m_vCenter, vCenter);
+
+      ezUInt32 uiChildNodeIndex = node.m_ChildIndices[uiChildIndex];
+      if (uiChildNodeIndex == ezInvalidIndex)
+      {
+        const ezSimdVec4f vChildCenter = GetChildCenter(node.m_vCenter, GetHalfExtent(uiDepth), uiChildIndex);
+
+        // CreateNode may reallocate m_Nodes, so the parent must be looked up again afterwards
+        uiChildNodeIndex = CreateNode(uiNodeIndex, vChildCenter, uiDepth);
+        m_Nodes[uiNodeIndex]->m_ChildIndices[uiChildIndex] = uiChildNodeIndex;
+      }
+
+      uiNodeIndex = uiChildNodeIndex;
+    }
+
+    return uiNodeIndex;
+  }
+
+  void AddSpatialData(const ezSimdBBoxSphere& bounds, const ezTagSet& tags, ezGameObject* pObject, ezUInt64 uiLastVisibleFrameIdxAndVisType, const ezSpatialDataHandle& hData)
+  {
+    ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+    ezUInt32 uiNodeIndex = GetOrCreateNode(bounds.m_CenterAndRadius, GetTargetDepth(bounds));
+    ezUInt32 uiNodeDataIndex = m_Nodes[uiNodeIndex]->AddData(bounds, tags, pObject, uiLastVisibleFrameIdxAndVisType, uiDataIndex);
+
+    for (ezUInt32 i = uiNodeIndex; i != ezInvalidIndex; i = m_Nodes[i]->m_uiParentIndex)
+    {
+      ++m_Nodes[i]->m_uiNumObjectsInSubTree;
+    }
+
+    m_NodeDataMappings.EnsureCount(uiDataIndex + 1);
+    EZ_ASSERT_DEBUG(m_NodeDataMappings[uiDataIndex].m_uiNodeIndex == ezInvalidIndex, "data has already been added to a node");
+    m_NodeDataMappings[uiDataIndex] = {uiNodeIndex, uiNodeDataIndex};
+  }
+
+  void RemoveSpatialData(const ezSpatialDataHandle& hData)
+  {
+    ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+    auto& mapping = m_NodeDataMappings[uiDataIndex];
+    const ezUInt32 uiNodeIndex = mapping.m_uiNodeIndex;
+
+    ezUInt32 uiMovedDataIndex = m_Nodes[uiNodeIndex]->RemoveData(mapping.m_uiNodeDataIndex);
+    if (uiMovedDataIndex != uiDataIndex)
+    {
+      m_NodeDataMappings[uiMovedDataIndex].m_uiNodeDataIndex = mapping.m_uiNodeDataIndex;
+    }
+
+    mapping = {};
+
+    // update the object counts and remove nodes that became empty
+    ezUInt32 i = uiNodeIndex;
+    while (i != ezInvalidIndex)
+    {
+      Node& node = *m_Nodes[i];
+      const ezUInt32 uiParentIndex = node.m_uiParentIndex;
+
+      if (--node.m_uiNumObjectsInSubTree == 0 && i != ROOT_NODE_INDEX)
+      {
+        Node& parent = *m_Nodes[uiParentIndex];
+        for (ezUInt32 c = 0; c < 8; ++c)
+        {
+          if (parent.m_ChildIndices[c] == i)
+          {
+            parent.m_ChildIndices[c] = ezInvalidIndex;
+            break;
+          }
+        }
+
+        DeleteNode(i);
+      }
+
+      i = uiParentIndex;
+    }
+  }
+
+  template <typename Functor>
+  EZ_FORCE_INLINE void Traverse(Functor func) const
+  {
+    struct StackEntry
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt32 m_uiNodeIndex;
+      ezUInt32 m_uiFlags;
+    };
+
+    ezHybridArray<StackEntry, 128> stack;
+    stack.PushBack({ROOT_NODE_INDEX, 0});
+
+    while (!stack.IsEmpty())
+    {
+      const StackEntry entry = stack.PeekBack();
+      stack.PopBack();
+
+      const Node& node = *m_Nodes[entry.m_uiNodeIndex];
+      ezUInt32 uiFlags = entry.m_uiFlags;
+
+      const ezVisitorExecution::Enum res = func(node, uiFlags);
+      if (res == ezVisitorExecution::Stop)
+        return;
+
+      if (res == ezVisitorExecution::Skip)
+        continue;
+
+      for (ezUInt32 c = 0; c < 8; ++c)
+      {
+        if (node.m_ChildIndices[c] != ezInvalidIndex)
+        {
+          stack.PushBack({node.m_ChildIndices[c], uiFlags});
+        }
+      }
+    }
+  }
+
+  template <typename Shape, bool UseTagsFilter>
+  void FindObjectsInShape(const Shape& shape, const QueryParams& queryParams, Stats& ref_stats, QueryCallback callback) const
+  {
+    Traverse(
+      [&](const Node& node, ezUInt32& inout_uiFlags)
+      {
+        if (!node.m_LooseBounds.Overlaps(shape))
+          return ezVisitorExecution::Skip;
+
+        auto boundingSpheres = node.m_BoundingSpheres.GetData();
+        auto tagSets = node.m_TagSets.GetData();
+        auto objectPointers = node.m_ObjectPointers.GetData();
+
+        const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+        ref_stats.m_uiNumObjectsTested += numSpheres;
+
+        for (ezUInt32 i = 0; i < numSpheres; ++i)
+        {
+          if (!shape.Overlaps(boundingSpheres[i]))
+            continue;
+
+          if constexpr (UseTagsFilter)
+          {
+            if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+              continue;
+          }
+
+          ref_stats.m_uiNumObjectsPassed++;
+
+          if (callback(objectPointers[i]) == ezVisitorExecution::Stop)
+            return ezVisitorExecution::Stop;
+        }
+
+        return ezVisitorExecution::Continue;
+      });
+  }
+
+  template <bool UseTagsFilter>
+  void FindObjectsAlongRay(const ezInternal::RayData& ray, const QueryParams& queryParams, Stats& ref_stats, QueryCallback callback) const
+  {
+    Traverse(
+      [&](const Node& node, ezUInt32& inout_uiFlags)
+      {
+        if (!ezInternal::RayBoxIntersect(ray, node.m_LooseBounds))
+          return ezVisitorExecution::Skip;
+
+        auto boundingSpheres = node.m_BoundingSpheres.GetData();
+        auto boundingBoxHalfExtents = node.m_BoundingBoxHalfExtents.GetData();
+        auto tagSets = node.m_TagSets.GetData();
+        auto objectPointers = node.m_ObjectPointers.GetData();
+
+        const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+        ref_stats.m_uiNumObjectsTested += numSpheres;
+
+        for (ezUInt32 i = 0; i < numSpheres; ++i)
+        {
+          const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
+          if (!ezInternal::RayBoxIntersect(ray, bbox))
+            continue;
+
+          if constexpr (UseTagsFilter)
+          {
+            if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+              continue;
+          }
+
+          ref_stats.m_uiNumObjectsPassed++;
+
+          if (callback(objectPointers[i]) == ezVisitorExecution::Stop)
+            return ezVisitorExecution::Stop;
+        }
+
+        return ezVisitorExecution::Continue;
+      });
+  }
+
+  template <bool UseTagsFilter, bool UseOcclusionCallback>
+  void FindVisibleObjects(const ezInternal::PlaneData& planeData, const QueryParams& queryParams, Stats& ref_stats, ezDynamicArray<const ezGameObject*>& out_objects, IsOccludedFunc isOccluded, ezUInt64 uiFrameIdxAndType) const
+  {
+    Traverse(
+      [&](const Node& node, ezUInt32& inout_uiFlags)
+      {
+        // nothing to test if a parent node was already completely inside of the frustum
+        if ((inout_uiFlags & NODE_FULLY_INSIDE) == 0)
+        {
+          if (!ezInternal::SphereFrustumIntersect(node.m_LooseSphere, planeData))
+            return ezVisitorExecution::Skip;
+
+          if (ezInternal::SphereInsideFrustum(node.m_LooseSphere, planeData))
+          {
+            inout_uiFlags |= NODE_FULLY_INSIDE;
+          }
+        }
+
+        if constexpr (UseOcclusionCallback)
+        {
+          if (isOccluded(node.m_LooseBounds))
+            return ezVisitorExecution::Skip;
+        }
+
+        auto boundingSpheres = node.m_BoundingSpheres.GetData();
+        auto boundingBoxHalfExtents = node.m_BoundingBoxHalfExtents.GetData();
+        auto tagSets = node.m_TagSets.GetData();
+        auto objectPointers = node.m_ObjectPointers.GetData();
+        auto lastVisibleFrameIdxAndVisType = node.m_LastVisibleFrameIdxAndVisType.GetData();
+
+        const ezUInt32 numSpheres = node.m_BoundingSpheres.GetCount();
+        ref_stats.m_uiNumObjectsTested += numSpheres;
+
+        auto AddVisibleObject = [&](ezUInt32 i)
+        {
+          if constexpr (UseTagsFilter)
+          {
+            if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+              return;
+          }
+
+          if constexpr (UseOcclusionCallback)
+          {
+            const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
+            if (isOccluded(bbox))
+              return;
+          }
+
+          lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
+          out_objects.PushBack(objectPointers[i]);
+
+          ref_stats.m_uiNumObjectsPassed++;
+        };
+
+        if (inout_uiFlags & NODE_FULLY_INSIDE)
+        {
+          for (ezUInt32 i = 0; i < numSpheres; ++i)
+          {
+            AddVisibleObject(i);
+          }
+
+          return ezVisitorExecution::Continue;
+        }
+
+        ezUInt32 currentIndex = 0;
+        for (; currentIndex + 4 <= numSpheres; currentIndex += 4)
+        {
+          ezUInt32 mask = ezInternal::SphereFrustumIntersect4(boundingSpheres + currentIndex, planeData);
+
+          while (mask > 0)
+          {
+            const ezUInt32 i = ezMath::FirstBitLow(mask) + currentIndex;
+            mask &= mask - 1;
+
+            AddVisibleObject(i);
+          }
+        }
+
+        for (; currentIndex < numSpheres; ++currentIndex)
+        {
+          if (ezInternal::SphereFrustumIntersect(boundingSpheres[currentIndex], planeData))
+          {
+            AddVisibleObject(currentIndex);
+          }
+        }
+
+        return ezVisitorExecution::Continue;
+      });
+  }
+
+  ezSpatialSystem_LooseOctree& m_System;
+  ezDynamicArray<ezUniquePtr<Node>> m_Nodes;
+  ezDynamicArray<ezUInt32> m_FreeNodeIndices;
+  ezDynamicArray<NodeDataMapping> m_NodeDataMappings;
+  ezUInt32 m_uiNumActiveNodes = 0;
+
+  ezSpatialData::Category m_Category;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem_LooseOctree, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezSpatialSystem_LooseOctree::ezSpatialSystem_LooseOctree(float fRootHalfExtent /*= 32768.0f*/, ezUInt32 uiMaxDepth /*= 12*/)
+  : m_AlignedAllocator("Spatial System Aligned", ezFoundation::GetAlignedAllocator())
+  , m_fRootHalfExtent(fRootHalfExtent)
+  , m_uiMaxDepth(ezMath::Min<ezUInt32>(uiMaxDepth, 24))
+  , m_Trees(&m_Allocator)
+  , m_DataTable(&m_Allocator)
+{
+  EZ_CHECK_AT_COMPILETIME(sizeof(Data) == 8);
+
+  m_Trees.SetCount(MAX_NUM_TREES);
+}
+
+ezSpatialSystem_LooseOctree::~ezSpatialSystem_LooseOctree() = default;
+
+void ezSpatialSystem_LooseOctree::GetAllNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezSpatialData::Category filterCategory /*= ezInvalidSpatialDataCategory*/) const
+{
+  for (ezUInt32 uiTreeIndex = 0; uiTreeIndex < m_Trees.GetCount(); ++uiTreeIndex)
+  {
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr)
+      continue;
+
+    if (filterCategory != ezInvalidSpatialDataCategory && filterCategory.m_uiValue != uiTreeIndex)
+      continue;
+
+    // the root node is skipped since it has no meaningful bounds
+    for (ezUInt32 uiNodeIndex = ROOT_NODE_INDEX + 1; uiNodeIndex < pTree->m_Nodes.GetCount(); ++uiNodeIndex)
+    {
+      auto& pNode = pTree->m_Nodes[uiNodeIndex];
+      if (!pNode->m_BoundingSpheres.IsEmpty())
+      {
+        out_boundingBoxes.PushBack(pNode->GetBoundingBox());
+      }
+    }
+  }
+}
+
+ezSpatialDataHandle ezSpatialSystem_LooseOctree::CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  Data data;
+  data.m_uiCategoryBitmask = uiCategoryBitmask;
+  data.m_uiAlwaysVisible = 0;
+
+  auto hData = ezSpatialDataHandle(m_DataTable.Insert(data));
+
+  ezUInt32 uiTreeBitmask = uiCategoryBitmask;
+  while (uiTreeBitmask > 0)
+  {
+    ezUInt32 uiTreeIndex = ezMath::FirstBitLow(uiTreeBitmask);
+    uiTreeBitmask &= uiTreeBitmask - 1;
+
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr)
+    {
+      pTree = EZ_NEW(&m_Allocator, Tree, *this, ezSpatialData::Category(static_cast<ezUInt16>(uiTreeIndex)));
+    }
+
+    pTree->AddSpatialData(bounds, tags, pObject, m_uiFrameCounter, hData);
+  }
+
+  return hData;
+}
+
+ezSpatialDataHandle ezSpatialSystem_LooseOctree::CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  const ezSimdBBox hugeBox = ezSimdBBox::MakeFromCenterAndHalfExtents(ezSimdVec4f::MakeZero(), ezSimdVec4f(m_fRootHalfExtent * 1024.0f));
+
+  ezSpatialDataHandle hData = CreateSpatialData(hugeBox, pObject, uiCategoryBitmask, tags);
+
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Implementation error");
+  pData->m_uiAlwaysVisible = 1;
+
+  return hData;
+}
+
+void ezSpatialSystem_LooseOctree::DeleteSpatialData(const ezSpatialDataHandle& hData)
+{
+  Data oldData;
+  EZ_VERIFY(m_DataTable.Remove(hData.GetInternalID(), &oldData), "Invalid spatial data handle");
+
+  ForEachTree(oldData,
+    [&](Tree& ref_tree)
+    {
+      ref_tree.RemoveSpatialData(hData);
+    });
+}
+
+void ezSpatialSystem_LooseOctree::UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  if (pData->m_uiAlwaysVisible != 0)
+    return;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ForEachTree(*pData,
+    [&](Tree& ref_tree)
+    {
+      const Tree::NodeDataMapping mapping = ref_tree.m_NodeDataMappings[uiDataIndex];
+      Node& oldNode = *ref_tree.m_Nodes[mapping.m_uiNodeIndex];
+
+      // Most moving objects stay in their node
+      if (ref_tree.FindNode(bounds.m_CenterAndRadius, ref_tree.GetTargetDepth(bounds)) == mapping.m_uiNodeIndex)
+      {
+        oldNode.m_BoundingSpheres[mapping.m_uiNodeDataIndex] = bounds.GetSphere();
+        oldNode.m_BoundingBoxHalfExtents[mapping.m_uiNodeDataIndex] = bounds.m_BoxHalfExtents;
+        return;
+      }
+
+      const ezTagSet tags = oldNode.m_TagSets[mapping.m_uiNodeDataIndex];
+      ezGameObject* objectPointer = oldNode.m_ObjectPointers[mapping.m_uiNodeDataIndex];
+      const ezUInt64 uiLastVisibleFrameIdxAndVisType = oldNode.m_LastVisibleFrameIdxAndVisType[mapping.m_uiNodeDataIndex];
+
+      ref_tree.RemoveSpatialData(hData);
+
+      ref_tree.AddSpatialData(bounds, tags, objectPointer, uiLastVisibleFrameIdxAndVisType, hData);
+    });
+}
+
+void ezSpatialSystem_LooseOctree::UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ForEachTree(*pData,
+    [&](Tree& ref_tree)
+    {
+      const Tree::NodeDataMapping& mapping = ref_tree.m_NodeDataMappings[uiDataIndex];
+      ref_tree.m_Nodes[mapping.m_uiNodeIndex]->m_ObjectPointers[mapping.m_uiNodeDataIndex] = pObject;
+    });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInSphere");
+
+  const ezSimdBSphere simdSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+
+  ForEachMatchingTree(queryParams,
+    [&](const Tree& tree, bool bUseTagsFilter, Stats& ref_stats)
+    {
+      if (bUseTagsFilter)
+        tree.FindObjectsInShape<ezSimdBSphere, true>(simdSphere, queryParams, ref_stats, callback);
+      else
+        tree.FindObjectsInShape<ezSimdBSphere, false>(simdSphere, queryParams, ref_stats, callback);
+    });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInBox");
+
+  const ezSimdBBox simdBox(ezSimdConversion::ToVec3(box.m_vMin), ezSimdConversion::ToVec3(box.m_vMax));
+
+  ForEachMatchingTree(queryParams,
+    [&](const Tree& tree, bool bUseTagsFilter, Stats& ref_stats)
+    {
+      if (bUseTagsFilter)
+        tree.FindObjectsInShape<ezSimdBBox, true>(simdBox, queryParams, ref_stats, callback);
+      else
+        tree.FindObjectsInShape<ezSimdBBox, false>(simdBox, queryParams, ref_stats, callback);
+    });
+}
+
+void ezSpatialSystem_LooseOctree::FindObjectsAlongRay(const ezVec3& vRayStart, const ezVec3& vRayDir, float fMaxDistance, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsAlongRay");
+
+  ezInternal::RayData ray;
+  ezInternal::ComputeRayData(vRayStart, vRayDir, fMaxDistance, ray);
+
+  ForEachMatchingTree(queryParams,
+    [&](const Tree& tree, bool bUseTagsFilter, Stats& ref_stats)
+    {
+      if (bUseTagsFilter)
+        tree.FindObjectsAlongRay<true>(ray, queryParams, ref_stats, callback);
+      else
+        tree.FindObjectsAlongRay<false>(ray, queryParams, ref_stats, callback);
+    });
+}
+
+void ezSpatialSystem_LooseOctree::FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const
+{
+  EZ_PROFILE_SCOPE("FindVisibleObjects");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  ezInternal::PlaneData planeData;
+  ezInternal::ComputePlaneData(frustum, planeData);
+
+  const ezUInt64 uiFrameIdxAndType = (m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
+  const bool bUseOcclusionCallback = IsOccluded.IsValid();
+
+  ForEachMatchingTree(queryParams,
+    [&](const Tree& tree, bool bUseTagsFilter, Stats& ref_stats)
+    {
+      if (bUseOcclusionCallback)
+      {
+        if (bUseTagsFilter)
+          tree.FindVisibleObjects<true, true>(planeData, queryParams, ref_stats, out_Objects, IsOccluded, uiFrameIdxAndType);
+        else
+          tree.FindVisibleObjects<false, true>(planeData, queryParams, ref_stats, out_Objects, IsOccluded, uiFrameIdxAndType);
+      }
+      else
+      {
+        if (bUseTagsFilter)
+          tree.FindVisibleObjects<true, false>(planeData, queryParams, ref_stats, out_Objects, IsOccluded, uiFrameIdxAndType);
+        else
+          tree.FindVisibleObjects<false, false>(planeData, queryParams, ref_stats, out_Objects, IsOccluded, uiFrameIdxAndType);
+      }
+    });
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+ezVisibilityState ezSpatialSystem_LooseOctree::GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  if (pData->m_uiAlwaysVisible != 0)
+    return ezVisibilityState::Direct;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ezUInt64 uiLastVisibleFrameIdxAndVisType = 0;
+  ForEachTree(*pData,
+    [&](const Tree& tree)
+    {
+      const Tree::NodeDataMapping& mapping = tree.m_NodeDataMappings[uiDataIndex];
+      const Node& node = *tree.m_Nodes[mapping.m_uiNodeIndex];
+      uiLastVisibleFrameIdxAndVisType = ezMath::Max<ezUInt64>(uiLastVisibleFrameIdxAndVisType, node.m_LastVisibleFrameIdxAndVisType[mapping.m_uiNodeDataIndex]);
+    });
+
+  const ezUInt64 uiLastVisibleFrameIdx = (uiLastVisibleFrameIdxAndVisType >> 4);
+  const ezUInt64 uiLastVisibilityType = (uiLastVisibleFrameIdxAndVisType & static_cast<ezUInt64>(15)); // mask out lower 4 bits
+
+  if (m_uiFrameCounter > uiLastVisibleFrameIdx + uiNumFramesBeforeInvisible)
+    return ezVisibilityState::Invisible;
+
+  return static_cast<ezVisibilityState>(uiLastVisibilityType);
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+void ezSpatialSystem_LooseOctree::GetInternalStats(ezStringBuilder& sb) const
+{
+  ezUInt32 uiNumActiveTrees = 0;
+  for (auto& pTree : m_Trees)
+  {
+    uiNumActiveTrees += (pTree != nullptr) ? 1 : 0;
+  }
+
+  sb.SetFormat("Num Trees: {}\n", uiNumActiveTrees);
+
+  for (auto& pTree : m_Trees)
+  {
+    if (pTree == nullptr)
+      continue;
+
+    ezUInt32 uiMaxUsedDepth = 0;
+    ezUInt32 uiNumObjectsInRoot = pTree->m_Nodes[ROOT_NODE_INDEX]->m_BoundingSpheres.GetCount();
+    for (auto& pNode : pTree->m_Nodes)
+    {
+      if (pNode->m_uiNumObjectsInSubTree > 0)
+      {
+        uiMaxUsedDepth = ezMath::Max(uiMaxUsedDepth, pNode->m_uiDepth);
+      }
+    }
+
+    sb.AppendFormat(" \nCategory: {}\nNodes: {}, Max Depth: {}, Objects: {} ({} in root)\n", ezSpatialData::GetCategoryName(pTree->m_Category),
+      pTree->m_uiNumActiveNodes, uiMaxUsedDepth, pTree->m_Nodes[ROOT_NODE_INDEX]->m_uiNumObjectsInSubTree, uiNumObjectsInRoot);
+  }
+}
+#endif
+
+template <typename Functor>
+EZ_FORCE_INLINE void ezSpatialSystem_LooseOctree::ForEachTree(const Data& data, Functor func) const
+{
+  ezUInt32 uiTreeBitmask = data.m_uiCategoryBitmask;
+
+  while (uiTreeBitmask > 0)
+  {
+    ezUInt32 uiTreeIndex = ezMath::FirstBitLow(uiTreeBitmask);
+    uiTreeBitmask &= uiTreeBitmask - 1;
+
+    func(*m_Trees[uiTreeIndex]);
+  }
+}
+
+template <typename Functor>
+EZ_FORCE_INLINE void ezSpatialSystem_LooseOctree::ForEachMatchingTree(const QueryParams& queryParams, Functor func) const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+  }
+#endif
+
+  const bool bUseTagsFilter = (queryParams.m_pIncludeTags && queryParams.m_pIncludeTags->IsEmpty() == false) || (queryParams.m_pExcludeTags && queryParams.m_pExcludeTags->IsEmpty() == false);
+
+  ezUInt32 uiTreeBitmask = queryParams.m_uiCategoryBitmask;
+  while (uiTreeBitmask > 0)
+  {
+    ezUInt32 uiTreeIndex = ezMath::FirstBitLow(uiTreeBitmask);
+    uiTreeBitmask &= uiTreeBitmask - 1;
+
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr)
+      continue;
+
+    Stats stats;
+    func(*pTree, bUseTagsFilter, stats);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (queryParams.m_pStats != nullptr)
+    {
+      queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+      queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+    }
+#endif
+  }
+}
+
+EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_LooseOctree);
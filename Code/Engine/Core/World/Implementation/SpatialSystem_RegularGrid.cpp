@@ -1,25 +1,17 @@
 #include <Core/CorePCH.h>
 
+#include <Core/World/Implementation/SpatialQueryUtils.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 
 ezCVarInt cvar_SpatialQueriesCachingThreshold("Spatial.Queries.CachingThreshold", 100, ezCVarFlags::Default, "Number of objects that are tested for a query before it is considered for caching");
+ezCVarInt cvar_SpatialQueriesParallelThreshold("Spatial.Queries.ParallelThreshold", 4096, ezCVarFlags::Default, "Number of objects in the visited cells above which visibility queries are split across worker threads. 0 disables multi-threading.");
 
-struct PlaneData
-{
-  ezSimdVec4f m_x0x1x2x3;
-  ezSimdVec4f m_y0y1y2y3;
-  ezSimdVec4f m_z0z1z2z3;
-  ezSimdVec4f m_w0w1w2w3;
-
-  ezSimdVec4f m_x4x5x4x5;
-  ezSimdVec4f m_y4y5y4y5;
-  ezSimdVec4f m_z4z5z4z5;
-  ezSimdVec4f m_w4w5w4w5;
-};
+using ezInternal::FilterByTags;
 
 namespace
 {
@@ -70,17 +62,6 @@ namespace
     return a.IsEmpty();
   }
 
-  EZ_ALWAYS_INLINE bool FilterByTags(const ezTagSet& tags, const ezTagSet* pIncludeTags, const ezTagSet* pExcludeTags)
-  {
-    if (pExcludeTags != nullptr && !pExcludeTags->IsEmpty() && pExcludeTags->IsAnySet(tags))
-      return true;
-
-    if (pIncludeTags != nullptr && !pIncludeTags->IsEmpty() && !pIncludeTags->IsAnySet(tags))
-      return true;
-
-    return false;
-  }
-
   EZ_ALWAYS_INLINE bool CanBeCached(ezSpatialData::Category category)
   {
     return ezSpatialData::GetCategoryFlags(category).IsSet(ezSpatialData::Flags::FrequentChanges) == false;
@@ -106,73 +87,6 @@ namespace
     out_sSb.Append(" }");
   }
 #endif
-
-  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const PlaneData& planeData)
-  {
-    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
-    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
-    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
-    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
-
-    ezSimdVec4f dot_0123;
-    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
-
-    ezSimdVec4f dot_4545;
-    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
-
-    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
-    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
-    return (cmp_0123 || cmp_4545).NoneSet<4>();
-  }
-
-  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const ezSimdBSphere& sphereA, const ezSimdBSphere& sphereB, const PlaneData& planeData)
-  {
-    ezSimdVec4f posA_xxxx(sphereA.m_CenterAndRadius.x());
-    ezSimdVec4f posA_yyyy(sphereA.m_CenterAndRadius.y());
-    ezSimdVec4f posA_zzzz(sphereA.m_CenterAndRadius.z());
-    ezSimdVec4f posA_rrrr(sphereA.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotA_0123;
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_yyyy, planeData.m_y0y1y2y3, dotA_0123);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_zzzz, planeData.m_z0z1z2z3, dotA_0123);
-
-    ezSimdVec4f posB_xxxx(sphereB.m_CenterAndRadius.x());
-    ezSimdVec4f posB_yyyy(sphereB.m_CenterAndRadius.y());
-    ezSimdVec4f posB_zzzz(sphereB.m_CenterAndRadius.z());
-    ezSimdVec4f posB_rrrr(sphereB.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotB_0123;
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_yyyy, planeData.m_y0y1y2y3, dotB_0123);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_zzzz, planeData.m_z0z1z2z3, dotB_0123);
-
-    ezSimdVec4f posAB_xxxx = posA_xxxx.GetCombined<ezSwizzle::XXXX>(posB_xxxx);
-    ezSimdVec4f posAB_yyyy = posA_yyyy.GetCombined<ezSwizzle::XXXX>(posB_yyyy);
-    ezSimdVec4f posAB_zzzz = posA_zzzz.GetCombined<ezSwizzle::XXXX>(posB_zzzz);
-    ezSimdVec4f posAB_rrrr = posA_rrrr.GetCombined<ezSwizzle::XXXX>(posB_rrrr);
-
-    ezSimdVec4f dot_A45B45;
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_yyyy, planeData.m_y4y5y4y5, dot_A45B45);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_zzzz, planeData.m_z4z5z4z5, dot_A45B45);
-
-    ezSimdVec4b cmp_A0123 = dotA_0123 > posA_rrrr;
-    ezSimdVec4b cmp_B0123 = dotB_0123 > posB_rrrr;
-    ezSimdVec4b cmp_A45B45 = dot_A45B45 > posAB_rrrr;
-
-    ezSimdVec4b cmp_A45 = cmp_A45B45.Get<ezSwizzle::XYXY>();
-    ezSimdVec4b cmp_B45 = cmp_A45B45.Get<ezSwizzle::ZWZW>();
-
-    ezUInt32 result = (cmp_A0123 || cmp_A45).NoneSet<4>() ? 1 : 0;
-    result |= (cmp_B0123 || cmp_B45).NoneSet<4>() ? 2 : 0;
-
-    return result;
-  }
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -376,27 +290,44 @@ struct ezSpatialSystem_RegularGrid::Grid
     const ezInt32 iDiffZ = diff.z();
     const ezInt32 iNumIterations = iDiffX * iDiffY * iDiffZ;
 
-    for (ezInt32 i = 0; i < iNumIterations; ++i)
+    // Large boxes (e.g. the bounds of a frustum with a far away far plane) can cover millions of potential cells,
+    // in that case it is much cheaper to test all existing cells.
+    if (static_cast<ezUInt64>(iDiffX) * iDiffY * iDiffZ > m_Cells.GetCount())
     {
-      ezInt32 index = i;
-      ezInt32 z = i / (iDiffX * iDiffY);
-      index -= z * iDiffX * iDiffY;
-      ezInt32 y = index / iDiffX;
-      ezInt32 x = index - (y * iDiffX);
-
-      x += iMinX;
-      y += iMinY;
-      z += iMinZ;
-
-      ezUInt64 cellKey = GetCellKey(x, y, z);
-      ezUInt32 cellIndex = 0;
-      if (m_CellKeyToCellIndex.TryGetValue(cellKey, cellIndex))
+      for (ezUInt32 uiCellIndex = m_uiOverflowCellIndex + 1; uiCellIndex < m_Cells.GetCount(); ++uiCellIndex)
       {
-        const Cell& constCell = *m_Cells[cellIndex];
+        const Cell& constCell = *m_Cells[uiCellIndex];
+        if (!constCell.m_Bounds.GetBox().Overlaps(box))
+          continue;
+
         if (func(constCell) == ezVisitorExecution::Stop)
           return;
       }
     }
+    else
+    {
+      for (ezInt32 i = 0; i < iNumIterations; ++i)
+      {
+        ezInt32 index = i;
+        ezInt32 z = i / (iDiffX * iDiffY);
+        index -= z * iDiffX * iDiffY;
+        ezInt32 y = index / iDiffX;
+        ezInt32 x = index - (y * iDiffX);
+
+        x += iMinX;
+        y += iMinY;
+        z += iMinZ;
+
+        ezUInt64 cellKey = GetCellKey(x, y, z);
+        ezUInt32 cellIndex = 0;
+        if (m_CellKeyToCellIndex.TryGetValue(cellKey, cellIndex))
+        {
+          const Cell& constCell = *m_Cells[cellIndex];
+          if (func(constCell) == ezVisitorExecution::Stop)
+            return;
+        }
+      }
+    }
 
     const Cell& overflowCell = *m_Cells[m_uiOverflowCellIndex];
     func(overflowCell);
@@ -481,6 +412,53 @@ namespace ezInternal
       return ezVisitorExecution::Continue;
     }
 
+    struct RayQueryData
+    {
+      RayData m_Ray;
+      ezSpatialSystem::QueryCallback m_Callback;
+    };
+
+    template <bool UseTagsFilter>
+    static ezVisitorExecution::Enum RayQueryCallback(const ezSpatialSystem_RegularGrid::Cell& cell, const ezSpatialSystem::QueryParams& queryParams, ezSpatialSystem_RegularGrid::Stats& ref_stats, void* pUserData, ezVisibilityState visType)
+    {
+      auto pQueryData = static_cast<const RayQueryData*>(pUserData);
+      const RayData& ray = pQueryData->m_Ray;
+
+      if (!RayBoxIntersect(ray, cell.m_Bounds.GetBox()))
+        return ezVisitorExecution::Continue;
+
+      auto boundingSpheres = cell.m_BoundingSpheres.GetData();
+      auto boundingBoxHalfExtents = cell.m_BoundingBoxHalfExtents.GetData();
+      auto tagSets = cell.m_TagSets.GetData();
+      auto objectPointers = cell.m_ObjectPointers.GetData();
+
+      const ezUInt32 numSpheres = cell.m_BoundingSpheres.GetCount();
+      ref_stats.m_uiNumObjectsTested += numSpheres;
+
+      for (ezUInt32 i = 0; i < numSpheres; ++i)
+      {
+        const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
+        if (!RayBoxIntersect(ray, bbox))
+          continue;
+
+        if constexpr (UseTagsFilter)
+        {
+          if (FilterByTags(tagSets[i], queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+          {
+            ref_stats.m_uiNumObjectsFiltered++;
+            continue;
+          }
+        }
+
+        ref_stats.m_uiNumObjectsPassed++;
+
+        if (pQueryData->m_Callback(objectPointers[i]) == ezVisitorExecution::Stop)
+          return ezVisitorExecution::Stop;
+      }
+
+      return ezVisitorExecution::Continue;
+    }
+
     struct FrustumQueryData
     {
       PlaneData m_PlaneData;
@@ -493,7 +471,7 @@ namespace ezInternal
     static ezVisitorExecution::Enum FrustumQueryCallback(const ezSpatialSystem_RegularGrid::Cell& cell, const ezSpatialSystem::QueryParams& queryParams, ezSpatialSystem_RegularGrid::Stats& ref_stats, void* pUserData, ezVisibilityState visType)
     {
       auto pQueryData = static_cast<FrustumQueryData*>(pUserData);
-      PlaneData planeData = pQueryData->m_PlaneData;
+      const PlaneData& planeData = pQueryData->m_PlaneData;
 
       ezSimdBSphere cellSphere = cell.m_Bounds.GetSphere();
       if (!SphereFrustumIntersect(cellSphere, planeData))
@@ -525,12 +503,9 @@ namespace ezInternal
         {
           ezUInt32 mask = 0;
 
-          for (ezUInt32 i = 0; i < 32; i += 2)
+          for (ezUInt32 i = 0; i < 32; i += 4)
           {
-            auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
-            auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
-
-            mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
+            mask |= SphereFrustumIntersect4(boundingSpheres + currentIndex + i, planeData) << i;
           }
 
           while (mask > 0)
@@ -841,6 +816,23 @@ void ezSpatialSystem_RegularGrid::FindObjectsInBox(const ezBoundingBox& box, con
     &queryData, ezVisibilityState::Indirect);
 }
 
+void ezSpatialSystem_RegularGrid::FindObjectsAlongRay(const ezVec3& vRayStart, const ezVec3& vRayDir, float fMaxDistance, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsAlongRay");
+
+  ezInternal::QueryHelper::RayQueryData queryData;
+  ezInternal::ComputeRayData(vRayStart, vRayDir, fMaxDistance, queryData.m_Ray);
+  queryData.m_Callback = callback;
+
+  const ezVec3 vRayEnd = vRayStart + vRayDir * fMaxDistance;
+  const ezSimdBBox simdBox(ezSimdConversion::ToVec3(vRayStart.CompMin(vRayEnd)), ezSimdConversion::ToVec3(vRayStart.CompMax(vRayEnd)));
+
+  ForEachCellInBoxInMatchingGrids(simdBox, queryParams,
+    &ezInternal::QueryHelper::RayQueryCallback<false>,
+    &ezInternal::QueryHelper::RayQueryCallback<true>,
+    &queryData, ezVisibilityState::Indirect);
+}
+
 void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const
 {
   EZ_PROFILE_SCOPE("FindVisibleObjects");
@@ -862,28 +854,7 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, c
 
   ezInternal::QueryHelper::FrustumQueryData queryData;
   {
-    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
-    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
-    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
-    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
-    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
-    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
-    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
-
-    ezSimdMat4f helperMat;
-    helperMat.SetRows(plane0, plane1, plane2, plane3);
-
-    queryData.m_PlaneData.m_x0x1x2x3 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y0y1y2y3 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z0z1z2z3 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w0w1w2w3 = helperMat.m_col3;
-
-    helperMat.SetRows(plane4, plane5, plane4, plane5);
-
-    queryData.m_PlaneData.m_x4x5x4x5 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y4y5y4y5 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z4z5z4z5 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w4w5w4w5 = helperMat.m_col3;
+    ezInternal::ComputePlaneData(frustum, queryData.m_PlaneData);
 
     queryData.m_pOutObjects = &out_Objects;
     queryData.m_uiFrameCounter = m_uiFrameCounter;
@@ -891,19 +862,148 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, c
     queryData.m_IsOccludedCB = IsOccluded;
   }
 
+  CellCallback noFilterCallback = &ezInternal::QueryHelper::FrustumQueryCallback<false, false>;
+  CellCallback filterByTagsCallback = &ezInternal::QueryHelper::FrustumQueryCallback<true, false>;
+
   if (IsOccluded.IsValid())
   {
-    ForEachCellInBoxInMatchingGrids(simdBox, queryParams,
-      &ezInternal::QueryHelper::FrustumQueryCallback<false, true>,
-      &ezInternal::QueryHelper::FrustumQueryCallback<true, true>,
-      &queryData, visType);
+    noFilterCallback = &ezInternal::QueryHelper::FrustumQueryCallback<false, true>;
+    filterByTagsCallback = &ezInternal::QueryHelper::FrustumQueryCallback<true, true>;
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+  }
+#endif
+
+  // Collect all cells first, so that they can be distributed across several threads if there is enough work.
+  // The cell and object order is the same as in ForEachCellInBoxInMatchingGrids, so the result does not depend on the number of threads.
+  struct VisitedCell
+  {
+    const Cell* m_pCell;
+    ezUInt32 m_uiGridIndex;
+    Stats m_Stats;
+  };
+
+  ezHybridArray<MatchingGrid, 8> grids;
+  FindMatchingGrids(queryParams, grids);
+
+  ezHybridArray<VisitedCell, 64> cells;
+  ezUInt32 uiNumObjectsInCells = 0;
+
+  for (ezUInt32 uiGridIndex = 0; uiGridIndex < grids.GetCount(); ++uiGridIndex)
+  {
+    grids[uiGridIndex].m_pGrid->ForEachCellInBox(simdBox,
+      [&](const Cell& cell)
+      {
+        cells.PushBack({&cell, uiGridIndex, Stats()});
+        uiNumObjectsInCells += cell.m_BoundingSpheres.GetCount();
+        return ezVisitorExecution::Continue;
+      });
+  }
+
+  auto ProcessCells = [&](ezUInt32 uiFirstCell, ezUInt32 uiEndCell, ezInternal::QueryHelper::FrustumQueryData& ref_queryData)
+  {
+    for (ezUInt32 i = uiFirstCell; i < uiEndCell; ++i)
+    {
+      VisitedCell& visitedCell = cells[i];
+      CellCallback& cellCallback = grids[visitedCell.m_uiGridIndex].m_bUseTagsFilter ? filterByTagsCallback : noFilterCallback;
+
+      cellCallback(*visitedCell.m_pCell, queryParams, visitedCell.m_Stats, &ref_queryData, visType);
+    }
+  };
+
+  const ezUInt32 uiNumWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  const ezUInt32 uiParallelThreshold = static_cast<ezUInt32>(ezMath::Max(cvar_SpatialQueriesParallelThreshold.GetValue(), 0));
+
+  if (uiParallelThreshold == 0 || uiNumObjectsInCells < uiParallelThreshold || uiNumWorkers <= 1 || cells.GetCount() <= 1)
+  {
+    ProcessCells(0, cells.GetCount(), queryData);
   }
   else
   {
-    ForEachCellInBoxInMatchingGrids(simdBox, queryParams,
-      &ezInternal::QueryHelper::FrustumQueryCallback<false, false>,
-      &ezInternal::QueryHelper::FrustumQueryCallback<true, false>,
-      &queryData, visType);
+    EZ_PROFILE_SCOPE("FindVisibleObjects MT");
+
+    // Cells are never split, but there are usually plenty of them. Create a few more jobs than workers so that big cells can be balanced out.
+    struct Job
+    {
+      ezUInt32 m_uiFirstCell = 0;
+      ezUInt32 m_uiEndCell = 0;
+      ezDynamicArray<const ezGameObject*> m_VisibleObjects;
+    };
+
+    ezHybridArray<Job, 16> jobs;
+    {
+      const ezUInt32 uiObjectsPerJob = ezMath::Max(uiNumObjectsInCells / (uiNumWorkers * 4), uiParallelThreshold / 4);
+
+      ezUInt32 uiNumObjectsInJob = 0;
+      for (ezUInt32 i = 0; i < cells.GetCount(); ++i)
+      {
+        uiNumObjectsInJob += cells[i].m_pCell->m_BoundingSpheres.GetCount();
+
+        if (uiNumObjectsInJob >= uiObjectsPerJob || i + 1 == cells.GetCount())
+        {
+          Job& job = jobs.ExpandAndGetRef();
+          job.m_uiFirstCell = jobs.GetCount() > 1 ? jobs[jobs.GetCount() - 2].m_uiEndCell : 0;
+          job.m_uiEndCell = i + 1;
+
+          uiNumObjectsInJob = 0;
+        }
+      }
+    }
+
+    ezParallelForParams parallelForParams;
+    parallelForParams.m_uiBinSize = 1;
+    parallelForParams.m_uiMaxTasksPerThread = 4;
+
+    ezTaskSystem::ParallelForIndexed(
+      0u, jobs.GetCount(),
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 uiJobIndex = uiStartIndex; uiJobIndex < uiEndIndex; ++uiJobIndex)
+        {
+          Job& job = jobs[uiJobIndex];
+
+          ezInternal::QueryHelper::FrustumQueryData jobQueryData = queryData;
+          jobQueryData.m_pOutObjects = &job.m_VisibleObjects;
+
+          ProcessCells(job.m_uiFirstCell, job.m_uiEndCell, jobQueryData);
+        }
+      },
+      "FindVisibleObjects", ezTaskNesting::Never, parallelForParams);
+
+    ezUInt32 uiNumVisibleObjects = out_Objects.GetCount();
+    for (const Job& job : jobs)
+    {
+      uiNumVisibleObjects += job.m_VisibleObjects.GetCount();
+    }
+
+    out_Objects.Reserve(uiNumVisibleObjects);
+
+    for (const Job& job : jobs)
+    {
+      out_Objects.PushBackRange(job.m_VisibleObjects);
+    }
+  }
+
+  {
+    ezHybridArray<Stats, 8> gridStats;
+    gridStats.SetCount(grids.GetCount());
+
+    for (const VisitedCell& visitedCell : cells)
+    {
+      Stats& stats = gridStats[visitedCell.m_uiGridIndex];
+      stats.m_uiNumObjectsTested += visitedCell.m_Stats.m_uiNumObjectsTested;
+      stats.m_uiNumObjectsPassed += visitedCell.m_Stats.m_uiNumObjectsPassed;
+      stats.m_uiNumObjectsFiltered += visitedCell.m_Stats.m_uiNumObjectsFiltered;
+    }
+
+    for (ezUInt32 i = 0; i < grids.GetCount(); ++i)
+    {
+      FinishGridQuery(grids[i], queryParams, gridStats[i]);
+    }
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -1070,6 +1170,26 @@ void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBB
   }
 #endif
 
+  ezHybridArray<MatchingGrid, 8> grids;
+  FindMatchingGrids(queryParams, grids);
+
+  for (const MatchingGrid& grid : grids)
+  {
+    CellCallback cellCallback = grid.m_bUseTagsFilter ? filterByTagsCallback : noFilterCallback;
+
+    Stats stats;
+    grid.m_pGrid->ForEachCellInBox(box,
+      [&](const Cell& cell)
+      {
+        return cellCallback(cell, queryParams, stats, pUserData, visType);
+      });
+
+    FinishGridQuery(grid, queryParams, stats);
+  }
+}
+
+void ezSpatialSystem_RegularGrid::FindMatchingGrids(const QueryParams& queryParams, ezHybridArray<MatchingGrid, 8>& out_grids) const
+{
   ezUInt32 uiGridBitmask = queryParams.m_uiCategoryBitmask;
 
   // search for cached grids that match the exact query params first
@@ -1086,27 +1206,11 @@ void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBB
 
     uiGridBitmask &= ~pGrid->m_Category.GetBitmask();
 
-    Stats stats;
-    pGrid->ForEachCellInBox(box,
-      [&](const Cell& cell)
-      {
-        return noFilterCallback(cell, queryParams, stats, pUserData, visType);
-      });
-
-    UpdateCacheCandidate(queryParams.m_pIncludeTags, queryParams.m_pExcludeTags, pGrid->m_Category, 0.0f);
-
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (queryParams.m_pStats != nullptr)
-    {
-      queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
-      queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
-    }
-#endif
+    out_grids.PushBack({pGrid.Borrow(), true, false});
   }
 
   // then search for the rest
   const bool useTagsFilter = (queryParams.m_pIncludeTags && queryParams.m_pIncludeTags->IsEmpty() == false) || (queryParams.m_pExcludeTags && queryParams.m_pExcludeTags->IsEmpty() == false);
-  CellCallback cellCallback = useTagsFilter ? filterByTagsCallback : noFilterCallback;
 
   while (uiGridBitmask > 0)
   {
@@ -1117,36 +1221,38 @@ void ezSpatialSystem_RegularGrid::ForEachCellInBoxInMatchingGrids(const ezSimdBB
     if (pGrid == nullptr)
       continue;
 
-    Stats stats;
-    pGrid->ForEachCellInBox(box,
-      [&](const Cell& cell)
-      {
-        return cellCallback(cell, queryParams, stats, pUserData, visType);
-      });
+    out_grids.PushBack({pGrid.Borrow(), false, useTagsFilter});
+  }
+}
 
-    if (pGrid->m_bCanBeCached && useTagsFilter)
-    {
-      const ezUInt32 totalNumObjectsAfterSpatialTest = stats.m_uiNumObjectsFiltered + stats.m_uiNumObjectsPassed;
-      const ezUInt32 cacheThreshold = ezUInt32(ezMath::Max(cvar_SpatialQueriesCachingThreshold.GetValue(), 1));
+void ezSpatialSystem_RegularGrid::FinishGridQuery(const MatchingGrid& grid, const QueryParams& queryParams, const Stats& stats) const
+{
+  if (grid.m_bIsCachedGrid)
+  {
+    UpdateCacheCandidate(queryParams.m_pIncludeTags, queryParams.m_pExcludeTags, grid.m_pGrid->m_Category, 0.0f);
+  }
+  else if (grid.m_pGrid->m_bCanBeCached && grid.m_bUseTagsFilter)
+  {
+    const ezUInt32 totalNumObjectsAfterSpatialTest = stats.m_uiNumObjectsFiltered + stats.m_uiNumObjectsPassed;
+    const ezUInt32 cacheThreshold = ezUInt32(ezMath::Max(cvar_SpatialQueriesCachingThreshold.GetValue(), 1));
 
-      // 1.0 => all objects filtered, 0.0 => no object filtered by tags
-      const float filteredRatio = float(double(stats.m_uiNumObjectsFiltered) / totalNumObjectsAfterSpatialTest);
+    // 1.0 => all objects filtered, 0.0 => no object filtered by tags
+    const float filteredRatio = float(double(stats.m_uiNumObjectsFiltered) / totalNumObjectsAfterSpatialTest);
 
-      // Doesn't make sense to cache if there are only few objects in total or only few objects have been filtered
-      if (totalNumObjectsAfterSpatialTest > cacheThreshold && filteredRatio > 0.1f)
-      {
-        UpdateCacheCandidate(queryParams.m_pIncludeTags, queryParams.m_pExcludeTags, pGrid->m_Category, filteredRatio);
-      }
+    // Doesn't make sense to cache if there are only few objects in total or only few objects have been filtered
+    if (totalNumObjectsAfterSpatialTest > cacheThreshold && filteredRatio > 0.1f)
+    {
+      UpdateCacheCandidate(queryParams.m_pIncludeTags, queryParams.m_pExcludeTags, grid.m_pGrid->m_Category, filteredRatio);
     }
+  }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (queryParams.m_pStats != nullptr)
-    {
-      queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
-      queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
-    }
-#endif
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
   }
+#endif
 }
 
 void ezSpatialSystem_RegularGrid::MigrateCachedGrid(ezUInt32 uiCandidateIndex)
@@ -61,6 +61,9 @@ ezWorld::ezWorld(ezWorldDesc& ref_desc)
   sb.Append(".Update");
   m_pUpdateTask->ConfigureTask(sb, ezTaskNesting::Maybe);
 
+  sb.SetFormat("World Update/{0}/Game Object Count", ref_desc.m_sName);
+  m_Data.m_hObjectCountStat = ezStats::RegisterStat(sb);
+
   m_uiIndex = ezInvalidIndex;
 
   // find a free world slot
@@ -94,6 +97,8 @@ ezWorld::~ezWorld()
   EZ_LOCK(GetWriteMarker());
   m_Data.Clear();
 
+  ezStats::UnregisterStat(m_Data.m_hObjectCountStat);
+
   s_Worlds[m_uiIndex] = nullptr;
   m_uiIndex = ezInvalidIndex;
 }
@@ -240,6 +245,13 @@ ezGameObjectHandle ezWorld::CreateObject(const ezGameObjectDesc& desc, ezGameObj
   return ezGameObjectHandle(newId);
 }
 
+void ezWorld::ReserveObjects(ezUInt32 uiNumObjects)
+{
+  CheckForWriteAccess();
+
+  m_Data.m_Objects.Reserve(m_Data.m_Objects.GetCount() + uiNumObjects);
+}
+
 void ezWorld::DeleteObjectNow(const ezGameObjectHandle& hObject0, bool bAlsoDeleteEmptyParents /*= true*/)
 {
   CheckForWriteAccess();
@@ -446,13 +458,7 @@ void ezWorld::Update()
 
   EZ_LOG_BLOCK(m_Data.m_sName.GetData());
 
-  {
-    ezStringBuilder sStatName;
-    sStatName.SetFormat("World Update/{0}/Game Object Count", m_Data.m_sName);
-
-    ezStringBuilder sStatValue;
-    ezStats::SetStat(sStatName, GetObjectCount());
-  }
+  ezStats::SetStat(m_Data.m_hObjectCountStat, GetObjectCount());
 
   ++m_Data.m_uiUpdateCounter;
 
@@ -495,7 +501,7 @@ void ezWorld::Update()
   {
     EZ_PROFILE_SCOPE("Pre-Async Phase");
     ProcessQueuedMessages(ezObjectMsgQueueType::NextFrame);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PreAsync]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PreAsync);
   }
 
   // async phase
@@ -513,8 +519,9 @@ void ezWorld::Update()
   // post-async phase
   {
     EZ_PROFILE_SCOPE("Post-Async Phase");
+    ReplayCommandBuffers();
     ProcessQueuedMessages(ezObjectMsgQueueType::PostAsync);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PostAsync]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PostAsync);
   }
 
   // delete dead objects and update the object hierarchy
@@ -534,7 +541,7 @@ void ezWorld::Update()
   {
     EZ_PROFILE_SCOPE("Post-Transform Phase");
     ProcessQueuedMessages(ezObjectMsgQueueType::PostTransform);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[ezComponentManagerBase::UpdateFunctionDesc::Phase::PostTransform]);
+    UpdateSynchronous(ezComponentManagerBase::UpdateFunctionDesc::Phase::PostTransform);
   }
 
   // Process again so new component can receive render messages, otherwise we introduce a frame delay.
@@ -563,6 +570,8 @@ ezWorldModule* ezWorld::GetOrCreateModule(const ezRTTI* pRtti)
     return nullptr;
   }
 
+  CheckForModuleAccess(uiTypeId, true);
+
   m_Data.m_Modules.EnsureCount(uiTypeId + 1);
 
   ezWorldModule* pModule = m_Data.m_Modules[uiTypeId];
@@ -598,9 +607,9 @@ void ezWorld::DeleteModule(const ezRTTI* pRtti)
 
 ezWorldModule* ezWorld::GetModule(const ezRTTI* pRtti)
 {
-  CheckForWriteAccess();
-
   const ezWorldModuleTypeId uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
+  CheckForModuleWriteAccess(uiTypeId);
+
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return m_Data.m_Modules[uiTypeId];
@@ -616,6 +625,7 @@ const ezWorldModule* ezWorld::GetModule(const ezRTTI* pRtti) const
   const ezWorldModuleTypeId uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
+    CheckForModuleAccess(uiTypeId, false);
     return m_Data.m_Modules[uiTypeId];
   }
 
@@ -903,25 +913,34 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
 
   // timed messages
   {
-    ezInternal::WorldData::MessageQueue& queue = m_Data.m_TimedMessageQueues[queueType];
-    queue.Sort(MessageComparer());
+    ezInternal::WorldData::TimedMessageWheel& wheel = m_Data.m_TimedMessageWheels[queueType];
 
-    const ezTime now = m_Data.m_Clock.GetAccumulatedTime();
+    // move the messages that were posted since the last time into the wheel
+    {
+      ezInternal::WorldData::MessageQueue& queue = m_Data.m_TimedMessageQueues[queueType];
+      for (ezUInt32 i = 0; i < queue.GetCount(); ++i)
+      {
+        wheel.Insert(queue[i]);
+      }
+
+      queue.Clear();
+    }
+
+    // only the due messages need to be sorted
+    auto& dueMessages = m_Data.m_DueTimedMessages;
+    wheel.ExtractDue(m_Data.m_Clock.GetAccumulatedTime(), dueMessages);
+    dueMessages.Sort(MessageComparer());
 
     m_Data.m_ProcessingMessageQueue = queueType;
-    while (!queue.IsEmpty())
+    for (auto& entry : dueMessages)
     {
-      auto& entry = queue.Peek();
-      if (entry.m_MetaData.m_Due > now)
-        break;
-
       ProcessQueuedMessage(entry);
 
       EZ_DELETE(&m_Data.m_Allocator, entry.m_pMessage);
-
-      queue.Dequeue();
     }
     m_Data.m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
+
+    dueMessages.Clear();
   }
 }
 
@@ -1024,6 +1043,7 @@ void ezWorld::DeregisterUpdateFunction(const ezComponentManagerBase::UpdateFunct
     if (updateFunctions[i].m_Function.IsEqualIfComparable(desc.m_Function))
     {
       updateFunctions.RemoveAtAndCopy(i);
+      m_Data.m_UpdateGraphs[desc.m_Phase.GetValue()].m_bIsDirty = true;
     }
   }
 }
@@ -1041,6 +1061,7 @@ void ezWorld::DeregisterUpdateFunctions(ezWorldModule* pModule)
       if (updateFunctions[i].m_Function.GetClassInstance() == pModule)
       {
         updateFunctions.RemoveAtAndCopy(i);
+        m_Data.m_UpdateGraphs[phase].m_bIsDirty = true;
       }
     }
   }
@@ -1058,8 +1079,16 @@ void ezWorld::UpdateFromThread()
   Update();
 }
 
-void ezWorld::UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions)
+void ezWorld::UpdateSynchronous(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase)
 {
+  const ezDynamicArrayBase<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions = m_Data.m_UpdateFunctions[phase];
+
+  if (m_Data.m_bParallelUpdateFunctions && updateFunctions.GetCount() > 1)
+  {
+    UpdateSynchronousInParallel(phase);
+    return;
+  }
+
   ezWorldModule::UpdateContext context;
   context.m_uiFirstComponentIndex = 0;
   context.m_uiComponentCount = ezInvalidIndex;
@@ -1076,6 +1105,99 @@ void ezWorld::UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::Register
   }
 }
 
+void ezWorld::UpdateSynchronousInParallel(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase)
+{
+  const ezDynamicArrayBase<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions = m_Data.m_UpdateFunctions[phase];
+  const ezUInt32 uiNumFunctions = updateFunctions.GetCount();
+
+  m_Data.UpdateUpdateGraph(phase);
+  const ezInternal::WorldData::UpdateGraph& graph = m_Data.m_UpdateGraphs[phase];
+
+  // One entry per update function, functions that are executed on this thread get an invalid id
+  m_Data.m_SynchronousUpdateTaskGroups.Clear();
+  m_Data.m_SynchronousUpdateTaskGroups.SetCount(uiNumFunctions);
+
+  ezUInt32 uiBatchStart = 0;
+
+  auto RunBatch = [&](ezUInt32 uiBatchEnd)
+  {
+    if (uiBatchStart == uiBatchEnd)
+      return;
+
+    ezArrayPtr<const ezTaskGroupID> batch = m_Data.m_SynchronousUpdateTaskGroups.GetArrayPtr().GetSubArray(uiBatchStart, uiBatchEnd - uiBatchStart);
+
+    m_Data.m_bIsUpdatingInParallel = true;
+
+    ezTaskSystem::StartTaskGroupBatch(batch);
+
+    for (const ezTaskGroupID& taskGroupId : batch)
+    {
+      ezTaskSystem::WaitForGroup(taskGroupId);
+    }
+
+    m_Data.m_bIsUpdatingInParallel = false;
+  };
+
+  ezWorldModule::UpdateContext context;
+  context.m_uiFirstComponentIndex = 0;
+  context.m_uiComponentCount = ezInvalidIndex;
+
+  for (ezUInt32 i = 0; i < uiNumFunctions; ++i)
+  {
+    const auto& updateFunction = updateFunctions[i];
+    const bool bSkip = updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld;
+
+    // Functions that don't declare their accesses may touch anything, so they are executed on this thread
+    // after everything before them has finished and before anything after them starts.
+    if (!updateFunction.m_bOnlyAccessesDeclaredTypes)
+    {
+      RunBatch(i);
+      uiBatchStart = i + 1;
+
+      if (!bSkip)
+      {
+        EZ_PROFILE_SCOPE(updateFunction.m_sFunctionName);
+        updateFunction.m_Function(context);
+      }
+
+      continue;
+    }
+
+    if (i >= m_Data.m_SynchronousUpdateTasks.GetCount())
+    {
+      m_Data.m_SynchronousUpdateTasks.SetCount(i + 1);
+    }
+
+    ezSharedPtr<ezInternal::WorldData::SynchronousUpdateTask>& pTask = m_Data.m_SynchronousUpdateTasks[i];
+    if (pTask == nullptr)
+    {
+      pTask = EZ_NEW(&m_Data.m_Allocator, ezInternal::WorldData::SynchronousUpdateTask);
+    }
+
+    // skipped functions still get a task, otherwise the dependencies that go through them would be lost
+    pTask->ConfigureTask(updateFunction.m_sFunctionName, ezTaskNesting::Maybe);
+    pTask->m_pFunction = &updateFunction;
+    pTask->m_pWorldData = &m_Data;
+    pTask->m_bSkip = bSkip;
+
+    ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+    ezTaskSystem::AddTaskToGroup(taskGroupId, pTask);
+
+    for (ezUInt32 uiDependency : graph.m_Dependencies[i])
+    {
+      // everything before the start of the batch has already finished
+      if (uiDependency >= uiBatchStart)
+      {
+        ezTaskSystem::AddTaskGroupDependency(taskGroupId, m_Data.m_SynchronousUpdateTaskGroups[uiDependency]);
+      }
+    }
+
+    m_Data.m_SynchronousUpdateTaskGroups[i] = taskGroupId;
+  }
+
+  RunBatch(uiNumFunctions);
+}
+
 void ezWorld::UpdateAsynchronous()
 {
   ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
@@ -1114,6 +1236,7 @@ void ezWorld::UpdateAsynchronous()
       pTask->m_Function = updateFunction.m_Function;
       pTask->m_uiStartIndex = uiStartIndex;
       pTask->m_uiCount = (uiStartIndex + uiGranularity < uiTotalCount) ? uiGranularity : ezInvalidIndex;
+      pTask->m_pWorldData = &m_Data;
       ezTaskSystem::AddTaskToGroup(taskGroupId, pTask);
 
       ++uiCurrentTaskIndex;
@@ -1125,6 +1248,20 @@ void ezWorld::UpdateAsynchronous()
   ezTaskSystem::WaitForGroup(taskGroupId);
 }
 
+void ezWorld::ReplayCommandBuffers()
+{
+  EZ_PROFILE_SCOPE("Replay Command Buffers");
+
+  // the tasks are in the order of the update functions and their batches, which makes the result independent of the thread scheduling
+  for (auto& pTask : m_Data.m_UpdateTasks)
+  {
+    if (!pTask->m_CommandBuffer.IsEmpty())
+    {
+      pTask->m_CommandBuffer.Replay(*this);
+    }
+  }
+}
+
 bool ezWorld::ProcessInitializationBatch(ezInternal::WorldData::InitBatch& batch, ezTime endTime)
 {
   CheckForWriteAccess();
@@ -1315,6 +1452,33 @@ ezResult ezWorld::RegisterUpdateFunctionInternal(const ezWorldModule::UpdateFunc
   ezInternal::WorldData::RegisteredUpdateFunction newFunction;
   newFunction.FillFromDesc(desc);
 
+  if (desc.m_bOnlyAccessesDeclaredTypes)
+  {
+    // the module that registers the function is always accessed
+    const ezWorldModule* pModule = static_cast<const ezWorldModule*>(desc.m_Function.GetClassInstance());
+    if (pModule != nullptr)
+    {
+      newFunction.m_WriteModules.PushBack(ezWorldModuleFactory::GetInstance()->GetTypeId(pModule->GetDynamicRTTI()));
+    }
+
+    auto AddModules = [](const ezHybridArray<const ezRTTI*, 2>& types, ezHybridArray<ezWorldModuleTypeId, 4>& out_modules)
+    {
+      for (const ezRTTI* pRtti : types)
+      {
+        const ezWorldModuleTypeId uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
+        EZ_ASSERT_DEV(uiTypeId != 0xFFFF, "'{0}' is neither a component type nor a world module type", pRtti->GetTypeName());
+
+        if (uiTypeId != 0xFFFF && !out_modules.Contains(uiTypeId))
+        {
+          out_modules.PushBack(uiTypeId);
+        }
+      }
+    };
+
+    AddModules(desc.m_WritesTo, newFunction.m_WriteModules);
+    AddModules(desc.m_ReadsFrom, newFunction.m_ReadModules);
+  }
+
   while (uiInsertionIndex < updateFunctions.GetCount())
   {
     const auto& existingFunction = updateFunctions[uiInsertionIndex];
@@ -1327,6 +1491,7 @@ ezResult ezWorld::RegisterUpdateFunctionInternal(const ezWorldModule::UpdateFunc
   }
 
   updateFunctions.InsertAt(uiInsertionIndex, newFunction);
+  m_Data.m_UpdateGraphs[desc.m_Phase.GetValue()].m_bIsDirty = true;
 
   return EZ_SUCCESS;
 }
@@ -1406,6 +1571,12 @@ void ezWorld::PatchHierarchyData(ezGameObject* pObject, ezGameObject::TransformP
   RecreateHierarchyData(pObject, pObject->IsDynamic());
 
   pObject->m_pTransformationData->m_pParentData = pParent != nullptr ? pParent->m_pTransformationData : nullptr;
+  m_Data.InvalidateParentBlocks(pObject->IsDynamic(), pObject->m_uiHierarchyLevel, pObject->m_pTransformationData);
+
+  if (pObject->IsDynamic())
+  {
+    pObject->MarkTransformDirty();
+  }
 
   if (preserve == ezGameObject::TransformPreservation::PreserveGlobal)
   {
@@ -1442,7 +1613,9 @@ void ezWorld::RecreateHierarchyData(ezGameObject* pObject, bool bWasDynamic)
     ezGameObject::TransformationData* pOldTransformationData = pObject->m_pTransformationData;
 
     ezGameObject::TransformationData* pNewTransformationData = m_Data.CreateTransformationData(bIsDynamic, uiNewHierarchyLevel);
+    const ezUInt32 uiNewIndexInLevel = pNewTransformationData->m_uiIndexInLevel;
     ezMemoryUtils::Copy(pNewTransformationData, pOldTransformationData, 1);
+    pNewTransformationData->m_uiIndexInLevel = uiNewIndexInLevel;
 
     pObject->m_uiHierarchyLevel = static_cast<ezUInt16>(uiNewHierarchyLevel);
     pObject->m_pTransformationData = pNewTransformationData;
@@ -1452,6 +1625,7 @@ void ezWorld::RecreateHierarchyData(ezGameObject* pObject, bool bWasDynamic)
     {
       ezGameObject::TransformationData* pTransformData = it->m_pTransformationData;
       pTransformData->m_pParentData = pNewTransformationData;
+      m_Data.InvalidateParentBlocks(it->IsDynamic(), it->m_uiHierarchyLevel, pTransformData);
     }
 
     m_Data.DeleteTransformationData(bWasDynamic, uiOldHierarchyLevel, pOldTransformationData);
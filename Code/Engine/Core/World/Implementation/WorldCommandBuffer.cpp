@@ -0,0 +1,202 @@
+#include <Core/CorePCH.h>
+
+#include <Core/World/World.h>
+#include <Core/World/WorldCommandBuffer.h>
+
+ezWorldCommandBuffer::ezWorldCommandBuffer() = default;
+ezWorldCommandBuffer::~ezWorldCommandBuffer() = default;
+
+void ezWorldCommandBuffer::SetLocalPosition(const ezGameObjectHandle& hObject, const ezVec3& vPosition)
+{
+  Command& cmd = AddCommand(CommandType::SetLocalPosition, hObject);
+  cmd.m_fData[0] = vPosition.x;
+  cmd.m_fData[1] = vPosition.y;
+  cmd.m_fData[2] = vPosition.z;
+}
+
+void ezWorldCommandBuffer::SetLocalRotation(const ezGameObjectHandle& hObject, const ezQuat& qRotation)
+{
+  Command& cmd = AddCommand(CommandType::SetLocalRotation, hObject);
+  cmd.m_fData[0] = qRotation.x;
+  cmd.m_fData[1] = qRotation.y;
+  cmd.m_fData[2] = qRotation.z;
+  cmd.m_fData[3] = qRotation.w;
+}
+
+void ezWorldCommandBuffer::SetLocalScaling(const ezGameObjectHandle& hObject, const ezVec3& vScaling)
+{
+  Command& cmd = AddCommand(CommandType::SetLocalScaling, hObject);
+  cmd.m_fData[0] = vScaling.x;
+  cmd.m_fData[1] = vScaling.y;
+  cmd.m_fData[2] = vScaling.z;
+}
+
+void ezWorldCommandBuffer::SetLocalUniformScaling(const ezGameObjectHandle& hObject, float fScaling)
+{
+  Command& cmd = AddCommand(CommandType::SetLocalUniformScaling, hObject);
+  cmd.m_fData[0] = fScaling;
+}
+
+void ezWorldCommandBuffer::CreateObject(const ezGameObjectDesc& desc, ObjectCreatedCallback onCreated)
+{
+  Command& cmd = AddCommand(CommandType::CreateObject, ezGameObjectHandle());
+  cmd.m_uiPayloadIndex = m_CreateObjects.GetCount();
+
+  auto& payload = m_CreateObjects.ExpandAndGetRef();
+  payload.m_Desc = desc;
+  payload.m_OnCreated = onCreated;
+}
+
+void ezWorldCommandBuffer::CreateComponent(const ezGameObjectHandle& hOwner, const ezRTTI* pComponentType, ComponentCreatedCallback onCreated)
+{
+  EZ_ASSERT_DEV(pComponentType != nullptr && pComponentType->IsDerivedFrom<ezComponent>(), "Invalid component type");
+
+  Command& cmd = AddCommand(CommandType::CreateComponent, hOwner);
+  cmd.m_uiPayloadIndex = m_CreateComponents.GetCount();
+
+  auto& payload = m_CreateComponents.ExpandAndGetRef();
+  payload.m_pComponentType = pComponentType;
+  payload.m_OnCreated = onCreated;
+}
+
+void ezWorldCommandBuffer::DeleteObject(const ezGameObjectHandle& hObject, bool bAlsoDeleteEmptyParents /*= true*/)
+{
+  Command& cmd = AddCommand(CommandType::DeleteObject, hObject);
+  cmd.m_bFlag = bAlsoDeleteEmptyParents;
+}
+
+void ezWorldCommandBuffer::DeleteComponent(const ezComponentHandle& hComponent)
+{
+  Command& cmd = AddCommand(CommandType::DeleteComponent, ezGameObjectHandle());
+  cmd.m_hComponent = hComponent;
+}
+
+void ezWorldCommandBuffer::AddFunction(Function func)
+{
+  Command& cmd = AddCommand(CommandType::Function, ezGameObjectHandle());
+  cmd.m_uiPayloadIndex = m_Functions.GetCount();
+
+  m_Functions.PushBack(func);
+}
+
+void ezWorldCommandBuffer::Replay(ezWorld& ref_world)
+{
+  for (const Command& cmd : m_Commands)
+  {
+    switch (cmd.m_Type)
+    {
+      case CommandType::SetLocalPosition:
+      {
+        ezGameObject* pObject = nullptr;
+        if (ref_world.TryGetObject(cmd.m_hObject, pObject))
+        {
+          pObject->SetLocalPosition(ezVec3(cmd.m_fData[0], cmd.m_fData[1], cmd.m_fData[2]));
+        }
+      }
+      break;
+
+      case CommandType::SetLocalRotation:
+      {
+        ezGameObject* pObject = nullptr;
+        if (ref_world.TryGetObject(cmd.m_hObject, pObject))
+        {
+          pObject->SetLocalRotation(ezQuat(cmd.m_fData[0], cmd.m_fData[1], cmd.m_fData[2], cmd.m_fData[3]));
+        }
+      }
+      break;
+
+      case CommandType::SetLocalScaling:
+      {
+        ezGameObject* pObject = nullptr;
+        if (ref_world.TryGetObject(cmd.m_hObject, pObject))
+        {
+          pObject->SetLocalScaling(ezVec3(cmd.m_fData[0], cmd.m_fData[1], cmd.m_fData[2]));
+        }
+      }
+      break;
+
+      case CommandType::SetLocalUniformScaling:
+      {
+        ezGameObject* pObject = nullptr;
+        if (ref_world.TryGetObject(cmd.m_hObject, pObject))
+        {
+          pObject->SetLocalUniformScaling(cmd.m_fData[0]);
+        }
+      }
+      break;
+
+      case CommandType::CreateObject:
+      {
+        const CreateObjectPayload& payload = m_CreateObjects[cmd.m_uiPayloadIndex];
+
+        ezGameObject* pObject = nullptr;
+        ref_world.CreateObject(payload.m_Desc, pObject);
+
+        if (payload.m_OnCreated.IsValid())
+        {
+          payload.m_OnCreated(pObject);
+        }
+      }
+      break;
+
+      case CommandType::CreateComponent:
+      {
+        const CreateComponentPayload& payload = m_CreateComponents[cmd.m_uiPayloadIndex];
+
+        ezGameObject* pOwner = nullptr;
+        if (!ref_world.TryGetObject(cmd.m_hObject, pOwner))
+          break;
+
+        ezComponentManagerBase* pManager = ref_world.GetOrCreateManagerForComponentType(payload.m_pComponentType);
+        if (pManager == nullptr)
+          break;
+
+        ezComponent* pComponent = nullptr;
+        if (ref_world.TryGetComponent(pManager->CreateComponent(pOwner), pComponent) && payload.m_OnCreated.IsValid())
+        {
+          payload.m_OnCreated(pComponent);
+        }
+      }
+      break;
+
+      case CommandType::DeleteObject:
+        ref_world.DeleteObjectDelayed(cmd.m_hObject, cmd.m_bFlag);
+        break;
+
+      case CommandType::DeleteComponent:
+      {
+        ezComponent* pComponent = nullptr;
+        if (ref_world.TryGetComponent(cmd.m_hComponent, pComponent))
+        {
+          pComponent->GetOwningManager()->DeleteComponent(pComponent);
+        }
+      }
+      break;
+
+      case CommandType::Function:
+        m_Functions[cmd.m_uiPayloadIndex](ref_world);
+        break;
+
+        EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
+    }
+  }
+
+  Clear();
+}
+
+void ezWorldCommandBuffer::Clear()
+{
+  m_Commands.Clear();
+  m_CreateObjects.Clear();
+  m_CreateComponents.Clear();
+  m_Functions.Clear();
+}
+
+ezWorldCommandBuffer::Command& ezWorldCommandBuffer::AddCommand(CommandType type, const ezGameObjectHandle& hObject)
+{
+  Command& cmd = m_Commands.ExpandAndGetRef();
+  cmd = Command();
+  cmd.m_Type = type;
+  cmd.m_hObject = hObject;
+  return cmd;
+}
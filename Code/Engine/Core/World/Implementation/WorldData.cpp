@@ -25,6 +25,12 @@ namespace ezInternal
     }
   };
 
+  // the command buffer of the async update task or the synchronous update function that is currently executed by this thread,
+  // tasks may be nested when a worker thread waits for other tasks
+  static thread_local const WorldData* tl_pCurrentWorldData = nullptr;
+  static thread_local ezWorldCommandBuffer* tl_pCurrentCommandBuffer = nullptr;
+  static thread_local const void* tl_pCurrentUpdateFunction = nullptr;
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
   void WorldData::UpdateTask::Execute()
@@ -32,10 +38,350 @@ namespace ezInternal
     ezWorldModule::UpdateContext context;
     context.m_uiFirstComponentIndex = m_uiStartIndex;
     context.m_uiComponentCount = m_uiCount;
+    context.m_pCommandBuffer = &m_CommandBuffer;
+
+    const WorldData* pPreviousWorldData = tl_pCurrentWorldData;
+    ezWorldCommandBuffer* pPreviousCommandBuffer = tl_pCurrentCommandBuffer;
+    const void* pPreviousUpdateFunction = tl_pCurrentUpdateFunction;
+    tl_pCurrentWorldData = m_pWorldData;
+    tl_pCurrentCommandBuffer = &m_CommandBuffer;
+    tl_pCurrentUpdateFunction = nullptr;
+
+    EZ_SCOPE_EXIT(tl_pCurrentWorldData = pPreviousWorldData; tl_pCurrentCommandBuffer = pPreviousCommandBuffer; tl_pCurrentUpdateFunction = pPreviousUpdateFunction);
 
     m_Function(context);
   }
 
+  void WorldData::SynchronousUpdateTask::Execute()
+  {
+    if (m_bSkip)
+      return;
+
+    ezWorldModule::UpdateContext context;
+    context.m_uiFirstComponentIndex = 0;
+    context.m_uiComponentCount = ezInvalidIndex;
+
+    const WorldData* pPreviousWorldData = tl_pCurrentWorldData;
+    ezWorldCommandBuffer* pPreviousCommandBuffer = tl_pCurrentCommandBuffer;
+    const void* pPreviousUpdateFunction = tl_pCurrentUpdateFunction;
+    tl_pCurrentWorldData = m_pWorldData;
+    tl_pCurrentCommandBuffer = nullptr;
+    tl_pCurrentUpdateFunction = m_pFunction;
+
+    EZ_SCOPE_EXIT(tl_pCurrentWorldData = pPreviousWorldData; tl_pCurrentCommandBuffer = pPreviousCommandBuffer; tl_pCurrentUpdateFunction = pPreviousUpdateFunction);
+
+    // the task system already records a profiling scope with the task name, which is the name of the update function
+    m_pFunction->m_Function(context);
+  }
+
+  ezWorldCommandBuffer* WorldData::GetCurrentCommandBuffer() const
+  {
+    return tl_pCurrentWorldData == this ? tl_pCurrentCommandBuffer : nullptr;
+  }
+
+  bool WorldData::IsInParallelUpdateFunction() const
+  {
+    return tl_pCurrentWorldData == this && tl_pCurrentUpdateFunction != nullptr;
+  }
+
+  void WorldData::CheckForModuleAccess(ezWorldModuleTypeId uiTypeId, bool bWrite) const
+  {
+    if (!IsInParallelUpdateFunction())
+      return;
+
+    const RegisteredUpdateFunction& function = *static_cast<const RegisteredUpdateFunction*>(tl_pCurrentUpdateFunction);
+    if (!function.m_bOnlyAccessesDeclaredTypes)
+      return;
+
+    if (function.m_WriteModules.Contains(uiTypeId) || (!bWrite && function.m_ReadModules.Contains(uiTypeId)))
+      return;
+
+    const ezWorldModule* pModule = uiTypeId < m_Modules.GetCount() ? m_Modules[uiTypeId] : nullptr;
+    EZ_REPORT_FAILURE("Update function '{0}' {1} '{2}' which is not declared in its {3} set. This is a data race when update functions are executed in parallel.",
+      function.m_sFunctionName, bWrite ? "writes to" : "reads from", pModule != nullptr ? pModule->GetDynamicRTTI()->GetTypeName() : "<unknown module>",
+      bWrite ? "write" : "read");
+  }
+
+  void WorldData::UpdateUpdateGraph(ezUInt32 uiPhase)
+  {
+    UpdateGraph& graph = m_UpdateGraphs[uiPhase];
+    if (!graph.m_bIsDirty)
+      return;
+
+    graph.m_bIsDirty = false;
+
+    const ezDynamicArrayBase<RegisteredUpdateFunction>& updateFunctions = m_UpdateFunctions[uiPhase];
+    const ezUInt32 uiNumFunctions = updateFunctions.GetCount();
+
+    auto MustRunBefore = [](const RegisteredUpdateFunction& first, const RegisteredUpdateFunction& second)
+    {
+      // functions that don't declare their accesses are executed exclusively
+      if (!first.m_bOnlyAccessesDeclaredTypes || !second.m_bOnlyAccessesDeclaredTypes)
+        return true;
+
+      if (second.m_DependsOn.Contains(first.m_sFunctionName))
+        return true;
+
+      for (ezWorldModuleTypeId uiTypeId : first.m_WriteModules)
+      {
+        if (second.m_WriteModules.Contains(uiTypeId) || second.m_ReadModules.Contains(uiTypeId))
+          return true;
+      }
+
+      for (ezWorldModuleTypeId uiTypeId : first.m_ReadModules)
+      {
+        if (second.m_WriteModules.Contains(uiTypeId))
+          return true;
+      }
+
+      return false;
+    };
+
+    // MustRunBefore only considers earlier functions, a dependency that has ended up later in the order would be ignored
+    for (ezUInt32 j = 0; j < uiNumFunctions; ++j)
+    {
+      for (const ezHashedString& sDependency : updateFunctions[j].m_DependsOn)
+      {
+        for (ezUInt32 i = j + 1; i < uiNumFunctions; ++i)
+        {
+          if (updateFunctions[i].m_sFunctionName == sDependency)
+          {
+            ezLog::Warning("Update function '{0}' depends on '{1}', but '{1}' is ordered after it. The dependency is ignored.", updateFunctions[j].m_sFunctionName, sDependency);
+            break;
+          }
+        }
+      }
+    }
+
+    graph.m_Dependencies.Clear();
+    graph.m_Dependencies.SetCount(uiNumFunctions);
+
+    // isBefore[j * uiNumFunctions + i] is true if function i is already known to finish before function j starts
+    ezDynamicArray<bool> isBefore;
+    isBefore.SetCount(uiNumFunctions * uiNumFunctions, false);
+
+    // The functions are sorted such that every function can be executed after all previous ones, so all edges point forward.
+    // Visiting the candidates from the closest one backwards means that every edge which is implied by an already added edge is skipped.
+    for (ezUInt32 j = 0; j < uiNumFunctions; ++j)
+    {
+      bool* pIsBeforeJ = isBefore.GetData() + j * uiNumFunctions;
+
+      for (ezUInt32 i = j; i-- > 0;)
+      {
+        if (pIsBeforeJ[i] || !MustRunBefore(updateFunctions[i], updateFunctions[j]))
+          continue;
+
+        graph.m_Dependencies[j].PushBack(i);
+
+        const bool* pIsBeforeI = isBefore.GetData() + i * uiNumFunctions;
+        for (ezUInt32 k = 0; k < i; ++k)
+        {
+          pIsBeforeJ[k] |= pIsBeforeI[k];
+        }
+        pIsBeforeJ[i] = true;
+      }
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  WorldData::TimedMessageWheel::TimedMessageWheel()
+  {
+    for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+    {
+      for (ezUInt32 uiSlot = 0; uiSlot < SlotsPerLevel; ++uiSlot)
+      {
+        m_Slots[uiLevel][uiSlot] = InvalidNode;
+      }
+    }
+  }
+
+  void WorldData::TimedMessageWheel::Insert(const MessageQueue::Entry& entry)
+  {
+    ezUInt32 uiNode = m_uiFreeNodes;
+    if (uiNode != InvalidNode)
+    {
+      m_uiFreeNodes = m_Nodes[uiNode].m_uiNext;
+    }
+    else
+    {
+      uiNode = m_Nodes.GetCount();
+      m_Nodes.ExpandAndGetRef();
+    }
+
+    Node& node = m_Nodes[uiNode];
+    node.m_Entry = entry;
+    node.m_uiTick = GetTick(entry.m_MetaData.m_Due);
+
+    InsertNode(uiNode);
+    ++m_uiCount;
+  }
+
+  void WorldData::TimedMessageWheel::ExtractDue(ezTime now, ezDynamicArrayBase<MessageQueue::Entry>& out_entries)
+  {
+    const ezUInt64 uiNowTick = GetTick(now);
+
+    if (m_uiCount == 0)
+    {
+      m_uiCurrentTick = ezMath::Max(m_uiCurrentTick, uiNowTick);
+      return;
+    }
+
+    if (uiNowTick > m_uiCurrentTick + SlotsPerLevel * SlotsPerLevel)
+    {
+      // the clock jumped far ahead, sorting all messages into the wheel again is cheaper than walking all the expired slots
+      ezUInt32 uiAllNodes = m_uiOverflow;
+      m_uiOverflow = InvalidNode;
+
+      for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+      {
+        for (ezUInt32 uiSlot = 0; uiSlot < SlotsPerLevel; ++uiSlot)
+        {
+          ezUInt32 uiNode = m_Slots[uiLevel][uiSlot];
+          m_Slots[uiLevel][uiSlot] = InvalidNode;
+
+          while (uiNode != InvalidNode)
+          {
+            const ezUInt32 uiNext = m_Nodes[uiNode].m_uiNext;
+            m_Nodes[uiNode].m_uiNext = uiAllNodes;
+            uiAllNodes = uiNode;
+            uiNode = uiNext;
+          }
+        }
+      }
+
+      m_uiCurrentTick = uiNowTick;
+      ReinsertList(uiAllNodes);
+    }
+
+    // all messages in slots of ticks that lie completely in the past are due
+    while (m_uiCurrentTick < uiNowTick)
+    {
+      MoveListToArray(m_Slots[0][m_uiCurrentTick & (SlotsPerLevel - 1)], out_entries);
+
+      ++m_uiCurrentTick;
+      Cascade(m_uiCurrentTick);
+    }
+
+    // the slot of the current tick may contain messages that are due later within this millisecond
+    ezUInt32* pLink = &m_Slots[0][m_uiCurrentTick & (SlotsPerLevel - 1)];
+    while (*pLink != InvalidNode)
+    {
+      const ezUInt32 uiNode = *pLink;
+      Node& node = m_Nodes[uiNode];
+
+      if (node.m_Entry.m_MetaData.m_Due <= now)
+      {
+        *pLink = node.m_uiNext;
+        out_entries.PushBack(node.m_Entry);
+        FreeNode(uiNode);
+      }
+      else
+      {
+        pLink = &node.m_uiNext;
+      }
+    }
+  }
+
+  void WorldData::TimedMessageWheel::ExtractAll(ezDynamicArrayBase<MessageQueue::Entry>& out_entries)
+  {
+    for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+    {
+      for (ezUInt32 uiSlot = 0; uiSlot < SlotsPerLevel; ++uiSlot)
+      {
+        MoveListToArray(m_Slots[uiLevel][uiSlot], out_entries);
+      }
+    }
+
+    MoveListToArray(m_uiOverflow, out_entries);
+
+    EZ_ASSERT_DEV(m_uiCount == 0, "Timed message wheel is corrupted");
+    m_Nodes.Clear();
+    m_uiFreeNodes = InvalidNode;
+  }
+
+  // static
+  ezUInt64 WorldData::TimedMessageWheel::GetTick(ezTime time)
+  {
+    return static_cast<ezUInt64>(ezMath::Max(time.GetMilliseconds(), 0.0));
+  }
+
+  void WorldData::TimedMessageWheel::InsertNode(ezUInt32 uiNode)
+  {
+    Node& node = m_Nodes[uiNode];
+
+    // messages that are already due go into the current slot
+    const ezUInt64 uiTick = ezMath::Max(node.m_uiTick, m_uiCurrentTick);
+    const ezUInt64 uiDelta = uiTick - m_uiCurrentTick;
+
+    ezUInt32* pHead = &m_uiOverflow;
+    for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+    {
+      if (uiDelta < (ezUInt64(1) << (SlotBits * (uiLevel + 1))))
+      {
+        pHead = &m_Slots[uiLevel][(uiTick >> (SlotBits * uiLevel)) & (SlotsPerLevel - 1)];
+        break;
+      }
+    }
+
+    node.m_uiNext = *pHead;
+    *pHead = uiNode;
+  }
+
+  void WorldData::TimedMessageWheel::Cascade(ezUInt64 uiTick)
+  {
+    // distribute the slots of the higher levels that start at this tick to the lower levels, highest level first,
+    // so that messages moved down more than one level are picked up by the following iterations
+    if ((uiTick & ((ezUInt64(1) << (SlotBits * NumLevels)) - 1)) == 0)
+    {
+      const ezUInt32 uiHead = m_uiOverflow;
+      m_uiOverflow = InvalidNode;
+      ReinsertList(uiHead);
+    }
+
+    for (ezUInt32 uiLevel = NumLevels - 1; uiLevel > 0; --uiLevel)
+    {
+      if ((uiTick & ((ezUInt64(1) << (SlotBits * uiLevel)) - 1)) != 0)
+        continue;
+
+      ezUInt32& uiHead = m_Slots[uiLevel][(uiTick >> (SlotBits * uiLevel)) & (SlotsPerLevel - 1)];
+      const ezUInt32 uiNodes = uiHead;
+      uiHead = InvalidNode;
+      ReinsertList(uiNodes);
+    }
+  }
+
+  void WorldData::TimedMessageWheel::MoveListToArray(ezUInt32& ref_uiHead, ezDynamicArrayBase<MessageQueue::Entry>& out_entries)
+  {
+    ezUInt32 uiNode = ref_uiHead;
+    ref_uiHead = InvalidNode;
+
+    while (uiNode != InvalidNode)
+    {
+      const ezUInt32 uiNext = m_Nodes[uiNode].m_uiNext;
+      out_entries.PushBack(m_Nodes[uiNode].m_Entry);
+      FreeNode(uiNode);
+      uiNode = uiNext;
+    }
+  }
+
+  void WorldData::TimedMessageWheel::ReinsertList(ezUInt32 uiHead)
+  {
+    while (uiHead != InvalidNode)
+    {
+      const ezUInt32 uiNext = m_Nodes[uiHead].m_uiNext;
+      InsertNode(uiHead);
+      uiHead = uiNext;
+    }
+  }
+
+  void WorldData::TimedMessageWheel::FreeNode(ezUInt32 uiNode)
+  {
+    m_Nodes[uiNode].m_uiNext = m_uiFreeNodes;
+    m_uiFreeNodes = uiNode;
+    --m_uiCount;
+  }
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
   WorldData::WorldData(ezWorldDesc& desc)
@@ -46,6 +392,7 @@ namespace ezInternal
     , m_StackAllocator(desc.m_sName, ezFoundation::GetAlignedAllocator())
     , m_ObjectStorage(&m_BlockAllocator, &m_Allocator)
     , m_MaxInitializationTimePerFrame(desc.m_MaxComponentInitializationTimePerFrame)
+    , m_bParallelUpdateFunctions(desc.m_bParallelUpdateFunctions)
     , m_Clock(desc.m_sName)
     , m_WriteThreadID((ezThreadID)0)
     , m_bReportErrorWhenStaticObjectMoves(desc.m_bReportErrorWhenStaticObjectMoves)
@@ -68,7 +415,7 @@ namespace ezInternal
     m_Objects.Insert(nullptr);
 
 #if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
-    EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject::TransformationData) == 240);
+    EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject::TransformationData) == 256);
 #else
     EZ_CHECK_AT_COMPILETIME(sizeof(ezGameObject::TransformationData) == 192);
 #endif
@@ -158,13 +505,17 @@ namespace ezInternal
           m_BlockAllocator.DeallocateBlock((*blocks)[j]);
         }
         EZ_DELETE(&m_Allocator, blocks);
+        EZ_DELETE(&m_Allocator, hierarchy.m_BlockStates[i]);
       }
 
       hierarchy.m_Data.Clear();
+      hierarchy.m_BlockStates.Clear();
     }
 
     // delete task storage
     m_UpdateTasks.Clear();
+    m_SynchronousUpdateTasks.Clear();
+    m_SynchronousUpdateTaskGroups.Clear();
 
     // delete queued messages
     for (ezUInt32 i = 0; i < ezObjectMsgQueueType::COUNT; ++i)
@@ -186,6 +537,18 @@ namespace ezInternal
           queue.Dequeue();
         }
       }
+
+      {
+        m_DueTimedMessages.Clear();
+        m_TimedMessageWheels[i].ExtractAll(m_DueTimedMessages);
+
+        for (auto& entry : m_DueTimedMessages)
+        {
+          EZ_DELETE(&m_Allocator, entry.m_pMessage);
+        }
+
+        m_DueTimedMessages.Clear();
+      }
     }
   }
 
@@ -196,9 +559,11 @@ namespace ezInternal
     while (uiHierarchyLevel >= hierarchy.m_Data.GetCount())
     {
       hierarchy.m_Data.PushBack(EZ_NEW(&m_Allocator, Hierarchy::DataBlockArray, &m_Allocator));
+      hierarchy.m_BlockStates.PushBack(EZ_NEW(&m_Allocator, Hierarchy::BlockStateArray, &m_Allocator));
     }
 
     Hierarchy::DataBlockArray& blocks = *hierarchy.m_Data[uiHierarchyLevel];
+    Hierarchy::BlockStateArray& blockStates = *hierarchy.m_BlockStates[uiHierarchyLevel];
     Hierarchy::DataBlock* pBlock = nullptr;
 
     if (!blocks.IsEmpty())
@@ -209,31 +574,67 @@ namespace ezInternal
     if (pBlock == nullptr || pBlock->IsFull())
     {
       blocks.PushBack(m_BlockAllocator.AllocateBlock<ezGameObject::TransformationData>());
+      blockStates.ExpandAndGetRef();
       pBlock = &blocks.PeekBack();
     }
 
-    return pBlock->ReserveBack();
+    ezGameObject::TransformationData* pData = pBlock->ReserveBack();
+
+    const ezUInt32 uiIndexInBlock = pBlock->m_uiCount - 1;
+    pData->m_uiIndexInLevel = (blocks.GetCount() - 1) * TRANSFORMATION_DATA_PER_BLOCK + uiIndexInBlock;
+
+    // new data always needs an initial update
+    Hierarchy::BlockState& blockState = blockStates.PeekBack();
+    blockState.m_DirtyMask[uiIndexInBlock / 64].Or(static_cast<ezInt64>(EZ_BIT(uiIndexInBlock % 64)));
+    blockState.m_bParentBlocksValid = false;
+
+    return pData;
   }
 
   void WorldData::DeleteTransformationData(bool bDynamic, ezUInt32 uiHierarchyLevel, ezGameObject::TransformationData* pData)
   {
     Hierarchy& hierarchy = m_Hierarchies[GetHierarchyType(bDynamic)];
     Hierarchy::DataBlockArray& blocks = *hierarchy.m_Data[uiHierarchyLevel];
+    Hierarchy::BlockStateArray& blockStates = *hierarchy.m_BlockStates[uiHierarchyLevel];
 
     Hierarchy::DataBlock& lastBlock = blocks.PeekBack();
+    Hierarchy::BlockState& lastBlockState = blockStates.PeekBack();
+
+    // the last slot becomes unused, make sure a future object in this slot doesn't inherit its state
+    {
+      const ezUInt32 uiLastIndexInBlock = lastBlock.m_uiCount - 1;
+      const ezUInt64 uiLastBit = EZ_BIT(uiLastIndexInBlock % 64);
+
+      lastBlockState.m_DirtyMask[uiLastIndexInBlock / 64].And(static_cast<ezInt64>(~uiLastBit));
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+      lastBlockState.m_uiMovedMask[uiLastIndexInBlock / 64] &= ~uiLastBit;
+#endif
+      lastBlockState.m_bParentBlocksValid = false;
+    }
+
     const ezGameObject::TransformationData* pLast = lastBlock.PopBack();
 
     if (pData != pLast)
     {
+      const ezUInt32 uiIndexInLevel = pData->m_uiIndexInLevel;
+
       ezMemoryUtils::Copy(pData, pLast, 1);
+      pData->m_uiIndexInLevel = uiIndexInLevel;
       pData->m_pObject->m_pTransformationData = pData;
 
+      // simply update the moved data once more instead of transferring its dirty state
+      Hierarchy::BlockState& blockState = blockStates[uiIndexInLevel / TRANSFORMATION_DATA_PER_BLOCK];
+      const ezUInt32 uiIndexInBlock = uiIndexInLevel % TRANSFORMATION_DATA_PER_BLOCK;
+      blockState.m_DirtyMask[uiIndexInBlock / 64].Or(static_cast<ezInt64>(EZ_BIT(uiIndexInBlock % 64)));
+      blockState.m_bParentBlocksValid = false;
+
       // fix parent transform data for children as well
       auto it = pData->m_pObject->GetChildren();
       while (it.IsValid())
       {
         auto pTransformData = it->m_pTransformationData;
         pTransformData->m_pParentData = pData;
+        InvalidateParentBlocks(it->IsDynamic(), it->m_uiHierarchyLevel, pTransformData);
         it.Next();
       }
     }
@@ -242,6 +643,7 @@ namespace ezInternal
     {
       m_BlockAllocator.DeallocateBlock(lastBlock);
       blocks.PopBack();
+      blockStates.PopBack();
     }
   }
 
@@ -309,79 +711,253 @@ namespace ezInternal
 
   void WorldData::UpdateGlobalTransforms()
   {
-    struct UserData
+    Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
+    const ezUInt32 uiNumLevels = hierarchy.m_Data.GetCount();
+
+    if (uiNumLevels == 0)
+      return;
+
+    // all blocks of all levels are enumerated level by level, this is a valid order for processing since parents always come first
+    ezHybridArray<ezUInt32, 16> levelStartIndices;
+    ezUInt32 uiNumBlocks = 0;
+
+    for (ezUInt32 uiLevel = 0; uiLevel < uiNumLevels; ++uiLevel)
     {
-      ezSpatialSystem* m_pSpatialSystem;
-      ezUInt32 m_uiUpdateCounter;
-    };
+      levelStartIndices.PushBack(uiNumBlocks);
+      uiNumBlocks += hierarchy.m_Data[uiLevel]->GetCount();
+    }
 
-    UserData userData;
-    userData.m_pSpatialSystem = m_pSpatialSystem.Borrow();
-    userData.m_uiUpdateCounter = m_uiUpdateCounter;
+    levelStartIndices.PushBack(uiNumBlocks);
 
-    struct RootLevel
+    // Only dirty objects are updated, so even for large worlds there is often not much to do.
+    // However, we can only know how much work there is in the deeper levels once their parents have been processed.
+    constexpr ezUInt32 uiMinBlocksForMultiThreading = 64;
+
+    if (uiNumBlocks < uiMinBlocksForMultiThreading || ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) <= 1)
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
+      for (ezUInt32 uiLevel = 0; uiLevel < uiNumLevels; ++uiLevel)
       {
-        auto pUserData = static_cast<const UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransform(pData, pUserData->m_uiUpdateCounter);
-        return ezVisitorExecution::Continue;
-      }
-    };
+        const ezUInt32 uiNumLevelBlocks = hierarchy.m_Data[uiLevel]->GetCount();
 
-    struct WithParent
+        for (ezUInt32 uiBlock = 0; uiBlock < uiNumLevelBlocks; ++uiBlock)
+        {
+          UpdateTransformationDataBlock(uiLevel, uiBlock, false);
+        }
+      }
+    }
+    else
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
+      for (ezUInt32 uiLevel = 1; uiLevel < uiNumLevels; ++uiLevel)
       {
-        auto pUserData = static_cast<const UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformWithParent(pData, pUserData->m_uiUpdateCounter);
-        return ezVisitorExecution::Continue;
+        Hierarchy::DataBlockArray& blocks = *hierarchy.m_Data[uiLevel];
+        Hierarchy::BlockStateArray& blockStates = *hierarchy.m_BlockStates[uiLevel];
+
+        for (ezUInt32 uiBlock = 0; uiBlock < blocks.GetCount(); ++uiBlock)
+        {
+          if (!blockStates[uiBlock].m_bParentBlocksValid)
+          {
+            UpdateParentBlocks(blockStates[uiBlock], blocks[uiBlock]);
+          }
+        }
       }
-    };
 
-    struct RootLevelWithSpatialData
+      // Instead of a barrier after each hierarchy level, every task grabs the next block in the order from above and only waits until the
+      // blocks that contain the parents of its objects are done. Since blocks are only grabbed by running tasks and all parent blocks come
+      // earlier in the order, they are guaranteed to be in progress already, so this cannot deadlock.
+      struct SharedData
+      {
+        WorldData* m_pWorldData;
+        const ezUInt32* m_pLevelStartIndices;
+        ezUInt32 m_uiNumBlocks;
+        ezAtomicInteger32 m_iNextBlock;
+      };
+
+      SharedData sharedData;
+      sharedData.m_pWorldData = this;
+      sharedData.m_pLevelStartIndices = levelStartIndices.GetData();
+      sharedData.m_uiNumBlocks = uiNumBlocks;
+
+      ezParallelForParams parallelForParams;
+      parallelForParams.m_uiBinSize = 1;
+      parallelForParams.m_uiMaxTasksPerThread = 1;
+      parallelForParams.m_pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
+
+      const ezUInt32 uiNumTasks = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+
+      ezTaskSystem::ParallelForIndexed(
+        0u, uiNumTasks,
+        [pSharedData = &sharedData](ezUInt32, ezUInt32)
+        {
+          ezUInt32 uiLevel = 0;
+
+          while (true)
+          {
+            const ezUInt32 uiBlock = static_cast<ezUInt32>(pSharedData->m_iNextBlock.PostIncrement());
+            if (uiBlock >= pSharedData->m_uiNumBlocks)
+              break;
+
+            while (uiBlock >= pSharedData->m_pLevelStartIndices[uiLevel + 1])
+            {
+              ++uiLevel;
+            }
+
+            pSharedData->m_pWorldData->UpdateTransformationDataBlock(uiLevel, uiBlock - pSharedData->m_pLevelStartIndices[uiLevel], true);
+          }
+        },
+        "World Transform Update Task", ezTaskNesting::Never, parallelForParams);
+    }
+
+    UpdateSpatialData();
+  }
+
+  // static
+  void WorldData::UpdateParentBlocks(Hierarchy::BlockState& ref_state, const Hierarchy::DataBlock& block)
+  {
+    ref_state.m_ParentBlocks.Clear();
+
+    for (ezUInt32 i = 0; i < block.m_uiCount; ++i)
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
+      const ezGameObject::TransformationData* pParentData = block.m_pData[i].m_pParentData;
+
+      // static parents are not part of the update, so there is nothing to wait for
+      if (pParentData == nullptr || pParentData->m_pObject->IsStatic())
+        continue;
+
+      const ezUInt32 uiParentBlock = pParentData->m_uiIndexInLevel / TRANSFORMATION_DATA_PER_BLOCK;
+
+      // siblings are usually created one after the other, so most of the time this is the same block as for the previous object
+      if (!ref_state.m_ParentBlocks.IsEmpty() && ref_state.m_ParentBlocks.PeekBack() == uiParentBlock)
+        continue;
+
+      if (!ref_state.m_ParentBlocks.Contains(uiParentBlock))
       {
-        auto pUserData = static_cast<UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformAndSpatialData(pData, pUserData->m_uiUpdateCounter, *pUserData->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
+        ref_state.m_ParentBlocks.PushBack(uiParentBlock);
       }
-    };
+    }
 
-    struct WithParentWithSpatialData
+    ref_state.m_bParentBlocksValid = true;
+  }
+
+  void WorldData::UpdateTransformationDataBlock(ezUInt32 uiHierarchyLevel, ezUInt32 uiBlockIndex, bool bWaitForParentBlocks)
+  {
+    Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
+    Hierarchy::BlockState& blockState = (*hierarchy.m_BlockStates[uiHierarchyLevel])[uiBlockIndex];
+    const Hierarchy::DataBlock& block = (*hierarchy.m_Data[uiHierarchyLevel])[uiBlockIndex];
+
+    const ezUInt32 uiUpdateCounter = m_uiUpdateCounter;
+
+    if (bWaitForParentBlocks && uiHierarchyLevel > 0)
     {
-      EZ_ALWAYS_INLINE static ezVisitorExecution::Enum Visit(ezGameObject::TransformationData* pData, void* pUserData0)
+      const Hierarchy::BlockStateArray& parentBlockStates = *hierarchy.m_BlockStates[uiHierarchyLevel - 1];
+
+      for (ezUInt32 uiParentBlock : blockState.m_ParentBlocks)
       {
-        auto pUserData = static_cast<UserData*>(pUserData0);
-        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, pUserData->m_uiUpdateCounter, *pUserData->m_pSpatialSystem);
-        return ezVisitorExecution::Continue;
+        while (parentBlockStates[uiParentBlock].m_iUpdatedInFrame != static_cast<ezInt32>(uiUpdateCounter))
+        {
+          ezThreadUtils::YieldHardwareThread();
+        }
       }
-    };
+    }
 
-    Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
-    if (!hierarchy.m_Data.IsEmpty())
+    const bool bHasSpatialSystem = m_pSpatialSystem != nullptr;
+
+    for (ezUInt32 uiWord = 0; uiWord < Hierarchy::MASK_WORDS_PER_BLOCK; ++uiWord)
     {
-      auto dataPtr = hierarchy.m_Data.GetData();
+      ezUInt64 uiDirtyMask = static_cast<ezUInt64>(blockState.m_DirtyMask[uiWord].Set(0));
+      ezUInt64 uiSpatialUpdateMask = 0;
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+      // objects that moved last frame but are not dirty anymore only need their last global transform to catch up
+      ezUInt64 uiCatchUpMask = blockState.m_uiMovedMask[uiWord] & ~uiDirtyMask;
+      ezUInt64 uiMovedMask = 0;
+#endif
 
-      // If we have no spatial system, we perform multi-threaded update as we do not
-      // have to acquire a write lock in the process.
-      if (m_pSpatialSystem == nullptr)
+      while (uiDirtyMask != 0)
       {
-        TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &userData);
+        const ezUInt32 uiBit = ezMath::FirstBitLow(uiDirtyMask);
+        uiDirtyMask &= uiDirtyMask - 1;
 
-        for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
+        EZ_ASSERT_DEBUG(uiWord * 64 + uiBit < block.m_uiCount, "Dirty flag set for unused transformation data");
+        ezGameObject::TransformationData* pData = block.m_pData + uiWord * 64 + uiBit;
+
+        if (uiHierarchyLevel == 0)
+        {
+          pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
+        }
+        else
         {
-          TraverseHierarchyLevelMultiThreaded<WithParent>(*dataPtr[i], &userData);
+          pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
         }
+
+        const ezSimdBBoxSphere oldGlobalBounds = pData->m_globalBounds;
+        pData->UpdateGlobalBounds();
+
+        // the spatial system is not thread-safe, so changed bounds are passed on after all blocks are done, see UpdateSpatialData()
+        if (bHasSpatialSystem && pData->m_hSpatialData.IsInvalidated() == false && pData->m_localBounds.m_BoxHalfExtents.w() == ezSimdFloat::MakeZero() &&
+            pData->m_globalBounds != oldGlobalBounds)
+        {
+          uiSpatialUpdateMask |= EZ_BIT(uiBit);
+        }
+
+        // the children live in the next hierarchy level, whose blocks wait until this block is done
+        for (auto it = pData->m_pObject->GetChildren(); it.IsValid(); ++it)
+        {
+          MarkTransformationDataDirty(uiHierarchyLevel + 1, it->m_pTransformationData);
+        }
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+        if (pData->m_lastGlobalTransform != pData->m_globalTransform)
+        {
+          uiMovedMask |= EZ_BIT(uiBit);
+        }
+#endif
       }
-      else
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+      while (uiCatchUpMask != 0)
       {
-        TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &userData);
+        const ezUInt32 uiBit = ezMath::FirstBitLow(uiCatchUpMask);
+        uiCatchUpMask &= uiCatchUpMask - 1;
+
+        block.m_pData[uiWord * 64 + uiBit].UpdateLastGlobalTransform(uiUpdateCounter);
+      }
 
-        for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
+      blockState.m_uiMovedMask[uiWord] = uiMovedMask;
+#endif
+
+      blockState.m_uiSpatialUpdateMask[uiWord] = uiSpatialUpdateMask;
+    }
+
+    blockState.m_iUpdatedInFrame = static_cast<ezInt32>(uiUpdateCounter);
+  }
+
+  void WorldData::UpdateSpatialData()
+  {
+    if (m_pSpatialSystem == nullptr)
+      return;
+
+    Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
+
+    for (ezUInt32 uiLevel = 0; uiLevel < hierarchy.m_Data.GetCount(); ++uiLevel)
+    {
+      Hierarchy::DataBlockArray& blocks = *hierarchy.m_Data[uiLevel];
+      Hierarchy::BlockStateArray& blockStates = *hierarchy.m_BlockStates[uiLevel];
+
+      for (ezUInt32 uiBlock = 0; uiBlock < blocks.GetCount(); ++uiBlock)
+      {
+        for (ezUInt32 uiWord = 0; uiWord < Hierarchy::MASK_WORDS_PER_BLOCK; ++uiWord)
         {
-          TraverseHierarchyLevel<WithParentWithSpatialData>(*dataPtr[i], &userData);
+          ezUInt64 uiMask = blockStates[uiBlock].m_uiSpatialUpdateMask[uiWord];
+          blockStates[uiBlock].m_uiSpatialUpdateMask[uiWord] = 0;
+
+          while (uiMask != 0)
+          {
+            const ezUInt32 uiBit = ezMath::FirstBitLow(uiMask);
+            uiMask &= uiMask - 1;
+
+            const ezGameObject::TransformationData& data = blocks[uiBlock].m_pData[uiWord * 64 + uiBit];
+            m_pSpatialSystem->UpdateSpatialDataBounds(data.m_hSpatialData, data.m_globalBounds);
+          }
         }
       }
     }
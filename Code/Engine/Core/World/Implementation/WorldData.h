@@ -7,9 +7,11 @@
 #include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Types/SharedPtr.h>
+#include <Foundation/Utilities/Stats.h>
 
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/World/GameObject.h>
+#include <Core/World/WorldCommandBuffer.h>
 #include <Core/World/WorldDesc.h>
 
 namespace ezInternal
@@ -19,6 +21,7 @@ namespace ezInternal
   private:
     friend class ::ezWorld;
     friend class ::ezComponentManagerBase;
+    friend class ::ezGameObject;
 
     WorldData(ezWorldDesc& desc);
     ~WorldData();
@@ -103,7 +106,39 @@ namespace ezInternal
       using DataBlock = ezDataBlock<ezGameObject::TransformationData, ezInternal::DEFAULT_BLOCK_SIZE>;
       using DataBlockArray = ezDynamicArray<DataBlock>;
 
+      enum
+      {
+        MASK_WORDS_PER_BLOCK = (TRANSFORMATION_DATA_PER_BLOCK + 63) / 64
+      };
+
+      /// \brief Bookkeeping for the global transform update, one per data block.
+      struct BlockState
+      {
+        /// Objects that need their global transform and bounds recomputed. Set from any thread by ezGameObject when the local transform
+        /// changes and by the transform update itself for the children of updated objects.
+        ezAtomicInteger64 m_DirtyMask[MASK_WORDS_PER_BLOCK];
+
+        /// Objects whose global bounds changed during the update and still need to be passed to the spatial system.
+        ezUInt64 m_uiSpatialUpdateMask[MASK_WORDS_PER_BLOCK] = {};
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+        /// Objects that moved in the last update. Their last global transform has to catch up even if they don't move again.
+        ezUInt64 m_uiMovedMask[MASK_WORDS_PER_BLOCK] = {};
+#endif
+
+        /// Indices of the blocks in the previous hierarchy level that contain parents of objects in this block.
+        /// A block can only be updated once all of these have been updated.
+        ezHybridArray<ezUInt32, 4> m_ParentBlocks;
+        bool m_bParentBlocksValid = false;
+
+        /// Update counter of the frame in which this block was last updated.
+        ezAtomicInteger32 m_iUpdatedInFrame = -1;
+      };
+
+      using BlockStateArray = ezDynamicArray<BlockState>;
+
       ezHybridArray<DataBlockArray*, 8, ezLocalAllocatorWrapper> m_Data;
+      ezHybridArray<BlockStateArray*, 8, ezLocalAllocatorWrapper> m_BlockStates;
     };
 
     struct HierarchyType
@@ -124,24 +159,26 @@ namespace ezInternal
 
     void DeleteTransformationData(bool bDynamic, ezUInt32 uiHierarchyLevel, ezGameObject::TransformationData* pData);
 
+    /// \brief Flags the given dynamic transformation data for the next global transform update. Thread-safe.
+    void MarkTransformationDataDirty(ezUInt32 uiHierarchyLevel, const ezGameObject::TransformationData* pData);
+
+    /// \brief Must be called whenever the parent data pointer of the given transformation data changes.
+    void InvalidateParentBlocks(bool bDynamic, ezUInt32 uiHierarchyLevel, const ezGameObject::TransformationData* pData);
+
     template <typename VISITOR>
     static ezVisitorExecution::Enum TraverseHierarchyLevel(Hierarchy::DataBlockArray& blocks, void* pUserData = nullptr);
-    template <typename VISITOR>
-    ezVisitorExecution::Enum TraverseHierarchyLevelMultiThreaded(Hierarchy::DataBlockArray& blocks, void* pUserData = nullptr);
 
     using VisitorFunc = ezDelegate<ezVisitorExecution::Enum(ezGameObject*)>;
     void TraverseBreadthFirst(VisitorFunc& func);
     void TraverseDepthFirst(VisitorFunc& func);
     static ezVisitorExecution::Enum TraverseObjectDepthFirst(ezGameObject* pObject, VisitorFunc& func);
 
-    static void UpdateGlobalTransform(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter);
-    static void UpdateGlobalTransformWithParent(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter);
-
-    static void UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem);
-    static void UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem);
-
     void UpdateGlobalTransforms();
 
+    static void UpdateParentBlocks(Hierarchy::BlockState& ref_state, const Hierarchy::DataBlock& block);
+    void UpdateTransformationDataBlock(ezUInt32 uiHierarchyLevel, ezUInt32 uiBlockIndex, bool bWaitForParentBlocks);
+    void UpdateSpatialData();
+
     void ResourceEventHandler(const ezResourceEvent& e);
 
     // game object lookups
@@ -181,6 +218,11 @@ namespace ezInternal
       float m_fPriority;
       ezUInt16 m_uiGranularity;
       bool m_bOnlyUpdateWhenSimulating;
+      bool m_bOnlyAccessesDeclaredTypes;
+
+      ezHybridArray<ezHashedString, 4> m_DependsOn;
+      ezHybridArray<ezWorldModuleTypeId, 4> m_ReadModules;
+      ezHybridArray<ezWorldModuleTypeId, 4> m_WriteModules;
 
       void FillFromDesc(const ezWorldModule::UpdateFunctionDesc& desc);
       bool operator<(const RegisteredUpdateFunction& other) const;
@@ -193,13 +235,53 @@ namespace ezInternal
       ezWorldModule::UpdateFunction m_Function;
       ezUInt32 m_uiStartIndex;
       ezUInt32 m_uiCount;
+
+      const WorldData* m_pWorldData = nullptr;
+      ezWorldCommandBuffer m_CommandBuffer;
+    };
+
+    /// \brief Executes one synchronous update function when the update functions of a phase are scheduled in parallel.
+    struct SynchronousUpdateTask final : public ezTask
+    {
+      virtual void Execute() override;
+
+      const RegisteredUpdateFunction* m_pFunction = nullptr;
+      const WorldData* m_pWorldData = nullptr;
+      bool m_bSkip = false;
+    };
+
+    /// \brief The dependencies between the synchronous update functions of one phase.
+    ///
+    /// Only the direct dependencies are stored, edges that are already implied by other edges are removed.
+    struct UpdateGraph
+    {
+      ezDynamicArray<ezHybridArray<ezUInt32, 4>, ezLocalAllocatorWrapper> m_Dependencies; ///< Per update function the indices of the functions that must be finished before it starts
+      bool m_bIsDirty = true;
     };
 
+    /// \brief Returns the command buffer of the async update task that is executed by the calling thread for this world, or nullptr.
+    ezWorldCommandBuffer* GetCurrentCommandBuffer() const;
+
+    /// \brief Returns whether the calling thread is currently executing a synchronous update function of this world as a parallel task.
+    bool IsInParallelUpdateFunction() const;
+
+    /// \brief Reports an error if the synchronous update function executed by the calling thread accesses a module that it did not declare.
+    void CheckForModuleAccess(ezWorldModuleTypeId uiTypeId, bool bWrite) const;
+
+    /// \brief Rebuilds the update graph of the given phase if update functions have been added or removed since it was built the last time.
+    void UpdateUpdateGraph(ezUInt32 uiPhase);
+
     ezDynamicArray<RegisteredUpdateFunction, ezLocalAllocatorWrapper> m_UpdateFunctions[ezWorldModule::UpdateFunctionDesc::Phase::COUNT];
     ezDynamicArray<ezWorldModule::UpdateFunctionDesc, ezLocalAllocatorWrapper> m_UpdateFunctionsToRegister;
 
     ezDynamicArray<ezSharedPtr<UpdateTask>, ezLocalAllocatorWrapper> m_UpdateTasks;
 
+    UpdateGraph m_UpdateGraphs[ezWorldModule::UpdateFunctionDesc::Phase::COUNT];
+    ezDynamicArray<ezSharedPtr<SynchronousUpdateTask>, ezLocalAllocatorWrapper> m_SynchronousUpdateTasks;
+    ezDynamicArray<ezTaskGroupID, ezLocalAllocatorWrapper> m_SynchronousUpdateTaskGroups;
+    bool m_bParallelUpdateFunctions = false;
+    bool m_bIsUpdatingInParallel = false;
+
     ezUniquePtr<ezSpatialSystem> m_pSpatialSystem;
     ezSharedPtr<ezCoordinateSystemProvider> m_pCoordinateSystemProvider;
     ezUniquePtr<ezTimeStepSmoothing> m_pTimeStepSmoothing;
@@ -232,8 +314,63 @@ namespace ezInternal
     };
 
     using MessageQueue = ezMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper>;
+
+    /// \brief Hierarchical timing wheel that stores the pending timed messages of one queue type.
+    ///
+    /// Messages are bucketed by their due time in milliseconds into 4 levels of 256 slots each. Insertion is O(1), and advancing the
+    /// time only touches the slots that have expired, far away messages are moved down one level at a time when their slot comes up.
+    /// The returned messages are not sorted, the caller has to sort them to get a deterministic order.
+    /// Not thread safe, messages are posted into the staging queues first and moved into the wheel by ProcessQueuedMessages.
+    class TimedMessageWheel
+    {
+    public:
+      TimedMessageWheel();
+
+      void Insert(const MessageQueue::Entry& entry);
+
+      /// \brief Removes all messages that are due at the given time and appends them to out_entries.
+      void ExtractDue(ezTime now, ezDynamicArrayBase<MessageQueue::Entry>& out_entries);
+
+      /// \brief Removes all messages and appends them to out_entries.
+      void ExtractAll(ezDynamicArrayBase<MessageQueue::Entry>& out_entries);
+
+      ezUInt32 GetCount() const { return m_uiCount; }
+
+    private:
+      static constexpr ezUInt32 NumLevels = 4;
+      static constexpr ezUInt32 SlotBits = 8;
+      static constexpr ezUInt32 SlotsPerLevel = 1 << SlotBits;
+      static constexpr ezUInt32 InvalidNode = 0xFFFFFFFF;
+
+      struct Node
+      {
+        EZ_DECLARE_POD_TYPE();
+
+        MessageQueue::Entry m_Entry;
+        ezUInt64 m_uiTick;
+        ezUInt32 m_uiNext;
+      };
+
+      static ezUInt64 GetTick(ezTime time);
+
+      void InsertNode(ezUInt32 uiNode);
+      void Cascade(ezUInt64 uiTick);
+      void MoveListToArray(ezUInt32& ref_uiHead, ezDynamicArrayBase<MessageQueue::Entry>& out_entries);
+      void ReinsertList(ezUInt32 uiHead);
+      void FreeNode(ezUInt32 uiNode);
+
+      ezDynamicArray<Node, ezLocalAllocatorWrapper> m_Nodes;
+      ezUInt32 m_uiFreeNodes = InvalidNode;
+      ezUInt32 m_uiCount = 0;
+      ezUInt64 m_uiCurrentTick = 0;
+      ezUInt32 m_Slots[NumLevels][SlotsPerLevel];
+      ezUInt32 m_uiOverflow = InvalidNode; // messages that are more than 2^32 ms in the future
+    };
+
     mutable MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
-    mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
+    mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT]; ///< Staging queues for timed messages, PostMessage may be called from multiple threads
+    TimedMessageWheel m_TimedMessageWheels[ezObjectMsgQueueType::COUNT];
+    ezDynamicArray<MessageQueue::Entry, ezLocalAllocatorWrapper> m_DueTimedMessages;
     ezObjectMsgQueueType::Enum m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
 
     ezThreadID m_WriteThreadID;
@@ -241,6 +378,7 @@ namespace ezInternal
     mutable ezAtomicInteger32 m_iReadCounter;
 
     ezUInt32 m_uiUpdateCounter = 0;
+    ezStatHandle m_hObjectCountStat;
     bool m_bSimulateWorld = true;
     bool m_bReportErrorWhenStaticObjectMoves = true;
 
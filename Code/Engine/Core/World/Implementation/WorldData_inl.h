@@ -7,6 +7,20 @@ namespace ezInternal
     return bIsDynamic ? HierarchyType::Dynamic : HierarchyType::Static;
   }
 
+  EZ_FORCE_INLINE void WorldData::MarkTransformationDataDirty(ezUInt32 uiHierarchyLevel, const ezGameObject::TransformationData* pData)
+  {
+    Hierarchy::BlockStateArray& blockStates = *m_Hierarchies[HierarchyType::Dynamic].m_BlockStates[uiHierarchyLevel];
+
+    const ezUInt32 uiIndexInBlock = pData->m_uiIndexInLevel % TRANSFORMATION_DATA_PER_BLOCK;
+    blockStates[pData->m_uiIndexInLevel / TRANSFORMATION_DATA_PER_BLOCK].m_DirtyMask[uiIndexInBlock / 64].Or(static_cast<ezInt64>(EZ_BIT(uiIndexInBlock % 64)));
+  }
+
+  EZ_FORCE_INLINE void WorldData::InvalidateParentBlocks(bool bDynamic, ezUInt32 uiHierarchyLevel, const ezGameObject::TransformationData* pData)
+  {
+    Hierarchy::BlockStateArray& blockStates = *m_Hierarchies[GetHierarchyType(bDynamic)].m_BlockStates[uiHierarchyLevel];
+    blockStates[pData->m_uiIndexInLevel / TRANSFORMATION_DATA_PER_BLOCK].m_bParentBlocksValid = false;
+  }
+
   // static
   template <typename VISITOR>
   EZ_FORCE_INLINE ezVisitorExecution::Enum WorldData::TraverseHierarchyLevel(Hierarchy::DataBlockArray& blocks, void* pUserData /* = nullptr*/)
@@ -29,65 +43,6 @@ namespace ezInternal
     return ezVisitorExecution::Continue;
   }
 
-  // static
-  template <typename VISITOR>
-  EZ_FORCE_INLINE ezVisitorExecution::Enum WorldData::TraverseHierarchyLevelMultiThreaded(
-    Hierarchy::DataBlockArray& blocks, void* pUserData /* = nullptr*/)
-  {
-    ezParallelForParams parallelForParams;
-    parallelForParams.m_uiBinSize = 100;
-    parallelForParams.m_uiMaxTasksPerThread = 2;
-    parallelForParams.m_pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
-
-    ezTaskSystem::ParallelFor(
-      blocks.GetArrayPtr(),
-      [pUserData](ezArrayPtr<WorldData::Hierarchy::DataBlock> blocksSlice)
-      {
-        for (WorldData::Hierarchy::DataBlock& block : blocksSlice)
-        {
-          ezGameObject::TransformationData* pCurrentData = block.m_pData;
-          ezGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
-
-          while (pCurrentData < pEndData)
-          {
-            VISITOR::Visit(pCurrentData, pUserData);
-            ++pCurrentData;
-          }
-        }
-      },
-      "World DataBlock Traversal Task", parallelForParams);
-
-    return ezVisitorExecution::Continue;
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransform(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter)
-  {
-    pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
-    pData->UpdateGlobalBounds();
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParent(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter)
-  {
-    pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
-    pData->UpdateGlobalBounds();
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem)
-  {
-    pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
-  }
-
-  // static
-  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem)
-  {
-    pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
-  }
-
   ///////////////////////////////////////////////////////////////////////////////////////////////////
 
   EZ_ALWAYS_INLINE const ezGameObject& WorldData::ConstObjectIterator::operator*() const
@@ -199,6 +154,8 @@ namespace ezInternal
     m_fPriority = desc.m_fPriority;
     m_uiGranularity = desc.m_uiGranularity;
     m_bOnlyUpdateWhenSimulating = desc.m_bOnlyUpdateWhenSimulating;
+    m_bOnlyAccessesDeclaredTypes = desc.m_bOnlyAccessesDeclaredTypes;
+    m_DependsOn = desc.m_DependsOn;
   }
 
   EZ_FORCE_INLINE bool WorldData::RegisteredUpdateFunction::operator<(const RegisteredUpdateFunction& other) const
@@ -155,6 +155,7 @@ ManagerType* ezWorld::GetOrCreateComponentManager()
   CheckForWriteAccess();
 
   const ezWorldModuleTypeId uiTypeId = ManagerType::TypeId();
+  CheckForModuleAccess(uiTypeId, true);
   m_Data.m_Modules.EnsureCount(uiTypeId + 1);
 
   ManagerType* pModule = static_cast<ManagerType*>(m_Data.m_Modules[uiTypeId]);
@@ -203,9 +204,9 @@ EZ_FORCE_INLINE ManagerType* ezWorld::GetComponentManager()
 {
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponentManagerBase, ManagerType), "Not a valid component manager type");
 
-  CheckForWriteAccess();
-
   const ezWorldModuleTypeId uiTypeId = ManagerType::TypeId();
+  CheckForModuleWriteAccess(uiTypeId);
+
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return ezStaticCast<ManagerType*>(m_Data.m_Modules[uiTypeId]);
@@ -222,6 +223,7 @@ EZ_FORCE_INLINE const ManagerType* ezWorld::GetComponentManager() const
   CheckForReadAccess();
 
   const ezWorldModuleTypeId uiTypeId = ManagerType::TypeId();
+  CheckForModuleAccess(uiTypeId, false);
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return ezStaticCast<const ManagerType*>(m_Data.m_Modules[uiTypeId]);
@@ -263,10 +265,10 @@ inline bool ezWorld::IsValidComponent(const ezComponentHandle& hComponent) const
 template <typename ComponentType>
 inline bool ezWorld::TryGetComponent(const ezComponentHandle& hComponent, ComponentType*& out_pComponent)
 {
-  CheckForWriteAccess();
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponent, ComponentType), "Not a valid component type");
 
   const ezWorldModuleTypeId uiTypeId = hComponent.m_InternalId.m_TypeId;
+  CheckForModuleWriteAccess(uiTypeId);
 
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
@@ -289,6 +291,7 @@ inline bool ezWorld::TryGetComponent(const ezComponentHandle& hComponent, const
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponent, ComponentType), "Not a valid component type");
 
   const ezWorldModuleTypeId uiTypeId = hComponent.m_InternalId.m_TypeId;
+  CheckForModuleAccess(uiTypeId, false);
 
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
@@ -378,6 +381,11 @@ EZ_FORCE_INLINE void ezWorld::SendMessage(const ezComponentHandle& hReceiverComp
   }
 }
 
+EZ_ALWAYS_INLINE ezWorldCommandBuffer* ezWorld::GetCommandBuffer() const
+{
+  return m_Data.GetCurrentCommandBuffer();
+}
+
 EZ_ALWAYS_INLINE void ezWorld::SetWorldSimulationEnabled(bool bEnable)
 {
   m_Data.m_bSimulateWorld = bEnable;
@@ -546,6 +554,34 @@ EZ_ALWAYS_INLINE void ezWorld::CheckForWriteAccess() const
     m_Data.m_WriteThreadID == ezThreadUtils::GetCurrentThreadID(), "Trying to write to World '{0}', but it is not marked for writing.", GetName());
 }
 
+EZ_ALWAYS_INLINE void ezWorld::CheckForModuleWriteAccess(ezWorldModuleTypeId uiTypeId) const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // update functions that are executed in parallel are allowed to write to the modules they have declared, but nothing else
+  if (m_Data.m_bIsUpdatingInParallel && m_Data.IsInParallelUpdateFunction())
+  {
+    m_Data.CheckForModuleAccess(uiTypeId, true);
+    return;
+  }
+#endif
+
+  EZ_IGNORE_UNUSED(uiTypeId);
+  CheckForWriteAccess();
+}
+
+EZ_ALWAYS_INLINE void ezWorld::CheckForModuleAccess(ezWorldModuleTypeId uiTypeId, bool bWrite) const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (m_Data.m_bIsUpdatingInParallel)
+  {
+    m_Data.CheckForModuleAccess(uiTypeId, bWrite);
+  }
+#else
+  EZ_IGNORE_UNUSED(uiTypeId);
+  EZ_IGNORE_UNUSED(bWrite);
+#endif
+}
+
 EZ_ALWAYS_INLINE ezGameObject* ezWorld::GetObjectUnchecked(ezUInt32 uiIndex) const
 {
   return m_Data.m_Objects.GetValueUnchecked(uiIndex);
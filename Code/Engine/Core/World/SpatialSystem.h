@@ -59,12 +59,21 @@ public:
   virtual void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, ezDynamicArray<ezGameObject*>& out_objects) const;
   virtual void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const = 0;
 
+  /// \brief Finds all objects whose bounding box is hit by the ray segment from \a vRayStart along the normalized direction \a vRayDir.
+  ///
+  /// The objects are reported in no particular order, sort them by distance if the closest hit is needed.
+  virtual void FindObjectsAlongRay(const ezVec3& vRayStart, const ezVec3& vRayDir, float fMaxDistance, const QueryParams& queryParams, ezDynamicArray<ezGameObject*>& out_objects) const;
+  virtual void FindObjectsAlongRay(const ezVec3& vRayStart, const ezVec3& vRayDir, float fMaxDistance, const QueryParams& queryParams, QueryCallback callback) const = 0;
+
   ///@}
   /// \name Visibility Queries
   ///@{
 
   using IsOccludedFunc = ezDelegate<bool(const ezSimdBBox&)>;
 
+  /// \brief Finds all objects in the given frustum that pass the query filter and are not occluded.
+  ///
+  /// Implementations may distribute the work across worker threads, so \a isOccluded must be safe to call concurrently.
   virtual void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, IsOccludedFunc isOccluded, ezVisibilityState visType) const = 0;
 
   /// \brief Retrieves a state describing how visible the object is.
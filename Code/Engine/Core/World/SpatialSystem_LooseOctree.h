@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/IdTable.h>
+#include <Foundation/Types/UniquePtr.h>
+
+/// \brief A spatial system that sorts objects into a loose octree.
+///
+/// Every object is stored in the deepest node that is still at least as large as the object. The loose bounds of a node are twice as large
+/// as the node itself, so an object only has to fit into the node with its center and never needs to be split.
+/// This works well for worlds that mix huge objects (e.g. terrain chunks) with lots of tiny ones, since there is no fixed cell size.
+/// Moving objects only change their node when they leave its area or change their size considerably.
+///
+/// Objects outside of the root node are kept in the root node itself. The nodes are created and removed on demand,
+/// and there is a separate tree for every spatial data category.
+///
+/// To use it, pass an instance through ezWorldDesc::m_pSpatialSystem.
+class EZ_CORE_DLL ezSpatialSystem_LooseOctree : public ezSpatialSystem
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezSpatialSystem_LooseOctree, ezSpatialSystem);
+
+public:
+  /// \param fRootHalfExtent Half the size of the root node, which is centered at the origin.
+  /// \param uiMaxDepth Maximum number of levels below the root. The smallest nodes have a half extent of fRootHalfExtent / 2^uiMaxDepth.
+  ezSpatialSystem_LooseOctree(float fRootHalfExtent = 32768.0f, ezUInt32 uiMaxDepth = 12);
+  ~ezSpatialSystem_LooseOctree();
+
+  /// \brief Returns the loose bounding boxes of all nodes that contain objects. Useful for debug visualizations.
+  void GetAllNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezSpatialData::Category filterCategory = ezInvalidSpatialDataCategory) const;
+
+private:
+  // ezSpatialSystem implementation
+  ezSpatialDataHandle CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+  ezSpatialDataHandle CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+
+  void DeleteSpatialData(const ezSpatialDataHandle& hData) override;
+
+  void UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject) override;
+
+  void FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsAlongRay(const ezVec3& vRayStart, const ezVec3& vRayDir, float fMaxDistance, const QueryParams& queryParams, QueryCallback callback) const override;
+
+  void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const override;
+
+  ezVisibilityState GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const override;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  virtual void GetInternalStats(ezStringBuilder& sb) const override;
+#endif
+
+  ezProxyAllocator m_AlignedAllocator;
+
+  float m_fRootHalfExtent;
+  ezUInt32 m_uiMaxDepth;
+
+  enum
+  {
+    MAX_NUM_TREES = sizeof(QueryParams::m_uiCategoryBitmask) * 8
+  };
+
+  struct Node;
+  struct Tree;
+  struct Stats;
+  ezDynamicArray<ezUniquePtr<Tree>> m_Trees;
+
+  struct Data
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiCategoryBitmask;
+    ezUInt32 m_uiAlwaysVisible;
+  };
+
+  ezIdTable<ezSpatialDataId, Data, ezLocalAllocatorWrapper> m_DataTable;
+
+  template <typename Functor>
+  void ForEachTree(const Data& data, Functor func) const;
+
+  template <typename Functor>
+  void ForEachMatchingTree(const QueryParams& queryParams, Functor func) const;
+};
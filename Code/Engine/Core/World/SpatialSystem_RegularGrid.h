@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/SimdMath/SimdVec4i.h>
 #include <Foundation/Types/UniquePtr.h>
@@ -40,6 +41,7 @@ private:
 
   void FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
   void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsAlongRay(const ezVec3& vRayStart, const ezVec3& vRayDir, float fMaxDistance, const QueryParams& queryParams, QueryCallback callback) const override;
 
   void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const override;
 
@@ -88,6 +90,16 @@ private:
   using CellCallback = ezDelegate<ezVisitorExecution::Enum(const Cell&, const QueryParams&, Stats&, void*, ezVisibilityState)>;
   void ForEachCellInBoxInMatchingGrids(const ezSimdBBox& box, const QueryParams& queryParams, CellCallback noFilterCallback, CellCallback filterByTagsCallback, void* pUserData, ezVisibilityState visType) const;
 
+  struct MatchingGrid
+  {
+    const Grid* m_pGrid = nullptr;
+    bool m_bIsCachedGrid = false;
+    bool m_bUseTagsFilter = false;
+  };
+
+  void FindMatchingGrids(const QueryParams& queryParams, ezHybridArray<MatchingGrid, 8>& out_grids) const;
+  void FinishGridQuery(const MatchingGrid& grid, const QueryParams& queryParams, const Stats& stats) const;
+
   struct CacheCandidate
   {
     ezTagSet m_IncludeTags;
@@ -14,10 +14,15 @@ class ezEventMessageHandlerComponent;
 /// * Async phase: The update functions are called in batches asynchronously on multiple threads. There is absolutely no guarantee in which
 /// order the functions are called.
 ///   Thus it is not allowed to access any data other than the components own data during that phase.
-/// * Post-async phase: Another synchronous phase like the pre-async phase.
+///   Modifications of the world have to be recorded with the command buffer returned by GetCommandBuffer().
+/// * Post-async phase: The recorded commands are executed in a deterministic order, then the update functions are called like in the
+/// pre-async phase.
 /// * Actual deletion of dead objects and components are done now.
 /// * Transform update: The global transformation of dynamic objects is updated.
 /// * Post-transform phase: Another synchronous phase like the pre-async phase after the transformation has been updated.
+///
+/// If ezWorldDesc::m_bParallelUpdateFunctions is enabled, the synchronous phases execute update functions that declare their accesses
+/// concurrently on multiple threads, as long as they don't depend on each other and don't access the same modules in a conflicting way.
 class EZ_CORE_DLL ezWorld final
 {
 public:
@@ -43,6 +48,9 @@ public:
   /// \brief Create a new game object from the given description, writes a pointer to it to out_pObject and returns a handle to it.
   ezGameObjectHandle CreateObject(const ezGameObjectDesc& desc, ezGameObject*& out_pObject);
 
+  /// \brief Makes sure that the given number of additional objects can be created without growing the internal id table.
+  void ReserveObjects(ezUInt32 uiNumObjects);
+
   /// \brief Deletes the given object, its children and all components.
   /// \note This function deletes the object immediately! It is unsafe to use this during a game update loop, as other objects
   /// may rely on this object staying valid for the rest of the frame.
@@ -250,6 +258,12 @@ public:
 
   ///@}
 
+  /// \brief Returns the command buffer into which world modifications have to be recorded during the async phase.
+  ///
+  /// Returns nullptr if the calling thread is not executing an async update function of this world, in that case the world can be modified
+  /// directly, provided that it is marked for writing. The recorded commands are executed at the start of the post-async phase.
+  ezWorldCommandBuffer* GetCommandBuffer() const;
+
   /// \brief If enabled, the full simulation should be executed, otherwise only the rendering related updates should be done
   void SetWorldSimulationEnabled(bool bEnable);
 
@@ -376,6 +390,8 @@ private:
 
   void CheckForReadAccess() const;
   void CheckForWriteAccess() const;
+  void CheckForModuleAccess(ezWorldModuleTypeId uiTypeId, bool bWrite) const;
+  void CheckForModuleWriteAccess(ezWorldModuleTypeId uiTypeId) const;
 
   ezGameObject* GetObjectUnchecked(ezUInt32 uiIndex) const;
 
@@ -402,8 +418,10 @@ private:
   void AddComponentToInitialize(ezComponentHandle hComponent);
 
   void UpdateFromThread();
-  void UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions);
+  void UpdateSynchronous(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase);
+  void UpdateSynchronousInParallel(ezWorldModule::UpdateFunctionDesc::Phase::Enum phase);
   void UpdateAsynchronous();
+  void ReplayCommandBuffers();
 
   // returns if the batch was completely initialized
   bool ProcessInitializationBatch(ezInternal::WorldData::InitBatch& batch, ezTime endTime);
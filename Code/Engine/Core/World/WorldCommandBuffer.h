@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Core/World/GameObjectDesc.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Types/Delegate.h>
+
+class ezWorld;
+class ezGameObject;
+
+/// \brief Records modifications of a world that are executed later, when write access to the world is available again.
+///
+/// During the async update phase the world can only be read. Every async update batch gets its own command buffer, which can be
+/// retrieved through ezWorld::GetCommandBuffer() or ezWorldModule::UpdateContext::m_pCommandBuffer. All buffers are replayed in the order
+/// of the update functions and batches at the start of the post-async phase, so the result does not depend on which thread executed which
+/// batch.
+///
+/// Messages don't need to be recorded, ezWorld::PostMessage may be called from multiple threads and queued messages are sorted before they
+/// are processed. Use ezObjectMsgQueueType::PostAsync to receive them in the same frame.
+class EZ_CORE_DLL ezWorldCommandBuffer
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezWorldCommandBuffer);
+
+public:
+  ezWorldCommandBuffer();
+  ~ezWorldCommandBuffer();
+
+  using ObjectCreatedCallback = ezDelegate<void(ezGameObject*)>;
+  using ComponentCreatedCallback = ezDelegate<void(ezComponent*)>;
+  using Function = ezDelegate<void(ezWorld&)>;
+
+  /// \brief Sets the local position of the given object, see ezGameObject::SetLocalPosition().
+  void SetLocalPosition(const ezGameObjectHandle& hObject, const ezVec3& vPosition);
+
+  /// \brief Sets the local rotation of the given object, see ezGameObject::SetLocalRotation().
+  void SetLocalRotation(const ezGameObjectHandle& hObject, const ezQuat& qRotation);
+
+  /// \brief Sets the local scaling of the given object, see ezGameObject::SetLocalScaling().
+  void SetLocalScaling(const ezGameObjectHandle& hObject, const ezVec3& vScaling);
+
+  /// \brief Sets the local uniform scaling of the given object, see ezGameObject::SetLocalUniformScaling().
+  void SetLocalUniformScaling(const ezGameObjectHandle& hObject, float fScaling);
+
+  /// \brief Creates a new object from the given description. The optional callback is called right after the object has been created, e.g.
+  /// to add components to it.
+  void CreateObject(const ezGameObjectDesc& desc, ObjectCreatedCallback onCreated = {});
+
+  /// \brief Creates a component of the given type on the owner object. Nothing happens if the owner does not exist anymore.
+  void CreateComponent(const ezGameObjectHandle& hOwner, const ezRTTI* pComponentType, ComponentCreatedCallback onCreated = {});
+
+  /// \brief Deletes the given object, see ezWorld::DeleteObjectDelayed().
+  void DeleteObject(const ezGameObjectHandle& hObject, bool bAlsoDeleteEmptyParents = true);
+
+  /// \brief Deletes the given component, see ezComponentManagerBase::DeleteComponent().
+  void DeleteComponent(const ezComponentHandle& hComponent);
+
+  /// \brief Calls the given function with write access to the world. Use this for everything that isn't covered by the other commands.
+  void AddFunction(Function func);
+
+  /// \brief Executes all recorded commands in the order in which they were recorded and clears the buffer afterwards.
+  ///
+  /// Commands that reference objects or components that have been deleted in the meantime are skipped.
+  void Replay(ezWorld& ref_world);
+
+  /// \brief Removes all recorded commands without executing them.
+  void Clear();
+
+  /// \brief Returns whether no commands have been recorded.
+  bool IsEmpty() const { return m_Commands.IsEmpty(); }
+
+private:
+  enum class CommandType : ezUInt8
+  {
+    SetLocalPosition,
+    SetLocalRotation,
+    SetLocalScaling,
+    SetLocalUniformScaling,
+    CreateObject,
+    CreateComponent,
+    DeleteObject,
+    DeleteComponent,
+    Function,
+  };
+
+  struct Command
+  {
+    CommandType m_Type;
+    bool m_bFlag = false;
+    ezUInt32 m_uiPayloadIndex = 0;
+    ezGameObjectHandle m_hObject;
+    ezComponentHandle m_hComponent;
+    float m_fData[4] = {};
+  };
+
+  struct CreateObjectPayload
+  {
+    ezGameObjectDesc m_Desc;
+    ObjectCreatedCallback m_OnCreated;
+  };
+
+  struct CreateComponentPayload
+  {
+    const ezRTTI* m_pComponentType = nullptr;
+    ComponentCreatedCallback m_OnCreated;
+  };
+
+  Command& AddCommand(CommandType type, const ezGameObjectHandle& hObject);
+
+  ezDynamicArray<Command> m_Commands;
+  ezDynamicArray<CreateObjectPayload> m_CreateObjects;
+  ezDynamicArray<CreateComponentPayload> m_CreateComponents;
+  ezDynamicArray<Function> m_Functions;
+};
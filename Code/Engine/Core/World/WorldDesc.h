@@ -19,7 +19,7 @@ struct ezWorldDesc
   ezHashedString m_sName;
   ezUInt64 m_uiRandomNumberGeneratorSeed = 0;
 
-  ezUniquePtr<ezSpatialSystem> m_pSpatialSystem;
+  ezUniquePtr<ezSpatialSystem> m_pSpatialSystem;         ///< The spatial system to use, e.g. ezSpatialSystem_LooseOctree. If none is set, an ezSpatialSystem_RegularGrid is created.
   bool m_bAutoCreateSpatialSystem = true;                ///< automatically create a default spatial system if none is set
 
   ezSharedPtr<ezCoordinateSystemProvider> m_pCoordinateSystemProvider;
@@ -27,5 +27,9 @@ struct ezWorldDesc
 
   bool m_bReportErrorWhenStaticObjectMoves = true;
 
+  /// If enabled, synchronous update functions that declare their accesses (see ezWorldModule::UpdateFunctionDesc::m_bOnlyAccessesDeclaredTypes)
+  /// are executed concurrently as tasks, as long as they don't depend on each other and their accesses don't conflict.
+  bool m_bParallelUpdateFunctions = false;
+
   ezTime m_MaxComponentInitializationTimePerFrame = ezTime::MakeFromHours(10000); // max time to spend on component initialization per frame
 };
@@ -5,6 +5,7 @@
 #include <Foundation/Strings/HashedString.h>
 
 class ezWorld;
+class ezWorldCommandBuffer;
 
 class EZ_CORE_DLL ezWorldModule : public ezReflectedClass
 {
@@ -33,6 +34,9 @@ protected:
   {
     ezUInt32 m_uiFirstComponentIndex = 0;
     ezUInt32 m_uiComponentCount = 0;
+
+    /// \brief Only set in the async phase, world modifications have to be recorded here. See ezWorldCommandBuffer.
+    ezWorldCommandBuffer* m_pCommandBuffer = nullptr;
   };
 
   /// \brief Update function delegate.
@@ -74,6 +78,14 @@ protected:
     ezUInt16 m_uiGranularity = 0;                 ///< The granularity in which batch updates should happen during the asynchronous phase. Has to be 0 for
                                                   ///< synchronous functions.
     float m_fPriority = 0.0f;                     ///< Higher priority (higher number) means that this function is called earlier than a function with lower priority.
+
+    ezHybridArray<const ezRTTI*, 2> m_ReadsFrom;  ///< Component or world module types that are read by this function. See m_bOnlyAccessesDeclaredTypes.
+    ezHybridArray<const ezRTTI*, 2> m_WritesTo;   ///< Component or world module types that are modified by this function. The module that registers the
+                                                  ///< function is always included. See m_bOnlyAccessesDeclaredTypes.
+    bool m_bOnlyAccessesDeclaredTypes = false;    ///< Promises that this synchronous function only accesses its own module and the types in m_ReadsFrom
+                                                  ///< and m_WritesTo, and doesn't create or delete objects. If the world executes update functions in
+                                                  ///< parallel (see ezWorldDesc::m_bParallelUpdateFunctions), such functions may run concurrently with other
+                                                  ///< functions that don't conflict with them. All other functions are always executed exclusively on the main thread.
   };
 
   /// \brief Registers the given update function at the world.
@@ -7,6 +7,54 @@
 
 ezWorldReader::FindComponentTypeCallback ezWorldReader::s_FindComponentTypeCallback;
 
+// a super simple, but also efficient random number generator
+inline static ezUInt32 NextStableRandomSeed(ezUInt32& ref_uiSeed)
+{
+  ref_uiSeed = 214013L * ref_uiSeed + 2531011L;
+  return ((ref_uiSeed >> 16) & 0x7FFFF);
+}
+
+static void ApplyInstantiationOptions(ezGameObjectDesc& ref_desc, ezPrefabInstantiationOptions& ref_options)
+{
+  ref_desc.m_bDynamic |= ref_options.m_bForceDynamic;
+
+  switch (ref_options.m_RandomSeedMode)
+  {
+    case ezPrefabInstantiationOptions::RandomSeedMode::DeterministicFromParent:
+      ref_desc.m_uiStableRandomSeed = 0xFFFFFFFF; // ezWorld::CreateObject() will either derive a deterministic value from the parent object, or assign a random value, if no parent exists
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::CompletelyRandom:
+      ref_desc.m_uiStableRandomSeed = 0; // ezWorld::CreateObject() will assign a random value to this object
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::FixedFromSerialization:
+      // keep deserialized value
+      break;
+
+    case ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue:
+      // we use the given seed root value to assign a deterministic (but different) value to each game object
+      ref_desc.m_uiStableRandomSeed = NextStableRandomSeed(ref_options.m_uiCustomRandomSeedRootValue);
+      break;
+  }
+
+  if (ref_options.m_pOverrideTeamID != nullptr)
+  {
+    ref_desc.m_uiTeamID = *ref_options.m_pOverrideTeamID;
+  }
+}
+
+static void ApplyRootTransform(ezGameObjectDesc& ref_desc, const ezTransform& rootTransform)
+{
+  ezTransform tChild(ref_desc.m_LocalPosition, ref_desc.m_LocalRotation, ref_desc.m_LocalScaling);
+  ezTransform tFinal;
+  tFinal = ezTransform::MakeGlobalTransform(rootTransform, tChild);
+
+  ref_desc.m_LocalPosition = tFinal.m_vPosition;
+  ref_desc.m_LocalRotation = tFinal.m_qRotation;
+  ref_desc.m_LocalScaling = tFinal.m_vScale;
+}
+
 ezWorldReader::ezWorldReader() = default;
 ezWorldReader::~ezWorldReader() = default;
 
@@ -71,6 +119,7 @@ ezResult ezWorldReader::ReadWorldDescription(ezStreamReader& inout_stream, bool
   }
 
   // read all component data
+  ReadComponentCreationData(bWarningOnUknownSkip);
   ReadComponentDataToMemStream(bWarningOnUknownSkip);
   m_pStringDedupReadContext->SetActive(false);
 
@@ -93,12 +142,71 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
   return Instantiate(ref_world, true, rootTransform, options);
 }
 
+void ezWorldReader::InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::InstantiatePrefabs");
+
+  if (rootTransforms.IsEmpty())
+    return;
+
+  EZ_LOCK(ref_world.GetWriteMarker());
+
+  m_pWorld = &ref_world;
+
+  ezPrefabInstantiationOptions copyOptions = options;
+  copyOptions.m_MaxStepTime = ezTime::MakeZero();
+  copyOptions.m_pProgress = nullptr;
+
+  if (options.m_pCreatedRootObjectsOut != nullptr)
+  {
+    options.m_pCreatedRootObjectsOut->Reserve(options.m_pCreatedRootObjectsOut->GetCount() + rootTransforms.GetCount() * m_RootObjectsToCreate.GetCount());
+  }
+
+  if (options.m_pCreatedChildObjectsOut != nullptr)
+  {
+    options.m_pCreatedChildObjectsOut->Reserve(options.m_pCreatedChildObjectsOut->GetCount() + rootTransforms.GetCount() * m_ChildObjectsToCreate.GetCount());
+  }
+
+  if (!options.m_ReplaceNamedRootWithParent.IsEmpty())
+  {
+    // every copy would reuse the parent object, instantiate them one by one
+    for (const ezTransform& rootTransform : rootTransforms)
+    {
+      ClearHandles();
+
+      InstantiationContext context(*this, true, rootTransform, copyOptions);
+      EZ_VERIFY(context.Step() == InstantiationContextBase::StepResult::Finished, "Instantiation should be completed after this call");
+
+      // continue the random sequence, otherwise all copies would get the same seeds
+      copyOptions.m_uiCustomRandomSeedRootValue = context.m_Options.m_uiCustomRandomSeedRootValue;
+    }
+
+    return;
+  }
+
+  CreateGameObjectsBatched(rootTransforms, copyOptions);
+  CreateComponentsBatched(rootTransforms.GetCount());
+  DeserializeComponentsBatched(rootTransforms.GetCount());
+
+  {
+    EZ_PROFILE_SCOPE("ezWorldReader::AddComponentsToBatch");
+
+    for (ezComponent* pComponent : m_BatchComponents)
+    {
+      pComponent->GetOwningManager()->InitializeComponent(pComponent);
+    }
+  }
+
+  m_BatchObjects.Clear();
+  m_BatchComponents.Clear();
+}
+
 ezGameObjectHandle ezWorldReader::ReadGameObjectHandle()
 {
   ezUInt32 idx = 0;
   *m_pStream >> idx;
 
-  return m_IndexToGameObjectHandle[idx];
+  return m_IndexToGameObjectHandle[m_uiFirstGameObjectHandle + idx];
 }
 
 void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
@@ -113,10 +221,11 @@ void ezWorldReader::ReadComponentHandle(ezComponentHandle& out_hComponent)
 
   if (uiTypeIndex < m_ComponentTypes.GetCount())
   {
-    auto& indexToHandle = m_ComponentTypes[uiTypeIndex].m_ComponentIndexToHandle;
-    if (uiIndex < indexToHandle.GetCount())
+    const ComponentTypeInfo& compTypeInfo = m_ComponentTypes[uiTypeIndex];
+    const ezUInt32 uiHandleIndex = compTypeInfo.m_uiFirstComponentHandle + uiIndex;
+    if (uiIndex <= compTypeInfo.m_uiNumComponents && uiHandleIndex < compTypeInfo.m_ComponentIndexToHandle.GetCount())
     {
-      out_hComponent = indexToHandle[uiIndex];
+      out_hComponent = compTypeInfo.m_ComponentIndexToHandle[uiHandleIndex];
     }
   }
 }
@@ -151,17 +260,23 @@ void ezWorldReader::ClearAndCompact()
   m_ComponentTypeVersions.Clear();
   m_ComponentTypeVersions.Compact();
 
-  m_ComponentCreationStream.Clear();
-  m_ComponentCreationStream.Compact();
+  m_ComponentsToCreate.Clear();
+  m_ComponentsToCreate.Compact();
 
   m_ComponentDataStream.Clear();
   m_ComponentDataStream.Compact();
+
+  m_BatchObjects.Clear();
+  m_BatchObjects.Compact();
+
+  m_BatchComponents.Clear();
+  m_BatchComponents.Compact();
 }
 
 ezUInt64 ezWorldReader::GetHeapMemoryUsage() const
 {
-  return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentCreationStream.GetHeapMemoryUsage() +
-         m_ComponentDataStream.GetHeapMemoryUsage();
+  return m_IndexToGameObjectHandle.GetHeapMemoryUsage() + m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentsToCreate.GetHeapMemoryUsage() +
+         m_ComponentDataStream.GetHeapMemoryUsage() + m_BatchObjects.GetHeapMemoryUsage() + m_BatchComponents.GetHeapMemoryUsage();
 }
 
 ezUInt32 ezWorldReader::GetRootObjectCount() const
@@ -246,70 +361,266 @@ void ezWorldReader::ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx)
   m_ComponentTypeVersions[pRtti] = uiRttiVersion;
 }
 
-void ezWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
+void ezWorldReader::ReadComponentCreationData(bool warningOnUnknownSkip)
 {
-  auto WriteToMemStream = [&](ezMemoryStreamWriter& ref_writer, bool bReadNumComponents)
+  ezStreamReader& s = *m_pStream;
+
+  m_ComponentsToCreate.Clear();
+
+  for (auto& compTypeInfo : m_ComponentTypes)
   {
-    ezUInt8 Temp[4096];
-    for (auto& compTypeInfo : m_ComponentTypes)
-    {
-      ezUInt32 uiAllComponentsSize = 0;
-      *m_pStream >> uiAllComponentsSize;
+    ezUInt32 uiAllComponentsSize = 0;
+    s >> uiAllComponentsSize;
 
-      if (compTypeInfo.m_pRtti == nullptr)
+    if (compTypeInfo.m_pRtti == nullptr)
+    {
+      if (warningOnUnknownSkip)
       {
-        if (warningOnUnknownSkip)
-        {
-          ezLog::Warning("Skipping components of unknown type");
-        }
-
-        m_pStream->SkipBytes(uiAllComponentsSize);
+        ezLog::Warning("Skipping components of unknown type");
       }
-      else
-      {
-        if (bReadNumComponents)
-        {
-          *m_pStream >> compTypeInfo.m_uiNumComponents;
-          uiAllComponentsSize -= sizeof(ezUInt32);
 
-          m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
-        }
+      s.SkipBytes(uiAllComponentsSize);
+      continue;
+    }
 
-        while (uiAllComponentsSize > 0)
-        {
-          const ezUInt64 uiRead = m_pStream->ReadBytes(Temp, ezMath::Min<ezUInt32>(uiAllComponentsSize, EZ_ARRAY_SIZE(Temp)));
+    s >> compTypeInfo.m_uiNumComponents;
+    uiAllComponentsSize -= sizeof(ezUInt32);
 
-          ref_writer.WriteBytes(Temp, uiRead).IgnoreResult();
+    m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
 
-          uiAllComponentsSize -= (ezUInt32)uiRead;
-        }
-      }
+    compTypeInfo.m_uiFirstComponentToCreate = m_ComponentsToCreate.GetCount();
+    m_ComponentsToCreate.Reserve(m_ComponentsToCreate.GetCount() + compTypeInfo.m_uiNumComponents);
+
+    // the creation data is parsed only once here, instead of every time the world is instantiated
+    for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+    {
+      ComponentToCreate& comp = m_ComponentsToCreate.ExpandAndGetRef();
+
+      ezUInt32 uiComponentIdx = 0;
+
+      s >> comp.m_uiOwnerHandleIdx;
+      s >> uiComponentIdx;
+      s >> comp.m_bActive;
+      s >> comp.m_uiUserFlags;
+
+      EZ_ASSERT_DEBUG(uiComponentIdx == i + 1, "Component index doesn't match");
+      uiAllComponentsSize -= sizeof(ezUInt32) * 2 + sizeof(bool) + sizeof(ezUInt8);
     }
-  };
 
-  {
-    ezMemoryStreamWriter writer(&m_ComponentCreationStream);
-    WriteToMemStream(writer, true);
+    EZ_ASSERT_DEBUG(uiAllComponentsSize == 0, "Unexpected component creation data");
   }
+}
+
+void ezWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
+{
+  ezMemoryStreamWriter writer(&m_ComponentDataStream);
 
+  ezUInt8 Temp[4096];
+  for (auto& compTypeInfo : m_ComponentTypes)
   {
-    ezMemoryStreamWriter writer(&m_ComponentDataStream);
-    WriteToMemStream(writer, false);
+    ezUInt32 uiAllComponentsSize = 0;
+    *m_pStream >> uiAllComponentsSize;
+
+    if (compTypeInfo.m_pRtti == nullptr)
+    {
+      if (warningOnUnknownSkip)
+      {
+        ezLog::Warning("Skipping components of unknown type");
+      }
+
+      m_pStream->SkipBytes(uiAllComponentsSize);
+    }
+    else
+    {
+      m_ComponentDataStream.Reserve(m_ComponentDataStream.GetStorageSize64() + uiAllComponentsSize);
+
+      while (uiAllComponentsSize > 0)
+      {
+        const ezUInt64 uiRead = m_pStream->ReadBytes(Temp, ezMath::Min<ezUInt32>(uiAllComponentsSize, EZ_ARRAY_SIZE(Temp)));
+
+        writer.WriteBytes(Temp, uiRead).IgnoreResult();
+
+        uiAllComponentsSize -= (ezUInt32)uiRead;
+      }
+    }
   }
 }
 
 void ezWorldReader::ClearHandles()
 {
+  // Clear() keeps the capacity, so repeated instantiations don't need to allocate
   m_IndexToGameObjectHandle.Clear();
+  m_IndexToGameObjectHandle.Reserve(m_RootObjectsToCreate.GetCount() + m_ChildObjectsToCreate.GetCount() + 1);
   m_IndexToGameObjectHandle.PushBack(ezGameObjectHandle());
+  m_uiFirstGameObjectHandle = 0;
 
   for (auto& compTypeInfo : m_ComponentTypes)
   {
+    compTypeInfo.m_uiFirstComponentHandle = 0;
     compTypeInfo.m_ComponentIndexToHandle.Clear();
+    compTypeInfo.m_ComponentIndexToHandle.Reserve(compTypeInfo.m_uiNumComponents + 1);
     compTypeInfo.m_ComponentIndexToHandle.PushBack(ezComponentHandle());
   }
 }
 
+void ezWorldReader::CreateGameObjectsBatched(ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions& inout_options)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::CreateGameObjects");
+
+  const ezUInt32 uiNumCopies = rootTransforms.GetCount();
+  const ezUInt32 uiNumRootObjects = m_RootObjectsToCreate.GetCount();
+  const ezUInt32 uiNumObjects = uiNumRootObjects + m_ChildObjectsToCreate.GetCount();
+
+  m_pWorld->ReserveObjects(uiNumCopies * uiNumObjects);
+
+  // one handle table per copy, each one starts with an invalid handle like in ClearHandles()
+  m_IndexToGameObjectHandle.Clear();
+  m_IndexToGameObjectHandle.SetCount(uiNumCopies * (uiNumObjects + 1));
+  m_BatchObjects.Clear();
+  m_BatchObjects.SetCount(uiNumCopies * (uiNumObjects + 1), nullptr);
+
+  for (ezUInt32 uiCopy = 0; uiCopy < uiNumCopies; ++uiCopy)
+  {
+    const ezUInt32 uiFirstHandle = uiCopy * (uiNumObjects + 1);
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      const bool bIsRoot = i < uiNumRootObjects;
+      const GameObjectToCreate& godesc = bIsRoot ? m_RootObjectsToCreate[i] : m_ChildObjectsToCreate[i - uiNumRootObjects];
+
+      ezGameObjectDesc desc = godesc.m_Desc; // make a copy
+      desc.m_hParent = (bIsRoot && !inout_options.m_hParent.IsInvalidated()) ? inout_options.m_hParent : m_IndexToGameObjectHandle[uiFirstHandle + godesc.m_uiParentHandleIdx];
+
+      ApplyInstantiationOptions(desc, inout_options);
+
+      if (bIsRoot)
+      {
+        ApplyRootTransform(desc, rootTransforms[uiCopy]);
+      }
+
+      ezGameObject* pObject = nullptr;
+      m_IndexToGameObjectHandle[uiFirstHandle + 1 + i] = m_pWorld->CreateObject(desc, pObject);
+      m_BatchObjects[uiFirstHandle + 1 + i] = pObject;
+
+      if (!godesc.m_sGlobalKey.IsEmpty())
+      {
+        pObject->SetGlobalKey(godesc.m_sGlobalKey);
+      }
+
+      ezDynamicArray<ezGameObject*>* pCreatedObjectsOut = bIsRoot ? inout_options.m_pCreatedRootObjectsOut : inout_options.m_pCreatedChildObjectsOut;
+      if (pCreatedObjectsOut)
+      {
+        pCreatedObjectsOut->PushBack(pObject);
+      }
+    }
+  }
+}
+
+void ezWorldReader::CreateComponentsBatched(ezUInt32 uiNumCopies)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
+
+  const ezUInt32 uiNumObjects = m_RootObjectsToCreate.GetCount() + m_ChildObjectsToCreate.GetCount();
+
+  // ordered by type, then by copy, so each manager is only looked up once
+  m_BatchComponents.Clear();
+  m_BatchComponents.SetCount(uiNumCopies * m_ComponentsToCreate.GetCount(), nullptr);
+
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    compTypeInfo.m_ComponentIndexToHandle.Clear();
+    compTypeInfo.m_ComponentIndexToHandle.SetCount(uiNumCopies * (compTypeInfo.m_uiNumComponents + 1));
+
+    // will be the case for all abstract component types
+    if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
+      continue;
+
+    ezComponentManagerBase* pManager = m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
+    EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
+
+    pManager->ReserveComponents(uiNumCopies * compTypeInfo.m_uiNumComponents);
+
+    ezComponent** pComponents = m_BatchComponents.GetData() + uiNumCopies * compTypeInfo.m_uiFirstComponentToCreate;
+
+    for (ezUInt32 uiCopy = 0; uiCopy < uiNumCopies; ++uiCopy)
+    {
+      ezGameObject* const* pObjects = m_BatchObjects.GetData() + uiCopy * (uiNumObjects + 1);
+      ezComponentHandle* pHandles = compTypeInfo.m_ComponentIndexToHandle.GetData() + uiCopy * (compTypeInfo.m_uiNumComponents + 1);
+
+      for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+      {
+        const ComponentToCreate& compToCreate = m_ComponentsToCreate[compTypeInfo.m_uiFirstComponentToCreate + i];
+
+        ezGameObject* pOwnerObject = pObjects[compToCreate.m_uiOwnerHandleIdx];
+        EZ_ASSERT_DEV(pOwnerObject != nullptr, "Owner object must be not null");
+
+        ezComponent* pComponent = nullptr;
+        pHandles[1 + i] = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
+
+        pComponent->SetActiveFlag(compToCreate.m_bActive);
+
+        for (ezUInt8 j = 0; j < 8; ++j)
+        {
+          pComponent->SetUserFlag(j, (compToCreate.m_uiUserFlags & EZ_BIT(j)) != 0);
+        }
+
+        *pComponents++ = pComponent;
+      }
+    }
+  }
+}
+
+void ezWorldReader::DeserializeComponentsBatched(ezUInt32 uiNumCopies)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::DeserializeComponents");
+
+  if (m_ComponentDataStream.GetStorageSize64() == 0)
+    return;
+
+  const ezUInt32 uiNumObjects = m_RootObjectsToCreate.GetCount() + m_ChildObjectsToCreate.GetCount();
+
+  // every copy reads the same data, only the handle tables are switched to the ones of the copy
+  ezRawMemoryStreamReader reader;
+
+  m_pStringDedupReadContext->SetActive(true);
+
+  ezStreamReader* pPrevReader = m_pStream;
+  m_pStream = &reader;
+
+  EZ_SCOPE_EXIT(m_pStream = pPrevReader; m_pStringDedupReadContext->SetActive(false););
+
+  for (ezUInt32 uiCopy = 0; uiCopy < uiNumCopies; ++uiCopy)
+  {
+    reader.Reset(m_ComponentDataStream.GetData(), m_ComponentDataStream.GetStorageSize64());
+    m_uiFirstGameObjectHandle = uiCopy * (uiNumObjects + 1);
+
+    for (auto& compTypeInfo : m_ComponentTypes)
+    {
+      compTypeInfo.m_uiFirstComponentHandle = uiCopy * (compTypeInfo.m_uiNumComponents + 1);
+    }
+
+    for (const auto& compTypeInfo : m_ComponentTypes)
+    {
+      if (compTypeInfo.m_pRtti == nullptr)
+        continue;
+
+      ezComponent* const* pComponents = m_BatchComponents.GetData() + uiNumCopies * compTypeInfo.m_uiFirstComponentToCreate + uiCopy * compTypeInfo.m_uiNumComponents;
+
+      for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+      {
+        pComponents[i]->DeserializeComponent(*this);
+      }
+    }
+  }
+
+  m_uiFirstGameObjectHandle = 0;
+
+  for (auto& compTypeInfo : m_ComponentTypes)
+  {
+    compTypeInfo.m_uiFirstComponentHandle = 0;
+  }
+}
+
 ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options)
 {
   m_pWorld = &world;
@@ -427,25 +738,14 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
     if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_Options.m_pCreatedChildObjectsOut, endTime))
       return StepResult::Continue;
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
     m_Phase = Phase::CreateComponents;
     BeginNextProgressStep("CreateComponents");
   }
 
   if (m_Phase == Phase::CreateComponents)
   {
-    if (m_WorldReader.m_ComponentCreationStream.GetStorageSize64() > 0)
-    {
-      m_WorldReader.m_pStringDedupReadContext->SetActive(true);
-
-      ezStreamReader* pPrevReader = m_WorldReader.m_pStream;
-      m_WorldReader.m_pStream = &m_CurrentReader;
-
-      EZ_SCOPE_EXIT(m_WorldReader.m_pStream = pPrevReader; m_WorldReader.m_pStringDedupReadContext->SetActive(false););
-
-      if (!CreateComponents(endTime))
-        return StepResult::Continue;
-    }
+    if (!CreateComponents(endTime))
+      return StepResult::Continue;
 
     m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
     m_Phase = Phase::DeserializeComponents;
@@ -513,13 +813,6 @@ void ezWorldReader::InstantiationContext::Cancel()
   m_pOverallProgressRange = nullptr;
 }
 
-// a super simple, but also efficient random number generator
-inline static ezUInt32 NextStableRandomSeed(ezUInt32& ref_uiSeed)
-{
-  ref_uiSeed = 214013L * ref_uiSeed + 2531011L;
-  return ((ref_uiSeed >> 16) & 0x7FFFF);
-}
-
 template <bool UseTransform>
 bool ezWorldReader::InstantiationContext::CreateGameObjects(const ezDynamicArray<GameObjectToCreate>& objects, ezGameObjectHandle hParent, ezDynamicArray<ezGameObject*>* out_pCreatedObjects, ezTime endTime)
 {
@@ -531,42 +824,12 @@ bool ezWorldReader::InstantiationContext::CreateGameObjects(const ezDynamicArray
 
     ezGameObjectDesc desc = godesc.m_Desc; // make a copy
     desc.m_hParent = hParent.IsInvalidated() ? m_WorldReader.m_IndexToGameObjectHandle[godesc.m_uiParentHandleIdx] : hParent;
-    desc.m_bDynamic |= m_Options.m_bForceDynamic;
 
-    switch (m_Options.m_RandomSeedMode)
-    {
-      case ezPrefabInstantiationOptions::RandomSeedMode::DeterministicFromParent:
-        desc.m_uiStableRandomSeed = 0xFFFFFFFF; // ezWorld::CreateObject() will either derive a deterministic value from the parent object, or assign a random value, if no parent exists
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::CompletelyRandom:
-        desc.m_uiStableRandomSeed = 0; // ezWorld::CreateObject() will assign a random value to this object
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::FixedFromSerialization:
-        // keep deserialized value
-        break;
-
-      case ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue:
-        // we use the given seed root value to assign a deterministic (but different) value to each game object
-        desc.m_uiStableRandomSeed = NextStableRandomSeed(m_Options.m_uiCustomRandomSeedRootValue);
-        break;
-    }
-
-    if (m_Options.m_pOverrideTeamID != nullptr)
-    {
-      desc.m_uiTeamID = *m_Options.m_pOverrideTeamID;
-    }
+    ApplyInstantiationOptions(desc, m_Options);
 
     if (UseTransform)
     {
-      ezTransform tChild(desc.m_LocalPosition, desc.m_LocalRotation, desc.m_LocalScaling);
-      ezTransform tFinal;
-      tFinal = ezTransform::MakeGlobalTransform(m_RootTransform, tChild);
-
-      desc.m_LocalPosition = tFinal.m_vPosition;
-      desc.m_LocalRotation = tFinal.m_qRotation;
-      desc.m_LocalScaling = tFinal.m_vScale;
+      ApplyRootTransform(desc, m_RootTransform);
     }
 
     ezGameObject* pObject = nullptr;
@@ -601,8 +864,6 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
 
-  ezStreamReader& s = *m_WorldReader.m_pStream;
-
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
@@ -616,16 +877,8 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 
     while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
     {
-      const ezGameObjectHandle hOwner = m_WorldReader.ReadGameObjectHandle();
-
-      ezUInt32 uiComponentIdx = 0;
-      s >> uiComponentIdx;
-
-      bool bActive = true;
-      s >> bActive;
-
-      ezUInt8 userFlags = 0;
-      s >> userFlags;
+      const ComponentToCreate& compToCreate = m_WorldReader.m_ComponentsToCreate[compTypeInfo.m_uiFirstComponentToCreate + m_uiCurrentIndex];
+      const ezGameObjectHandle hOwner = m_WorldReader.m_IndexToGameObjectHandle[compToCreate.m_uiOwnerHandleIdx];
 
       ezGameObject* pOwnerObject = nullptr;
       if (!m_WorldReader.m_pWorld->TryGetObject(hOwner, pOwnerObject))
@@ -636,14 +889,13 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
       ezComponent* pComponent = nullptr;
       auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
 
-      pComponent->SetActiveFlag(bActive);
+      pComponent->SetActiveFlag(compToCreate.m_bActive);
 
       for (ezUInt8 j = 0; j < 8; ++j)
       {
-        pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
+        pComponent->SetUserFlag(j, (compToCreate.m_uiUserFlags & EZ_BIT(j)) != 0);
       }
 
-      EZ_ASSERT_DEBUG(uiComponentIdx == compTypeInfo.m_ComponentIndexToHandle.GetCount(), "Component index doesn't match");
       compTypeInfo.m_ComponentIndexToHandle.PushBack(hComponent);
 
       ++m_uiCurrentIndex;
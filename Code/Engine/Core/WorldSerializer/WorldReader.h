@@ -117,6 +117,15 @@ public:
   /// has to be valid as long as the instantiation is in progress.
   ezUniquePtr<InstantiationContextBase> InstantiatePrefab(ezWorld& ref_world, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
+  /// \brief Creates one instance of the world for every transform in \a rootTransforms.
+  ///
+  /// This is more efficient than calling InstantiatePrefab() in a loop, e.g. to spawn many bullets or debris pieces at once.
+  /// The world is only locked once, object and component storage is reserved for all copies up front and every phase
+  /// (object creation, component creation, deserialization, initialization) is executed for all copies in one go.
+  /// The instantiation is always finished within this call, options.m_MaxStepTime and options.m_pProgress are ignored.
+  /// The created objects of all copies are appended to the output arrays in \a options, one copy after the other.
+  void InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options);
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
   ezStreamReader& GetStream() const { return *m_pStream; }
 
@@ -166,10 +175,24 @@ private:
     ezUInt32 m_uiParentHandleIdx;
   };
 
+  /// \brief The creation data of a component, which is read once, so that instantiation doesn't need to parse it again.
+  struct ComponentToCreate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiOwnerHandleIdx;
+    bool m_bActive;
+    ezUInt8 m_uiUserFlags;
+  };
+
   void ReadGameObjectDesc(GameObjectToCreate& godesc);
   void ReadComponentTypeInfo(ezUInt32 uiComponentTypeIdx);
+  void ReadComponentCreationData(bool warningOnUnknownSkip);
   void ReadComponentDataToMemStream(bool warningOnUnknownSkip = true);
   void ClearHandles();
+  void CreateGameObjectsBatched(ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions& inout_options);
+  void CreateComponentsBatched(ezUInt32 uiNumCopies);
+  void DeserializeComponentsBatched(ezUInt32 uiNumCopies);
   ezUniquePtr<InstantiationContextBase> Instantiate(ezWorld& world, bool bUseTransform, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
   ezStreamReader* m_pStream = nullptr;
@@ -177,6 +200,7 @@ private:
 
   ezUInt8 m_uiVersion = 0;
   ezDynamicArray<ezGameObjectHandle> m_IndexToGameObjectHandle;
+  ezUInt32 m_uiFirstGameObjectHandle = 0; ///< InstantiatePrefabs() stores the handles of all copies in m_IndexToGameObjectHandle, this is the start of the current copy
 
   ezDynamicArray<GameObjectToCreate> m_RootObjectsToCreate;
   ezDynamicArray<GameObjectToCreate> m_ChildObjectsToCreate;
@@ -185,15 +209,21 @@ private:
   {
     const ezRTTI* m_pRtti = nullptr;
     ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
+    ezUInt32 m_uiFirstComponentHandle = 0; ///< Same as m_uiFirstGameObjectHandle, but for m_ComponentIndexToHandle
     ezUInt32 m_uiNumComponents = 0;
+    ezUInt32 m_uiFirstComponentToCreate = 0; ///< Index into m_ComponentsToCreate
   };
 
   ezDynamicArray<ComponentTypeInfo> m_ComponentTypes;
   ezHashTable<const ezRTTI*, ezUInt32> m_ComponentTypeVersions;
-  ezDefaultMemoryStreamStorage m_ComponentCreationStream;
-  ezDefaultMemoryStreamStorage m_ComponentDataStream;
+  ezDynamicArray<ComponentToCreate> m_ComponentsToCreate;
+  ezContiguousMemoryStreamStorage m_ComponentDataStream; ///< Contiguous, so that InstantiatePrefabs() can deserialize every copy straight from memory
   ezUInt64 m_uiTotalNumComponents = 0;
 
+  // Objects and components created by InstantiatePrefabs(), kept as members to reuse the memory
+  ezDynamicArray<ezGameObject*> m_BatchObjects;
+  ezDynamicArray<ezComponent*> m_BatchComponents;
+
   ezUniquePtr<ezStringDeduplicationReadContext> m_pStringDedupReadContext;
 
   class InstantiationContext : public InstantiationContextBase
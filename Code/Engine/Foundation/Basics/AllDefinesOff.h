@@ -69,6 +69,7 @@
 
 // Allocators
 #define EZ_ALLOC_GUARD_ALLOCATIONS EZ_OFF
+#define EZ_ALLOC_THREAD_CACHE_HEAP EZ_OFF
 #define EZ_ALLOC_TRACKING_DEFAULT ezAllocatorTrackingMode::Nothing
 
 // Other Features
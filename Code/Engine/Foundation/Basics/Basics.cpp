@@ -6,6 +6,10 @@
 using DefaultHeapType = ezGuardingAllocator;
 using DefaultAlignedHeapType = ezGuardingAllocator;
 using DefaultStaticsHeapType = ezAllocatorWithPolicy<ezAllocPolicyGuarding, ezAllocatorTrackingMode::AllocationStatsIgnoreLeaks>;
+#elif EZ_ENABLED(EZ_ALLOC_THREAD_CACHE_HEAP)
+using DefaultHeapType = ezThreadCacheHeapAllocator;
+using DefaultAlignedHeapType = ezAlignedHeapAllocator;
+using DefaultStaticsHeapType = ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::AllocationStatsIgnoreLeaks>;
 #else
 using DefaultHeapType = ezHeapAllocator;
 using DefaultAlignedHeapType = ezAlignedHeapAllocator;
@@ -15,11 +19,12 @@ using DefaultStaticsHeapType = ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAlloca
 enum
 {
   HEAP_ALLOCATOR_BUFFER_SIZE = sizeof(DefaultHeapType),
+  STATICS_ALLOCATOR_BUFFER_SIZE = sizeof(DefaultStaticsHeapType),
   ALIGNED_ALLOCATOR_BUFFER_SIZE = sizeof(DefaultAlignedHeapType)
 };
 
 alignas(EZ_ALIGNMENT_MINIMUM) static ezUInt8 s_DefaultAllocatorBuffer[HEAP_ALLOCATOR_BUFFER_SIZE];
-alignas(EZ_ALIGNMENT_MINIMUM) static ezUInt8 s_StaticAllocatorBuffer[HEAP_ALLOCATOR_BUFFER_SIZE];
+alignas(EZ_ALIGNMENT_MINIMUM) static ezUInt8 s_StaticAllocatorBuffer[STATICS_ALLOCATOR_BUFFER_SIZE];
 
 alignas(EZ_ALIGNMENT_MINIMUM) static ezUInt8 s_AlignedAllocatorBuffer[ALIGNED_ALLOCATOR_BUFFER_SIZE];
 
@@ -12,6 +12,8 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_chunked,    ///< Independently compressed zstd chunks with a chunk table, allows random access and parallel decompression. Added in archive version 5.
+  Compressed_zstd_dictionary, ///< Like Compressed_zstd, but compressed with a raw content dictionary that is shared by multiple entries. Added in archive version 6.
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -22,6 +22,18 @@ public:
   // all the source files from disk that should be put into the ezArchive
   ezDeque<SourceEntry> m_Entries;
 
+  /// \brief zstd compressed files up to this size are grouped by file extension and compressed with a dictionary that is shared by the group.
+  ///
+  /// Small files of the same type (configs, materials, prefabs) compress badly on their own, because zstd has no history to find matches in.
+  /// The dictionary is built from samples of the files and is stored only once in the archive. Zero disables dictionary compression.
+  ezUInt32 m_uiMaxDictionaryFileSize = 0;
+
+  /// \brief The maximum size of each dictionary, see m_uiMaxDictionaryFileSize.
+  ezUInt32 m_uiDictionarySize = 16 * 1024;
+
+  /// \brief A dictionary is only built for file extensions that have at least this many files.
+  ezUInt32 m_uiMinDictionaryFiles = 8;
+
   enum class InclusionMode
   {
     Exclude,               ///< Do not add this file to the archive
@@ -46,13 +58,18 @@ public:
   ezResult WriteArchive(ezStringView sFile) const;
 
   /// \brief Writes the previously gathered files to the file stream
+  ///
+  /// Files are compressed in parallel on the ezTaskSystem worker threads, but they are always written in the order of m_Entries.
+  /// Files with identical content are only stored once, all their TOC entries reference the same data.
   ezResult WriteArchive(ezStreamWriter& inout_stream) const;
 
 protected:
   /// Override this to get a callback when the next file is being written to the output. Return 'true' to continue, 'false' to cancel the entire archive generation.
   virtual bool WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const;
-  /// Override this to get a progress report for writing a single file to the output
+  /// Override this to get a progress report for writing a single file to the output.
+  /// Files that are compressed in parallel only report their progress once they are written.
   virtual bool WriteFileProgressCallback(ezUInt64 bytesWritten, ezUInt64 bytesTotal) const;
   /// Override this to get a callback after a file has been processed. Gets additional information about the compression result and duration.
+  /// For files that are duplicates of a previous file, the stored size is zero.
   virtual void WriteFileResultCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile, ezUInt64 uiSourceSize, ezUInt64 uiStoredSize, ezTime duration) const {}
 };
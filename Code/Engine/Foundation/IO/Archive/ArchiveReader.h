@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -33,6 +34,22 @@ public:
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Returns the data of an uncompressed entry directly from the memory mapped archive, without any copy.
+  ///
+  /// The view stays valid as long as the archive is open. Returns an empty array for compressed entries.
+  ezConstByteArrayPtr GetUncompressedEntryData(ezUInt32 uiEntryIdx) const;
+
+  /// \brief Reads uncompressed data of the given entry, starting at \a uiOffset. Returns the number of bytes that were read.
+  ///
+  /// See ezArchiveUtils::ReadEntryData() for which entries support efficient random access.
+  ezUInt64 ReadEntryData(ezUInt32 uiEntryIdx, ezUInt64 uiOffset, ezByteArrayPtr destination) const;
+
+  /// \brief Gives access to the chunks of an ezArchiveCompressionMode::Compressed_zstd_chunked entry.
+  ezResult GetChunkedEntry(ezUInt32 uiEntryIdx, ezArchiveUtils::ChunkedEntry& out_chunkedEntry) const;
+
+  /// \brief Returns the compressed data and the dictionary of an ezArchiveCompressionMode::Compressed_zstd_dictionary entry.
+  ezResult GetDictionaryEntryData(ezUInt32 uiEntryIdx, ezConstByteArrayPtr& out_compressedData, ezConstByteArrayPtr& out_dictionary) const;
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Stream.h>
 #include <Foundation/Types/Delegate.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -18,6 +19,16 @@ namespace ezArchiveUtils
   constexpr ezUInt32 ArchiveHeaderSize = 16;
   constexpr ezUInt32 ArchiveTOCMetaMaxFooterSize = 14 + 12; //< note that it's the MAX size, i.e. toc meta can be smaller
 
+  /// Files of at least this size, that should be compressed with zstd, are stored as ezArchiveCompressionMode::Compressed_zstd_chunked.
+  constexpr ezUInt64 ChunkedEntryMinSize = 1024 * 1024;
+
+  /// The number of uncompressed bytes in every chunk of an ezArchiveCompressionMode::Compressed_zstd_chunked entry, except for the last one.
+  constexpr ezUInt32 ChunkedEntryChunkSize = 1024 * 256;
+
+  /// The size of the header in front of the compressed data of ezArchiveCompressionMode::Compressed_zstd_dictionary entries.
+  /// It stores where the dictionary is located in the archive (ezUInt64 offset, ezUInt32 size).
+  constexpr ezUInt32 DictionaryEntryHeaderSize = 12;
+
   struct TOCMeta
   {
     ezUInt32 m_uiTocSize = 0;
@@ -59,6 +70,7 @@ namespace ezArchiveUtils
   ///
   /// Appends information to the TOC for finding the data in the stream. Reads and updates inout_uiCurrentStreamPosition with the data byte
   /// offset. The progress callback is executed for every couple of KB of data that were written.
+  /// Files of at least ChunkedEntryMinSize bytes that should be compressed with zstd, are stored as ezArchiveCompressionMode::Compressed_zstd_chunked.
   EZ_FOUNDATION_DLL ezResult WriteEntry(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezInt32 iCompressionLevel, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
     FileWriteProgressCallback progress = FileWriteProgressCallback());
@@ -70,6 +82,14 @@ namespace ezArchiveUtils
   EZ_FOUNDATION_DLL ezResult WriteEntryPreprocessed(ezStreamWriter& inout_stream, ezConstByteArrayPtr entryData, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezUInt32 uiUncompressedEntryDataSize, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition);
 
+  /// \brief Writes a single file entry, compressed with zstd and the given raw content dictionary.
+  ///
+  /// The dictionary itself has to be written to the archive stream separately (once) and in front of all entries that use it,
+  /// \a uiDictionaryOffset is its position in the stream.
+  /// Creates an ezArchiveCompressionMode::Compressed_zstd_dictionary entry. Since the entire file is compressed at once, this is meant for small files.
+  EZ_FOUNDATION_DLL ezResult WriteEntryWithDictionary(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset,
+    ezInt32 iCompressionLevel, ezConstByteArrayPtr dictionary, ezUInt64 uiDictionaryOffset, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition);
+
   /// \brief Similar to WriteEntry, but if compression is enabled, checks that compression makes enough of a difference.
   /// If compression does not reduce file size enough, the file is stored uncompressed instead.
   EZ_FOUNDATION_DLL ezResult WriteEntryOptimal(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset,
@@ -87,8 +107,83 @@ namespace ezArchiveUtils
   /// Under the hood it may create different types of stream readers to uncompress or decode the data.
   EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData);
 
+  /// \brief Returns the compressed data of an ezArchiveCompressionMode::Compressed_zstd_dictionary entry and the dictionary it was compressed with.
+  ///
+  /// The compressed data uses the same layout as ezArchiveCompressionMode::Compressed_zstd entries and can be read with ezCompressedStreamReaderZstd.
+  ///
+  /// Fails, if the entry doesn't use a dictionary or its header is corrupted.
+  EZ_FOUNDATION_DLL ezResult GetDictionaryEntryData(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ezConstByteArrayPtr& out_compressedData, ezConstByteArrayPtr& out_dictionary);
+
+  /// \brief Returns the data of an uncompressed entry as a view into the archive memory, without copying it.
+  ///
+  /// Returns an empty array for compressed entries.
+  EZ_FOUNDATION_DLL ezConstByteArrayPtr GetUncompressedEntryData(const ezArchiveEntry& entry, const void* pStartOfArchiveData);
+
+  /// \brief Reads the uncompressed data of the given entry, starting at \a uiOffset. Returns the number of bytes that were read.
+  ///
+  /// Uncompressed and chunked entries are read without touching any data before \a uiOffset. For chunked entries only the chunks that
+  /// overlap the requested range are decompressed, in parallel. Other compressed entries have to be decompressed from the start.
+  EZ_FOUNDATION_DLL ezUInt64 ReadEntryData(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ezUInt64 uiOffset, ezByteArrayPtr destination);
+
+  /// \brief Gives access to the chunks of an ezArchiveCompressionMode::Compressed_zstd_chunked entry.
+  ///
+  /// The stored data of such an entry consists of the independently compressed chunks, followed by the chunk table
+  /// (the start offset of every chunk plus the end offset of the last one, as ezUInt64), the chunk size and the number of chunks (both ezUInt32).
+  /// The table is at the end, so that entries can be written in a single pass.
+  struct EZ_FOUNDATION_DLL ChunkedEntry
+  {
+    ezUInt64 m_uiUncompressedDataSize = 0;
+    ezUInt32 m_uiChunkSize = 0;
+    ezUInt32 m_uiNumChunks = 0;
+    const ezUInt8* m_pChunkData = nullptr;
+    const ezUInt8* m_pChunkTable = nullptr;
+
+    /// \brief Returns the compressed data of the given chunk.
+    ezConstByteArrayPtr GetCompressedChunk(ezUInt32 uiChunk) const;
+
+    /// \brief Returns the number of bytes that the given chunk decompresses to.
+    ezUInt32 GetUncompressedChunkSize(ezUInt32 uiChunk) const;
+
+    /// \brief Decompresses a single chunk. \a pDestination must have room for GetUncompressedChunkSize() bytes.
+    ezResult DecompressChunk(ezUInt32 uiChunk, void* pDestination) const;
+
+    /// \brief Decompresses consecutive chunks into consecutive memory. The chunks are distributed across the worker threads.
+    ezResult DecompressChunks(ezUInt32 uiFirstChunk, ezUInt32 uiNumChunks, void* pDestination) const;
+  };
+
+  /// \brief Sets up \a out_chunkedEntry for the given entry. Fails, if the entry is not chunked or its chunk table is corrupted.
+  EZ_FOUNDATION_DLL ezResult GetChunkedEntry(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ChunkedEntry& out_chunkedEntry);
+
   EZ_FOUNDATION_DLL ezResult ReadZipHeader(ezStreamReader& inout_stream, ezUInt8& out_uiVersion);
   EZ_FOUNDATION_DLL ezResult ExtractZipTOC(const ezMemoryMappedFile& memFile, ezArchiveTOC& ref_toc);
 
 
 } // namespace ezArchiveUtils
+
+/// \brief Stream reader for ezArchiveCompressionMode::Compressed_zstd_chunked entries.
+///
+/// Only the chunks that are actually read get decompressed, so skipping through the entry is cheap.
+/// Reads that span entire chunks decompress them in parallel, directly into the target buffer.
+class EZ_FOUNDATION_DLL ezArchiveChunkedEntryReader : public ezStreamReader
+{
+public:
+  ezArchiveChunkedEntryReader();
+  ~ezArchiveChunkedEntryReader();
+
+  /// \brief Sets the entry to read from and resets the read position.
+  void SetChunkedEntry(const ezArchiveUtils::ChunkedEntry& entry);
+
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Moves the read position to the given uncompressed byte offset.
+  void SetReadPosition(ezUInt64 uiReadPosition);
+
+  ezUInt64 GetReadPosition() const { return m_uiReadPosition; }
+
+private:
+  ezArchiveUtils::ChunkedEntry m_Entry;
+  ezUInt64 m_uiReadPosition = 0;
+  ezUInt32 m_uiCachedChunk = ezInvalidIndex;
+  ezDynamicArray<ezUInt8> m_ChunkCache;
+};
@@ -14,6 +14,7 @@ namespace ezDataDirectory
 {
   class ArchiveReaderUncompressed;
   class ArchiveReaderZstd;
+  class ArchiveReaderZstdChunked;
   class ArchiveReaderZip;
 
   class EZ_FOUNDATION_DLL ArchiveType : public ezDataDirectoryType
@@ -51,6 +52,8 @@ namespace ezDataDirectory
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZstd>, 4> m_ReadersZstd;
     ezHybridArray<ArchiveReaderZstd*, 4> m_FreeReadersZstd;
+    ezHybridArray<ezUniquePtr<ArchiveReaderZstdChunked>, 4> m_ReadersZstdChunked;
+    ezHybridArray<ArchiveReaderZstdChunked*, 4> m_FreeReadersZstdChunked;
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZip>, 4> m_ReadersZip;
@@ -66,6 +69,7 @@ namespace ezDataDirectory
     ArchiveReaderCommon(ezInt32 iDataDirUserData);
 
     virtual ezUInt64 GetFileSize() const override;
+    virtual ezConstByteArrayPtr GetFileMemoryView() const override;
 
   protected:
     friend class ArchiveType;
@@ -73,6 +77,7 @@ namespace ezDataDirectory
     ezUInt64 m_uiUncompressedSize = 0;
     ezUInt64 m_uiCompressedSize = 0;
     ezRawMemoryStreamReader m_MemStreamReader;
+    ezConstByteArrayPtr m_UncompressedData;
   };
 
   class EZ_FOUNDATION_DLL ArchiveReaderUncompressed : public ArchiveReaderCommon
@@ -104,7 +109,31 @@ namespace ezDataDirectory
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
     virtual void InternalClose() override;
 
+    friend class ArchiveType;
+
     ezCompressedStreamReaderZstd m_CompressedStreamReader;
+    ezConstByteArrayPtr m_Dictionary;
+  };
+
+  /// \brief Reads ezArchiveCompressionMode::Compressed_zstd_chunked entries. Skipping only has to decompress the chunk that is read afterwards.
+  class EZ_FOUNDATION_DLL ArchiveReaderZstdChunked : public ArchiveReaderCommon
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(ArchiveReaderZstdChunked);
+
+  public:
+    ArchiveReaderZstdChunked(ezInt32 iDataDirUserData);
+
+    virtual ezUInt64 Skip(ezUInt64 uiBytes) override;
+    virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+
+  protected:
+    virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
+    virtual void InternalClose() override;
+
+    friend class ArchiveType;
+
+    ezArchiveUtils::ChunkedEntry m_ChunkedEntry;
+    ezArchiveChunkedEntryReader m_ChunkedReader;
   };
 #endif
 
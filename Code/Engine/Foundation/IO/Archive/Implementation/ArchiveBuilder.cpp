@@ -1,11 +1,16 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/Containers/Map.h>
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 
 void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressionMode defaultMode /*= ezArchiveCompressionMode::Uncompressed*/, InclusionCallback callback /*= InclusionCallback()*/)
@@ -94,6 +99,110 @@ ezResult ezArchiveBuilder::WriteArchive(ezStringView sFile) const
   return WriteArchive(file);
 }
 
+namespace
+{
+  struct ezArchiveBuilderFileInfo
+  {
+    ezUInt64 m_uiContentHash = 0;
+    ezUInt64 m_uiFileSize = 0;
+    ezResult m_Result = EZ_FAILURE;
+    ezUInt32 m_uiDuplicateOf = ezInvalidIndex;
+    ezUInt32 m_uiDictionary = ezInvalidIndex;
+  };
+
+  struct ezArchiveBuilderDictionary
+  {
+    ezDynamicArray<ezUInt8> m_Data;
+    ezUInt64 m_uiOffset = 0;
+  };
+
+  struct ezArchiveBuilderCompressedFile
+  {
+    ezDefaultMemoryStreamStorage m_Storage;
+    ezArchiveEntry m_Entry;
+    ezResult m_Result = EZ_FAILURE;
+    ezTime m_Duration;
+  };
+
+  /// the amount of source data that is compressed in memory, before it is written to the output
+  constexpr ezUInt64 s_uiArchiveBuilderBatchSize = 256 * 1024 * 1024;
+
+  ezResult ReadArchiveBuilderFileInfo(ezStringView sFile, ezArchiveBuilderFileInfo& out_info)
+  {
+    ezFileReader file;
+    if (file.Open(sFile, 1024 * 1024).Failed())
+    {
+      ezLog::Error("Could not open '{}' for reading.", sFile);
+      return EZ_FAILURE;
+    }
+
+    ezHashStreamWriter64 hash;
+    ezUInt8 buf[1024 * 16];
+
+    while (true)
+    {
+      const ezUInt64 uiRead = file.ReadBytes(buf, EZ_ARRAY_SIZE(buf));
+
+      if (uiRead == 0)
+        break;
+
+      hash.WriteBytes(buf, uiRead).AssertSuccess();
+      out_info.m_uiFileSize += uiRead;
+    }
+
+    out_info.m_uiContentHash = hash.GetHashValue();
+    return EZ_SUCCESS;
+  }
+
+  bool AreArchiveBuilderFilesEqual(ezStringView sFileA, ezStringView sFileB)
+  {
+    ezFileReader fileA;
+    ezFileReader fileB;
+    if (fileA.Open(sFileA, 1024 * 1024).Failed() || fileB.Open(sFileB, 1024 * 1024).Failed())
+      return false;
+
+    ezUInt8 bufA[1024 * 16];
+    ezUInt8 bufB[1024 * 16];
+
+    while (true)
+    {
+      const ezUInt64 uiReadA = fileA.ReadBytes(bufA, EZ_ARRAY_SIZE(bufA));
+      const ezUInt64 uiReadB = fileB.ReadBytes(bufB, EZ_ARRAY_SIZE(bufB));
+
+      if (uiReadA != uiReadB || !ezMemoryUtils::IsEqual(bufA, bufB, static_cast<size_t>(uiReadA)))
+        return false;
+
+      if (uiReadA == 0)
+        return true;
+    }
+  }
+
+  void BuildArchiveBuilderDictionary(const ezDeque<ezArchiveBuilder::SourceEntry>& entries, ezArrayPtr<const ezUInt32> files, ezUInt32 uiDictionarySize, ezDynamicArray<ezUInt8>& out_dictionary)
+  {
+    // zstd can use any data as a dictionary, so it is simply made up from the beginning of as many files as fit
+    // matches are found where files of the same type have the same structure, which is the case for headers and common properties
+    const ezUInt32 uiMaxSampleSize = ezMath::Max(uiDictionarySize / files.GetCount(), 1024u);
+
+    out_dictionary.Reserve(uiDictionarySize);
+
+    for (ezUInt32 uiEntry : files)
+    {
+      const ezUInt32 uiSampleSize = ezMath::Min(uiMaxSampleSize, uiDictionarySize - out_dictionary.GetCount());
+
+      if (uiSampleSize == 0)
+        break;
+
+      ezFileReader file;
+      if (file.Open(entries[uiEntry].m_sAbsSourcePath).Failed())
+        continue;
+
+      const ezUInt32 uiPrevSize = out_dictionary.GetCount();
+      out_dictionary.SetCountUninitialized(uiPrevSize + uiSampleSize);
+      out_dictionary.SetCountUninitialized(uiPrevSize + static_cast<ezUInt32>(file.ReadBytes(out_dictionary.GetData() + uiPrevSize, uiSampleSize)));
+    }
+  }
+} // namespace
+
 ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
 {
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(inout_stream));
@@ -105,27 +214,235 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
   ezUInt64 uiStreamSize = 0;
   const ezUInt32 uiNumEntries = m_Entries.GetCount();
 
+  ezDynamicArray<ezArchiveBuilderFileInfo> fileInfos;
+  fileInfos.SetCount(uiNumEntries);
+
+  // hash the content of all files, to find the ones that are identical
+  ezTaskSystem::ParallelForIndexed(0, uiNumEntries, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        fileInfos[i].m_Result = ReadArchiveBuilderFileInfo(m_Entries[i].m_sAbsSourcePath, fileInfos[i]);
+      }
+    },
+    "ArchiveBuilder.Hash");
+
+  {
+    ezHashTable<ezUInt64, ezUInt32> contentToEntry;
+
+    for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+    {
+      ezArchiveBuilderFileInfo& info = fileInfos[i];
+
+      if (info.m_Result.Failed())
+        return EZ_FAILURE;
+
+      ezUInt32 uiOriginal = ezInvalidIndex;
+      if (contentToEntry.TryGetValue(info.m_uiContentHash, uiOriginal))
+      {
+        if (fileInfos[uiOriginal].m_uiFileSize == info.m_uiFileSize)
+        {
+          info.m_uiDuplicateOf = uiOriginal;
+        }
+      }
+      else
+      {
+        contentToEntry.Insert(info.m_uiContentHash, i);
+      }
+    }
+
+    // a matching hash and size is only a candidate, the content has to be identical to store the entry only once
+    ezTaskSystem::ParallelForIndexed(0, uiNumEntries, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          ezArchiveBuilderFileInfo& info = fileInfos[i];
+
+          if (info.m_uiDuplicateOf != ezInvalidIndex && !AreArchiveBuilderFilesEqual(m_Entries[i].m_sAbsSourcePath, m_Entries[info.m_uiDuplicateOf].m_sAbsSourcePath))
+          {
+            info.m_uiDuplicateOf = ezInvalidIndex;
+          }
+        }
+      },
+      "ArchiveBuilder.Compare");
+  }
+
+  ezDeque<ezArchiveBuilderDictionary> dictionaries;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (m_uiMaxDictionaryFileSize > 0)
+  {
+    ezMap<ezString, ezDynamicArray<ezUInt32>> filesPerExtension;
+
+    for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+    {
+      if (m_Entries[i].m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd || fileInfos[i].m_uiDuplicateOf != ezInvalidIndex || fileInfos[i].m_uiFileSize > m_uiMaxDictionaryFileSize)
+        continue;
+
+      sHashablePath = ezPathUtils::GetFileExtension(m_Entries[i].m_sAbsSourcePath);
+      sHashablePath.ToLower();
+
+      filesPerExtension[sHashablePath].PushBack(i);
+    }
+
+    for (auto it = filesPerExtension.GetIterator(); it.IsValid(); ++it)
+    {
+      if (it.Value().GetCount() < ezMath::Max(m_uiMinDictionaryFiles, 1u))
+        continue;
+
+      ezArchiveBuilderDictionary& dict = dictionaries.ExpandAndGetRef();
+      BuildArchiveBuilderDictionary(m_Entries, it.Value(), m_uiDictionarySize, dict.m_Data);
+
+      if (dict.m_Data.IsEmpty())
+      {
+        dictionaries.PopBack();
+        continue;
+      }
+
+      // the dictionaries are stored in front of all entries, they are only referenced by the entries themselves
+      dict.m_uiOffset = uiStreamSize;
+      EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(dict.m_Data.GetData(), dict.m_Data.GetCount()));
+      uiStreamSize += dict.m_Data.GetCount();
+
+      for (ezUInt32 uiEntry : it.Value())
+      {
+        fileInfos[uiEntry].m_uiDictionary = dictionaries.GetCount() - 1;
+      }
+    }
+  }
+#endif
+
+  ezDeque<ezArchiveBuilderCompressedFile> compressedFiles;
+
   ezStopwatch sw;
 
-  for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+  for (ezUInt32 uiBatchStart = 0; uiBatchStart < uiNumEntries;)
   {
-    const SourceEntry& e = m_Entries[i];
+    // compress a batch of files in parallel, the memory usage is limited by the amount of source data per batch
+    ezUInt32 uiBatchEnd = uiBatchStart;
+    ezUInt64 uiBatchSize = 0;
+
+    while (uiBatchEnd < uiNumEntries && (uiBatchSize < s_uiArchiveBuilderBatchSize || uiBatchEnd == uiBatchStart))
+    {
+      if (m_Entries[uiBatchEnd].m_CompressionMode != ezArchiveCompressionMode::Uncompressed && fileInfos[uiBatchEnd].m_uiDuplicateOf == ezInvalidIndex)
+      {
+        uiBatchSize += fileInfos[uiBatchEnd].m_uiFileSize;
+      }
+
+      ++uiBatchEnd;
+    }
 
-    const ezUInt32 uiPathStringOffset = toc.AddPathString(e.m_sRelTargetPath);
+    compressedFiles.Clear();
+    compressedFiles.SetCount(uiBatchEnd - uiBatchStart);
 
-    sHashablePath = e.m_sRelTargetPath;
-    sHashablePath.ToLower();
+    ezTaskSystem::ParallelForIndexed(0, uiBatchEnd - uiBatchStart, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 uiItem = uiStartIndex; uiItem < uiEndIndex; ++uiItem)
+        {
+          const SourceEntry& e = m_Entries[uiBatchStart + uiItem];
+          const ezArchiveBuilderFileInfo& info = fileInfos[uiBatchStart + uiItem];
 
-    toc.m_PathToEntryIndex[ezArchiveStoredString(ezHashingUtils::StringHash(sHashablePath), uiPathStringOffset)] = toc.m_Entries.GetCount();
+          if (e.m_CompressionMode == ezArchiveCompressionMode::Uncompressed || info.m_uiDuplicateOf != ezInvalidIndex)
+            continue;
 
-    if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
-      return EZ_FAILURE;
+          ezArchiveBuilderCompressedFile& compressed = compressedFiles[uiItem];
+
+          ezStopwatch swFile;
+          ezUInt64 uiStreamPos = 0;
+
+          if (info.m_uiDictionary != ezInvalidIndex)
+          {
+            const ezArchiveBuilderDictionary& dict = dictionaries[info.m_uiDictionary];
+
+            ezMemoryStreamWriter writer(&compressed.m_Storage);
+            compressed.m_Result = ezArchiveUtils::WriteEntryWithDictionary(writer, e.m_sAbsSourcePath, 0, e.m_iCompressionLevel, dict.m_Data, dict.m_uiOffset, compressed.m_Entry, uiStreamPos);
+          }
+
+          if (info.m_uiDictionary == ezInvalidIndex)
+          {
+            ezMemoryStreamWriter writer(&compressed.m_Storage);
+            compressed.m_Result = ezArchiveUtils::WriteEntryOptimal(writer, e.m_sAbsSourcePath, 0, e.m_CompressionMode, e.m_iCompressionLevel, compressed.m_Entry, uiStreamPos);
+          }
+          else if (compressed.m_Result.Succeeded())
+          {
+            // the files are small, so also trying without the dictionary is cheap, and it isn't guaranteed to help for every file
+            ezDefaultMemoryStreamStorage storage;
+            ezMemoryStreamWriter writer(&storage);
+
+            ezArchiveEntry entry;
+            uiStreamPos = 0;
+
+            if (ezArchiveUtils::WriteEntryOptimal(writer, e.m_sAbsSourcePath, 0, e.m_CompressionMode, e.m_iCompressionLevel, entry, uiStreamPos).Succeeded() && entry.m_uiStoredDataSize <= compressed.m_Entry.m_uiStoredDataSize)
+            {
+              compressed.m_Storage.Clear();
+              ezMemoryStreamWriter copyWriter(&compressed.m_Storage);
+              compressed.m_Result = storage.CopyToStream(copyWriter);
+              compressed.m_Entry = entry;
+            }
+          }
+
+          compressed.m_Duration = swFile.GetRunningTotal();
+        }
+      },
+      "ArchiveBuilder.Compress");
+
+    sw.Checkpoint();
+
+    for (ezUInt32 i = uiBatchStart; i < uiBatchEnd; ++i)
+    {
+      const SourceEntry& e = m_Entries[i];
+      const ezArchiveBuilderFileInfo& info = fileInfos[i];
+
+      const ezUInt32 uiPathStringOffset = toc.AddPathString(e.m_sRelTargetPath);
+
+      sHashablePath = e.m_sRelTargetPath;
+      sHashablePath.ToLower();
+
+      toc.m_PathToEntryIndex[ezArchiveStoredString(ezHashingUtils::StringHash(sHashablePath), uiPathStringOffset)] = toc.m_Entries.GetCount();
+
+      if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
+        return EZ_FAILURE;
 
-    ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+      ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+      if (info.m_uiDuplicateOf != ezInvalidIndex)
+      {
+        // the original is always written before its duplicates
+        tocEntry = toc.m_Entries[info.m_uiDuplicateOf];
+        tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+
+        WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, 0, sw.Checkpoint());
+      }
+      else if (e.m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+      {
+        EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntry(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, ezArchiveCompressionMode::Uncompressed, 0, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+
+        WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
+      }
+      else
+      {
+        ezArchiveBuilderCompressedFile& compressed = compressedFiles[i - uiBatchStart];
+        EZ_SUCCEED_OR_RETURN(compressed.m_Result);
+
+        tocEntry = compressed.m_Entry;
+        tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+        tocEntry.m_uiDataStartOffset = uiStreamSize;
+
+        EZ_SUCCEED_OR_RETURN(compressed.m_Storage.CopyToStream(inout_stream));
+        uiStreamSize += tocEntry.m_uiStoredDataSize;
+
+        if (!WriteFileProgressCallback(tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiUncompressedDataSize))
+          return EZ_FAILURE;
+
+        compressed.m_Storage.Clear();
+        compressed.m_Storage.Compact();
+
+        WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, compressed.m_Duration);
+        sw.Checkpoint();
+      }
+    }
 
-    WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
+    uiBatchStart = uiBatchEnd;
   }
 
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::AppendTOC(inout_stream, toc));
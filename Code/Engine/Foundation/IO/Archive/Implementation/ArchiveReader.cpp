@@ -71,12 +71,19 @@ ezResult ezArchiveReader::OpenArchive(ezStringView sPath)
         return EZ_FAILURE;
       }
 
-      if (e.m_uiUncompressedDataSize < e.m_uiStoredDataSize)
+      // chunked entries also store their chunk table, which is validated when they are opened
+      if (e.m_uiUncompressedDataSize < e.m_uiStoredDataSize && e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_chunked && e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_dictionary)
       {
         ezLog::Error("Archive is corrupt. Invalid compression info.");
         return EZ_FAILURE;
       }
 
+      ezConstByteArrayPtr compressedData, dictionary;
+      if (e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dictionary && ezArchiveUtils::GetDictionaryEntryData(e, m_pDataStart, compressedData, dictionary).Failed())
+      {
+        return EZ_FAILURE;
+      }
+
       if (e.m_uiPathStringOffset >= uiMaxPathString)
       {
         ezLog::Error("Archive is corrupt. Invalid entry path-string offset.");
@@ -126,12 +133,34 @@ ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryI
   return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
 }
 
+ezConstByteArrayPtr ezArchiveReader::GetUncompressedEntryData(ezUInt32 uiEntryIdx) const
+{
+  return ezArchiveUtils::GetUncompressedEntryData(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
+}
+
+ezUInt64 ezArchiveReader::ReadEntryData(ezUInt32 uiEntryIdx, ezUInt64 uiOffset, ezByteArrayPtr destination) const
+{
+  return ezArchiveUtils::ReadEntryData(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, uiOffset, destination);
+}
+
+ezResult ezArchiveReader::GetChunkedEntry(ezUInt32 uiEntryIdx, ezArchiveUtils::ChunkedEntry& out_chunkedEntry) const
+{
+  return ezArchiveUtils::GetChunkedEntry(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, out_chunkedEntry);
+}
+
+ezResult ezArchiveReader::GetDictionaryEntryData(ezUInt32 uiEntryIdx, ezConstByteArrayPtr& out_compressedData, ezConstByteArrayPtr& out_dictionary) const
+{
+  return ezArchiveUtils::GetDictionaryEntryData(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, out_compressedData, out_dictionary);
+}
+
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, ezStringView sTargetFolder) const
 {
   ezStringView sFilePath = m_ArchiveTOC.GetEntryPathString(uiEntryIdx);
   const ezUInt64 uiMaxSize = m_ArchiveTOC.m_Entries[uiEntryIdx].m_uiUncompressedDataSize;
 
   ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(uiEntryIdx);
+  if (pReader == nullptr)
+    return EZ_FAILURE;
 
   ezStringBuilder sOutputFile = sTargetFolder;
   sOutputFile.AppendPath(sFilePath);
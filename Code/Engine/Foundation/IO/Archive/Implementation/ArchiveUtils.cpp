@@ -9,6 +9,12 @@
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Types/ScopeExit.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+#  include <zstd/zstd.h>
+#endif
 
 ezHybridArray<ezString, 4, ezStaticsAllocatorWrapper>& ezArchiveUtils::GetAcceptedArchiveFileExtensions()
 {
@@ -40,11 +46,13 @@ ezResult ezArchiveUtils::WriteHeader(ezStreamWriter& inout_stream)
   const char* szTag = "EZARCHIVE";
   EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(szTag, 10));
 
-  const ezUInt8 uiArchiveVersion = 4;
+  const ezUInt8 uiArchiveVersion = 6;
 
   // Version 2: Added end-of-file marker for file corruption (cutoff) detection
   // Version 3: HashedStrings changed from MurmurHash to xxHash
   // Version 4: use 64 Bit string hashes
+  // Version 5: added ezArchiveCompressionMode::Compressed_zstd_chunked
+  // Version 6: added ezArchiveCompressionMode::Compressed_zstd_dictionary
   inout_stream << uiArchiveVersion;
 
   const ezUInt8 uiPadding[5] = {0, 0, 0, 0, 0};
@@ -67,7 +75,7 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& inout_stream, ezUInt8& out_u
   out_uiVersion = 0;
   inout_stream >> out_uiVersion;
 
-  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3 && out_uiVersion != 4)
+  if (out_uiVersion < 1 || out_uiVersion > 6)
   {
     ezLog::Error("Unsupported archive version '{}'.", out_uiVersion);
     return EZ_FAILURE;
@@ -106,6 +114,71 @@ ezResult ezArchiveUtils::WriteEntryPreprocessed(ezStreamWriter& inout_stream, ez
   return EZ_SUCCESS;
 }
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+static ezResult WriteChunkedEntry(ezStreamWriter& inout_stream, ezFileReader& inout_file, ezUInt64 uiMaxBytes, ezInt32 iCompressionLevel, ezArchiveEntry& inout_tocEntry, ezArchiveUtils::FileWriteProgressCallback progress)
+{
+  ZSTD_CCtx* pContext = ZSTD_createCCtx();
+  EZ_SCOPE_EXIT(ZSTD_freeCCtx(pContext));
+
+  ZSTD_CCtx_setParameter(pContext, ZSTD_c_compressionLevel, iCompressionLevel);
+
+  ezDynamicArray<ezUInt8> uncompressed;
+  uncompressed.SetCountUninitialized(ezArchiveUtils::ChunkedEntryChunkSize);
+
+  ezDynamicArray<ezUInt8> compressed;
+  compressed.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(ezArchiveUtils::ChunkedEntryChunkSize)));
+
+  ezDynamicArray<ezUInt64> chunkTable;
+  ezUInt64 uiChunkDataSize = 0;
+
+  while (true)
+  {
+    const ezUInt64 uiRead = inout_file.ReadBytes(uncompressed.GetData(), uncompressed.GetCount());
+
+    if (uiRead == 0)
+      break;
+
+    // every chunk is a separate zstd frame, so that it can be decompressed without the ones before it
+    const size_t uiCompressedSize = ZSTD_compress2(pContext, compressed.GetData(), compressed.GetCount(), uncompressed.GetData(), static_cast<size_t>(uiRead));
+
+    if (ZSTD_isError(uiCompressedSize))
+    {
+      ezLog::Error("Compressing archive chunk failed: '{}'", ZSTD_getErrorName(uiCompressedSize));
+      return EZ_FAILURE;
+    }
+
+    EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(compressed.GetData(), uiCompressedSize));
+
+    chunkTable.PushBack(uiChunkDataSize);
+    uiChunkDataSize += uiCompressedSize;
+    inout_tocEntry.m_uiUncompressedDataSize += uiRead;
+
+    if (progress.IsValid())
+    {
+      if (!progress(inout_tocEntry.m_uiUncompressedDataSize, uiMaxBytes))
+        return EZ_FAILURE;
+    }
+  }
+
+  chunkTable.PushBack(uiChunkDataSize);
+
+  for (ezUInt64 uiChunkOffset : chunkTable)
+  {
+    inout_stream << uiChunkOffset;
+  }
+
+  inout_stream << ezArchiveUtils::ChunkedEntryChunkSize;
+  inout_stream << (chunkTable.GetCount() - 1);
+
+  inout_tocEntry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd_chunked;
+  inout_tocEntry.m_uiStoredDataSize = uiChunkDataSize + chunkTable.GetCount() * sizeof(ezUInt64) + 2 * sizeof(ezUInt32);
+
+  return EZ_SUCCESS;
+}
+
+#endif
+
 ezResult ezArchiveUtils::WriteEntry(
   ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression,
   ezInt32 iCompressionLevel, ezArchiveEntry& inout_tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
@@ -136,6 +209,22 @@ ezResult ezArchiveUtils::WriteEntry(
   inout_tocEntry.m_uiDataStartOffset = inout_uiCurrentStreamPosition;
   inout_tocEntry.m_uiUncompressedDataSize = 0;
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (compression == ezArchiveCompressionMode::Compressed_zstd && uiMaxBytes >= ChunkedEntryMinSize)
+  {
+    // large files are split into chunks, so that they can be read partially
+    compression = ezArchiveCompressionMode::Compressed_zstd_chunked;
+  }
+
+  if (compression == ezArchiveCompressionMode::Compressed_zstd_chunked)
+  {
+    EZ_SUCCEED_OR_RETURN(WriteChunkedEntry(inout_stream, file, uiMaxBytes, iCompressionLevel, inout_tocEntry, progress));
+
+    inout_uiCurrentStreamPosition += inout_tocEntry.m_uiStoredDataSize;
+    return EZ_SUCCESS;
+  }
+#endif
+
   ezStreamWriter* pWriter = &inout_stream;
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -203,6 +292,69 @@ ezResult ezArchiveUtils::WriteEntry(
   return EZ_SUCCESS;
 }
 
+ezResult ezArchiveUtils::WriteEntryWithDictionary(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset, ezInt32 iCompressionLevel, ezConstByteArrayPtr dictionary, ezUInt64 uiDictionaryOffset, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition)
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ezFileReader file;
+  EZ_SUCCEED_OR_RETURN(file.Open(sAbsSourcePath));
+
+  ezDynamicArray<ezUInt8> uncompressed;
+  uncompressed.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+  uncompressed.SetCountUninitialized(static_cast<ezUInt32>(file.ReadBytes(uncompressed.GetData(), uncompressed.GetCount())));
+
+  ezDynamicArray<ezUInt8> compressed;
+  compressed.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(uncompressed.GetCount())));
+
+  ZSTD_CCtx* pContext = ZSTD_createCCtx();
+  EZ_SCOPE_EXIT(ZSTD_freeCCtx(pContext));
+
+  ZSTD_CCtx_setParameter(pContext, ZSTD_c_compressionLevel, iCompressionLevel);
+  ZSTD_CCtx_refPrefix(pContext, dictionary.GetPtr(), dictionary.GetCount());
+
+  const size_t uiCompressedSize = ZSTD_compress2(pContext, compressed.GetData(), compressed.GetCount(), uncompressed.GetData(), uncompressed.GetCount());
+
+  if (ZSTD_isError(uiCompressedSize))
+  {
+    ezLog::Error("Compressing '{}' failed: '{}'", sAbsSourcePath, ZSTD_getErrorName(uiCompressedSize));
+    return EZ_FAILURE;
+  }
+
+  inout_stream << uiDictionaryOffset;
+  inout_stream << dictionary.GetCount();
+
+  ezUInt64 uiStoredSize = DictionaryEntryHeaderSize;
+
+  // use the same block layout as ezCompressedStreamWriterZstd, so that the data can be read with ezCompressedStreamReaderZstd
+  for (ezUInt32 uiBlockStart = 0; uiBlockStart < uiCompressedSize;)
+  {
+    const ezUInt16 uiBlockSize = static_cast<ezUInt16>(ezMath::Min<size_t>(uiCompressedSize - uiBlockStart, 63 * 1024));
+
+    inout_stream << uiBlockSize;
+    EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(compressed.GetData() + uiBlockStart, uiBlockSize));
+
+    uiBlockStart += uiBlockSize;
+    uiStoredSize += sizeof(ezUInt16) + uiBlockSize;
+  }
+
+  // zero terminator
+  inout_stream << static_cast<ezUInt16>(0);
+  uiStoredSize += sizeof(ezUInt16);
+
+  ref_tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+  ref_tocEntry.m_uiDataStartOffset = inout_uiCurrentStreamPosition;
+  ref_tocEntry.m_uiUncompressedDataSize = uncompressed.GetCount();
+  ref_tocEntry.m_uiStoredDataSize = uiStoredSize;
+  ref_tocEntry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd_dictionary;
+
+  inout_uiCurrentStreamPosition += ref_tocEntry.m_uiStoredDataSize;
+
+  return EZ_SUCCESS;
+#else
+  ezLog::Error("Compressing archive entries with a dictionary requires zstd support.");
+  return EZ_FAILURE;
+#endif
+}
+
 ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression, ezInt32 iCompressionLevel, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
 {
   if (compression == ezArchiveCompressionMode::Uncompressed)
@@ -276,6 +428,32 @@ ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEnt
       break;
     }
 #endif
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    case ezArchiveCompressionMode::Compressed_zstd_dictionary:
+    {
+      ezConstByteArrayPtr compressedData;
+      ezConstByteArrayPtr dictionary;
+      if (GetDictionaryEntryData(entry, pStartOfArchiveData, compressedData, dictionary).Failed())
+        break;
+
+      reader = EZ_DEFAULT_NEW(ezCompressedStreamReaderZstdWithSource);
+      ezCompressedStreamReaderZstdWithSource* pRawReader = static_cast<ezCompressedStreamReaderZstdWithSource*>(reader.Borrow());
+      pRawReader->m_Source.Reset(compressedData.GetPtr(), compressedData.GetCount());
+      pRawReader->SetInputStream(&pRawReader->m_Source, dictionary);
+      break;
+    }
+
+    case ezArchiveCompressionMode::Compressed_zstd_chunked:
+    {
+      ChunkedEntry chunkedEntry;
+      if (GetChunkedEntry(entry, pStartOfArchiveData, chunkedEntry).Failed())
+        break;
+
+      reader = EZ_DEFAULT_NEW(ezArchiveChunkedEntryReader);
+      static_cast<ezArchiveChunkedEntryReader*>(reader.Borrow())->SetChunkedEntry(chunkedEntry);
+      break;
+    }
+#endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
     case ezArchiveCompressionMode::Compressed_zip:
     {
@@ -300,6 +478,266 @@ void ezArchiveUtils::ConfigureRawMemoryStreamReader(const ezArchiveEntry& entry,
   ref_memReader.Reset(ezMemoryUtils::AddByteOffset(pStartOfArchiveData, static_cast<std::ptrdiff_t>(entry.m_uiDataStartOffset)), entry.m_uiStoredDataSize);
 }
 
+ezResult ezArchiveUtils::GetDictionaryEntryData(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ezConstByteArrayPtr& out_compressedData, ezConstByteArrayPtr& out_dictionary)
+{
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_dictionary)
+    return EZ_FAILURE;
+
+  if (entry.m_uiStoredDataSize < DictionaryEntryHeaderSize)
+  {
+    ezLog::Error("Archive is corrupt. Entry is too small for a dictionary header.");
+    return EZ_FAILURE;
+  }
+
+  const ezUInt8* pData = static_cast<const ezUInt8*>(pStartOfArchiveData) + entry.m_uiDataStartOffset;
+
+  ezUInt64 uiDictionaryOffset = 0;
+  ezUInt32 uiDictionarySize = 0;
+  {
+    ezRawMemoryStreamReader headerReader(pData, DictionaryEntryHeaderSize);
+    headerReader >> uiDictionaryOffset;
+    headerReader >> uiDictionarySize;
+  }
+
+  // dictionaries are always stored in front of the entries that use them, which also guarantees that they are inside the archive
+  if (uiDictionaryOffset + uiDictionarySize > entry.m_uiDataStartOffset || uiDictionaryOffset + uiDictionarySize < uiDictionaryOffset)
+  {
+    ezLog::Error("Archive is corrupt. Invalid dictionary range.");
+    return EZ_FAILURE;
+  }
+
+  out_compressedData = ezConstByteArrayPtr(pData + DictionaryEntryHeaderSize, static_cast<ezUInt32>(entry.m_uiStoredDataSize - DictionaryEntryHeaderSize));
+  out_dictionary = ezConstByteArrayPtr(static_cast<const ezUInt8*>(pStartOfArchiveData) + uiDictionaryOffset, uiDictionarySize);
+
+  return EZ_SUCCESS;
+}
+
+ezConstByteArrayPtr ezArchiveUtils::GetUncompressedEntryData(const ezArchiveEntry& entry, const void* pStartOfArchiveData)
+{
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Uncompressed)
+    return {};
+
+  const ezUInt8* pData = static_cast<const ezUInt8*>(pStartOfArchiveData) + entry.m_uiDataStartOffset;
+  return ezConstByteArrayPtr(pData, static_cast<ezUInt32>(entry.m_uiStoredDataSize));
+}
+
+ezUInt64 ezArchiveUtils::ReadEntryData(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ezUInt64 uiOffset, ezByteArrayPtr destination)
+{
+  if (uiOffset >= entry.m_uiUncompressedDataSize)
+    return 0;
+
+  const ezUInt64 uiBytesToRead = ezMath::Min<ezUInt64>(destination.GetCount(), entry.m_uiUncompressedDataSize - uiOffset);
+
+  switch (entry.m_CompressionMode)
+  {
+    case ezArchiveCompressionMode::Uncompressed:
+    {
+      const ezUInt8* pData = static_cast<const ezUInt8*>(pStartOfArchiveData) + entry.m_uiDataStartOffset + uiOffset;
+      ezMemoryUtils::Copy(destination.GetPtr(), pData, static_cast<size_t>(uiBytesToRead));
+      return uiBytesToRead;
+    }
+
+    case ezArchiveCompressionMode::Compressed_zstd_chunked:
+    {
+      ChunkedEntry chunkedEntry;
+      if (GetChunkedEntry(entry, pStartOfArchiveData, chunkedEntry).Failed())
+        return 0;
+
+      ezArchiveChunkedEntryReader reader;
+      reader.SetChunkedEntry(chunkedEntry);
+      reader.SetReadPosition(uiOffset);
+      return reader.ReadBytes(destination.GetPtr(), uiBytesToRead);
+    }
+
+    default:
+    {
+      ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(entry, pStartOfArchiveData);
+      if (pReader == nullptr || pReader->SkipBytes(uiOffset) != uiOffset)
+        return 0;
+
+      return pReader->ReadBytes(destination.GetPtr(), uiBytesToRead);
+    }
+  }
+}
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+namespace
+{
+  /// Decompression contexts are expensive to create, so every thread keeps one around.
+  struct ezArchiveZstdDecompressionContext
+  {
+    ~ezArchiveZstdDecompressionContext()
+    {
+      if (m_pContext != nullptr)
+      {
+        ZSTD_freeDCtx(m_pContext);
+      }
+    }
+
+    ZSTD_DCtx* Get()
+    {
+      if (m_pContext == nullptr)
+      {
+        m_pContext = ZSTD_createDCtx();
+      }
+
+      return m_pContext;
+    }
+
+    ZSTD_DCtx* m_pContext = nullptr;
+  };
+
+  thread_local ezArchiveZstdDecompressionContext tl_ArchiveZstdDecompressionContext;
+} // namespace
+
+#endif
+
+static ezUInt64 ReadChunkTableValue(const ezUInt8* pTable, ezUInt32 uiIndex)
+{
+  // the table has no alignment guarantees
+  ezUInt64 uiValue = 0;
+  ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiValue), pTable + uiIndex * sizeof(ezUInt64), sizeof(ezUInt64));
+  return uiValue;
+}
+
+ezConstByteArrayPtr ezArchiveUtils::ChunkedEntry::GetCompressedChunk(ezUInt32 uiChunk) const
+{
+  EZ_ASSERT_DEBUG(uiChunk < m_uiNumChunks, "Invalid chunk index {} (num chunks: {})", uiChunk, m_uiNumChunks);
+
+  const ezUInt64 uiStart = ReadChunkTableValue(m_pChunkTable, uiChunk);
+  const ezUInt64 uiEnd = ReadChunkTableValue(m_pChunkTable, uiChunk + 1);
+
+  return ezConstByteArrayPtr(m_pChunkData + uiStart, static_cast<ezUInt32>(uiEnd - uiStart));
+}
+
+ezUInt32 ezArchiveUtils::ChunkedEntry::GetUncompressedChunkSize(ezUInt32 uiChunk) const
+{
+  EZ_ASSERT_DEBUG(uiChunk < m_uiNumChunks, "Invalid chunk index {} (num chunks: {})", uiChunk, m_uiNumChunks);
+
+  const ezUInt64 uiChunkStart = static_cast<ezUInt64>(uiChunk) * m_uiChunkSize;
+  return static_cast<ezUInt32>(ezMath::Min<ezUInt64>(m_uiChunkSize, m_uiUncompressedDataSize - uiChunkStart));
+}
+
+ezResult ezArchiveUtils::ChunkedEntry::DecompressChunk(ezUInt32 uiChunk, void* pDestination) const
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  const ezConstByteArrayPtr compressed = GetCompressedChunk(uiChunk);
+  const ezUInt32 uiUncompressedSize = GetUncompressedChunkSize(uiChunk);
+
+  const size_t uiResult = ZSTD_decompressDCtx(tl_ArchiveZstdDecompressionContext.Get(), pDestination, uiUncompressedSize, compressed.GetPtr(), compressed.GetCount());
+
+  if (ZSTD_isError(uiResult))
+  {
+    ezLog::Error("Decompressing archive chunk {} failed: '{}'", uiChunk, ZSTD_getErrorName(uiResult));
+    return EZ_FAILURE;
+  }
+
+  if (uiResult != uiUncompressedSize)
+  {
+    ezLog::Error("Archive chunk {} is corrupted. Expected {} bytes, got {}.", uiChunk, uiUncompressedSize, uiResult);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+#else
+  ezLog::Error("Chunked archive entries require zstd support.");
+  return EZ_FAILURE;
+#endif
+}
+
+ezResult ezArchiveUtils::ChunkedEntry::DecompressChunks(ezUInt32 uiFirstChunk, ezUInt32 uiNumChunks, void* pDestination) const
+{
+  if (uiNumChunks == 1)
+  {
+    return DecompressChunk(uiFirstChunk, pDestination);
+  }
+
+  ezAtomicBool bFailed;
+
+  // iterate over indices relative to uiFirstChunk, split up invocations of ParallelForIndexed ignore a non-zero start index
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumChunks, [this, uiFirstChunk, pDestination, &bFailed](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 uiIndex = uiStartIndex; uiIndex < uiEndIndex; ++uiIndex)
+      {
+        void* pChunkDestination = ezMemoryUtils::AddByteOffset(pDestination, static_cast<std::ptrdiff_t>(uiIndex) * m_uiChunkSize);
+
+        if (DecompressChunk(uiFirstChunk + uiIndex, pChunkDestination).Failed())
+        {
+          bFailed.Set(true);
+        }
+      }
+    },
+    "DecompressArchiveChunks");
+
+  return bFailed ? EZ_FAILURE : EZ_SUCCESS;
+}
+
+ezResult ezArchiveUtils::GetChunkedEntry(const ezArchiveEntry& entry, const void* pStartOfArchiveData, ChunkedEntry& out_chunkedEntry)
+{
+  constexpr ezUInt32 uiFooterSize = 2 * sizeof(ezUInt32);
+
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_chunked)
+    return EZ_FAILURE;
+
+  if (entry.m_uiStoredDataSize < uiFooterSize + sizeof(ezUInt64))
+  {
+    ezLog::Error("Archive is corrupt. Chunked entry is too small.");
+    return EZ_FAILURE;
+  }
+
+  const ezUInt8* pData = static_cast<const ezUInt8*>(pStartOfArchiveData) + entry.m_uiDataStartOffset;
+
+  ezUInt32 uiChunkSize = 0;
+  ezUInt32 uiNumChunks = 0;
+  {
+    ezRawMemoryStreamReader footerReader(pData + entry.m_uiStoredDataSize - uiFooterSize, uiFooterSize);
+    footerReader >> uiChunkSize;
+    footerReader >> uiNumChunks;
+  }
+
+  const ezUInt64 uiTableSize = (static_cast<ezUInt64>(uiNumChunks) + 1) * sizeof(ezUInt64);
+
+  if (uiChunkSize == 0 || uiTableSize + uiFooterSize > entry.m_uiStoredDataSize)
+  {
+    ezLog::Error("Archive is corrupt. Invalid chunk table.");
+    return EZ_FAILURE;
+  }
+
+  if ((entry.m_uiUncompressedDataSize + uiChunkSize - 1) / uiChunkSize != uiNumChunks)
+  {
+    ezLog::Error("Archive is corrupt. Chunk count does not match the entry size.");
+    return EZ_FAILURE;
+  }
+
+  const ezUInt64 uiChunkDataSize = entry.m_uiStoredDataSize - uiFooterSize - uiTableSize;
+  const ezUInt8* pTable = pData + uiChunkDataSize;
+
+  // make sure no chunk points outside of the entry
+  ezUInt64 uiPrevOffset = 0;
+  for (ezUInt32 i = 0; i <= uiNumChunks; ++i)
+  {
+    const ezUInt64 uiOffset = ReadChunkTableValue(pTable, i);
+
+    if (uiOffset < uiPrevOffset || uiOffset > uiChunkDataSize || (i == 0 && uiOffset != 0) || (i == uiNumChunks && uiOffset != uiChunkDataSize))
+    {
+      ezLog::Error("Archive is corrupt. Invalid chunk offsets.");
+      return EZ_FAILURE;
+    }
+
+    uiPrevOffset = uiOffset;
+  }
+
+  out_chunkedEntry.m_uiUncompressedDataSize = entry.m_uiUncompressedDataSize;
+  out_chunkedEntry.m_uiChunkSize = uiChunkSize;
+  out_chunkedEntry.m_uiNumChunks = uiNumChunks;
+  out_chunkedEntry.m_pChunkData = pData;
+  out_chunkedEntry.m_pChunkTable = pTable;
+
+  return EZ_SUCCESS;
+}
+
 static const char* szEndMarker = "EZARCHIVE-END";
 
 static ezUInt32 GetEndMarkerSize(ezUInt8 uiFileVersion)
@@ -662,3 +1100,80 @@ ezResult ezArchiveUtils::ExtractZipTOC(const ezMemoryMappedFile& memFile, ezArch
 
   return EZ_SUCCESS;
 }
+
+//////////////////////////////////////////////////////////////////////////
+
+ezArchiveChunkedEntryReader::ezArchiveChunkedEntryReader() = default;
+ezArchiveChunkedEntryReader::~ezArchiveChunkedEntryReader() = default;
+
+void ezArchiveChunkedEntryReader::SetChunkedEntry(const ezArchiveUtils::ChunkedEntry& entry)
+{
+  m_Entry = entry;
+  m_uiReadPosition = 0;
+  m_uiCachedChunk = ezInvalidIndex;
+}
+
+void ezArchiveChunkedEntryReader::SetReadPosition(ezUInt64 uiReadPosition)
+{
+  m_uiReadPosition = ezMath::Min(uiReadPosition, m_Entry.m_uiUncompressedDataSize);
+}
+
+ezUInt64 ezArchiveChunkedEntryReader::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  const ezUInt64 uiPrevPosition = m_uiReadPosition;
+  SetReadPosition(m_uiReadPosition + ezMath::Min(uiBytesToSkip, m_Entry.m_uiUncompressedDataSize - m_uiReadPosition));
+  return m_uiReadPosition - uiPrevPosition;
+}
+
+ezUInt64 ezArchiveChunkedEntryReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  const ezUInt64 uiChunkSize = m_Entry.m_uiChunkSize;
+  const ezUInt64 uiEndPosition = m_uiReadPosition + ezMath::Min(uiBytesToRead, m_Entry.m_uiUncompressedDataSize - m_uiReadPosition);
+
+  ezUInt8* pTarget = static_cast<ezUInt8*>(pReadBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  while (m_uiReadPosition < uiEndPosition)
+  {
+    const ezUInt32 uiChunk = static_cast<ezUInt32>(m_uiReadPosition / uiChunkSize);
+    const ezUInt64 uiOffsetInChunk = m_uiReadPosition - uiChunk * uiChunkSize;
+
+    if (uiOffsetInChunk == 0)
+    {
+      // chunks that are read entirely are decompressed straight into the target buffer
+      const ezUInt32 uiEndChunk = uiEndPosition == m_Entry.m_uiUncompressedDataSize ? m_Entry.m_uiNumChunks : static_cast<ezUInt32>(uiEndPosition / uiChunkSize);
+
+      if (uiEndChunk > uiChunk)
+      {
+        if (m_Entry.DecompressChunks(uiChunk, uiEndChunk - uiChunk, pTarget + uiBytesRead).Failed())
+          break;
+
+        const ezUInt64 uiNewPosition = ezMath::Min(uiEndChunk * uiChunkSize, m_Entry.m_uiUncompressedDataSize);
+        uiBytesRead += uiNewPosition - m_uiReadPosition;
+        m_uiReadPosition = uiNewPosition;
+        continue;
+      }
+    }
+
+    if (m_uiCachedChunk != uiChunk)
+    {
+      m_ChunkCache.SetCountUninitialized(m_Entry.m_uiChunkSize);
+
+      if (m_Entry.DecompressChunk(uiChunk, m_ChunkCache.GetData()).Failed())
+      {
+        m_uiCachedChunk = ezInvalidIndex;
+        break;
+      }
+
+      m_uiCachedChunk = uiChunk;
+    }
+
+    const ezUInt64 uiBytesFromChunk = ezMath::Min<ezUInt64>(m_Entry.GetUncompressedChunkSize(uiChunk) - uiOffsetInChunk, uiEndPosition - m_uiReadPosition);
+    ezMemoryUtils::Copy(pTarget + uiBytesRead, m_ChunkCache.GetData() + uiOffsetInChunk, static_cast<size_t>(uiBytesFromChunk));
+
+    uiBytesRead += uiBytesFromChunk;
+    m_uiReadPosition += uiBytesFromChunk;
+  }
+
+  return uiBytesRead;
+}
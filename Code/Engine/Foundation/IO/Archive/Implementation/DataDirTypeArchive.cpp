@@ -74,6 +74,7 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
       case ezArchiveCompressionMode::Compressed_zstd:
+      case ezArchiveCompressionMode::Compressed_zstd_dictionary:
       {
         if (!m_FreeReadersZstd.IsEmpty())
         {
@@ -87,6 +88,31 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
         }
         break;
       }
+
+      case ezArchiveCompressionMode::Compressed_zstd_chunked:
+      {
+        ArchiveReaderZstdChunked* pChunkedReader = nullptr;
+
+        if (!m_FreeReadersZstdChunked.IsEmpty())
+        {
+          pChunkedReader = m_FreeReadersZstdChunked.PeekBack();
+          m_FreeReadersZstdChunked.PopBack();
+        }
+        else
+        {
+          m_ReadersZstdChunked.PushBack(EZ_DEFAULT_NEW(ArchiveReaderZstdChunked, 3));
+          pChunkedReader = m_ReadersZstdChunked.PeekBack().Borrow();
+        }
+
+        if (m_ArchiveReader.GetChunkedEntry(uiEntryIndex, pChunkedReader->m_ChunkedEntry).Failed())
+        {
+          m_FreeReadersZstdChunked.PushBack(pChunkedReader);
+          return nullptr;
+        }
+
+        pReader = pChunkedReader;
+        break;
+      }
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
       case ezArchiveCompressionMode::Compressed_zip:
@@ -115,6 +141,19 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
+  pReader->m_UncompressedData = m_ArchiveReader.GetUncompressedEntryData(uiEntryIndex);
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (pEntry->m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dictionary)
+  {
+    ArchiveReaderZstd* pZstdReader = static_cast<ArchiveReaderZstd*>(pReader);
+
+    // the entries were validated when the archive was opened
+    ezConstByteArrayPtr compressedData;
+    m_ArchiveReader.GetDictionaryEntryData(uiEntryIndex, compressedData, pZstdReader->m_Dictionary).AssertSuccess();
+    pZstdReader->m_MemStreamReader.Reset(compressedData.GetPtr(), compressedData.GetCount());
+  }
+#endif
 
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
@@ -245,6 +284,12 @@ void ezDataDirectory::ArchiveType::OnReaderWriterClose(ezDataDirectoryReaderWrit
     m_FreeReadersZstd.PushBack(static_cast<ArchiveReaderZstd*>(pClosed));
     return;
   }
+
+  if (pClosed->GetDataDirUserData() == 3)
+  {
+    m_FreeReadersZstdChunked.PushBack(static_cast<ArchiveReaderZstdChunked*>(pClosed));
+    return;
+  }
 #endif
 
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
@@ -270,6 +315,11 @@ ezUInt64 ezDataDirectory::ArchiveReaderCommon::GetFileSize() const
   return m_uiUncompressedSize;
 }
 
+ezConstByteArrayPtr ezDataDirectory::ArchiveReaderCommon::GetFileMemoryView() const
+{
+  return m_UncompressedData;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 ezDataDirectory::ArchiveReaderUncompressed::ArchiveReaderUncompressed(ezInt32 iDataDirUserData)
@@ -318,11 +368,41 @@ ezResult ezDataDirectory::ArchiveReaderZstd::InternalOpen(ezFileShareMode::Enum
 {
   EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
 
-  m_CompressedStreamReader.SetInputStream(&m_MemStreamReader);
+  m_CompressedStreamReader.SetInputStream(&m_MemStreamReader, m_Dictionary);
   return EZ_SUCCESS;
 }
 
 void ezDataDirectory::ArchiveReaderZstd::InternalClose()
+{
+  m_Dictionary = ezConstByteArrayPtr();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezDataDirectory::ArchiveReaderZstdChunked::ArchiveReaderZstdChunked(ezInt32 iDataDirUserData)
+  : ArchiveReaderCommon(iDataDirUserData)
+{
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdChunked::Skip(ezUInt64 uiBytes)
+{
+  return m_ChunkedReader.SkipBytes(uiBytes);
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdChunked::Read(void* pBuffer, ezUInt64 uiBytes)
+{
+  return m_ChunkedReader.ReadBytes(pBuffer, uiBytes);
+}
+
+ezResult ezDataDirectory::ArchiveReaderZstdChunked::InternalOpen(ezFileShareMode::Enum FileShareMode)
+{
+  EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
+
+  m_ChunkedReader.SetChunkedEntry(m_ChunkedEntry);
+  return EZ_SUCCESS;
+}
+
+void ezDataDirectory::ArchiveReaderZstdChunked::InternalClose()
 {
   // nothing to do
 }
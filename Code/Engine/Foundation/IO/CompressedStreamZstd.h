@@ -24,7 +24,10 @@ public:
   ///
   /// Calling this a second time on the same instance is valid and allows to reuse the decoder, which is more efficient than creating a new
   /// one.
-  void SetInputStream(ezStreamReader* pInputStream); // [tested]
+  ///
+  /// If the data was compressed with a raw content dictionary (see ezArchiveCompressionMode::Compressed_zstd_dictionary), the same
+  /// dictionary has to be passed in. It is only referenced, so it has to stay valid until the stream has been read.
+  void SetInputStream(ezStreamReader* pInputStream, ezConstByteArrayPtr rawDictionary = ezConstByteArrayPtr()); // [tested]
 
   /// \brief Reads either uiBytesToRead or the amount of remaining bytes in the stream into pReadBuffer.
   ///
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Strings/String.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Types/Delegate.h>
+#include <Foundation/Types/SharedPtr.h>
+
+class ezAsyncFileRead;
+
+/// \brief Describes a single read that is issued through ezFileSystem::ReadAsync() or ezFileSystem::ReadAsyncBatch().
+struct ezAsyncFileReadRequest
+{
+  /// \brief The file to read from. This can be a relative, an absolute or a rooted path, just as for ezFileReader.
+  ezString m_sFile;
+
+  /// \brief The position in the file at which to start reading.
+  ezUInt64 m_uiOffset = 0;
+
+  /// \brief How many bytes to read. The default reads everything from m_uiOffset up to the end of the file.
+  ezUInt64 m_uiNumBytes = ezMath::MaxValue<ezUInt64>();
+
+  /// \brief If set, the data is read into this memory instead of an internal buffer.
+  ///
+  /// The memory must be large enough for m_uiNumBytes and stay valid until the read has finished.
+  /// m_uiNumBytes must be set explicitly in this case.
+  void* m_pDestination = nullptr;
+
+  /// \brief Called once the read has finished, successfully or not.
+  ///
+  /// This is executed on whichever thread completed the read, so it should only do very little work,
+  /// for example kick off a task that processes the data.
+  ezDelegate<void(ezAsyncFileRead&)> m_OnCompletion;
+};
+
+/// \brief Represents a read that was started through ezFileSystem::ReadAsync().
+///
+/// Works like a future: The object can be polled with IsFinished() or waited on with WaitForCompletion().
+/// Afterwards GetResult() and GetData() return the outcome of the read.
+/// The read keeps itself alive until it is finished, so it is fine to drop all references to it, if only the
+/// completion callback is of interest.
+class EZ_FOUNDATION_DLL ezAsyncFileRead : public ezRefCounted
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezAsyncFileRead);
+
+public:
+  ezAsyncFileRead();
+  ~ezAsyncFileRead();
+
+  /// \brief Returns true once the read has finished and the completion callback has been executed.
+  bool IsFinished() const { return m_iState == State::Finished; }
+
+  /// \brief Blocks until the read has finished.
+  ///
+  /// If the read is executed by a task that hasn't started yet, the calling thread executes it directly,
+  /// so this doesn't deadlock when it is called from the file access thread.
+  void WaitForCompletion();
+
+  /// \brief Returns whether the file could be opened and the requested range could be read. Only valid after the read has finished.
+  ///
+  /// Reading beyond the end of the file is not an error, GetNumBytesRead() just returns fewer bytes than requested.
+  ezResult GetResult() const { return m_Result; }
+
+  /// \brief Returns how many bytes were read. Only valid after the read has finished.
+  ezUInt64 GetNumBytesRead() const { return m_uiNumBytesRead; }
+
+  /// \brief Returns the read data, either in the destination memory of the request or in the internal buffer. Only valid after the read has finished.
+  ezArrayPtr<const ezUInt8> GetData() const { return ezArrayPtr<const ezUInt8>(m_pTarget, static_cast<ezUInt32>(m_uiNumBytesRead)); }
+
+  /// \brief Returns the file path as given in the request.
+  const ezString& GetFile() const { return m_Request.m_sFile; }
+
+private:
+  friend class ezFileSystem;
+  friend class ezAsyncFileReadBackend;
+
+  struct State
+  {
+    enum Enum
+    {
+      Pending,
+      Reading,
+      Finished,
+    };
+  };
+
+  void ExecuteBlockingRead();
+
+  ezAsyncFileReadRequest m_Request;
+  ezString m_sOSFile;
+
+  ezAtomicInteger32 m_iState = State::Pending;
+  ezThreadSignal m_Finished;
+  ezSharedPtr<ezAsyncFileRead> m_pKeepAlive;
+
+  ezUInt8* m_pTarget = nullptr;
+  ezUInt64 m_uiNumBytesToRead = 0;
+  ezUInt64 m_uiNumBytesRead = 0;
+  ezDynamicArray<ezUInt8> m_Buffer;
+  ezResult m_Result = EZ_FAILURE;
+};
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/SharedPtr.h>
+
+class ezAsyncFileRead;
+struct ezAsyncFileReadRequest;
+class ezDirectoryWatcher;
 
 /// \brief The ezFileSystem provides high-level functionality to manage files in a virtual file system.
 ///
@@ -135,6 +141,44 @@ public:
   /// \brief Calls ezDataDirectoryType::ReloadExternalConfigs() on all active data directories.
   static void ReloadAllExternalDataDirectoryConfigs();
 
+  ///@}
+  /// \name Path Cache
+  ///
+  /// Looking up a file by a relative path probes every data directory, until one of them has the file. With many data directories, most of
+  /// these probes are misses, and each of them costs a file system access. The path cache remembers in which data directory a file was found
+  /// and also which files don't exist at all, so that repeated lookups through GetFileReader() (e.g. by ezFileReader) and ExistsFile() only
+  /// access the data directory that actually has the file.
+  ///
+  /// The cache is cleared when data directories are added or removed and when files are written or deleted through the file system.
+  /// Changes from other sources are picked up by directory watchers on all folder data directories (if the platform supports them),
+  /// which are polled at most every 100 milliseconds. Results that depend on data directories which can't be watched are not cached.
+  /// The exception is the data directory for absolute paths (mounted with an empty path), which is assumed not to change
+  /// when it is used to look up relative paths in the working directory.
+  /// Since the skipped data directories aren't probed, OpenFileAttempt events are only broadcast for the data directory that has the file.
+  /// Opening, ExistsFile() and ResolvePath() share the cache entries of a file, independent of how its path is spelled.
+  ///@{
+
+  struct PathCacheStats
+  {
+    ezUInt64 m_uiHits = 0;          ///< Lookups that were answered by the cached data directory.
+    ezUInt64 m_uiNegativeHits = 0;  ///< Lookups that were answered by the cached knowledge that no data directory has the file.
+    ezUInt64 m_uiMisses = 0;        ///< Lookups that had to probe all data directories.
+    ezUInt64 m_uiInvalidations = 0; ///< How often the entire cache was cleared.
+    ezUInt32 m_uiNumEntries = 0;    ///< The number of currently cached paths.
+  };
+
+  /// \brief Enables or disables the path cache. It is disabled by default.
+  static void SetPathCacheEnabled(bool bEnable);
+
+  /// \brief Returns whether the path cache is enabled.
+  static bool IsPathCacheEnabled();
+
+  /// \brief Removes all cached paths. Only necessary after external file changes that the directory watchers can't see.
+  static void ClearPathCache();
+
+  /// \brief Returns how effective the path cache has been so far.
+  static PathCacheStats GetPathCacheStats();
+
   ///@}
   /// \name Special Directories
   ///@{
@@ -247,6 +291,20 @@ public:
   /// \returns The function will return EZ_FAILURE if it was not able to determine any location where the file could be read from or written to.
   static ezResult ResolvePath(ezStringView sPath, ezStringBuilder* out_pAbsolutePath, ezStringBuilder* out_pDataDirRelativePath, ezDataDirectoryType** out_pDataDir = nullptr); // [tested]
 
+  /// \brief Starts reading (a part of) a file without blocking the calling thread. See ezAsyncFileRead for how to retrieve the result.
+  ///
+  /// The path is resolved on the calling thread. Files that are stored directly on disk are read through the native asynchronous file API
+  /// of the platform (io_uring on Linux), if it is available and the CVar 'FileSystem.NativeAsyncReads' is enabled.
+  /// All other reads, e.g. from archives, are executed by tasks on the file access thread.
+  /// If the path can't be resolved, the read is finished (as failed) before the function returns.
+  static ezSharedPtr<ezAsyncFileRead> ReadAsync(const ezAsyncFileReadRequest& request);
+
+  /// \brief Starts all the given reads and appends them to \a out_reads, in the same order.
+  ///
+  /// Prefer this over individual calls to ReadAsync() when many (small) files are needed at once,
+  /// since the native reads are handed to the OS in a single submission.
+  static void ReadAsyncBatch(ezArrayPtr<const ezAsyncFileReadRequest> requests, ezDynamicArray<ezSharedPtr<ezAsyncFileRead>>& out_reads);
+
   /// \brief Starts at szStartDirectory and goes up until it finds a folder that contains the given sub folder structure.
   ///
   /// Returns EZ_FAILURE if nothing is found. Otherwise \a result is the absolute path to the existing folder that has a given sub-folder.
@@ -317,6 +375,13 @@ private:
 
     ezEvent<const FileEvent&, ezMutex> m_Event;
     ezMutex m_FsMutex;
+
+    bool m_bPathCacheEnabled = false;
+    ezHashTable<ezString, ezInt32> m_PathCache; // index of the data directory that has the file, or -1 if none has it
+    ezHybridArray<bool, 16> m_PathCacheDataDirCacheable;
+    ezHybridArray<ezDirectoryWatcher*, 16> m_PathCacheWatchers;
+    ezTime m_LastPathCacheWatcherPoll;
+    PathCacheStats m_PathCacheStats;
   };
 
   /// \brief Extracts the root name in a rooted path, e.g. for ":bin/stuff" it would extract "bin". Returns the relative path (here "stuff") or an empty string if it is a root only.
@@ -329,6 +394,30 @@ private:
 
   static void CleanUpRootName(ezStringBuilder& sRoot);
 
+  /// \brief Probes the data directories for the given cleaned up path and opens the file in the first one that has it. Uses and updates the path cache entry sCacheKey.
+  static ezDataDirectoryReader* OpenFileReader(const ezString& sRootName, ezStringView sPath, ezStringView sCacheKey, bool bIsCached, ezInt32 iCachedDataDir, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents);
+
+  /// \brief Builds the path cache key for a path with the given root name. All lookups of the same file must use the same key.
+  static void MakePathCacheKey(ezStringView sRootName, ezStringView sPath, ezStringBuilder& out_sKey);
+
+  /// \brief Returns the data directory that was cached for the given lookup key (-1 if no data directory has the file). Returns false, if nothing is cached.
+  static bool LookupPathCache(ezStringView sKey, ezInt32& out_iDataDir);
+
+  /// \brief Caches the result of a lookup. Must only be called, if all probed data directories are cacheable.
+  static void StorePathCache(ezStringView sKey, ezInt32 iDataDir);
+
+  /// \brief Removes all cached paths, after the data directories or the files in them have changed.
+  static void InvalidatePathCache();
+
+  /// \brief Returns whether a lookup of sPath in the given data directory may be cached.
+  static bool IsPathCacheable(ezUInt32 uiDataDir, ezStringView sPath);
+
+  /// \brief Recreates the directory watchers for the current data directories.
+  static void UpdatePathCacheWatchers();
+
+  /// \brief Invalidates the path cache, if any directory watcher reports a change.
+  static void PollPathCacheWatchers();
+
   static ezString s_sSdkRootDir;
   static ezMap<ezString, ezString> s_SpecialDirectories;
   static FileSystemData* s_pData;
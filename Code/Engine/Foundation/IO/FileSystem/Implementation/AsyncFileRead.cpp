@@ -0,0 +1,250 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/Implementation/AsyncFileReadBackend.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+ezCVarBool cvar_FileSystemNativeAsyncReads("FileSystem.NativeAsyncReads", true, ezCVarFlags::Default, "Use the native asynchronous file API of the platform (io_uring on Linux) for ezFileSystem::ReadAsync, instead of reading on the file access thread.");
+
+namespace
+{
+  ezMutex s_AsyncFileReadBackendMutex;
+  ezUniquePtr<ezAsyncFileReadBackend> s_pAsyncFileReadBackend;
+  bool s_bAsyncFileReadBackendCreated = false;
+  ezAtomicInteger32 s_iNumAsyncFileReadsInFlight;
+
+  class ezAsyncFileReadTask final : public ezTask
+  {
+  public:
+    ezAsyncFileReadTask(const ezSharedPtr<ezAsyncFileRead>& pRead)
+      : m_pRead(pRead)
+    {
+      ConfigureTask("ReadAsync", ezTaskNesting::Never);
+    }
+
+  private:
+    virtual void Execute() override
+    {
+      // WaitForCompletion() may have executed the read already
+      ezAsyncFileReadBackend::ExecuteIfPending(*m_pRead);
+      m_pRead.Clear();
+    }
+
+    ezSharedPtr<ezAsyncFileRead> m_pRead;
+  };
+
+  ezAsyncFileReadBackend* GetNativeAsyncFileReadBackend()
+  {
+    if (!cvar_FileSystemNativeAsyncReads)
+      return nullptr;
+
+    EZ_LOCK(s_AsyncFileReadBackendMutex);
+
+    // only create the backend on demand, it may start a thread
+    if (!s_bAsyncFileReadBackendCreated)
+    {
+      s_bAsyncFileReadBackendCreated = true;
+      s_pAsyncFileReadBackend = ezCreateNativeAsyncFileReadBackend();
+    }
+
+    return s_pAsyncFileReadBackend.Borrow();
+  }
+
+  void ShutdownAsyncFileReads()
+  {
+    while (s_iNumAsyncFileReadsInFlight > 0)
+    {
+      ezThreadUtils::YieldTimeSlice();
+    }
+
+    EZ_LOCK(s_AsyncFileReadBackendMutex);
+    s_pAsyncFileReadBackend.Clear();
+    s_bAsyncFileReadBackendCreated = false;
+  }
+} // namespace
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, AsyncFileRead)
+
+  BEGIN_SUBSYSTEM_DEPENDENCIES
+    "FileSystem",
+    "TaskSystem"
+  END_SUBSYSTEM_DEPENDENCIES
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ShutdownAsyncFileReads();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+#if EZ_DISABLED(EZ_PLATFORM_LINUX)
+ezUniquePtr<ezAsyncFileReadBackend> ezCreateNativeAsyncFileReadBackend()
+{
+  return nullptr;
+}
+#endif
+
+ezAsyncFileRead::ezAsyncFileRead()
+  : m_Finished(ezThreadSignal::Mode::ManualReset)
+{
+}
+
+ezAsyncFileRead::~ezAsyncFileRead() = default;
+
+void ezAsyncFileRead::WaitForCompletion()
+{
+  ezAsyncFileReadBackend::ExecuteIfPending(*this);
+
+  m_Finished.WaitForSignal();
+}
+
+void ezAsyncFileRead::ExecuteBlockingRead()
+{
+  ezResult result = EZ_FAILURE;
+  ezUInt64 uiNumBytesRead = 0;
+
+  if (!m_sOSFile.IsEmpty())
+  {
+    ezOSFile file;
+    if (file.Open(m_sOSFile, ezFileOpenMode::Read, ezFileShareMode::SharedReads).Succeeded())
+    {
+      ezUInt8* pTarget = ezAsyncFileReadBackend::PrepareTarget(*this, file.GetFileSize());
+
+      file.SetFilePosition(m_Request.m_uiOffset, ezFileSeekMode::FromStart);
+      uiNumBytesRead = file.Read(pTarget, m_uiNumBytesToRead);
+      result = EZ_SUCCESS;
+    }
+  }
+  else
+  {
+    // files that are not directly on disk (e.g. inside archives) have to go through their data directory
+    ezFileReader file;
+    if (file.Open(m_Request.m_sFile, 0).Succeeded())
+    {
+      ezUInt8* pTarget = ezAsyncFileReadBackend::PrepareTarget(*this, file.GetFileSize());
+
+      file.SkipBytes(m_Request.m_uiOffset);
+      uiNumBytesRead = file.ReadBytes(pTarget, m_uiNumBytesToRead);
+      result = EZ_SUCCESS;
+    }
+  }
+
+  ezAsyncFileReadBackend::FinishRead(*this, result, uiNumBytesRead);
+}
+
+void ezAsyncFileReadBackend::ExecuteIfPending(ezAsyncFileRead& ref_read)
+{
+  if (ref_read.m_iState.TestAndSet(ezAsyncFileRead::State::Pending, ezAsyncFileRead::State::Reading))
+  {
+    ref_read.ExecuteBlockingRead();
+  }
+}
+
+ezUInt8* ezAsyncFileReadBackend::PrepareTarget(ezAsyncFileRead& ref_read, ezUInt64 uiFileSize)
+{
+  const ezUInt64 uiOffset = ref_read.m_Request.m_uiOffset;
+  const ezUInt64 uiAvailable = uiFileSize > uiOffset ? uiFileSize - uiOffset : 0;
+
+  ref_read.m_uiNumBytesToRead = ezMath::Min(ref_read.m_Request.m_uiNumBytes, uiAvailable);
+
+  if (ref_read.m_Request.m_pDestination != nullptr)
+  {
+    ref_read.m_pTarget = static_cast<ezUInt8*>(ref_read.m_Request.m_pDestination);
+  }
+  else
+  {
+    EZ_ASSERT_DEV(ref_read.m_uiNumBytesToRead <= ezMath::MaxValue<ezUInt32>(), "Reads into the internal buffer are limited to 4GB, use a destination buffer instead.");
+
+    ref_read.m_Buffer.SetCountUninitialized(static_cast<ezUInt32>(ref_read.m_uiNumBytesToRead));
+    ref_read.m_pTarget = ref_read.m_Buffer.GetData();
+  }
+
+  return ref_read.m_pTarget;
+}
+
+void ezAsyncFileReadBackend::FinishRead(ezAsyncFileRead& ref_read, ezResult result, ezUInt64 uiNumBytesRead)
+{
+  ref_read.m_Result = result;
+  ref_read.m_uiNumBytesRead = uiNumBytesRead;
+
+  if (ref_read.m_Request.m_OnCompletion.IsValid())
+  {
+    ref_read.m_Request.m_OnCompletion(ref_read);
+  }
+
+  // the read may get deleted as soon as the signal is raised, if no one else holds a reference to it
+  ezSharedPtr<ezAsyncFileRead> pKeepAlive = std::move(ref_read.m_pKeepAlive);
+
+  ref_read.m_iState = ezAsyncFileRead::State::Finished;
+  ref_read.m_Finished.RaiseSignal();
+
+  s_iNumAsyncFileReadsInFlight.Decrement();
+}
+
+ezSharedPtr<ezAsyncFileRead> ezFileSystem::ReadAsync(const ezAsyncFileReadRequest& request)
+{
+  ezHybridArray<ezSharedPtr<ezAsyncFileRead>, 1> reads;
+  ReadAsyncBatch(ezMakeArrayPtr(&request, 1), reads);
+  return reads[0];
+}
+
+void ezFileSystem::ReadAsyncBatch(ezArrayPtr<const ezAsyncFileReadRequest> requests, ezDynamicArray<ezSharedPtr<ezAsyncFileRead>>& out_reads)
+{
+  EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+  EZ_PROFILE_SCOPE("ReadAsyncBatch");
+
+  ezAsyncFileReadBackend* pBackend = GetNativeAsyncFileReadBackend();
+
+  ezHybridArray<ezAsyncFileRead*, 32> nativeReads;
+  ezStringBuilder sAbsolutePath;
+
+  out_reads.Reserve(out_reads.GetCount() + requests.GetCount());
+
+  for (const ezAsyncFileReadRequest& request : requests)
+  {
+    EZ_ASSERT_DEV(request.m_pDestination == nullptr || request.m_uiNumBytes != ezMath::MaxValue<ezUInt64>(), "The number of bytes to read must be known, when reading into a destination buffer.");
+
+    ezSharedPtr<ezAsyncFileRead> pRead = EZ_DEFAULT_NEW(ezAsyncFileRead);
+    pRead->m_Request = request;
+    pRead->m_pKeepAlive = pRead;
+    out_reads.PushBack(pRead);
+
+    s_iNumAsyncFileReadsInFlight.Increment();
+
+    if (ResolvePath(request.m_sFile, &sAbsolutePath, nullptr).Failed())
+    {
+      pRead->m_iState = ezAsyncFileRead::State::Reading;
+      ezAsyncFileReadBackend::FinishRead(*pRead, EZ_FAILURE, 0);
+      continue;
+    }
+
+    if (ezOSFile::ExistsFile(sAbsolutePath))
+    {
+      pRead->m_sOSFile = sAbsolutePath;
+
+      if (pBackend != nullptr)
+      {
+        pRead->m_iState = ezAsyncFileRead::State::Reading;
+        nativeReads.PushBack(pRead.Borrow());
+        continue;
+      }
+    }
+
+    ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezAsyncFileReadTask, pRead);
+    ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::FileAccess);
+  }
+
+  if (!nativeReads.IsEmpty())
+  {
+    pBackend->Submit(nativeReads);
+  }
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_FileSystem_Implementation_AsyncFileRead);
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#include <Foundation/IO/FileSystem/AsyncFileRead.h>
+#include <Foundation/Types/UniquePtr.h>
+
+/// \brief Interface for platform specific implementations that execute asynchronous reads from OS files.
+///
+/// Reads that can't be handled by a backend (files inside archives or platforms without a backend) are executed
+/// by tasks on the file access thread instead.
+class ezAsyncFileReadBackend
+{
+public:
+  virtual ~ezAsyncFileReadBackend() = default;
+
+  /// \brief Starts all the given reads. Every one of them must eventually be passed to FinishRead().
+  virtual void Submit(ezArrayPtr<ezAsyncFileRead* const> reads) = 0;
+
+  /// \brief Executes the read on the calling thread, unless it has been started already.
+  static void ExecuteIfPending(ezAsyncFileRead& ref_read);
+
+protected:
+  static ezStringView GetOSFile(const ezAsyncFileRead& read) { return read.m_sOSFile; }
+  static ezUInt64 GetOffset(const ezAsyncFileRead& read) { return read.m_Request.m_uiOffset; }
+
+  /// \brief Clamps the read to the file size and allocates the internal buffer, if necessary. Returns where the data has to be written to.
+  static ezUInt8* PrepareTarget(ezAsyncFileRead& ref_read, ezUInt64 uiFileSize);
+
+  /// \brief Returns how many bytes are supposed to be read. Only valid after PrepareTarget().
+  static ezUInt64 GetNumBytesToRead(const ezAsyncFileRead& read) { return read.m_uiNumBytesToRead; }
+
+  /// \brief Marks the read as finished and calls the completion callback.
+  static void FinishRead(ezAsyncFileRead& ref_read, ezResult result, ezUInt64 uiNumBytesRead);
+
+  /// \brief Executes a read that was already started on the calling thread, e.g. if the backend can't execute it after all.
+  static void ExecuteBlockingRead(ezAsyncFileRead& ref_read) { ref_read.ExecuteBlockingRead(); }
+
+  friend class ezAsyncFileRead;
+  friend class ezFileSystem;
+};
+
+/// \brief Creates the native backend of the current platform. Returns nullptr, if the platform doesn't have one or it is not available at runtime.
+ezUniquePtr<ezAsyncFileReadBackend> ezCreateNativeAsyncFileReadBackend();
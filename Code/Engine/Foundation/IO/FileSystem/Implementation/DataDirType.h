@@ -186,6 +186,12 @@ public:
 
     return uiBytesSkipped;
   }
+
+  /// \brief Returns the entire file content, if the data directory has it in memory already (e.g. uncompressed entries in memory mapped archives).
+  ///
+  /// This allows to consume the data without copying it. The view stays valid until the data directory is removed.
+  /// Returns an empty array, if the data is not directly accessible.
+  virtual ezConstByteArrayPtr GetFileMemoryView() const { return {}; }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
@@ -36,6 +36,11 @@ public:
   /// \brief Returns the current total size of the file.
   ezUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns the entire file content without copying it, if the data directory supports that. Otherwise returns an empty array.
+  ///
+  /// \sa ezDataDirectoryReader::GetFileMemoryView()
+  ezConstByteArrayPtr GetFileMemoryView() const { return m_pDataDirReader->GetFileMemoryView(); }
+
 protected:
   ezDataDirectoryReader* GetFileReader(ezStringView sFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
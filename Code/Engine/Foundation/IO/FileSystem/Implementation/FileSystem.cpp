@@ -1,6 +1,7 @@
 #include <Foundation/FoundationPCH.h>
 
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
@@ -117,6 +118,9 @@ ezResult ezFileSystem::AddDataDirectory(ezStringView sDataDirectory, ezStringVie
 
         s_pData->m_DataDirectories.PushBack(dd);
 
+        InvalidatePathCache();
+        UpdatePathCacheWatchers();
+
         {
           // Broadcast that a data directory was added
           FileEvent fe;
@@ -172,6 +176,9 @@ bool ezFileSystem::RemoveDataDirectory(ezStringView sRootName)
       directory.m_pDataDirectory->RemoveDataDirectory();
       s_pData->m_DataDirectories.RemoveAtAndCopy(i);
 
+      InvalidatePathCache();
+      UpdatePathCacheWatchers();
+
       return true;
     }
     else
@@ -213,6 +220,12 @@ ezUInt32 ezFileSystem::RemoveDataDirectoryGroup(ezStringView sGroup)
       ++i;
   }
 
+  if (uiRemoved > 0)
+  {
+    InvalidatePathCache();
+    UpdatePathCacheWatchers();
+  }
+
   return uiRemoved;
 }
 
@@ -238,6 +251,9 @@ void ezFileSystem::ClearAllDataDirectories()
   }
 
   s_pData->m_DataDirectories.Clear();
+
+  InvalidatePathCache();
+  UpdatePathCacheWatchers();
 }
 
 const ezFileSystem::DataDirectoryInfo* ezFileSystem::FindDataDirectoryWithRoot(ezStringView sRootName)
@@ -346,6 +362,9 @@ void ezFileSystem::DeleteFile(ezStringView sFile)
   if (ezPathUtils::IsAbsolutePath(sFile))
   {
     ezOSFile::DeleteFile(sFile).IgnoreResult();
+
+    EZ_LOCK(s_pData->m_FsMutex);
+    InvalidatePathCache();
     return;
   }
 
@@ -359,6 +378,8 @@ void ezFileSystem::DeleteFile(ezStringView sFile)
 
   EZ_LOCK(s_pData->m_FsMutex);
 
+  InvalidatePathCache();
+
   for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
     // do not delete data from directories that are mounted as read only
@@ -396,17 +417,48 @@ bool ezFileSystem::ExistsFile(ezStringView sFile)
 
   EZ_LOCK(s_pData->m_FsMutex);
 
+  ezStringBuilder sCacheKey;
+  if (s_pData->m_bPathCacheEnabled)
+  {
+    MakePathCacheKey(sRootName, sFile, sCacheKey);
+
+    ezInt32 iCachedDataDir = -1;
+    if (LookupPathCache(sCacheKey, iCachedDataDir))
+    {
+      if (iCachedDataDir < 0)
+        return false;
+
+      if (s_pData->m_DataDirectories[iCachedDataDir].m_pDataDirectory->ExistsFile(GetDataDirRelativePath(sFile, iCachedDataDir), bOneSpecificDataDir))
+        return true;
+
+      // the cache is outdated, the file might be somewhere else now
+      s_pData->m_PathCache.Remove(sCacheKey);
+    }
+  }
+
+  bool bCacheable = s_pData->m_bPathCacheEnabled;
+
   for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
     if (!sRootName.IsEmpty() && s_pData->m_DataDirectories[i].m_sRootName != sRootName)
       continue;
 
+    bCacheable = bCacheable && IsPathCacheable(i, sFile);
+
     ezStringView sRelPath = GetDataDirRelativePath(sFile, i);
 
     if (s_pData->m_DataDirectories[i].m_pDataDirectory->ExistsFile(sRelPath, bOneSpecificDataDir))
+    {
+      if (bCacheable)
+        StorePathCache(sCacheKey, i);
+
       return true;
+    }
   }
 
+  if (bCacheable)
+    StorePathCache(sCacheKey, -1);
+
   return false;
 }
 
@@ -463,15 +515,38 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(ezStringView sFile, ezFileSha
   ezStringBuilder sPath = sFile;
   sPath.MakeCleanPath();
 
+  ezStringBuilder sCacheKey;
+  ezInt32 iCachedDataDir = -1;
+  bool bIsCached = false;
+
+  if (s_pData->m_bPathCacheEnabled)
+  {
+    MakePathCacheKey(sRootName, sPath, sCacheKey);
+    bIsCached = LookupPathCache(sCacheKey, iCachedDataDir);
+  }
+
+  return OpenFileReader(sRootName, sPath, sCacheKey, bIsCached, iCachedDataDir, FileShareMode, bAllowFileEvents);
+}
+
+ezDataDirectoryReader* ezFileSystem::OpenFileReader(const ezString& sRootName, ezStringView sPath, ezStringView sCacheKey, bool bIsCached, ezInt32 iCachedDataDir, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
+{
   const bool bOneSpecificDataDir = !sRootName.IsEmpty();
 
+  bool bCacheable = s_pData->m_bPathCacheEnabled;
+
   // the last added data directory has the highest priority
   for (ezInt32 i = (ezInt32)s_pData->m_DataDirectories.GetCount() - 1; i >= 0; --i)
   {
+    // if the cache knows where the file is (or that it doesn't exist), the other data directories don't need to be probed
+    if (bIsCached && i != iCachedDataDir)
+      continue;
+
     // if a root is used, ignore all directories that do not have the same root name
     if (bOneSpecificDataDir && s_pData->m_DataDirectories[i].m_sRootName != sRootName)
       continue;
 
+    bCacheable = bCacheable && IsPathCacheable(i, sPath);
+
     ezStringView sRelPath = GetDataDirRelativePath(sPath, i);
 
     if (bAllowFileEvents)
@@ -498,9 +573,35 @@ ezDataDirectoryReader* ezFileSystem::GetFileReader(ezStringView sFile, ezFileSha
       fe.m_sOther = sRootName;
       fe.m_pDataDir = s_pData->m_DataDirectories[i].m_pDataDirectory;
       s_pData->m_Event.Broadcast(fe);
+    }
+
+    if (pReader != nullptr)
+    {
+      if (!bIsCached && bCacheable)
+      {
+        StorePathCache(sCacheKey, i);
+      }
 
       return pReader;
     }
+
+    // Opening also fails for files that exist but are locked, only files that really don't exist may be cached as missing.
+    const bool bExists = s_pData->m_bPathCacheEnabled && s_pData->m_DataDirectories[i].m_pDataDirectory->ExistsFile(sRelPath, bOneSpecificDataDir);
+    bCacheable = bCacheable && !bExists;
+
+    if (bIsCached && !bExists)
+    {
+      // the cached data directory doesn't have the file anymore, probe all data directories again
+      s_pData->m_PathCache.Remove(sCacheKey);
+      bIsCached = false;
+      bCacheable = true;
+      i = s_pData->m_DataDirectories.GetCount();
+    }
+  }
+
+  if (!bIsCached && bCacheable)
+  {
+    StorePathCache(sCacheKey, -1);
   }
 
   if (bAllowFileEvents)
@@ -565,6 +666,12 @@ ezDataDirectoryWriter* ezFileSystem::GetFileWriter(ezStringView sFile, ezFileSha
 
     ezDataDirectoryWriter* pWriter = s_pData->m_DataDirectories[i].m_pDataDirectory->OpenFileToWrite(sRelPath, FileShareMode);
 
+    if (pWriter != nullptr)
+    {
+      // the file may not have existed before
+      InvalidatePathCache();
+    }
+
     if (bAllowFileEvents && pWriter != nullptr)
     {
       // Broadcast that this file has been created.
@@ -649,8 +756,29 @@ ezResult ezFileSystem::ResolvePath(ezStringView sPath, ezStringBuilder* out_pAbs
   }
   else
   {
+    if (sPath.IsEmpty())
+      return EZ_FAILURE;
+
+    ezStringBuilder sCleanPath = sPath;
+    sCleanPath.MakeCleanPath();
+
+    ezStringBuilder sCacheKey;
+    ezInt32 iCachedDataDir = -1;
+    bool bIsCached = false;
+
+    if (s_pData->m_bPathCacheEnabled)
+    {
+      MakePathCacheKey(ezString(), sCleanPath, sCacheKey);
+      bIsCached = LookupPathCache(sCacheKey, iCachedDataDir);
+
+      // files that are known not to exist don't need to be opened
+      if (bIsCached && iCachedDataDir < 0)
+        return EZ_FAILURE;
+    }
+
     // try to get a reader -> if we get one, the file does indeed exist
-    ezDataDirectoryReader* pReader = ezFileSystem::GetFileReader(sPath, ezFileShareMode::SharedReads, true);
+    // the reader is still needed for cached files, because only the data directory knows where a file is redirected to
+    ezDataDirectoryReader* pReader = OpenFileReader(ezString(), sCleanPath, sCacheKey, bIsCached, iCachedDataDir, ezFileShareMode::SharedReads, true);
 
     if (!pReader)
       return EZ_FAILURE;
@@ -818,6 +946,185 @@ void ezFileSystem::ReloadAllExternalDataDirectoryConfigs()
   {
     dd.m_pDataDirectory->ReloadExternalConfigs();
   }
+
+  // the redirection tables may have changed
+  InvalidatePathCache();
+}
+
+void ezFileSystem::SetPathCacheEnabled(bool bEnable)
+{
+  EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+
+  EZ_LOCK(s_pData->m_FsMutex);
+
+  if (s_pData->m_bPathCacheEnabled == bEnable)
+    return;
+
+  s_pData->m_bPathCacheEnabled = bEnable;
+
+  InvalidatePathCache();
+  UpdatePathCacheWatchers();
+}
+
+bool ezFileSystem::IsPathCacheEnabled()
+{
+  EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+
+  return s_pData->m_bPathCacheEnabled;
+}
+
+void ezFileSystem::ClearPathCache()
+{
+  EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+
+  EZ_LOCK(s_pData->m_FsMutex);
+  InvalidatePathCache();
+}
+
+ezFileSystem::PathCacheStats ezFileSystem::GetPathCacheStats()
+{
+  EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+
+  EZ_LOCK(s_pData->m_FsMutex);
+
+  PathCacheStats stats = s_pData->m_PathCacheStats;
+  stats.m_uiNumEntries = s_pData->m_PathCache.GetCount();
+  return stats;
+}
+
+void ezFileSystem::MakePathCacheKey(ezStringView sRootName, ezStringView sPath, ezStringBuilder& out_sKey)
+{
+  // clean up the path on its own, the root name would otherwise count as a folder that ".." can remove
+  ezStringBuilder sCleanPath = sPath;
+  sCleanPath.MakeCleanPath();
+
+  out_sKey.Set(sRootName, ":", sCleanPath);
+}
+
+bool ezFileSystem::LookupPathCache(ezStringView sKey, ezInt32& out_iDataDir)
+{
+  PollPathCacheWatchers();
+
+  if (s_pData->m_PathCache.TryGetValue(sKey, out_iDataDir))
+  {
+    if (out_iDataDir < 0)
+      ++s_pData->m_PathCacheStats.m_uiNegativeHits;
+    else
+      ++s_pData->m_PathCacheStats.m_uiHits;
+
+    return true;
+  }
+
+  ++s_pData->m_PathCacheStats.m_uiMisses;
+  return false;
+}
+
+void ezFileSystem::StorePathCache(ezStringView sKey, ezInt32 iDataDir)
+{
+  // start over once the cache gets very large, e.g. when lots of non-existing files are queried
+  constexpr ezUInt32 MaxPathCacheEntries = 64 * 1024;
+  if (s_pData->m_PathCache.GetCount() >= MaxPathCacheEntries)
+  {
+    InvalidatePathCache();
+  }
+
+  s_pData->m_PathCache.Insert(sKey, iDataDir);
+}
+
+void ezFileSystem::InvalidatePathCache()
+{
+  if (s_pData->m_PathCache.IsEmpty())
+    return;
+
+  s_pData->m_PathCache.Clear();
+  ++s_pData->m_PathCacheStats.m_uiInvalidations;
+}
+
+void ezFileSystem::UpdatePathCacheWatchers()
+{
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+  for (ezDirectoryWatcher* pWatcher : s_pData->m_PathCacheWatchers)
+  {
+    EZ_DEFAULT_DELETE(pWatcher);
+  }
+#endif
+
+  s_pData->m_PathCacheWatchers.Clear();
+  s_pData->m_PathCacheDataDirCacheable.Clear();
+
+  if (!s_pData->m_bPathCacheEnabled)
+    return;
+
+  s_pData->m_PathCacheDataDirCacheable.SetCount(s_pData->m_DataDirectories.GetCount(), false);
+
+  ezStringBuilder sPath;
+  for (ezUInt32 i = 0; i < s_pData->m_DataDirectories.GetCount(); ++i)
+  {
+    sPath = s_pData->m_DataDirectories[i].m_pDataDirectory->GetRedirectedDataDirectoryPath();
+    while (sPath.EndsWith("/"))
+      sPath.Shrink(0, 1);
+
+    // the data directory for absolute paths, see IsPathCacheable()
+    if (sPath.IsEmpty())
+      continue;
+
+    // archives don't change while they are mounted
+    if (ezOSFile::ExistsFile(sPath))
+    {
+      s_pData->m_PathCacheDataDirCacheable[i] = true;
+      continue;
+    }
+
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    if (ezOSFile::ExistsDirectory(sPath))
+    {
+      ezDirectoryWatcher* pWatcher = EZ_DEFAULT_NEW(ezDirectoryWatcher);
+
+      if (pWatcher->OpenDirectory(sPath, ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Deletes | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories).Succeeded())
+      {
+        s_pData->m_PathCacheWatchers.PushBack(pWatcher);
+        s_pData->m_PathCacheDataDirCacheable[i] = true;
+      }
+      else
+      {
+        EZ_DEFAULT_DELETE(pWatcher);
+      }
+    }
+#endif
+  }
+}
+
+bool ezFileSystem::IsPathCacheable(ezUInt32 uiDataDir, ezStringView sPath)
+{
+  if (s_pData->m_PathCacheDataDirCacheable[uiDataDir])
+    return true;
+
+  // the data directory for absolute paths can't be watched, since the files could be anywhere,
+  // but relative paths end up in the working directory, which is treated like a regular data directory that doesn't change
+  return ezPathUtils::IsRelativePath(sPath) && s_pData->m_DataDirectories[uiDataDir].m_pDataDirectory->GetRedirectedDataDirectoryPath().IsEmpty();
+}
+
+void ezFileSystem::PollPathCacheWatchers()
+{
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+  if (s_pData->m_PathCacheWatchers.IsEmpty())
+    return;
+
+  const ezTime tNow = ezTime::Now();
+  if (tNow - s_pData->m_LastPathCacheWatcherPoll < ezTime::MakeFromMilliseconds(100))
+    return;
+
+  s_pData->m_LastPathCacheWatcherPoll = tNow;
+
+  bool bChanged = false;
+  ezDirectoryWatcher::EnumerateChanges(s_pData->m_PathCacheWatchers, [&bChanged](ezStringView sFilename, ezDirectoryWatcherAction action, ezDirectoryWatcherType type)
+    { bChanged = true; });
+
+  if (bChanged)
+  {
+    InvalidatePathCache();
+  }
+#endif
 }
 
 void ezFileSystem::Startup()
@@ -23,7 +23,7 @@ ezCompressedStreamReaderZstd::~ezCompressedStreamReaderZstd()
   }
 }
 
-void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream)
+void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream, ezConstByteArrayPtr rawDictionary /*= ezConstByteArrayPtr()*/)
 {
   m_InBuffer.pos = 0;
   m_InBuffer.size = 0;
@@ -36,6 +36,12 @@ void ezCompressedStreamReaderZstd::SetInputStream(ezStreamReader* pInputStream)
   }
 
   ZSTD_initDStream(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream));
+
+  if (!rawDictionary.IsEmpty())
+  {
+    // a prefix only applies to the next frame, which is all that is needed here
+    ZSTD_DCtx_refPrefix(reinterpret_cast<ZSTD_DStream*>(m_pZstdDStream), rawDictionary.GetPtr(), rawDictionary.GetCount());
+  }
 }
 
 ezUInt64 ezCompressedStreamReaderZstd::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
@@ -0,0 +1,509 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+#include <atomic>
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, AsyncLog)
+
+  // no dependencies
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezGlobalLog::DisableAsyncLogging();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+namespace
+{
+  thread_local bool tl_bIsAsyncLogWriterThread = false;
+}
+
+/// Bounded lock-free multi-producer single-consumer queue of log messages and the thread that consumes it.
+///
+/// The queue follows the usual sequence number scheme: every entry stores the position at which it may be written next. Producers
+/// reserve a position with a compare-exchange and publish the entry by advancing its sequence number, the single consumer releases
+/// it again by advancing the sequence number by the queue capacity.
+class ezAsyncLogWriter : public ezThread
+{
+public:
+  ezAsyncLogWriter(const ezGlobalLog::AsyncLogConfig& config)
+    : ezThread("Async Log Writer")
+    , m_Config(config)
+  {
+    const ezUInt32 uiCapacity = ezMath::PowerOfTwo_Ceil(ezMath::Max(config.m_uiQueueCapacity, 2u));
+    m_uiMask = uiCapacity - 1;
+    m_Entries = EZ_DEFAULT_NEW_ARRAY(Entry, uiCapacity);
+
+    for (ezUInt32 i = 0; i < uiCapacity; ++i)
+    {
+      m_Entries[i].m_uiSequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~ezAsyncLogWriter()
+  {
+    EZ_DEFAULT_DELETE_ARRAY(m_Entries);
+  }
+
+  bool Push(const ezLoggingEventData& le)
+  {
+    while (!TryPush(le))
+    {
+      if (CanDrop(le.m_EventType))
+      {
+        m_uiNumDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+
+      WakeUp();
+      ezThreadUtils::YieldTimeSlice();
+    }
+
+    if (m_bSleeping.load() && m_bSleeping.exchange(false))
+    {
+      m_Signal.RaiseSignal();
+    }
+
+    return true;
+  }
+
+  void WaitUntilProcessed()
+  {
+    const ezUInt64 uiTarget = m_uiEnqueuePos.load();
+
+    while (m_uiProcessedPos.load(std::memory_order_acquire) < uiTarget && !m_bHalt.load())
+    {
+      WakeUp();
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+  }
+
+  void Stop()
+  {
+    m_bStop = true;
+    WakeUp();
+    Join();
+  }
+
+  void FlushAfterCrash()
+  {
+    if (!tl_bIsAsyncLogWriterThread)
+    {
+      // stop the writer thread from consuming, so that the queue can be drained on this thread
+      m_bHalted = false;
+      m_bHalt = true;
+      WakeUp();
+
+      for (ezUInt32 i = 0; i < 500 && !m_bHalted.load(); ++i)
+      {
+        ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+      }
+
+      // the writer thread is stuck, consuming concurrently would corrupt the queue
+      if (!m_bHalted.load())
+        return;
+    }
+
+    ProcessQueue();
+    ReportSuppressedDuplicates();
+    FinishBatch();
+
+    ezLoggingEventData flush;
+    flush.m_EventType = ezLogMsgType::Flush;
+    ezGlobalLog::s_LoggingEvent.Broadcast(flush);
+
+    // in case the application survives, the writer thread continues
+    m_bHalt = false;
+    WakeUp();
+  }
+
+  ezUInt32 GetNumDroppedMessages() const { return m_uiNumDroppedMessages.load(std::memory_order_relaxed); }
+
+private:
+  struct Entry
+  {
+    std::atomic<ezUInt64> m_uiSequence;
+    ezLogMsgType::Enum m_EventType = ezLogMsgType::None;
+    ezUInt8 m_uiIndentation = 0;
+    ezHybridString<64> m_sTag;
+    ezHybridString<256> m_sText;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    double m_fSeconds = 0;
+#endif
+  };
+
+  virtual ezUInt32 Run() override
+  {
+    tl_bIsAsyncLogWriterThread = true;
+
+    while (true)
+    {
+      if (m_bHalt)
+      {
+        m_bHalted = true;
+
+        if (m_bStop)
+          break;
+
+        m_Signal.WaitForSignal(ezTime::MakeFromMilliseconds(50));
+        continue;
+      }
+
+      m_bHalted = false;
+
+      if (ProcessQueue())
+        continue;
+
+      FinishBatch();
+
+      if (m_bStop)
+      {
+        ReportSuppressedDuplicates();
+        break;
+      }
+
+      m_bSleeping = true;
+
+      if (!IsQueueEmpty())
+      {
+        m_bSleeping = false;
+        continue;
+      }
+
+      // the timeout is only a safety net, producers raise the signal when they see that the thread sleeps
+      // while duplicates are pending, wake up in time to report them once the collapse window has expired
+      m_Signal.WaitForSignal(ezMath::Min(ezTime::MakeFromMilliseconds(50), GetTimeUntilDuplicateWindowExpires()));
+      m_bSleeping = false;
+    }
+
+    tl_bIsAsyncLogWriterThread = false;
+    return 0;
+  }
+
+  bool TryPush(const ezLoggingEventData& le)
+  {
+    ezUInt64 uiPos = m_uiEnqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+      Entry& entry = m_Entries[uiPos & m_uiMask];
+      const ezUInt64 uiSequence = entry.m_uiSequence.load(std::memory_order_acquire);
+
+      if (uiSequence == uiPos)
+      {
+        if (m_uiEnqueuePos.compare_exchange_weak(uiPos, uiPos + 1, std::memory_order_relaxed))
+        {
+          entry.m_EventType = le.m_EventType;
+          entry.m_uiIndentation = le.m_uiIndentation;
+          entry.m_sTag = le.m_sTag;
+          entry.m_sText = le.m_sText;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+          entry.m_fSeconds = le.m_fSeconds;
+#endif
+
+          entry.m_uiSequence.store(uiPos + 1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (uiSequence < uiPos)
+      {
+        // the entry is still in use by the consumer, the queue is full
+        return false;
+      }
+      else
+      {
+        uiPos = m_uiEnqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool CanDrop(ezLogMsgType::Enum type) const
+  {
+    // dropping groups or flushes would confuse the log writers
+    if (type <= ezLogMsgType::None)
+      return false;
+
+    switch (m_Config.m_OverflowPolicy)
+    {
+      case ezGlobalLog::AsyncOverflowPolicy::Drop:
+        return true;
+      case ezGlobalLog::AsyncOverflowPolicy::DropBelowSeverity:
+        return type > m_Config.m_DropBelowSeverity;
+      default:
+        return false;
+    }
+  }
+
+  bool IsQueueEmpty() const
+  {
+    const Entry& entry = m_Entries[m_uiDequeuePos & m_uiMask];
+    return entry.m_uiSequence.load(std::memory_order_acquire) != m_uiDequeuePos + 1;
+  }
+
+  void WakeUp()
+  {
+    m_bSleeping = false;
+    m_Signal.RaiseSignal();
+  }
+
+  /// Passes all queued messages to the log writers, returns false if the queue was empty.
+  bool ProcessQueue()
+  {
+    bool bProcessedAny = false;
+
+    while (!IsQueueEmpty())
+    {
+      Entry& entry = m_Entries[m_uiDequeuePos & m_uiMask];
+      Broadcast(entry);
+
+      entry.m_uiSequence.store(m_uiDequeuePos + m_uiMask + 1, std::memory_order_release);
+      ++m_uiDequeuePos;
+      m_uiProcessedPos.store(m_uiDequeuePos, std::memory_order_release);
+      bProcessedAny = true;
+
+      // another thread wants to take over, see FlushAfterCrash()
+      if (m_bHalt && tl_bIsAsyncLogWriterThread)
+        break;
+    }
+
+    return bProcessedAny;
+  }
+
+  void Broadcast(const Entry& entry)
+  {
+    const bool bIsMessage = entry.m_EventType > ezLogMsgType::None;
+
+    if (bIsMessage && m_Config.m_DuplicateMessageWindow.IsPositive())
+    {
+      const ezTime now = ezTime::Now();
+
+      if (m_bHasLastMessage && entry.m_EventType == m_LastEventType && entry.m_uiIndentation == m_uiLastIndentation &&
+          now - m_LastMessageTime < m_Config.m_DuplicateMessageWindow && entry.m_sText == m_sLastText && entry.m_sTag == m_sLastTag)
+      {
+        ++m_uiNumSuppressedDuplicates;
+        return;
+      }
+
+      ReportSuppressedDuplicates();
+
+      m_bHasLastMessage = true;
+      m_LastEventType = entry.m_EventType;
+      m_uiLastIndentation = entry.m_uiIndentation;
+      m_LastMessageTime = now;
+      m_sLastText = entry.m_sText;
+      m_sLastTag = entry.m_sTag;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      m_fLastSeconds = entry.m_fSeconds;
+#endif
+    }
+    else if (entry.m_EventType == ezLogMsgType::BeginGroup || entry.m_EventType == ezLogMsgType::EndGroup)
+    {
+      // the count has to be reported in the group of the message that was repeated
+      ReportSuppressedDuplicates();
+      m_bHasLastMessage = false;
+    }
+
+    ezLoggingEventData le;
+    le.m_EventType = entry.m_EventType;
+    le.m_uiIndentation = entry.m_uiIndentation;
+    le.m_sTag = entry.m_sTag;
+    le.m_sText = entry.m_sText;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    le.m_fSeconds = entry.m_fSeconds;
+#endif
+
+    ezGlobalLog::s_LoggingEvent.Broadcast(le);
+  }
+
+  void ReportSuppressedDuplicates()
+  {
+    if (m_uiNumSuppressedDuplicates == 0)
+      return;
+
+    ezStringBuilder sText;
+    sText.SetFormat("Last message repeated {0} times.", m_uiNumSuppressedDuplicates);
+    m_uiNumSuppressedDuplicates = 0;
+
+    ezLoggingEventData le;
+    le.m_EventType = m_LastEventType;
+    le.m_uiIndentation = m_uiLastIndentation;
+    le.m_sTag = m_sLastTag;
+    le.m_sText = sText;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    le.m_fSeconds = m_fLastSeconds;
+#endif
+
+    ezGlobalLog::s_LoggingEvent.Broadcast(le);
+  }
+
+  /// Returns how long the duplicates that are currently being collapsed may still be held back.
+  ezTime GetTimeUntilDuplicateWindowExpires() const
+  {
+    if (m_uiNumSuppressedDuplicates == 0)
+      return ezTime::MakeFromSeconds(60);
+
+    return ezMath::Max(ezTime::MakeZero(), m_LastMessageTime + m_Config.m_DuplicateMessageWindow - ezTime::Now());
+  }
+
+  /// Called whenever the queue has been drained.
+  ///
+  /// Suppressed duplicates are only reported here once their collapse window has expired, otherwise a message that is logged
+  /// repeatedly but not within a single burst would be followed by a 'repeated 1 times' message every time.
+  void FinishBatch()
+  {
+    if (m_uiNumSuppressedDuplicates > 0 && GetTimeUntilDuplicateWindowExpires().IsZeroOrNegative())
+    {
+      ReportSuppressedDuplicates();
+    }
+
+    const ezUInt32 uiNumDropped = m_uiNumDroppedMessages.load(std::memory_order_relaxed);
+    if (uiNumDropped != m_uiNumReportedDroppedMessages)
+    {
+      ezStringBuilder sText;
+      sText.SetFormat("{0} log messages were dropped, because the asynchronous log queue was full.", uiNumDropped - m_uiNumReportedDroppedMessages);
+      m_uiNumReportedDroppedMessages = uiNumDropped;
+
+      ezLoggingEventData le;
+      le.m_EventType = ezLogMsgType::WarningMsg;
+      le.m_sText = sText;
+
+      ezGlobalLog::s_LoggingEvent.Broadcast(le);
+    }
+  }
+
+  const ezGlobalLog::AsyncLogConfig m_Config;
+
+  ezArrayPtr<Entry> m_Entries;
+  ezUInt64 m_uiMask = 0;
+  std::atomic<ezUInt64> m_uiEnqueuePos{0};
+  std::atomic<ezUInt64> m_uiProcessedPos{0};
+  std::atomic<ezUInt32> m_uiNumDroppedMessages{0};
+
+  ezThreadSignal m_Signal;
+  std::atomic<bool> m_bSleeping{false};
+  std::atomic<bool> m_bStop{false};
+  std::atomic<bool> m_bHalt{false};
+  std::atomic<bool> m_bHalted{false};
+
+  // only accessed by the consumer
+  ezUInt64 m_uiDequeuePos = 0;
+  ezUInt32 m_uiNumReportedDroppedMessages = 0;
+  ezUInt32 m_uiNumSuppressedDuplicates = 0;
+  bool m_bHasLastMessage = false;
+  ezLogMsgType::Enum m_LastEventType = ezLogMsgType::None;
+  ezUInt8 m_uiLastIndentation = 0;
+  ezTime m_LastMessageTime;
+  ezStringBuilder m_sLastText;
+  ezStringBuilder m_sLastTag;
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  double m_fLastSeconds = 0;
+#endif
+};
+
+namespace
+{
+  ezMutex s_AsyncLogMutex;
+  std::atomic<ezAsyncLogWriter*> s_pAsyncLogWriter{nullptr};
+
+  // number of threads that currently queue a message, the writer may only be deleted once this is zero
+  std::atomic<ezInt32> s_iAsyncLogProducers{0};
+} // namespace
+
+void ezGlobalLog::EnableAsyncLogging(const AsyncLogConfig& config)
+{
+  EZ_LOCK(s_AsyncLogMutex);
+
+  if (s_pAsyncLogWriter.load() != nullptr)
+  {
+    DisableAsyncLogging();
+  }
+
+  ezAsyncLogWriter* pWriter = EZ_DEFAULT_NEW(ezAsyncLogWriter, config);
+  pWriter->Start();
+
+  s_pAsyncLogWriter.store(pWriter);
+}
+
+void ezGlobalLog::DisableAsyncLogging()
+{
+  EZ_LOCK(s_AsyncLogMutex);
+
+  ezAsyncLogWriter* pWriter = s_pAsyncLogWriter.exchange(nullptr);
+  if (pWriter == nullptr)
+    return;
+
+  while (s_iAsyncLogProducers.load() > 0)
+  {
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  // the thread drains the queue before it exits
+  pWriter->Stop();
+  EZ_DEFAULT_DELETE(pWriter);
+}
+
+bool ezGlobalLog::IsAsyncLoggingEnabled()
+{
+  return s_pAsyncLogWriter.load(std::memory_order_relaxed) != nullptr;
+}
+
+void ezGlobalLog::WaitForAsyncLog()
+{
+  if (tl_bIsAsyncLogWriterThread || s_pAsyncLogWriter.load(std::memory_order_relaxed) == nullptr)
+    return;
+
+  EZ_LOCK(s_AsyncLogMutex);
+
+  if (ezAsyncLogWriter* pWriter = s_pAsyncLogWriter.load())
+  {
+    pWriter->WaitUntilProcessed();
+  }
+}
+
+void ezGlobalLog::FlushAsyncLogAfterCrash()
+{
+  // don't take any locks here, the crashed thread might hold them
+  if (ezAsyncLogWriter* pWriter = s_pAsyncLogWriter.load())
+  {
+    pWriter->FlushAfterCrash();
+  }
+}
+
+ezUInt32 ezGlobalLog::GetNumDroppedAsyncMessages()
+{
+  EZ_LOCK(s_AsyncLogMutex);
+
+  ezAsyncLogWriter* pWriter = s_pAsyncLogWriter.load();
+  return pWriter != nullptr ? pWriter->GetNumDroppedMessages() : 0;
+}
+
+bool ezGlobalLog::QueueAsyncMessage(const ezLoggingEventData& le)
+{
+  if (s_pAsyncLogWriter.load(std::memory_order_relaxed) == nullptr)
+    return false;
+
+  // messages logged by the log writers themselves are passed on directly, the queue might be full
+  if (tl_bIsAsyncLogWriterThread)
+    return false;
+
+  s_iAsyncLogProducers.fetch_add(1);
+
+  bool bQueued = false;
+  if (ezAsyncLogWriter* pWriter = s_pAsyncLogWriter.load())
+  {
+    bQueued = pWriter->Push(le);
+  }
+
+  s_iAsyncLogProducers.fetch_sub(1);
+  return bQueued;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Logging_Implementation_AsyncLog);
@@ -44,11 +44,16 @@ void ezGlobalLog::RemoveLogWriter(ezLoggingEvent::Handler handler)
   if (!s_LoggingEvent.HasEventHandler(handler))
     return;
 
+  // the writer should still receive everything that was logged before it was removed
+  WaitForAsyncLog();
+
   s_LoggingEvent.RemoveEventHandler(handler);
 }
 
 void ezGlobalLog::RemoveLogWriter(ezEventSubscriptionID& ref_subscriptionID)
 {
+  WaitForAsyncLog();
+
   s_LoggingEvent.RemoveEventHandler(ref_subscriptionID);
 }
 
@@ -97,7 +102,11 @@ void ezGlobalLog::HandleLogMessage(const ezLoggingEventData& le)
       ezLog::Print(stmp);
     }
 #endif
-    s_LoggingEvent.Broadcast(le);
+
+    if (!QueueAsyncMessage(le))
+    {
+      s_LoggingEvent.Broadcast(le);
+    }
   }
 }
 
@@ -139,7 +139,59 @@ public:
   /// override is set at the moment.
   static void SetGlobalLogOverride(ezLogInterface* pInterface);
 
+  /// \brief Describes what happens when a message is logged while the queue of the asynchronous logging mode is full.
+  struct AsyncOverflowPolicy
+  {
+    enum Enum
+    {
+      Block,             ///< The logging thread waits until the writer thread has made room. No message is lost.
+      Drop,              ///< The message is dropped. The writers get a warning with the number of dropped messages later.
+      DropBelowSeverity, ///< Messages that are less severe than AsyncLogConfig::m_DropBelowSeverity are dropped, all others block.
+    };
+  };
+
+  /// \brief Configuration of the asynchronous logging mode, see EnableAsyncLogging().
+  struct AsyncLogConfig
+  {
+    ezUInt32 m_uiQueueCapacity = 4096; ///< How many messages can be queued, rounded up to the next power of two.
+    AsyncOverflowPolicy::Enum m_OverflowPolicy = AsyncOverflowPolicy::Block;
+    ezLogMsgType::Enum m_DropBelowSeverity = ezLogMsgType::WarningMsg;
+
+    /// \brief Identical consecutive messages within this time are collapsed into a single 'repeated n times' message. Zero disables this.
+    ezTime m_DuplicateMessageWindow = ezTime::MakeFromSeconds(1);
+  };
+
+  /// \brief Switches to asynchronous logging.
+  ///
+  /// Instead of calling all log writers on the thread that logs a message, the message is copied into a lock-free queue
+  /// and a dedicated thread passes it on to the log writers. This way slow log writers (e.g. file or HTML writers) don't stall the
+  /// threads that log. The log writers are only ever called from the writer thread then, in the order in which the messages were queued.
+  /// Groups and flush requests are never dropped, regardless of the overflow policy.
+  static void EnableAsyncLogging(const AsyncLogConfig& config);
+
+  /// \brief Passes all queued messages to the log writers, stops the writer thread and switches back to synchronous logging.
+  static void DisableAsyncLogging();
+
+  /// \brief Returns whether EnableAsyncLogging() is active.
+  static bool IsAsyncLoggingEnabled();
+
+  /// \brief Blocks until all messages that were logged before this call have been passed to the log writers.
+  ///
+  /// Does nothing in synchronous mode or when called from within a log writer.
+  static void WaitForAsyncLog();
+
+  /// \brief Passes all queued messages to the log writers on the calling thread. Called by the ezCrashHandler before the crash is handled.
+  static void FlushAsyncLogAfterCrash();
+
+  /// \brief Returns how many messages have been dropped due to the overflow policy since asynchronous logging was enabled.
+  static ezUInt32 GetNumDroppedAsyncMessages();
+
 private:
+  friend class ezAsyncLogWriter;
+
+  /// \brief Queues the message for the writer thread. Returns false if asynchronous logging is disabled.
+  static bool QueueAsyncMessage(const ezLoggingEventData& le);
+
   /// \brief Counts the number of messages of each type.
   static ezAtomicInteger32 s_uiMessageCount[ezLogMsgType::ENUM_COUNT];
 
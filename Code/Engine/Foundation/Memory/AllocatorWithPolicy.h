@@ -6,6 +6,7 @@
 #include <Foundation/Threading/ThreadUtils.h>
 
 EZ_MAKE_MEMBERFUNCTION_CHECKER(Reallocate, ezHasReallocate);
+EZ_MAKE_MEMBERFUNCTION_CHECKER(IsSampledAllocation, ezHasSampledTracking);
 
 #include <Foundation/Memory/Implementation/AllocatorMixin_inl.h>
 
@@ -13,6 +14,8 @@ EZ_MAKE_MEMBERFUNCTION_CHECKER(Reallocate, ezHasReallocate);
 ///
 /// AllocationPolicy defines how the actual memory is allocated.\n
 /// TrackingFlags defines how stats about allocations are tracked.\n
+/// Policies that implement IsSampledAllocation(), AllocatedSize() and GetStats() keep their own stats and only the allocations
+/// they flag as sampled are reported to ezMemoryTracker, see ezAllocPolicyThreadCache.
 template <typename AllocationPolicy, ezAllocatorTrackingMode TrackingMode = ezAllocatorTrackingMode::Default>
 class ezAllocatorWithPolicy : public ezInternal::ezAllocatorMixinReallocate<AllocationPolicy, TrackingMode,
                                 ezHasReallocate<AllocationPolicy, void* (AllocationPolicy::*)(void*, size_t, size_t, size_t)>::value>
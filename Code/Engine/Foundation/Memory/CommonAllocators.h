@@ -9,6 +9,7 @@
 #include <Foundation/Memory/Policies/AllocPolicyGuarding.h>
 #include <Foundation/Memory/Policies/AllocPolicyHeap.h>
 #include <Foundation/Memory/Policies/AllocPolicyProxy.h>
+#include <Foundation/Memory/Policies/AllocPolicyThreadCache.h>
 
 
 /// \brief Default heap allocator
@@ -17,6 +18,9 @@ using ezAlignedHeapAllocator = ezAllocatorWithPolicy<ezAllocPolicyAlignedHeap>;
 /// \brief Default heap allocator
 using ezHeapAllocator = ezAllocatorWithPolicy<ezAllocPolicyHeap>;
 
+/// \brief Heap allocator with per-thread caches for small allocations, see ezAllocPolicyThreadCache
+using ezThreadCacheHeapAllocator = ezAllocatorWithPolicy<ezAllocPolicyThreadCache>;
+
 /// \brief Guarded allocator
 using ezGuardingAllocator = ezAllocatorWithPolicy<ezAllocPolicyGuarding>;
 
@@ -0,0 +1,478 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Memory/Policies/AllocPolicyThreadCache.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+
+namespace
+{
+  static constexpr ezUInt32 s_uiHeaderSize = 16;
+  static constexpr ezUInt32 s_uiNumSizeClasses = 24;
+  static constexpr ezUInt16 s_uiLargeAllocation = 0xFFFF;
+  static constexpr ezUInt32 s_uiChunkSize = 64 * 1024;
+  static constexpr ezUInt32 s_uiMaxInstances = 32;
+  static constexpr ezUInt32 s_uiStatsPublishInterval = 64;
+
+  // the central free lists store a counter in the upper 16 bits of the head pointer to prevent ABA problems
+  static constexpr ezUInt64 s_uiPointerMask = (1ull << 48) - 1;
+
+  struct AllocationHeader
+  {
+    ezUInt64 m_uiSize;
+    ezUInt16 m_uiSizeClass;
+    ezUInt16 m_uiFlags;
+    ezUInt32 m_uiPadding;
+  };
+
+  static_assert(sizeof(AllocationHeader) == s_uiHeaderSize);
+
+  enum HeaderFlags : ezUInt16
+  {
+    Sampled = EZ_BIT(0),
+  };
+
+  /// The first block of a batch additionally links to the next batch and stores how many blocks the batch contains.
+  struct FreeBlock
+  {
+    FreeBlock* m_pNext;
+    FreeBlock* m_pNextBatch;
+    ezUInt32 m_uiBatchCount;
+  };
+
+  // Block sizes include the header. Up to 128 bytes the size classes are 16 bytes apart, above that every power of two range is split into 4 classes.
+  // The smallest allocation needs 17 bytes, so class 0 is never used, which guarantees that every block can hold a FreeBlock.
+  constexpr ezUInt32 GetBlockSize(ezUInt32 uiSizeClass)
+  {
+    if (uiSizeClass < 8)
+      return (uiSizeClass + 1) * 16;
+
+    const ezUInt32 uiLog = (uiSizeClass - 8) / 4 + 7;
+    const ezUInt32 uiStep = (uiSizeClass - 8) % 4 + 5;
+    return uiStep << (uiLog - 2);
+  }
+
+  static_assert(GetBlockSize(s_uiNumSizeClasses - 1) == ezAllocPolicyThreadCache::MaxSmallSize + s_uiHeaderSize);
+
+  EZ_ALWAYS_INLINE ezUInt32 GetSizeClass(ezUInt32 uiBlockSize)
+  {
+    if (uiBlockSize <= 128)
+      return (uiBlockSize + 15) / 16 - 1;
+
+    const ezUInt32 uiLog = ezMath::FirstBitHigh(uiBlockSize - 1);
+    const ezUInt32 uiStep = (uiBlockSize - 1) >> (uiLog - 2);
+    return 8 + (uiLog - 7) * 4 + (uiStep - 4);
+  }
+
+  /// How many blocks are moved between a thread cache and the central free list at once.
+  constexpr ezUInt32 GetBatchSize(ezUInt32 uiSizeClass)
+  {
+    const ezUInt32 uiCount = 8192 / GetBlockSize(uiSizeClass);
+    return uiCount < 4 ? 4 : (uiCount > 64 ? 64 : uiCount);
+  }
+
+  struct InstanceSlot
+  {
+    ezAtomicInteger64 m_iNumAllocations;
+    ezAtomicInteger64 m_iNumDeallocations;
+    ezAtomicInteger64 m_iAllocationSize;
+    ezUInt32 m_uiGeneration = 0;
+    ezUInt32 m_uiRefCount = 0;
+  };
+
+  struct CentralData
+  {
+    ezAtomicInteger64 m_FreeLists[s_uiNumSizeClasses];
+
+    ezMutex m_Mutex;
+    void* m_pChunks = nullptr; // all chunks stay linked, so that leak checkers still consider the memory reachable
+    InstanceSlot m_Instances[s_uiMaxInstances];
+  };
+
+  static CentralData& GetCentralData()
+  {
+    // never destroyed, thread caches may still be flushed during shutdown
+    alignas(CentralData) static ezUInt8 s_CentralDataBuffer[sizeof(CentralData)];
+    static CentralData* s_pCentralData = new (s_CentralDataBuffer) CentralData();
+    return *s_pCentralData;
+  }
+
+  static void PushBatch(ezUInt32 uiSizeClass, FreeBlock* pBatch)
+  {
+    ezAtomicInteger64& head = GetCentralData().m_FreeLists[uiSizeClass];
+
+    while (true)
+    {
+      const ezUInt64 uiOldHead = (ezUInt64)(ezInt64)head;
+      pBatch->m_pNextBatch = reinterpret_cast<FreeBlock*>(uiOldHead & s_uiPointerMask);
+
+      const ezUInt64 uiNewHead = ((uiOldHead + (1ull << 48)) & ~s_uiPointerMask) | reinterpret_cast<ezUInt64>(pBatch);
+      if (head.TestAndSet((ezInt64)uiOldHead, (ezInt64)uiNewHead))
+        return;
+    }
+  }
+
+  static FreeBlock* PopBatch(ezUInt32 uiSizeClass)
+  {
+    ezAtomicInteger64& head = GetCentralData().m_FreeLists[uiSizeClass];
+
+    while (true)
+    {
+      const ezUInt64 uiOldHead = (ezUInt64)(ezInt64)head;
+      FreeBlock* pBatch = reinterpret_cast<FreeBlock*>(uiOldHead & s_uiPointerMask);
+      if (pBatch == nullptr)
+        return nullptr;
+
+      // chunks are never freed, so even if another thread popped this batch in the meantime, reading from it is safe
+      // and the counter makes the exchange below fail
+      const ezUInt64 uiNewHead = ((uiOldHead + (1ull << 48)) & ~s_uiPointerMask) | reinterpret_cast<ezUInt64>(pBatch->m_pNextBatch);
+      if (head.TestAndSet((ezInt64)uiOldHead, (ezInt64)uiNewHead))
+        return pBatch;
+    }
+  }
+
+  /// Allocates a new chunk for the given size class, returns the first batch and pushes all others to the central free list.
+  static FreeBlock* AllocateChunk(ezUInt32 uiSizeClass)
+  {
+    const ezUInt32 uiBlockSize = GetBlockSize(uiSizeClass);
+    const ezUInt32 uiBatchSize = GetBatchSize(uiSizeClass);
+
+    ezUInt8* pChunk = static_cast<ezUInt8*>(malloc(s_uiChunkSize));
+    EZ_ASSERT_DEV(pChunk != nullptr, "Could not allocate {0} bytes. Out of memory?", s_uiChunkSize);
+
+    {
+      CentralData& data = GetCentralData();
+      EZ_LOCK(data.m_Mutex);
+
+      *reinterpret_cast<void**>(pChunk) = data.m_pChunks;
+      data.m_pChunks = pChunk;
+    }
+
+    ezUInt8* pBlocks = ezMemoryUtils::AlignForwards(pChunk + sizeof(void*), s_uiHeaderSize);
+    const ezUInt32 uiNumBlocks = (ezUInt32)((pChunk + s_uiChunkSize - pBlocks) / uiBlockSize);
+
+    FreeBlock* pFirstBatch = nullptr;
+
+    for (ezUInt32 uiFirst = 0; uiFirst < uiNumBlocks; uiFirst += uiBatchSize)
+    {
+      const ezUInt32 uiCount = ezMath::Min(uiBatchSize, uiNumBlocks - uiFirst);
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(pBlocks + (uiFirst + i) * uiBlockSize);
+        pBlock->m_pNext = (i + 1 < uiCount) ? reinterpret_cast<FreeBlock*>(pBlocks + (uiFirst + i + 1) * uiBlockSize) : nullptr;
+      }
+
+      FreeBlock* pBatch = reinterpret_cast<FreeBlock*>(pBlocks + uiFirst * uiBlockSize);
+      pBatch->m_uiBatchCount = uiCount;
+
+      if (pFirstBatch == nullptr)
+        pFirstBatch = pBatch;
+      else
+        PushBatch(uiSizeClass, pBatch);
+    }
+
+    return pFirstBatch;
+  }
+
+  struct ThreadCache
+  {
+    struct Bin
+    {
+      FreeBlock* m_pHead = nullptr;
+      ezUInt32 m_uiCount = 0;
+    };
+
+    struct PendingStats
+    {
+      ezInt64 m_iNumAllocations = 0;
+      ezInt64 m_iNumDeallocations = 0;
+      ezInt64 m_iAllocationSize = 0;
+      ezUInt32 m_uiGeneration = 0;
+      ezUInt32 m_uiNumOperations = 0;
+    };
+
+    ~ThreadCache()
+    {
+      Flush();
+
+      // static destructors may still free memory after this, those blocks go straight to the central free lists
+      m_bDestroyed = true;
+    }
+
+    FreeBlock* PopBlock(ezUInt32 uiSizeClass)
+    {
+      Bin& bin = m_Bins[uiSizeClass];
+
+      if (bin.m_pHead == nullptr)
+      {
+        FreeBlock* pBatch = PopBatch(uiSizeClass);
+        if (pBatch == nullptr)
+        {
+          pBatch = AllocateChunk(uiSizeClass);
+        }
+
+        if (m_bDestroyed)
+        {
+          if (pBatch->m_pNext != nullptr)
+          {
+            pBatch->m_pNext->m_uiBatchCount = pBatch->m_uiBatchCount - 1;
+            PushBatch(uiSizeClass, pBatch->m_pNext);
+          }
+
+          return pBatch;
+        }
+
+        bin.m_pHead = pBatch;
+        bin.m_uiCount = pBatch->m_uiBatchCount;
+      }
+
+      FreeBlock* pBlock = bin.m_pHead;
+      bin.m_pHead = pBlock->m_pNext;
+      --bin.m_uiCount;
+      return pBlock;
+    }
+
+    void PushBlock(ezUInt32 uiSizeClass, FreeBlock* pBlock)
+    {
+      if (m_bDestroyed)
+      {
+        pBlock->m_pNext = nullptr;
+        pBlock->m_uiBatchCount = 1;
+        PushBatch(uiSizeClass, pBlock);
+        return;
+      }
+
+      Bin& bin = m_Bins[uiSizeClass];
+      pBlock->m_pNext = bin.m_pHead;
+      bin.m_pHead = pBlock;
+      ++bin.m_uiCount;
+
+      const ezUInt32 uiBatchSize = GetBatchSize(uiSizeClass);
+      if (bin.m_uiCount >= 2 * uiBatchSize)
+      {
+        // keep the recently freed blocks at the front, they are most likely still in the cache, and hand back the tail
+        FreeBlock* pLast = bin.m_pHead;
+        for (ezUInt32 i = 1; i < bin.m_uiCount - uiBatchSize; ++i)
+        {
+          pLast = pLast->m_pNext;
+        }
+
+        FreeBlock* pBatch = pLast->m_pNext;
+        pLast->m_pNext = nullptr;
+        pBatch->m_uiBatchCount = uiBatchSize;
+        bin.m_uiCount -= uiBatchSize;
+
+        PushBatch(uiSizeClass, pBatch);
+      }
+    }
+
+    EZ_ALWAYS_INLINE void Count(ezUInt32 uiSlot, ezUInt32 uiGeneration, ezInt64 iNumAllocations, ezInt64 iNumDeallocations, ezInt64 iSize)
+    {
+      PendingStats& stats = m_Stats[uiSlot];
+      if (stats.m_uiGeneration != uiGeneration)
+      {
+        // left over from a previous allocator that used the same slot
+        stats = PendingStats();
+        stats.m_uiGeneration = uiGeneration;
+      }
+
+      stats.m_iNumAllocations += iNumAllocations;
+      stats.m_iNumDeallocations += iNumDeallocations;
+      stats.m_iAllocationSize += iSize;
+
+      if (++stats.m_uiNumOperations >= s_uiStatsPublishInterval || m_bDestroyed)
+      {
+        Publish(stats, GetCentralData().m_Instances[uiSlot]);
+      }
+    }
+
+    static void Publish(PendingStats& ref_stats, InstanceSlot& ref_slot)
+    {
+      ref_slot.m_iNumAllocations.Add(ref_stats.m_iNumAllocations);
+      ref_slot.m_iNumDeallocations.Add(ref_stats.m_iNumDeallocations);
+      ref_slot.m_iAllocationSize.Add(ref_stats.m_iAllocationSize);
+
+      ref_stats.m_iNumAllocations = 0;
+      ref_stats.m_iNumDeallocations = 0;
+      ref_stats.m_iAllocationSize = 0;
+      ref_stats.m_uiNumOperations = 0;
+    }
+
+    void Flush()
+    {
+      for (ezUInt32 uiSizeClass = 0; uiSizeClass < s_uiNumSizeClasses; ++uiSizeClass)
+      {
+        Bin& bin = m_Bins[uiSizeClass];
+        if (bin.m_pHead != nullptr)
+        {
+          bin.m_pHead->m_uiBatchCount = bin.m_uiCount;
+          PushBatch(uiSizeClass, bin.m_pHead);
+
+          bin.m_pHead = nullptr;
+          bin.m_uiCount = 0;
+        }
+      }
+
+      CentralData& data = GetCentralData();
+      EZ_LOCK(data.m_Mutex);
+
+      for (ezUInt32 uiSlot = 0; uiSlot < s_uiMaxInstances; ++uiSlot)
+      {
+        PendingStats& stats = m_Stats[uiSlot];
+        InstanceSlot& slot = data.m_Instances[uiSlot];
+
+        if (stats.m_uiNumOperations > 0 && slot.m_uiRefCount > 0 && stats.m_uiGeneration == slot.m_uiGeneration)
+        {
+          Publish(stats, slot);
+        }
+      }
+    }
+
+    Bin m_Bins[s_uiNumSizeClasses];
+    PendingStats m_Stats[s_uiMaxInstances];
+    ezUInt32 m_uiSampleCountdown = ezAllocPolicyThreadCache::SampleRate;
+    bool m_bDestroyed = false;
+  };
+
+  thread_local ThreadCache tl_ThreadCache;
+
+  // Only used to access tl_ThreadCache. Compilers tend to recompute the address of a thread_local object for every access,
+  // whereas a pointer that was read once stays in a register.
+  thread_local ThreadCache* tl_pThreadCache = nullptr;
+
+  EZ_ALWAYS_INLINE ThreadCache* GetThreadCache()
+  {
+    ThreadCache* pCache = tl_pThreadCache;
+    if (pCache == nullptr)
+    {
+      pCache = &tl_ThreadCache;
+      tl_pThreadCache = pCache;
+    }
+
+    return pCache;
+  }
+} // namespace
+
+ezAllocPolicyThreadCache::ezAllocPolicyThreadCache(ezAllocator* pParent)
+{
+  CentralData& data = GetCentralData();
+  EZ_LOCK(data.m_Mutex);
+
+  // once all slots are taken, the last one is shared by all remaining instances
+  m_uiInstanceSlot = s_uiMaxInstances - 1;
+  for (ezUInt32 i = 0; i < s_uiMaxInstances - 1; ++i)
+  {
+    if (data.m_Instances[i].m_uiRefCount == 0)
+    {
+      m_uiInstanceSlot = i;
+      break;
+    }
+  }
+
+  InstanceSlot& slot = data.m_Instances[m_uiInstanceSlot];
+  if (slot.m_uiRefCount++ == 0)
+  {
+    ++slot.m_uiGeneration;
+    slot.m_iNumAllocations = 0;
+    slot.m_iNumDeallocations = 0;
+    slot.m_iAllocationSize = 0;
+  }
+
+  m_uiInstanceGeneration = slot.m_uiGeneration;
+}
+
+ezAllocPolicyThreadCache::~ezAllocPolicyThreadCache()
+{
+  CentralData& data = GetCentralData();
+  EZ_LOCK(data.m_Mutex);
+
+  --data.m_Instances[m_uiInstanceSlot].m_uiRefCount;
+}
+
+void* ezAllocPolicyThreadCache::Allocate(size_t uiSize, size_t uiAlign)
+{
+  EZ_ASSERT_DEBUG(uiAlign <= s_uiHeaderSize, "This allocator does not guarantee alignments larger than {}. Use an aligned allocator to allocate the desired data type.", s_uiHeaderSize);
+
+  ThreadCache& cache = *GetThreadCache();
+
+  AllocationHeader* pHeader = nullptr;
+  if (uiSize <= MaxSmallSize)
+  {
+    const ezUInt32 uiSizeClass = GetSizeClass((ezUInt32)uiSize + s_uiHeaderSize);
+    pHeader = reinterpret_cast<AllocationHeader*>(cache.PopBlock(uiSizeClass));
+    pHeader->m_uiSizeClass = (ezUInt16)uiSizeClass;
+  }
+  else
+  {
+    pHeader = static_cast<AllocationHeader*>(malloc(uiSize + s_uiHeaderSize));
+    if (pHeader == nullptr)
+      return nullptr;
+
+    pHeader->m_uiSizeClass = s_uiLargeAllocation;
+  }
+
+  pHeader->m_uiSize = uiSize;
+  pHeader->m_uiFlags = 0;
+
+  if (--cache.m_uiSampleCountdown == 0)
+  {
+    cache.m_uiSampleCountdown = SampleRate;
+    pHeader->m_uiFlags |= HeaderFlags::Sampled;
+  }
+
+  cache.Count(m_uiInstanceSlot, m_uiInstanceGeneration, 1, 0, (ezInt64)uiSize);
+
+  void* pPtr = pHeader + 1;
+  EZ_CHECK_ALIGNMENT(pPtr, uiAlign);
+  return pPtr;
+}
+
+void ezAllocPolicyThreadCache::Deallocate(void* pPtr)
+{
+  if (pPtr == nullptr)
+    return;
+
+  AllocationHeader* pHeader = static_cast<AllocationHeader*>(pPtr) - 1;
+  const ezUInt16 uiSizeClass = pHeader->m_uiSizeClass;
+
+  ThreadCache& cache = *GetThreadCache();
+  cache.Count(m_uiInstanceSlot, m_uiInstanceGeneration, 0, 1, -(ezInt64)pHeader->m_uiSize);
+
+  if (uiSizeClass == s_uiLargeAllocation)
+  {
+    free(pHeader);
+  }
+  else
+  {
+    cache.PushBlock(uiSizeClass, reinterpret_cast<FreeBlock*>(pHeader));
+  }
+}
+
+size_t ezAllocPolicyThreadCache::AllocatedSize(const void* pPtr) const
+{
+  return static_cast<size_t>((static_cast<const AllocationHeader*>(pPtr) - 1)->m_uiSize);
+}
+
+bool ezAllocPolicyThreadCache::IsSampledAllocation(const void* pPtr) const
+{
+  return ((static_cast<const AllocationHeader*>(pPtr) - 1)->m_uiFlags & HeaderFlags::Sampled) != 0;
+}
+
+ezAllocator::Stats ezAllocPolicyThreadCache::GetStats() const
+{
+  const InstanceSlot& slot = GetCentralData().m_Instances[m_uiInstanceSlot];
+
+  ezAllocator::Stats stats;
+  stats.m_uiNumAllocations = (ezUInt64)(ezInt64)slot.m_iNumAllocations;
+  stats.m_uiNumDeallocations = (ezUInt64)(ezInt64)slot.m_iNumDeallocations;
+  // counters of different threads are published independently, so the size can temporarily drop below zero
+  stats.m_uiAllocationSize = (ezUInt64)ezMath::Max<ezInt64>((ezInt64)slot.m_iAllocationSize, 0);
+  return stats;
+}
+
+// static
+void ezAllocPolicyThreadCache::FlushThreadCache()
+{
+  GetThreadCache()->Flush();
+}
@@ -17,6 +17,8 @@ namespace ezInternal
     ezAllocator* GetParent() const;
 
   protected:
+    static constexpr bool SampledTracking = ezHasSampledTracking<AllocationPolicy, bool (AllocationPolicy::*)(const void*) const>::value;
+
     AllocationPolicy m_allocator;
 
     ezAllocatorId m_Id;
@@ -68,14 +70,28 @@ void* ezInternal::ezAllocatorImpl<A, TrackingMode>::Allocate(size_t uiSize, size
 
   EZ_ASSERT_DEBUG(ezMath::IsPowerOf2((ezUInt32)uiAlign), "Alignment must be power of two");
 
-  ezTime fAllocationTime = ezTime::Now();
+  ezTime fAllocationTime;
+  if constexpr (TrackingMode >= ezAllocatorTrackingMode::AllocationStats && !SampledTracking)
+  {
+    fAllocationTime = ezTime::Now();
+  }
 
   void* ptr = m_allocator.Allocate(uiSize, uiAlign);
   EZ_ASSERT_DEV(ptr != nullptr, "Could not allocate {0} bytes. Out of memory?", uiSize);
 
   if constexpr (TrackingMode >= ezAllocatorTrackingMode::AllocationStats)
   {
-    ezMemoryTracker::AddAllocation(this->m_Id, TrackingMode, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
+    if constexpr (SampledTracking)
+    {
+      if (m_allocator.IsSampledAllocation(ptr))
+      {
+        ezMemoryTracker::AddAllocation(this->m_Id, TrackingMode, ptr, uiSize, uiAlign, ezTime::MakeZero());
+      }
+    }
+    else
+    {
+      ezMemoryTracker::AddAllocation(this->m_Id, TrackingMode, ptr, uiSize, uiAlign, ezTime::Now() - fAllocationTime);
+    }
   }
 
   return ptr;
@@ -86,7 +102,17 @@ void ezInternal::ezAllocatorImpl<A, TrackingMode>::Deallocate(void* pPtr)
 {
   if constexpr (TrackingMode >= ezAllocatorTrackingMode::AllocationStats)
   {
-    ezMemoryTracker::RemoveAllocation(this->m_Id, pPtr);
+    if constexpr (SampledTracking)
+    {
+      if (m_allocator.IsSampledAllocation(pPtr))
+      {
+        ezMemoryTracker::RemoveAllocation(this->m_Id, pPtr);
+      }
+    }
+    else
+    {
+      ezMemoryTracker::RemoveAllocation(this->m_Id, pPtr);
+    }
   }
 
   m_allocator.Deallocate(pPtr);
@@ -95,7 +121,11 @@ void ezInternal::ezAllocatorImpl<A, TrackingMode>::Deallocate(void* pPtr)
 template <typename A, ezAllocatorTrackingMode TrackingMode>
 size_t ezInternal::ezAllocatorImpl<A, TrackingMode>::AllocatedSize(const void* pPtr)
 {
-  if constexpr (TrackingMode >= ezAllocatorTrackingMode::AllocationStats)
+  if constexpr (SampledTracking)
+  {
+    return m_allocator.AllocatedSize(pPtr);
+  }
+  else if constexpr (TrackingMode >= ezAllocatorTrackingMode::AllocationStats)
   {
     return ezMemoryTracker::GetAllocationInfo(this->m_Id, pPtr).m_uiSize;
   }
@@ -114,7 +144,11 @@ ezAllocatorId ezInternal::ezAllocatorImpl<A, TrackingMode>::GetId() const
 template <typename A, ezAllocatorTrackingMode TrackingMode>
 ezAllocator::Stats ezInternal::ezAllocatorImpl<A, TrackingMode>::GetStats() const
 {
-  if constexpr (TrackingMode >= ezAllocatorTrackingMode::Basics)
+  if constexpr (SampledTracking)
+  {
+    return m_allocator.GetStats();
+  }
+  else if constexpr (TrackingMode >= ezAllocatorTrackingMode::Basics)
   {
     return ezMemoryTracker::GetAllocatorStats(this->m_Id);
   }
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+
+/// \brief Heap allocation policy that serves small allocations from per-thread size class caches.
+///
+/// Allocations of up to MaxSmallSize bytes are rounded up to one of a fixed set of size classes. Every thread keeps a short free list
+/// per size class and only talks to the shared central free lists when its cache runs empty or overflows, in which case a whole batch
+/// of blocks is moved at once. The central free lists are lock-free, only carving new chunks off the system heap takes a mutex.
+/// Larger allocations are forwarded to malloc.
+///
+/// Memory that was handed to a size class is never returned to the system, it is only recycled for the same size class.
+/// All instances of this policy share the same caches, the allocation counters are kept per instance though.
+///
+/// Instead of taking the global lock of ezMemoryTracker for every allocation, the counters are accumulated per thread and published
+/// in batches. Additionally every SampleRate-th allocation of a thread is flagged as sampled and only those are reported to
+/// ezMemoryTracker by ezAllocatorWithPolicy, so stack traces for leaks are still collected, just not for every single allocation.
+/// Alignments of up to 16 bytes are supported.
+///
+/// \see ezAllocatorWithPolicy, ezThreadCacheHeapAllocator
+class EZ_FOUNDATION_DLL ezAllocPolicyThreadCache
+{
+public:
+  ezAllocPolicyThreadCache(ezAllocator* pParent);
+  ~ezAllocPolicyThreadCache();
+
+  void* Allocate(size_t uiSize, size_t uiAlign);
+  void Deallocate(void* pPtr);
+
+  /// \brief Returns the size that was requested for the given allocation.
+  size_t AllocatedSize(const void* pPtr) const;
+
+  /// \brief Returns whether the given allocation was picked to be tracked by ezMemoryTracker.
+  bool IsSampledAllocation(const void* pPtr) const;
+
+  /// \brief Returns the allocation counters of this instance. Counters are published in batches, so the values may lag slightly behind.
+  ezAllocator::Stats GetStats() const;
+
+  EZ_ALWAYS_INLINE ezAllocator* GetParent() const { return nullptr; }
+
+  /// \brief Returns all blocks cached by the calling thread to the central free lists and publishes its pending counters.
+  ///
+  /// This happens automatically when a thread exits, calling it manually is only needed to get exact stats.
+  static void FlushThreadCache();
+
+  /// \brief Allocations larger than this are forwarded to malloc.
+  static constexpr ezUInt32 MaxSmallSize = 2048 - 16;
+
+  /// \brief Every n-th allocation of a thread is reported to ezMemoryTracker.
+  static constexpr ezUInt32 SampleRate = 256;
+
+private:
+  ezUInt32 m_uiInstanceSlot = 0;
+  ezUInt32 m_uiInstanceGeneration = 0;
+};
@@ -0,0 +1,541 @@
+#include <Foundation/FoundationPCH.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#  include <Foundation/IO/FileSystem/Implementation/AsyncFileReadBackend.h>
+
+#  if __has_include(<linux/io_uring.h>)
+
+#    include <Foundation/Containers/Deque.h>
+#    include <Foundation/Logging/Log.h>
+#    include <Foundation/Threading/Thread.h>
+#    include <Foundation/Threading/ThreadUtils.h>
+
+#    include <errno.h>
+#    include <fcntl.h>
+#    include <linux/io_uring.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+
+namespace
+{
+  // liburing is not a dependency, the few syscalls that are needed are issued directly
+  int ezIoUringSetup(unsigned int uiEntries, io_uring_params* pParams)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_setup, uiEntries, pParams));
+  }
+
+  int ezIoUringEnter(int iRingFd, unsigned int uiToSubmit, unsigned int uiMinComplete, unsigned int uiFlags)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_enter, iRingFd, uiToSubmit, uiMinComplete, uiFlags, nullptr, 0));
+  }
+} // namespace
+
+/// \brief Executes reads through an io_uring instance.
+///
+/// Reads are queued and submitted under a mutex, a dedicated thread waits for the completions, re-queues short reads
+/// and finishes the reads once all data has arrived. Reads that can't be submitted to the kernel are executed as blocking reads instead.
+class ezAsyncFileReadBackend_IoUring final : public ezAsyncFileReadBackend
+{
+public:
+  ezAsyncFileReadBackend_IoUring();
+  ~ezAsyncFileReadBackend_IoUring();
+
+  ezResult Initialize();
+
+  virtual void Submit(ezArrayPtr<ezAsyncFileRead* const> reads) override;
+
+private:
+  static constexpr ezUInt32 RingSize = 256;
+
+  // the maximum number of bytes that is read by a single submission, larger reads are split up
+  static constexpr ezUInt64 MaxBytesPerSubmission = 1024 * 1024 * 1024;
+
+  // user data of the NOP that stops the completion thread, all reads use their slot index + 1
+  static constexpr __u64 StopUserData = 0;
+
+  class CompletionThread : public ezThread
+  {
+  public:
+    CompletionThread(ezAsyncFileReadBackend_IoUring* pOwner)
+      : ezThread("io_uring Completions")
+      , m_pOwner(pOwner)
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override { return m_pOwner->ProcessCompletions(); }
+
+    ezAsyncFileReadBackend_IoUring* m_pOwner;
+  };
+
+  struct ReadSlot
+  {
+    ezAsyncFileRead* m_pRead = nullptr;
+    ezUInt8* m_pTarget = nullptr;
+    ezUInt64 m_uiOffset = 0;
+    ezUInt64 m_uiNumBytesToRead = 0;
+    ezUInt64 m_uiNumBytesRead = 0;
+    int m_iFileDescriptor = -1;
+  };
+
+  struct CompletedRead
+  {
+    ezAsyncFileRead* m_pRead = nullptr;
+    ezResult m_Result = EZ_FAILURE;
+    ezUInt64 m_uiNumBytesRead = 0;
+    bool m_bExecuteBlocking = false;
+  };
+
+  void StartRead(ezAsyncFileRead* pRead, ezDynamicArray<CompletedRead>& ref_completed);
+  void HandleCompletion(ezUInt32 uiSlot, int iResult, ezDynamicArray<CompletedRead>& ref_completed);
+  void ReleaseSlot(ezUInt32 uiSlot, ezResult result, ezDynamicArray<CompletedRead>& ref_completed);
+  void QueueEntry(ezUInt8 uiOpcode, __u64 uiUserData, int iFileDescriptor = -1, void* pTarget = nullptr, ezUInt32 uiNumBytes = 0, ezUInt64 uiOffset = 0);
+  void QueueRead(ezUInt32 uiSlot);
+  ezResult SubmitQueuedEntries();
+  void CancelQueuedEntries(ezDynamicArray<CompletedRead>& ref_completed);
+  static void FinishReads(ezArrayPtr<const CompletedRead> reads);
+  ezUInt32 ProcessCompletions();
+
+  ezMutex m_Mutex;
+  CompletionThread m_Thread;
+
+  int m_iRingFd = -1;
+  void* m_pSqRing = nullptr;
+  void* m_pCqRing = nullptr;
+  size_t m_uiSqRingSize = 0;
+  size_t m_uiCqRingSize = 0;
+  io_uring_sqe* m_pSqEntries = nullptr;
+  size_t m_uiSqEntriesSize = 0;
+
+  unsigned int* m_pSqTail = nullptr;
+  unsigned int m_uiSqMask = 0;
+  unsigned int* m_pSqArray = nullptr;
+  unsigned int m_uiNumUnsubmittedEntries = 0;
+  unsigned int m_uiNumEntriesInFlight = 0;
+  bool m_bStopRequested = false;
+
+  unsigned int* m_pCqHead = nullptr;
+  unsigned int* m_pCqTail = nullptr;
+  unsigned int m_uiCqMask = 0;
+  io_uring_cqe* m_pCqEntries = nullptr;
+
+  ezDynamicArray<ReadSlot> m_Slots;
+  ezDynamicArray<ezUInt32> m_FreeSlots;
+  ezDeque<ezAsyncFileRead*> m_WaitingReads;
+};
+
+ezAsyncFileReadBackend_IoUring::ezAsyncFileReadBackend_IoUring()
+  : m_Thread(this)
+{
+}
+
+ezAsyncFileReadBackend_IoUring::~ezAsyncFileReadBackend_IoUring()
+{
+  if (m_Thread.IsRunning())
+  {
+    {
+      EZ_LOCK(m_Mutex);
+      m_bStopRequested = true;
+      QueueEntry(IORING_OP_NOP, StopUserData);
+    }
+
+    // All reads have finished at this point, retry until the stop entry is submitted or the completion thread has returned anyway
+    while (true)
+    {
+      {
+        EZ_LOCK(m_Mutex);
+        if (m_uiNumUnsubmittedEntries == 0 || SubmitQueuedEntries().Succeeded())
+          break;
+      }
+
+      if (!m_Thread.IsRunning())
+        break;
+
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+
+    m_Thread.Join();
+  }
+
+  if (m_pSqEntries != nullptr)
+    munmap(m_pSqEntries, m_uiSqEntriesSize);
+
+  if (m_pCqRing != nullptr && m_pCqRing != m_pSqRing)
+    munmap(m_pCqRing, m_uiCqRingSize);
+
+  if (m_pSqRing != nullptr)
+    munmap(m_pSqRing, m_uiSqRingSize);
+
+  if (m_iRingFd >= 0)
+    close(m_iRingFd);
+}
+
+ezResult ezAsyncFileReadBackend_IoUring::Initialize()
+{
+  io_uring_params params = {};
+  m_iRingFd = ezIoUringSetup(RingSize, &params);
+
+  if (m_iRingFd < 0)
+  {
+    ezLog::Dev("io_uring is not available ({}), asynchronous reads are executed on the file access thread.", ezArgErrno(errno));
+    return EZ_FAILURE;
+  }
+
+  // IORING_OP_READ was introduced together with this feature (Linux 5.6)
+  if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+  {
+    ezLog::Dev("io_uring doesn't support IORING_OP_READ, asynchronous reads are executed on the file access thread.");
+    return EZ_FAILURE;
+  }
+
+  m_uiSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+  m_uiCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+  const bool bSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (bSingleMap)
+  {
+    m_uiSqRingSize = ezMath::Max(m_uiSqRingSize, m_uiCqRingSize);
+  }
+
+  m_pSqRing = mmap(nullptr, m_uiSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_SQ_RING);
+  if (m_pSqRing == MAP_FAILED)
+  {
+    m_pSqRing = nullptr;
+    return EZ_FAILURE;
+  }
+
+  if (bSingleMap)
+  {
+    m_pCqRing = m_pSqRing;
+  }
+  else
+  {
+    m_pCqRing = mmap(nullptr, m_uiCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_CQ_RING);
+    if (m_pCqRing == MAP_FAILED)
+    {
+      m_pCqRing = nullptr;
+      return EZ_FAILURE;
+    }
+  }
+
+  m_uiSqEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+  void* pSqEntries = mmap(nullptr, m_uiSqEntriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_SQES);
+  if (pSqEntries == MAP_FAILED)
+    return EZ_FAILURE;
+
+  m_pSqEntries = static_cast<io_uring_sqe*>(pSqEntries);
+
+  ezUInt8* pSqRing = static_cast<ezUInt8*>(m_pSqRing);
+  m_pSqTail = reinterpret_cast<unsigned int*>(pSqRing + params.sq_off.tail);
+  m_uiSqMask = *reinterpret_cast<unsigned int*>(pSqRing + params.sq_off.ring_mask);
+  m_pSqArray = reinterpret_cast<unsigned int*>(pSqRing + params.sq_off.array);
+
+  ezUInt8* pCqRing = static_cast<ezUInt8*>(m_pCqRing);
+  m_pCqHead = reinterpret_cast<unsigned int*>(pCqRing + params.cq_off.head);
+  m_pCqTail = reinterpret_cast<unsigned int*>(pCqRing + params.cq_off.tail);
+  m_uiCqMask = *reinterpret_cast<unsigned int*>(pCqRing + params.cq_off.ring_mask);
+  m_pCqEntries = reinterpret_cast<io_uring_cqe*>(pCqRing + params.cq_off.cqes);
+
+  // every slot has at most one entry in the submission queue, one entry is reserved for the NOP that stops the completion thread
+  m_Slots.SetCount(params.sq_entries - 1);
+  m_FreeSlots.Reserve(m_Slots.GetCount());
+  for (ezUInt32 i = m_Slots.GetCount(); i > 0; --i)
+  {
+    m_FreeSlots.PushBack(i - 1);
+  }
+
+  m_Thread.Start();
+  return EZ_SUCCESS;
+}
+
+void ezAsyncFileReadBackend_IoUring::Submit(ezArrayPtr<ezAsyncFileRead* const> reads)
+{
+  ezHybridArray<CompletedRead, 8> completed;
+
+  {
+    EZ_LOCK(m_Mutex);
+
+    for (ezAsyncFileRead* pRead : reads)
+    {
+      if (m_FreeSlots.IsEmpty())
+      {
+        m_WaitingReads.PushBack(pRead);
+      }
+      else
+      {
+        StartRead(pRead, completed);
+      }
+    }
+
+    if (SubmitQueuedEntries().Failed())
+    {
+      CancelQueuedEntries(completed);
+    }
+  }
+
+  // reads that failed right away (or have nothing to read) are finished outside of the lock, since the callbacks may issue new reads
+  FinishReads(completed);
+}
+
+void ezAsyncFileReadBackend_IoUring::StartRead(ezAsyncFileRead* pRead, ezDynamicArray<CompletedRead>& ref_completed)
+{
+  ezStringBuilder sPath = GetOSFile(*pRead);
+  const int iFileDescriptor = open(sPath.GetData(), O_RDONLY | O_CLOEXEC);
+
+  struct stat fileStats;
+  if (iFileDescriptor < 0 || fstat(iFileDescriptor, &fileStats) != 0)
+  {
+    if (iFileDescriptor >= 0)
+      close(iFileDescriptor);
+
+    ref_completed.PushBack({pRead, EZ_FAILURE, 0});
+    return;
+  }
+
+  ezUInt8* pTarget = PrepareTarget(*pRead, static_cast<ezUInt64>(fileStats.st_size));
+
+  if (GetNumBytesToRead(*pRead) == 0)
+  {
+    close(iFileDescriptor);
+    ref_completed.PushBack({pRead, EZ_SUCCESS, 0});
+    return;
+  }
+
+  const ezUInt32 uiSlot = m_FreeSlots.PeekBack();
+  m_FreeSlots.PopBack();
+
+  ReadSlot& slot = m_Slots[uiSlot];
+  slot.m_pRead = pRead;
+  slot.m_pTarget = pTarget;
+  slot.m_uiOffset = GetOffset(*pRead);
+  slot.m_uiNumBytesToRead = GetNumBytesToRead(*pRead);
+  slot.m_uiNumBytesRead = 0;
+  slot.m_iFileDescriptor = iFileDescriptor;
+
+  QueueRead(uiSlot);
+}
+
+void ezAsyncFileReadBackend_IoUring::HandleCompletion(ezUInt32 uiSlot, int iResult, ezDynamicArray<CompletedRead>& ref_completed)
+{
+  ReadSlot& slot = m_Slots[uiSlot];
+
+  if (iResult == -EAGAIN || iResult == -EINTR)
+  {
+    QueueRead(uiSlot);
+    return;
+  }
+
+  if (iResult < 0)
+  {
+    ReleaseSlot(uiSlot, EZ_FAILURE, ref_completed);
+    return;
+  }
+
+  slot.m_uiNumBytesRead += static_cast<ezUInt64>(iResult);
+
+  // a short read only means that the remaining data has to be requested again, zero bytes means the file has shrunk in between
+  if (iResult > 0 && slot.m_uiNumBytesRead < slot.m_uiNumBytesToRead)
+  {
+    QueueRead(uiSlot);
+    return;
+  }
+
+  ReleaseSlot(uiSlot, EZ_SUCCESS, ref_completed);
+}
+
+void ezAsyncFileReadBackend_IoUring::ReleaseSlot(ezUInt32 uiSlot, ezResult result, ezDynamicArray<CompletedRead>& ref_completed)
+{
+  ReadSlot& slot = m_Slots[uiSlot];
+
+  close(slot.m_iFileDescriptor);
+  ref_completed.PushBack({slot.m_pRead, result, slot.m_uiNumBytesRead});
+
+  slot = ReadSlot();
+  m_FreeSlots.PushBack(uiSlot);
+}
+
+void ezAsyncFileReadBackend_IoUring::QueueEntry(ezUInt8 uiOpcode, __u64 uiUserData, int iFileDescriptor, void* pTarget, ezUInt32 uiNumBytes, ezUInt64 uiOffset)
+{
+  // the tail is only written while the mutex is held, the kernel advances the head while consuming entries
+  const unsigned int uiTail = *m_pSqTail;
+  const unsigned int uiIndex = uiTail & m_uiSqMask;
+
+  io_uring_sqe& entry = m_pSqEntries[uiIndex];
+  ezMemoryUtils::ZeroFill(&entry, 1);
+  entry.opcode = uiOpcode;
+  entry.fd = iFileDescriptor;
+  entry.addr = reinterpret_cast<__u64>(pTarget);
+  entry.len = uiNumBytes;
+  entry.off = uiOffset;
+  entry.user_data = uiUserData;
+
+  m_pSqArray[uiIndex] = uiIndex;
+  __atomic_store_n(m_pSqTail, uiTail + 1, __ATOMIC_RELEASE);
+
+  ++m_uiNumUnsubmittedEntries;
+}
+
+void ezAsyncFileReadBackend_IoUring::QueueRead(ezUInt32 uiSlot)
+{
+  const ReadSlot& slot = m_Slots[uiSlot];
+  const ezUInt64 uiNumBytes = ezMath::Min(slot.m_uiNumBytesToRead - slot.m_uiNumBytesRead, MaxBytesPerSubmission);
+
+  QueueEntry(IORING_OP_READ, uiSlot + 1, slot.m_iFileDescriptor, slot.m_pTarget + slot.m_uiNumBytesRead, static_cast<ezUInt32>(uiNumBytes), slot.m_uiOffset + slot.m_uiNumBytesRead);
+}
+
+ezResult ezAsyncFileReadBackend_IoUring::SubmitQueuedEntries()
+{
+  while (m_uiNumUnsubmittedEntries > 0)
+  {
+    const int iSubmitted = ezIoUringEnter(m_iRingFd, m_uiNumUnsubmittedEntries, 0, 0);
+
+    if (iSubmitted < 0)
+    {
+      if (errno == EINTR)
+        continue;
+
+      // The kernel is out of resources or the completion queue is full. Both resolve once completions are reaped,
+      // so the completion thread submits the remaining entries after the next completion has arrived.
+      if ((errno == EAGAIN || errno == EBUSY) && m_uiNumEntriesInFlight > 0)
+        return EZ_SUCCESS;
+
+      ezLog::Warning("io_uring_enter failed: {}", ezArgErrno(errno));
+      return EZ_FAILURE;
+    }
+
+    m_uiNumUnsubmittedEntries -= static_cast<unsigned int>(iSubmitted);
+    m_uiNumEntriesInFlight += static_cast<unsigned int>(iSubmitted);
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezAsyncFileReadBackend_IoUring::CancelQueuedEntries(ezDynamicArray<CompletedRead>& ref_completed)
+{
+  // The kernel only consumes entries during io_uring_enter, which is only called with entries to submit while the mutex is held.
+  // Thus the unsubmitted entries can be taken back by moving the tail.
+  unsigned int uiTail = *m_pSqTail;
+
+  for (; m_uiNumUnsubmittedEntries > 0; --m_uiNumUnsubmittedEntries)
+  {
+    --uiTail;
+
+    // the completion thread notices the stop request by itself, once everything in flight has completed
+    const __u64 uiUserData = m_pSqEntries[uiTail & m_uiSqMask].user_data;
+    if (uiUserData == StopUserData)
+      continue;
+
+    ReleaseSlot(static_cast<ezUInt32>(uiUserData - 1), EZ_FAILURE, ref_completed);
+    ref_completed.PeekBack().m_bExecuteBlocking = true;
+  }
+
+  __atomic_store_n(m_pSqTail, uiTail, __ATOMIC_RELEASE);
+}
+
+void ezAsyncFileReadBackend_IoUring::FinishReads(ezArrayPtr<const CompletedRead> reads)
+{
+  for (const CompletedRead& read : reads)
+  {
+    if (read.m_bExecuteBlocking)
+    {
+      ExecuteBlockingRead(*read.m_pRead);
+    }
+    else
+    {
+      FinishRead(*read.m_pRead, read.m_Result, read.m_uiNumBytesRead);
+    }
+  }
+}
+
+ezUInt32 ezAsyncFileReadBackend_IoUring::ProcessCompletions()
+{
+  ezHybridArray<CompletedRead, 32> completed;
+  bool bPoll = false;
+
+  while (true)
+  {
+    if (bPoll)
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+    else if (ezIoUringEnter(m_iRingFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+    {
+      // the kernel still executes the reads that are in flight, so their completions are picked up by polling the completion queue instead
+      ezLog::Error("Waiting for io_uring completions failed: {}", ezArgErrno(errno));
+      bPoll = true;
+    }
+
+    bool bStop = false;
+
+    {
+      EZ_LOCK(m_Mutex);
+
+      unsigned int uiHead = *m_pCqHead;
+      const unsigned int uiTail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+
+      for (; uiHead != uiTail; ++uiHead)
+      {
+        const io_uring_cqe& entry = m_pCqEntries[uiHead & m_uiCqMask];
+        --m_uiNumEntriesInFlight;
+
+        if (entry.user_data == StopUserData)
+        {
+          bStop = true;
+          continue;
+        }
+
+        HandleCompletion(static_cast<ezUInt32>(entry.user_data - 1), entry.res, completed);
+      }
+
+      __atomic_store_n(m_pCqHead, uiHead, __ATOMIC_RELEASE);
+
+      while (!m_WaitingReads.IsEmpty() && !m_FreeSlots.IsEmpty())
+      {
+        ezAsyncFileRead* pRead = m_WaitingReads.PeekFront();
+        m_WaitingReads.PopFront();
+
+        StartRead(pRead, completed);
+      }
+
+      if (SubmitQueuedEntries().Failed())
+      {
+        CancelQueuedEntries(completed);
+      }
+
+      // the stop entry never arrives if it couldn't be submitted
+      if (m_bStopRequested && m_uiNumEntriesInFlight == 0 && m_uiNumUnsubmittedEntries == 0)
+      {
+        bStop = true;
+      }
+    }
+
+    FinishReads(completed);
+    completed.Clear();
+
+    if (bStop)
+      return 0;
+  }
+}
+
+ezUniquePtr<ezAsyncFileReadBackend> ezCreateNativeAsyncFileReadBackend()
+{
+  ezUniquePtr<ezAsyncFileReadBackend_IoUring> pBackend = EZ_DEFAULT_NEW(ezAsyncFileReadBackend_IoUring);
+
+  if (pBackend->Initialize().Failed())
+    return nullptr;
+
+  return pBackend;
+}
+
+#  else
+
+ezUniquePtr<ezAsyncFileReadBackend> ezCreateNativeAsyncFileReadBackend()
+{
+  return nullptr;
+}
+
+#  endif
+#endif
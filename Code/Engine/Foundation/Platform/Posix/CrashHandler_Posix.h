@@ -17,6 +17,8 @@ static void PrintHelper(const char* szString)
 
 static void ezCrashHandlerFunc() noexcept
 {
+  ezGlobalLog::FlushAsyncLogAfterCrash();
+
   if (ezCrashHandler::GetCrashHandler() != nullptr)
   {
     ezCrashHandler::GetCrashHandler()->HandleCrash(nullptr);
@@ -55,6 +57,8 @@ static void ezSignalHandler(int signum)
       break;
   }
 
+  ezGlobalLog::FlushAsyncLogAfterCrash();
+
   if (ezCrashHandler::GetCrashHandler() != nullptr)
   {
     ezCrashHandler::GetCrashHandler()->HandleCrash(nullptr);
@@ -1,16 +1,25 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Application/Application.h>
 #include <Foundation/Communication/DataTransfer.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/JSONWriter.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
+#include <atomic>
+
 #if EZ_ENABLED(EZ_USE_PROFILING)
 
 class ezProfileCaptureDataTransfer : public ezDataTransfer
@@ -60,6 +69,7 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
   }
   ON_CORESYSTEMS_SHUTDOWN
   {
+    ezProfilingSystem::StopStreamingCapture();
     s_ProfileCaptureDataTransfer.DisableDataTransfer();
     ezPlugin::Events().RemoveEventHandler(s_PluginEventSubscription);
     ezProfilingSystem::Reset();
@@ -133,6 +143,520 @@ namespace
   static ezDynamicArray<ezUniquePtr<GPUScopesBuffer>> s_GPUScopes;
 } // namespace
 
+//////////////////////////////////////////////////////////////////////////
+// Streaming capture
+//
+// File layout: magic, version and process ID, followed by chunks that start with a StreamChunkType:
+//  Names:      ezUInt32 count, then per name its ezUInt32 ID and the string
+//  ThreadInfo: ezUInt64 thread ID and the thread name
+//  Events:     ezUInt64 thread ID, ezUInt32 byte count and that many bytes of records
+//  End:        no payload
+//
+// The event chunks of one thread form one continuous stream of records. Names are referenced by ID (0 means no name), times are stored
+// in nanoseconds as variable length deltas to the previous time of the same thread, durations as variable length values. Every name is
+// written before the first chunk that references it.
+
+namespace
+{
+  constexpr ezUInt32 STREAM_FILE_MAGIC = 0x4650455A; // 'EZPF'
+  constexpr ezUInt8 STREAM_FILE_VERSION = 1;
+
+  enum class StreamChunkType : ezUInt8
+  {
+    Names = 1,
+    ThreadInfo = 2,
+    Events = 3,
+    End = 4,
+  };
+
+  enum class StreamRecordType : ezUInt8
+  {
+    CPUScope = 1,
+    Frame = 2,
+    GPUScope = 3,
+  };
+
+  enum
+  {
+    STREAM_BUFFER_SIZE_OTHER_THREAD = 1024 * 1024,
+    STREAM_BUFFER_SIZE_MAIN_THREAD = STREAM_BUFFER_SIZE_OTHER_THREAD * 4,
+    STREAM_NAME_CACHE_SIZE = 256,
+    STREAM_MAX_RECORD_SIZE = 48,
+  };
+
+  EZ_ALWAYS_INLINE ezUInt8* WriteVarUInt(ezUInt8* pDst, ezUInt64 uiValue)
+  {
+    while (uiValue >= 0x80)
+    {
+      *pDst++ = static_cast<ezUInt8>(uiValue | 0x80);
+      uiValue >>= 7;
+    }
+
+    *pDst++ = static_cast<ezUInt8>(uiValue);
+    return pDst;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt8* WriteVarInt(ezUInt8* pDst, ezInt64 iValue)
+  {
+    // zig-zag encoding, so that small negative deltas are small as well
+    return WriteVarUInt(pDst, (static_cast<ezUInt64>(iValue) << 1) ^ static_cast<ezUInt64>(iValue >> 63));
+  }
+
+  bool ReadVarUInt(const ezUInt8*& ref_pSrc, const ezUInt8* pEnd, ezUInt64& out_uiValue)
+  {
+    out_uiValue = 0;
+
+    for (ezUInt32 uiShift = 0; ref_pSrc < pEnd && uiShift < 64; uiShift += 7)
+    {
+      const ezUInt8 uiByte = *ref_pSrc++;
+      out_uiValue |= static_cast<ezUInt64>(uiByte & 0x7F) << uiShift;
+
+      if ((uiByte & 0x80) == 0)
+        return true;
+    }
+
+    return false;
+  }
+
+  bool ReadVarInt(const ezUInt8*& ref_pSrc, const ezUInt8* pEnd, ezInt64& out_iValue)
+  {
+    ezUInt64 uiValue = 0;
+    if (!ReadVarUInt(ref_pSrc, pEnd, uiValue))
+      return false;
+
+    out_iValue = static_cast<ezInt64>(uiValue >> 1) ^ -static_cast<ezInt64>(uiValue & 1);
+    return true;
+  }
+
+  /// Byte ring buffer with a single producer, the thread that owns it, and a single consumer, the stream thread.
+  /// The buffer object lives as long as its thread, the ring buffer data only while a streaming capture is active.
+  struct StreamBuffer
+  {
+    StreamBuffer(ezUInt64 uiThreadId, ezUInt32 uiCapacity)
+      : m_uiThreadId(uiThreadId)
+      , m_uiMask(uiCapacity - 1)
+    {
+      EZ_ASSERT_DEBUG(ezMath::IsPowerOf2(uiCapacity), "Capacity must be a power of two");
+    }
+
+    /// Called by the owning thread when it writes the first record of a new capture.
+    void Begin()
+    {
+      m_Data.SetCountUninitialized(static_cast<ezUInt32>(m_uiMask + 1));
+
+      m_uiWritePos.store(0, std::memory_order_relaxed);
+      m_uiReadPos.store(0, std::memory_order_relaxed);
+      m_uiDroppedRecords.store(0, std::memory_order_relaxed);
+      m_uiCachedReadPos = 0;
+      m_iPrevTime = 0;
+
+      // the name IDs are only valid within one capture
+      for (NameCacheEntry& entry : m_NameCache)
+      {
+        entry = NameCacheEntry();
+      }
+    }
+
+    void FreeData()
+    {
+      m_Data.Clear();
+      m_Data.Compact();
+    }
+
+    bool Write(const ezUInt8* pRecord, ezUInt32 uiSize)
+    {
+      const ezUInt64 uiWritePos = m_uiWritePos.load(std::memory_order_relaxed);
+      const ezUInt64 uiCapacity = m_uiMask + 1;
+
+      if (uiWritePos + uiSize - m_uiCachedReadPos > uiCapacity)
+      {
+        m_uiCachedReadPos = m_uiReadPos.load(std::memory_order_acquire);
+
+        if (uiWritePos + uiSize - m_uiCachedReadPos > uiCapacity)
+        {
+          m_uiDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+      }
+
+      const ezUInt32 uiOffset = static_cast<ezUInt32>(uiWritePos & m_uiMask);
+      const ezUInt32 uiFirstPart = ezMath::Min(uiSize, static_cast<ezUInt32>(uiCapacity - uiOffset));
+      ezMemoryUtils::Copy(m_Data.GetData() + uiOffset, pRecord, uiFirstPart);
+      ezMemoryUtils::Copy(m_Data.GetData(), pRecord + uiFirstPart, uiSize - uiFirstPart);
+
+      m_uiWritePos.store(uiWritePos + uiSize, std::memory_order_release);
+      return true;
+    }
+
+    EZ_ALWAYS_INLINE ezUInt32 FindCachedName(ezUInt64 uiKey) const
+    {
+      const ezUInt32 uiSlot = static_cast<ezUInt32>(uiKey ^ (uiKey >> 16)) & (STREAM_NAME_CACHE_SIZE - 1);
+
+      for (ezUInt32 i = 0; i < 4; ++i)
+      {
+        const NameCacheEntry& entry = m_NameCache[(uiSlot + i) & (STREAM_NAME_CACHE_SIZE - 1)];
+        if (entry.m_uiKey == uiKey)
+          return entry.m_uiId;
+      }
+
+      return 0;
+    }
+
+    void AddCachedName(ezUInt64 uiKey, ezUInt32 uiId)
+    {
+      const ezUInt32 uiSlot = static_cast<ezUInt32>(uiKey ^ (uiKey >> 16)) & (STREAM_NAME_CACHE_SIZE - 1);
+
+      for (ezUInt32 i = 0; i < 4; ++i)
+      {
+        NameCacheEntry& entry = m_NameCache[(uiSlot + i) & (STREAM_NAME_CACHE_SIZE - 1)];
+        if (entry.m_uiId == 0)
+        {
+          entry.m_uiKey = uiKey;
+          entry.m_uiId = uiId;
+          return;
+        }
+      }
+
+      // all candidates are taken, evict the first one
+      m_NameCache[uiSlot].m_uiKey = uiKey;
+      m_NameCache[uiSlot].m_uiId = uiId;
+    }
+
+    const ezUInt64 m_uiThreadId;
+    const ezUInt64 m_uiMask;
+    ezDynamicArray<ezUInt8> m_Data;
+
+    std::atomic<ezUInt64> m_uiWritePos = 0;
+    std::atomic<ezUInt64> m_uiReadPos = 0;
+    std::atomic<ezUInt32> m_uiDroppedRecords = 0;
+    std::atomic<bool> m_bWriting = false; // set by the owning thread while it accesses the data
+
+    // only accessed by the owning thread
+    ezUInt64 m_uiCachedReadPos = 0;
+    ezInt64 m_iPrevTime = 0;
+
+    struct NameCacheEntry
+    {
+      ezUInt64 m_uiKey = 0;
+      ezUInt32 m_uiId = 0;
+    };
+
+    NameCacheEntry m_NameCache[STREAM_NAME_CACHE_SIZE];
+  };
+
+  static std::atomic<ezUInt32> s_uiStreamSession = 0; // 0 while no streaming capture is active
+  static ezUInt32 s_uiLastStreamSession = 0;
+  static thread_local StreamBuffer* s_pStreamBuffer = nullptr;
+  static thread_local ezUInt32 s_uiStreamBufferSession = 0;
+
+  static ezMutex s_StreamMutex; // protects the buffers and names below
+  static ezDynamicArray<StreamBuffer*> s_AllStreamBuffers;
+  static ezDynamicArray<StreamBuffer*> s_StreamBuffers; // the buffers that are used by the active capture
+  static ezHashTable<ezUInt64, ezUInt32> s_StreamNameIds;
+  static ezDynamicArray<ezString> s_StreamNames; // indexed by ID - 1
+
+  /// Returns the buffer of the current thread and marks it as being written, so that StopStreamingCapture() doesn't free its data in the meantime.
+  /// Every buffer that is returned has to be passed to ReleaseStreamBuffer() afterwards.
+  EZ_ALWAYS_INLINE StreamBuffer* AcquireStreamBuffer()
+  {
+    const ezUInt32 uiSession = s_uiStreamSession.load(std::memory_order_acquire);
+    if (uiSession == 0)
+      return nullptr;
+
+    StreamBuffer* pBuffer = s_pStreamBuffer;
+    if (pBuffer == nullptr)
+    {
+      const ezUInt64 uiThreadId = (ezUInt64)ezThreadUtils::GetCurrentThreadID();
+      pBuffer = EZ_DEFAULT_NEW(StreamBuffer, uiThreadId, ezThreadUtils::IsMainThread() ? STREAM_BUFFER_SIZE_MAIN_THREAD : STREAM_BUFFER_SIZE_OTHER_THREAD);
+
+      EZ_LOCK(s_StreamMutex);
+      s_AllStreamBuffers.PushBack(pBuffer);
+      s_pStreamBuffer = pBuffer;
+    }
+
+    // StopStreamingCapture() first resets the session and then waits for the flag,
+    // so either the stop is seen here or the stop waits until the buffer is released
+    pBuffer->m_bWriting.store(true);
+
+    if (s_uiStreamSession.load() != uiSession)
+    {
+      pBuffer->m_bWriting.store(false, std::memory_order_release);
+      return nullptr;
+    }
+
+    if (s_uiStreamBufferSession != uiSession)
+    {
+      pBuffer->Begin();
+
+      EZ_LOCK(s_StreamMutex);
+      s_StreamBuffers.PushBack(pBuffer);
+      s_uiStreamBufferSession = uiSession;
+    }
+
+    return pBuffer;
+  }
+
+  EZ_ALWAYS_INLINE void ReleaseStreamBuffer(StreamBuffer* pBuffer)
+  {
+    pBuffer->m_bWriting.store(false, std::memory_order_release);
+  }
+
+  ezUInt32 RegisterStreamName(ezStringView sName)
+  {
+    const ezUInt64 uiHash = ezHashingUtils::xxHash64String(sName);
+
+    EZ_LOCK(s_StreamMutex);
+
+    ezUInt32 uiId = 0;
+    if (!s_StreamNameIds.TryGetValue(uiHash, uiId))
+    {
+      s_StreamNames.PushBack(sName);
+      uiId = s_StreamNames.GetCount();
+      s_StreamNameIds.Insert(uiHash, uiId);
+    }
+
+    return uiId;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 GetStreamNameId(StreamBuffer& ref_buffer, ezStringView sName)
+  {
+    // names are often built on the stack, so they are identified by their content
+    const ezUInt64 uiKey = ezMath::Max<ezUInt64>(ezHashingUtils::xxHash64String(sName), 1);
+
+    ezUInt32 uiId = ref_buffer.FindCachedName(uiKey);
+    if (uiId == 0)
+    {
+      uiId = RegisterStreamName(sName);
+      ref_buffer.AddCachedName(uiKey, uiId);
+    }
+
+    return uiId;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 GetStreamFunctionNameId(StreamBuffer& ref_buffer, const char* szFunctionName)
+  {
+    if (szFunctionName == nullptr)
+      return 0;
+
+    // function names are string literals, so the pointer is enough to identify them
+    const ezUInt64 uiKey = reinterpret_cast<ezUInt64>(szFunctionName);
+
+    ezUInt32 uiId = ref_buffer.FindCachedName(uiKey);
+    if (uiId == 0)
+    {
+      uiId = RegisterStreamName(szFunctionName);
+      ref_buffer.AddCachedName(uiKey, uiId);
+    }
+
+    return uiId;
+  }
+
+  EZ_ALWAYS_INLINE void StreamScope(StreamRecordType type, ezUInt32 uiGpuIndex, ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime)
+  {
+    StreamBuffer* pBuffer = AcquireStreamBuffer();
+    if (pBuffer == nullptr)
+      return;
+
+    const ezInt64 iBeginTime = static_cast<ezInt64>(beginTime.GetNanoseconds());
+    const ezInt64 iDuration = ezMath::Max<ezInt64>(static_cast<ezInt64>((endTime - beginTime).GetNanoseconds()), 0);
+
+    ezUInt8 record[STREAM_MAX_RECORD_SIZE];
+    ezUInt8* pCur = record;
+    *pCur++ = static_cast<ezUInt8>(type);
+
+    if (type == StreamRecordType::GPUScope)
+    {
+      pCur = WriteVarUInt(pCur, uiGpuIndex);
+    }
+
+    pCur = WriteVarUInt(pCur, GetStreamNameId(*pBuffer, sName));
+
+    if (type == StreamRecordType::CPUScope)
+    {
+      pCur = WriteVarUInt(pCur, GetStreamFunctionNameId(*pBuffer, szFunctionName));
+    }
+
+    pCur = WriteVarInt(pCur, iBeginTime - pBuffer->m_iPrevTime);
+    pCur = WriteVarUInt(pCur, static_cast<ezUInt64>(iDuration));
+
+    // the delta base only advances if the record has actually been written
+    if (pBuffer->Write(record, static_cast<ezUInt32>(pCur - record)))
+    {
+      pBuffer->m_iPrevTime = iBeginTime;
+    }
+
+    ReleaseStreamBuffer(pBuffer);
+  }
+
+  void StreamFrameStart(ezTime time)
+  {
+    StreamBuffer* pBuffer = AcquireStreamBuffer();
+    if (pBuffer == nullptr)
+      return;
+
+    const ezInt64 iTime = static_cast<ezInt64>(time.GetNanoseconds());
+
+    ezUInt8 record[STREAM_MAX_RECORD_SIZE];
+    ezUInt8* pCur = record;
+    *pCur++ = static_cast<ezUInt8>(StreamRecordType::Frame);
+    pCur = WriteVarInt(pCur, iTime - pBuffer->m_iPrevTime);
+
+    if (pBuffer->Write(record, static_cast<ezUInt32>(pCur - record)))
+    {
+      pBuffer->m_iPrevTime = iTime;
+    }
+
+    ReleaseStreamBuffer(pBuffer);
+  }
+
+  class StreamThread : public ezThread
+  {
+  public:
+    StreamThread()
+      : ezThread("Profiling Stream")
+    {
+    }
+
+    ezFileWriter m_File;
+    ezThreadSignal m_Signal;
+    ezAtomicBool m_bStop;
+    bool m_bWriteError = false;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        m_Signal.WaitForSignal(ezTime::MakeFromMilliseconds(50));
+        WriteNewData();
+      }
+
+      WriteNewData();
+
+      m_File << static_cast<ezUInt8>(StreamChunkType::End);
+      CheckResult(m_File.Flush());
+      return 0;
+    }
+
+    void CheckResult(ezResult res)
+    {
+      m_bWriteError |= res.Failed();
+    }
+
+    void WriteNewData()
+    {
+      // The fill state of the buffers has to be taken before the names are written,
+      // so that all names which are referenced by the written records are known.
+      {
+        EZ_LOCK(s_StreamMutex);
+        m_Buffers = s_StreamBuffers;
+      }
+
+      m_WritePositions.SetCountUninitialized(m_Buffers.GetCount());
+      for (ezUInt32 i = 0; i < m_Buffers.GetCount(); ++i)
+      {
+        m_WritePositions[i] = m_Buffers[i]->m_uiWritePos.load(std::memory_order_acquire);
+      }
+
+      WriteNewNames();
+      WriteNewThreadInfos();
+
+      for (ezUInt32 i = 0; i < m_Buffers.GetCount(); ++i)
+      {
+        WriteEvents(*m_Buffers[i], m_WritePositions[i]);
+      }
+
+      CheckResult(m_File.Flush());
+    }
+
+    void WriteNewNames()
+    {
+      {
+        EZ_LOCK(s_StreamMutex);
+
+        m_NewNames.Clear();
+        for (ezUInt32 i = m_uiNumWrittenNames; i < s_StreamNames.GetCount(); ++i)
+        {
+          m_NewNames.PushBack(s_StreamNames[i]);
+        }
+      }
+
+      if (m_NewNames.IsEmpty())
+        return;
+
+      m_File << static_cast<ezUInt8>(StreamChunkType::Names);
+      m_File << m_NewNames.GetCount();
+
+      for (const ezString& sName : m_NewNames)
+      {
+        m_File << ++m_uiNumWrittenNames;
+        m_File << sName;
+      }
+    }
+
+    void WriteNewThreadInfos()
+    {
+      EZ_LOCK(s_ThreadInfosMutex);
+
+      for (const ezProfilingSystem::ThreadInfo& info : s_ThreadInfos)
+      {
+        if (m_WrittenThreadIds.Insert(info.m_uiThreadId))
+          continue;
+
+        m_File << static_cast<ezUInt8>(StreamChunkType::ThreadInfo);
+        m_File << info.m_uiThreadId;
+        m_File << info.m_sName;
+      }
+    }
+
+    void WriteEvents(StreamBuffer& ref_buffer, ezUInt64 uiWritePos)
+    {
+      const ezUInt64 uiReadPos = ref_buffer.m_uiReadPos.load(std::memory_order_relaxed);
+      if (uiWritePos == uiReadPos)
+        return;
+
+      const ezUInt32 uiSize = static_cast<ezUInt32>(uiWritePos - uiReadPos);
+      const ezUInt32 uiOffset = static_cast<ezUInt32>(uiReadPos & ref_buffer.m_uiMask);
+      const ezUInt32 uiFirstPart = ezMath::Min(uiSize, static_cast<ezUInt32>(ref_buffer.m_Data.GetCount() - uiOffset));
+
+      m_File << static_cast<ezUInt8>(StreamChunkType::Events);
+      m_File << ref_buffer.m_uiThreadId;
+      m_File << uiSize;
+      CheckResult(m_File.WriteBytes(ref_buffer.m_Data.GetData() + uiOffset, uiFirstPart));
+      CheckResult(m_File.WriteBytes(ref_buffer.m_Data.GetData(), uiSize - uiFirstPart));
+
+      ref_buffer.m_uiReadPos.store(uiWritePos, std::memory_order_release);
+    }
+
+    ezDynamicArray<StreamBuffer*> m_Buffers;
+    ezDynamicArray<ezUInt64> m_WritePositions;
+    ezDynamicArray<ezString> m_NewNames;
+    ezHashSet<ezUInt64> m_WrittenThreadIds;
+    ezUInt32 m_uiNumWrittenNames = 0;
+  };
+
+  static ezUniquePtr<StreamThread> s_pStreamThread;
+
+  /// Waits until no thread is writing to its stream buffer anymore. The session must have been reset before.
+  void WaitForStreamWriters()
+  {
+    ezDynamicArray<StreamBuffer*> buffers;
+    {
+      EZ_LOCK(s_StreamMutex);
+      buffers = s_AllStreamBuffers;
+    }
+
+    // not done while holding the mutex, since writers may need it to register new names
+    for (StreamBuffer* pBuffer : buffers)
+    {
+      while (pBuffer->m_bWriting.load(std::memory_order_acquire))
+      {
+        ezThreadUtils::YieldTimeSlice();
+      }
+    }
+  }
+} // namespace
+
 void ezProfilingSystem::ProfilingData::Clear()
 {
   m_uiFramesThreadID = 0;
@@ -540,6 +1064,181 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& ref_outputStrea
   return writer.HadWriteError() ? EZ_FAILURE : EZ_SUCCESS;
 }
 
+ezResult ezProfilingSystem::ProfilingData::ReadStreamingCapture(ezStreamReader& inout_stream)
+{
+  Clear();
+
+  ezUInt32 uiMagic = 0;
+  ezUInt8 uiVersion = 0;
+  ezUInt64 uiProcessID = 0;
+  inout_stream >> uiMagic;
+  inout_stream >> uiVersion;
+  inout_stream >> uiProcessID;
+
+  if (uiMagic != STREAM_FILE_MAGIC || uiVersion != STREAM_FILE_VERSION)
+  {
+    ezLog::Error("Not a streaming profiling capture or unsupported version {}.", uiVersion);
+    return EZ_FAILURE;
+  }
+
+  m_uiProcessID = static_cast<ezOsProcessID>(uiProcessID);
+
+  // the function names are referenced by pointer, hashed strings stay alive until shutdown
+  ezDynamicArray<ezHashedString> names;
+
+  struct ThreadState
+  {
+    ezUInt32 m_uiEventBufferIndex = 0;
+    ezInt64 m_iPrevTime = 0;
+  };
+
+  ezHashTable<ezUInt64, ThreadState> threadStates;
+  ezDynamicArray<ezUInt8> chunkData;
+  ezStringBuilder sTemp;
+
+  auto GetName = [&](ezUInt64 uiId) -> ezStringView
+  {
+    return (uiId > 0 && uiId <= names.GetCount()) ? names[static_cast<ezUInt32>(uiId - 1)].GetView() : ezStringView("<unknown>");
+  };
+
+  while (true)
+  {
+    ezUInt8 uiChunkType = 0;
+    if (inout_stream.ReadBytes(&uiChunkType, 1) != 1)
+    {
+      ezLog::Warning("Streaming profiling capture is truncated, it was probably not stopped properly.");
+      break;
+    }
+
+    if (uiChunkType == static_cast<ezUInt8>(StreamChunkType::End))
+      break;
+
+    if (uiChunkType == static_cast<ezUInt8>(StreamChunkType::Names))
+    {
+      ezUInt32 uiCount = 0;
+      inout_stream >> uiCount;
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        ezUInt32 uiId = 0;
+        inout_stream >> uiId;
+        EZ_SUCCEED_OR_RETURN(inout_stream.ReadString(sTemp));
+
+        names.EnsureCount(uiId);
+        names[uiId - 1].Assign(sTemp);
+      }
+    }
+    else if (uiChunkType == static_cast<ezUInt8>(StreamChunkType::ThreadInfo))
+    {
+      ThreadInfo& info = m_ThreadInfos.ExpandAndGetRef();
+      inout_stream >> info.m_uiThreadId;
+      EZ_SUCCEED_OR_RETURN(inout_stream.ReadString(sTemp));
+      info.m_sName = sTemp;
+    }
+    else if (uiChunkType == static_cast<ezUInt8>(StreamChunkType::Events))
+    {
+      ezUInt64 uiThreadId = 0;
+      ezUInt32 uiSize = 0;
+      inout_stream >> uiThreadId;
+      inout_stream >> uiSize;
+
+      chunkData.SetCountUninitialized(uiSize);
+      if (inout_stream.ReadBytes(chunkData.GetData(), uiSize) != uiSize)
+      {
+        ezLog::Warning("Streaming profiling capture is truncated, it was probably not stopped properly.");
+        break;
+      }
+
+      bool bExisted = false;
+      ThreadState& state = threadStates.FindOrAdd(uiThreadId, &bExisted);
+      if (!bExisted)
+      {
+        state.m_uiEventBufferIndex = m_AllEventBuffers.GetCount();
+        m_AllEventBuffers.ExpandAndGetRef().m_uiThreadId = uiThreadId;
+      }
+
+      const ezUInt8* pCur = chunkData.GetData();
+      const ezUInt8* pEnd = pCur + uiSize;
+
+      while (pCur < pEnd)
+      {
+        const ezUInt8 uiRecordType = *pCur++;
+
+        ezUInt64 uiGpuIndex = 0;
+        ezUInt64 uiNameId = 0;
+        ezUInt64 uiFunctionNameId = 0;
+        ezInt64 iTimeDelta = 0;
+        ezUInt64 uiDuration = 0;
+        bool bValid = true;
+
+        if (uiRecordType == static_cast<ezUInt8>(StreamRecordType::GPUScope))
+          bValid &= ReadVarUInt(pCur, pEnd, uiGpuIndex);
+        if (uiRecordType != static_cast<ezUInt8>(StreamRecordType::Frame))
+          bValid &= ReadVarUInt(pCur, pEnd, uiNameId);
+        if (uiRecordType == static_cast<ezUInt8>(StreamRecordType::CPUScope))
+          bValid &= ReadVarUInt(pCur, pEnd, uiFunctionNameId);
+        bValid &= ReadVarInt(pCur, pEnd, iTimeDelta);
+        if (uiRecordType != static_cast<ezUInt8>(StreamRecordType::Frame))
+          bValid &= ReadVarUInt(pCur, pEnd, uiDuration);
+
+        if (!bValid)
+        {
+          ezLog::Error("Invalid record in streaming profiling capture.");
+          return EZ_FAILURE;
+        }
+
+        state.m_iPrevTime += iTimeDelta;
+        const ezTime beginTime = ezTime::MakeFromNanoseconds(static_cast<double>(state.m_iPrevTime));
+        const ezTime endTime = ezTime::MakeFromNanoseconds(static_cast<double>(state.m_iPrevTime + static_cast<ezInt64>(uiDuration)));
+
+        switch (uiRecordType)
+        {
+          case static_cast<ezUInt8>(StreamRecordType::CPUScope):
+          {
+            CPUScope& scope = m_AllEventBuffers[state.m_uiEventBufferIndex].m_Data.ExpandAndGetRef();
+            scope.m_szFunctionName = uiFunctionNameId != 0 ? GetName(uiFunctionNameId).GetStartPointer() : nullptr;
+            scope.m_BeginTime = beginTime;
+            scope.m_EndTime = endTime;
+
+            const ezStringView sName = GetName(uiNameId);
+            ezStringUtils::Copy(scope.m_szName, CPUScope::NAME_SIZE, sName.GetStartPointer(), sName.GetEndPointer());
+          }
+          break;
+
+          case static_cast<ezUInt8>(StreamRecordType::Frame):
+            m_FrameStartTimes.PushBack(beginTime);
+            ++m_uiFrameCount;
+            break;
+
+          case static_cast<ezUInt8>(StreamRecordType::GPUScope):
+          {
+            m_GPUScopes.EnsureCount(static_cast<ezUInt32>(uiGpuIndex) + 1);
+
+            GPUScope& scope = m_GPUScopes[static_cast<ezUInt32>(uiGpuIndex)].ExpandAndGetRef();
+            scope.m_BeginTime = beginTime;
+            scope.m_EndTime = endTime;
+
+            const ezStringView sName = GetName(uiNameId);
+            ezStringUtils::Copy(scope.m_szName, GPUScope::NAME_SIZE, sName.GetStartPointer(), sName.GetEndPointer());
+          }
+          break;
+
+          default:
+            ezLog::Error("Unknown record type {} in streaming profiling capture.", uiRecordType);
+            return EZ_FAILURE;
+        }
+      }
+    }
+    else
+    {
+      ezLog::Error("Unknown chunk type {} in streaming profiling capture.", uiChunkType);
+      return EZ_FAILURE;
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
 // static
 void ezProfilingSystem::Clear()
 {
@@ -672,6 +1371,88 @@ ezUInt64 ezProfilingSystem::GetFrameCount()
   return s_uiFrameCount;
 }
 
+// static
+ezResult ezProfilingSystem::StartStreamingCapture(ezStringView sFilePath)
+{
+  StopStreamingCapture();
+
+  ezUniquePtr<StreamThread> pThread = EZ_DEFAULT_NEW(StreamThread);
+  if (pThread->m_File.Open(sFilePath).Failed())
+  {
+    ezLog::Error("Could not open streaming profiling capture '{0}'.", sFilePath);
+    return EZ_FAILURE;
+  }
+
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+  const ezUInt64 uiProcessID = static_cast<ezUInt64>(ezProcess::GetCurrentProcessID());
+#  else
+  const ezUInt64 uiProcessID = 0;
+#  endif
+
+  pThread->m_File << STREAM_FILE_MAGIC;
+  pThread->m_File << STREAM_FILE_VERSION;
+  pThread->m_File << uiProcessID;
+
+  s_uiStreamSession.store(++s_uiLastStreamSession, std::memory_order_release);
+
+  s_pStreamThread = std::move(pThread);
+  s_pStreamThread->Start();
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopStreamingCapture()
+{
+  if (s_pStreamThread == nullptr)
+    return;
+
+  s_uiStreamSession.store(0);
+
+  // scopes that are being written right now still end up in the file
+  WaitForStreamWriters();
+
+  s_pStreamThread->m_bStop = true;
+  s_pStreamThread->m_Signal.RaiseSignal();
+  s_pStreamThread->Join();
+
+  ezUInt32 uiDroppedRecords = 0;
+  {
+    EZ_LOCK(s_StreamMutex);
+    for (StreamBuffer* pBuffer : s_StreamBuffers)
+    {
+      uiDroppedRecords += pBuffer->m_uiDroppedRecords.load(std::memory_order_relaxed);
+      pBuffer->FreeData();
+    }
+
+    s_StreamBuffers.Clear();
+    s_StreamBuffers.Compact();
+    s_StreamNameIds.Clear();
+    s_StreamNameIds.Compact();
+    s_StreamNames.Clear();
+    s_StreamNames.Compact();
+  }
+
+  if (uiDroppedRecords > 0)
+  {
+    ezLog::Warning("{} profiling scopes were dropped from the streaming capture because the stream buffers were full.", uiDroppedRecords);
+  }
+
+  if (s_pStreamThread->m_bWriteError)
+  {
+    ezLog::Error("Failed to write streaming profiling capture '{0}'.", s_pStreamThread->m_File.GetFilePathAbsolute().GetData());
+  }
+
+  s_pStreamThread->m_File.Close();
+  s_pStreamThread.Clear();
+}
+
+// static
+bool ezProfilingSystem::IsStreamingCaptureActive()
+{
+  return s_uiStreamSession.load(std::memory_order_relaxed) != 0;
+}
+
 // static
 void ezProfilingSystem::StartNewFrame()
 {
@@ -682,7 +1463,9 @@ void ezProfilingSystem::StartNewFrame()
     s_FrameStartTimes.PopFront();
   }
 
-  s_FrameStartTimes.PushBack(ezTime::Now());
+  const ezTime now = ezTime::Now();
+  s_FrameStartTimes.PushBack(now);
+  StreamFrameStart(now);
 
   EZ_PROFILER_FRAME_MARKER();
 }
@@ -696,6 +1479,8 @@ void ezProfilingSystem::AddCPUScope(ezStringView sName, const char* szFunctionNa
   if (duration < ezTime::MakeFromMilliseconds(cvar_ProfilingDiscardThresholdMS))
     return;
 
+  StreamScope(StreamRecordType::CPUScope, 0, sName, szFunctionName, beginTime, endTime);
+
   ::CpuScopesBufferBase* pScopes = s_CpuScopes;
 
   if (pScopes == nullptr)
@@ -788,6 +1573,23 @@ void ezProfilingSystem::Reset()
         s_AllCpuScopes.RemoveAtAndCopy(k);
       }
     }
+
+    // while a capture is active, the stream thread may still read the buffer of a dead thread
+    if (s_pStreamThread == nullptr)
+    {
+      EZ_LOCK(s_StreamMutex);
+      for (ezUInt32 k = 0; k < s_AllStreamBuffers.GetCount(); k++)
+      {
+        StreamBuffer* pStreamBuffer = s_AllStreamBuffers[k];
+        if (pStreamBuffer->m_uiThreadId == uiThreadId)
+        {
+          EZ_DEFAULT_DELETE(pStreamBuffer);
+          // Forward order and no swap important, see comment above.
+          s_AllStreamBuffers.RemoveAtAndCopy(k);
+          break;
+        }
+      }
+    }
   }
   s_DeadThreadIDs.Clear();
 }
@@ -844,6 +1646,8 @@ void ezProfilingSystem::AddGPUScope(ezStringView sName, ezTime beginTime, ezTime
   ezStringUtils::Copy(scope.m_szName, EZ_ARRAY_SIZE(scope.m_szName), sName.GetStartPointer(), sName.GetEndPointer());
 
   s_GPUScopes[uiGpuIndex]->PushBack(scope);
+
+  StreamScope(StreamRecordType::GPUScope, uiGpuIndex, sName, nullptr, beginTime, endTime);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -904,6 +1708,23 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& outputStream) c
   return EZ_FAILURE;
 }
 
+ezResult ezProfilingSystem::ProfilingData::ReadStreamingCapture(ezStreamReader& inout_stream)
+{
+  return EZ_FAILURE;
+}
+
+ezResult ezProfilingSystem::StartStreamingCapture(ezStringView sFilePath)
+{
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::StopStreamingCapture() {}
+
+bool ezProfilingSystem::IsStreamingCaptureActive()
+{
+  return false;
+}
+
 void ezProfilingSystem::Clear() {}
 
 void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& out_Capture, bool bClearAfterCapture) {}
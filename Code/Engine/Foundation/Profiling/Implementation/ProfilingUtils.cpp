@@ -74,3 +74,32 @@ ezResult ezProfilingUtils::MergeProfilingCaptures(ezStringView sCapturePath1, ez
   ezLog::Info("Merged profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
   return EZ_SUCCESS;
 }
+
+ezResult ezProfilingUtils::ConvertStreamingCaptureToJson(ezStringView sStreamingCapturePath, ezStringView sJsonCapturePath)
+{
+  ezProfilingSystem::ProfilingData profilingData;
+  {
+    ezFileReader reader;
+    if (reader.Open(sStreamingCapturePath).Failed())
+    {
+      ezLog::Error("Failed to read streaming profiling capture: {}.", sStreamingCapturePath);
+      return EZ_FAILURE;
+    }
+
+    if (profilingData.ReadStreamingCapture(reader).Failed())
+    {
+      ezLog::Error("Failed to parse streaming profiling capture: {}.", sStreamingCapturePath);
+      return EZ_FAILURE;
+    }
+  }
+
+  ezFileWriter fileWriter;
+  if (fileWriter.Open(sJsonCapturePath).Failed() || profilingData.Write(fileWriter).Failed())
+  {
+    ezLog::Error("Failed to write converted profiling capture: {}.", sJsonCapturePath);
+    return EZ_FAILURE;
+  }
+
+  ezLog::Info("Converted profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
+  return EZ_SUCCESS;
+}
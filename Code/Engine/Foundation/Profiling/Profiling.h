@@ -113,6 +113,11 @@ public:
     /// \brief Writes profiling data as JSON to the output stream.
     ezResult Write(ezStreamWriter& ref_outputStream) const;
 
+    /// \brief Reads a capture that was written with ezProfilingSystem::StartStreamingCapture().
+    ///
+    /// A truncated capture, e.g. of a process that crashed, is read up to the last complete chunk.
+    ezResult ReadStreamingCapture(ezStreamReader& inout_stream);
+
     void Clear();
 
     /// \brief Concatenates all given ProfilingData instances into one merge struct
@@ -141,6 +146,23 @@ public:
   /// \brief Get current frame counter
   static ezUInt64 GetFrameCount();
 
+  /// \brief Starts writing all CPU and GPU scopes and frame starts to the given file until StopStreamingCapture() is called.
+  ///
+  /// Other than Capture(), which only returns the most recent scopes that fit into the in-memory ring buffers, this records everything
+  /// and is meant for long captures. Every thread encodes its scopes into its own lock-free buffer in a compact binary format with interned
+  /// names and delta encoded times, which is written to disk continuously by a background thread. If the buffer of a thread is full,
+  /// its scopes are dropped and reported when the capture is stopped.
+  ///
+  /// Use ProfilingData::ReadStreamingCapture() or ezProfilingUtils::ConvertStreamingCaptureToJson() to read the capture.
+  /// Starting and stopping is not thread-safe, it should only be done from one thread.
+  static ezResult StartStreamingCapture(ezStringView sFilePath);
+
+  /// \brief Writes the remaining data of a streaming capture and closes the file.
+  static void StopStreamingCapture();
+
+  /// \brief Returns whether StartStreamingCapture() has been called and the capture has not been stopped yet.
+  static bool IsStreamingCaptureActive();
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
   friend ezUInt32 RunThread(ezThread* pThread);
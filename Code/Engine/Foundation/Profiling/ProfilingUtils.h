@@ -9,4 +9,6 @@ public:
   static ezResult SaveProfilingCapture(ezStringView sCapturePath);
   /// \brief Reads two profiling captures and merges them into one.
   static ezResult MergeProfilingCaptures(ezStringView sCapturePath1, ezStringView sCapturePath2, ezStringView sMergedCapturePath);
+  /// \brief Converts a capture written by ezProfilingSystem::StartStreamingCapture to the JSON format that SaveProfilingCapture writes.
+  static ezResult ConvertStreamingCaptureToJson(ezStringView sStreamingCapturePath, ezStringView sJsonCapturePath);
 };
@@ -14,7 +14,8 @@ class ezTempHashedString;
 /// (it's a pointer comparison).\n
 /// Copying ezHashedString objects around and assigning between them is very fast as well.\n
 /// \n
-/// Assigning from some other string type is rather slow though, as it requires thread synchronization.\n
+/// Assigning from some other string type is slower, as the string has to be hashed and looked up in the central storage. Looking up a
+/// string that is already stored does not take a lock, only adding a new string locks the part of the storage it ends up in.\n
 /// You can also get access to the actual string data via GetString().\n
 /// \n
 /// You should use ezHashedString whenever the size of the encapsulating object is important and when changes to the string itself
@@ -26,15 +27,26 @@ class EZ_FOUNDATION_DLL ezHashedString
 public:
   struct HashedData
   {
+    ezUInt64 m_uiHash = 0;
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
     ezAtomicInteger32 m_iRefCount;
 #endif
     ezString m_sString;
   };
 
-  // Do NOT use a hash-table! The map does not relocate memory when it resizes, which is a vital aspect for the hashed strings to work.
-  using StringStorage = ezMap<ezUInt64, HashedData, ezCompareHelper<ezUInt64>, ezStaticsAllocatorWrapper>;
-  using HashedType = StringStorage::Iterator;
+  // Entries are allocated individually and never move, the central storage only stores pointers to them.
+  using HashedType = HashedData*;
+
+  /// \brief Statistics about the central string storage, see GetStorageStats().
+  struct StorageStats
+  {
+    ezUInt32 m_uiNumStrings = 0;  ///< Number of distinct strings in the storage.
+    ezUInt64 m_uiStringBytes = 0; ///< Size of all stored strings in bytes, excluding terminators.
+    ezUInt64 m_uiTableBytes = 0;  ///< Memory used by the lookup tables and the entries themselves.
+  };
+
+  /// \brief Returns how many strings are stored in the central storage and how much memory they take up.
+  static StorageStats GetStorageStats();
 
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   /// \brief This will remove all hashed strings from the central storage, that are not referenced anymore.
@@ -71,7 +83,7 @@ public:
   /// \brief Moves the given ezHashedString.
   void operator=(ezHashedString&& rhs); // [tested]
 
-  /// \brief Assigning a new string from a string constant is a slow operation, but the hash computation can happen at compile time.
+  /// \brief Assigning a new string from a string constant requires a lookup in the central storage, but the hash computation can happen at compile time.
   ///
   /// If you need to create an object to compare ezHashedString objects against, prefer to use ezTempHashedString. It will only compute
   /// the strings hash value, but does not require any thread synchronization.
@@ -81,7 +93,7 @@ public:
   template <size_t N>
   void Assign(char (&string)[N]) = delete;
 
-  /// \brief Assigning a new string from a non-hashed string is a very slow operation, this should be used rarely.
+  /// \brief Assigning a new string from a non-hashed string requires hashing it and a lookup in the central storage, this should be used rarely.
   ///
   /// If you need to create an object to compare ezHashedString objects against, prefer to use ezTempHashedString. It will only compute
   /// the strings hash value, but does not require any thread synchronization.
@@ -5,12 +5,143 @@
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
-struct HashedStringData
+#include <atomic>
+
+namespace
 {
-  ezMutex m_Mutex;
-  ezHashedString::StringStorage m_Storage;
-  ezHashedString::HashedType m_Empty;
-};
+  // Strings are distributed over the shards by the upper bits of their hash, so adding strings only contends with other additions to the same shard.
+  static constexpr ezUInt32 s_uiNumShardsBits = 6;
+  static constexpr ezUInt32 s_uiNumShards = 1u << s_uiNumShardsBits;
+  static constexpr ezUInt32 s_uiInitialTableCapacity = 32;
+
+  // The hash is stored next to the pointer, so that probing does not have to touch the entries themselves.
+  // It is written before the pointer is published, readers only look at it once they have seen a non-null pointer.
+  struct HashedStringSlot
+  {
+    std::atomic<ezUInt64> m_uiHash;
+    std::atomic<ezHashedString::HashedType> m_pData;
+  };
+
+  /// Open addressing table with linear probing. Slots are only ever filled, never cleared while readers may access the table,
+  /// so a lookup can run concurrently with an insertion.
+  struct HashedStringTable
+  {
+    ezUInt32 m_uiCapacity = 0; // always a power of two
+    HashedStringSlot* m_pSlots = nullptr;
+
+    // the table that was replaced when this one was created, readers may still be probing it, so it is kept alive
+    HashedStringTable* m_pPrevious = nullptr;
+  };
+
+  // aligned to a cache line, so that locking one shard does not slow down lookups in its neighbors
+  struct alignas(64) HashedStringShard
+  {
+    ezMutex m_Mutex;
+    std::atomic<HashedStringTable*> m_pTable{nullptr};
+
+    // guarded by m_Mutex
+    ezUInt32 m_uiNumStrings = 0;
+    ezUInt64 m_uiStringBytes = 0;
+  };
+
+  static HashedStringTable* CreateTable(ezUInt32 uiCapacity, HashedStringTable* pPrevious)
+  {
+    ezAllocator* pAllocator = ezFoundation::GetStaticsAllocator();
+
+    HashedStringTable* pTable = EZ_NEW(pAllocator, HashedStringTable);
+    pTable->m_uiCapacity = uiCapacity;
+    pTable->m_pSlots = static_cast<HashedStringSlot*>(pAllocator->Allocate(sizeof(HashedStringSlot) * uiCapacity, EZ_ALIGNMENT_OF(HashedStringSlot)));
+    pTable->m_pPrevious = pPrevious;
+
+    for (ezUInt32 i = 0; i < uiCapacity; ++i)
+    {
+      new (&pTable->m_pSlots[i].m_uiHash) std::atomic<ezUInt64>(0);
+      new (&pTable->m_pSlots[i].m_pData) std::atomic<ezHashedString::HashedType>(nullptr);
+    }
+
+    return pTable;
+  }
+
+  static ezHashedString::HashedType FindInTable(const HashedStringTable* pTable, ezUInt64 uiHash)
+  {
+    const ezUInt32 uiMask = pTable->m_uiCapacity - 1;
+
+    for (ezUInt32 uiSlot = static_cast<ezUInt32>(uiHash) & uiMask;; uiSlot = (uiSlot + 1) & uiMask)
+    {
+      const HashedStringSlot& slot = pTable->m_pSlots[uiSlot];
+      ezHashedString::HashedType pData = slot.m_pData.load(std::memory_order_acquire);
+
+      if (pData == nullptr || slot.m_uiHash.load(std::memory_order_relaxed) == uiHash)
+        return pData;
+    }
+  }
+
+  // only called while holding the lock of the shard
+  static void InsertIntoTable(HashedStringTable* pTable, ezHashedString::HashedType pData)
+  {
+    const ezUInt32 uiMask = pTable->m_uiCapacity - 1;
+
+    ezUInt32 uiSlot = static_cast<ezUInt32>(pData->m_uiHash) & uiMask;
+    while (pTable->m_pSlots[uiSlot].m_pData.load(std::memory_order_relaxed) != nullptr)
+    {
+      uiSlot = (uiSlot + 1) & uiMask;
+    }
+
+    // the release store makes sure readers only ever see fully constructed entries
+    pTable->m_pSlots[uiSlot].m_uiHash.store(pData->m_uiHash, std::memory_order_relaxed);
+    pTable->m_pSlots[uiSlot].m_pData.store(pData, std::memory_order_release);
+  }
+
+  // only called while holding the lock of the shard
+  static HashedStringTable* GrowTable(HashedStringShard& ref_shard)
+  {
+    HashedStringTable* pOldTable = ref_shard.m_pTable.load(std::memory_order_relaxed);
+    HashedStringTable* pNewTable = CreateTable(pOldTable->m_uiCapacity * 2, pOldTable);
+
+    for (ezUInt32 i = 0; i < pOldTable->m_uiCapacity; ++i)
+    {
+      if (ezHashedString::HashedType pData = pOldTable->m_pSlots[i].m_pData.load(std::memory_order_relaxed))
+      {
+        InsertIntoTable(pNewTable, pData);
+      }
+    }
+
+    ref_shard.m_pTable.store(pNewTable, std::memory_order_release);
+    return pNewTable;
+  }
+
+  // only called while holding the lock of the shard
+  static ezHashedString::HashedType AddToShard(HashedStringShard& ref_shard, ezStringView sString, ezUInt64 uiHash)
+  {
+    HashedStringTable* pTable = ref_shard.m_pTable.load(std::memory_order_relaxed);
+
+    // keep the load factor below 3/4, so that probe sequences stay short
+    if ((ref_shard.m_uiNumStrings + 1) * 4 > pTable->m_uiCapacity * 3)
+    {
+      pTable = GrowTable(ref_shard);
+    }
+
+    ezHashedString::HashedType pData = EZ_NEW(ezFoundation::GetStaticsAllocator(), ezHashedString::HashedData);
+    pData->m_uiHash = uiHash;
+#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
+    pData->m_iRefCount = 1;
+#endif
+    pData->m_sString = sString;
+
+    InsertIntoTable(pTable, pData);
+
+    ref_shard.m_uiNumStrings++;
+    ref_shard.m_uiStringBytes += pData->m_sString.GetElementCount();
+
+    return pData;
+  }
+
+  struct HashedStringData
+  {
+    HashedStringShard m_Shards[s_uiNumShards];
+    ezHashedString::HashedType m_Empty;
+  };
+} // namespace
 
 static HashedStringData* s_pHSData;
 
@@ -23,37 +154,44 @@ ezHashedString::HashedType ezHashedString::AddHashedString(ezStringView sString,
   if (s_pHSData == nullptr)
     InitHashedString();
 
-  EZ_LOCK(s_pHSData->m_Mutex);
+  HashedStringShard& shard = s_pHSData->m_Shards[uiHash >> (64 - s_uiNumShardsBits)];
 
-  // try to find the existing string
-  bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
+#if EZ_DISABLED(EZ_HASHED_STRING_REF_COUNTING)
+  // without ref counting strings are never removed, so existing strings can be looked up without taking the lock
+  HashedType pData = FindInTable(shard.m_pTable.load(std::memory_order_acquire), uiHash);
 
-  // if it already exists, just increase the refcount
-  if (bExisted)
+  if (pData == nullptr)
   {
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (ret.Value().m_sString != sString)
-    {
-      // TODO: I think this should be a more serious issue
-      ezLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", ezArgSensitive(ret.Value().m_sString), ezArgSensitive(sString), uiHash);
-    }
-#endif
+    EZ_LOCK(shard.m_Mutex);
 
-#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-    ret.Value().m_iRefCount.Increment();
-#endif
+    // another thread may have added it in the meantime
+    pData = FindInTable(shard.m_pTable.load(std::memory_order_relaxed), uiHash);
+
+    if (pData == nullptr)
+      return AddToShard(shard, sString, uiHash);
   }
-  else
-  {
-    ezHashedString::HashedData& d = ret.Value();
-#if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-    d.m_iRefCount = 1;
+#else
+  // ClearUnusedStrings() may delete entries, therefore the lock is needed to safely increase the ref count
+  EZ_LOCK(shard.m_Mutex);
+
+  HashedType pData = FindInTable(shard.m_pTable.load(std::memory_order_relaxed), uiHash);
+
+  if (pData == nullptr)
+    return AddToShard(shard, sString, uiHash);
+
+  pData->m_iRefCount.Increment();
 #endif
-    d.m_sString = sString;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  // a plain byte comparison, this runs for every lookup
+  if (pData->m_sString.GetElementCount() != sString.GetElementCount() || !ezMemoryUtils::IsEqual(pData->m_sString.GetData(), sString.GetStartPointer(), sString.GetElementCount()))
+  {
+    // TODO: I think this should be a more serious issue
+    ezLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", ezArgSensitive(pData->m_sString), ezArgSensitive(sString), uiHash);
   }
+#endif
 
-  return ret;
+  return pData;
 }
 
 EZ_MSVC_ANALYSIS_WARNING_POP
@@ -65,33 +203,89 @@ void ezHashedString::InitHashedString()
     return;
 
   alignas(EZ_ALIGNMENT_OF(HashedStringData)) static ezUInt8 HashedStringDataBuffer[sizeof(HashedStringData)];
-  s_pHSData = new (HashedStringDataBuffer) HashedStringData();
+  HashedStringData* pData = new (HashedStringDataBuffer) HashedStringData();
+
+  for (ezUInt32 i = 0; i < s_uiNumShards; ++i)
+  {
+    pData->m_Shards[i].m_pTable = CreateTable(s_uiInitialTableCapacity, nullptr);
+  }
+
+  s_pHSData = pData;
 
   // makes sure the empty string exists for the default constructor to use
   s_pHSData->m_Empty = AddHashedString("", ezHashingUtils::StringHash(""));
 
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   // this one should never get deleted, so make sure its refcount is 2
-  s_pHSData->m_Empty.Value().m_iRefCount.Increment();
+  s_pHSData->m_Empty->m_iRefCount.Increment();
 #endif
 }
 
+// static
+ezHashedString::StorageStats ezHashedString::GetStorageStats()
+{
+  StorageStats stats;
+
+  if (s_pHSData == nullptr)
+    return stats;
+
+  for (HashedStringShard& shard : s_pHSData->m_Shards)
+  {
+    EZ_LOCK(shard.m_Mutex);
+
+    stats.m_uiNumStrings += shard.m_uiNumStrings;
+    stats.m_uiStringBytes += shard.m_uiStringBytes;
+    stats.m_uiTableBytes += shard.m_uiNumStrings * sizeof(HashedData);
+
+    for (const HashedStringTable* pTable = shard.m_pTable.load(std::memory_order_relaxed); pTable != nullptr; pTable = pTable->m_pPrevious)
+    {
+      stats.m_uiTableBytes += sizeof(HashedStringTable) + pTable->m_uiCapacity * sizeof(HashedStringSlot);
+    }
+  }
+
+  return stats;
+}
+
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
 ezUInt32 ezHashedString::ClearUnusedStrings()
 {
-  EZ_LOCK(s_pHSData->m_Mutex);
-
   ezUInt32 uiDeleted = 0;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  for (HashedStringShard& shard : s_pHSData->m_Shards)
   {
-    if (it.Value().m_iRefCount == 0)
+    EZ_LOCK(shard.m_Mutex);
+
+    // with ref counting all lookups hold the lock, so the table can be rebuilt in place
+    HashedStringTable* pTable = shard.m_pTable.load(std::memory_order_relaxed);
+
+    ezHybridArray<HashedType, 64> remaining;
+
+    for (ezUInt32 i = 0; i < pTable->m_uiCapacity; ++i)
+    {
+      HashedType pData = pTable->m_pSlots[i].m_pData.load(std::memory_order_relaxed);
+      pTable->m_pSlots[i].m_pData.store(nullptr, std::memory_order_relaxed);
+
+      if (pData == nullptr)
+        continue;
+
+      if (pData->m_iRefCount == 0)
+      {
+        shard.m_uiNumStrings--;
+        shard.m_uiStringBytes -= pData->m_sString.GetElementCount();
+
+        EZ_DELETE(ezFoundation::GetStaticsAllocator(), pData);
+        ++uiDeleted;
+      }
+      else
+      {
+        remaining.PushBack(pData);
+      }
+    }
+
+    for (HashedType pData : remaining)
     {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
+      InsertIntoTable(pTable, pData);
     }
-    else
-      ++it;
   }
 
   return uiDeleted;
@@ -112,7 +306,7 @@ ezHashedString::ezHashedString()
 
   m_Data = s_pHSData->m_Empty;
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
-  m_Data.Value().m_iRefCount.Increment();
+  m_Data->m_iRefCount.Increment();
 #endif
 }
 
@@ -131,9 +325,9 @@ void ezHashedString::Clear()
     HashedType tmp = m_Data;
 
     m_Data = s_pHSData->m_Empty;
-    m_Data.Value().m_iRefCount.Increment();
+    m_Data->m_iRefCount.Increment();
 
-    tmp.Value().m_iRefCount.Decrement();
+    tmp->m_iRefCount.Decrement();
   }
 #else
   m_Data = s_pHSData->m_Empty;
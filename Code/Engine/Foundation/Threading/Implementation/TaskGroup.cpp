@@ -28,6 +28,7 @@ void ezTaskGroup::Reuse(ezTaskPriority::Enum priority, ezOnTaskGroupFinishedCall
   m_Tasks.Clear();
   m_DependsOnGroups.Clear();
   m_OthersDependingOnMe.Clear();
+  m_QueueEntries.Clear();
   m_Priority = priority;
   m_OnFinishedCallback = callback;
 }
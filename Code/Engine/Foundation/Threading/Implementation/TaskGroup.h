@@ -2,6 +2,7 @@
 
 #include <Foundation/Strings/String.h>
 #include <Foundation/Threading/ConditionVariable.h>
+#include <Foundation/Threading/Implementation/TaskQueues.h>
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
 #include <Foundation/Types/SharedPtr.h>
 
@@ -41,4 +42,9 @@ private:
   ezOnTaskGroupFinishedCallback m_OnFinishedCallback;
   ezTaskPriority::Enum m_Priority = ezTaskPriority::ThisFrame;
   mutable ezConditionVariable m_CondVarGroupFinished;
+
+  // Work-stealing mode: one entry per scheduled task invocation, the queues point into this array.
+  ezDynamicArray<ezTaskQueueEntry> m_QueueEntries;
+  // Work-stealing mode: how many of m_QueueEntries have not been removed from their queue yet. The group must not be reused before this is zero.
+  ezAtomicInteger32 m_iNumQueueEntriesInFlight;
 };
@@ -0,0 +1,179 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/Implementation/TaskQueues.h>
+#include <Foundation/Threading/Lock.h>
+
+static_assert(ezMath::IsPowerOf2(ezTaskWorkStealingDeque::Capacity), "Capacity must be a power of two");
+static_assert(ezMath::IsPowerOf2(ezTaskInjectionQueue::Capacity), "Capacity must be a power of two");
+
+ezTaskWorkStealingDeque::ezTaskWorkStealingDeque()
+{
+  for (ezUInt32 i = 0; i < Capacity; ++i)
+  {
+    m_Slots[i] = nullptr;
+  }
+}
+
+bool ezTaskWorkStealingDeque::PushBottom(ezTaskQueueEntry* pEntry)
+{
+  const ezInt64 b = m_iBottom;
+  const ezInt64 t = m_iTop;
+
+  // a stale (too small) top value only makes us more conservative here, so we never overwrite a slot that may still be stolen
+  if (b - t >= static_cast<ezInt64>(Capacity))
+    return false;
+
+  m_Slots[b & (Capacity - 1)] = pEntry;
+
+  // the atomic write acts as a full barrier, thieves that see the new bottom also see the slot content
+  m_iBottom = b + 1;
+  return true;
+}
+
+ezTaskQueueEntry* ezTaskWorkStealingDeque::PopBottom()
+{
+  const ezInt64 b = m_iBottom - 1;
+  m_iBottom = b;
+
+  const ezInt64 t = m_iTop;
+
+  if (t > b)
+  {
+    // deque was empty, restore the canonical empty state
+    m_iBottom = b + 1;
+    return nullptr;
+  }
+
+  ezTaskQueueEntry* pEntry = m_Slots[b & (Capacity - 1)];
+
+  if (t == b)
+  {
+    // this was the last entry, race against the thieves for it
+    if (!m_iTop.TestAndSet(t, t + 1))
+    {
+      pEntry = nullptr;
+    }
+
+    m_iBottom = b + 1;
+  }
+
+  return pEntry;
+}
+
+ezTaskQueueEntry* ezTaskWorkStealingDeque::Steal()
+{
+  while (true)
+  {
+    const ezInt64 t = m_iTop;
+    const ezInt64 b = m_iBottom;
+
+    if (t >= b)
+      return nullptr;
+
+    ezTaskQueueEntry* pEntry = m_Slots[t & (Capacity - 1)];
+
+    if (m_iTop.TestAndSet(t, t + 1))
+      return pEntry;
+
+    // lost the race against the owner or another thief, try again as long as there is something left
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezTaskInjectionQueue::ezTaskInjectionQueue()
+{
+  for (ezUInt32 i = 0; i < Capacity; ++i)
+  {
+    m_Cells[i].m_iSequence = i;
+  }
+}
+
+void ezTaskInjectionQueue::Push(ezTaskQueueEntry* pEntry)
+{
+  if (TryPushRing(pEntry))
+    return;
+
+  EZ_LOCK(m_OverflowMutex);
+  m_Overflow.PushBack(pEntry);
+  m_iNumOverflow.Increment();
+}
+
+ezTaskQueueEntry* ezTaskInjectionQueue::Pop()
+{
+  if (ezTaskQueueEntry* pEntry = TryPopRing())
+    return pEntry;
+
+  if (m_iNumOverflow > 0)
+  {
+    EZ_LOCK(m_OverflowMutex);
+
+    if (!m_Overflow.IsEmpty())
+    {
+      ezTaskQueueEntry* pEntry = m_Overflow.PeekFront();
+      m_Overflow.PopFront();
+      m_iNumOverflow.Decrement();
+      return pEntry;
+    }
+  }
+
+  return nullptr;
+}
+
+bool ezTaskInjectionQueue::TryPushRing(ezTaskQueueEntry* pEntry)
+{
+  ezInt64 pos = m_iEnqueuePos;
+
+  while (true)
+  {
+    Cell& cell = m_Cells[pos & (Capacity - 1)];
+    const ezInt64 seq = cell.m_iSequence;
+    const ezInt64 diff = seq - pos;
+
+    if (diff == 0)
+    {
+      if (m_iEnqueuePos.TestAndSet(pos, pos + 1))
+      {
+        cell.m_pEntry = pEntry;
+        cell.m_iSequence = pos + 1;
+        return true;
+      }
+    }
+    else if (diff < 0)
+    {
+      // full
+      return false;
+    }
+
+    pos = m_iEnqueuePos;
+  }
+}
+
+ezTaskQueueEntry* ezTaskInjectionQueue::TryPopRing()
+{
+  ezInt64 pos = m_iDequeuePos;
+
+  while (true)
+  {
+    Cell& cell = m_Cells[pos & (Capacity - 1)];
+    const ezInt64 seq = cell.m_iSequence;
+    const ezInt64 diff = seq - (pos + 1);
+
+    if (diff == 0)
+    {
+      if (m_iDequeuePos.TestAndSet(pos, pos + 1))
+      {
+        ezTaskQueueEntry* pEntry = cell.m_pEntry;
+        cell.m_iSequence = pos + Capacity;
+        return pEntry;
+      }
+    }
+    else if (diff < 0)
+    {
+      // empty (or the producer has not finished writing this cell yet)
+      return nullptr;
+    }
+
+    pos = m_iDequeuePos;
+  }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+/// \internal A single scheduled task invocation as it is stored by the work-stealing scheduler.
+///
+/// The entries are owned by the ezTaskGroup that the task belongs to, the queues only store pointers to them.
+/// An entry stays valid until it has been removed from a queue, the group is never reused before that.
+struct ezTaskQueueEntry
+{
+  enum State : ezInt32
+  {
+    Queued = 0,   ///< Waiting in some queue for execution.
+    Taken = 1,    ///< Removed from a queue by a thread that is going to execute it.
+    Canceled = 2, ///< Canceled through ezTaskSystem::CancelTask() before any thread picked it up.
+  };
+
+  ezTaskSystem::TaskData m_Data;
+
+  /// \brief Only used to identify the entry. Must not be dereferenced, the task may already be gone once the entry got canceled.
+  ezTask* m_pTask = nullptr;
+
+  /// \brief Copy of the task's nesting mode, so that it can be checked without touching the task.
+  ezTaskNesting m_NestingMode = ezTaskNesting::Maybe;
+
+  ezAtomicInteger32 m_iState; // State
+};
+
+/// \internal Fixed-size Chase-Lev deque. Only the owning worker thread may push and pop at the bottom, all other threads may steal from the top.
+class ezTaskWorkStealingDeque
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskWorkStealingDeque);
+
+public:
+  static constexpr ezUInt32 Capacity = 256;
+
+  ezTaskWorkStealingDeque();
+
+  /// \brief Owner only. Returns false, if the deque is full, in which case the entry has to be queued elsewhere.
+  bool PushBottom(ezTaskQueueEntry* pEntry);
+
+  /// \brief Owner only. Returns the most recently pushed entry or nullptr.
+  ezTaskQueueEntry* PopBottom();
+
+  /// \brief May be called from any thread. Returns the oldest entry or nullptr.
+  ezTaskQueueEntry* Steal();
+
+  bool IsEmpty() const { return m_iBottom <= m_iTop; }
+
+private:
+  ezAtomicInteger64 m_iTop;
+  ezTaskQueueEntry* volatile m_Slots[Capacity];
+  ezAtomicInteger64 m_iBottom;
+};
+
+/// \internal Multi-producer, multi-consumer FIFO that receives all tasks that are not pushed into a worker's local deque.
+///
+/// The queue is a bounded lock-free ring buffer. If that is full, entries spill into a mutex-protected overflow list,
+/// so pushing never fails.
+class ezTaskInjectionQueue
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskInjectionQueue);
+
+public:
+  static constexpr ezUInt32 Capacity = 1024;
+
+  ezTaskInjectionQueue();
+
+  void Push(ezTaskQueueEntry* pEntry);
+
+  /// \brief Returns nullptr if the queue is empty.
+  ezTaskQueueEntry* Pop();
+
+private:
+  bool TryPushRing(ezTaskQueueEntry* pEntry);
+  ezTaskQueueEntry* TryPopRing();
+
+  struct Cell
+  {
+    ezAtomicInteger64 m_iSequence;
+    ezTaskQueueEntry* m_pEntry = nullptr;
+  };
+
+  ezAtomicInteger64 m_iEnqueuePos;
+  Cell m_Cells[Capacity];
+  ezAtomicInteger64 m_iDequeuePos;
+
+  ezAtomicInteger32 m_iNumOverflow;
+  ezMutex m_OverflowMutex;
+  ezDeque<ezTaskQueueEntry*> m_Overflow;
+};
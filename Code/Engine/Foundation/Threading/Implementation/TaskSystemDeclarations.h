@@ -10,6 +10,8 @@
 class ezTask;
 class ezTaskGroup;
 class ezTaskWorkerThread;
+class ezTaskWorkStealingDeque;
+struct ezTaskQueueEntry;
 class ezTaskSystemState;
 class ezTaskSystemThreadState;
 class ezDGMLGraph;
@@ -98,6 +100,23 @@ struct ezWorkerThreadType
   static const char* GetThreadTypeName(ezWorkerThreadType::Enum threadType);
 };
 
+/// \brief Selects how the ezTaskSystem stores scheduled tasks and hands them out to the worker threads.
+///
+/// 'Locked' keeps one list per ezTaskPriority, all protected by the global task system mutex.
+/// 'WorkStealing' gives every worker thread its own lock-free deque (per priority) into which it pushes the tasks that it schedules itself,
+/// plus one lock-free injection queue per priority for tasks that are scheduled from other threads. Idle workers steal from their siblings.
+/// Both modes respect the ezTaskPriority order and the ezWorkerThreadType that is responsible for each priority.
+struct ezTaskSchedulerMode
+{
+  enum Enum : ezUInt8
+  {
+    Locked,
+    WorkStealing,
+
+    Default = Locked
+  };
+};
+
 /// \brief Given out by ezTaskSystem::CreateTaskGroup to identify a task group.
 class EZ_FOUNDATION_DLL ezTaskGroupID
 {
@@ -18,7 +18,8 @@ ezTaskGroupID ezTaskSystem::CreateTaskGroup(ezTaskPriority::Enum priority, ezOnT
   // this search could be speed up with a stack of free groups
   for (; i < s_pState->m_TaskGroups.GetCount(); ++i)
   {
-    if (!s_pState->m_TaskGroups[i].m_bInUse)
+    // in work-stealing mode, canceled tasks may still sit in some queue and reference the group, see CancelQueuedTaskEntries()
+    if (!s_pState->m_TaskGroups[i].m_bInUse && s_pState->m_TaskGroups[i].m_iNumQueueEntriesInFlight == 0)
     {
       goto foundtaskgroup;
     }
@@ -145,8 +146,59 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
 
   ezInt32 iRemainingTasks = 0;
 
-  // add all the tasks to the task list, so that they will be processed
+  // once the tasks are queued, the group may finish (and get reused) at any time, so don't access it afterwards
+  const ezTaskPriority::Enum priority = pGroup->m_Priority;
+
+  if (s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing)
   {
+    {
+      EZ_LOCK(s_TaskSystemMutex);
+
+      // store how many tasks from this groups still need to be processed
+
+      for (auto pTask : pGroup->m_Tasks)
+      {
+        iRemainingTasks += ezMath::Max(1u, pTask->m_uiMultiplicity);
+        pTask->m_iRemainingRuns = ezMath::Max(1u, pTask->m_uiMultiplicity);
+      }
+
+      pGroup->m_iNumRemainingTasks = iRemainingTasks;
+      pGroup->m_iNumQueueEntriesInFlight = iRemainingTasks;
+
+      // the entries must not relocate anymore, once the first one is queued
+      pGroup->m_QueueEntries.Clear();
+      pGroup->m_QueueEntries.Reserve(iRemainingTasks);
+
+      for (ezUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
+      {
+        auto& pTask = pGroup->m_Tasks[task];
+
+        for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
+        {
+          ezTaskQueueEntry& entry = pGroup->m_QueueEntries.ExpandAndGetRef();
+          entry.m_Data.m_pBelongsToGroup = pGroup;
+          entry.m_Data.m_pTask = pTask;
+          entry.m_Data.m_uiInvocation = mult;
+          entry.m_pTask = pTask.Borrow();
+          entry.m_NestingMode = pTask->m_NestingMode;
+          entry.m_iState = ezTaskQueueEntry::Queued;
+
+          pTask->m_bTaskIsScheduled = true;
+        }
+      }
+    }
+
+    // the queues are lock-free, no need to hold the mutex while filling them
+    ezTaskQueueEntry* pEntries = pGroup->m_QueueEntries.GetData();
+
+    for (ezInt32 i = 0; i < iRemainingTasks; ++i)
+    {
+      QueueTaskEntry(&pEntries[i], priority, true);
+    }
+  }
+  else
+  {
+    // add all the tasks to the task list, so that they will be processed
     EZ_LOCK(s_TaskSystemMutex);
 
 
@@ -174,54 +226,20 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
         td.m_uiInvocation = mult;
 
         if (bHighPriority)
-          s_pState->m_Tasks[pGroup->m_Priority].PushFront(td);
+          s_pState->m_Tasks[priority].PushFront(td);
         else
-          s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+          s_pState->m_Tasks[priority].PushBack(td);
       }
     }
+  }
 
-    // send the proper thread signal, to make sure one of the correct worker threads is awake
-    switch (pGroup->m_Priority)
-    {
-      case ezTaskPriority::EarlyThisFrame:
-      case ezTaskPriority::ThisFrame:
-      case ezTaskPriority::LateThisFrame:
-      case ezTaskPriority::EarlyNextFrame:
-      case ezTaskPriority::NextFrame:
-      case ezTaskPriority::LateNextFrame:
-      case ezTaskPriority::In2Frames:
-      case ezTaskPriority::In3Frames:
-      case ezTaskPriority::In4Frames:
-      case ezTaskPriority::In5Frames:
-      case ezTaskPriority::In6Frames:
-      case ezTaskPriority::In7Frames:
-      case ezTaskPriority::In8Frames:
-      case ezTaskPriority::In9Frames:
-      {
-        WakeUpThreads(ezWorkerThreadType::ShortTasks, iRemainingTasks);
-        break;
-      }
-
-      case ezTaskPriority::LongRunning:
-      case ezTaskPriority::LongRunningHighPriority:
-      {
-        WakeUpThreads(ezWorkerThreadType::LongTasks, iRemainingTasks);
-        break;
-      }
-
-      case ezTaskPriority::FileAccess:
-      case ezTaskPriority::FileAccessHighPriority:
-      {
-        WakeUpThreads(ezWorkerThreadType::FileAccess, iRemainingTasks);
-        break;
-      }
+  // send the proper thread signal, to make sure one of the correct worker threads is awake
+  const ezWorkerThreadType::Enum workerType = GetWorkerTypeForPriority(priority);
 
-      case ezTaskPriority::SomeFrameMainThread:
-      case ezTaskPriority::ThisFrameMainThread:
-      case ezTaskPriority::ENUM_COUNT:
-        // nothing to do for these enum values
-        break;
-    }
+  // main thread tasks are picked up by FinishFrameTasks()
+  if (workerType != ezWorkerThreadType::MainThread)
+  {
+    WakeUpThreads(workerType, iRemainingTasks);
   }
 }
 
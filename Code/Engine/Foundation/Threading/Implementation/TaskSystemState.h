@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Threading/Implementation/TaskQueues.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 class ezTaskSystemThreadState
@@ -31,4 +32,12 @@ private:
 
   // The lists of all scheduled tasks, for each priority.
   ezList<ezTaskSystem::TaskData> m_Tasks[ezTaskPriority::ENUM_COUNT];
+
+  ezTaskSchedulerMode::Enum m_SchedulerMode = ezTaskSchedulerMode::Default;
+
+  // Work-stealing mode: all scheduled tasks that did not go into the local deque of a worker thread, for each priority.
+  ezTaskInjectionQueue m_InjectionQueues[ezTaskPriority::ENUM_COUNT];
+
+  // Work-stealing mode: the number of queued tasks for each priority (over all queues), used to quickly skip empty priorities.
+  ezAtomicInteger32 m_iNumQueuedTasks[ezTaskPriority::ENUM_COUNT];
 };
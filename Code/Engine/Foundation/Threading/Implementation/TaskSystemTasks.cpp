@@ -94,6 +94,11 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   EZ_ASSERT_DEV(FirstPriority >= ezTaskPriority::EarlyThisFrame && LastPriority < ezTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
+  if (s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing)
+  {
+    return GetNextTaskWorkStealing(FirstPriority, LastPriority, bOnlyTasksThatNeverWait, WaitingForGroup, pWorkerState);
+  }
+
   EZ_LOCK(s_TaskSystemMutex);
 
   // go through all the task lists that this thread is willing to work on
@@ -173,9 +178,16 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
       return EZ_SUCCESS;
     }
 
-    // check if the task has already been scheduled for execution
-    // if so, remove it from the work queue
+    if (s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing)
     {
+      // the lock-free queues do not allow to remove entries, instead the entries are flagged as canceled
+      if (CancelQueuedTaskEntries(pTask).Succeeded())
+        return EZ_SUCCESS;
+    }
+    else
+    {
+      // check if the task has already been scheduled for execution
+      // if so, remove it from the work queue
       for (ezUInt32 i = 0; i < ezTaskPriority::ENUM_COUNT; ++i)
       {
         auto it = s_pState->m_Tasks[i].GetIterator();
@@ -226,6 +238,12 @@ bool ezTaskSystem::HelpExecutingTasks(const ezTaskGroupID& WaitingForGroup)
 
 void ezTaskSystem::ReprioritizeFrameTasks()
 {
+  if (s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing)
+  {
+    ReprioritizeFrameTasksWorkStealing();
+    return;
+  }
+
   // There should usually be no 'this frame tasks' left at this time
   // however, while we waited to enter the lock, such tasks might have appeared
   // In this case we move them into the highest-priority 'this frame' queue, to ensure they will be executed asap
@@ -313,12 +331,7 @@ void ezTaskSystem::ExecuteSomeFrameTasks(ezTime smoothFrameTime)
     CurTime = ezTime::Now();
   }
 
-  ezUInt32 uiNumTasksTodo = 0;
-
-  {
-    EZ_LOCK(s_TaskSystemMutex);
-    uiNumTasksTodo = s_pState->m_Tasks[ezTaskPriority::SomeFrameMainThread].GetCount();
-  }
+  const ezUInt32 uiNumTasksTodo = GetNumQueuedTasks(ezTaskPriority::SomeFrameMainThread);
 
   if (uiNumTasksTodo == 0)
     return;
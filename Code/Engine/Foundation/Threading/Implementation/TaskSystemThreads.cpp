@@ -93,6 +93,16 @@ void ezTaskSystem::StopWorkerThreads()
     for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
     {
       s_pThreadState->m_Workers[type][i]->Join();
+
+      // hand over the tasks that are still queued in the worker's local deques, the worker itself will be gone
+      for (ezUInt32 prio = 0; prio < ezTaskPriority::ENUM_COUNT; ++prio)
+      {
+        while (ezTaskQueueEntry* pEntry = s_pThreadState->m_Workers[type][i]->m_LocalQueues[prio].Steal())
+        {
+          s_pState->m_InjectionQueues[prio].Push(pEntry);
+        }
+      }
+
       EZ_DEFAULT_DELETE(s_pThreadState->m_Workers[type][i]);
     }
 
@@ -237,3 +247,41 @@ void ezTaskSystem::DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_Fir
     }
   }
 }
+
+ezWorkerThreadType::Enum ezTaskSystem::GetWorkerTypeForPriority(ezTaskPriority::Enum priority)
+{
+  switch (priority)
+  {
+    case ezTaskPriority::EarlyThisFrame:
+    case ezTaskPriority::ThisFrame:
+    case ezTaskPriority::LateThisFrame:
+    case ezTaskPriority::EarlyNextFrame:
+    case ezTaskPriority::NextFrame:
+    case ezTaskPriority::LateNextFrame:
+    case ezTaskPriority::In2Frames:
+    case ezTaskPriority::In3Frames:
+    case ezTaskPriority::In4Frames:
+    case ezTaskPriority::In5Frames:
+    case ezTaskPriority::In6Frames:
+    case ezTaskPriority::In7Frames:
+    case ezTaskPriority::In8Frames:
+    case ezTaskPriority::In9Frames:
+      return ezWorkerThreadType::ShortTasks;
+
+    case ezTaskPriority::LongRunningHighPriority:
+    case ezTaskPriority::LongRunning:
+      return ezWorkerThreadType::LongTasks;
+
+    case ezTaskPriority::FileAccessHighPriority:
+    case ezTaskPriority::FileAccess:
+      return ezWorkerThreadType::FileAccess;
+
+    case ezTaskPriority::ThisFrameMainThread:
+    case ezTaskPriority::SomeFrameMainThread:
+      return ezWorkerThreadType::MainThread;
+
+    default:
+      EZ_ASSERT_NOT_IMPLEMENTED;
+      return ezWorkerThreadType::Unknown;
+  }
+}
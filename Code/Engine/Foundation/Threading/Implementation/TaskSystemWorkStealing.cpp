@@ -0,0 +1,261 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Threading/Implementation/TaskGroup.h>
+#include <Foundation/Threading/Implementation/TaskSystemState.h>
+#include <Foundation/Threading/Implementation/TaskWorkerThread.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+void ezTaskSystem::QueueTaskEntry(ezTaskQueueEntry* pEntry, ezTaskPriority::Enum priority, bool bAllowLocalQueue)
+{
+  bool bQueued = false;
+
+  // tasks that the calling worker could execute itself go into its own deque, where they are cheap to push and pop
+  // all other workers of the same type can steal them from there
+  if (bAllowLocalQueue && tl_TaskWorkerInfo.m_pLocalQueues != nullptr && GetWorkerTypeForPriority(priority) == tl_TaskWorkerInfo.m_WorkerType)
+  {
+    bQueued = tl_TaskWorkerInfo.m_pLocalQueues[priority].PushBottom(pEntry);
+  }
+
+  if (!bQueued)
+  {
+    s_pState->m_InjectionQueues[priority].Push(pEntry);
+  }
+
+  // only count the entry once it is visible in a queue, see GetNextTaskWorkStealing() for why this matters
+  s_pState->m_iNumQueuedTasks[priority].Increment();
+}
+
+ezTaskQueueEntry* ezTaskSystem::DequeueTaskEntry(ezTaskPriority::Enum priority)
+{
+  ezTaskWorkStealingDeque* pLocalQueues = tl_TaskWorkerInfo.m_pLocalQueues;
+
+  // newest tasks from the own deque first, they are most likely to still be in the cache
+  if (pLocalQueues != nullptr)
+  {
+    if (ezTaskQueueEntry* pEntry = pLocalQueues[priority].PopBottom())
+      return pEntry;
+  }
+
+  if (ezTaskQueueEntry* pEntry = s_pState->m_InjectionQueues[priority].Pop())
+    return pEntry;
+
+  // steal from the other workers that are responsible for this priority
+  const ezWorkerThreadType::Enum type = GetWorkerTypeForPriority(priority);
+  const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
+
+  if (uiNumWorkers == 0)
+    return nullptr;
+
+  // start with different victims on different threads, to spread the contention
+  const ezUInt32 uiFirstVictim = (tl_TaskWorkerInfo.m_iWorkerIndex >= 0) ? static_cast<ezUInt32>(tl_TaskWorkerInfo.m_iWorkerIndex + 1) : 0u;
+
+  for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+  {
+    ezTaskWorkerThread* pVictim = s_pThreadState->m_Workers[type][(uiFirstVictim + i) % uiNumWorkers];
+
+    if (pVictim->m_LocalQueues == pLocalQueues)
+      continue;
+
+    if (ezTaskQueueEntry* pEntry = pVictim->m_LocalQueues[priority].Steal())
+      return pEntry;
+  }
+
+  return nullptr;
+}
+
+ezTaskSystem::TaskData ezTaskSystem::GetNextTaskWorkStealing(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority,
+  bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState)
+{
+  while (true)
+  {
+    for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+    {
+      if (s_pState->m_iNumQueuedTasks[prio] <= 0)
+        continue;
+
+      const ezTaskPriority::Enum priority = static_cast<ezTaskPriority::Enum>(prio);
+
+      // entries that this thread is not allowed to execute right now, they are put back once we are done with this priority
+      ezHybridArray<ezTaskQueueEntry*, 8> rejected;
+      TaskData result;
+
+      while (ezTaskQueueEntry* pEntry = DequeueTaskEntry(priority))
+      {
+        s_pState->m_iNumQueuedTasks[prio].Decrement();
+
+        ezTaskGroup* pGroup = pEntry->m_Data.m_pBelongsToGroup;
+
+        if (bOnlyTasksThatNeverWait && pEntry->m_NestingMode != ezTaskNesting::Never && pGroup != WaitingForGroup.m_pTaskGroup)
+        {
+          rejected.PushBack(pEntry);
+
+          if (rejected.GetCount() == rejected.GetCapacity())
+            break;
+
+          continue;
+        }
+
+        if (!pEntry->m_iState.TestAndSet(ezTaskQueueEntry::Queued, ezTaskQueueEntry::Taken))
+        {
+          // the task was canceled, CancelTask() already took care of it, we only need to release the entry
+          pGroup->m_iNumQueueEntriesInFlight.Decrement();
+          continue;
+        }
+
+        result = std::move(pEntry->m_Data);
+
+        // this must be the last access to the entry, afterwards the group may get reused
+        pGroup->m_iNumQueueEntriesInFlight.Decrement();
+        break;
+      }
+
+      for (ezTaskQueueEntry* pEntry : rejected)
+      {
+        QueueTaskEntry(pEntry, priority, false);
+      }
+
+      if (result.m_pTask != nullptr)
+        return result;
+    }
+
+    if (pWorkerState == nullptr)
+      return TaskData();
+
+    EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+
+    // Without the global mutex, a task may get queued after we searched its queue but before we marked ourselves as idle.
+    // The scheduling thread then did not see us as idle and might not wake anyone up. Therefore check the counters once more
+    // and if there is something to do, try to get back into the active state. If that fails, someone already woke us up.
+    bool bAnyQueued = false;
+    for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+    {
+      if (s_pState->m_iNumQueuedTasks[prio] > 0)
+      {
+        bAnyQueued = true;
+        break;
+      }
+    }
+
+    if (!bAnyQueued || !pWorkerState->TestAndSet((int)ezTaskWorkerState::Idle, (int)ezTaskWorkerState::Active))
+      return TaskData();
+  }
+}
+
+ezResult ezTaskSystem::CancelQueuedTaskEntries(const ezSharedPtr<ezTask>& pTask)
+{
+  // called with s_TaskSystemMutex locked, so the group cannot get reused while we look at its entries
+
+  ezTaskGroup* pGroup = pTask->m_BelongsToGroup.m_pTaskGroup;
+
+  ezHybridArray<ezTaskQueueEntry*, 16> canceled;
+  ezUInt32 uiNumRunning = 0;
+
+  for (ezTaskQueueEntry& entry : pGroup->m_QueueEntries)
+  {
+    if (entry.m_pTask != pTask.Borrow())
+      continue;
+
+    if (entry.m_iState.TestAndSet(ezTaskQueueEntry::Queued, ezTaskQueueEntry::Canceled))
+      canceled.PushBack(&entry);
+    else
+      ++uiNumRunning;
+  }
+
+  if (uiNumRunning == 0)
+  {
+    // we set the task to finished, even though it was not executed
+    pTask->m_iRemainingRuns = 0;
+  }
+  else
+  {
+    // some invocations are running (or done), only count the canceled ones as finished, the others will bring the counter to zero
+    for (ezUInt32 i = 0; i < canceled.GetCount(); ++i)
+    {
+      pTask->m_iRemainingRuns.Decrement();
+    }
+  }
+
+  // the canceled entries stay in their queues until some thread pops and releases them,
+  // but the group does not need to wait for that, so tell it that these runs are 'finished'
+  for (ezTaskQueueEntry* pEntry : canceled)
+  {
+    TaskHasFinished(std::move(pEntry->m_Data.m_pTask), pEntry->m_Data.m_pBelongsToGroup);
+  }
+
+  return uiNumRunning == 0 ? EZ_SUCCESS : EZ_FAILURE;
+}
+
+void ezTaskSystem::MoveQueuedTaskEntries(ezTaskPriority::Enum from, ezTaskPriority::Enum to)
+{
+  while (ezTaskQueueEntry* pEntry = s_pState->m_InjectionQueues[from].Pop())
+  {
+    s_pState->m_iNumQueuedTasks[from].Decrement();
+    QueueTaskEntry(pEntry, to, false);
+  }
+
+  const ezWorkerThreadType::Enum type = GetWorkerTypeForPriority(from);
+  const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
+
+  for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+  {
+    ezTaskWorkStealingDeque& deque = s_pThreadState->m_Workers[type][i]->m_LocalQueues[from];
+
+    while (ezTaskQueueEntry* pEntry = deque.Steal())
+    {
+      s_pState->m_iNumQueuedTasks[from].Decrement();
+      QueueTaskEntry(pEntry, to, false);
+    }
+  }
+}
+
+void ezTaskSystem::ReprioritizeFrameTasksWorkStealing()
+{
+  // same order as in ReprioritizeFrameTasks()
+
+  for (ezUInt32 i = (ezUInt32)ezTaskPriority::ThisFrame; i <= (ezUInt32)ezTaskPriority::LateThisFrame; ++i)
+  {
+    MoveQueuedTaskEntries((ezTaskPriority::Enum)i, ezTaskPriority::EarlyThisFrame);
+  }
+
+  for (ezUInt32 i = (ezUInt32)ezTaskPriority::EarlyNextFrame; i <= (ezUInt32)ezTaskPriority::LateNextFrame; ++i)
+  {
+    MoveQueuedTaskEntries((ezTaskPriority::Enum)i, (ezTaskPriority::Enum)(i - 3));
+  }
+
+  for (ezUInt32 i = (ezUInt32)ezTaskPriority::In2Frames; i <= (ezUInt32)ezTaskPriority::In9Frames; ++i)
+  {
+    MoveQueuedTaskEntries((ezTaskPriority::Enum)i, (ezTaskPriority::Enum)(i - 1));
+  }
+}
+
+ezUInt32 ezTaskSystem::GetNumQueuedTasks(ezTaskPriority::Enum priority)
+{
+  if (s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing)
+  {
+    return static_cast<ezUInt32>(ezMath::Max<ezInt32>(s_pState->m_iNumQueuedTasks[priority], 0));
+  }
+
+  EZ_LOCK(s_TaskSystemMutex);
+  return s_pState->m_Tasks[priority].GetCount();
+}
+
+void ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::Enum mode)
+{
+  EZ_LOCK(s_TaskSystemMutex);
+
+  if (s_pState->m_SchedulerMode == mode)
+    return;
+
+  for (ezUInt32 prio = 0; prio < ezTaskPriority::ENUM_COUNT; ++prio)
+  {
+    EZ_ASSERT_DEV(GetNumQueuedTasks((ezTaskPriority::Enum)prio) == 0, "The scheduler mode can only be changed while no tasks are queued.");
+  }
+
+  s_pState->m_SchedulerMode = mode;
+}
+
+ezTaskSchedulerMode::Enum ezTaskSystem::GetSchedulerMode()
+{
+  return s_pState->m_SchedulerMode;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Threading/Implementation/TaskQueues.h>
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
 
 #include <Foundation/Threading/Thread.h>
@@ -75,6 +76,17 @@ private:
   ezAtomicInteger32 m_iWorkerState; // ezTaskWorkerState
 
   ///@}
+
+  /// \name Work Stealing
+  ///@{
+
+private:
+  friend class ezTaskSystem;
+
+  // only used in ezTaskSchedulerMode::WorkStealing, tasks that this thread scheduled itself, for each priority
+  ezTaskWorkStealingDeque m_LocalQueues[ezTaskPriority::ENUM_COUNT];
+
+  ///@}
 };
 
 /// \internal Thread local state used by the task system (and for better debugging)
@@ -85,6 +97,7 @@ struct ezTaskWorkerInfo
   ezInt32 m_iWorkerIndex = -1;
   const char* m_szTaskName = nullptr;
   ezAtomicInteger32* m_pWorkerState = nullptr;
+  ezTaskWorkStealingDeque* m_pLocalQueues = nullptr;
 };
 
 extern thread_local ezTaskWorkerInfo tl_TaskWorkerInfo;
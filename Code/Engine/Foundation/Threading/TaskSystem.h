@@ -103,6 +103,25 @@ private:
   /// \brief Helps executing tasks that are suitable for the calling thread. Returns true if a task was found and executed.
   static bool HelpExecutingTasks(const ezTaskGroupID& WaitingForGroup);
 
+  /// \brief Work-stealing counterpart of GetNextTask().
+  static TaskData GetNextTaskWorkStealing(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
+    const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
+
+  /// \brief Removes one entry of the given priority from the calling thread's local deque, the injection queue or another worker's deque.
+  static ezTaskQueueEntry* DequeueTaskEntry(ezTaskPriority::Enum priority);
+
+  /// \brief Puts a scheduled task into the local deque of the calling worker thread (if allowed and possible) or into the injection queue.
+  static void QueueTaskEntry(ezTaskQueueEntry* pEntry, ezTaskPriority::Enum priority, bool bAllowLocalQueue);
+
+  /// \brief Work-stealing counterpart of the queue search in CancelTask(). Returns EZ_FAILURE if any invocation of the task is already running.
+  static ezResult CancelQueuedTaskEntries(const ezSharedPtr<ezTask>& pTask);
+
+  /// \brief Work-stealing counterpart of ReprioritizeFrameTasks().
+  static void ReprioritizeFrameTasksWorkStealing();
+
+  /// \brief Moves all entries of priority \a from into the injection queue of priority \a to.
+  static void MoveQueuedTaskEntries(ezTaskPriority::Enum from, ezTaskPriority::Enum to);
+
   ///@}
 
   /// \name Managing Task Groups
@@ -229,6 +248,7 @@ private:
   /// \brief Uses a thread local variable to know the current thread type and to decide the range of task priorities that it may execute
   static void DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_FirstPriority, ezTaskPriority::Enum& out_LastPriority);
 
+
 private:
   static ezUniquePtr<ezTaskSystemThreadState> s_pThreadState;
 
@@ -281,6 +301,12 @@ private:
   ///@{
 
 public:
+  /// \brief Returns how many tasks of the given priority are currently waiting for execution.
+  static ezUInt32 GetNumQueuedTasks(ezTaskPriority::Enum priority); // [tested]
+
+  /// \brief Returns the type of worker thread that is responsible for executing tasks of the given priority.
+  static ezWorkerThreadType::Enum GetWorkerTypeForPriority(ezTaskPriority::Enum priority);
+
   /// \brief Writes the internal state of the ezTaskSystem as a DGML graph.
   static void WriteStateSnapshotToDGML(ezDGMLGraph& ref_graph);
 
@@ -300,6 +326,15 @@ public:
   /// \see FinishFrameTasks() for more details.
   static void SetTargetFrameTime(ezTime targetFrameTime = ezTime::MakeFromSeconds(1.0 / 40.0) /* 40 FPS -> 25 ms */);
 
+  /// \brief Switches between the mutex-protected task lists and the work-stealing scheduler.
+  ///
+  /// This may only be called while no tasks are queued for execution, typically right after startup.
+  /// \see ezTaskSchedulerMode
+  static void SetSchedulerMode(ezTaskSchedulerMode::Enum mode); // [tested]
+
+  /// \brief Returns which scheduler implementation is currently used.
+  static ezTaskSchedulerMode::Enum GetSchedulerMode(); // [tested]
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, TaskSystem);
 
@@ -52,6 +52,10 @@
 #endif
 
 
+/// Whether the default heap is an ezThreadCacheHeapAllocator, which serves small allocations from per-thread caches and only reports a sample of them to the memory tracker
+#undef EZ_ALLOC_THREAD_CACHE_HEAP
+#define EZ_ALLOC_THREAD_CACHE_HEAP EZ_OFF
+
 /// Whether game objects compute and store their velocity since the last frame (increases object size)
 #define EZ_GAMEOBJECT_VELOCITY EZ_ON
 
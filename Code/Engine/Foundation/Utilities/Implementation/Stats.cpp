@@ -1,11 +1,185 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Utilities/Stats.h>
 
+#include <atomic>
+
 ezMutex ezStats::s_Mutex;
 ezStats::MapType ezStats::s_Stats;
 ezStats::ezEventStats ezStats::s_StatsEvents;
 
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, Stats)
+
+  // no dependencies
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezStats::Shutdown();
+  }
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+namespace
+{
+  constexpr ezUInt32 s_uiStatsPerBlock = 256;
+  constexpr ezUInt32 s_uiMaxStatBlocks = 256;
+  constexpr ezUInt32 s_uiMaxRegisteredStats = s_uiStatsPerBlock * s_uiMaxStatBlocks;
+
+  struct StatSlot
+  {
+    // written by ezStats::SetStat() from any thread
+    std::atomic<double> m_fValue{0.0};
+
+    // everything else is protected by s_StatsRegistryMutex
+    ezString m_sName;
+    ezStats::StatMode::Enum m_Mode = ezStats::StatMode::Value;
+    ezUInt32 m_uiRefCount = 0;
+
+    ezDynamicArray<double> m_History;
+    ezUInt32 m_uiNextHistoryIndex = 0;
+    ezUInt32 m_uiNumHistorySamples = 0;
+
+    double m_fLastCounterValue = 0.0;
+    double m_fPublishedValue = 0.0;
+    bool m_bPublished = false;
+  };
+
+  struct StatSlotBlock
+  {
+    StatSlot m_Slots[s_uiStatsPerBlock];
+  };
+
+  /// Every thread that calls ezStats::AddToStat() gets its own counter blocks, which are only ever written by that thread.
+  struct StatCounterBlock
+  {
+    StatCounterBlock()
+    {
+      for (auto& value : m_fValues)
+      {
+        value.store(0.0, std::memory_order_relaxed);
+      }
+    }
+
+    std::atomic<double> m_fValues[s_uiStatsPerBlock];
+  };
+
+  struct StatThreadCounters
+  {
+    StatThreadCounters()
+    {
+      for (auto& pBlock : m_Blocks)
+      {
+        pBlock.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    std::atomic<StatCounterBlock*> m_Blocks[s_uiMaxStatBlocks];
+  };
+
+  class StatsSamplingThread : public ezThread
+  {
+  public:
+    StatsSamplingThread()
+      : ezThread("Stats Sampling")
+    {
+    }
+
+    ezThreadSignal m_Signal;
+    ezAtomicBool m_bStop;
+
+  private:
+    virtual ezUInt32 Run() override;
+  };
+
+  ezMutex s_StatsRegistryMutex;
+  std::atomic<StatSlotBlock*> s_StatSlotBlocks[s_uiMaxStatBlocks];
+  ezUInt32 s_uiNumStatSlots = 0;
+  ezDynamicArray<ezUInt32> s_FreeStatSlots;
+  ezHashTable<ezString, ezUInt32> s_RegisteredStatIndices;
+  ezDynamicArray<StatThreadCounters*> s_StatThreadCounters;
+  ezUniquePtr<StatsSamplingThread> s_pStatsSamplingThread;
+  std::atomic<double> s_fStatsAggregationInterval{0.1};
+
+  // thread counters of an older generation have been deleted during shutdown
+  std::atomic<ezUInt32> s_uiStatCountersGeneration{1};
+  thread_local StatThreadCounters* tl_pStatThreadCounters = nullptr;
+  thread_local ezUInt32 tl_uiStatCountersGeneration = 0;
+
+  EZ_ALWAYS_INLINE StatSlot* GetStatSlot(ezUInt32 uiIndex)
+  {
+    if (uiIndex >= s_uiMaxRegisteredStats)
+      return nullptr;
+
+    StatSlotBlock* pBlock = s_StatSlotBlocks[uiIndex / s_uiStatsPerBlock].load(std::memory_order_acquire);
+    return pBlock != nullptr ? &pBlock->m_Slots[uiIndex % s_uiStatsPerBlock] : nullptr;
+  }
+
+  StatThreadCounters* AcquireStatThreadCounters()
+  {
+    EZ_LOCK(s_StatsRegistryMutex);
+
+    tl_pStatThreadCounters = EZ_DEFAULT_NEW(StatThreadCounters);
+    tl_uiStatCountersGeneration = s_uiStatCountersGeneration.load(std::memory_order_relaxed);
+
+    s_StatThreadCounters.PushBack(tl_pStatThreadCounters);
+    return tl_pStatThreadCounters;
+  }
+
+  double SumStatCounters(ezUInt32 uiIndex)
+  {
+    double fSum = 0.0;
+
+    for (StatThreadCounters* pCounters : s_StatThreadCounters)
+    {
+      if (StatCounterBlock* pBlock = pCounters->m_Blocks[uiIndex / s_uiStatsPerBlock].load(std::memory_order_acquire))
+      {
+        fSum += pBlock->m_fValues[uiIndex % s_uiStatsPerBlock].load(std::memory_order_relaxed);
+      }
+    }
+
+    return fSum;
+  }
+
+  void ResetStatCounters(ezUInt32 uiIndex)
+  {
+    for (StatThreadCounters* pCounters : s_StatThreadCounters)
+    {
+      if (StatCounterBlock* pBlock = pCounters->m_Blocks[uiIndex / s_uiStatsPerBlock].load(std::memory_order_acquire))
+      {
+        pBlock->m_fValues[uiIndex % s_uiStatsPerBlock].store(0.0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  ezUInt32 StatsSamplingThread::Run()
+  {
+    while (!m_bStop)
+    {
+      const double fInterval = s_fStatsAggregationInterval.load(std::memory_order_relaxed);
+
+      if (fInterval > 0.0)
+      {
+        if (m_Signal.WaitForSignal(ezTime::MakeFromSeconds(fInterval)) == ezThreadSignal::WaitResult::Timeout)
+        {
+          ezStats::SampleStats();
+        }
+      }
+      else
+      {
+        m_Signal.WaitForSignal();
+      }
+    }
+
+    return 0;
+  }
+} // namespace
+
 void ezStats::RemoveStat(ezStringView sStatName)
 {
   EZ_LOCK(s_Mutex);
@@ -43,3 +217,278 @@ void ezStats::SetStat(ezStringView sStatName, const ezVariant& value)
 
   s_StatsEvents.Broadcast(e);
 }
+
+ezStatHandle ezStats::RegisterStat(ezStringView sStatName, StatMode::Enum mode /*= StatMode::Value*/, ezUInt32 uiHistorySize /*= 64*/)
+{
+  EZ_LOCK(s_StatsRegistryMutex);
+
+  ezStatHandle hStat;
+
+  const ezString sName = sStatName;
+  if (s_RegisteredStatIndices.TryGetValue(sName, hStat.m_uiIndex))
+  {
+    StatSlot* pSlot = GetStatSlot(hStat.m_uiIndex);
+    EZ_ASSERT_DEV(pSlot->m_Mode == mode, "Stat '{0}' is already registered with a different mode.", sStatName);
+
+    ++pSlot->m_uiRefCount;
+    return hStat;
+  }
+
+  if (!s_FreeStatSlots.IsEmpty())
+  {
+    hStat.m_uiIndex = s_FreeStatSlots.PeekBack();
+    s_FreeStatSlots.PopBack();
+  }
+  else if (s_uiNumStatSlots < s_uiMaxRegisteredStats)
+  {
+    hStat.m_uiIndex = s_uiNumStatSlots++;
+  }
+  else
+  {
+    EZ_REPORT_FAILURE("Too many stats registered, '{0}' can't be registered.", sStatName);
+    return hStat;
+  }
+
+  std::atomic<StatSlotBlock*>& block = s_StatSlotBlocks[hStat.m_uiIndex / s_uiStatsPerBlock];
+  if (block.load(std::memory_order_relaxed) == nullptr)
+  {
+    StatSlotBlock* pBlock = EZ_DEFAULT_NEW(StatSlotBlock);
+    block.store(pBlock, std::memory_order_release);
+  }
+
+  StatSlot& slot = block.load(std::memory_order_relaxed)->m_Slots[hStat.m_uiIndex % s_uiStatsPerBlock];
+  slot.m_fValue.store(0.0, std::memory_order_relaxed);
+  slot.m_sName = sName;
+  slot.m_Mode = mode;
+  slot.m_uiRefCount = 1;
+  slot.m_History.SetCount(ezMath::Max(uiHistorySize, 1u));
+  slot.m_uiNextHistoryIndex = 0;
+  slot.m_uiNumHistorySamples = 0;
+  slot.m_fLastCounterValue = 0.0;
+  slot.m_bPublished = false;
+
+  // the slot may have been used by a stat that was unregistered before
+  ResetStatCounters(hStat.m_uiIndex);
+
+  s_RegisteredStatIndices.Insert(sName, hStat.m_uiIndex);
+
+  if (s_pStatsSamplingThread == nullptr)
+  {
+    s_pStatsSamplingThread = EZ_DEFAULT_NEW(StatsSamplingThread);
+    s_pStatsSamplingThread->Start();
+  }
+
+  return hStat;
+}
+
+void ezStats::UnregisterStat(ezStatHandle& ref_hStat)
+{
+  EZ_LOCK(s_StatsRegistryMutex);
+
+  StatSlot* pSlot = GetStatSlot(ref_hStat.m_uiIndex);
+  ref_hStat.Invalidate();
+
+  if (pSlot == nullptr || pSlot->m_uiRefCount == 0)
+    return;
+
+  if (--pSlot->m_uiRefCount > 0)
+    return;
+
+  ezUInt32 uiIndex = 0;
+  s_RegisteredStatIndices.Remove(pSlot->m_sName, &uiIndex);
+
+  if (pSlot->m_bPublished)
+  {
+    RemoveStat(pSlot->m_sName);
+  }
+
+  pSlot->m_sName.Clear();
+  pSlot->m_History.Clear();
+  pSlot->m_bPublished = false;
+
+  s_FreeStatSlots.PushBack(uiIndex);
+}
+
+void ezStats::SetStat(ezStatHandle hStat, double fValue)
+{
+  if (StatSlot* pSlot = GetStatSlot(hStat.m_uiIndex))
+  {
+    EZ_ASSERT_DEBUG(pSlot->m_Mode == StatMode::Value, "SetStat() can only be used with stats of mode 'Value'.");
+    pSlot->m_fValue.store(fValue, std::memory_order_relaxed);
+  }
+}
+
+void ezStats::AddToStat(ezStatHandle hStat, double fAmount)
+{
+  if (hStat.m_uiIndex >= s_uiMaxRegisteredStats)
+    return;
+
+  StatThreadCounters* pCounters = tl_pStatThreadCounters;
+  if (tl_uiStatCountersGeneration != s_uiStatCountersGeneration.load(std::memory_order_relaxed))
+  {
+    pCounters = AcquireStatThreadCounters();
+  }
+
+  std::atomic<StatCounterBlock*>& block = pCounters->m_Blocks[hStat.m_uiIndex / s_uiStatsPerBlock];
+
+  StatCounterBlock* pBlock = block.load(std::memory_order_relaxed);
+  if (pBlock == nullptr)
+  {
+    pBlock = EZ_DEFAULT_NEW(StatCounterBlock);
+    block.store(pBlock, std::memory_order_release);
+  }
+
+  // only this thread writes to the value, the atomic just guarantees that the sampling thread never reads a torn value
+  std::atomic<double>& value = pBlock->m_fValues[hStat.m_uiIndex % s_uiStatsPerBlock];
+  value.store(value.load(std::memory_order_relaxed) + fAmount, std::memory_order_relaxed);
+}
+
+double ezStats::GetStatValue(ezStatHandle hStat)
+{
+  StatSlot* pSlot = GetStatSlot(hStat.m_uiIndex);
+  if (pSlot == nullptr)
+    return 0.0;
+
+  if (pSlot->m_Mode == StatMode::Value)
+    return pSlot->m_fValue.load(std::memory_order_relaxed);
+
+  EZ_LOCK(s_StatsRegistryMutex);
+  return SumStatCounters(hStat.m_uiIndex);
+}
+
+ezResult ezStats::GetStatAggregate(ezStatHandle hStat, StatAggregate& out_aggregate)
+{
+  EZ_LOCK(s_StatsRegistryMutex);
+
+  out_aggregate = StatAggregate();
+
+  const StatSlot* pSlot = GetStatSlot(hStat.m_uiIndex);
+  if (pSlot == nullptr || pSlot->m_uiRefCount == 0 || pSlot->m_uiNumHistorySamples == 0)
+    return EZ_FAILURE;
+
+  const ezUInt32 uiNumSamples = pSlot->m_uiNumHistorySamples;
+  const double* pSamples = pSlot->m_History.GetData();
+
+  double fSum = 0.0;
+  out_aggregate.m_fMin = pSamples[0];
+  out_aggregate.m_fMax = pSamples[0];
+
+  for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+  {
+    out_aggregate.m_fMin = ezMath::Min(out_aggregate.m_fMin, pSamples[i]);
+    out_aggregate.m_fMax = ezMath::Max(out_aggregate.m_fMax, pSamples[i]);
+    fSum += pSamples[i];
+  }
+
+  out_aggregate.m_uiNumSamples = uiNumSamples;
+  out_aggregate.m_fAverage = fSum / uiNumSamples;
+
+  const double fRange = out_aggregate.m_fMax - out_aggregate.m_fMin;
+  const double fBucketScale = fRange > 0.0 ? StatAggregate::HistogramBuckets / fRange : 0.0;
+
+  for (ezUInt32 i = 0; i < uiNumSamples; ++i)
+  {
+    const ezUInt32 uiBucket = static_cast<ezUInt32>((pSamples[i] - out_aggregate.m_fMin) * fBucketScale);
+    ++out_aggregate.m_Histogram[ezMath::Min<ezUInt32>(uiBucket, StatAggregate::HistogramBuckets - 1)];
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezStats::SetAggregationInterval(ezTime interval)
+{
+  s_fStatsAggregationInterval.store(ezMath::Max(interval.GetSeconds(), 0.0), std::memory_order_relaxed);
+
+  EZ_LOCK(s_StatsRegistryMutex);
+
+  if (s_pStatsSamplingThread != nullptr)
+  {
+    // wake up the thread, so that it picks up the new interval
+    s_pStatsSamplingThread->m_Signal.RaiseSignal();
+  }
+}
+
+void ezStats::SampleStats()
+{
+  // Changed values are published while the registry is locked, so that a stat that gets unregistered concurrently can't be
+  // published again after it was removed.
+  EZ_LOCK(s_StatsRegistryMutex);
+
+  for (ezUInt32 uiIndex = 0; uiIndex < s_uiNumStatSlots; ++uiIndex)
+  {
+    StatSlot& slot = *GetStatSlot(uiIndex);
+    if (slot.m_uiRefCount == 0)
+      continue;
+
+    double fValue = 0.0;
+    double fSample = 0.0;
+
+    if (slot.m_Mode == StatMode::Value)
+    {
+      fValue = slot.m_fValue.load(std::memory_order_relaxed);
+      fSample = fValue;
+    }
+    else
+    {
+      fValue = SumStatCounters(uiIndex);
+      fSample = fValue - slot.m_fLastCounterValue;
+      slot.m_fLastCounterValue = fValue;
+    }
+
+    slot.m_History[slot.m_uiNextHistoryIndex] = fSample;
+    slot.m_uiNextHistoryIndex = (slot.m_uiNextHistoryIndex + 1) % slot.m_History.GetCount();
+    slot.m_uiNumHistorySamples = ezMath::Min(slot.m_uiNumHistorySamples + 1, slot.m_History.GetCount());
+
+    if (!slot.m_bPublished || slot.m_fPublishedValue != fValue)
+    {
+      slot.m_bPublished = true;
+      slot.m_fPublishedValue = fValue;
+
+      SetStat(slot.m_sName, fValue);
+    }
+  }
+}
+
+void ezStats::Shutdown()
+{
+  if (s_pStatsSamplingThread != nullptr)
+  {
+    s_pStatsSamplingThread->m_bStop = true;
+    s_pStatsSamplingThread->m_Signal.RaiseSignal();
+    s_pStatsSamplingThread->Join();
+    s_pStatsSamplingThread.Clear();
+  }
+
+  EZ_LOCK(s_StatsRegistryMutex);
+
+  // threads notice the new generation and allocate new counters on their next update
+  s_uiStatCountersGeneration.fetch_add(1, std::memory_order_relaxed);
+
+  for (StatThreadCounters* pCounters : s_StatThreadCounters)
+  {
+    for (auto& block : pCounters->m_Blocks)
+    {
+      StatCounterBlock* pBlock = block.load(std::memory_order_relaxed);
+      EZ_DEFAULT_DELETE(pBlock);
+    }
+
+    EZ_DEFAULT_DELETE(pCounters);
+  }
+
+  for (auto& block : s_StatSlotBlocks)
+  {
+    StatSlotBlock* pBlock = block.load(std::memory_order_relaxed);
+    EZ_DEFAULT_DELETE(pBlock);
+    block.store(nullptr, std::memory_order_relaxed);
+  }
+
+  s_uiNumStatSlots = 0;
+  s_StatThreadCounters.Clear();
+  s_StatThreadCounters.Compact();
+  s_FreeStatSlots.Clear();
+  s_FreeStatSlots.Compact();
+  s_RegisteredStatIndices.Clear();
+  s_RegisteredStatIndices.Compact();
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Utilities_Implementation_Stats);
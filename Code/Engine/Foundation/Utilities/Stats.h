@@ -2,15 +2,38 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Configuration/StaticSubSystem.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/Strings/String.h>
+#include <Foundation/Time/Time.h>
 #include <Foundation/Types/Variant.h>
 
+/// \brief A handle to a stat that was registered through ezStats::RegisterStat().
+struct ezStatHandle
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezUInt32 m_uiIndex = ezInvalidIndex;
+
+  bool IsValid() const { return m_uiIndex != ezInvalidIndex; }
+  void Invalidate() { m_uiIndex = ezInvalidIndex; }
+
+  bool operator==(const ezStatHandle& other) const { return m_uiIndex == other.m_uiIndex; }
+  bool operator!=(const ezStatHandle& other) const { return m_uiIndex != other.m_uiIndex; }
+};
+
 /// \brief This class holds a simple map that maps strings (keys) to strings (values), which represent certain stats.
 ///
 /// This can be used by a game to store (and continuously update) information about the internal game state. Other tools can then
 /// display this information in a convenient manner. For example the stats can be shown on screen. The data is also transmitted through
 /// ezTelemetry, and the ezInspector tool will display the information.
+///
+/// There are two ways to update a stat. SetStat() with a name is the simple but slow path, it locks a global mutex, looks up the name
+/// and broadcasts an event for every change. Stats that are updated frequently (e.g. every frame) should instead be registered once
+/// through RegisterStat(). Updating a registered stat through its handle is a single atomic write without locks or allocations.
+/// A background thread samples all registered stats in a fixed interval (see SetAggregationInterval()), keeps a history of the last
+/// samples for GetStatAggregate() and publishes changed values into the regular stats map, so tools that use GetAllStats() or the
+/// event handlers see them like any other stat, just with a small delay.
 class EZ_FOUNDATION_DLL ezStats
 {
 public:
@@ -29,6 +52,69 @@ public:
   /// changed value.
   static void SetStat(ezStringView sStatName, const ezVariant& value);
 
+  /// \brief Describes how the value of a registered stat is updated.
+  struct StatMode
+  {
+    enum Enum
+    {
+      Value,   ///< The stat holds the last value that was passed to SetStat(). Its history stores these values.
+      Counter, ///< The stat is the sum of all values passed to AddToStat() on any thread. Its history stores the increase per sample.
+    };
+  };
+
+  /// \brief Registers a stat for fast updates and returns a handle to it.
+  ///
+  /// Registering a name that is already registered returns the same handle, the stat is only removed once UnregisterStat() was called
+  /// for every registration. uiHistorySize is the number of samples that are kept for GetStatAggregate(), the history of a stat that
+  /// is registered multiple times keeps the size of the first registration.
+  /// All handles become invalid when the core systems are shut down.
+  static ezStatHandle RegisterStat(ezStringView sStatName, StatMode::Enum mode = StatMode::Value, ezUInt32 uiHistorySize = 64);
+
+  /// \brief Releases a stat that was registered through RegisterStat(). Once the last registration is gone, the stat is removed.
+  static void UnregisterStat(ezStatHandle& ref_hStat);
+
+  /// \brief Sets the value of a registered stat of mode StatMode::Value. Lock-free, may be called from any thread.
+  static void SetStat(ezStatHandle hStat, double fValue);
+
+  /// \brief Increases the value of a registered stat of mode StatMode::Counter.
+  ///
+  /// Every thread writes into its own slot, so concurrent updates from many threads do not contend with each other.
+  /// The first update of a stat on a thread may allocate, every following one is lock-free and allocation-free.
+  static void AddToStat(ezStatHandle hStat, double fAmount);
+
+  /// \brief Returns the current value of a registered stat. For counters the slots of all threads are summed up.
+  static double GetStatValue(ezStatHandle hStat);
+
+  /// \brief Aggregated information about the history of a registered stat.
+  struct StatAggregate
+  {
+    enum
+    {
+      HistogramBuckets = 16
+    };
+
+    ezUInt32 m_uiNumSamples = 0;
+    double m_fMin = 0.0;
+    double m_fMax = 0.0;
+    double m_fAverage = 0.0;
+
+    /// \brief The number of samples per bucket. The buckets evenly divide the range from m_fMin to m_fMax.
+    ezUInt32 m_Histogram[HistogramBuckets] = {};
+  };
+
+  /// \brief Computes min, max, average and a histogram over the sample history of the given stat.
+  ///
+  /// Returns EZ_FAILURE if the handle is invalid or no sample has been taken yet.
+  static ezResult GetStatAggregate(ezStatHandle hStat, StatAggregate& out_aggregate);
+
+  /// \brief Sets how often the background thread samples all registered stats. Defaults to 100 milliseconds.
+  ///
+  /// A zero interval stops the background sampling, SampleStats() then has to be called manually, e.g. once per frame.
+  static void SetAggregationInterval(ezTime interval);
+
+  /// \brief Takes one sample of every registered stat and publishes changed values. Called regularly by the background thread.
+  static void SampleStats();
+
   /// \brief Returns the value of the given stat. Returns an invalid ezVariant, if the stat did not exist before.
   static const ezVariant& GetStat(ezStringView sStatName) { return s_Stats[sStatName]; }
 
@@ -60,6 +146,10 @@ public:
   static void RemoveEventHandler(ezEventStats::Handler handler) { s_StatsEvents.RemoveEventHandler(handler); }
 
 private:
+  EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, Stats);
+
+  static void Shutdown();
+
   static ezMutex s_Mutex;
   static MapType s_Stats;
   static ezEventStats s_StatsEvents;
@@ -286,7 +286,11 @@ void ezGameApplication::Init_LoadRequiredPlugins()
 
 #endif
 
-  EZ_VERIFY(ezPlugin::LoadPlugin(szShaderCompiler).Succeeded(), "Shader compiler '{}' plugin not found", szShaderCompiler);
+  // renderers without a shader compiler (e.g. the null renderer) can't compile shaders at runtime
+  if (!ezStringUtils::IsNullOrEmpty(szShaderCompiler))
+  {
+    EZ_VERIFY(ezPlugin::LoadPlugin(szShaderCompiler).Succeeded(), "Shader compiler '{}' plugin not found", szShaderCompiler);
+  }
 }
 
 void ezGameApplication::Deinit_ShutdownGraphicsDevice()
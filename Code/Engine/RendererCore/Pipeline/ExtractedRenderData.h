@@ -32,6 +32,11 @@ public:
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
   void AddFrameData(const ezRenderData* pFrameData);
 
+  /// \brief Appends the render data of all categories of the given extracted data, e.g. from a per-thread extraction buffer.
+  ///
+  /// Sorting keys are taken over as they are, so both need to use the same camera. Must be called before SortAndBatch.
+  void MergeRenderData(const ezExtractedRenderData& other);
+
   void SortAndBatch();
 
   void Clear();
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class ezStreamWriter;
@@ -32,6 +34,8 @@ protected:
   bool FilterByViewTags(const ezView& view, const ezGameObject* pObject) const;
 
   /// \brief extracts the render data for the given object.
+  ///
+  /// Can be called from multiple threads at once as long as every thread uses its own msg and extractedRenderData.
   void ExtractRenderData(const ezView& view, const ezGameObject* pObject, ezMsgExtractRenderData& msg, ezExtractedRenderData& extractedRenderData) const;
 
 private:
@@ -45,8 +49,8 @@ protected:
   ezHybridArray<ezHashedString, 4> m_DependsOn;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  mutable ezUInt32 m_uiNumCachedRenderData;
-  mutable ezUInt32 m_uiNumUncachedRenderData;
+  mutable ezAtomicInteger32 m_NumCachedRenderData;
+  mutable ezAtomicInteger32 m_NumUncachedRenderData;
 #endif
 };
 
@@ -62,6 +66,13 @@ public:
   virtual void Extract(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData) override;
   virtual ezResult Serialize(ezStreamWriter& inout_stream) const override;
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
+
+  /// \brief Visible objects are extracted in chunks of this size on the worker threads. Fewer objects are extracted directly.
+  static constexpr ezUInt32 ObjectsPerChunk = 128;
+
+private:
+  // one buffer per chunk, merged in order so the result does not depend on the thread scheduling
+  ezDynamicArray<ezExtractedRenderData> m_ChunkRenderData;
 };
 
 class EZ_RENDERERCORE_DLL ezSelectedObjectsExtractorBase : public ezExtractor
@@ -19,6 +19,16 @@ void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
   m_FrameData.PushBack(pFrameData);
 }
 
+void ezExtractedRenderData::MergeRenderData(const ezExtractedRenderData& other)
+{
+  m_DataPerCategory.EnsureCount(other.m_DataPerCategory.GetCount());
+
+  for (ezUInt32 i = 0; i < other.m_DataPerCategory.GetCount(); ++i)
+  {
+    m_DataPerCategory[i].m_SortableRenderData.PushBackRange(other.m_DataPerCategory[i].m_SortableRenderData);
+  }
+}
+
 void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
@@ -4,6 +4,7 @@
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/TypeVersionContext.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -21,6 +22,8 @@ ezCVarString cvar_SpatialVisDataOnlyObject("Spatial.VisData.OnlyObject", "", ezC
 ezCVarBool cvar_SpatialExtractionShowStats("Spatial.Extraction.ShowStats", false, ezCVarFlags::Default, "Display some stats of the render data extraction");
 #endif
 
+ezCVarBool cvar_SpatialExtractionMultithreaded("Spatial.Extraction.Multithreaded", true, ezCVarFlags::Default, "Extracts the render data of visible objects on multiple threads");
+
 namespace
 {
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -108,11 +111,6 @@ ezExtractor::ezExtractor(const char* szName)
 {
   m_bActive = true;
   m_sName.Assign(szName);
-
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-  m_uiNumCachedRenderData = 0;
-  m_uiNumUncachedRenderData = 0;
-#endif
 }
 
 ezExtractor::~ezExtractor() = default;
@@ -143,6 +141,11 @@ bool ezExtractor::FilterByViewTags(const ezView& view, const ezGameObject* pObje
 
 void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObject, ezMsgExtractRenderData& msg, ezExtractedRenderData& extractedRenderData) const
 {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezUInt32 uiNumCachedRenderData = 0;
+  ezUInt32 uiNumUncachedRenderData = 0;
+#endif
+
   auto AddRenderDataFromMessage = [&](const ezMsgExtractRenderData& msg) {
     if (msg.m_OverrideCategory != ezInvalidRenderDataCategory)
     {
@@ -160,7 +163,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
     }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    m_uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
+    uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
 #endif
   };
 
@@ -196,7 +199,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
           extractedRenderData.AddRenderData(cacheEntry.m_pRenderData, msg.m_OverrideCategory != ezInvalidRenderDataCategory ? msg.m_OverrideCategory : ezRenderData::Category(cacheEntry.m_uiCategory));
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-          ++m_uiNumCachedRenderData;
+          ++uiNumCachedRenderData;
 #endif
         }
         ++uiCacheIndex;
@@ -256,6 +259,11 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
 
     AddRenderDataFromMessage(msg);
   }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  m_NumCachedRenderData.Add(uiNumCachedRenderData);
+  m_NumUncachedRenderData.Add(uiNumUncachedRenderData);
+#endif
 }
 
 void ezExtractor::Extract(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData)
@@ -301,24 +309,77 @@ ezVisibleObjectsExtractor::~ezVisibleObjectsExtractor() = default;
 void ezVisibleObjectsExtractor::Extract(
   const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData)
 {
-  ezMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   EZ_LOCK(view.GetWorld()->GetReadMarker());
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   VisualizeSpatialData(view);
 
-  m_uiNumCachedRenderData = 0;
-  m_uiNumUncachedRenderData = 0;
+  m_NumCachedRenderData = 0;
+  m_NumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  const ezUInt32 uiNumObjects = visibleObjects.GetCount();
+  const ezUInt32 uiNumChunks = (uiNumObjects + ObjectsPerChunk - 1) / ObjectsPerChunk;
+
+  if (uiNumChunks <= 1 || !cvar_SpatialExtractionMultithreaded)
   {
-    ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    ezMsgExtractRenderData msg;
+    msg.m_pView = &view;
+
+    for (auto pObject : visibleObjects)
+    {
+      ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    }
+  }
+  else
+  {
+    // Every chunk extracts into its own buffer, the buffers are then merged in chunk order before sorting.
+    // The render data cache lookup doesn't lock and new cache entries are only applied at the end of the frame, so this is safe.
+    // Components already need to handle extraction of different views in parallel, each object is only extracted once per view though.
+    m_ChunkRenderData.SetCount(uiNumChunks);
+
+    for (auto& chunkRenderData : m_ChunkRenderData)
+    {
+      chunkRenderData.Clear();
+      chunkRenderData.SetCamera(ref_extractedRenderData.GetCamera());
+    }
+
+    ezParallelForParams parallelForParams;
+    parallelForParams.m_uiBinSize = 1;
+    parallelForParams.m_uiMaxTasksPerThread = 2;
+
+    ezTaskSystem::ParallelForIndexed(
+      0u, uiNumChunks,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        ezMsgExtractRenderData msg;
+        msg.m_pView = &view;
+
+        for (ezUInt32 uiChunkIndex = uiStartIndex; uiChunkIndex < uiEndIndex; ++uiChunkIndex)
+        {
+          ezExtractedRenderData& chunkRenderData = m_ChunkRenderData[uiChunkIndex];
+
+          const ezUInt32 uiFirstObject = uiChunkIndex * ObjectsPerChunk;
+          const ezUInt32 uiEndObject = ezMath::Min(uiFirstObject + ObjectsPerChunk, uiNumObjects);
+
+          for (ezUInt32 i = uiFirstObject; i < uiEndObject; ++i)
+          {
+            ExtractRenderData(view, visibleObjects[i], msg, chunkRenderData);
+          }
+        }
+      },
+      "ExtractVisibleObjects", ezTaskNesting::Never, parallelForParams);
+
+    for (auto& chunkRenderData : m_ChunkRenderData)
+    {
+      ref_extractedRenderData.MergeRenderData(chunkRenderData);
+    }
+  }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+  if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+  {
+    for (auto pObject : visibleObjects)
     {
       if ((cvar_SpatialVisDataOnlyObject.GetValue().IsEmpty() ||
             pObject->GetName().FindSubString_NoCase(cvar_SpatialVisDataOnlyObject.GetValue()) != nullptr) &&
@@ -327,8 +388,8 @@ void ezVisibleObjectsExtractor::Extract(
         VisualizeObject(view, pObject);
       }
     }
-#endif
   }
+#endif
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   const bool bIsMainView = (view.GetCameraUsageHint() == ezCameraUsageHint::MainView || view.GetCameraUsageHint() == ezCameraUsageHint::EditorView);
@@ -341,10 +402,10 @@ void ezVisibleObjectsExtractor::Extract(
 
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", "Extraction Stats:");
 
-    sb.SetFormat("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.SetFormat("Num Cached Render Data: {0}", (ezInt32)m_NumCachedRenderData);
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
 
-    sb.SetFormat("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.SetFormat("Num Uncached Render Data: {0}", (ezInt32)m_NumUncachedRenderData);
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
   }
 #endif
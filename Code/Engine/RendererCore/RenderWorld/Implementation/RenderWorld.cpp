@@ -95,8 +95,12 @@ namespace ezInternal
       {
       }
 
+      // Invalidated caches keep their entries until the end of the frame, so that concurrent lookups never see the storage change.
+      // The invalid version is outside the range of component versions and thus never matches.
+      static constexpr ezUInt32 InvalidVersion = 0xFFFFFFFF;
+
       ezHybridArray<RenderDataCacheEntry, 4> m_Entries;
-      ezUInt16 m_uiVersion = 0;
+      ezUInt32 m_uiVersion = InvalidVersion;
     };
 
     ezDynamicArray<PerObjectCache> m_PerObjectCaches;
@@ -651,8 +655,8 @@ void ezRenderWorld::DeleteCachedRenderDataInternal(const ezGameObjectHandle& hOw
 
       if (uiCacheIndex < perObjectCaches.GetCount())
       {
-        perObjectCaches[uiCacheIndex].m_Entries.Clear();
-        perObjectCaches[uiCacheIndex].m_uiVersion = 0;
+        // only invalidate, extraction might read the entries concurrently, they are cleaned up in UpdateRenderDataCache
+        perObjectCaches[uiCacheIndex].m_uiVersion = ezInternal::RenderDataCache::PerObjectCache::InvalidVersion;
       }
     }
   }
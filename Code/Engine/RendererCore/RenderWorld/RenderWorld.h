@@ -52,6 +52,7 @@ public:
   static void ClearMainViews();
   static ezArrayPtr<ezViewHandle> GetMainViews();
 
+  /// \brief Queues the given entries to be added to the render data cache of the view at the end of the frame. Can be called from multiple threads at once.
   static void CacheRenderData(const ezView& view, const ezGameObjectHandle& hOwnerObject, const ezComponentHandle& hOwnerComponent, ezUInt16 uiComponentVersion, ezArrayPtr<ezInternal::RenderDataCacheEntry> cacheEntries);
 
   static void DeleteAllCachedRenderData();
@@ -59,6 +60,11 @@ public:
   static void DeleteCachedRenderDataForObject(const ezGameObject* pOwnerObject);
   static void DeleteCachedRenderDataForObjectRecursive(const ezGameObject* pOwnerObject);
   static void ResetRenderDataCache(ezView& ref_view);
+
+  /// \brief Returns the cached render data of the given object or an empty array if there is none for the given component version.
+  ///
+  /// The lookup does not lock and can be called from multiple extraction threads at once. The cache of a view is only restructured
+  /// in EndFrame, invalidating cached render data during extraction only marks the entries as outdated.
   static ezArrayPtr<const ezInternal::RenderDataCacheEntry> GetCachedRenderData(const ezView& view, const ezGameObjectHandle& hOwner, ezUInt16 uiComponentVersion);
 
   static void AddViewToRender(const ezViewHandle& hView);
@@ -0,0 +1,292 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+ezGALCommandEncoderImplNull::ezGALCommandEncoderImplNull(ezGALDeviceNull& ref_deviceNull)
+  : m_GALDeviceNull(ref_deviceNull)
+{
+}
+
+ezGALCommandEncoderImplNull::~ezGALCommandEncoderImplNull() = default;
+
+// State setting functions
+
+void ezGALCommandEncoderImplNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  m_pBoundShader = pShader;
+}
+
+void ezGALCommandEncoderImplNull::SetConstantBufferPlatform(const ezShaderResourceBinding& binding, const ezGALBuffer* pBuffer)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetSamplerStatePlatform(const ezShaderResourceBinding& binding, const ezGALSamplerState* pSamplerState)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureResourceView* pResourceView)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferResourceView* pResourceView)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureUnorderedAccessView* pUnorderedAccessView)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferUnorderedAccessView* pUnorderedAccessView)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetPushConstantsPlatform(ezArrayPtr<const ezUInt8> data)
+{
+}
+
+// Query functions
+
+void ezGALCommandEncoderImplNull::BeginQueryPlatform(const ezGALQuery* pQuery)
+{
+}
+
+void ezGALCommandEncoderImplNull::EndQueryPlatform(const ezGALQuery* pQuery)
+{
+}
+
+ezResult ezGALCommandEncoderImplNull::GetQueryResultPlatform(const ezGALQuery* pQuery, ezUInt64& ref_uiQueryResult)
+{
+  // Nothing is ever rasterized, so occlusion queries never see any samples.
+  ref_uiQueryResult = 0;
+  return EZ_SUCCESS;
+}
+
+// Timestamp functions
+
+void ezGALCommandEncoderImplNull::InsertTimestampPlatform(ezGALTimestampHandle hTimestamp)
+{
+  m_GALDeviceNull.InsertTimestamp(hTimestamp);
+}
+
+// Resource update functions
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues)
+{
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues)
+{
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues)
+{
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues)
+{
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  EZ_ASSERT_DEV(pDestination->GetSize() == pSource->GetSize(), "Source and destination buffer sizes must match");
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  EZ_ASSERT_DEV(uiDestOffset + uiByteCount <= pDestination->GetSize(), "Copy region is out of bounds of the destination buffer");
+  EZ_ASSERT_DEV(uiSourceOffset + uiByteCount <= pSource->GetSize(), "Copy region is out of bounds of the source buffer");
+}
+
+void ezGALCommandEncoderImplNull::UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> sourceData, ezGALUpdateMode::Enum updateMode)
+{
+  EZ_ASSERT_DEV(uiDestOffset + sourceData.GetCount() <= pDestination->GetSize(), "Update region is out of bounds of the destination buffer");
+}
+
+void ezGALCommandEncoderImplNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+}
+
+void ezGALCommandEncoderImplNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezVec3U32& vDestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource, const ezBoundingBoxu32& box)
+{
+}
+
+void ezGALCommandEncoderImplNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezBoundingBoxu32& destinationBox, const ezGALSystemMemoryDescription& sourceData)
+{
+}
+
+void ezGALCommandEncoderImplNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource)
+{
+}
+
+void ezGALCommandEncoderImplNull::ReadbackTexturePlatform(const ezGALTexture* pTexture)
+{
+}
+
+void ezGALCommandEncoderImplNull::CopyTextureReadbackResultPlatform(const ezGALTexture* pTexture, ezArrayPtr<ezGALTextureSubresource> sourceSubResource, ezArrayPtr<ezGALSystemMemoryDescription> targetData)
+{
+  EZ_ASSERT_DEV(sourceSubResource.GetCount() == targetData.GetCount(), "Source and target arrays must be of the same size.");
+}
+
+void ezGALCommandEncoderImplNull::GenerateMipMapsPlatform(const ezGALTextureResourceView* pResourceView)
+{
+}
+
+void ezGALCommandEncoderImplNull::FlushPlatform()
+{
+}
+
+// Debug helper functions
+
+void ezGALCommandEncoderImplNull::PushMarkerPlatform(const char* szMarker)
+{
+}
+
+void ezGALCommandEncoderImplNull::PopMarkerPlatform()
+{
+}
+
+void ezGALCommandEncoderImplNull::InsertEventMarkerPlatform(const char* szMarker)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void ezGALCommandEncoderImplNull::BeginRendering(const ezGALRenderingSetup& renderingSetup)
+{
+  m_RenderTargetSetup = renderingSetup.m_RenderTargetSetup;
+}
+
+void ezGALCommandEncoderImplNull::BeginCompute()
+{
+}
+
+// Draw functions
+
+void ezGALCommandEncoderImplNull::ClearPlatform(const ezColor& clearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  return CountCommand(EZ_SUCCESS);
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  return CountCommand(ValidateIndexRange(uiIndexCount, uiStartIndex));
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  return CountCommand(ValidateIndexRange(uiIndexCountPerInstance, uiStartIndex));
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  if (m_pBoundIndexBuffer == nullptr)
+    return CountCommand(EZ_FAILURE);
+
+  // D3D11_DRAW_INDEXED_INSTANCED_INDIRECT_ARGS / VkDrawIndexedIndirectCommand
+  return CountCommand(ValidateIndirectArguments(pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 5 * sizeof(ezUInt32)));
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  return CountCommand(EZ_SUCCESS);
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  // D3D11_DRAW_INSTANCED_INDIRECT_ARGS / VkDrawIndirectCommand
+  return CountCommand(ValidateIndirectArguments(pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 4 * sizeof(ezUInt32)));
+}
+
+// State functions
+
+void ezGALCommandEncoderImplNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  m_pBoundIndexBuffer = pIndexBuffer;
+}
+
+void ezGALCommandEncoderImplNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  EZ_ASSERT_DEV(uiSlot < EZ_GAL_MAX_VERTEX_BUFFER_COUNT, "Invalid slot index");
+}
+
+void ezGALCommandEncoderImplNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum topology)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& blendFactor, ezUInt32 uiSampleMask)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+}
+
+void ezGALCommandEncoderImplNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezResult ezGALCommandEncoderImplNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  return CountCommand(m_pBoundShader != nullptr ? EZ_SUCCESS : EZ_FAILURE);
+}
+
+ezResult ezGALCommandEncoderImplNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  if (m_pBoundShader == nullptr)
+    return CountCommand(EZ_FAILURE);
+
+  return CountCommand(ValidateIndirectArguments(pIndirectArgumentBuffer, uiArgumentOffsetInBytes, 3 * sizeof(ezUInt32)));
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezResult ezGALCommandEncoderImplNull::ValidateIndexRange(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex) const
+{
+  if (m_pBoundIndexBuffer == nullptr)
+    return EZ_FAILURE;
+
+  const ezGALBufferCreationDescription& desc = m_pBoundIndexBuffer->GetDescription();
+  const ezUInt32 uiNumIndices = desc.m_uiStructSize > 0 ? desc.m_uiTotalSize / desc.m_uiStructSize : 0;
+
+  return uiStartIndex + uiIndexCount <= uiNumIndices ? EZ_SUCCESS : EZ_FAILURE;
+}
+
+ezResult ezGALCommandEncoderImplNull::ValidateIndirectArguments(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes, ezUInt32 uiArgumentSize) const
+{
+  if (pIndirectArgumentBuffer == nullptr || !pIndirectArgumentBuffer->GetDescription().m_BufferFlags.IsSet(ezGALBufferUsageFlags::DrawIndirect))
+    return EZ_FAILURE;
+
+  return uiArgumentOffsetInBytes + uiArgumentSize <= pIndirectArgumentBuffer->GetSize() ? EZ_SUCCESS : EZ_FAILURE;
+}
+
+ezResult ezGALCommandEncoderImplNull::CountCommand(ezResult result)
+{
+  if (result.Succeeded())
+    ++m_GALDeviceNull.m_uiNumSubmittedCommands;
+  else
+    ++m_GALDeviceNull.m_uiNumRejectedCommands;
+
+  return result;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_CommandEncoder_Implementation_CommandEncoderImplNull);
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <Foundation/Types/UniquePtr.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class ezGALPassNull;
+
+/// \brief A device implementation of the graphics abstraction layer that does not talk to any GPU.
+///
+/// All resources are created as plain CPU side objects without any backing storage and all commands are discarded after some light
+/// validation. This allows to run the whole renderer, e.g. extraction, sorting, batching and the render pipeline on machines without a GPU
+/// and to measure the CPU cost of it without any driver overhead.
+/// Timestamps return the CPU time at which they were inserted.
+class EZ_RENDERERNULL_DLL ezGALDeviceNull : public ezGALDevice
+{
+private:
+  friend ezInternal::NewInstance<ezGALDevice> CreateNullDevice(ezAllocator* pAllocator, const ezGALDeviceCreationDescription& description);
+  ezGALDeviceNull(const ezGALDeviceCreationDescription& Description);
+
+public:
+  virtual ~ezGALDeviceNull();
+
+public:
+  ezGALRenderCommandEncoder* GetRenderCommandEncoder() const;
+
+  /// \brief Returns the number of draw and dispatch calls that the command encoder accepted since the device was created.
+  ezUInt64 GetNumSubmittedCommands() const { return m_uiNumSubmittedCommands; }
+
+  /// \brief Returns the number of draw and dispatch calls that the command encoder rejected because of invalid state.
+  ezUInt64 GetNumRejectedCommands() const { return m_uiNumRejectedCommands; }
+
+  // These functions need to be implemented by a render API abstraction
+protected:
+  // Init & shutdown functions
+
+  virtual ezStringView GetRendererPlatform() override;
+  virtual ezResult InitPlatform() override;
+  virtual ezResult ShutdownPlatform() override;
+
+  // Pipeline & Pass functions
+
+  virtual void BeginPipelinePlatform(const char* szName, ezGALSwapChain* pSwapChain) override;
+  virtual void EndPipelinePlatform(ezGALSwapChain* pSwapChain) override;
+
+  virtual ezGALPass* BeginPassPlatform(const char* szName) override;
+  virtual void EndPassPlatform(ezGALPass* pPass) override;
+
+  virtual void FlushPlatform() override;
+
+
+  // State creation functions
+
+  virtual ezGALBlendState* CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description) override;
+  virtual void DestroyBlendStatePlatform(ezGALBlendState* pBlendState) override;
+
+  virtual ezGALDepthStencilState* CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description) override;
+  virtual void DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState) override;
+
+  virtual ezGALRasterizerState* CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description) override;
+  virtual void DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState) override;
+
+  virtual ezGALSamplerState* CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description) override;
+  virtual void DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState) override;
+
+
+  // Resource creation functions
+
+  virtual ezGALShader* CreateShaderPlatform(const ezGALShaderCreationDescription& Description) override;
+  virtual void DestroyShaderPlatform(ezGALShader* pShader) override;
+
+  virtual ezGALBuffer* CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData) override;
+  virtual void DestroyBufferPlatform(ezGALBuffer* pBuffer) override;
+
+  virtual ezGALTexture* CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData) override;
+  virtual void DestroyTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALTexture* CreateSharedTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle handle) override;
+  virtual void DestroySharedTexturePlatform(ezGALTexture* pTexture) override;
+
+  virtual ezGALTextureResourceView* CreateResourceViewPlatform(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description) override;
+  virtual void DestroyResourceViewPlatform(ezGALTextureResourceView* pResourceView) override;
+
+  virtual ezGALBufferResourceView* CreateResourceViewPlatform(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description) override;
+  virtual void DestroyResourceViewPlatform(ezGALBufferResourceView* pResourceView) override;
+
+  virtual ezGALRenderTargetView* CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description) override;
+  virtual void DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView) override;
+
+  ezGALTextureUnorderedAccessView* CreateUnorderedAccessViewPlatform(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description) override;
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALTextureUnorderedAccessView* pUnorderedAccessView) override;
+
+  ezGALBufferUnorderedAccessView* CreateUnorderedAccessViewPlatform(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description) override;
+  virtual void DestroyUnorderedAccessViewPlatform(ezGALBufferUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Other rendering creation functions
+
+  virtual ezGALQuery* CreateQueryPlatform(const ezGALQueryCreationDescription& Description) override;
+  virtual void DestroyQueryPlatform(ezGALQuery* pQuery) override;
+
+  virtual ezGALVertexDeclaration* CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description) override;
+  virtual void DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration) override;
+
+  // Timestamp functions
+
+  virtual ezGALTimestampHandle GetTimestampPlatform() override;
+  virtual ezResult GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result) override;
+
+  // Misc functions
+
+  virtual void BeginFramePlatform(const ezUInt64 uiRenderFrame) override;
+  virtual void EndFramePlatform() override;
+
+  virtual void FillCapabilitiesPlatform() override;
+
+  virtual void WaitIdlePlatform() override;
+
+  virtual const ezGALSharedTexture* GetSharedTexture(ezGALTextureHandle hTexture) const override;
+
+  /// \endcond
+
+private:
+  friend class ezGALCommandEncoderImplNull;
+
+  void InsertTimestamp(ezGALTimestampHandle hTimestamp);
+
+  ezUniquePtr<ezGALPassNull> m_pDefaultPass;
+
+  ezDynamicArray<ezTime, ezLocalAllocatorWrapper> m_Timestamps;
+  ezUInt32 m_uiNextTimestamp = 0;
+
+  ezUInt64 m_uiFrameCounter = 0;
+
+  ezUInt64 m_uiNumSubmittedCommands = 0;
+  ezUInt64 m_uiNumRejectedCommands = 0;
+};
@@ -0,0 +1,542 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/PassNull.h>
+#include <RendererNull/Device/SwapChainNull.h>
+#include <RendererNull/Resources/BufferNull.h>
+#include <RendererNull/Resources/QueryNull.h>
+#include <RendererNull/Resources/RenderTargetViewNull.h>
+#include <RendererNull/Resources/ResourceViewNull.h>
+#include <RendererNull/Resources/TextureNull.h>
+#include <RendererNull/Resources/UnorderedAccessViewNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+#include <RendererNull/Shader/VertexDeclarationNull.h>
+#include <RendererNull/State/StateNull.h>
+
+ezInternal::NewInstance<ezGALDevice> CreateNullDevice(ezAllocator* pAllocator, const ezGALDeviceCreationDescription& description)
+{
+  return EZ_NEW(pAllocator, ezGALDeviceNull, description);
+}
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(RendererNull, DeviceFactory)
+
+ON_CORESYSTEMS_STARTUP
+{
+  // There is no shader compiler for the null device, shaders are created from whatever byte code is passed in and never executed.
+  ezGALDeviceFactory::RegisterCreatorFunc("Null", &CreateNullDevice, "NULL", "");
+}
+
+ON_CORESYSTEMS_SHUTDOWN
+{
+  ezGALDeviceFactory::UnregisterCreatorFunc("Null");
+}
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+  , m_Timestamps(&m_Allocator)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+// Init & shutdown functions
+
+ezStringView ezGALDeviceNull::GetRendererPlatform()
+{
+  return "Null";
+}
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  EZ_LOG_BLOCK("ezGALDeviceNull::InitPlatform");
+
+  m_pDefaultPass = EZ_NEW(&m_Allocator, ezGALPassNull, *this);
+
+  // Match the conventions of the D3D style backends so that projection matrices computed on the CPU are identical.
+  ezClipSpaceDepthRange::Default = ezClipSpaceDepthRange::ZeroToOne;
+  ezClipSpaceYMode::RenderToTextureDefault = ezClipSpaceYMode::Regular;
+
+  m_Timestamps.SetCount(2048);
+  m_uiNextTimestamp = 0;
+  m_uiFrameCounter = 0;
+
+  ezGALWindowSwapChain::SetFactoryMethod([this](const ezGALWindowSwapChainCreationDescription& desc) -> ezGALSwapChainHandle
+    { return CreateSwapChain([&desc](ezAllocator* pAllocator) -> ezGALSwapChain*
+        { return EZ_NEW(pAllocator, ezGALSwapChainNull, desc); }); });
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  ezGALWindowSwapChain::SetFactoryMethod({});
+
+  m_Timestamps.Clear();
+  m_pDefaultPass = nullptr;
+
+  return EZ_SUCCESS;
+}
+
+// Pipeline & Pass functions
+
+void ezGALDeviceNull::BeginPipelinePlatform(const char* szName, ezGALSwapChain* pSwapChain)
+{
+  if (pSwapChain)
+  {
+    pSwapChain->AcquireNextRenderTarget(this);
+  }
+}
+
+void ezGALDeviceNull::EndPipelinePlatform(ezGALSwapChain* pSwapChain)
+{
+  if (pSwapChain)
+  {
+    pSwapChain->PresentRenderTarget(this);
+  }
+}
+
+ezGALPass* ezGALDeviceNull::BeginPassPlatform(const char* szName)
+{
+  return m_pDefaultPass.Borrow();
+}
+
+void ezGALDeviceNull::EndPassPlatform(ezGALPass* pPass)
+{
+  EZ_ASSERT_DEV(m_pDefaultPass.Borrow() == pPass, "Invalid pass");
+}
+
+void ezGALDeviceNull::FlushPlatform()
+{
+}
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  ezGALBlendStateNull* pState = EZ_NEW(&m_Allocator, ezGALBlendStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  ezGALBlendStateNull* pState = static_cast<ezGALBlendStateNull*>(pBlendState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  ezGALDepthStencilStateNull* pState = EZ_NEW(&m_Allocator, ezGALDepthStencilStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  ezGALDepthStencilStateNull* pState = static_cast<ezGALDepthStencilStateNull*>(pDepthStencilState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  ezGALRasterizerStateNull* pState = EZ_NEW(&m_Allocator, ezGALRasterizerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  ezGALRasterizerStateNull* pState = static_cast<ezGALRasterizerStateNull*>(pRasterizerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  ezGALSamplerStateNull* pState = EZ_NEW(&m_Allocator, ezGALSamplerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  ezGALSamplerStateNull* pState = static_cast<ezGALSamplerStateNull*>(pSamplerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  ezGALShaderNull* pShaderNull = EZ_NEW(&m_Allocator, ezGALShaderNull, Description);
+
+  if (pShaderNull->InitPlatform(this).Succeeded())
+  {
+    return pShaderNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pShaderNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  ezGALShaderNull* pShaderNull = static_cast<ezGALShaderNull*>(pShader);
+  pShaderNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pShaderNull);
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pBufferNull = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (pBufferNull->InitPlatform(this, pInitialData).Succeeded())
+  {
+    return pBufferNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pBufferNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  ezGALBufferNull* pBufferNull = static_cast<ezGALBufferNull*>(pBuffer);
+  pBufferNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pBufferNull);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pTextureNull = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (pTextureNull->InitPlatform(this, pInitialData).Succeeded())
+  {
+    return pTextureNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pTextureNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALTextureNull* pTextureNull = static_cast<ezGALTextureNull*>(pTexture);
+  pTextureNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pTextureNull);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateSharedTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle handle)
+{
+  ezLog::Error("Shared textures are not supported by the null device");
+  return nullptr;
+}
+
+void ezGALDeviceNull::DestroySharedTexturePlatform(ezGALTexture* pTexture)
+{
+  EZ_REPORT_FAILURE("Shared textures are not supported by the null device");
+}
+
+ezGALTextureResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description)
+{
+  ezGALTextureResourceViewNull* pResourceViewNull = EZ_NEW(&m_Allocator, ezGALTextureResourceViewNull, pResource, Description);
+
+  if (pResourceViewNull->InitPlatform(this).Succeeded())
+  {
+    return pResourceViewNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pResourceViewNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALTextureResourceView* pResourceView)
+{
+  ezGALTextureResourceViewNull* pResourceViewNull = static_cast<ezGALTextureResourceViewNull*>(pResourceView);
+  pResourceViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pResourceViewNull);
+}
+
+ezGALBufferResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description)
+{
+  ezGALBufferResourceViewNull* pResourceViewNull = EZ_NEW(&m_Allocator, ezGALBufferResourceViewNull, pResource, Description);
+
+  if (pResourceViewNull->InitPlatform(this).Succeeded())
+  {
+    return pResourceViewNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pResourceViewNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALBufferResourceView* pResourceView)
+{
+  ezGALBufferResourceViewNull* pResourceViewNull = static_cast<ezGALBufferResourceViewNull*>(pResourceView);
+  pResourceViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pResourceViewNull);
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  ezGALRenderTargetViewNull* pRenderTargetViewNull = EZ_NEW(&m_Allocator, ezGALRenderTargetViewNull, pTexture, Description);
+
+  if (pRenderTargetViewNull->InitPlatform(this).Succeeded())
+  {
+    return pRenderTargetViewNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pRenderTargetViewNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  ezGALRenderTargetViewNull* pRenderTargetViewNull = static_cast<ezGALRenderTargetViewNull*>(pRenderTargetView);
+  pRenderTargetViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pRenderTargetViewNull);
+}
+
+ezGALTextureUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALTextureUnorderedAccessViewNull* pUnorderedAccessViewNull = EZ_NEW(&m_Allocator, ezGALTextureUnorderedAccessViewNull, pResource, Description);
+
+  if (pUnorderedAccessViewNull->InitPlatform(this).Succeeded())
+  {
+    return pUnorderedAccessViewNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALTextureUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALTextureUnorderedAccessViewNull* pUnorderedAccessViewNull = static_cast<ezGALTextureUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pUnorderedAccessViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+}
+
+ezGALBufferUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALBufferUnorderedAccessViewNull* pUnorderedAccessViewNull = EZ_NEW(&m_Allocator, ezGALBufferUnorderedAccessViewNull, pResource, Description);
+
+  if (pUnorderedAccessViewNull->InitPlatform(this).Succeeded())
+  {
+    return pUnorderedAccessViewNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALBufferUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALBufferUnorderedAccessViewNull* pUnorderedAccessViewNull = static_cast<ezGALBufferUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pUnorderedAccessViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+}
+
+// Other rendering creation functions
+
+ezGALQuery* ezGALDeviceNull::CreateQueryPlatform(const ezGALQueryCreationDescription& Description)
+{
+  ezGALQueryNull* pQueryNull = EZ_NEW(&m_Allocator, ezGALQueryNull, Description);
+
+  if (pQueryNull->InitPlatform(this).Succeeded())
+  {
+    return pQueryNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pQueryNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyQueryPlatform(ezGALQuery* pQuery)
+{
+  ezGALQueryNull* pQueryNull = static_cast<ezGALQueryNull*>(pQuery);
+  pQueryNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pQueryNull);
+}
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  ezGALVertexDeclarationNull* pVertexDeclarationNull = EZ_NEW(&m_Allocator, ezGALVertexDeclarationNull, Description);
+
+  if (pVertexDeclarationNull->InitPlatform(this).Succeeded())
+  {
+    return pVertexDeclarationNull;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pVertexDeclarationNull);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  ezGALVertexDeclarationNull* pVertexDeclarationNull = static_cast<ezGALVertexDeclarationNull*>(pVertexDeclaration);
+  pVertexDeclarationNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pVertexDeclarationNull);
+}
+
+// Timestamp functions
+
+ezGALTimestampHandle ezGALDeviceNull::GetTimestampPlatform()
+{
+  ezUInt32 uiIndex = m_uiNextTimestamp;
+  m_uiNextTimestamp = (m_uiNextTimestamp + 1) % m_Timestamps.GetCount();
+  return {uiIndex, m_uiFrameCounter};
+}
+
+ezResult ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& result)
+{
+  // The ring buffer slot may have been reused since the timestamp was requested.
+  if (hTimestamp.m_uiFrameCounter + 4 < m_uiFrameCounter)
+  {
+    return EZ_FAILURE;
+  }
+
+  result = m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_uiIndex)];
+  return EZ_SUCCESS;
+}
+
+void ezGALDeviceNull::InsertTimestamp(ezGALTimestampHandle hTimestamp)
+{
+  m_Timestamps[static_cast<ezUInt32>(hTimestamp.m_uiIndex)] = ezTime::Now();
+}
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform(const ezUInt64 uiRenderFrame)
+{
+}
+
+void ezGALDeviceNull::EndFramePlatform()
+{
+  ++m_uiFrameCounter;
+}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = false;
+  m_Capabilities.m_bMultithreadedResourceCreation = true;
+  m_Capabilities.m_bNoOverwriteBufferUpdate = true;
+
+  for (ezUInt32 i = 0; i < ezGALShaderStage::ENUM_COUNT; ++i)
+  {
+    m_Capabilities.m_bShaderStageSupported[i] = true;
+  }
+
+  m_Capabilities.m_bInstancing = true;
+  m_Capabilities.m_b32BitIndices = true;
+  m_Capabilities.m_bIndirectDraw = true;
+  m_Capabilities.m_bConservativeRasterization = true;
+  m_Capabilities.m_bVertexShaderRenderTargetArrayIndex = true;
+  m_Capabilities.m_uiMaxConstantBuffers = 14;
+  m_Capabilities.m_uiMaxPushConstantsSize = 128;
+  m_Capabilities.m_bTextureArrays = true;
+  m_Capabilities.m_bCubemapArrays = true;
+  m_Capabilities.m_bSharedTextures = false;
+  m_Capabilities.m_uiMaxTextureDimension = 16384;
+  m_Capabilities.m_uiMaxCubemapDimension = 16384;
+  m_Capabilities.m_uiMax3DTextureDimension = 2048;
+  m_Capabilities.m_uiMaxAnisotropy = 16;
+  m_Capabilities.m_uiMaxRendertargets = 8;
+  m_Capabilities.m_uiUAVCount = 64;
+  m_Capabilities.m_bAlphaToCoverage = true;
+
+  m_Capabilities.m_FormatSupport.SetCount(ezGALResourceFormat::ENUM_COUNT);
+  for (ezUInt32 i = 0; i < ezGALResourceFormat::ENUM_COUNT; ++i)
+  {
+    const ezGALResourceFormat::Enum format = (ezGALResourceFormat::Enum)i;
+    if (ezGALResourceFormat::IsDepthFormat(format))
+    {
+      m_Capabilities.m_FormatSupport[i] = ezGALResourceFormatSupport::Texture | ezGALResourceFormatSupport::RenderTarget;
+    }
+    else
+    {
+      m_Capabilities.m_FormatSupport[i] = ezGALResourceFormatSupport::Texture | ezGALResourceFormatSupport::RenderTarget | ezGALResourceFormatSupport::TextureRW | ezGALResourceFormatSupport::VertexAttribute | ezGALResourceFormatSupport::MSAA2x | ezGALResourceFormatSupport::MSAA4x | ezGALResourceFormatSupport::MSAA8x;
+    }
+  }
+}
+
+void ezGALDeviceNull::WaitIdlePlatform()
+{
+  DestroyDeadObjects();
+}
+
+const ezGALSharedTexture* ezGALDeviceNull::GetSharedTexture(ezGALTextureHandle hTexture) const
+{
+  return nullptr;
+}
+
+ezGALRenderCommandEncoder* ezGALDeviceNull::GetRenderCommandEncoder() const
+{
+  return m_pDefaultPass->m_pRenderCommandEncoder.Borrow();
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_DeviceNull);
@@ -0,0 +1,48 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererFoundation/CommandEncoder/CommandEncoderState.h>
+#include <RendererFoundation/CommandEncoder/ComputeCommandEncoder.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/PassNull.h>
+
+ezGALPassNull::ezGALPassNull(ezGALDevice& device)
+  : ezGALPass(device)
+{
+  m_pCommandEncoderState = EZ_DEFAULT_NEW(ezGALCommandEncoderRenderState);
+  m_pCommandEncoderImpl = EZ_DEFAULT_NEW(ezGALCommandEncoderImplNull, static_cast<ezGALDeviceNull&>(device));
+
+  m_pRenderCommandEncoder = EZ_DEFAULT_NEW(ezGALRenderCommandEncoder, device, *m_pCommandEncoderState, *m_pCommandEncoderImpl, *m_pCommandEncoderImpl);
+  m_pComputeCommandEncoder = EZ_DEFAULT_NEW(ezGALComputeCommandEncoder, device, *m_pCommandEncoderState, *m_pCommandEncoderImpl, *m_pCommandEncoderImpl);
+
+  m_pCommandEncoderImpl->m_pOwner = m_pRenderCommandEncoder.Borrow();
+}
+
+ezGALPassNull::~ezGALPassNull() = default;
+
+ezGALRenderCommandEncoder* ezGALPassNull::BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup, const char* szName)
+{
+  m_pCommandEncoderImpl->BeginRendering(renderingSetup);
+
+  return m_pRenderCommandEncoder.Borrow();
+}
+
+void ezGALPassNull::EndRenderingPlatform(ezGALRenderCommandEncoder* pCommandEncoder)
+{
+  EZ_ASSERT_DEV(m_pRenderCommandEncoder.Borrow() == pCommandEncoder, "Invalid command encoder");
+}
+
+ezGALComputeCommandEncoder* ezGALPassNull::BeginComputePlatform(const char* szName)
+{
+  m_pCommandEncoderImpl->BeginCompute();
+
+  return m_pComputeCommandEncoder.Borrow();
+}
+
+void ezGALPassNull::EndComputePlatform(ezGALComputeCommandEncoder* pCommandEncoder)
+{
+  EZ_ASSERT_DEV(m_pComputeCommandEncoder.Borrow() == pCommandEncoder, "Invalid command encoder");
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_PassNull);
@@ -0,0 +1,83 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <Core/System/Window.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/Device/SwapChainNull.h>
+
+void ezGALSwapChainNull::AcquireNextRenderTarget(ezGALDevice* pDevice)
+{
+}
+
+void ezGALSwapChainNull::PresentRenderTarget(ezGALDevice* pDevice)
+{
+}
+
+ezResult ezGALSwapChainNull::UpdateSwapChain(ezGALDevice* pDevice, ezEnum<ezGALPresentMode> newPresentMode)
+{
+  m_CurrentPresentMode = newPresentMode;
+
+  DestroyBackBufferInternal(pDevice);
+  return CreateBackBufferInternal(pDevice);
+}
+
+ezGALSwapChainNull::ezGALSwapChainNull(const ezGALWindowSwapChainCreationDescription& Description)
+  : ezGALWindowSwapChain(Description)
+{
+}
+
+ezGALSwapChainNull::~ezGALSwapChainNull() = default;
+
+ezResult ezGALSwapChainNull::InitPlatform(ezGALDevice* pDevice)
+{
+  m_CurrentPresentMode = m_WindowDesc.m_InitialPresentMode;
+
+  EZ_SUCCEED_OR_RETURN(CreateBackBufferInternal(pDevice));
+
+  m_WindowDesc.m_pWindow->AddReference();
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALSwapChainNull::CreateBackBufferInternal(ezGALDevice* pDevice)
+{
+  ezGALTextureCreationDescription TexDesc;
+  TexDesc.m_uiWidth = m_WindowDesc.m_pWindow->GetClientAreaSize().width;
+  TexDesc.m_uiHeight = m_WindowDesc.m_pWindow->GetClientAreaSize().height;
+  TexDesc.m_SampleCount = m_WindowDesc.m_SampleCount;
+  TexDesc.m_Format = m_WindowDesc.m_BackBufferFormat;
+  TexDesc.m_bAllowShaderResourceView = false;
+  TexDesc.m_bCreateRenderTarget = true;
+  TexDesc.m_ResourceAccess.m_bImmutable = true;
+  TexDesc.m_ResourceAccess.m_bReadBack = m_WindowDesc.m_bAllowScreenshots;
+
+  m_hBackBufferTexture = pDevice->CreateTexture(TexDesc);
+  if (m_hBackBufferTexture.IsInvalidated())
+  {
+    ezLog::Error("Couldn't create backbuffer texture of the null swap chain");
+    return EZ_FAILURE;
+  }
+
+  m_RenderTargets.m_hRTs[0] = m_hBackBufferTexture;
+  m_CurrentSize = ezSizeU32(TexDesc.m_uiWidth, TexDesc.m_uiHeight);
+  return EZ_SUCCESS;
+}
+
+void ezGALSwapChainNull::DestroyBackBufferInternal(ezGALDevice* pDevice)
+{
+  if (!m_hBackBufferTexture.IsInvalidated())
+  {
+    pDevice->DestroyTexture(m_hBackBufferTexture);
+    m_hBackBufferTexture.Invalidate();
+  }
+
+  m_RenderTargets.m_hRTs[0].Invalidate();
+}
+
+ezResult ezGALSwapChainNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  DestroyBackBufferInternal(pDevice);
+
+  m_WindowDesc.m_pWindow->RemoveReference();
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_SwapChainNull);
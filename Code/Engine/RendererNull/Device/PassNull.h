@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Foundation/Types/UniquePtr.h>
+#include <RendererFoundation/Device/Pass.h>
+
+struct ezGALCommandEncoderRenderState;
+class ezGALRenderCommandEncoder;
+class ezGALComputeCommandEncoder;
+
+class ezGALCommandEncoderImplNull;
+
+class ezGALPassNull : public ezGALPass
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALPassNull(ezGALDevice& device);
+  virtual ~ezGALPassNull();
+
+  virtual ezGALRenderCommandEncoder* BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup, const char* szName) override;
+  virtual void EndRenderingPlatform(ezGALRenderCommandEncoder* pCommandEncoder) override;
+
+  virtual ezGALComputeCommandEncoder* BeginComputePlatform(const char* szName) override;
+  virtual void EndComputePlatform(ezGALComputeCommandEncoder* pCommandEncoder) override;
+
+private:
+  ezUniquePtr<ezGALCommandEncoderRenderState> m_pCommandEncoderState;
+  ezUniquePtr<ezGALCommandEncoderImplNull> m_pCommandEncoderImpl;
+
+  ezUniquePtr<ezGALRenderCommandEncoder> m_pRenderCommandEncoder;
+  ezUniquePtr<ezGALComputeCommandEncoder> m_pComputeCommandEncoder;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <RendererFoundation/Descriptors/Descriptors.h>
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererNull/RendererNullDLL.h>
+
+/// \brief Window swap chain of the null device. The back buffer is a regular render target texture that is never presented.
+class ezGALSwapChainNull : public ezGALWindowSwapChain
+{
+public:
+  virtual void AcquireNextRenderTarget(ezGALDevice* pDevice) override;
+  virtual void PresentRenderTarget(ezGALDevice* pDevice) override;
+  virtual ezResult UpdateSwapChain(ezGALDevice* pDevice, ezEnum<ezGALPresentMode> newPresentMode) override;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSwapChainNull(const ezGALWindowSwapChainCreationDescription& Description);
+
+  virtual ~ezGALSwapChainNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  ezResult CreateBackBufferInternal(ezGALDevice* pDevice);
+  void DestroyBackBufferInternal(ezGALDevice* pDevice);
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  ezGALTextureHandle m_hBackBufferTexture;
+  ezEnum<ezGALPresentMode> m_CurrentPresentMode;
+};
@@ -0,0 +1,32 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/BufferNull.h>
+
+ezGALBufferNull::ezGALBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALBuffer(Description)
+{
+}
+
+ezGALBufferNull::~ezGALBufferNull() = default;
+
+ezResult ezGALBufferNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  if (!pInitialData.IsEmpty() && pInitialData.GetCount() < m_Description.m_uiTotalSize)
+  {
+    ezLog::Error("Initial data of buffer is too small ({0} bytes, expected {1} bytes)", pInitialData.GetCount(), m_Description.m_uiTotalSize);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALBufferNull::SetDebugNamePlatform(const char* szName) const
+{
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_BufferNull);
@@ -0,0 +1,41 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/ResourceViewNull.h>
+
+ezGALTextureResourceViewNull::ezGALTextureResourceViewNull(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description)
+  : ezGALTextureResourceView(pResource, Description)
+{
+}
+
+ezGALTextureResourceViewNull::~ezGALTextureResourceViewNull() = default;
+
+ezResult ezGALTextureResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALBufferResourceViewNull::ezGALBufferResourceViewNull(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description)
+  : ezGALBufferResourceView(pResource, Description)
+{
+}
+
+ezGALBufferResourceViewNull::~ezGALBufferResourceViewNull() = default;
+
+ezResult ezGALBufferResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_ResourceViewNull);
@@ -0,0 +1,32 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/TextureNull.h>
+
+ezGALTextureNull::ezGALTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALTexture(Description)
+{
+}
+
+ezGALTextureNull::~ezGALTextureNull() = default;
+
+ezResult ezGALTextureNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  if (m_Description.m_pExisitingNativeObject != nullptr)
+  {
+    ezLog::Error("The null device can't wrap existing native textures");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+void ezGALTextureNull::SetDebugNamePlatform(const char* szName) const
+{
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_TextureNull);
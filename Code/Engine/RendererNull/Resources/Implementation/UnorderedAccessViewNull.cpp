@@ -0,0 +1,41 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/UnorderedAccessViewNull.h>
+
+ezGALTextureUnorderedAccessViewNull::ezGALTextureUnorderedAccessViewNull(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description)
+  : ezGALTextureUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALTextureUnorderedAccessViewNull::~ezGALTextureUnorderedAccessViewNull() = default;
+
+ezResult ezGALTextureUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezGALBufferUnorderedAccessViewNull::ezGALBufferUnorderedAccessViewNull(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description)
+  : ezGALBufferUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALBufferUnorderedAccessViewNull::~ezGALBufferUnorderedAccessViewNull() = default;
+
+ezResult ezGALBufferUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Resources_Implementation_UnorderedAccessViewNull);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Query.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class EZ_RENDERERNULL_DLL ezGALQueryNull : public ezGALQuery
+{
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALQueryNull(const ezGALQueryCreationDescription& Description);
+  ~ezGALQueryNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
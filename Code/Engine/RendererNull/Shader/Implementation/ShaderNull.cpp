@@ -0,0 +1,28 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Shader/ShaderNull.h>
+
+ezGALShaderNull::ezGALShaderNull(const ezGALShaderCreationDescription& Description)
+  : ezGALShader(Description)
+{
+}
+
+ezGALShaderNull::~ezGALShaderNull() = default;
+
+void ezGALShaderNull::SetDebugName(const char* szName) const
+{
+}
+
+ezResult ezGALShaderNull::InitPlatform(ezGALDevice* pDevice)
+{
+  // The byte code is never executed, but the binding mapping is still needed to validate resource bindings.
+  return CreateBindingMapping();
+}
+
+ezResult ezGALShaderNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  DestroyBindingMapping();
+  return EZ_SUCCESS;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Shader_Implementation_ShaderNull);
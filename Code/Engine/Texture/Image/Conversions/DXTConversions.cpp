@@ -2,6 +2,7 @@
 
 #include <Foundation/Math/Color16f.h>
 #include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Texture/Image/Conversions/DXTConversions.h>
 #include <Texture/Image/Conversions/PixelConversions.h>
 #include <Texture/Image/ImageConversion.h>
@@ -2951,32 +2952,37 @@ class ezImageConversion_CompressBC4 : public ezImageConversionStepCompressBlocks
       bias = 128;
     }
 
-    for (ezUInt32 blockY = 0; blockY < numBlocksY; ++blockY)
-    {
-      for (ezUInt32 blockX = 0; blockX < numBlocksX; ++blockX)
-      {
-        ezUInt8 sourceBlock[16];
+    const ezUInt8* pSource = source.GetPtr();
+    ezUInt8* pTarget = target.GetPtr();
 
-        for (ezUInt32 y = 0; y < 4; ++y)
+    ezTaskSystem::ParallelForIndexed(0, numBlocksY, [pSource, pTarget, numBlocksX, stride, rowPitch, bias](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+      for (ezUInt32 blockY = uiStartIndex; blockY < uiEndIndex; ++blockY)
+      {
+        for (ezUInt32 blockX = 0; blockX < numBlocksX; ++blockX)
         {
-          const ezUInt8* sourcePointer = static_cast<const ezUInt8*>(source.GetPtr()) + (4 * blockY + y) * rowPitch;
+          ezUInt8 sourceBlock[16];
 
-          for (ezUInt32 x = 0; x < 4; ++x)
+          for (ezUInt32 y = 0; y < 4; ++y)
           {
-            sourceBlock[4 * y + x] = sourcePointer[(x + 4 * blockX) * stride] + bias;
+            const ezUInt8* sourcePointer = pSource + (4 * blockY + y) * rowPitch;
+
+            for (ezUInt32 x = 0; x < 4; ++x)
+            {
+              sourceBlock[4 * y + x] = sourcePointer[(x + 4 * blockX) * stride] + bias;
+            }
           }
-        }
 
-        ezUInt32 a0, a1;
-        findBestPaletteBC4(sourceBlock, a0, a1);
+          ezUInt32 a0, a1;
+          findBestPaletteBC4(sourceBlock, a0, a1);
 
-        ezUInt8* targetPointer = static_cast<ezUInt8*>(target.GetPtr()) + (blockY * numBlocksX + blockX) * 8;
-        packBlockBC4(sourceBlock, a0, a1, targetPointer);
+          ezUInt8* targetPointer = pTarget + (blockY * numBlocksX + blockX) * 8;
+          packBlockBC4(sourceBlock, a0, a1, targetPointer);
 
-        targetPointer[0] -= bias;
-        targetPointer[1] -= bias;
-      }
-    }
+          targetPointer[0] -= bias;
+          targetPointer[1] -= bias;
+        }
+      } }, "CompressBC4");
 
     return EZ_SUCCESS;
   }
@@ -3008,47 +3014,52 @@ class ezImageConversion_CompressBC5 : public ezImageConversionStepCompressBlocks
       bias = 128;
     }
 
-    for (ezUInt32 blockY = 0; blockY < numBlocksY; ++blockY)
-    {
-      for (ezUInt32 blockX = 0; blockX < numBlocksX; ++blockX)
-      {
-        ezUInt8 sourceBlockR[16];
-        ezUInt8 sourceBlockG[16];
+    const ezUInt8* pSource = source.GetPtr();
+    ezUInt8* pTarget = target.GetPtr();
 
-        for (ezUInt32 y = 0; y < 4; ++y)
+    ezTaskSystem::ParallelForIndexed(0, numBlocksY, [pSource, pTarget, numBlocksX, stride, rowPitch, bias](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+      for (ezUInt32 blockY = uiStartIndex; blockY < uiEndIndex; ++blockY)
+      {
+        for (ezUInt32 blockX = 0; blockX < numBlocksX; ++blockX)
         {
-          const ezUInt8* sourcePointer = static_cast<const ezUInt8*>(source.GetPtr()) + (4 * blockY + y) * rowPitch;
+          ezUInt8 sourceBlockR[16];
+          ezUInt8 sourceBlockG[16];
 
-          for (ezUInt32 x = 0; x < 4; ++x)
+          for (ezUInt32 y = 0; y < 4; ++y)
           {
-            sourceBlockR[4 * y + x] = sourcePointer[(x + 4 * blockX) * stride + 0] + bias;
-            sourceBlockG[4 * y + x] = sourcePointer[(x + 4 * blockX) * stride + 1] + bias;
+            const ezUInt8* sourcePointer = pSource + (4 * blockY + y) * rowPitch;
+
+            for (ezUInt32 x = 0; x < 4; ++x)
+            {
+              sourceBlockR[4 * y + x] = sourcePointer[(x + 4 * blockX) * stride + 0] + bias;
+              sourceBlockG[4 * y + x] = sourcePointer[(x + 4 * blockX) * stride + 1] + bias;
+            }
           }
-        }
 
-        ezUInt8* targetPointer = static_cast<ezUInt8*>(target.GetPtr()) + (blockY * numBlocksX + blockX) * 16;
+          ezUInt8* targetPointer = pTarget + (blockY * numBlocksX + blockX) * 16;
 
-        {
-          ezUInt32 a0, a1;
-          findBestPaletteBC4(sourceBlockR, a0, a1);
-          packBlockBC4(sourceBlockR, a0, a1, targetPointer);
+          {
+            ezUInt32 a0, a1;
+            findBestPaletteBC4(sourceBlockR, a0, a1);
+            packBlockBC4(sourceBlockR, a0, a1, targetPointer);
 
-          // Undo biasing for signed formats by shifting palette upper and lower bound back into signed range
-          targetPointer[0] -= bias;
-          targetPointer[1] -= bias;
-        }
+            // Undo biasing for signed formats by shifting palette upper and lower bound back into signed range
+            targetPointer[0] -= bias;
+            targetPointer[1] -= bias;
+          }
 
-        {
-          ezUInt32 a0, a1;
-          findBestPaletteBC4(sourceBlockG, a0, a1);
-          packBlockBC4(sourceBlockG, a0, a1, targetPointer + 8);
+          {
+            ezUInt32 a0, a1;
+            findBestPaletteBC4(sourceBlockG, a0, a1);
+            packBlockBC4(sourceBlockG, a0, a1, targetPointer + 8);
 
-          // Undo biasing for signed formats by shifting palette upper and lower bound back into signed range
-          targetPointer[8] -= bias;
-          targetPointer[9] -= bias;
+            // Undo biasing for signed formats by shifting palette upper and lower bound back into signed range
+            targetPointer[8] -= bias;
+            targetPointer[9] -= bias;
+          }
         }
-      }
-    }
+      } }, "CompressBC5");
 
     return EZ_SUCCESS;
   }
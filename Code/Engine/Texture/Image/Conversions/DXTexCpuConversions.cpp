@@ -5,127 +5,181 @@
 #  include <Texture/DirectXTex/BC.h>
 #  include <Texture/Image/ImageConversion.h>
 
+#  include <Foundation/Configuration/CVar.h>
 #  include <Foundation/Threading/TaskSystem.h>
 
-  ezImageConversionEntry g_DXTexCpuConversions[] = {
+ezCVarInt cvar_TextureCpuCompressionQuality("Texture.CpuCompressionQuality", 1, ezCVarFlags::Default, "Quality preset for CPU based BC7 compression: 0 = fast (mode 6 only), 1 = balanced, 2 = best (also tries modes 0 and 2). All other formats ignore it.");
+
+ezImageConversionEntry g_DXTexCpuConversions[] = {
   ezImageConversionEntry(ezImageFormat::R32G32B32A32_FLOAT, ezImageFormat::BC6H_UF16, ezImageConversionFlags::Default),
 
   ezImageConversionEntry(ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC1_UNORM, ezImageConversionFlags::Default),
+  ezImageConversionEntry(ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC3_UNORM, ezImageConversionFlags::Default),
   ezImageConversionEntry(ezImageFormat::R8G8B8A8_UNORM, ezImageFormat::BC7_UNORM, ezImageConversionFlags::Default),
 
   ezImageConversionEntry(ezImageFormat::R8G8B8A8_UNORM_SRGB, ezImageFormat::BC1_UNORM_SRGB, ezImageConversionFlags::Default),
+  ezImageConversionEntry(ezImageFormat::R8G8B8A8_UNORM_SRGB, ezImageFormat::BC3_UNORM_SRGB, ezImageConversionFlags::Default),
   ezImageConversionEntry(ezImageFormat::R8G8B8A8_UNORM_SRGB, ezImageFormat::BC7_UNORM_SRGB, ezImageConversionFlags::Default),
 };
 
-class ezImageConversion_CompressDxTexCpu : public ezImageConversionStepCompressBlocks
+namespace
 {
-public:
-  virtual ezArrayPtr<const ezImageConversionEntry> GetSupportedConversions() const override
+  using EncodeBlockFunc = void (*)(ezUInt8* pTarget, const DirectX::XMVECTOR* pColors, ezUInt32 uiFlags);
+
+  void EncodeBlockBC1(ezUInt8* pTarget, const DirectX::XMVECTOR* pColors, ezUInt32 uiFlags)
   {
-    return g_DXTexCpuConversions;
+    DirectX::D3DXEncodeBC1(pTarget, pColors, 1.0f, uiFlags);
   }
 
-  virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
-    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat) const override
+  void EncodeBlockBC3(ezUInt8* pTarget, const DirectX::XMVECTOR* pColors, ezUInt32 uiFlags)
   {
-    if (targetFormat == ezImageFormat::BC7_UNORM || targetFormat == ezImageFormat::BC7_UNORM_SRGB)
-    {
-      const ezUInt32 srcStride = numBlocksX * 4 * 4;
-      const ezUInt32 targetStride = numBlocksX * 16;
+    DirectX::D3DXEncodeBC3(pTarget, pColors, uiFlags);
+  }
 
-      ezTaskSystem::ParallelForIndexed(0, numBlocksY, [srcStride, targetStride, source, target, numBlocksX](ezUInt32 startIndex, ezUInt32 endIndex)
-        {
-        const ezUInt8* srcIt = source.GetPtr() + srcStride * startIndex * 4;
-        ezUInt8* targetIt = target.GetPtr() + targetStride * startIndex;
-        for (ezUInt32 blockY = startIndex; blockY < endIndex; ++blockY)
-        {
-          for (ezUInt32 blockX = 0; blockX < numBlocksX; ++blockX)
-          {
-            DirectX::XMVECTOR temp[16];
-            for (ezUInt32 y = 0; y < 4; y++)
-            {
-              for (ezUInt32 x = 0; x < 4; x++)
-              {
-                const ezUInt8* pixel = srcIt + y * srcStride + x * 4;
-                temp[y * 4 + x] = DirectX::XMVectorSet(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, pixel[3] / 255.0f);
-              }
-            }
-            DirectX::D3DXEncodeBC7(targetIt, temp, 0);
+  void EncodeBlockBC6H(ezUInt8* pTarget, const DirectX::XMVECTOR* pColors, ezUInt32 uiFlags)
+  {
+    DirectX::D3DXEncodeBC6HU(pTarget, pColors, uiFlags);
+  }
 
-            srcIt += 4 * 4;
-            targetIt += 16;
-          }
-          srcIt += 3 * srcStride;
-        } });
+  void EncodeBlockBC7(ezUInt8* pTarget, const DirectX::XMVECTOR* pColors, ezUInt32 uiFlags)
+  {
+    DirectX::D3DXEncodeBC7(pTarget, pColors, uiFlags);
+  }
 
-      return EZ_SUCCESS;
+  /// Maps the quality preset to the DirectXTex encoder flags.
+  ///
+  /// Only the BC7 encoder has modes that trade speed for quality. The BC1 and BC3 encoders always do the same amount of work,
+  /// their flags only select the error weighting or dithering, so they keep the perceptual weighting for every preset.
+  /// The BC6H encoder ignores all flags.
+  ezUInt32 GetCompressionFlags(ezImageFormat::Enum targetFormat)
+  {
+    const ezInt32 iQuality = cvar_TextureCpuCompressionQuality;
+
+    switch (targetFormat)
+    {
+      case ezImageFormat::BC7_UNORM:
+      case ezImageFormat::BC7_UNORM_SRGB:
+        if (iQuality <= 0)
+          return DirectX::BC_FLAGS_FORCE_BC7_MODE6;
+        if (iQuality >= 2)
+          return DirectX::BC_FLAGS_USE_3SUBSETS;
+        return DirectX::BC_FLAGS_NONE;
+
+      default:
+        return DirectX::BC_FLAGS_NONE;
     }
-    else if (targetFormat == ezImageFormat::BC1_UNORM || targetFormat == ezImageFormat::BC1_UNORM_SRGB)
+  }
+
+  struct CompressBlocksJob
+  {
+    const ezUInt8* m_pSource = nullptr;
+    ezUInt8* m_pTarget = nullptr;
+    ezUInt32 m_uiNumBlocksX = 0;
+    ezUInt32 m_uiBytesPerPixel = 0;
+    ezUInt32 m_uiBytesPerBlock = 0;
+    ezUInt32 m_uiFlags = 0;
+    bool m_bFloatSource = false;
+    EncodeBlockFunc m_EncodeBlock = nullptr;
+
+    void CompressBlockRows(ezUInt32 uiStartRow, ezUInt32 uiEndRow) const
     {
-      const ezUInt32 srcStride = numBlocksX * 4 * 4;
-      const ezUInt32 targetStride = numBlocksX * 8;
+      const ezUInt32 srcStride = m_uiNumBlocksX * 4 * m_uiBytesPerPixel;
+      const ezUInt32 targetStride = m_uiNumBlocksX * m_uiBytesPerBlock;
 
-      ezTaskSystem::ParallelForIndexed(0, numBlocksY, [srcStride, targetStride, source, target, numBlocksX](ezUInt32 startIndex, ezUInt32 endIndex)
-        {
-        const ezUInt8* srcIt = source.GetPtr() + srcStride * startIndex * 4;
-        ezUInt8* targetIt = target.GetPtr() + targetStride * startIndex;
-        for (ezUInt32 blockY = startIndex; blockY < endIndex; ++blockY)
+      DirectX::XMVECTOR temp[16];
+
+      for (ezUInt32 blockY = uiStartRow; blockY < uiEndRow; ++blockY)
+      {
+        const ezUInt8* srcIt = m_pSource + srcStride * blockY * 4;
+        ezUInt8* targetIt = m_pTarget + targetStride * blockY;
+
+        for (ezUInt32 blockX = 0; blockX < m_uiNumBlocksX; ++blockX)
         {
-          for (ezUInt32 blockX = 0; blockX < numBlocksX; ++blockX)
+          for (ezUInt32 y = 0; y < 4; y++)
           {
-            DirectX::XMVECTOR temp[16];
-            for (ezUInt32 y = 0; y < 4; y++)
+            for (ezUInt32 x = 0; x < 4; x++)
             {
-              for (ezUInt32 x = 0; x < 4; x++)
+              const ezUInt8* pixel = srcIt + y * srcStride + x * m_uiBytesPerPixel;
+
+              if (m_bFloatSource)
+              {
+                const float* pixelF = reinterpret_cast<const float*>(pixel);
+                temp[y * 4 + x] = DirectX::XMVectorSet(pixelF[0], pixelF[1], pixelF[2], pixelF[3]);
+              }
+              else
               {
-                const ezUInt8* pixel = srcIt + y * srcStride + x * 4;
                 temp[y * 4 + x] = DirectX::XMVectorSet(pixel[0] / 255.0f, pixel[1] / 255.0f, pixel[2] / 255.0f, pixel[3] / 255.0f);
               }
             }
-            DirectX::D3DXEncodeBC1(targetIt, temp, 1.0f, 0);
-
-            srcIt += 4 * 4;
-            targetIt += 8;
           }
-          srcIt += 3 * srcStride;
-        } });
 
-      return EZ_SUCCESS;
+          m_EncodeBlock(targetIt, temp, m_uiFlags);
+
+          srcIt += 4 * m_uiBytesPerPixel;
+          targetIt += m_uiBytesPerBlock;
+        }
+      }
     }
-    else if (targetFormat == ezImageFormat::BC6H_UF16)
-    {
-      const ezUInt32 srcStride = numBlocksX * 4 * 4 * sizeof(float);
-      const ezUInt32 targetStride = numBlocksX * 16;
 
-      ezTaskSystem::ParallelForIndexed(0, numBlocksY, [srcStride, targetStride, source, target, numBlocksX](ezUInt32 startIndex, ezUInt32 endIndex)
-        {
-        const ezUInt8* srcIt = source.GetPtr() + srcStride * startIndex * 4;
-        ezUInt8* targetIt = target.GetPtr() + targetStride * startIndex;
-        for (ezUInt32 blockY = startIndex; blockY < endIndex; ++blockY)
-        {
-          for (ezUInt32 blockX = 0; blockX < numBlocksX; ++blockX)
-          {
-            DirectX::XMVECTOR temp[16];
-            for (ezUInt32 y = 0; y < 4; y++)
-            {
-              for (ezUInt32 x = 0; x < 4; x++)
-              {
-                const float* pixel = reinterpret_cast<const float*>(srcIt + y * srcStride + x * 4 * sizeof(float));
-                temp[y * 4 + x] = DirectX::XMVectorSet(pixel[0], pixel[1], pixel[2], pixel[3]);
-              }
-            }
-            DirectX::D3DXEncodeBC6HU(targetIt, temp, 0);
+    /// Every block row is independent, so they are spread across all worker threads.
+    void Run(ezUInt32 uiNumBlockRows) const
+    {
+      const CompressBlocksJob* pJob = this;
+      ezTaskSystem::ParallelForIndexed(0, uiNumBlockRows, [pJob](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+        { pJob->CompressBlockRows(uiStartIndex, uiEndIndex); }, "CompressBlocks");
+    }
+  };
+} // namespace
 
-            srcIt += 4 * 4 * sizeof(float);
-            targetIt += 16;
-          }
-          srcIt += 3 * srcStride;
-        } });
+class ezImageConversion_CompressDxTexCpu : public ezImageConversionStepCompressBlocks
+{
+public:
+  virtual ezArrayPtr<const ezImageConversionEntry> GetSupportedConversions() const override
+  {
+    return g_DXTexCpuConversions;
+  }
 
-      return EZ_SUCCESS;
+  virtual ezResult CompressBlocks(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt32 numBlocksX, ezUInt32 numBlocksY,
+    ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat) const override
+  {
+    CompressBlocksJob job;
+    job.m_pSource = source.GetPtr();
+    job.m_pTarget = target.GetPtr();
+    job.m_uiNumBlocksX = numBlocksX;
+    job.m_uiBytesPerPixel = 4;
+    job.m_uiBytesPerBlock = 16;
+    job.m_uiFlags = GetCompressionFlags(targetFormat);
+
+    switch (targetFormat)
+    {
+      case ezImageFormat::BC1_UNORM:
+      case ezImageFormat::BC1_UNORM_SRGB:
+        job.m_uiBytesPerBlock = 8;
+        job.m_EncodeBlock = &EncodeBlockBC1;
+        break;
+
+      case ezImageFormat::BC3_UNORM:
+      case ezImageFormat::BC3_UNORM_SRGB:
+        job.m_EncodeBlock = &EncodeBlockBC3;
+        break;
+
+      case ezImageFormat::BC6H_UF16:
+        job.m_uiBytesPerPixel = 4 * sizeof(float);
+        job.m_bFloatSource = true;
+        job.m_EncodeBlock = &EncodeBlockBC6H;
+        break;
+
+      case ezImageFormat::BC7_UNORM:
+      case ezImageFormat::BC7_UNORM_SRGB:
+        job.m_EncodeBlock = &EncodeBlockBC7;
+        break;
+
+      default:
+        return EZ_FAILURE;
     }
 
-    return EZ_FAILURE;
+    job.Run(numBlocksY);
+    return EZ_SUCCESS;
   }
 };
 
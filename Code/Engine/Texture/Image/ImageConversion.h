@@ -135,6 +135,16 @@ public:
   static ezResult BuildPath(ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat, bool bSourceEqualsTarget,
     ezHybridArray<ConversionPathNode, 16>& ref_path_out, ezUInt32& ref_uiNumScratchBuffers_out);
 
+  /// \brief How often BuildPath() could return a cached path and how often it had to search for one.
+  struct PathCacheStats
+  {
+    ezUInt32 m_uiNumHits = 0;
+    ezUInt32 m_uiNumMisses = 0;
+  };
+
+  /// \brief Returns the number of BuildPath() calls that were answered from the path cache so far.
+  static PathCacheStats GetPathCacheStats();
+
   /// \brief  Converts the source image into a target image with the given format. Source and target may be the same.
   static ezResult Convert(const ezImageView& source, ezImage& ref_target, ezImageFormat::Enum targetFormat);
 
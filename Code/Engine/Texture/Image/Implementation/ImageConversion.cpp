@@ -3,6 +3,7 @@
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Math/Math.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Texture/Image/ImageConversion.h>
 
 EZ_ENUMERABLE_CLASS_IMPLEMENTATION(ezImageConversionStep);
@@ -99,6 +100,17 @@ namespace
   ezHashTable<ezUInt32, TableEntry> s_conversionTable;
   bool s_conversionTableValid = false;
 
+  struct CachedConversionPath
+  {
+    ezHybridArray<ezImageConversion::ConversionPathNode, 16> m_Path;
+    ezUInt32 m_uiNumScratchBuffers = 0;
+  };
+
+  /// BuildPath() results, keyed by source format, target format and whether source equals target.
+  /// Cleared whenever the conversion table is rebuilt.
+  ezHashTable<ezUInt32, CachedConversionPath> s_conversionPathCache;
+  ezImageConversion::PathCacheStats s_conversionPathCacheStats;
+
   constexpr ezUInt32 MakeKey(ezImageFormat::Enum a, ezImageFormat::Enum b)
   {
     return a * ezImageFormat::NUM_FORMATS + b;
@@ -107,6 +119,10 @@ namespace
   {
     return (a << 16) + b;
   }
+  constexpr ezUInt32 MakePathKey(ezImageFormat::Enum a, ezImageFormat::Enum b, bool bSourceEqualsTarget)
+  {
+    return MakeKey(a, b) * 2 + (bSourceEqualsTarget ? 1 : 0);
+  }
 
   struct IntermediateBuffer
   {
@@ -147,6 +163,112 @@ namespace
       return ref_scratchBuffers.GetCount() - 1;
     }
   }
+
+  /// Number of pixels that are pushed through all steps of a linear conversion path at once.
+  /// Small enough that the intermediate results of one tile stay in the cache.
+  constexpr ezUInt32 s_uiConversionTileSize = 4096;
+
+  /// Returns true if all steps of the path are pixel-wise conversions between byte aligned linear formats.
+  bool CanConvertPathInTiles(ezArrayPtr<const ezImageConversion::ConversionPathNode> path)
+  {
+    for (const auto& node : path)
+    {
+      if (ezImageFormat::GetType(node.m_sourceFormat) != ezImageFormatType::LINEAR || ezImageFormat::GetType(node.m_targetFormat) != ezImageFormatType::LINEAR)
+        return false;
+
+      if (ezImageFormat::GetBitsPerPixel(node.m_sourceFormat) % 8 != 0 || ezImageFormat::GetBitsPerPixel(node.m_targetFormat) % 8 != 0)
+        return false;
+    }
+
+    return true;
+  }
+
+  /// Runs all steps of a linear conversion path on one tile after the other, instead of doing one full pass over the data per step.
+  struct ConvertTilesJob
+  {
+    ezConstByteBlobPtr m_Source;
+    ezByteBlobPtr m_Target;
+    ezUInt64 m_uiNumElements = 0;
+    ezArrayPtr<const ezImageConversion::ConversionPathNode> m_Path;
+    ezUInt32 m_uiMaxBytesPerPixel = 0;
+    mutable ezAtomicBool m_bFailed;
+
+    void ConvertTiles(ezUInt32 uiFirstTile, ezUInt32 uiEndTile) const
+    {
+      // two scratch buffers are enough, every step only reads the result of the previous one
+      ezDynamicArray<ezUInt8> scratch[2];
+      if (m_Path.GetCount() > 1)
+      {
+        const ezUInt32 uiScratchSize = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(s_uiConversionTileSize, m_uiNumElements)) * m_uiMaxBytesPerPixel;
+        scratch[0].SetCountUninitialized(uiScratchSize);
+        scratch[1].SetCountUninitialized(uiScratchSize);
+      }
+
+      const ezUInt32 uiSourceBytesPerPixel = ezImageFormat::GetBitsPerPixel(m_Path[0].m_sourceFormat) / 8;
+
+      for (ezUInt32 uiTile = uiFirstTile; uiTile < uiEndTile; ++uiTile)
+      {
+        if (m_bFailed)
+          return;
+
+        const ezUInt64 uiFirstElement = ezUInt64(uiTile) * s_uiConversionTileSize;
+        const ezUInt32 uiNumElements = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(s_uiConversionTileSize, m_uiNumElements - uiFirstElement));
+
+        ezConstByteBlobPtr stepSource(m_Source.GetPtr() + uiFirstElement * uiSourceBytesPerPixel, uiNumElements * uiSourceBytesPerPixel);
+
+        for (ezUInt32 i = 0; i < m_Path.GetCount(); ++i)
+        {
+          const ezUInt32 uiTargetBytesPerPixel = ezImageFormat::GetBitsPerPixel(m_Path[i].m_targetFormat) / 8;
+
+          ezByteBlobPtr stepTarget;
+          if (i + 1 == m_Path.GetCount())
+          {
+            stepTarget = ezByteBlobPtr(m_Target.GetPtr() + uiFirstElement * uiTargetBytesPerPixel, uiNumElements * uiTargetBytesPerPixel);
+          }
+          else
+          {
+            stepTarget = ezByteBlobPtr(scratch[i % 2].GetData(), uiNumElements * uiTargetBytesPerPixel);
+          }
+
+          if (m_Path[i].m_step == nullptr)
+          {
+            memcpy(stepTarget.GetPtr(), stepSource.GetPtr(), stepTarget.GetCount());
+          }
+          else if (static_cast<const ezImageConversionStepLinear*>(m_Path[i].m_step)
+                     ->ConvertPixels(stepSource, stepTarget, uiNumElements, m_Path[i].m_sourceFormat, m_Path[i].m_targetFormat)
+                     .Failed())
+          {
+            m_bFailed = true;
+            return;
+          }
+
+          stepSource = stepTarget;
+        }
+      }
+    }
+  };
+
+  ezResult ConvertPathInTiles(ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt64 uiNumElements, ezArrayPtr<const ezImageConversion::ConversionPathNode> path)
+  {
+    ConvertTilesJob job;
+    job.m_Source = source;
+    job.m_Target = target;
+    job.m_uiNumElements = uiNumElements;
+    job.m_Path = path;
+
+    for (const auto& node : path)
+    {
+      job.m_uiMaxBytesPerPixel = ezMath::Max(job.m_uiMaxBytesPerPixel, ezImageFormat::GetBitsPerPixel(node.m_targetFormat) / 8);
+    }
+
+    const ezUInt32 uiNumTiles = static_cast<ezUInt32>((uiNumElements + s_uiConversionTileSize - 1) / s_uiConversionTileSize);
+
+    const ConvertTilesJob* pJob = &job;
+    ezTaskSystem::ParallelForIndexed(0, uiNumTiles, [pJob](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      { pJob->ConvertTiles(uiStartIndex, uiEndIndex); }, "ezImageConversion::ConvertTiles");
+
+    return job.m_bFailed ? EZ_FAILURE : EZ_SUCCESS;
+  }
 } // namespace
 
 ezImageConversionStep::ezImageConversionStep()
@@ -185,6 +307,18 @@ ezResult ezImageConversion::BuildPath(ezImageFormat::Enum sourceFormat, ezImageF
     RebuildConversionTable();
   }
 
+  const ezUInt32 uiPathKey = MakePathKey(sourceFormat, targetFormat, bSourceEqualsTarget);
+
+  if (const CachedConversionPath* pCached = s_conversionPathCache.GetValue(uiPathKey))
+  {
+    ++s_conversionPathCacheStats.m_uiNumHits;
+    ref_path_out = pCached->m_Path;
+    ref_uiNumScratchBuffers_out = pCached->m_uiNumScratchBuffers;
+    return EZ_SUCCESS;
+  }
+
+  ++s_conversionPathCacheStats.m_uiNumMisses;
+
   for (ezImageFormat::Enum current = sourceFormat; current != targetFormat;)
   {
     ezUInt32 currentTableIndex = MakeKey(current, targetFormat);
@@ -271,14 +405,25 @@ ezResult ezImageConversion::BuildPath(ezImageFormat::Enum sourceFormat, ezImageF
 
   ref_uiNumScratchBuffers_out = scratchBuffers.GetCount() - 1;
 
+  CachedConversionPath& cached = s_conversionPathCache[uiPathKey];
+  cached.m_Path = ref_path_out;
+  cached.m_uiNumScratchBuffers = ref_uiNumScratchBuffers_out;
+
   return EZ_SUCCESS;
 }
 
+ezImageConversion::PathCacheStats ezImageConversion::GetPathCacheStats()
+{
+  EZ_LOCK(s_conversionTableLock);
+  return s_conversionPathCacheStats;
+}
+
 void ezImageConversion::RebuildConversionTable()
 {
   EZ_LOCK(s_conversionTableLock);
 
   s_conversionTable.Clear();
+  s_conversionPathCache.Clear();
 
   // Prime conversion table with known conversions
   for (ezImageConversionStep* conversion = ezImageConversionStep::GetFirstInstance(); conversion; conversion = conversion->GetNextInstance())
@@ -408,6 +553,26 @@ ezResult ezImageConversion::Convert(const ezImageView& source, ezImage& ref_targ
   EZ_ASSERT_DEV(path.GetCount() > 0, "Invalid conversion path");
   EZ_ASSERT_DEV(path[0].m_sourceFormat == source.GetImageFormat(), "Invalid conversion path");
 
+  // Pixel-wise conversions don't need full size intermediate images, run all steps tile by tile instead.
+  // In-place conversions keep using the step by step path, since a tile may overwrite source data that another tile still reads.
+  if (&source != &ref_target && CanConvertPathInTiles(path))
+  {
+    const ezImageFormat::Enum targetFormat = path[path.GetCount() - 1].m_targetFormat;
+
+    ezImageHeader header = source.GetHeader();
+    header.SetImageFormat(targetFormat);
+    ref_target.ResetAndAlloc(header);
+
+    // we have to do the computation in 64-bit otherwise it might overflow for very large textures (8k x 4k or bigger).
+    const ezUInt64 uiNumElements = ezUInt64(8) * ref_target.GetByteBlobPtr().GetCount() / (ezUInt64)ezImageFormat::GetBitsPerPixel(targetFormat);
+    const ezUInt64 uiNumSourceElements = ezUInt64(8) * source.GetByteBlobPtr().GetCount() / (ezUInt64)ezImageFormat::GetBitsPerPixel(source.GetImageFormat());
+
+    if (uiNumElements == uiNumSourceElements)
+    {
+      return ConvertPathInTiles(source.GetByteBlobPtr(), ref_target.GetByteBlobPtr(), uiNumElements, path);
+    }
+  }
+
   ezHybridArray<ezImage, 16> intermediates;
   intermediates.SetCount(uiNumScratchBuffers);
 
@@ -476,6 +641,11 @@ ezResult ezImageConversion::ConvertRaw(
     return EZ_FAILURE;
   }
 
+  if (source.GetPtr() != target.GetPtr() && CanConvertPathInTiles(path))
+  {
+    return ConvertPathInTiles(source, target, uiNumElements, path);
+  }
+
   ezHybridArray<ezBlob, 16> intermediates;
   intermediates.SetCount(uiNumScratchBuffers);
 
@@ -5,6 +5,7 @@
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Timestamp.h>
 #include <Texture/Image/ImageConversion.h>
 #include <Texture/Image/ImageEnums.h>
@@ -740,6 +741,61 @@ inline static void FilterLine(
   }
 }
 
+/// Filters a complete target row (or slice) at once, as the weighted sum of whole source rows (or slices).
+/// Compared to filtering column by column, this keeps all memory accesses linear.
+inline static void FilterRows(ezUInt32 uiNumSourceRows, const ezSimdVec4f* __restrict pSourceBegin, ezSimdVec4f* __restrict pTargetRow, ezUInt32 uiRowLength, ezUInt32 uiTargetRowIndex, const ezImageFilterWeights& weights, ezImageAddressMode::Enum addressMode, const ezSimdVec4f& vBorderColor)
+{
+  const ezUInt32 numWeights = weights.GetNumWeights();
+  const ezInt32 firstSourceIdx = weights.GetFirstSourceSampleIndex(uiTargetRowIndex);
+
+  for (ezUInt32 i = 0; i < uiRowLength; ++i)
+  {
+    pTargetRow[i].SetZero();
+  }
+
+  for (ezUInt32 weightIdx = 0; weightIdx < numWeights; ++weightIdx)
+  {
+    const ezSimdVec4f weight(weights.GetWeight(uiTargetRowIndex, weightIdx));
+
+    bool useBorderColor = false;
+    const ezUInt32 sourceRowIdx = ezImageUtils::GetSampleIndex(uiNumSourceRows, firstSourceIdx + weightIdx, addressMode, useBorderColor);
+
+    if (useBorderColor)
+    {
+      for (ezUInt32 i = 0; i < uiRowLength; ++i)
+      {
+        pTargetRow[i] = ezSimdVec4f::MulAdd(vBorderColor, weight, pTargetRow[i]);
+      }
+    }
+    else
+    {
+      const ezSimdVec4f* __restrict sourceRow = pSourceBegin + static_cast<ezUInt64>(sourceRowIdx) * uiRowLength;
+      for (ezUInt32 i = 0; i < uiRowLength; ++i)
+      {
+        pTargetRow[i] = ezSimdVec4f::MulAdd(sourceRow[i], weight, pTargetRow[i]);
+      }
+    }
+  }
+}
+
+/// Calls func(uiItem) for all items, spread across the task system. Small workloads are executed directly.
+template <typename Func>
+static void ParallelForScaleItems(ezUInt32 uiNumItems, ezUInt32 uiPixelsPerItem, const Func& func)
+{
+  ezParallelForParams params;
+  params.m_uiBinSize = ezMath::Max(1u, 16384u / ezMath::Max(1u, uiPixelsPerItem));
+
+  const Func* pFunc = &func;
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumItems, [pFunc](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        (*pFunc)(i);
+      } },
+    "ezImageUtils::Scale3D", ezTaskNesting::Never, params);
+}
+
 static void DownScaleFastLine(ezUInt32 uiPixelStride, const ezUInt8* pSrc, ezUInt8* pDest, ezUInt32 uiLengthIn, ezUInt32 uiStrideIn, ezUInt32 uiLengthOut, ezUInt32 uiStrideOut)
 {
   const ezUInt32 downScaleFactor = uiLengthIn / uiLengthOut;
@@ -1004,12 +1060,13 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepSource = &conversionScratch;
   };
 
-  ezHybridArray<ezInt32, 256> firstSampleIndices;
-  firstSampleIndices.Reserve(ezMath::Max(uiWidth, uiHeight, uiDepth));
+  const ezSimdVec4f vBorderColor(borderColor.r, borderColor.g, borderColor.b, borderColor.a);
 
   if (uiWidth != originalWidth)
   {
     ezImageFilterWeights weights(*pFilter, originalWidth, uiWidth);
+
+    ezHybridArray<ezInt32, 256> firstSampleIndices;
     firstSampleIndices.SetCountUninitialized(uiWidth);
     for (ezUInt32 x = 0; x < uiWidth; ++x)
     {
@@ -1030,21 +1087,18 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetWidth(uiWidth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    // every row of every slice is filtered independently
+    const ezImageView& passSource = *stepSource;
+    ParallelForScaleItems(numArrayElements * numFaces * originalDepth * originalHeight, uiWidth, [&](ezUInt32 uiItem)
       {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
-        {
-          for (ezUInt32 y = 0; y < originalHeight; ++y)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezUInt32 y = uiItem % originalHeight;
+        const ezUInt32 z = (uiItem / originalHeight) % originalDepth;
+        const ezUInt32 face = (uiItem / (originalHeight * originalDepth)) % numFaces;
+        const ezUInt32 arrayIndex = uiItem / (originalHeight * originalDepth * numFaces);
+
+        const ezSimdVec4f* filterSource = passSource.GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+        FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, vBorderColor); });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1053,11 +1107,6 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
   if (uiHeight != originalHeight)
   {
     ezImageFilterWeights weights(*pFilter, originalHeight, uiHeight);
-    firstSampleIndices.SetCount(uiHeight);
-    for (ezUInt32 y = 0; y < uiHeight; ++y)
-    {
-      firstSampleIndices[y] = weights.GetFirstSourceSampleIndex(y);
-    }
 
     ezImage* stepTarget;
     if (uiDepth == originalDepth && format == ezImageFormat::R32G32B32A32_FLOAT)
@@ -1073,21 +1122,18 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetHeight(uiHeight);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    // every target row is computed from complete source rows
+    const ezImageView& passSource = *stepSource;
+    ParallelForScaleItems(numArrayElements * numFaces * originalDepth * uiHeight, uiWidth, [&](ezUInt32 uiItem)
       {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
-        {
-          for (ezUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth, weights, firstSampleIndices, addressModeV, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezUInt32 y = uiItem % uiHeight;
+        const ezUInt32 z = (uiItem / uiHeight) % originalDepth;
+        const ezUInt32 face = (uiItem / (uiHeight * originalDepth)) % numFaces;
+        const ezUInt32 arrayIndex = uiItem / (uiHeight * originalDepth * numFaces);
+
+        const ezSimdVec4f* filterSource = passSource.GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, 0, z);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+        FilterRows(originalHeight, filterSource, filterTarget, uiWidth, y, weights, addressModeV, vBorderColor); });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1096,11 +1142,6 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
   if (uiDepth != originalDepth)
   {
     ezImageFilterWeights weights(*pFilter, originalDepth, uiDepth);
-    firstSampleIndices.SetCount(uiDepth);
-    for (ezUInt32 z = 0; z < uiDepth; ++z)
-    {
-      firstSampleIndices[z] = weights.GetFirstSourceSampleIndex(z);
-    }
 
     ezImage* stepTarget;
     if (format == ezImageFormat::R32G32B32A32_FLOAT)
@@ -1116,21 +1157,17 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetDepth(uiDepth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    // every target slice is computed from complete source slices
+    const ezImageView& passSource = *stepSource;
+    ParallelForScaleItems(numArrayElements * numFaces * uiDepth, uiWidth * uiHeight, [&](ezUInt32 uiItem)
       {
-        for (ezUInt32 y = 0; y < uiHeight; ++y)
-        {
-          for (ezUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth * uiHeight, weights, firstSampleIndices, addressModeW, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+        const ezUInt32 z = uiItem % uiDepth;
+        const ezUInt32 face = (uiItem / uiDepth) % numFaces;
+        const ezUInt32 arrayIndex = uiItem / (uiDepth * numFaces);
+
+        const ezSimdVec4f* filterSource = passSource.GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, 0, 0);
+        ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, 0, z);
+        FilterRows(originalDepth, filterSource, filterTarget, uiWidth * uiHeight, z, weights, addressModeW, vBorderColor); });
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -2,6 +2,7 @@
 
 #include <Foundation/DataProcessing/Stream/ProcessingStreamProcessor.h>
 #include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <ParticlePlugin/Module/ParticleModule.h>
 #include <ParticlePlugin/ParticlePluginDLL.h>
 
@@ -37,5 +38,34 @@ protected:
   virtual void InitializeElements(ezUInt64 uiStartIndex, ezUInt64 uiNumElements) override {}
   virtual void StepParticleSystem(const ezTime& tDiff, ezUInt32 uiNumNewParticles) { m_TimeDiff = tDiff; }
 
+  /// \brief Calls func(uiStartIndex, uiEndIndex) for disjoint ranges that together cover the first uiNumElements particles.
+  ///
+  /// Large particle systems are split up across the worker threads, small ones are processed directly on the calling thread.
+  /// The function must only touch the particles in its range and must not remove or spawn particles.
+  template <typename Func>
+  void ProcessElementsInParallel(ezUInt64 uiNumElements, const char* szTaskName, Func&& func) const
+  {
+    ezParallelForParams params;
+    params.m_uiBinSize = ParallelProcessingBinSize;
+    params.m_uiMaxTasksPerThread = 1;
+
+    ezTaskSystem::ParallelForIndexed(
+      ezUInt64(0), uiNumElements, [&func](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
+      { func(uiStartIndex, uiEndIndex); },
+      szTaskName, ezTaskNesting::Never, params);
+  }
+
+  /// \brief Returns the first index >= uiStartIndex that gets updated, when only every uiInterval-th particle is updated, starting with uiFirstToUpdate.
+  static EZ_ALWAYS_INLINE ezUInt64 GetFirstIndexToUpdate(ezUInt64 uiStartIndex, ezUInt32 uiFirstToUpdate, ezUInt32 uiInterval)
+  {
+    if (uiStartIndex <= uiFirstToUpdate)
+      return uiFirstToUpdate;
+
+    return uiStartIndex + ((uiFirstToUpdate % uiInterval) + uiInterval - (uiStartIndex % uiInterval)) % uiInterval;
+  }
+
+  /// \brief Particle systems with more particles than this are processed on multiple threads.
+  static constexpr ezUInt32 ParallelProcessingBinSize = 16 * 1024;
+
   ezTime m_TimeDiff;
 };
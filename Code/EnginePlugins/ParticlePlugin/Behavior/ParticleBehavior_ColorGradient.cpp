@@ -174,70 +174,52 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
 
   const ezColorGradient& gradient = pGradient->GetDescriptor().m_Gradient;
 
-  ezProcessingStreamIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
+  ezColorLinear16f* pColor = m_pStreamColor->GetWritableData<ezColorLinear16f>();
 
-  // skip the first n particles
-  itColor.Advance(m_uiFirstToUpdate);
+  // only every n-th particle is updated, starting at a different one every frame
+  // this is to reduce the number of particles that need to be fully evaluated,
+  // since sampling the color gradient is pretty expensive
+  const ezUInt32 uiFirstToUpdate = m_uiFirstToUpdate;
+  const ezUInt32 uiUpdateInterval = m_uiCurrentUpdateInterval;
 
-  if (m_GradientMode == ezParticleColorGradientMode::Age)
+  auto EvaluateGradient = [&](float fPosX) -> ezColorLinear16f
   {
-    ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
+    ezColor rgba;
+    ezUInt8 alpha;
+    gradient.EvaluateColor(fPosX, rgba);
+    gradient.EvaluateAlpha(fPosX, alpha);
+    rgba.a = ezMath::ColorByteToFloat(alpha);
 
-    // skip the first n particles
-    itLifeTime.Advance(m_uiFirstToUpdate);
+    return rgba * m_TintColor;
+  };
 
-    while (!itLifeTime.HasReachedEnd())
-    {
-      // if (itLifeTime.Current().y > 0)
+  if (m_GradientMode == ezParticleColorGradientMode::Age)
+  {
+    const ezFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetData<ezFloat16Vec2>();
+
+    ProcessElementsInParallel(uiNumElements, "PFX: Color Gradient",
+      [&](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
       {
-        const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-        const float posx = 1.0f - fLifeTimeFraction;
-
-        ezColor rgba;
-        ezUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = ezMath::ColorByteToFloat(alpha);
-
-        itColor.Current() = rgba * m_TintColor;
-      }
-
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itLifeTime.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
-    }
+        for (ezUInt64 i = GetFirstIndexToUpdate(uiStartIndex, uiFirstToUpdate, uiUpdateInterval); i < uiEndIndex; i += uiUpdateInterval)
+        {
+          const float fLifeTimeFraction = pLifeTime[i].x * pLifeTime[i].y;
+          pColor[i] = EvaluateGradient(1.0f - fLifeTimeFraction);
+        }
+      });
   }
   else if (m_GradientMode == ezParticleColorGradientMode::Speed)
   {
-    ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
-
-    // skip the first n particles
-    itVelocity.Advance(m_uiFirstToUpdate);
+    const ezVec3* pVelocity = m_pStreamVelocity->GetData<ezVec3>();
 
-    while (!itVelocity.HasReachedEnd())
-    {
-      // if (itLifeTime.Current().y > 0)
+    ProcessElementsInParallel(uiNumElements, "PFX: Color Gradient",
+      [&](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
       {
-        const float fSpeed = itVelocity.Current().GetLength();
-        const float posx = fSpeed / m_fMaxSpeed; // no need to clamp the range, the color lookup will already do that
-
-        ezColor rgba;
-        ezUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = ezMath::ColorByteToFloat(alpha);
-
-        itColor.Current() = rgba * m_TintColor;
-      }
-
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itVelocity.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
-    }
+        for (ezUInt64 i = GetFirstIndexToUpdate(uiStartIndex, uiFirstToUpdate, uiUpdateInterval); i < uiEndIndex; i += uiUpdateInterval)
+        {
+          // no need to clamp the range, the color lookup will already do that
+          pColor[i] = EvaluateGradient(pVelocity[i].GetLength() / m_fMaxSpeed);
+        }
+      });
   }
 
   // adjust which index is the first to update
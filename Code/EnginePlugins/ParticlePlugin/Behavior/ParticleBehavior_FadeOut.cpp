@@ -1,6 +1,5 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Math/Color16f.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_FadeOut.h>
@@ -72,51 +71,29 @@ void ezParticleBehavior_FadeOut::Process(ezUInt64 uiNumElements)
 
   EZ_PROFILE_SCOPE("PFX: Fade Out");
 
-  ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  ezProcessingStreamIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
+  const ezFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetData<ezFloat16Vec2>();
+  ezColorLinear16f* pColor = m_pStreamColor->GetWritableData<ezColorLinear16f>();
 
-  // skip the first n particles
-  {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itColor.Advance();
-    }
+  // only every n-th particle is updated, starting at a different one every frame
+  const ezUInt32 uiFirstToUpdate = m_uiFirstToUpdate;
+  const ezUInt32 uiUpdateInterval = m_uiCurrentUpdateInterval;
 
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
-  }
+  ++m_uiFirstToUpdate;
+  if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
+    m_uiFirstToUpdate = 0;
 
-  if (m_fStartAlpha <= 1.0f)
-  {
-    while (!itLifeTime.HasReachedEnd())
-    {
-      const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-      itColor.Current().a = m_fStartAlpha * ezMath::Pow(fLifeTimeFraction, m_fExponent);
+  // a start alpha above 1 has to be clamped to 1
+  const float fMaxAlpha = m_fStartAlpha <= 1.0f ? ezMath::MaxValue<float>() : 1.0f;
 
-      for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-      {
-        itLifeTime.Advance();
-        itColor.Advance();
-      }
-    }
-  }
-  else
-  {
-    // this case has to clamp alpha to 1
-    while (!itLifeTime.HasReachedEnd())
+  ProcessElementsInParallel(uiNumElements, "PFX: Fade Out",
+    [&](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
     {
-      const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-      itColor.Current().a = ezMath::Min(1.0f, m_fStartAlpha * ezMath::Pow(fLifeTimeFraction, m_fExponent));
-
-      for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
+      for (ezUInt64 i = GetFirstIndexToUpdate(uiStartIndex, uiFirstToUpdate, uiUpdateInterval); i < uiEndIndex; i += uiUpdateInterval)
       {
-        itLifeTime.Advance();
-        itColor.Advance();
+        const float fLifeTimeFraction = pLifeTime[i].x * pLifeTime[i].y;
+        pColor[i].a = ezMath::Min(fMaxAlpha, m_fStartAlpha * ezMath::Pow(fLifeTimeFraction, m_fExponent));
       }
-    }
-  }
+    });
 
   /// \todo Use level of detail to reduce the update interval further
   /// up close, with a high interval, animations appear choppy, especially when fading stuff out at the end
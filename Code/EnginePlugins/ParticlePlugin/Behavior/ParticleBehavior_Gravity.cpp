@@ -3,7 +3,6 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
@@ -82,14 +81,38 @@ void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
   const float tDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
 
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
-
-  while (!itVelocity.HasReachedEnd())
-  {
-    itVelocity.Current() += addGravity;
-
-    itVelocity.Advance();
-  }
+  // the velocity stream is tightly packed, so four particles cover exactly three SIMD registers
+  const ezSimdVec4f vAdd0(addGravity.x, addGravity.y, addGravity.z, addGravity.x);
+  const ezSimdVec4f vAdd1(addGravity.y, addGravity.z, addGravity.x, addGravity.y);
+  const ezSimdVec4f vAdd2(addGravity.z, addGravity.x, addGravity.y, addGravity.z);
+
+  EZ_ASSERT_DEBUG(m_pStreamVelocity->GetElementStride() == sizeof(ezVec3), "Velocity stream is expected to be tightly packed");
+  ezVec3* pVelocity = m_pStreamVelocity->GetWritableData<ezVec3>();
+
+  ProcessElementsInParallel(uiNumElements, "PFX: Gravity",
+    [&](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
+    {
+      ezUInt64 i = uiStartIndex;
+
+      for (; i + 4 <= uiEndIndex; i += 4)
+      {
+        float* pData = &pVelocity[i].x;
+
+        ezSimdVec4f v0, v1, v2;
+        v0.Load<4>(pData + 0);
+        v1.Load<4>(pData + 4);
+        v2.Load<4>(pData + 8);
+
+        (v0 + vAdd0).Store<4>(pData + 0);
+        (v1 + vAdd1).Store<4>(pData + 4);
+        (v2 + vAdd2).Store<4>(pData + 8);
+      }
+
+      for (; i < uiEndIndex; ++i)
+      {
+        pVelocity[i] += addGravity;
+      }
+    });
 }
 
 void ezParticleBehavior_Gravity::RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule)
@@ -112,9 +112,6 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
 
   EZ_PROFILE_SCOPE("PFX: Size Curve");
 
-  ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  ezProcessingStreamIterator<ezFloat16> itSize(m_pStreamSize, uiNumElements, 0);
-
   ezResourceLock<ezCurve1DResource> pCurve(m_hCurve, ezResourceAcquireMode::BlockTillLoaded);
 
   if (pCurve.GetAcquireResult() == ezResourceAcquireResult::MissingFallback)
@@ -123,46 +120,35 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
   if (pCurve->GetDescriptor().m_Curves.IsEmpty())
     return;
 
-  auto& curve = pCurve->GetDescriptor().m_Curves[0];
+  const ezCurve1D& curve = pCurve->GetDescriptor().m_Curves[0];
 
-  double fMinX, fMaxX;
-  curve.QueryExtents(fMinX, fMaxX);
+  const ezFloat16Vec2* pLifeTime = m_pStreamLifeTime->GetData<ezFloat16Vec2>();
+  ezFloat16* pSize = m_pStreamSize->GetWritableData<ezFloat16>();
 
-  // skip the first n particles
-  {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
+  // only every n-th particle is updated, starting at a different one every frame
+  // this is to reduce the number of particles that need to be fully evaluated,
+  // since sampling the curve is expensive
+  const ezUInt32 uiFirstToUpdate = m_uiFirstToUpdate;
+  const ezUInt32 uiUpdateInterval = m_uiCurrentUpdateInterval;
 
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
-  }
+  ++m_uiFirstToUpdate;
+  if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
+    m_uiFirstToUpdate = 0;
 
-  while (!itLifeTime.HasReachedEnd())
-  {
-    // if (itLifeTime.Current().y > 0)
+  ProcessElementsInParallel(uiNumElements, "PFX: Size Curve",
+    [&](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
     {
-      const float fLifeTimeFraction = 1.0f - (itLifeTime.Current().x * itLifeTime.Current().y);
-
-      const double evalPos = curve.ConvertNormalizedPos(fLifeTimeFraction);
-      double val = curve.Evaluate(evalPos);
-      val = curve.NormalizeValue(val);
+      for (ezUInt64 i = GetFirstIndexToUpdate(uiStartIndex, uiFirstToUpdate, uiUpdateInterval); i < uiEndIndex; i += uiUpdateInterval)
+      {
+        const float fLifeTimeFraction = 1.0f - (pLifeTime[i].x * pLifeTime[i].y);
 
-      itSize.Current() = m_fBaseSize + (float)val * m_fCurveScale;
-    }
+        const double evalPos = curve.ConvertNormalizedPos(fLifeTimeFraction);
+        double val = curve.Evaluate(evalPos);
+        val = curve.NormalizeValue(val);
 
-    // skip the next n items
-    // this is to reduce the number of particles that need to be fully evaluated,
-    // since sampling the curve is expensive
-    for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
-  }
+        pSize[i] = m_fBaseSize + (float)val * m_fCurveScale;
+      }
+    });
 }
 
 
@@ -3,7 +3,6 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/Interfaces/WindWorldModule.h>
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
@@ -117,35 +116,51 @@ void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
   const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
   const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  EZ_ASSERT_DEBUG(m_pStreamPosition->GetElementStride() == sizeof(ezSimdVec4f), "Position stream is expected to be tightly packed");
+  EZ_ASSERT_DEBUG(m_pStreamVelocity->GetElementStride() == sizeof(ezVec3), "Velocity stream is expected to be tightly packed");
 
-  if (m_fWindInfluence > 0)
-  {
-    const ezSimdFloat fWindFactor = m_fWindInfluence * tDiff;
-
-    while (!itPosition.HasReachedEnd())
-    {
-      ezSimdVec4f addPos = vRise + pOwner->GetWindAt(itPosition.Current()) * fWindFactor;
+  ezSimdVec4f* pPosition = m_pStreamPosition->GetWritableData<ezSimdVec4f>();
+  float* pVelocity = m_pStreamVelocity->GetWritableData<float>();
 
-      itPosition.Current() += addPos;
-      itVelocity.Current() *= fFrictionFactor;
+  const ezSimdFloat fWindFactor = m_fWindInfluence * tDiff;
+  const bool bApplyWind = m_fWindInfluence > 0;
 
-      itPosition.Advance();
-      itVelocity.Advance();
-    }
-  }
-  else
-  {
-    while (!itPosition.HasReachedEnd())
+  ProcessElementsInParallel(uiNumElements, "PFX: Velocity",
+    [&](ezUInt64 uiStartIndex, ezUInt64 uiEndIndex)
     {
-      itPosition.Current() += vRise;
-      itVelocity.Current() *= fFrictionFactor;
-
-      itPosition.Advance();
-      itVelocity.Advance();
-    }
-  }
+      if (bApplyWind)
+      {
+        for (ezUInt64 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          pPosition[i] += vRise + pOwner->GetWindAt(pPosition[i]) * fWindFactor;
+        }
+      }
+      else
+      {
+        for (ezUInt64 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          pPosition[i] += vRise;
+        }
+      }
+
+      // friction scales all components the same way, so the velocities can be treated as one flat float array
+      const ezSimdFloat fSimdFrictionFactor = fFrictionFactor;
+
+      ezUInt64 uiFloat = uiStartIndex * 3;
+      const ezUInt64 uiEndFloat = uiEndIndex * 3;
+
+      for (; uiFloat + 4 <= uiEndFloat; uiFloat += 4)
+      {
+        ezSimdVec4f v;
+        v.Load<4>(pVelocity + uiFloat);
+        (v * fSimdFrictionFactor).Store<4>(pVelocity + uiFloat);
+      }
+
+      for (; uiFloat < uiEndFloat; ++uiFloat)
+      {
+        pVelocity[uiFloat] *= fFrictionFactor;
+      }
+    });
 }
 
 void ezParticleBehavior_Velocity::RequestRequiredWorldModulesForCache(ezParticleWorldModule* pParticleModule)
@@ -1,5 +1,6 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Utilities/AssetFileHeader.h>
 #include <ParticlePlugin/Resources/ParticleEffectResource.h>
 
@@ -63,7 +64,13 @@ void ezParticleEffectResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage
 
 EZ_RESOURCE_IMPLEMENT_CREATEABLE(ezParticleEffectResource, ezParticleEffectResourceDescriptor)
 {
-  m_Desc = descriptor;
+  // the descriptor owns its systems through raw pointers, so a plain copy would share (and double free) them
+  ezDefaultMemoryStreamStorage storage;
+  ezMemoryStreamWriter writer(&storage);
+  descriptor.Save(writer);
+
+  ezMemoryStreamReader reader(&storage);
+  m_Desc.Load(reader);
 
   ezResourceLoadDesc res;
   res.m_State = ezResourceState::Loaded;
@@ -22,6 +22,7 @@ public:
   //////////////////////////////////////////////////////////////////////////
   /// Properties
 
+  void AddEmitterFactory(ezParticleEmitterFactory* pFactory) { m_EmitterFactories.PushBack(pFactory); }
   const ezHybridArray<ezParticleEmitterFactory*, 1>& GetEmitterFactories() const { return m_EmitterFactories; }
 
   void AddInitializerFactory(ezParticleInitializerFactory* pFactory) { m_InitializerFactories.PushBack(pFactory); }
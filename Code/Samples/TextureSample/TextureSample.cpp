@@ -123,7 +123,10 @@ public:
     ezGALDeviceFactory::GetShaderModelAndCompiler(sRendererName, szShaderModel, szShaderCompiler);
 
     ezShaderManager::Configure(szShaderModel, true);
-    EZ_VERIFY(ezPlugin::LoadPlugin(szShaderCompiler).Succeeded(), "Shader compiler '{}' plugin not found", szShaderCompiler);
+    if (!ezStringUtils::IsNullOrEmpty(szShaderCompiler))
+    {
+      EZ_VERIFY(ezPlugin::LoadPlugin(szShaderCompiler).Succeeded(), "Shader compiler '{}' plugin not found", szShaderCompiler);
+    }
 
     // Register Input
     {
@@ -85,6 +85,14 @@ Example:\n\
 ",
   "");
 
+ezCommandLineOptionInt opt_DictionaryFileSize("_ArchiveTool", "-dictFileSize", "\
+Maximum size in KB of files that are compressed with a dictionary.\n\
+\n\
+Small files of the same type are grouped by their file extension and compressed with a dictionary that is shared by the group.\n\
+This improves compression of many small files, like configs, materials or prefabs. 0 disables dictionaries.\n\
+",
+  0, 0, 1024);
+
 ezCommandLineOptionDoc opt_Desc("_ArchiveTool", "Description:", "", "\
 -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)\n\
 or to unpack multiple archives at the same time.\n\
@@ -307,6 +315,7 @@ public:
   ezResult Pack()
   {
     ezArchiveBuilderImpl archive;
+    archive.m_uiMaxDictionaryFileSize = opt_DictionaryFileSize.GetOptionValue(ezCommandLineOption::LogMode::AlwaysIfSpecified) * 1024;
 
     for (const auto& folder : m_sInputs)
     {
@@ -126,6 +126,118 @@ namespace
   EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(TestResource, 1, ezRTTIDefaultAllocator<TestResource>)
   EZ_END_DYNAMIC_REFLECTED_TYPE;
 
+  using StreamingTestResourceHandle = ezTypedResourceHandle<class StreamingTestResource>;
+
+  /// Every call to UpdateContent adds one quality level, every quality level needs twice as much GPU memory as the previous one.
+  class StreamingTestResource : public ezResource
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(StreamingTestResource, ezResource);
+    EZ_RESOURCE_DECLARE_COMMON_CODE(StreamingTestResource);
+
+  public:
+    static constexpr ezUInt8 s_uiMaxLevels = 4;
+    static constexpr ezUInt64 s_uiLevel0Memory = 1024;
+
+    StreamingTestResource()
+      : ezResource(ezResource::DoUpdate::OnAnyThread, 1)
+    {
+    }
+
+    ezUInt8 GetNumLevels() const { return m_uiNumLevels; }
+
+  protected:
+    virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override
+    {
+      if (WhatToUnload == Unload::AllQualityLevels)
+        m_uiNumLevels = 0;
+      else if (m_uiNumLevels > 1)
+        --m_uiNumLevels;
+
+      return MakeLoadDesc();
+    }
+
+    virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override
+    {
+      m_uiNumLevels = ezMath::Min<ezUInt8>(m_uiNumLevels + 1, s_uiMaxLevels);
+
+      return MakeLoadDesc();
+    }
+
+    virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override
+    {
+      out_NewMemoryUsage.m_uiMemoryCPU = 0;
+      out_NewMemoryUsage.m_uiMemoryGPU = ((1ull << m_uiNumLevels) - 1) * s_uiLevel0Memory;
+    }
+
+  private:
+    ezResourceLoadDesc MakeLoadDesc() const
+    {
+      ezResourceLoadDesc ld;
+      ld.m_State = m_uiNumLevels > 0 ? ezResourceState::Loaded : ezResourceState::Unloaded;
+      ld.m_uiQualityLevelsDiscardable = m_uiNumLevels > 0 ? m_uiNumLevels - 1 : 0;
+      ld.m_uiQualityLevelsLoadable = s_uiMaxLevels - m_uiNumLevels;
+
+      return ld;
+    }
+
+    ezUInt8 m_uiNumLevels = 0;
+  };
+
+  class StreamingTestResourceTypeLoader : public ezResourceTypeLoader
+  {
+  public:
+    virtual ezResourceLoadData OpenDataStream(const ezResource* pResource) override
+    {
+      ezResourceLoadData ld;
+      ld.m_pDataStream = &m_Reader;
+      ld.m_sResourceDescription = pResource->GetResourceID();
+
+      return ld;
+    }
+
+    virtual void CloseDataStream(const ezResource* pResource, const ezResourceLoadData& loaderData) override {}
+
+  private:
+    ezDefaultMemoryStreamStorage m_StreamData;
+    ezMemoryStreamReader m_Reader{&m_StreamData};
+  };
+
+  EZ_RESOURCE_IMPLEMENT_COMMON_CODE(StreamingTestResource);
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(StreamingTestResource, 1, ezRTTIDefaultAllocator<StreamingTestResource>)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+  ezUInt8 GetNumLevels(const StreamingTestResourceHandle& hResource)
+  {
+    ezResourceLock<StreamingTestResource> pResource(hResource, ezResourceAcquireMode::PointerOnly);
+    return pResource->GetNumLevels();
+  }
+
+  /// Keeps requesting more quality levels until no resource loads anything anymore.
+  void StreamInAllLevels(ezArrayPtr<StreamingTestResourceHandle> resources)
+  {
+    for (ezUInt32 tries = 0; tries < 100; ++tries)
+    {
+      for (auto& hResource : resources)
+      {
+        ezResourceManager::PreloadResource(hResource);
+      }
+
+      do
+      {
+        ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(5));
+      } while (ezResourceManager::IsAnyLoadingInProgress());
+
+      bool bAllDone = true;
+      for (auto& hResource : resources)
+      {
+        bAllDone &= GetNumLevels(hResource) == StreamingTestResource::s_uiMaxLevels;
+      }
+
+      if (bAllDone)
+        return;
+    }
+  }
+
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(ResourceManager, Basics)
@@ -286,3 +398,190 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, ConcurrentLookup)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+
+  const ezUInt32 uiNumLoaded = 100;
+  const ezUInt32 uiNumStreaming = 200;
+
+  ezDynamicArray<TestResourceHandle> hLoaded;
+  ezDynamicArray<TestResourceHandle> hStreaming;
+
+  ezStringBuilder sResourceID;
+  for (ezUInt32 i = 0; i < uiNumLoaded; ++i)
+  {
+    sResourceID.SetFormat("Loaded-{}", i);
+    hLoaded.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+    ezResourceLock<TestResource> pResource(hLoaded.PeekBack(), ezResourceAcquireMode::BlockTillLoaded);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Lookup while loading")
+  {
+    for (ezUInt32 i = 0; i < uiNumStreaming; ++i)
+    {
+      sResourceID.SetFormat("Streaming-{}", i);
+      hStreaming.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+      ezResourceManager::PreloadResource(hStreaming.PeekBack());
+    }
+
+    ezAtomicInteger32 iNumMismatches = 0;
+
+    ezTaskSystem::ParallelForIndexed(0u, 10000u, [&](ezUInt32 uiStart, ezUInt32 uiEnd)
+      {
+        ezStringBuilder sID;
+        for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+        {
+          const ezUInt32 uiIndex = i % uiNumLoaded;
+          sID.SetFormat("Loaded-{}", uiIndex);
+
+          TestResourceHandle hResource = ezResourceManager::LoadResource<TestResource>(sID);
+          TestResourceHandle hExisting = ezResourceManager::GetExistingResource<TestResource>(sID);
+
+          if (hResource != hLoaded[uiIndex] || hExisting != hLoaded[uiIndex])
+          {
+            iNumMismatches.Increment();
+          }
+
+          ezResourceLock<TestResource> pResource(hResource, ezResourceAcquireMode::AllowLoadingFallback);
+          if (pResource.GetAcquireResult() != ezResourceAcquireResult::Final)
+          {
+            iNumMismatches.Increment();
+          }
+        }
+      });
+
+    EZ_TEST_INT(iNumMismatches, 0);
+
+    for (auto& hResource : hStreaming)
+    {
+      ezResourceLock<TestResource> pResource(hResource, ezResourceAcquireMode::BlockTillLoaded);
+      EZ_TEST_BOOL(pResource.GetAcquireResult() == ezResourceAcquireResult::Final);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Lookup after unload")
+  {
+    hLoaded.Clear();
+    hStreaming.Clear();
+
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+    }
+
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+
+    // the lookup must not return the deallocated resources anymore
+    EZ_TEST_BOOL(!ezResourceManager::GetExistingResource<TestResource>("Loaded-0").IsValid());
+
+    TestResourceHandle hResource = ezResourceManager::LoadResource<TestResource>("Loaded-0");
+    EZ_TEST_BOOL(hResource.IsValid());
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 1);
+    EZ_TEST_BOOL(ezResourceManager::GetExistingResource<TestResource>("Loaded-0") == hResource);
+
+    hResource.Invalidate();
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, MemoryBudget)
+{
+  StreamingTestResourceTypeLoader TypeLoader;
+  ezResourceManager::SetResourceTypeLoader<StreamingTestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<StreamingTestResource>(nullptr));
+  EZ_SCOPE_EXIT(ezResourceManager::SetMemoryBudgetForResourceType<StreamingTestResource>(0, 0));
+
+  constexpr ezUInt64 uiFullMemory = ((1ull << StreamingTestResource::s_uiMaxLevels) - 1) * StreamingTestResource::s_uiLevel0Memory;
+
+  ezDynamicArray<StreamingTestResourceHandle> hResources;
+  for (ezUInt32 i = 0; i < 4; ++i)
+  {
+    ezStringBuilder sResourceID;
+    sResourceID.SetFormat("Streaming-{}", i);
+    hResources.PushBack(ezResourceManager::LoadResource<StreamingTestResource>(sResourceID));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Usage")
+  {
+    StreamInAllLevels(hResources);
+
+    for (auto& hResource : hResources)
+    {
+      EZ_TEST_INT(GetNumLevels(hResource), StreamingTestResource::s_uiMaxLevels);
+    }
+
+    // without any budget nothing gets discarded
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(), 0);
+
+    auto usage = ezResourceManager::GetMemoryBudgetUsage(ezGetStaticRTTI<StreamingTestResource>());
+    EZ_TEST_INT(usage.m_uiUsedGPU, 4 * uiFullMemory);
+    EZ_TEST_INT(usage.m_uiUsedCPU, 0);
+    EZ_TEST_INT(usage.m_uiBudgetGPU, 0);
+    EZ_TEST_BOOL(ezResourceManager::GetMemoryBudgetUsage().m_uiUsedGPU >= 4 * uiFullMemory);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Eviction Order")
+  {
+    ezResourceLock<StreamingTestResource>(hResources[0], ezResourceAcquireMode::PointerOnly)->SetPriority(ezResourcePriority::Critical);
+    ezResourceLock<StreamingTestResource>(hResources[1], ezResourceAcquireMode::PointerOnly)->SetPriority(ezResourcePriority::Medium);
+    ezResourceLock<StreamingTestResource>(hResources[2], ezResourceAcquireMode::PointerOnly)->SetPriority(ezResourcePriority::Medium);
+    ezResourceLock<StreamingTestResource>(hResources[3], ezResourceAcquireMode::PointerOnly)->SetPriority(ezResourcePriority::Low);
+
+    // acquire resource 2 before resource 1, so that it is the least recently used one with medium priority
+    for (ezUInt32 i : {0, 3, 2, 1})
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(2));
+      ezResourceManager::PerFrameUpdate();
+
+      ezResourceLock<StreamingTestResource> pResource(hResources[i], ezResourceAcquireMode::AllowLoadingFallback);
+    }
+
+    // the low priority resource goes down to its last level (saving 14 KB), then resource 2 discards its highest level (saving 8 KB)
+    const ezUInt64 uiBudget = 4 * uiFullMemory - 20 * 1024;
+    ezResourceManager::SetMemoryBudgetForResourceType<StreamingTestResource>(0, uiBudget);
+
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(), 4);
+
+    EZ_TEST_INT(GetNumLevels(hResources[0]), 4);
+    EZ_TEST_INT(GetNumLevels(hResources[1]), 4);
+    EZ_TEST_INT(GetNumLevels(hResources[2]), 3);
+    EZ_TEST_INT(GetNumLevels(hResources[3]), 1);
+
+    auto usage = ezResourceManager::GetMemoryBudgetUsage(ezGetStaticRTTI<StreamingTestResource>());
+    EZ_TEST_INT(usage.m_uiUsedGPU, 4 * uiFullMemory - 22 * 1024);
+    EZ_TEST_INT(usage.m_uiBudgetGPU, uiBudget);
+
+    // already within budget
+    EZ_TEST_INT(ezResourceManager::EnforceMemoryBudgets(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Loading Headroom")
+  {
+    // the usage is close to the budget, so no higher quality levels may be loaded
+    for (auto& hResource : hResources)
+    {
+      ezResourceManager::PreloadResource(hResource);
+    }
+
+    EZ_TEST_BOOL(!ezResourceManager::IsAnyLoadingInProgress());
+    EZ_TEST_INT(GetNumLevels(hResources[2]), 3);
+    EZ_TEST_INT(GetNumLevels(hResources[3]), 1);
+
+    // with enough headroom, loading continues
+    ezResourceManager::SetMemoryBudgetForResourceType<StreamingTestResource>(0, 0);
+    StreamInAllLevels(hResources);
+
+    EZ_TEST_INT(GetNumLevels(hResources[2]), 4);
+    EZ_TEST_INT(GetNumLevels(hResources[3]), 4);
+  }
+
+  hResources.Clear();
+  ezResourceManager::FreeAllUnusedResources();
+  EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<StreamingTestResource>()->GetCount(), 0);
+}
@@ -0,0 +1,163 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Core/World/WorldCommandBuffer.h>
+
+namespace
+{
+  class CommandBufferTestComponent;
+  class CommandBufferTestComponentManager : public ezComponentManager<CommandBufferTestComponent, ezBlockStorageType::FreeList>
+  {
+  public:
+    CommandBufferTestComponentManager(ezWorld* pWorld)
+      : ezComponentManager<CommandBufferTestComponent, ezBlockStorageType::FreeList>(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(CommandBufferTestComponentManager::UpdateAsync, this);
+      desc.m_Phase = ezComponentManagerBase::UpdateFunctionDesc::Phase::Async;
+      desc.m_uiGranularity = 8;
+
+      this->RegisterUpdateFunction(desc);
+    }
+
+    void UpdateAsync(const ezWorldModule::UpdateContext& context);
+
+    ezUInt32 m_uiFrame = 0;
+    ezAtomicInteger32 m_iWrongCommandBuffer;
+    ezDynamicArray<ezUInt32> m_ReplayOrder;
+  };
+
+  class CommandBufferTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(CommandBufferTestComponent, ezComponent, CommandBufferTestComponentManager);
+
+  public:
+    ezUInt32 m_uiIndex = 0;
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(CommandBufferTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  void CommandBufferTestComponentManager::UpdateAsync(const ezWorldModule::UpdateContext& context)
+  {
+    ezWorldCommandBuffer* pCommandBuffer = context.m_pCommandBuffer;
+    if (pCommandBuffer == nullptr || GetWorld()->GetCommandBuffer() != pCommandBuffer)
+    {
+      m_iWrongCommandBuffer.Increment();
+      return;
+    }
+
+    for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+    {
+      CommandBufferTestComponent* pComponent = it;
+      const ezUInt32 uiIndex = pComponent->m_uiIndex;
+      const ezGameObjectHandle hOwner = pComponent->GetOwner()->GetHandle();
+
+      if (m_uiFrame == 0)
+      {
+        pCommandBuffer->SetLocalPosition(hOwner, ezVec3((float)uiIndex, 0, 0));
+        pCommandBuffer->SetLocalUniformScaling(hOwner, 2.0f);
+
+        if (uiIndex % 10 == 0)
+        {
+          ezGameObjectDesc desc;
+          desc.m_hParent = hOwner;
+          desc.m_sName.Assign("Child");
+
+          pCommandBuffer->CreateObject(desc,
+            [](ezGameObject* pChild)
+            {
+              ezStringBuilder sName("Created", pChild->GetName());
+              pChild->SetName(sName);
+            });
+        }
+
+        pCommandBuffer->AddFunction(
+          [this, uiIndex](ezWorld& ref_world)
+          {
+            m_ReplayOrder.PushBack(uiIndex);
+          });
+      }
+      else if (uiIndex % 2 == 1)
+      {
+        pCommandBuffer->DeleteComponent(pComponent->GetHandle());
+      }
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, CommandBuffer)
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  constexpr ezUInt32 uiNumObjects = 100;
+
+  CommandBufferTestComponentManager* pManager = world.GetOrCreateComponentManager<CommandBufferTestComponentManager>();
+
+  ezGameObjectHandle hObjects[uiNumObjects];
+  for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+  {
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = true;
+
+    ezGameObject* pObject = nullptr;
+    hObjects[i] = world.CreateObject(desc, pObject);
+
+    CommandBufferTestComponent* pComponent = nullptr;
+    pManager->CreateComponent(pObject, pComponent);
+    pComponent->m_uiIndex = i;
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Outside of async phase")
+  {
+    EZ_TEST_BOOL(world.GetCommandBuffer() == nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Replay")
+  {
+    world.Update();
+
+    EZ_TEST_INT(pManager->m_iWrongCommandBuffer, 0);
+
+    // the commands are replayed in the order of the update batches, independent of which thread executed them
+    EZ_TEST_INT(pManager->m_ReplayOrder.GetCount(), uiNumObjects);
+    for (ezUInt32 i = 0; i < pManager->m_ReplayOrder.GetCount(); ++i)
+    {
+      EZ_TEST_INT(pManager->m_ReplayOrder[i], i);
+    }
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ezGameObject* pObject = nullptr;
+      EZ_TEST_BOOL(world.TryGetObject(hObjects[i], pObject));
+
+      EZ_TEST_VEC3(pObject->GetLocalPosition(), ezVec3((float)i, 0, 0), 0);
+      EZ_TEST_FLOAT(pObject->GetLocalUniformScaling(), 2.0f, 0);
+
+      // global transforms are updated after the post-async phase, so the changes are visible in the same frame
+      EZ_TEST_VEC3(pObject->GetGlobalPosition(), ezVec3((float)i, 0, 0), 0);
+
+      const ezUInt32 uiExpectedChildren = (i % 10 == 0) ? 1 : 0;
+      EZ_TEST_INT(pObject->GetChildCount(), uiExpectedChildren);
+
+      for (auto it = pObject->GetChildren(); it.IsValid(); ++it)
+      {
+        EZ_TEST_STRING(it->GetName(), "CreatedChild");
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Delete Components")
+  {
+    pManager->m_uiFrame = 1;
+    world.Update();
+
+    EZ_TEST_INT(pManager->m_iWrongCommandBuffer, 0);
+    EZ_TEST_INT(pManager->GetComponentCount(), uiNumObjects / 2);
+  }
+}
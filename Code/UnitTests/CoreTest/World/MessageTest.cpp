@@ -233,4 +233,63 @@ EZ_CREATE_SIMPLE_TEST(World, Messaging)
 
     ezFrameAllocator::Reset();
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing with many delays")
+  {
+    ResetComponents(*pRoot);
+
+    // delays from a few milliseconds up to several minutes, so that all levels of the timing wheel are used
+    ezDynamicArray<ezTime> dueTimes;
+    for (ezUInt32 i = 0; i < 5000; ++i)
+    {
+      const ezTime delay = ezTime::MakeFromMilliseconds((i * 7919) % 300000 + 1);
+
+      TestMessage1 msg;
+      msg.m_iValue = 1;
+      pRoot->PostMessage(msg, delay);
+
+      dueTimes.PushBack(world.GetClock().GetAccumulatedTime() + delay);
+    }
+
+    TestComponentMsg* pComponent2 = nullptr;
+    pRoot->TryGetComponentOfBaseType(pComponent2);
+
+    auto CheckProcessedMessages = [&]()
+    {
+      const ezTime now = world.GetClock().GetAccumulatedTime();
+
+      ezInt32 iExpected = 1;
+      for (ezTime due : dueTimes)
+      {
+        if (due <= now)
+          ++iExpected;
+      }
+
+      EZ_TEST_INT(pComponent2->m_iSomeData, iExpected);
+    };
+
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromMilliseconds(250.5));
+
+    for (ezUInt32 i = 0; i < 200; ++i)
+    {
+      world.Update();
+      CheckProcessedMessages();
+    }
+
+    // a large time step skips many slots at once
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromSeconds(120.0));
+    world.Update();
+    CheckProcessedMessages();
+
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromSeconds(60.0));
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      world.Update();
+      CheckProcessedMessages();
+    }
+
+    EZ_TEST_INT(pComponent2->m_iSomeData, 5001);
+
+    ezFrameAllocator::Reset();
+  }
 }
@@ -0,0 +1,247 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/World/World.h>
+
+namespace
+{
+  static ezAtomicInteger32 s_iTicket;
+
+  template <typename ComponentType>
+  class ParallelUpdateTestComponentManager : public ezComponentManager<ComponentType, ezBlockStorageType::Compact>
+  {
+  public:
+    ParallelUpdateTestComponentManager(ezWorld* pWorld)
+      : ezComponentManager<ComponentType, ezBlockStorageType::Compact>(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelUpdateTestComponentManager::Update, this);
+      desc.m_sFunctionName.Assign(ComponentType::s_szFunctionName);
+      desc.m_Phase = ezWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+      desc.m_fPriority = ComponentType::s_fPriority;
+      desc.m_bOnlyAccessesDeclaredTypes = ComponentType::s_bOnlyAccessesDeclaredTypes;
+      ComponentType::GetReadTypes(desc.m_ReadsFrom);
+
+      this->RegisterUpdateFunction(desc);
+    }
+
+    void Update(const ezWorldModule::UpdateContext& context)
+    {
+      m_iStartTicket = s_iTicket.Increment();
+
+      for (auto it = this->m_ComponentStorage.GetIterator(); it.IsValid(); ++it)
+      {
+        it->Update();
+      }
+
+      m_iEndTicket = s_iTicket.Increment();
+    }
+
+    ezInt32 m_iStartTicket = 0;
+    ezInt32 m_iEndTicket = 0;
+  };
+
+  class WriterAComponent;
+  using WriterAComponentManager = ParallelUpdateTestComponentManager<WriterAComponent>;
+
+  class WriterAComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(WriterAComponent, ezComponent, WriterAComponentManager);
+
+  public:
+    static constexpr const char* s_szFunctionName = "WriterA";
+    static constexpr float s_fPriority = 10.0f;
+    static constexpr bool s_bOnlyAccessesDeclaredTypes = true;
+    static void GetReadTypes(ezHybridArray<const ezRTTI*, 2>& out_types) {}
+
+    void Update() { m_iValue += 1; }
+
+    ezInt32 m_iValue = 0;
+  };
+
+  class WriterBComponent;
+  using WriterBComponentManager = ParallelUpdateTestComponentManager<WriterBComponent>;
+
+  class WriterBComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(WriterBComponent, ezComponent, WriterBComponentManager);
+
+  public:
+    static constexpr const char* s_szFunctionName = "WriterB";
+    static constexpr float s_fPriority = 10.0f;
+    static constexpr bool s_bOnlyAccessesDeclaredTypes = true;
+    static void GetReadTypes(ezHybridArray<const ezRTTI*, 2>& out_types) {}
+
+    void Update() { m_iValue += 10; }
+
+    ezInt32 m_iValue = 0;
+  };
+
+  class ReaderComponent;
+  using ReaderComponentManager = ParallelUpdateTestComponentManager<ReaderComponent>;
+
+  class ReaderComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ReaderComponent, ezComponent, ReaderComponentManager);
+
+  public:
+    static constexpr const char* s_szFunctionName = "Reader";
+    static constexpr float s_fPriority = 0.0f;
+    static constexpr bool s_bOnlyAccessesDeclaredTypes = true;
+    static void GetReadTypes(ezHybridArray<const ezRTTI*, 2>& out_types)
+    {
+      out_types.PushBack(ezGetStaticRTTI<WriterAComponent>());
+      out_types.PushBack(ezGetStaticRTTI<WriterBComponent>());
+    }
+
+    void Update()
+    {
+      const ezWorld* pWorld = GetWorld();
+
+      m_iSum = 0;
+      for (const ezComponentHandle& hComponent : m_Sources)
+      {
+        const WriterAComponent* pComponentA = nullptr;
+        const WriterBComponent* pComponentB = nullptr;
+
+        if (pWorld->TryGetComponent(hComponent, pComponentA))
+          m_iSum += pComponentA->m_iValue;
+        else if (pWorld->TryGetComponent(hComponent, pComponentB))
+          m_iSum += pComponentB->m_iValue;
+      }
+    }
+
+    ezHybridArray<ezComponentHandle, 4> m_Sources;
+    ezInt32 m_iSum = 0;
+  };
+
+  class ExclusiveComponent;
+  using ExclusiveComponentManager = ParallelUpdateTestComponentManager<ExclusiveComponent>;
+
+  class ExclusiveComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(ExclusiveComponent, ezComponent, ExclusiveComponentManager);
+
+  public:
+    // doesn't declare its accesses and thus must not run concurrently with any other function
+    static constexpr const char* s_szFunctionName = "Exclusive";
+    static constexpr float s_fPriority = -10.0f;
+    static constexpr bool s_bOnlyAccessesDeclaredTypes = false;
+    static void GetReadTypes(ezHybridArray<const ezRTTI*, 2>& out_types) {}
+
+    void Update()
+    {
+      ++m_uiUpdateCount;
+
+      if (!ezThreadUtils::IsMainThread())
+        m_bRanOnOtherThread = true;
+
+      // reading undeclared modules is allowed for functions that don't declare their accesses
+      m_iSum = 0;
+      for (auto it = GetWorld()->GetComponentManager<WriterAComponentManager>()->GetComponents(); it.IsValid(); ++it)
+      {
+        m_iSum += it->m_iValue;
+      }
+    }
+
+    ezUInt32 m_uiUpdateCount = 0;
+    ezInt32 m_iSum = 0;
+    bool m_bRanOnOtherThread = false;
+  };
+
+  EZ_BEGIN_COMPONENT_TYPE(WriterAComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  EZ_BEGIN_COMPONENT_TYPE(WriterBComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  EZ_BEGIN_COMPONENT_TYPE(ReaderComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  EZ_BEGIN_COMPONENT_TYPE(ExclusiveComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE
+
+  struct ParallelUpdateTestResult
+  {
+    ezInt32 m_iSum = 0;
+    ezInt32 m_iExclusiveSum = 0;
+    ezUInt32 m_uiExclusiveUpdates = 0;
+    bool m_bExclusiveRanOnOtherThread = false;
+  };
+
+  ParallelUpdateTestResult RunParallelUpdateTest(bool bParallel, ezUInt32 uiNumFrames)
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_bParallelUpdateFunctions = bParallel;
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(desc, pObject);
+
+    ReaderComponent* pReader = nullptr;
+    world.GetOrCreateComponentManager<ReaderComponentManager>()->CreateComponent(pObject, pReader);
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      WriterAComponent* pComponentA = nullptr;
+      pReader->m_Sources.PushBack(world.GetOrCreateComponentManager<WriterAComponentManager>()->CreateComponent(pObject, pComponentA));
+
+      WriterBComponent* pComponentB = nullptr;
+      pReader->m_Sources.PushBack(world.GetOrCreateComponentManager<WriterBComponentManager>()->CreateComponent(pObject, pComponentB));
+    }
+
+    ExclusiveComponent* pExclusive = nullptr;
+    world.GetOrCreateComponentManager<ExclusiveComponentManager>()->CreateComponent(pObject, pExclusive);
+
+    const WriterAComponentManager* pManagerA = world.GetComponentManager<WriterAComponentManager>();
+    const WriterBComponentManager* pManagerB = world.GetComponentManager<WriterBComponentManager>();
+    const ReaderComponentManager* pManagerReader = world.GetComponentManager<ReaderComponentManager>();
+    const ExclusiveComponentManager* pManagerExclusive = world.GetComponentManager<ExclusiveComponentManager>();
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      world.Update();
+
+      // the writers don't depend on each other, but the reader must wait for both and the undeclared function for everything
+      EZ_TEST_BOOL(pManagerA->m_iStartTicket < pManagerA->m_iEndTicket);
+      EZ_TEST_BOOL(pManagerB->m_iStartTicket < pManagerB->m_iEndTicket);
+      EZ_TEST_BOOL(pManagerReader->m_iStartTicket > pManagerA->m_iEndTicket);
+      EZ_TEST_BOOL(pManagerReader->m_iStartTicket > pManagerB->m_iEndTicket);
+      EZ_TEST_BOOL(pManagerExclusive->m_iStartTicket > pManagerReader->m_iEndTicket);
+    }
+
+    ParallelUpdateTestResult result;
+    result.m_iSum = pReader->m_iSum;
+    result.m_iExclusiveSum = pExclusive->m_iSum;
+    result.m_uiExclusiveUpdates = pExclusive->m_uiUpdateCount;
+    result.m_bExclusiveRanOnOtherThread = pExclusive->m_bRanOnOtherThread;
+    return result;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, ParallelUpdateFunctions)
+{
+  constexpr ezUInt32 uiNumFrames = 20;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Serial")
+  {
+    ParallelUpdateTestResult result = RunParallelUpdateTest(false, uiNumFrames);
+    EZ_TEST_INT(result.m_iSum, uiNumFrames * 3 * (1 + 10));
+    EZ_TEST_INT(result.m_uiExclusiveUpdates, uiNumFrames);
+    EZ_TEST_INT(result.m_iExclusiveSum, uiNumFrames * 3);
+    EZ_TEST_BOOL(!result.m_bExclusiveRanOnOtherThread);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Parallel")
+  {
+    ParallelUpdateTestResult result = RunParallelUpdateTest(true, uiNumFrames);
+    EZ_TEST_INT(result.m_iSum, uiNumFrames * 3 * (1 + 10));
+    EZ_TEST_INT(result.m_uiExclusiveUpdates, uiNumFrames);
+    EZ_TEST_INT(result.m_iExclusiveSum, uiNumFrames * 3);
+    EZ_TEST_BOOL(!result.m_bExclusiveRanOnOtherThread);
+  }
+}
@@ -0,0 +1,248 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  class PrefabTestComponent;
+  using PrefabTestComponentManager = ezComponentManager<PrefabTestComponent, ezBlockStorageType::FreeList>;
+
+  class PrefabTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(PrefabTestComponent, ezComponent, PrefabTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override
+    {
+      SUPER::SerializeComponent(inout_stream);
+
+      inout_stream.GetStream() << m_fSpeed;
+      inout_stream.WriteGameObjectHandle(m_hTarget);
+      inout_stream.WriteComponentHandle(m_hTargetComponent);
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override
+    {
+      SUPER::DeserializeComponent(inout_stream);
+
+      inout_stream.GetStream() >> m_fSpeed;
+      m_hTarget = inout_stream.ReadGameObjectHandle();
+      inout_stream.ReadComponentHandle(m_hTargetComponent);
+    }
+
+    float m_fSpeed = 0.0f;
+    ezGameObjectHandle m_hTarget;
+    ezComponentHandle m_hTargetComponent;
+    bool m_bWasInitialized = false;
+
+  protected:
+    virtual void Initialize() override { m_bWasInitialized = true; }
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(PrefabTestComponent, 1, ezComponentMode::Dynamic)
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  /// a 'bullet' with a trail and a light as children, the trail references the bullet
+  void WritePrefabTestTemplate(ezStreamWriter& inout_stream)
+  {
+    ezWorldDesc worldDesc("PrefabTemplate");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = true;
+    desc.m_sName.Assign("Bullet");
+    desc.m_LocalPosition.Set(1, 0, 0);
+
+    ezGameObject* pRoot = nullptr;
+    const ezGameObjectHandle hRoot = world.CreateObject(desc, pRoot);
+
+    PrefabTestComponent* pComponent = nullptr;
+    const ezComponentHandle hRootComponent = PrefabTestComponent::CreateComponent(pRoot, pComponent);
+    pComponent->m_fSpeed = 100.0f;
+
+    desc.m_hParent = hRoot;
+    desc.m_LocalPosition.SetZero();
+    desc.m_sName.Assign("Trail");
+
+    ezGameObject* pChild = nullptr;
+    world.CreateObject(desc, pChild);
+
+    PrefabTestComponent::CreateComponent(pChild, pComponent);
+    pComponent->m_fSpeed = 1.0f;
+    pComponent->m_hTarget = hRoot;
+    pComponent->m_hTargetComponent = hRootComponent;
+
+    desc.m_sName.Assign("Light");
+
+    world.CreateObject(desc, pChild);
+
+    PrefabTestComponent::CreateComponent(pChild, pComponent);
+    pComponent->m_fSpeed = 2.0f;
+
+    const ezGameObject* rootObjects[] = {pRoot};
+
+    ezWorldWriter writer;
+    writer.WriteObjects(inout_stream, ezMakeArrayPtr(rootObjects));
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, PrefabInstantiation)
+{
+  ezDefaultMemoryStreamStorage storage;
+
+  {
+    ezMemoryStreamWriter memWriter(&storage);
+    WritePrefabTestTemplate(memWriter);
+  }
+
+  ezWorldReader reader;
+
+  {
+    ezMemoryStreamReader memReader(&storage);
+    EZ_TEST_BOOL(reader.ReadWorldDescription(memReader).Succeeded());
+  }
+
+  EZ_TEST_INT(reader.GetRootObjectCount(), 1);
+  EZ_TEST_INT(reader.GetChildObjectCount(), 2);
+
+  ezWorldDesc worldDesc("PrefabInstantiation");
+  ezWorld world(worldDesc);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs")
+  {
+    EZ_LOCK(world.GetWriteMarker());
+
+    constexpr ezUInt32 uiNumCopies = 10;
+
+    ezDynamicArray<ezTransform> transforms;
+    for (ezUInt32 i = 0; i < uiNumCopies; ++i)
+    {
+      transforms.PushBack(ezTransform(ezVec3(0, (float)i, 0)));
+    }
+
+    ezDynamicArray<ezGameObject*> rootObjects;
+    ezDynamicArray<ezGameObject*> childObjects;
+
+    ezPrefabInstantiationOptions options;
+    options.m_pCreatedRootObjectsOut = &rootObjects;
+    options.m_pCreatedChildObjectsOut = &childObjects;
+    options.m_RandomSeedMode = ezPrefabInstantiationOptions::RandomSeedMode::CustomRootValue;
+    options.m_uiCustomRandomSeedRootValue = 42;
+
+    reader.InstantiatePrefabs(world, transforms, options);
+
+    EZ_TEST_INT(world.GetObjectCount(), uiNumCopies * 3);
+    if (!EZ_TEST_INT(rootObjects.GetCount(), uiNumCopies) || !EZ_TEST_INT(childObjects.GetCount(), uiNumCopies * 2))
+      return;
+
+    for (ezUInt32 i = 0; i < uiNumCopies; ++i)
+    {
+      ezGameObject* pRoot = rootObjects[i];
+      ezGameObject* pTrail = childObjects[i * 2 + 0];
+      ezGameObject* pLight = childObjects[i * 2 + 1];
+
+      EZ_TEST_STRING(pRoot->GetName(), "Bullet");
+      EZ_TEST_STRING(pTrail->GetName(), "Trail");
+      EZ_TEST_STRING(pLight->GetName(), "Light");
+      EZ_TEST_VEC3(pRoot->GetLocalPosition(), ezVec3(1, (float)i, 0), 0.0001f);
+      EZ_TEST_BOOL(pTrail->GetParent() == pRoot);
+      EZ_TEST_BOOL(pLight->GetParent() == pRoot);
+
+      // every copy gets a different seed
+      if (i > 0)
+      {
+        EZ_TEST_BOOL(pRoot->GetStableRandomSeed() != rootObjects[i - 1]->GetStableRandomSeed());
+      }
+
+      PrefabTestComponent* pComponent = nullptr;
+      EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent));
+      EZ_TEST_FLOAT(pComponent->m_fSpeed, 100.0f, 0.0f);
+      EZ_TEST_BOOL(pComponent->IsActive());
+      const ezComponentHandle hRootComponent = pComponent->GetHandle();
+
+      // handles are remapped to the objects and components of the same copy
+      EZ_TEST_BOOL(pTrail->TryGetComponentOfBaseType(pComponent));
+      EZ_TEST_FLOAT(pComponent->m_fSpeed, 1.0f, 0.0f);
+      EZ_TEST_BOOL(pComponent->m_hTarget == pRoot->GetHandle());
+      EZ_TEST_BOOL(pComponent->m_hTargetComponent == hRootComponent);
+
+      EZ_TEST_BOOL(pLight->TryGetComponentOfBaseType(pComponent));
+      EZ_TEST_FLOAT(pComponent->m_fSpeed, 2.0f, 0.0f);
+      EZ_TEST_BOOL(pComponent->m_hTarget.IsInvalidated());
+      EZ_TEST_BOOL(pComponent->m_hTargetComponent.IsInvalidated());
+    }
+
+    // components are initialized with the next world update
+    world.Update();
+
+    for (ezGameObject* pRoot : rootObjects)
+    {
+      PrefabTestComponent* pComponent = nullptr;
+      EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent));
+      EZ_TEST_BOOL(pComponent->m_bWasInitialized);
+    }
+
+    // a single instantiation still works as before
+    rootObjects.Clear();
+    childObjects.Clear();
+    reader.InstantiatePrefab(world, ezTransform(ezVec3(0, 0, 5)), options);
+    if (EZ_TEST_INT(rootObjects.GetCount(), 1) && EZ_TEST_INT(childObjects.GetCount(), 2))
+    {
+      EZ_TEST_VEC3(rootObjects[0]->GetLocalPosition(), ezVec3(1, 0, 5), 0.0001f);
+
+      PrefabTestComponent* pComponent = nullptr;
+      EZ_TEST_BOOL(childObjects[0]->TryGetComponentOfBaseType(pComponent));
+      EZ_TEST_BOOL(pComponent->m_hTarget == rootObjects[0]->GetHandle());
+    }
+
+    world.Clear();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    EZ_LOCK(world.GetWriteMarker());
+
+    constexpr ezUInt32 uiNumCopies = 500;
+    constexpr ezUInt32 uiNumIterations = 10;
+
+    ezDynamicArray<ezTransform> transforms;
+    for (ezUInt32 i = 0; i < uiNumCopies; ++i)
+    {
+      transforms.PushBack(ezTransform(ezVec3((float)(i % 20), (float)(i / 20), 0)));
+    }
+
+    ezTime tSingle;
+    ezTime tBatch;
+
+    for (ezUInt32 iteration = 0; iteration < uiNumIterations; ++iteration)
+    {
+      ezStopwatch sw;
+
+      for (const ezTransform& transform : transforms)
+      {
+        reader.InstantiatePrefab(world, transform, ezPrefabInstantiationOptions());
+      }
+
+      tSingle += sw.Checkpoint();
+      EZ_TEST_INT(world.GetObjectCount(), uiNumCopies * 3);
+      world.Clear();
+
+      sw.Checkpoint();
+      reader.InstantiatePrefabs(world, transforms, ezPrefabInstantiationOptions());
+
+      tBatch += sw.Checkpoint();
+      EZ_TEST_INT(world.GetObjectCount(), uiNumCopies * 3);
+      world.Clear();
+    }
+
+    ezLog::Info("[test]Instantiating a prefab {} times with InstantiatePrefab(): {}", uiNumCopies, tSingle / uiNumIterations);
+    ezLog::Info("[test]Instantiating a prefab {} times with InstantiatePrefabs(): {} ({}x faster)", uiNumCopies, tBatch / uiNumIterations, ezArgF(tSingle.GetSeconds() / tBatch.GetSeconds(), 1));
+  }
+}
@@ -1,13 +1,19 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Containers/HashSet.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Profiling/ProfilingUtils.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Utilities/GraphicsUtils.h>
 
 namespace
@@ -27,9 +33,9 @@ namespace
     {
       auto& rng = GetWorld()->GetRandomNumberGenerator();
 
-      float x = (float)rng.DoubleMinMax(1.0, 100.0);
-      float y = (float)rng.DoubleMinMax(1.0, 100.0);
-      float z = (float)rng.DoubleMinMax(1.0, 100.0);
+      float x = (float)rng.DoubleMinMax(m_fMinHalfExtent, m_fMaxHalfExtent);
+      float y = (float)rng.DoubleMinMax(m_fMinHalfExtent, m_fMaxHalfExtent);
+      float z = (float)rng.DoubleMinMax(m_fMinHalfExtent, m_fMaxHalfExtent);
 
       ezBoundingBox bounds = ezBoundingBox::MakeFromCenterAndHalfExtents(ezVec3::MakeZero(), ezVec3(x, y, z));
 
@@ -43,6 +49,8 @@ namespace
     }
 
     ezSpatialData::Category m_SpecialCategory = ezInvalidSpatialDataCategory;
+    double m_fMinHalfExtent = 1.0;
+    double m_fMaxHalfExtent = 100.0;
   };
 
   // clang-format off
@@ -58,12 +66,10 @@ namespace
   // clang-format on
 } // namespace
 
-EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+// Tests that all spatial system implementations have to pass
+static void TestSpatialSystem(ezWorldDesc& ref_worldDesc)
 {
-  ezWorldDesc worldDesc("Test");
-  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
-
-  ezWorld world(worldDesc);
+  ezWorld world(ref_worldDesc);
   EZ_LOCK(world.GetWriteMarker());
 
   auto& rng = world.GetRandomNumberGenerator();
@@ -209,6 +215,83 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsAlongRay")
+  {
+    // shoot rays through some of the objects, so that there is always something to find
+    for (ezUInt32 uiRay = 0; uiRay < 20; ++uiRay)
+    {
+      const ezGameObject* pTarget = objects[uiRay * 7];
+
+      const ezVec3 vRayStart = ezVec3(-12000.0f, (float)rng.DoubleMinMax(-12000.0, 12000.0), (float)rng.DoubleMinMax(-12000.0, 12000.0));
+      ezVec3 vRayDir = pTarget->GetGlobalBounds().m_vCenter - vRayStart;
+      const float fMaxDistance = vRayDir.GetLengthAndNormalize() + 50.0f;
+
+      ezDynamicArray<ezGameObject*> objectsAlongRay;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsAlongRay(vRayStart, vRayDir, fMaxDistance, queryParams, objectsAlongRay);
+
+      for (auto pObject : objectsAlongRay)
+      {
+        float fDistance = 0.0f;
+        EZ_TEST_BOOL(pObject->GetGlobalBounds().GetBox().GetRayIntersection(vRayStart, vRayDir, &fDistance));
+        EZ_TEST_BOOL(fDistance <= fMaxDistance + 0.01f);
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
+
+      EZ_TEST_BOOL(pTarget->IsDynamic() || uniqueObjects.Contains(const_cast<ezGameObject*>(pTarget)));
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        float fDistance = 0.0f;
+        if (it->GetGlobalBounds().GetBox().GetRayIntersection(vRayStart, vRayDir, &fDistance) && fDistance < fMaxDistance - 0.01f)
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        }
+      }
+
+      // early out
+      ezUInt32 uiNumFound = 0;
+      world.GetSpatialSystem()->FindObjectsAlongRay(vRayStart, vRayDir, fMaxDistance, queryParams, [&](ezGameObject* pObject)
+        {
+        ++uiNumFound;
+        return ezVisitorExecution::Stop; });
+
+      EZ_TEST_INT(uiNumFound, objectsAlongRay.IsEmpty() ? 0 : 1);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsAlongRay axis-aligned")
+  {
+    // rays with zero direction components, starting exactly on the planes of the target box or inside its slabs
+    for (ezUInt32 uiRay = 0; uiRay < 20; ++uiRay)
+    {
+      const ezGameObject* pTarget = objects[uiRay * 7];
+      if (pTarget->IsDynamic())
+        continue;
+
+      const ezBoundingBox targetBox = pTarget->GetGlobalBounds().GetBox();
+
+      const ezVec3 vRayStart = (uiRay % 2) == 0 ? ezVec3(-12000.0f, targetBox.m_vMin.y, targetBox.m_vMin.z) : ezVec3(-12000.0f, targetBox.m_vMax.y, targetBox.GetCenter().z);
+      const ezVec3 vRayDir = ezVec3(1, 0, 0);
+      const float fMaxDistance = targetBox.m_vMax.x - vRayStart.x;
+
+      ezDynamicArray<ezGameObject*> objectsAlongRay;
+      world.GetSpatialSystem()->FindObjectsAlongRay(vRayStart, vRayDir, fMaxDistance, queryParams, objectsAlongRay);
+
+      for (auto pObject : objectsAlongRay)
+      {
+        const ezBoundingBox box = pObject->GetGlobalBounds().GetBox();
+        EZ_TEST_BOOL(vRayStart.y >= box.m_vMin.y && vRayStart.y <= box.m_vMax.y);
+        EZ_TEST_BOOL(vRayStart.z >= box.m_vMin.z && vRayStart.z <= box.m_vMax.z);
+        EZ_TEST_BOOL(box.m_vMin.x <= vRayStart.x + fMaxDistance && box.m_vMax.x >= vRayStart.x);
+      }
+
+      EZ_TEST_BOOL(objectsAlongRay.Contains(const_cast<ezGameObject*>(pTarget)));
+    }
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects")
   {
     constexpr uint32_t numUpdates = 13;
@@ -319,3 +402,266 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     world.Update();
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+{
+  ezWorldDesc worldDesc("Test");
+  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+
+  TestSpatialSystem(worldDesc);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects multi-threaded")
+  {
+    ezWorldDesc bigWorldDesc("BigTest");
+    bigWorldDesc.m_uiRandomNumberGeneratorSeed = 7;
+
+    ezWorld bigWorld(bigWorldDesc);
+    EZ_LOCK(bigWorld.GetWriteMarker());
+
+    auto& bigRng = bigWorld.GetRandomNumberGenerator();
+
+    for (ezUInt32 i = 0; i < 20000; ++i)
+    {
+      constexpr const double range = 5000.0;
+
+      ezGameObjectDesc desc;
+      desc.m_LocalPosition.x = (float)bigRng.DoubleMinMax(-range, range);
+      desc.m_LocalPosition.y = (float)bigRng.DoubleMinMax(-range, range);
+      desc.m_LocalPosition.z = (float)bigRng.DoubleMinMax(-range, range);
+
+      ezGameObject* pObject = nullptr;
+      bigWorld.CreateObject(desc, pObject);
+
+      TestBoundsComponent* pComponent = nullptr;
+      TestBoundsComponent::CreateComponent(pObject, pComponent);
+      pComponent->m_fMaxHalfExtent = 10.0;
+    }
+
+    bigWorld.Update();
+
+    ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(ezVec3::MakeZero(), ezVec3::MakeAxisX(), ezVec3::MakeAxisZ());
+    ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 10000.0f);
+    ezFrustum testFrustum = ezFrustum::MakeFromMVP(projection * lookAt);
+
+    ezSpatialSystem::QueryParams bigQueryParams;
+    bigQueryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+
+    ezCVarInt* pParallelThreshold = static_cast<ezCVarInt*>(ezCVar::FindCVarByName("Spatial.Queries.ParallelThreshold"));
+    if (EZ_TEST_BOOL(pParallelThreshold != nullptr))
+    {
+      const int iOldThreshold = pParallelThreshold->GetValue();
+
+      // make sure the multi-threaded path is used, even on machines with few cores
+      ezTaskSystem::SetWorkerThreadCount(4, 2);
+
+      ezDynamicArray<const ezGameObject*> visibleObjectsST;
+      ezDynamicArray<const ezGameObject*> visibleObjectsMT;
+
+      *pParallelThreshold = 0;
+      bigWorld.GetSpatialSystem()->FindVisibleObjects(testFrustum, bigQueryParams, visibleObjectsST, {}, ezVisibilityState::Direct);
+
+      *pParallelThreshold = 256;
+      bigWorld.GetSpatialSystem()->FindVisibleObjects(testFrustum, bigQueryParams, visibleObjectsMT, {}, ezVisibilityState::Direct);
+
+      // the result has to be exactly the same, including the order
+      EZ_TEST_BOOL(!visibleObjectsST.IsEmpty());
+      EZ_TEST_BOOL(visibleObjectsST == visibleObjectsMT);
+
+      for (auto pObject : visibleObjectsMT)
+      {
+        EZ_TEST_BOOL(testFrustum.Overlaps(pObject->GetGlobalBoundsSimd().GetSphere()));
+      }
+
+      // the occlusion callback is called from multiple threads now
+      ezAtomicInteger32 iNumOcclusionTests;
+      auto IsOccluded = [&](const ezSimdBBox& box)
+      {
+        iNumOcclusionTests.Increment();
+        return box.GetCenter().y() > 0.0f;
+      };
+
+      visibleObjectsMT.Clear();
+      bigWorld.GetSpatialSystem()->FindVisibleObjects(testFrustum, bigQueryParams, visibleObjectsMT, IsOccluded, ezVisibilityState::Direct);
+
+      EZ_TEST_BOOL(iNumOcclusionTests > 0);
+      EZ_TEST_BOOL(!visibleObjectsMT.IsEmpty());
+      EZ_TEST_BOOL(visibleObjectsMT.GetCount() < visibleObjectsST.GetCount());
+
+      for (auto pObject : visibleObjectsMT)
+      {
+        EZ_TEST_BOOL(pObject->GetGlobalBounds().m_vCenter.y <= 0.0f);
+      }
+
+      for (ezInt32 iThreshold : {0, 256})
+      {
+        *pParallelThreshold = iThreshold;
+
+        ezStopwatch sw;
+
+        for (ezUInt32 i = 0; i < 10; ++i)
+        {
+          visibleObjectsMT.Clear();
+          bigWorld.GetSpatialSystem()->FindVisibleObjects(testFrustum, bigQueryParams, visibleObjectsMT, {}, ezVisibilityState::Direct);
+        }
+
+        ezTestFramework::Output(ezTestOutput::Duration, "FindVisibleObjects (%s, %u objects visible): %.3fms", iThreshold == 0 ? "ST" : "MT", visibleObjectsMT.GetCount(), sw.GetRunningTotal().GetMilliseconds() / 10.0);
+      }
+
+      *pParallelThreshold = iOldThreshold;
+      ezTaskSystem::SetWorkerThreadCount(-1, -1);
+    }
+  }
+}
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem_LooseOctree)
+{
+  ezWorldDesc worldDesc("Test");
+  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+  worldDesc.m_pSpatialSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_LooseOctree);
+
+  TestSpatialSystem(worldDesc);
+}
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystemPerformance)
+{
+  // A few huge objects (think terrain chunks) mixed with lots of small props, which is the worst case for a regular grid
+  // since all the huge objects end up in its overflow cell and have to be tested by every query.
+  struct Result
+  {
+    ezUInt32 m_uiNumInSpheres = 0;
+    ezUInt32 m_uiNumInBoxes = 0;
+    ezUInt32 m_uiNumAlongRays = 0;
+    ezUInt32 m_uiNumVisible = 0;
+  };
+
+  auto RunBenchmark = [](const char* szName, ezUniquePtr<ezSpatialSystem>&& pSpatialSystem)
+  {
+    constexpr const double range = 8000.0;
+    constexpr ezUInt32 uiNumQueries = 200;
+
+    ezWorldDesc worldDesc(szName);
+    worldDesc.m_uiRandomNumberGeneratorSeed = 11;
+    worldDesc.m_pSpatialSystem = std::move(pSpatialSystem);
+
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    auto& rng = world.GetRandomNumberGenerator();
+
+    for (ezUInt32 i = 0; i < 25064; ++i)
+    {
+      const bool bHuge = i < 64;
+
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = i >= 20064;
+      desc.m_LocalPosition.x = (float)rng.DoubleMinMax(-range, range);
+      desc.m_LocalPosition.y = (float)rng.DoubleMinMax(-range, range);
+      desc.m_LocalPosition.z = (float)rng.DoubleMinMax(-range, range);
+
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
+
+      TestBoundsComponent* pComponent = nullptr;
+      TestBoundsComponent::CreateComponent(pObject, pComponent);
+      pComponent->m_fMinHalfExtent = bHuge ? 500.0 : 0.5;
+      pComponent->m_fMaxHalfExtent = bHuge ? 2000.0 : 4.0;
+    }
+
+    world.Update();
+
+    ezSpatialSystem::QueryParams queryParams;
+    queryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask() | ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+    Result result;
+    ezRandom queryRng;
+    queryRng.Initialize(42);
+
+    ezStopwatch sw;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < 10; ++uiFrame)
+    {
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        if (it->IsDynamic())
+        {
+          it->SetLocalPosition(it->GetLocalPosition() + ezVec3(10.0f, 0, 0));
+        }
+      }
+
+      world.Update();
+    }
+
+    const ezTime tUpdate = sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const ezVec3 vCenter((float)queryRng.DoubleMinMax(-range, range), (float)queryRng.DoubleMinMax(-range, range), (float)queryRng.DoubleMinMax(-range, range));
+      world.GetSpatialSystem()->FindObjectsInSphere(ezBoundingSphere::MakeFromCenterAndRadius(vCenter, 200.0f), queryParams, [&](ezGameObject*)
+        {
+        ++result.m_uiNumInSpheres;
+        return ezVisitorExecution::Continue; });
+    }
+
+    const ezTime tSphere = sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const ezVec3 vCenter((float)queryRng.DoubleMinMax(-range, range), (float)queryRng.DoubleMinMax(-range, range), (float)queryRng.DoubleMinMax(-range, range));
+      world.GetSpatialSystem()->FindObjectsInBox(ezBoundingBox::MakeFromCenterAndHalfExtents(vCenter, ezVec3(200.0f)), queryParams, [&](ezGameObject*)
+        {
+        ++result.m_uiNumInBoxes;
+        return ezVisitorExecution::Continue; });
+    }
+
+    const ezTime tBox = sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const ezVec3 vStart((float)queryRng.DoubleMinMax(-range, range), (float)queryRng.DoubleMinMax(-range, range), (float)queryRng.DoubleMinMax(-range, range));
+      const ezVec3 vDir = ezVec3::MakeRandomDirection(queryRng);
+      world.GetSpatialSystem()->FindObjectsAlongRay(vStart, vDir, 1000.0f, queryParams, [&](ezGameObject*)
+        {
+        ++result.m_uiNumAlongRays;
+        return ezVisitorExecution::Continue; });
+    }
+
+    const ezTime tRay = sw.Checkpoint();
+
+    ezDynamicArray<const ezGameObject*> visibleObjects;
+    for (ezUInt32 i = 0; i < 20; ++i)
+    {
+      const ezVec3 vPos((float)queryRng.DoubleMinMax(-range, range), (float)queryRng.DoubleMinMax(-range, range), 0.0f);
+      const ezAngle yaw = ezAngle::MakeFromDegree((float)queryRng.DoubleMinMax(0.0, 360.0));
+      const ezVec3 vDir(ezMath::Cos(yaw), ezMath::Sin(yaw), 0.0f);
+
+      ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(vPos, vPos + vDir, ezVec3::MakeAxisZ());
+      ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 3000.0f);
+
+      visibleObjects.Clear();
+      world.GetSpatialSystem()->FindVisibleObjects(ezFrustum::MakeFromMVP(projection * lookAt), queryParams, visibleObjects, {}, ezVisibilityState::Direct);
+      result.m_uiNumVisible += visibleObjects.GetCount();
+    }
+
+    const ezTime tFrustum = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: 10 updates: %.2fms, %u sphere queries: %.2fms, %u box queries: %.2fms, %u ray queries: %.2fms, 20 frustum queries: %.2fms", szName,
+      tUpdate.GetMilliseconds(), uiNumQueries, tSphere.GetMilliseconds(), uiNumQueries, tBox.GetMilliseconds(), uiNumQueries, tRay.GetMilliseconds(), tFrustum.GetMilliseconds());
+
+    return result;
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RegularGrid vs. LooseOctree")
+  {
+    const Result grid = RunBenchmark("RegularGrid", EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_RegularGrid));
+    const Result octree = RunBenchmark("LooseOctree", EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_LooseOctree));
+
+    // both systems have to find exactly the same objects
+    EZ_TEST_INT(grid.m_uiNumInSpheres, octree.m_uiNumInSpheres);
+    EZ_TEST_INT(grid.m_uiNumInBoxes, octree.m_uiNumInBoxes);
+    EZ_TEST_INT(grid.m_uiNumAlongRays, octree.m_uiNumAlongRays);
+    EZ_TEST_INT(grid.m_uiNumVisible, octree.m_uiNumVisible);
+
+    EZ_TEST_BOOL(grid.m_uiNumInSpheres > 0);
+    EZ_TEST_BOOL(grid.m_uiNumVisible > 0);
+  }
+}
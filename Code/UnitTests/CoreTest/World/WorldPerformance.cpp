@@ -249,7 +249,7 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
   EZ_TEST_BLOCK(EnableInRelease, "MT Update 250,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
-    worldDesc.m_bAutoCreateSpatialSystem = false; // allows multi-threaded update
+    worldDesc.m_bAutoCreateSpatialSystem = false; // only measure the transform update
     ezWorld world(worldDesc);
     MeasureCreationTime(true, 200, 5, 6, 0, &world);
 
@@ -267,10 +267,53 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 
+  EZ_TEST_BLOCK(EnableInRelease, "Update 250,000 dynamic objects, few moving")
+  {
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    MeasureCreationTime(true, 200, 5, 6, 0, &world);
+
+    // only every 20th root object moves, clean sub-trees are skipped by the transform update
+    ezDynamicArray<ezGameObject*> movingObjects;
+    {
+      EZ_LOCK(world.GetWriteMarker());
+
+      ezUInt32 uiIndex = 0;
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        if (it->GetParent() == nullptr && (uiIndex++ % 20) == 0)
+        {
+          movingObjects.PushBack(it);
+        }
+      }
+
+      // first round always has some overhead
+      world.Update();
+    }
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      EZ_LOCK(world.GetWriteMarker());
+
+      for (ezGameObject* pObject : movingObjects)
+      {
+        pObject->SetLocalPosition(pObject->GetLocalPosition() + ezVec3(0, 0, 1));
+      }
+
+      world.Update();
+
+      const ezTime tDiff = sw.Checkpoint();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Updating %u objects (%u moving sub-trees): %.2fms", world.GetObjectCount(), movingObjects.GetCount(), tDiff.GetMilliseconds());
+    }
+  }
+
   EZ_TEST_BLOCK(EnableInRelease, "MT Update 1,000,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
-    worldDesc.m_bAutoCreateSpatialSystem = false; // allows multi-threaded update
+    worldDesc.m_bAutoCreateSpatialSystem = false; // only measure the transform update
     ezWorld world(worldDesc);
     MeasureCreationTime(true, 100, 1, 3, 1, &world);
 
@@ -1,6 +1,7 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Utilities/GraphicsUtils.h>
 
@@ -257,6 +258,144 @@ EZ_CREATE_SIMPLE_TEST(World, World)
     TestTransforms(o, offset);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Transforms dirty tracking")
+  {
+    // make sure the multi-threaded update is used, even on machines with few cores
+    ezTaskSystem::SetWorkerThreadCount(4, 2);
+
+    ezWorldDesc worldDesc("Test");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromMilliseconds(100));
+
+    // enough objects to use the multi-threaded update
+    constexpr ezUInt32 uiNumRoots = 200;
+    constexpr ezUInt32 uiNumChildren = 30;
+
+    ezDynamicArray<ezGameObject*> roots;
+    ezDynamicArray<ezGameObject*> children;
+    ezDynamicArray<ezGameObject*> grandChildren;
+
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = true;
+
+    for (ezUInt32 r = 0; r < uiNumRoots; ++r)
+    {
+      desc.m_hParent.Invalidate();
+      desc.m_LocalPosition = ezVec3(r * 10.0f, 0, 0);
+
+      ezGameObject* pRoot = nullptr;
+      world.CreateObject(desc, pRoot);
+      roots.PushBack(pRoot);
+
+      for (ezUInt32 c = 0; c < uiNumChildren; ++c)
+      {
+        desc.m_hParent = pRoot->GetHandle();
+        desc.m_LocalPosition = ezVec3(0, (float)c, 0);
+
+        ezGameObject* pChild = nullptr;
+        world.CreateObject(desc, pChild);
+        children.PushBack(pChild);
+
+        desc.m_hParent = pChild->GetHandle();
+        desc.m_LocalPosition = ezVec3(0, 0, 1);
+
+        ezGameObject* pGrandChild = nullptr;
+        world.CreateObject(desc, pGrandChild);
+        grandChildren.PushBack(pGrandChild);
+      }
+    }
+
+    auto CheckTransforms = [&](const ezVec3& vMovedOffset)
+    {
+      for (ezUInt32 r = 0; r < uiNumRoots; ++r)
+      {
+        const ezVec3 vRootPos = ezVec3(r * 10.0f, 0, 0) + ((r % 20 == 0) ? vMovedOffset : ezVec3::MakeZero());
+        EZ_TEST_VEC3(roots[r]->GetGlobalPosition(), vRootPos, 0);
+
+        for (ezUInt32 c = 0; c < uiNumChildren; ++c)
+        {
+          EZ_TEST_VEC3(children[r * uiNumChildren + c]->GetGlobalPosition(), vRootPos + ezVec3(0, (float)c, 0), 0);
+          EZ_TEST_VEC3(grandChildren[r * uiNumChildren + c]->GetGlobalPosition(), vRootPos + ezVec3(0, (float)c, 1), 0);
+        }
+      }
+    };
+
+    world.Update();
+    CheckTransforms(ezVec3::MakeZero());
+
+    // only every 20th root moves, its whole sub-tree must follow
+    const ezVec3 vOffset(0, 0, 100);
+    for (ezUInt32 r = 0; r < uiNumRoots; r += 20)
+    {
+      roots[r]->SetLocalPosition(ezVec3(r * 10.0f, 0, 0) + vOffset);
+    }
+
+    world.Update();
+    CheckTransforms(vOffset);
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+    EZ_TEST_VEC3(roots[0]->GetLinearVelocity(), ezVec3(0, 0, 1000), ezMath::DefaultEpsilon<float>());
+    EZ_TEST_VEC3(grandChildren[5]->GetLinearVelocity(), ezVec3(0, 0, 1000), ezMath::DefaultEpsilon<float>());
+    EZ_TEST_VEC3(roots[1]->GetLinearVelocity(), ezVec3::MakeZero(), 0);
+#endif
+
+    // nothing moves anymore, the last global transforms still have to catch up
+    world.Update();
+    CheckTransforms(vOffset);
+
+#if EZ_ENABLED(EZ_GAMEOBJECT_VELOCITY)
+    EZ_TEST_VEC3(roots[0]->GetLinearVelocity(), ezVec3::MakeZero(), 0);
+    EZ_TEST_VEC3(grandChildren[5]->GetLinearVelocity(), ezVec3::MakeZero(), 0);
+#endif
+
+    // deleting objects moves other transformation data around, moved data must still be updated correctly
+    for (ezUInt32 r = 1; r < uiNumRoots; r += 20)
+    {
+      world.DeleteObjectNow(children[r * uiNumChildren]->GetHandle());
+      children[r * uiNumChildren] = nullptr;
+      grandChildren[r * uiNumChildren] = nullptr;
+    }
+
+    for (ezUInt32 r = 0; r < uiNumRoots; r += 20)
+    {
+      roots[r]->SetLocalPosition(ezVec3(r * 10.0f, 0, 0));
+    }
+
+    world.Update();
+
+    for (ezUInt32 r = 0; r < uiNumRoots; ++r)
+    {
+      const ezVec3 vRootPos = ezVec3(r * 10.0f, 0, 0);
+      EZ_TEST_VEC3(roots[r]->GetGlobalPosition(), vRootPos, 0);
+
+      for (ezUInt32 c = 0; c < uiNumChildren; ++c)
+      {
+        if (children[r * uiNumChildren + c] == nullptr)
+          continue;
+
+        EZ_TEST_VEC3(children[r * uiNumChildren + c]->GetGlobalPosition(), vRootPos + ezVec3(0, (float)c, 0), 0);
+        EZ_TEST_VEC3(grandChildren[r * uiNumChildren + c]->GetGlobalPosition(), vRootPos + ezVec3(0, (float)c, 1), 0);
+      }
+    }
+
+    // re-parenting keeps the global transform, afterwards the child follows its new parent
+    ezGameObject* pChild = children[3];
+    pChild->SetParent(roots[40]->GetHandle());
+    world.Update();
+
+    EZ_TEST_VEC3(pChild->GetGlobalPosition(), ezVec3(0, 3, 0), 0);
+
+    roots[40]->SetLocalPosition(ezVec3(400, 0, 50));
+    world.Update();
+
+    EZ_TEST_VEC3(pChild->GetGlobalPosition(), ezVec3(0, 3, 50), 0);
+    EZ_TEST_VEC3(grandChildren[3]->GetGlobalPosition(), ezVec3(0, 3, 51), 0);
+
+    ezTaskSystem::SetWorkerThreadCount(-1, -1);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "GameObject parenting")
   {
     ezWorldDesc worldDesc("Test");
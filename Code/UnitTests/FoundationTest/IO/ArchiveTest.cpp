@@ -1,12 +1,15 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/System/Process.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
 
 #if (EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) && EZ_ENABLED(EZ_SUPPORTS_FILE_STATS) && defined(BUILDSYSTEM_HAS_ARCHIVE_TOOL))
@@ -159,3 +162,413 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
 }
 
 #endif
+
+#if (EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE) && defined(BUILDSYSTEM_ENABLE_ZSTD_SUPPORT))
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveChunked)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveChunkedTest");
+  sOutputFolder.MakeCleanPath();
+
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveChunked", "output", ezFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  const ezStringBuilder sLargeFile(sOutputFolder, "/Large.bin");
+  const ezStringBuilder sSmallFile(sOutputFolder, "/Small.bin");
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Chunked.ezArchive");
+
+  // not a multiple of the chunk size, so that the last chunk is smaller
+  const ezUInt32 uiLargeSize = ezArchiveUtils::ChunkedEntryChunkSize * 13 + 1234;
+
+  ezDynamicArray<ezUInt8> largeData;
+  largeData.SetCountUninitialized(uiLargeSize);
+  for (ezUInt32 i = 0; i < uiLargeSize; ++i)
+  {
+    largeData[i] = static_cast<ezUInt8>((i / 7) ^ (i >> 12));
+  }
+
+  ezDynamicArray<ezUInt8> smallData;
+  smallData.SetCountUninitialized(1000);
+  for (ezUInt32 i = 0; i < smallData.GetCount(); ++i)
+  {
+    smallData[i] = static_cast<ezUInt8>(i * 13);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Write Archive")
+  {
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sLargeFile, ezFileOpenMode::Write).Succeeded());
+      EZ_TEST_BOOL(file.Write(largeData.GetData(), largeData.GetCount()).Succeeded());
+    }
+
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sSmallFile, ezFileOpenMode::Write).Succeeded());
+      EZ_TEST_BOOL(file.Write(smallData.GetData(), smallData.GetCount()).Succeeded());
+    }
+
+    ezArchiveBuilder builder;
+
+    auto& large = builder.m_Entries.ExpandAndGetRef();
+    large.m_sAbsSourcePath = sLargeFile;
+    large.m_sRelTargetPath = "Large.bin";
+    large.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+
+    auto& small = builder.m_Entries.ExpandAndGetRef();
+    small.m_sAbsSourcePath = sSmallFile;
+    small.m_sRelTargetPath = "Small.bin";
+    small.m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+
+    EZ_TEST_BOOL(builder.WriteArchive(":output/Chunked.ezArchive").Succeeded());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezArchiveReader")
+  {
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()))
+      return;
+
+    const ezUInt32 uiLarge = reader.GetArchiveTOC().FindEntry("Large.bin");
+    const ezUInt32 uiSmall = reader.GetArchiveTOC().FindEntry("Small.bin");
+    if (!EZ_TEST_BOOL(uiLarge != ezInvalidIndex && uiSmall != ezInvalidIndex))
+      return;
+
+    EZ_TEST_BOOL(reader.GetArchiveTOC().m_Entries[uiLarge].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked);
+
+    ezArchiveUtils::ChunkedEntry chunked;
+    EZ_TEST_BOOL(reader.GetChunkedEntry(uiLarge, chunked).Succeeded());
+    EZ_TEST_INT(chunked.m_uiNumChunks, 14);
+    EZ_TEST_INT(chunked.GetUncompressedChunkSize(13), 1234);
+    EZ_TEST_BOOL(reader.GetChunkedEntry(uiSmall, chunked).Failed());
+
+    // uncompressed data is accessible without a copy
+    const ezConstByteArrayPtr view = reader.GetUncompressedEntryData(uiSmall);
+    EZ_TEST_BOOL(view == smallData.GetArrayPtr());
+    EZ_TEST_BOOL(reader.GetUncompressedEntryData(uiLarge).IsEmpty());
+
+    // random access, crossing a chunk boundary
+    ezDynamicArray<ezUInt8> buffer;
+    buffer.SetCount(5000);
+    const ezUInt64 uiOffset = ezArchiveUtils::ChunkedEntryChunkSize * 5 - 2000;
+    EZ_TEST_INT(reader.ReadEntryData(uiLarge, uiOffset, buffer), 5000);
+    EZ_TEST_BOOL(buffer.GetArrayPtr() == largeData.GetArrayPtr().GetSubArray(static_cast<ezUInt32>(uiOffset), 5000));
+
+    // multiple whole chunks, not starting at the first chunk
+    buffer.SetCount(ezArchiveUtils::ChunkedEntryChunkSize * 3);
+    EZ_TEST_INT(reader.ReadEntryData(uiLarge, ezArchiveUtils::ChunkedEntryChunkSize, buffer), ezArchiveUtils::ChunkedEntryChunkSize * 3);
+    EZ_TEST_BOOL(buffer.GetArrayPtr() == largeData.GetArrayPtr().GetSubArray(ezArchiveUtils::ChunkedEntryChunkSize, ezArchiveUtils::ChunkedEntryChunkSize * 3));
+
+    // reading beyond the end
+    buffer.SetCount(5000);
+    EZ_TEST_INT(reader.ReadEntryData(uiLarge, uiLargeSize - 100, buffer), 100);
+    EZ_TEST_BOOL(buffer.GetArrayPtr().GetSubArray(0, 100) == largeData.GetArrayPtr().GetSubArray(uiLargeSize - 100));
+
+    EZ_TEST_INT(reader.ReadEntryData(uiSmall, 10, buffer), smallData.GetCount() - 10);
+    EZ_TEST_BOOL(buffer.GetArrayPtr().GetSubArray(0, 990) == smallData.GetArrayPtr().GetSubArray(10));
+
+    // the entire entry, decompressed in parallel
+    buffer.SetCount(uiLargeSize);
+    EZ_TEST_INT(reader.ReadEntryData(uiLarge, 0, buffer), uiLargeSize);
+    EZ_TEST_BOOL(buffer == largeData);
+
+    // stream reader with small reads and skips
+    ezUniquePtr<ezStreamReader> pStream = reader.CreateEntryReader(uiLarge);
+    buffer.Clear();
+    buffer.SetCount(uiLargeSize);
+
+    ezUInt32 uiPos = 0;
+    while (uiPos < uiLargeSize)
+    {
+      const ezUInt32 uiRead = static_cast<ezUInt32>(pStream->ReadBytes(buffer.GetData() + uiPos, 10000));
+      if (!EZ_TEST_BOOL(uiRead > 0))
+        break;
+
+      uiPos += uiRead;
+      uiPos += static_cast<ezUInt32>(pStream->SkipBytes(50000));
+    }
+
+    bool bMatches = true;
+    ezUInt32 uiCheck = 0;
+    while (uiCheck < uiLargeSize)
+    {
+      const ezUInt32 uiNum = ezMath::Min(10000u, uiLargeSize - uiCheck);
+      bMatches = bMatches && buffer.GetArrayPtr().GetSubArray(uiCheck, uiNum) == largeData.GetArrayPtr().GetSubArray(uiCheck, uiNum);
+      uiCheck += uiNum + 50000;
+    }
+
+    EZ_TEST_BOOL(bMatches);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mount as Data Dir")
+  {
+    if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "ArchiveChunked", "chunked", ezFileSystem::ReadOnly).Succeeded()))
+      return;
+
+    {
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(":chunked/Large.bin").Succeeded());
+      EZ_TEST_INT(file.GetFileSize(), uiLargeSize);
+      EZ_TEST_BOOL(file.GetFileMemoryView().IsEmpty());
+
+      // skip to the 'last mip'
+      const ezUInt32 uiTailOffset = uiLargeSize - 100000;
+      EZ_TEST_INT(file.SkipBytes(uiTailOffset), uiTailOffset);
+
+      ezDynamicArray<ezUInt8> buffer;
+      buffer.SetCount(100000);
+      EZ_TEST_INT(file.ReadBytes(buffer.GetData(), buffer.GetCount()), buffer.GetCount());
+      EZ_TEST_BOOL(buffer.GetArrayPtr() == largeData.GetArrayPtr().GetSubArray(uiTailOffset));
+    }
+
+    {
+      // read a 'header' from the first chunk, then the 'body'
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(":chunked/Large.bin").Succeeded());
+
+      ezDynamicArray<ezUInt8> header;
+      header.SetCount(100);
+      EZ_TEST_INT(file.ReadBytes(header.GetData(), header.GetCount()), header.GetCount());
+      EZ_TEST_BOOL(header.GetArrayPtr() == largeData.GetArrayPtr().GetSubArray(0, 100));
+
+      ezDynamicArray<ezUInt8> body;
+      body.SetCount(ezArchiveUtils::ChunkedEntryChunkSize * 4);
+      EZ_TEST_INT(file.ReadBytes(body.GetData(), body.GetCount()), body.GetCount());
+      EZ_TEST_BOOL(body.GetArrayPtr() == largeData.GetArrayPtr().GetSubArray(100, body.GetCount()));
+    }
+
+    {
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(":chunked/Small.bin").Succeeded());
+      EZ_TEST_BOOL(file.GetFileMemoryView() == smallData.GetArrayPtr());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()))
+      return;
+
+    const ezUInt32 uiLarge = reader.GetArchiveTOC().FindEntry("Large.bin");
+
+    ezDynamicArray<ezUInt8> buffer;
+    buffer.SetCountUninitialized(uiLargeSize);
+
+    constexpr ezUInt32 uiNumIterations = 10;
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      ezUniquePtr<ezStreamReader> pStream = reader.CreateEntryReader(uiLarge);
+      pStream->SkipBytes(uiLargeSize - 4096);
+      pStream->ReadBytes(buffer.GetData(), 4096);
+    }
+
+    const ezTime tTail = sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      reader.ReadEntryData(uiLarge, 0, buffer);
+    }
+
+    const ezTime tParallel = sw.Checkpoint();
+
+    ezArchiveUtils::ChunkedEntry chunked;
+    EZ_TEST_BOOL(reader.GetChunkedEntry(uiLarge, chunked).Succeeded());
+
+    for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      for (ezUInt32 uiChunk = 0; uiChunk < chunked.m_uiNumChunks; ++uiChunk)
+      {
+        chunked.DecompressChunk(uiChunk, buffer.GetData() + uiChunk * chunked.m_uiChunkSize).IgnoreResult();
+      }
+    }
+
+    const ezTime tSerial = sw.Checkpoint();
+
+    EZ_TEST_BOOL(buffer == largeData);
+
+    ezLog::Info("[test]Reading the last 4KB of a {} chunked entry {} times: {}", ezArgFileSize(uiLargeSize), uiNumIterations, tTail);
+    ezLog::Info("[test]Decompressing the entire entry {} times, in parallel: {}", uiNumIterations, tParallel);
+    ezLog::Info("[test]Decompressing the entire entry {} times, serially: {}", uiNumIterations, tSerial);
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveChunked");
+}
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveBuilder)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveBuilderTest");
+  sOutputFolder.MakeCleanPath();
+
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  ezOSFile::CreateDirectoryStructure(ezStringBuilder(sOutputFolder, "/Source")).IgnoreResult();
+
+  ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveBuilder", "output", ezFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  constexpr ezUInt32 uiNumSmallFiles = 256;
+
+  // small text files that share a lot of structure, like materials or configs do
+  ezDynamicArray<ezString> smallFiles;
+  for (ezUInt32 i = 0; i < uiNumSmallFiles; ++i)
+  {
+    ezStringBuilder sContent;
+    sContent.SetFormat("Node\n  string Name \"Material{}\"\n  string BaseMaterial \"d4b59f47-b8b3-4e5d-8b8f-fb2a0a6dbb4c\"\n  string ShaderMode \"File\"\n", i);
+    sContent.AppendFormat("  float Roughness {}\n  float Metallic {}\n  string BaseTexture \"Textures/Rock_{}_D.dds\"\n  string NormalTexture \"Textures/Rock_{}_N.dds\"\n", (i % 10) / 10.0f, (i % 3) / 3.0f, i, i);
+    smallFiles.PushBack(sContent);
+  }
+
+  ezDynamicArray<ezUInt8> sharedData;
+  sharedData.SetCountUninitialized(300000);
+  for (ezUInt32 i = 0; i < sharedData.GetCount(); ++i)
+  {
+    sharedData[i] = static_cast<ezUInt8>((i / 3) ^ (i >> 10));
+  }
+
+  auto WriteFile = [&](ezStringView sName, const void* pData, ezUInt32 uiSize)
+  {
+    ezStringBuilder sPath(sOutputFolder, "/Source/", sName);
+
+    ezOSFile file;
+    EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+    EZ_TEST_BOOL(file.Write(pData, uiSize).Succeeded());
+  };
+
+  auto BuildArchive = [&](ezStringView sArchive, ezUInt32 uiMaxDictionaryFileSize) -> ezTime
+  {
+    ezArchiveBuilder builder;
+    builder.m_uiMaxDictionaryFileSize = uiMaxDictionaryFileSize;
+    builder.m_uiDictionarySize = 4096;
+
+    builder.AddFolder(ezStringBuilder(sOutputFolder, "/Source"), ezArchiveCompressionMode::Uncompressed, [](ezStringView sFile)
+      { return ezPathUtils::HasExtension(sFile, "txt") ? ezArchiveBuilder::InclusionMode::Uncompressed : ezArchiveBuilder::InclusionMode::Compress_zstd_average; });
+
+    ezStopwatch sw;
+    EZ_TEST_BOOL(builder.WriteArchive(ezStringBuilder(":output/", sArchive)).Succeeded());
+    return sw.GetRunningTotal();
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Write Archives")
+  {
+    ezStringBuilder sName;
+    for (ezUInt32 i = 0; i < uiNumSmallFiles; ++i)
+    {
+      sName.SetFormat("Material{}.ezMaterial", i);
+      WriteFile(sName, smallFiles[i].GetData(), smallFiles[i].GetElementCount());
+    }
+
+    WriteFile("SharedA.bin", sharedData.GetData(), sharedData.GetCount());
+    WriteFile("SharedB.bin", sharedData.GetData(), sharedData.GetCount());
+    WriteFile("SharedC.txt", sharedData.GetData(), sharedData.GetCount());
+
+    const ezTime tPlain = BuildArchive("Plain.ezArchive", 0);
+    const ezTime tDictionary = BuildArchive("Dictionary.ezArchive", 4096);
+
+    ezFileStats plainStats, dictionaryStats;
+    EZ_TEST_BOOL(ezOSFile::GetFileStats(ezStringBuilder(sOutputFolder, "/Plain.ezArchive"), plainStats).Succeeded());
+    EZ_TEST_BOOL(ezOSFile::GetFileStats(ezStringBuilder(sOutputFolder, "/Dictionary.ezArchive"), dictionaryStats).Succeeded());
+
+    const ezUInt64 uiPlainSize = plainStats.m_uiFileSize;
+    const ezUInt64 uiDictionarySize = dictionaryStats.m_uiFileSize;
+
+    // the duplicates are not stored, so the archive has to be much smaller than all the files together
+    EZ_TEST_BOOL(uiPlainSize < 2 * sharedData.GetCount());
+    EZ_TEST_BOOL(uiDictionarySize < uiPlainSize);
+
+    ezLog::Info("[test]Archive without dictionaries: {} in {}", ezArgFileSize(uiPlainSize), tPlain);
+    ezLog::Info("[test]Archive with dictionaries: {} in {}", ezArgFileSize(uiDictionarySize), tDictionary);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezArchiveReader")
+  {
+    ezArchiveReader reader;
+    if (!EZ_TEST_BOOL(reader.OpenArchive(ezStringBuilder(sOutputFolder, "/Dictionary.ezArchive")).Succeeded()))
+      return;
+
+    const ezArchiveTOC& toc = reader.GetArchiveTOC();
+    EZ_TEST_INT(toc.m_Entries.GetCount(), uiNumSmallFiles + 3);
+
+    const ezUInt32 uiSharedA = toc.FindEntry("SharedA.bin");
+    const ezUInt32 uiSharedB = toc.FindEntry("SharedB.bin");
+    const ezUInt32 uiSharedC = toc.FindEntry("SharedC.txt");
+    if (!EZ_TEST_BOOL(uiSharedA != ezInvalidIndex && uiSharedB != ezInvalidIndex && uiSharedC != ezInvalidIndex))
+      return;
+
+    // identical content shares the data, even if it was supposed to be stored uncompressed
+    EZ_TEST_INT(toc.m_Entries[uiSharedA].m_uiDataStartOffset, toc.m_Entries[uiSharedB].m_uiDataStartOffset);
+    EZ_TEST_INT(toc.m_Entries[uiSharedA].m_uiDataStartOffset, toc.m_Entries[uiSharedC].m_uiDataStartOffset);
+
+    ezDynamicArray<ezUInt8> buffer;
+    buffer.SetCount(sharedData.GetCount());
+    EZ_TEST_INT(reader.ReadEntryData(uiSharedB, 0, buffer), sharedData.GetCount());
+    EZ_TEST_BOOL(buffer == sharedData);
+
+    ezStringBuilder sName;
+    for (ezUInt32 i = 0; i < uiNumSmallFiles; ++i)
+    {
+      sName.SetFormat("Material{}.ezMaterial", i);
+
+      const ezUInt32 uiEntry = toc.FindEntry(sName);
+      if (!EZ_TEST_BOOL(uiEntry != ezInvalidIndex))
+        continue;
+
+      EZ_TEST_BOOL(toc.m_Entries[uiEntry].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_dictionary);
+
+      ezConstByteArrayPtr compressedData, dictionary;
+      EZ_TEST_BOOL(reader.GetDictionaryEntryData(uiEntry, compressedData, dictionary).Succeeded());
+      EZ_TEST_BOOL(!dictionary.IsEmpty());
+
+      ezUniquePtr<ezStreamReader> pStream = reader.CreateEntryReader(uiEntry);
+      buffer.SetCount(smallFiles[i].GetElementCount() + 10);
+      EZ_TEST_INT(pStream->ReadBytes(buffer.GetData(), buffer.GetCount()), smallFiles[i].GetElementCount());
+      EZ_TEST_BOOL(ezStringView(reinterpret_cast<const char*>(buffer.GetData()), smallFiles[i].GetElementCount()) == smallFiles[i]);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mount as Data Dir")
+  {
+    if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(ezStringBuilder(sOutputFolder, "/Dictionary.ezArchive"), "ArchiveBuilder", "dict", ezFileSystem::ReadOnly).Succeeded()))
+      return;
+
+    ezDynamicArray<ezUInt8> buffer;
+    ezStringBuilder sName;
+
+    // read each file twice, to make sure the readers are properly reset when they are reused
+    for (ezUInt32 uiRound = 0; uiRound < 2; ++uiRound)
+    {
+      for (ezUInt32 i = 0; i < uiNumSmallFiles; ++i)
+      {
+        sName.SetFormat(":dict/Material{}.ezMaterial", i);
+
+        ezFileReader file;
+        if (!EZ_TEST_BOOL(file.Open(sName).Succeeded()))
+          continue;
+
+        buffer.SetCount(static_cast<ezUInt32>(file.GetFileSize()));
+        EZ_TEST_INT(file.ReadBytes(buffer.GetData(), buffer.GetCount()), smallFiles[i].GetElementCount());
+        EZ_TEST_BOOL(ezStringView(reinterpret_cast<const char*>(buffer.GetData()), buffer.GetCount()) == smallFiles[i]);
+      }
+
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(":dict/SharedC.txt").Succeeded());
+      buffer.SetCount(static_cast<ezUInt32>(file.GetFileSize()));
+      EZ_TEST_INT(file.ReadBytes(buffer.GetData(), buffer.GetCount()), sharedData.GetCount());
+      EZ_TEST_BOOL(buffer == sharedData);
+    }
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveBuilder");
+}
+
+#endif
@@ -0,0 +1,226 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/IO/FileSystem/AsyncFileRead.h>
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiAsyncReadNumFiles = 64;
+
+  ezUInt8 GetAsyncReadTestByte(ezUInt32 uiFile, ezUInt32 uiByte)
+  {
+    return static_cast<ezUInt8>((uiFile * 31 + uiByte * 7) & 0xFF);
+  }
+
+  ezUInt32 GetAsyncReadTestFileSize(ezUInt32 uiFile)
+  {
+    return 1000 + uiFile * 997;
+  }
+
+  bool CheckAsyncReadTestData(ezUInt32 uiFile, ezUInt32 uiOffset, ezArrayPtr<const ezUInt8> data)
+  {
+    for (ezUInt32 i = 0; i < data.GetCount(); ++i)
+    {
+      if (data[i] != GetAsyncReadTestByte(uiFile, uiOffset + i))
+        return false;
+    }
+
+    return true;
+  }
+
+  void TestAsyncReads(bool bNative)
+  {
+    ezCVarBool* pNativeReads = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("FileSystem.NativeAsyncReads"));
+    *pNativeReads = bNative;
+
+    ezStringBuilder sFile;
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, bNative ? "Single Read (native)" : "Single Read (tasks)")
+    {
+      sFile.SetFormat(":output/AsyncRead/File{}.bin", 3);
+
+      ezSharedPtr<ezAsyncFileRead> pRead;
+      {
+        ezAsyncFileReadRequest request;
+        request.m_sFile = sFile;
+        pRead = ezFileSystem::ReadAsync(request);
+      }
+
+      pRead->WaitForCompletion();
+      EZ_TEST_BOOL(pRead->IsFinished());
+      EZ_TEST_BOOL(pRead->GetResult().Succeeded());
+      EZ_TEST_INT(pRead->GetNumBytesRead(), GetAsyncReadTestFileSize(3));
+      EZ_TEST_BOOL(CheckAsyncReadTestData(3, 0, pRead->GetData()));
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, bNative ? "Partial Read (native)" : "Partial Read (tasks)")
+    {
+      sFile.SetFormat(":output/AsyncRead/File{}.bin", 5);
+
+      ezUInt8 destination[100];
+
+      ezAsyncFileReadRequest request;
+      request.m_sFile = sFile;
+      request.m_uiOffset = 50;
+      request.m_uiNumBytes = EZ_ARRAY_SIZE(destination);
+      request.m_pDestination = destination;
+
+      ezSharedPtr<ezAsyncFileRead> pRead = ezFileSystem::ReadAsync(request);
+      pRead->WaitForCompletion();
+      EZ_TEST_BOOL(pRead->GetResult().Succeeded());
+      EZ_TEST_INT(pRead->GetNumBytesRead(), EZ_ARRAY_SIZE(destination));
+      EZ_TEST_BOOL(pRead->GetData().GetPtr() == destination);
+      EZ_TEST_BOOL(CheckAsyncReadTestData(5, 50, pRead->GetData()));
+
+      // reading beyond the end of the file returns the remaining bytes
+      request.m_uiOffset = GetAsyncReadTestFileSize(5) - 10;
+      pRead = ezFileSystem::ReadAsync(request);
+      pRead->WaitForCompletion();
+      EZ_TEST_BOOL(pRead->GetResult().Succeeded());
+      EZ_TEST_INT(pRead->GetNumBytesRead(), 10);
+      EZ_TEST_BOOL(CheckAsyncReadTestData(5, GetAsyncReadTestFileSize(5) - 10, pRead->GetData()));
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, bNative ? "Missing File (native)" : "Missing File (tasks)")
+    {
+      ezAsyncFileReadRequest request;
+      request.m_sFile = ":output/AsyncRead/DoesNotExist.bin";
+
+      ezSharedPtr<ezAsyncFileRead> pRead = ezFileSystem::ReadAsync(request);
+      pRead->WaitForCompletion();
+      EZ_TEST_BOOL(pRead->GetResult().Failed());
+      EZ_TEST_INT(pRead->GetNumBytesRead(), 0);
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, bNative ? "Batch (native)" : "Batch (tasks)")
+    {
+      ezAtomicInteger32 iNumCallbacks;
+
+      ezDynamicArray<ezAsyncFileReadRequest> requests;
+      for (ezUInt32 i = 0; i < s_uiAsyncReadNumFiles; ++i)
+      {
+        sFile.SetFormat(":output/AsyncRead/File{}.bin", i);
+
+        ezAsyncFileReadRequest& request = requests.ExpandAndGetRef();
+        request.m_sFile = sFile;
+        request.m_OnCompletion = [&iNumCallbacks](ezAsyncFileRead& ref_read)
+        {
+          EZ_TEST_BOOL(ref_read.GetResult().Succeeded());
+          iNumCallbacks.Increment();
+        };
+      }
+
+      ezDynamicArray<ezSharedPtr<ezAsyncFileRead>> reads;
+      ezFileSystem::ReadAsyncBatch(requests, reads);
+      EZ_TEST_INT(reads.GetCount(), s_uiAsyncReadNumFiles);
+
+      for (ezUInt32 i = 0; i < reads.GetCount(); ++i)
+      {
+        reads[i]->WaitForCompletion();
+        EZ_TEST_INT(reads[i]->GetNumBytesRead(), GetAsyncReadTestFileSize(i));
+        EZ_TEST_BOOL(CheckAsyncReadTestData(i, 0, reads[i]->GetData()));
+      }
+
+      EZ_TEST_INT(iNumCallbacks, s_uiAsyncReadNumFiles);
+    }
+
+    *pNativeReads = true;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, AsyncFileRead)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Setup")
+  {
+    ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "AsyncFileReadTest", "output", ezFileSystem::AllowWrites).Succeeded());
+
+    ezStringBuilder sFile;
+    ezDynamicArray<ezUInt8> content;
+
+    for (ezUInt32 i = 0; i < s_uiAsyncReadNumFiles; ++i)
+    {
+      content.SetCountUninitialized(GetAsyncReadTestFileSize(i));
+      for (ezUInt32 j = 0; j < content.GetCount(); ++j)
+      {
+        content[j] = GetAsyncReadTestByte(i, j);
+      }
+
+      sFile.SetFormat(":output/AsyncRead/File{}.bin", i);
+
+      ezFileWriter file;
+      EZ_TEST_BOOL(file.Open(sFile).Succeeded());
+      EZ_TEST_BOOL(file.WriteBytes(content.GetData(), content.GetCount()).Succeeded());
+    }
+  }
+
+  TestAsyncReads(true);
+  TestAsyncReads(false);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    constexpr ezUInt32 uiNumIterations = 20;
+
+    ezStringBuilder sFile;
+    ezDynamicArray<ezUInt8> buffer;
+    ezUInt64 uiBytesBlocking = 0;
+    ezUInt64 uiBytesAsync = 0;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 iteration = 0; iteration < uiNumIterations; ++iteration)
+    {
+      for (ezUInt32 i = 0; i < s_uiAsyncReadNumFiles; ++i)
+      {
+        sFile.SetFormat(":output/AsyncRead/File{}.bin", i);
+
+        ezFileReader file;
+        if (file.Open(sFile).Succeeded())
+        {
+          buffer.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+          uiBytesBlocking += file.ReadBytes(buffer.GetData(), buffer.GetCount());
+        }
+      }
+    }
+
+    const ezTime tBlocking = sw.Checkpoint();
+
+    ezDynamicArray<ezAsyncFileReadRequest> requests;
+    for (ezUInt32 i = 0; i < s_uiAsyncReadNumFiles; ++i)
+    {
+      sFile.SetFormat(":output/AsyncRead/File{}.bin", i);
+      requests.ExpandAndGetRef().m_sFile = sFile;
+    }
+
+    sw.Checkpoint();
+
+    ezDynamicArray<ezSharedPtr<ezAsyncFileRead>> reads;
+    for (ezUInt32 iteration = 0; iteration < uiNumIterations; ++iteration)
+    {
+      reads.Clear();
+      ezFileSystem::ReadAsyncBatch(requests, reads);
+
+      for (auto& pRead : reads)
+      {
+        pRead->WaitForCompletion();
+        uiBytesAsync += pRead->GetNumBytesRead();
+      }
+    }
+
+    const ezTime tAsync = sw.Checkpoint();
+
+    EZ_TEST_INT(uiBytesAsync, uiBytesBlocking);
+
+    ezLog::Info("[test]Reading {} files {} times with ezFileReader: {}", s_uiAsyncReadNumFiles, uiNumIterations, tBlocking);
+    ezLog::Info("[test]Reading {} files {} times with ReadAsyncBatch: {}", s_uiAsyncReadNumFiles, uiNumIterations, tAsync);
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("AsyncFileReadTest");
+}
@@ -0,0 +1,182 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Stopwatch.h>
+
+EZ_CREATE_SIMPLE_TEST(IO, FileSystemPathCache)
+{
+  constexpr ezUInt32 uiNumDataDirs = 12;
+
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("PathCache");
+
+  ezStringBuilder sTemp;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Setup")
+  {
+    ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+
+    for (ezUInt32 i = 0; i < uiNumDataDirs; ++i)
+    {
+      ezStringBuilder sDataDir, sRootName;
+      sDataDir.SetFormat("{}/Dir{}", sOutputFolder, i);
+      sRootName.SetFormat("pathcache{}", i);
+
+      EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDataDir).Succeeded());
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sDataDir, "PathCacheTest", sRootName, ezFileSystem::AllowWrites).Succeeded());
+    }
+
+    // the file is in the data directory with the lowest priority, so finding it requires probing all of them
+    ezFileWriter file;
+    EZ_TEST_BOOL(file.Open(":pathcache0/PathCacheFile.txt").Succeeded());
+    EZ_TEST_BOOL(file.WriteBytes("Test", 4).Succeeded());
+    file.Close();
+
+    ezFileSystem::DeleteFile(":pathcache1/PathCacheLater.txt");
+
+    ezFileSystem::SetPathCacheEnabled(true);
+    EZ_TEST_BOOL(ezFileSystem::IsPathCacheEnabled());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Hits")
+  {
+    const ezFileSystem::PathCacheStats statsBefore = ezFileSystem::GetPathCacheStats();
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open("PathCacheFile.txt").Succeeded());
+      EZ_TEST_INT(file.GetFileSize(), 4);
+    }
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile("PathCacheFile.txt"));
+
+    const ezFileSystem::PathCacheStats stats = ezFileSystem::GetPathCacheStats();
+    EZ_TEST_INT(stats.m_uiMisses - statsBefore.m_uiMisses, 1);
+    EZ_TEST_INT(stats.m_uiHits - statsBefore.m_uiHits, 3);
+    EZ_TEST_BOOL(stats.m_uiNumEntries > 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Negative Hits")
+  {
+    const ezFileSystem::PathCacheStats statsBefore = ezFileSystem::GetPathCacheStats();
+
+    ezFileReader file;
+    EZ_TEST_BOOL(file.Open("PathCacheLater.txt").Failed());
+    EZ_TEST_BOOL(file.Open("PathCacheLater.txt").Failed());
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile("PathCacheLater.txt"));
+
+    const ezFileSystem::PathCacheStats stats = ezFileSystem::GetPathCacheStats();
+    EZ_TEST_INT(stats.m_uiMisses - statsBefore.m_uiMisses, 1);
+    EZ_TEST_INT(stats.m_uiNegativeHits - statsBefore.m_uiNegativeHits, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Shared entries")
+  {
+    ezFileSystem::ClearPathCache();
+    const ezFileSystem::PathCacheStats statsBefore = ezFileSystem::GetPathCacheStats();
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile("PathCacheFile.txt"));
+
+    {
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open("Sub/../PathCacheFile.txt").Succeeded());
+    }
+
+    ezStringBuilder sAbsPath;
+    EZ_TEST_BOOL(ezFileSystem::ResolvePath("Sub/../PathCacheFile.txt", &sAbsPath, nullptr).Succeeded());
+    EZ_TEST_BOOL(sAbsPath.EndsWith("/PathCacheFile.txt"));
+
+    EZ_TEST_BOOL(ezFileSystem::ResolvePath("PathCacheMissing.txt", nullptr, nullptr).Failed());
+    EZ_TEST_BOOL(ezFileSystem::ResolvePath("PathCacheMissing.txt", nullptr, nullptr).Failed());
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile("Sub/../PathCacheMissing.txt"));
+
+    const ezFileSystem::PathCacheStats stats = ezFileSystem::GetPathCacheStats();
+    EZ_TEST_INT(stats.m_uiMisses - statsBefore.m_uiMisses, 2);
+    EZ_TEST_INT(stats.m_uiHits - statsBefore.m_uiHits, 2);
+    EZ_TEST_INT(stats.m_uiNegativeHits - statsBefore.m_uiNegativeHits, 2);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalidation by writing")
+  {
+    const ezFileSystem::PathCacheStats statsBefore = ezFileSystem::GetPathCacheStats();
+
+    {
+      ezFileWriter file;
+      EZ_TEST_BOOL(file.Open(":pathcache1/PathCacheLater.txt").Succeeded());
+    }
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile("PathCacheLater.txt"));
+    EZ_TEST_BOOL(ezFileSystem::GetPathCacheStats().m_uiInvalidations > statsBefore.m_uiInvalidations);
+
+    ezFileSystem::DeleteFile(":pathcache1/PathCacheLater.txt");
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile("PathCacheLater.txt"));
+  }
+
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalidation by external changes")
+  {
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile("PathCacheExternal.txt"));
+
+    sTemp.SetFormat("{}/Dir5/PathCacheExternal.txt", sOutputFolder);
+
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sTemp, ezFileOpenMode::Write).Succeeded());
+    }
+
+    // the directory watchers are only polled every once in a while
+    bool bFound = false;
+    for (ezUInt32 i = 0; i < 50 && !bFound; ++i)
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(50));
+      bFound = ezFileSystem::ExistsFile("PathCacheExternal.txt");
+    }
+
+    EZ_TEST_BOOL(bFound);
+
+    EZ_TEST_BOOL(ezOSFile::DeleteFile(sTemp).Succeeded());
+  }
+#endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    constexpr ezUInt32 uiNumLookups = 2000;
+
+    ezFileSystem::SetPathCacheEnabled(false);
+
+    ezStopwatch sw;
+    for (ezUInt32 i = 0; i < uiNumLookups; ++i)
+    {
+      ezFileSystem::ExistsFile("PathCacheFile.txt");
+      ezFileSystem::ExistsFile("PathCacheMissing.txt");
+    }
+    const ezTime tUncached = sw.Checkpoint();
+
+    ezFileSystem::SetPathCacheEnabled(true);
+    sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumLookups; ++i)
+    {
+      ezFileSystem::ExistsFile("PathCacheFile.txt");
+      ezFileSystem::ExistsFile("PathCacheMissing.txt");
+    }
+    const ezTime tCached = sw.Checkpoint();
+
+    ezLog::Info("[test]{} lookups in {} data directories without path cache: {}", uiNumLookups * 2, uiNumDataDirs, tUncached);
+    ezLog::Info("[test]{} lookups in {} data directories with path cache: {}", uiNumLookups * 2, uiNumDataDirs, tCached);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Shutdown")
+  {
+    ezFileSystem::RemoveDataDirectoryGroup("PathCacheTest");
+    EZ_TEST_INT(ezFileSystem::GetPathCacheStats().m_uiNumEntries, 0);
+
+    ezFileSystem::SetPathCacheEnabled(false);
+    EZ_TEST_BOOL(!ezFileSystem::IsPathCacheEnabled());
+  }
+}
@@ -0,0 +1,179 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Texture/Image/Image.h>
+#include <Texture/Image/ImageConversion.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiBlockCompressionImageSize = 64;
+
+  /// smooth gradients in the upper half, hard edges in the lower left and noise in the lower right quadrant
+  void CreateBlockCompressionTestImage(ezImage& ref_image, bool bOpaque)
+  {
+    ezImageHeader header;
+    header.SetWidth(s_uiBlockCompressionImageSize);
+    header.SetHeight(s_uiBlockCompressionImageSize);
+    header.SetImageFormat(ezImageFormat::R8G8B8A8_UNORM);
+    ref_image.ResetAndAlloc(header);
+
+    ezUInt32 uiNoise = 12345;
+
+    for (ezUInt32 y = 0; y < s_uiBlockCompressionImageSize; ++y)
+    {
+      ezUInt8* pPixel = ref_image.GetPixelPointer<ezUInt8>(0, 0, 0, 0, y);
+
+      for (ezUInt32 x = 0; x < s_uiBlockCompressionImageSize; ++x, pPixel += 4)
+      {
+        pPixel[0] = static_cast<ezUInt8>(x * 4);
+        pPixel[1] = static_cast<ezUInt8>(y * 4);
+        pPixel[2] = static_cast<ezUInt8>(255 - (x + y) * 2);
+        pPixel[3] = bOpaque ? 255 : static_cast<ezUInt8>(128 + ezMath::Sin(ezAngle::MakeFromDegree(x * 11.0f)) * 100.0f);
+
+        if (y >= s_uiBlockCompressionImageSize / 2)
+        {
+          if (x < s_uiBlockCompressionImageSize / 2)
+          {
+            const bool bChecker = ((x / 3) + (y / 3)) % 2 == 0;
+            pPixel[0] = bChecker ? 240 : 20;
+            pPixel[1] = bChecker ? 200 : 60;
+          }
+          else
+          {
+            uiNoise = uiNoise * 1103515245 + 12345;
+            pPixel[0] = static_cast<ezUInt8>(pPixel[0] / 2 + ((uiNoise >> 16) & 0x3F));
+            pPixel[1] = static_cast<ezUInt8>(pPixel[1] / 2 + ((uiNoise >> 8) & 0x3F));
+          }
+        }
+      }
+    }
+  }
+
+  /// Computes the PSNR over the first uiNumChannels channels of two R8G8B8A8 images.
+  double ComputeBlockCompressionPSNR(const ezImage& original, const ezImage& decoded, ezUInt32 uiNumChannels)
+  {
+    double fSquaredError = 0.0;
+
+    for (ezUInt32 y = 0; y < original.GetHeight(); ++y)
+    {
+      const ezUInt8* pA = original.GetPixelPointer<ezUInt8>(0, 0, 0, 0, y);
+      const ezUInt8* pB = decoded.GetPixelPointer<ezUInt8>(0, 0, 0, 0, y);
+
+      for (ezUInt32 x = 0; x < original.GetWidth(); ++x, pA += 4, pB += 4)
+      {
+        for (ezUInt32 c = 0; c < uiNumChannels; ++c)
+        {
+          const double fDiff = (double)pA[c] - (double)pB[c];
+          fSquaredError += fDiff * fDiff;
+        }
+      }
+    }
+
+    const double fMSE = fSquaredError / (original.GetWidth() * original.GetHeight() * uiNumChannels);
+    if (fMSE == 0.0)
+      return 100.0;
+
+    return 10.0 * ezMath::Log10(255.0 * 255.0 / fMSE);
+  }
+
+  double CompressAndMeasure(const ezImage& original, const ezImage& source, ezImageFormat::Enum format, ezUInt32 uiNumChannels)
+  {
+    ezImage compressed;
+    if (ezImageConversion::Convert(source, compressed, format).Failed())
+      return 0.0;
+
+    ezImage decoded;
+    if (ezImageConversion::Convert(compressed, decoded, ezImageFormat::R8G8B8A8_UNORM).Failed())
+      return 0.0;
+
+    return ComputeBlockCompressionPSNR(original, decoded, uiNumChannels);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Image, BlockCompression)
+{
+  ezImage original;
+  CreateBlockCompressionTestImage(original, false);
+
+  // BC1 is only used for opaque textures, any alpha below 1 turns into transparent black
+  ezImage originalOpaque;
+  CreateBlockCompressionTestImage(originalOpaque, true);
+
+  struct FormatToTest
+  {
+    ezImageFormat::Enum m_Format;
+    ezUInt32 m_uiNumChannels;
+    double m_fMinPSNR;
+  };
+
+  // thresholds are a few dB below what the CPU encoders achieve with the balanced preset
+  const FormatToTest formats[] = {
+    {ezImageFormat::BC1_UNORM, 3, 30.0},
+    {ezImageFormat::BC3_UNORM, 4, 31.0},
+    {ezImageFormat::BC4_UNORM, 1, 45.0},
+    {ezImageFormat::BC5_UNORM, 2, 45.0},
+    {ezImageFormat::BC7_UNORM, 4, 34.0},
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "PSNR")
+  {
+    for (const FormatToTest& format : formats)
+    {
+      if (!ezImageConversion::IsConvertible(ezImageFormat::R8G8B8A8_UNORM, format.m_Format))
+        continue;
+
+      const ezImage& img = format.m_uiNumChannels == 3 ? originalOpaque : original;
+
+      const double fPSNR = CompressAndMeasure(img, img, format.m_Format, format.m_uiNumChannels);
+      EZ_TEST_BOOL_MSG(fPSNR >= format.m_fMinPSNR, "%s: PSNR %.2f is below %.2f", ezImageFormat::GetName(format.m_Format), fPSNR, format.m_fMinPSNR);
+
+      ezLog::Info("[test]{}: {} dB", ezImageFormat::GetName(format.m_Format), ezArgF(fPSNR, 2));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "PSNR BC6H")
+  {
+    if (!ezImageConversion::IsConvertible(ezImageFormat::R32G32B32A32_FLOAT, ezImageFormat::BC6H_UF16))
+      return;
+
+    ezImage originalF;
+    EZ_TEST_BOOL(ezImageConversion::Convert(originalOpaque, originalF, ezImageFormat::R32G32B32A32_FLOAT).Succeeded());
+
+    const double fPSNR = CompressAndMeasure(originalOpaque, originalF, ezImageFormat::BC6H_UF16, 3);
+    EZ_TEST_BOOL_MSG(fPSNR >= 34.0, "BC6H_UF16: PSNR %.2f is below 34", fPSNR);
+
+    ezLog::Info("[test]BC6H_UF16: {} dB", ezArgF(fPSNR, 2));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Quality Presets")
+  {
+    ezCVarInt* pQuality = static_cast<ezCVarInt*>(ezCVar::FindCVarByName("Texture.CpuCompressionQuality"));
+    if (pQuality == nullptr)
+      return;
+
+    const ezInt32 iPrevQuality = *pQuality;
+
+    const char* szPresetNames[] = {"fast", "balanced", "best"};
+    double fPrevPSNR = 0.0;
+
+    for (ezInt32 iPreset = 0; iPreset < 3; ++iPreset)
+    {
+      *pQuality = iPreset;
+
+      ezStopwatch sw;
+      const double fPSNR = CompressAndMeasure(original, original, ezImageFormat::BC7_UNORM, 4);
+      const ezTime tDuration = sw.GetRunningTotal();
+
+      EZ_TEST_BOOL(fPSNR >= 30.0);
+
+      // higher presets must never be worse than lower ones
+      EZ_TEST_BOOL(fPSNR >= fPrevPSNR - 0.01);
+      fPrevPSNR = fPSNR;
+
+      ezLog::Info("[test]BC7_UNORM ({}): {} dB in {}", szPresetNames[iPreset], ezArgF(fPSNR, 2), tDuration);
+    }
+
+    *pQuality = iPrevQuality;
+  }
+}
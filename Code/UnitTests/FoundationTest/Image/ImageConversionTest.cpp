@@ -230,3 +230,107 @@ private:
 };
 
 static ezImageConversionTest s_ImageConversionTest;
+
+EZ_CREATE_SIMPLE_TEST(Image, ConversionPaths)
+{
+  // not a multiple of the tile size, so that the last tile is only partially filled
+  ezImageHeader header;
+  header.SetWidth(257);
+  header.SetHeight(131);
+  header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+
+  ezImage source;
+  source.ResetAndAlloc(header);
+
+  {
+    ezUInt32 uiNoise = 4711;
+    for (float& f : source.GetBlobPtr<float>())
+    {
+      uiNoise = uiNoise * 1103515245 + 12345;
+      f = ((uiNoise >> 8) & 0xFFFF) / 65535.0f;
+    }
+  }
+
+  const ezImageFormat::Enum targetFormats[] = {
+    ezImageFormat::R8G8B8A8_UNORM,
+    ezImageFormat::B8G8R8A8_UNORM_SRGB,
+    ezImageFormat::B5G6R5_UNORM,
+    ezImageFormat::R16G16B16A16_FLOAT,
+    ezImageFormat::R8G8_UNORM,
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cached Paths")
+  {
+    for (ezImageFormat::Enum targetFormat : targetFormats)
+    {
+      ezHybridArray<ezImageConversion::ConversionPathNode, 16> path1, path2;
+      ezUInt32 uiNumScratch1 = 0, uiNumScratch2 = 0;
+
+      EZ_TEST_BOOL(ezImageConversion::BuildPath(ezImageFormat::R32G32B32A32_FLOAT, targetFormat, false, path1, uiNumScratch1).Succeeded());
+      const ezImageConversion::PathCacheStats statsBefore = ezImageConversion::GetPathCacheStats();
+
+      EZ_TEST_BOOL(ezImageConversion::BuildPath(ezImageFormat::R32G32B32A32_FLOAT, targetFormat, false, path2, uiNumScratch2).Succeeded());
+      const ezImageConversion::PathCacheStats statsAfter = ezImageConversion::GetPathCacheStats();
+
+      // the second call must have been answered from the cache
+      EZ_TEST_INT(statsAfter.m_uiNumHits, statsBefore.m_uiNumHits + 1);
+      EZ_TEST_INT(statsAfter.m_uiNumMisses, statsBefore.m_uiNumMisses);
+
+      EZ_TEST_INT(uiNumScratch1, uiNumScratch2);
+      if (!EZ_TEST_INT(path1.GetCount(), path2.GetCount()))
+        continue;
+
+      for (ezUInt32 i = 0; i < path1.GetCount(); ++i)
+      {
+        EZ_TEST_BOOL(path1[i].m_step == path2[i].m_step);
+        EZ_TEST_INT(path1[i].m_sourceFormat, path2[i].m_sourceFormat);
+        EZ_TEST_INT(path1[i].m_targetFormat, path2[i].m_targetFormat);
+        EZ_TEST_INT(path1[i].m_sourceBufferIndex, path2[i].m_sourceBufferIndex);
+        EZ_TEST_INT(path1[i].m_targetBufferIndex, path2[i].m_targetBufferIndex);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tiled Conversion")
+  {
+    for (ezImageFormat::Enum targetFormat : targetFormats)
+    {
+      ezHybridArray<ezImageConversion::ConversionPathNode, 16> path;
+      ezUInt32 uiNumScratch = 0;
+      EZ_TEST_BOOL(ezImageConversion::BuildPath(ezImageFormat::R32G32B32A32_FLOAT, targetFormat, false, path, uiNumScratch).Succeeded());
+
+      // reference: every step as a separate pass over the whole image, calling the steps directly so that no tiling is involved
+      const ezUInt32 uiNumElements = header.GetWidth() * header.GetHeight();
+      ezDynamicArray<ezUInt8> expected;
+      expected.SetCountUninitialized(uiNumElements * 16);
+      memcpy(expected.GetData(), source.GetByteBlobPtr().GetPtr(), expected.GetCount());
+
+      for (const auto& node : path)
+      {
+        if (!EZ_TEST_BOOL(node.m_step != nullptr && ezImageFormat::GetType(node.m_sourceFormat) == ezImageFormatType::LINEAR && ezImageFormat::GetType(node.m_targetFormat) == ezImageFormatType::LINEAR))
+          break;
+
+        ezDynamicArray<ezUInt8> stepResult;
+        stepResult.SetCountUninitialized(uiNumElements * ezImageFormat::GetBitsPerPixel(node.m_targetFormat) / 8);
+        EZ_TEST_BOOL(static_cast<const ezImageConversionStepLinear*>(node.m_step)->ConvertPixels(ezConstByteBlobPtr(expected.GetData(), expected.GetCount()), ezByteBlobPtr(stepResult.GetData(), stepResult.GetCount()), uiNumElements, node.m_sourceFormat, node.m_targetFormat).Succeeded());
+        expected.Swap(stepResult);
+      }
+
+      ezImage converted;
+      EZ_TEST_BOOL(ezImageConversion::Convert(source, converted, targetFormat).Succeeded());
+      EZ_TEST_INT(converted.GetImageFormat(), targetFormat);
+
+      ezImage convertedInPlace;
+      convertedInPlace.ResetAndCopy(source);
+      EZ_TEST_BOOL(ezImageConversion::Convert(convertedInPlace, convertedInPlace, targetFormat).Succeeded());
+
+      if (!EZ_TEST_INT(converted.GetByteBlobPtr().GetCount(), expected.GetCount()) || !EZ_TEST_INT(convertedInPlace.GetByteBlobPtr().GetCount(), expected.GetCount()))
+        continue;
+
+      EZ_TEST_BOOL_MSG(memcmp(converted.GetByteBlobPtr().GetPtr(), expected.GetData(), expected.GetCount()) == 0, "Tiled conversion to %s differs from the step by step result", ezImageFormat::GetName(targetFormat));
+      EZ_TEST_BOOL_MSG(memcmp(convertedInPlace.GetByteBlobPtr().GetPtr(), expected.GetData(), expected.GetCount()) == 0, "In-place conversion to %s differs from the step by step result", ezImageFormat::GetName(targetFormat));
+
+      ezLog::Info("[test]R32G32B32A32_FLOAT -> {}: {} step(s)", ezImageFormat::GetName(targetFormat), path.GetCount());
+    }
+  }
+}
@@ -3,8 +3,54 @@
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Texture/Image/ImageFilter.h>
 #include <Texture/Image/ImageUtils.h>
 
+namespace
+{
+  ezColor GetScaleTestColor(ezUInt32 x, ezUInt32 y, ezUInt32 z)
+  {
+    return ezColor(x * 0.1f, y * 0.2f + z * 0.05f, ((x * 7 + y * 3 + z * 5) % 11) / 11.0f, 1.0f - z * 0.1f);
+  }
+
+  struct ScaleReferenceAxis
+  {
+    const ezImageFilterWeights* m_pWeights = nullptr; ///< null, if the axis is not scaled
+
+    ezUInt32 GetNumWeights() const { return m_pWeights ? m_pWeights->GetNumWeights() : 1; }
+    ezInt32 GetFirstSourceSampleIndex(ezUInt32 uiIndex) const { return m_pWeights ? m_pWeights->GetFirstSourceSampleIndex(uiIndex) : uiIndex; }
+    float GetWeight(ezUInt32 uiIndex, ezUInt32 uiWeight) const { return m_pWeights ? (float)m_pWeights->GetWeight(uiIndex, uiWeight) : 1.0f; }
+  };
+
+  /// straightforward (non-separable, per pixel) evaluation of the filter, to compare the optimized implementation against
+  ezColor ComputeScaleReference(const ezImageView& source, const ScaleReferenceAxis* pAxes, ezUInt32 x, ezUInt32 y, ezUInt32 z, ezImageAddressMode::Enum addressMode, const ezColor& borderColor)
+  {
+    ezColor result(0, 0, 0, 0);
+
+    for (ezUInt32 k = 0; k < pAxes[2].GetNumWeights(); ++k)
+    {
+      for (ezUInt32 j = 0; j < pAxes[1].GetNumWeights(); ++j)
+      {
+        for (ezUInt32 i = 0; i < pAxes[0].GetNumWeights(); ++i)
+        {
+          bool bBorderX = false, bBorderY = false, bBorderZ = false;
+          const ezUInt32 sx = ezImageUtils::GetSampleIndex(source.GetWidth(), pAxes[0].GetFirstSourceSampleIndex(x) + i, addressMode, bBorderX);
+          const ezUInt32 sy = ezImageUtils::GetSampleIndex(source.GetHeight(), pAxes[1].GetFirstSourceSampleIndex(y) + j, addressMode, bBorderY);
+          const ezUInt32 sz = ezImageUtils::GetSampleIndex(source.GetDepth(), pAxes[2].GetFirstSourceSampleIndex(z) + k, addressMode, bBorderZ);
+
+          const float fWeight = pAxes[0].GetWeight(x, i) * pAxes[1].GetWeight(y, j) * pAxes[2].GetWeight(z, k);
+          const ezColor sample = (bBorderX || bBorderY || bBorderZ) ? borderColor : *source.GetPixelPointer<ezColor>(0, 0, 0, sx, sy, sz);
+
+          result += sample * fWeight;
+        }
+      }
+    }
+
+    return result;
+  }
+} // namespace
+
 
 EZ_CREATE_SIMPLE_TEST(Image, ImageUtils)
 {
@@ -116,5 +162,116 @@ EZ_CREATE_SIMPLE_TEST(Image, ImageUtils)
     EZ_TEST_INT(uiError, 1433);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scale3D")
+  {
+    ezImageHeader header;
+    header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+    header.SetWidth(9);
+    header.SetHeight(7);
+    header.SetDepth(6);
+
+    ezImage source;
+    source.ResetAndAlloc(header);
+
+    for (ezUInt32 z = 0; z < header.GetDepth(); ++z)
+    {
+      for (ezUInt32 y = 0; y < header.GetHeight(); ++y)
+      {
+        for (ezUInt32 x = 0; x < header.GetWidth(); ++x)
+        {
+          *source.GetPixelPointer<ezColor>(0, 0, 0, x, y, z) = GetScaleTestColor(x, y, z);
+        }
+      }
+    }
+
+    const ezColor borderColor(0.5f, 0.25f, 1.0f, 0.0f);
+    const ezImageFilterSincWithKaiserWindow filter;
+
+    const ezImageAddressMode::Enum addressModes[] = {ezImageAddressMode::Clamp, ezImageAddressMode::Repeat, ezImageAddressMode::Mirror, ezImageAddressMode::ClampBorder};
+    const ezVec3U32 targetSizes[] = {ezVec3U32(4, 3, 2), ezVec3U32(13, 11, 3), ezVec3U32(9, 4, 6), ezVec3U32(9, 7, 10)};
+
+    for (ezImageAddressMode::Enum addressMode : addressModes)
+    {
+      for (const ezVec3U32& size : targetSizes)
+      {
+        ezImage target;
+        EZ_TEST_BOOL(ezImageUtils::Scale3D(source, target, size.x, size.y, size.z, &filter, addressMode, addressMode, addressMode, borderColor).Succeeded());
+
+        EZ_TEST_INT(target.GetWidth(), size.x);
+        EZ_TEST_INT(target.GetHeight(), size.y);
+        EZ_TEST_INT(target.GetDepth(), size.z);
+
+        const ezImageFilterWeights weightsX(filter, header.GetWidth(), size.x);
+        const ezImageFilterWeights weightsY(filter, header.GetHeight(), size.y);
+        const ezImageFilterWeights weightsZ(filter, header.GetDepth(), size.z);
+
+        // dimensions that keep their size are not filtered at all
+        ScaleReferenceAxis axes[3];
+        axes[0].m_pWeights = size.x != header.GetWidth() ? &weightsX : nullptr;
+        axes[1].m_pWeights = size.y != header.GetHeight() ? &weightsY : nullptr;
+        axes[2].m_pWeights = size.z != header.GetDepth() ? &weightsZ : nullptr;
+
+        float fMaxError = 0.0f;
+        for (ezUInt32 z = 0; z < size.z; ++z)
+        {
+          for (ezUInt32 y = 0; y < size.y; ++y)
+          {
+            for (ezUInt32 x = 0; x < size.x; ++x)
+            {
+              const ezColor expected = ComputeScaleReference(source, axes, x, y, z, addressMode, borderColor);
+              const ezColor actual = *target.GetPixelPointer<ezColor>(0, 0, 0, x, y, z);
+
+              fMaxError = ezMath::Max(fMaxError, ezMath::Abs(expected.r - actual.r), ezMath::Abs(expected.g - actual.g));
+              fMaxError = ezMath::Max(fMaxError, ezMath::Abs(expected.b - actual.b), ezMath::Abs(expected.a - actual.a));
+            }
+          }
+        }
+
+        EZ_TEST_FLOAT(fMaxError, 0.0f, 0.0001f);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scale and GenerateMipMaps Performance")
+  {
+    ezImageHeader header;
+    header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+    header.SetWidth(1024);
+    header.SetHeight(1024);
+
+    ezImage source;
+    source.ResetAndAlloc(header);
+
+    for (ezUInt32 y = 0; y < header.GetHeight(); ++y)
+    {
+      ezColor* pPixel = source.GetPixelPointer<ezColor>(0, 0, 0, 0, y);
+      for (ezUInt32 x = 0; x < header.GetWidth(); ++x)
+      {
+        pPixel[x] = GetScaleTestColor(x % 17, y % 13, 0);
+      }
+    }
+
+    const ezImageFilterSincWithKaiserWindow filter;
+
+    ezStopwatch sw;
+
+    ezImage scaled;
+    EZ_TEST_BOOL(ezImageUtils::Scale(source, scaled, 700, 500, &filter).Succeeded());
+
+    const ezTime tScale = sw.Checkpoint();
+
+    ezImageUtils::MipMapOptions options;
+    options.m_filter = &filter;
+
+    ezImage mipmaps;
+    ezImageUtils::GenerateMipMaps(source, mipmaps, options);
+    EZ_TEST_INT(mipmaps.GetNumMipLevels(), 11);
+
+    const ezTime tMipMaps = sw.Checkpoint();
+
+    ezLog::Info("[test]Scaling 1024x1024 to 700x500: {}", tScale);
+    ezLog::Info("[test]Generating mipmaps for 1024x1024: {}", tMipMaps);
+  }
+
   ezFileSystem::RemoveDataDirectoryGroup("ImageTest");
 }
@@ -6,6 +6,7 @@
 #include <Foundation/Logging/HTMLWriter.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Logging/VisualStudioWriter.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Threading/Thread.h>
 #include <TestFramework/Utilities/TestLogInterface.h>
 
@@ -254,3 +255,222 @@ EZ_CREATE_SIMPLE_TEST(Logging, GlobalTestLog)
     }
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(Logging, AsyncLog)
+{
+  struct AsyncLogTestWriter
+  {
+    void HandleLogMessage(const ezLoggingEventData& le)
+    {
+      while (m_bBlock)
+      {
+        ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+      }
+
+      if (le.m_EventType == ezLogMsgType::Flush)
+      {
+        m_iFlushes.Increment();
+        return;
+      }
+
+      // only look at the messages of this test, the test framework logs as well
+      if (le.m_sTag != "AsyncLogTest" && !le.m_sText.StartsWith("Last message") && !le.m_sText.EndsWith("log queue was full."))
+        return;
+
+      EZ_LOCK(m_Mutex);
+      m_Messages.PushBack(le.m_sText);
+      m_bOnLoggingThread |= ezThreadUtils::GetCurrentThreadID() == m_LoggingThread;
+    }
+
+    ezMutex m_Mutex;
+    ezDynamicArray<ezString> m_Messages;
+    ezThreadID m_LoggingThread = ezThreadUtils::GetCurrentThreadID();
+    bool m_bOnLoggingThread = false;
+    ezAtomicBool m_bBlock;
+    ezAtomicInteger32 m_iFlushes;
+  };
+
+  ezLog::GetThreadLocalLogSystem()->SetLogLevel(ezLogMsgType::All);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Messages from multiple threads")
+  {
+    AsyncLogTestWriter writer;
+    ezEventSubscriptionID subscription = ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogTestWriter::HandleLogMessage, &writer));
+
+    ezGlobalLog::AsyncLogConfig config;
+    config.m_uiQueueCapacity = 16;
+    ezGlobalLog::EnableAsyncLogging(config);
+    EZ_TEST_BOOL(ezGlobalLog::IsAsyncLoggingEnabled());
+
+    ezParallelForParams params;
+    params.m_uiBinSize = 1;
+    params.m_uiMaxTasksPerThread = 16;
+
+    ezTaskSystem::ParallelForIndexed(
+      0u, 8u,
+      [](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          for (ezUInt32 j = 0; j < 16; ++j)
+          {
+            ezLog::Info("[AsyncLogTest]Message {0}.{1}", i, j);
+          }
+        }
+      },
+      "AsyncLogTest", ezTaskNesting::Never, params);
+
+    // with the blocking policy nothing is lost, even though the queue is much smaller than the number of messages
+    ezGlobalLog::WaitForAsyncLog();
+    {
+      EZ_LOCK(writer.m_Mutex);
+      EZ_TEST_INT(writer.m_Messages.GetCount(), 8 * 16);
+    }
+
+    ezGlobalLog::RemoveLogWriter(subscription);
+    ezGlobalLog::DisableAsyncLogging();
+    EZ_TEST_BOOL(!ezGlobalLog::IsAsyncLoggingEnabled());
+
+    EZ_TEST_INT(ezGlobalLog::GetNumDroppedAsyncMessages(), 0);
+    EZ_TEST_BOOL(!writer.m_bOnLoggingThread);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Duplicate messages")
+  {
+    AsyncLogTestWriter writer;
+    ezEventSubscriptionID subscription = ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogTestWriter::HandleLogMessage, &writer));
+
+    ezGlobalLog::EnableAsyncLogging(ezGlobalLog::AsyncLogConfig());
+
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      ezLog::Info("[AsyncLogTest]Same");
+    }
+    ezLog::Info("[AsyncLogTest]Different");
+
+    ezGlobalLog::DisableAsyncLogging();
+    ezGlobalLog::RemoveLogWriter(subscription);
+
+    EZ_TEST_INT(writer.m_Messages.GetCount(), 3);
+    if (writer.m_Messages.GetCount() == 3)
+    {
+      EZ_TEST_STRING(writer.m_Messages[0], "Same");
+      EZ_TEST_STRING(writer.m_Messages[1], "Last message repeated 4 times.");
+      EZ_TEST_STRING(writer.m_Messages[2], "Different");
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Duplicate messages spaced apart")
+  {
+    AsyncLogTestWriter writer;
+    ezEventSubscriptionID subscription = ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogTestWriter::HandleLogMessage, &writer));
+
+    ezGlobalLog::AsyncLogConfig config;
+    config.m_DuplicateMessageWindow = ezTime::MakeFromMilliseconds(500);
+    ezGlobalLog::EnableAsyncLogging(config);
+
+    // the writer thread drains the queue in between, that must not report the duplicates right away
+    for (ezUInt32 i = 0; i < 5; ++i)
+    {
+      ezLog::Info("[AsyncLogTest]Same");
+      ezGlobalLog::WaitForAsyncLog();
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+    }
+
+    {
+      EZ_LOCK(writer.m_Mutex);
+      EZ_TEST_INT(writer.m_Messages.GetCount(), 1);
+    }
+
+    // once the window has expired, the count is reported without another message arriving
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(20));
+
+      EZ_LOCK(writer.m_Mutex);
+      if (writer.m_Messages.GetCount() > 1)
+        break;
+    }
+
+    // a later occurrence is passed on again
+    ezLog::Info("[AsyncLogTest]Same");
+
+    ezGlobalLog::DisableAsyncLogging();
+    ezGlobalLog::RemoveLogWriter(subscription);
+
+    EZ_TEST_INT(writer.m_Messages.GetCount(), 3);
+    if (writer.m_Messages.GetCount() == 3)
+    {
+      EZ_TEST_STRING(writer.m_Messages[0], "Same");
+      EZ_TEST_STRING(writer.m_Messages[1], "Last message repeated 4 times.");
+      EZ_TEST_STRING(writer.m_Messages[2], "Same");
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Overflow policy")
+  {
+    AsyncLogTestWriter writer;
+    ezEventSubscriptionID subscription = ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogTestWriter::HandleLogMessage, &writer));
+
+    ezGlobalLog::AsyncLogConfig config;
+    config.m_uiQueueCapacity = 4;
+    config.m_OverflowPolicy = ezGlobalLog::AsyncOverflowPolicy::DropBelowSeverity;
+    config.m_DropBelowSeverity = ezLogMsgType::SuccessMsg;
+    config.m_DuplicateMessageWindow = ezTime::MakeZero();
+    ezGlobalLog::EnableAsyncLogging(config);
+
+    // stall the writer thread, so that the queue fills up
+    writer.m_bBlock = true;
+    for (ezUInt32 i = 0; i < 32; ++i)
+    {
+      ezLog::Info("[AsyncLogTest]Info {0}", i);
+    }
+
+    EZ_TEST_BOOL(ezGlobalLog::GetNumDroppedAsyncMessages() > 0);
+    writer.m_bBlock = false;
+
+    // success messages are not dropped with this policy
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      ezLog::Success("[AsyncLogTest]Success {0}", i);
+    }
+
+    const ezUInt32 uiNumDropped = ezGlobalLog::GetNumDroppedAsyncMessages();
+    ezGlobalLog::DisableAsyncLogging();
+    ezGlobalLog::RemoveLogWriter(subscription);
+
+    ezUInt32 uiNumSuccess = 0;
+    bool bReportedDrops = false;
+    for (const ezString& sMessage : writer.m_Messages)
+    {
+      uiNumSuccess += sMessage.StartsWith("Success") ? 1 : 0;
+      bReportedDrops |= sMessage.EndsWith("log queue was full.");
+    }
+
+    EZ_TEST_INT(uiNumSuccess, 8);
+    EZ_TEST_BOOL(bReportedDrops);
+    EZ_TEST_INT(writer.m_Messages.GetCount(), 32 - uiNumDropped + 8 + 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FlushAsyncLogAfterCrash")
+  {
+    AsyncLogTestWriter writer;
+    ezEventSubscriptionID subscription = ezGlobalLog::AddLogWriter(ezMakeDelegate(&AsyncLogTestWriter::HandleLogMessage, &writer));
+
+    ezGlobalLog::EnableAsyncLogging(ezGlobalLog::AsyncLogConfig());
+
+    ezLog::Info("[AsyncLogTest]Before the crash");
+    ezGlobalLog::FlushAsyncLogAfterCrash();
+
+    EZ_TEST_INT(writer.m_Messages.GetCount(), 1);
+    EZ_TEST_BOOL(writer.m_iFlushes > 0);
+
+    // the writer thread continues afterwards
+    ezLog::Info("[AsyncLogTest]After the crash");
+    ezGlobalLog::WaitForAsyncLog();
+    EZ_TEST_INT(writer.m_Messages.GetCount(), 2);
+
+    ezGlobalLog::DisableAsyncLogging();
+    ezGlobalLog::RemoveLogWriter(subscription);
+  }
+}
@@ -0,0 +1,87 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Memory/CommonAllocators.h>
+#include <FoundationTest/Threading/ContentionTestHelpers.h>
+
+namespace
+{
+  static constexpr ezUInt32 s_uiNumThreads = 16;
+  static constexpr ezUInt32 s_uiRounds = 500;
+  static constexpr ezUInt32 s_uiAllocationsPerRound = 64;
+
+  ezTime RunContentionBenchmark(ezAllocator* pAllocator)
+  {
+    return ezContentionTest::RunOnThreads(s_uiNumThreads, [pAllocator](ezUInt32 uiThreadIndex)
+      {
+        void* allocations[s_uiAllocationsPerRound];
+
+        ezRandom rng;
+        rng.Initialize(uiThreadIndex + 1);
+
+        for (ezUInt32 round = 0; round < s_uiRounds; ++round)
+        {
+          for (ezUInt32 i = 0; i < s_uiAllocationsPerRound; ++i)
+          {
+            // mostly small objects, like strings, array storage and event handlers
+            const size_t uiSize = 8 + rng.UIntInRange(504);
+
+            allocations[i] = pAllocator->Allocate(uiSize, EZ_ALIGNMENT_MINIMUM);
+            *static_cast<ezUInt8*>(allocations[i]) = (ezUInt8)i;
+          }
+
+          // free in a different order than allocated
+          for (ezUInt32 i = 0; i < s_uiAllocationsPerRound; ++i)
+          {
+            pAllocator->Deallocate(allocations[(i * 7) % s_uiAllocationsPerRound]);
+          }
+        }
+      });
+  }
+
+  template <typename HeapAllocator, typename ThreadCacheAllocator>
+  void CompareAllocators(ezStringView sTrackingMode)
+  {
+    ezTime tHeap;
+    ezTime tThreadCache;
+
+    {
+      HeapAllocator allocator("ContentionHeap");
+      tHeap = RunContentionBenchmark(&allocator);
+
+      const ezAllocator::Stats stats = allocator.GetStats();
+      EZ_TEST_INT(stats.m_uiNumAllocations - stats.m_uiNumDeallocations, 0);
+    }
+
+    {
+      ThreadCacheAllocator allocator("ContentionThreadCache");
+      tThreadCache = RunContentionBenchmark(&allocator);
+
+      // all threads have exited, so their counters have been published
+      const ezAllocator::Stats stats = allocator.GetStats();
+      EZ_TEST_INT(stats.m_uiNumAllocations, s_uiNumThreads * s_uiRounds * s_uiAllocationsPerRound);
+      EZ_TEST_INT(stats.m_uiNumAllocations - stats.m_uiNumDeallocations, 0);
+      EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+    }
+
+    const ezUInt32 uiNumAllocations = s_uiNumThreads * s_uiRounds * s_uiAllocationsPerRound;
+
+    ezLog::Info("[test]Tracking {}, {} threads, {} allocations", sTrackingMode, s_uiNumThreads, uiNumAllocations);
+    ezContentionTest::LogResult("Heap", tHeap, uiNumAllocations, "allocation");
+    ezContentionTest::LogResult("ThreadCache", tThreadCache, uiNumAllocations, "allocation");
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Memory, AllocatorContention)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Heap vs. ThreadCache (default tracking)")
+  {
+    CompareAllocators<ezHeapAllocator, ezThreadCacheHeapAllocator>("Default");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Heap vs. ThreadCache (basic tracking)")
+  {
+    CompareAllocators<ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::Basics>,
+      ezAllocatorWithPolicy<ezAllocPolicyThreadCache, ezAllocatorTrackingMode::Basics>>("Basics");
+  }
+}
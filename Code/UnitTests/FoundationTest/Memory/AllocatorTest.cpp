@@ -3,6 +3,7 @@
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
 #include <Foundation/Memory/LinearAllocator.h>
+#include <Foundation/Threading/Thread.h>
 
 struct alignas(EZ_ALIGNMENT_MINIMUM) NonAlignedVector
 {
@@ -37,6 +38,31 @@ struct alignas(16) AlignedVector
   float w;
 };
 
+class DeallocateThread : public ezThread
+{
+public:
+  DeallocateThread(ezAllocator* pAllocator, ezArrayPtr<void*> allocations)
+    : ezThread("DeallocateThread")
+    , m_pAllocator(pAllocator)
+    , m_Allocations(allocations)
+  {
+  }
+
+private:
+  virtual ezUInt32 Run() override
+  {
+    for (void* pPtr : m_Allocations)
+    {
+      m_pAllocator->Deallocate(pPtr);
+    }
+
+    return 0;
+  }
+
+  ezAllocator* m_pAllocator;
+  ezArrayPtr<void*> m_Allocations;
+};
+
 template <typename T>
 void TestAlignmentHelper(size_t uiExpectedAlignment)
 {
@@ -167,6 +193,68 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
     EZ_TEST_BOOL(stats.m_uiAllocationSize == 0);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ThreadCacheAllocator")
+  {
+    ezThreadCacheHeapAllocator allocator("TestThreadCache");
+
+    ezDynamicArray<void*> allocations;
+    ezDynamicArray<size_t> sizes;
+
+    // covers every size class, including the largest one and the forwarding to malloc
+    for (size_t uiSize = 1; uiSize <= ezAllocPolicyThreadCache::MaxSmallSize + 1024; uiSize += 7)
+    {
+      void* pPtr = allocator.Allocate(uiSize, 16);
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(pPtr, 16));
+      EZ_TEST_INT(allocator.AllocatedSize(pPtr), uiSize);
+
+      ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(pPtr), (ezUInt8)uiSize, (ezUInt32)uiSize);
+
+      allocations.PushBack(pPtr);
+      sizes.PushBack(uiSize);
+    }
+
+    bool bMemoryIntact = true;
+    for (ezUInt32 i = 0; i < allocations.GetCount(); ++i)
+    {
+      const ezUInt8* pData = static_cast<const ezUInt8*>(allocations[i]);
+      for (size_t j = 0; j < sizes[i]; ++j)
+      {
+        bMemoryIntact &= (pData[j] == (ezUInt8)sizes[i]);
+      }
+    }
+    EZ_TEST_BOOL(bMemoryIntact);
+
+    ezAllocPolicyThreadCache::FlushThreadCache();
+
+    ezAllocator::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, allocations.GetCount());
+    EZ_TEST_INT(stats.m_uiNumDeallocations, 0);
+
+    size_t uiTotalSize = 0;
+    for (size_t uiSize : sizes)
+    {
+      uiTotalSize += uiSize;
+    }
+    EZ_TEST_INT(stats.m_uiAllocationSize, uiTotalSize);
+
+    // freed blocks are reused by the next allocation of the same size class
+    void* pFreed = allocations[0];
+    allocator.Deallocate(pFreed);
+    allocations[0] = allocator.Allocate(sizes[0], EZ_ALIGNMENT_MINIMUM);
+    EZ_TEST_BOOL(allocations[0] == pFreed);
+
+    // memory may be freed on another thread than it was allocated on, the exiting thread publishes its counters
+    DeallocateThread thread(&allocator, allocations);
+    thread.Start();
+    thread.Join();
+
+    ezAllocPolicyThreadCache::FlushThreadCache();
+
+    stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations - stats.m_uiNumDeallocations, 0);
+    EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "StackAllocator")
   {
     ezLinearAllocator<> allocator("TestStackAllocator", ezFoundation::GetAlignedAllocator());
@@ -1,9 +1,13 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Profiling/ProfilingUtils.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Stopwatch.h>
 
 namespace
 {
@@ -21,6 +25,41 @@ namespace
       ezLog::Info("Profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
     }
   }
+
+  class ezStreamingProfilingThread : public ezThread
+  {
+  public:
+    ezStreamingProfilingThread()
+      : ezThread("StreamingProfiling")
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        EZ_PROFILE_SCOPE("Thread scope");
+      }
+
+      return 0;
+    }
+  };
+
+  ezUInt32 CountScopes(const ezProfilingSystem::ProfilingData& data, ezStringView sName)
+  {
+    ezUInt32 uiCount = 0;
+    for (const auto& eventBuffer : data.m_AllEventBuffers)
+    {
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        if (sName == static_cast<const char*>(scope.m_szName))
+          ++uiCount;
+      }
+    }
+
+    return uiCount;
+  }
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Profiling);
@@ -52,4 +91,97 @@ EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
 
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Streaming capture")
+  {
+    // the output data directory has been added by the previous block
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeZero());
+
+    EZ_TEST_RESULT(ezProfilingSystem::StartStreamingCapture(":output/profilingStream.ezProfilingCapture"));
+    EZ_TEST_BOOL(ezProfilingSystem::IsStreamingCaptureActive());
+
+    ezStringBuilder sDynamicName;
+    for (ezUInt32 uiFrame = 0; uiFrame < 10; ++uiFrame)
+    {
+      ezProfilingSystem::StartNewFrame();
+
+      EZ_PROFILE_SCOPE("Frame scope");
+
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        // names that are built on the stack must be interned by their content
+        sDynamicName.SetFormat("Dynamic {}", i % 3);
+        EZ_PROFILE_SCOPE(sDynamicName);
+      }
+    }
+
+    ezStreamingProfilingThread thread;
+    thread.Start();
+    thread.Join();
+
+    // measure the overhead of a scope while streaming, the in-memory ring buffers are filled in both cases
+    constexpr ezUInt32 uiNumOverheadScopes = 100000;
+    auto MeasureScopes = [&]()
+    {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumOverheadScopes; ++i)
+      {
+        EZ_PROFILE_SCOPE("Overhead scope");
+      }
+      return sw.GetRunningTotal();
+    };
+
+    const ezTime tWithStreaming = MeasureScopes();
+
+    const ezUInt64 uiMemoryWhileStreaming = ezFoundation::GetDefaultAllocator()->GetStats().m_uiAllocationSize;
+
+    ezProfilingSystem::StopStreamingCapture();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsStreamingCaptureActive());
+
+    // the stream buffers are freed when the capture stops, the one of the main thread alone has 4 MB
+    if (uiMemoryWhileStreaming > 0)
+    {
+      EZ_TEST_BOOL(ezFoundation::GetDefaultAllocator()->GetStats().m_uiAllocationSize + 4 * 1024 * 1024 <= uiMemoryWhileStreaming);
+    }
+
+    const ezTime tWithoutStreaming = MeasureScopes();
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeFromMilliseconds(0.1));
+
+    ezLog::Info("[test]Profiling scope without streaming capture: {} ns", ezArgF(tWithoutStreaming.GetNanoseconds() / uiNumOverheadScopes, 1));
+    ezLog::Info("[test]Profiling scope with streaming capture: {} ns", ezArgF(tWithStreaming.GetNanoseconds() / uiNumOverheadScopes, 1));
+
+    ezProfilingSystem::ProfilingData data;
+    {
+      ezFileReader reader;
+      EZ_TEST_RESULT(reader.Open(":output/profilingStream.ezProfilingCapture"));
+      EZ_TEST_RESULT(data.ReadStreamingCapture(reader));
+    }
+
+    EZ_TEST_INT(data.m_uiFrameCount, 10);
+    EZ_TEST_INT(data.m_FrameStartTimes.GetCount(), 10);
+    EZ_TEST_INT(CountScopes(data, "Frame scope"), 10);
+    EZ_TEST_INT(CountScopes(data, "Dynamic 0") + CountScopes(data, "Dynamic 1") + CountScopes(data, "Dynamic 2"), 10000);
+    EZ_TEST_INT(CountScopes(data, "Thread scope"), 100);
+    EZ_TEST_INT(CountScopes(data, "Overhead scope"), uiNumOverheadScopes);
+
+    bool bFoundThreadName = false;
+    for (const auto& info : data.m_ThreadInfos)
+    {
+      bFoundThreadName |= info.m_sName == "StreamingProfiling";
+    }
+    EZ_TEST_BOOL(bFoundThreadName);
+
+    for (const auto& eventBuffer : data.m_AllEventBuffers)
+    {
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        EZ_TEST_BOOL(scope.m_BeginTime <= scope.m_EndTime);
+        EZ_TEST_BOOL(scope.m_szFunctionName != nullptr);
+      }
+    }
+
+    EZ_TEST_RESULT(ezProfilingUtils::ConvertStreamingCaptureToJson(":output/profilingStream.ezProfilingCapture", ":output/profilingStream.json"));
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":output/profilingStream.json"));
+  }
 }
@@ -0,0 +1,104 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <FoundationTest/Threading/ContentionTestHelpers.h>
+
+namespace
+{
+  static constexpr ezUInt32 s_uiNumThreads = 16;
+  static constexpr ezUInt32 s_uiNumStrings = 1000;
+  static constexpr ezUInt32 s_uiLookupsPerThread = 50000;
+
+  /// Interns strings the way ezHashedString did before the storage was sharded: one map, one mutex for every lookup.
+  struct ezLockedStringTable
+  {
+    const ezString& Intern(ezStringView sString)
+    {
+      const ezUInt64 uiHash = ezHashingUtils::StringHash(sString);
+
+      EZ_LOCK(m_Mutex);
+
+      bool bExisted = false;
+      auto it = m_Storage.FindOrAdd(uiHash, &bExisted);
+      if (!bExisted)
+      {
+        it.Value() = sString;
+      }
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      else if (it.Value() != sString)
+      {
+        ezLog::Error("Hash collision encountered");
+      }
+#endif
+
+      return it.Value();
+    }
+
+    ezMutex m_Mutex;
+    ezMap<ezUInt64, ezString> m_Storage;
+  };
+
+  template <typename Func>
+  ezTime RunContentionBenchmark(const ezDynamicArray<ezString>& strings, Func func)
+  {
+    return ezContentionTest::RunOnThreads(s_uiNumThreads, [&](ezUInt32 uiThreadIndex)
+      {
+        ezRandom rng;
+        rng.Initialize(uiThreadIndex + 1);
+
+        for (ezUInt32 i = 0; i < s_uiLookupsPerThread; ++i)
+        {
+          func(strings[rng.UIntInRange(s_uiNumStrings)]);
+        }
+      });
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Strings, HashedStringContention)
+{
+  ezDynamicArray<ezString> strings;
+  strings.Reserve(s_uiNumStrings);
+
+  for (ezUInt32 i = 0; i < s_uiNumStrings; ++i)
+  {
+    ezStringBuilder sName;
+    sName.SetFormat("Resources/Textures/HashedStringContention_{}.ezTexture2D", i);
+    strings.PushBack(sName);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Locked vs. Sharded")
+  {
+    ezLockedStringTable lockedTable;
+
+    // add all strings up front, so that only lookups of existing strings are measured
+    for (const ezString& sString : strings)
+    {
+      lockedTable.Intern(sString);
+      ezHashedString sHashed;
+      sHashed.Assign(sString);
+    }
+
+    const ezTime tLocked = RunContentionBenchmark(strings, [&](const ezString& sString)
+      { lockedTable.Intern(sString); });
+
+    const ezTime tSharded = RunContentionBenchmark(strings, [](const ezString& sString)
+      {
+        ezHashedString sHashed;
+        sHashed.Assign(sString);
+        EZ_ASSERT_DEBUG(sHashed.GetView() == sString, "Wrong string returned");
+      });
+
+    const ezHashedString::StorageStats stats = ezHashedString::GetStorageStats();
+    const ezUInt32 uiNumLookups = s_uiNumThreads * s_uiLookupsPerThread;
+
+    ezLog::Info("[test]{} threads, {} lookups of {} strings", s_uiNumThreads, uiNumLookups, s_uiNumStrings);
+    ezContentionTest::LogResult("Locked", tLocked, uiNumLookups, "lookup");
+    ezContentionTest::LogResult("Sharded", tSharded, uiNumLookups, "lookup");
+    ezLog::Info("[test]Storage: {} strings, {} string bytes, {} table bytes", stats.m_uiNumStrings, stats.m_uiStringBytes, stats.m_uiTableBytes);
+
+    EZ_TEST_BOOL(stats.m_uiNumStrings >= s_uiNumStrings);
+  }
+}
@@ -1,6 +1,7 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -185,6 +186,64 @@ EZ_CREATE_SIMPLE_TEST(Strings, HashedString)
     EZ_TEST_STRING(s3.GetString().GetData(), "tut");
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetStorageStats")
+  {
+    const ezHashedString::StorageStats before = ezHashedString::GetStorageStats();
+    EZ_TEST_BOOL(before.m_uiNumStrings > 0); // at least the empty string
+    EZ_TEST_BOOL(before.m_uiTableBytes > 0);
+
+    ezHashedString s1, s2;
+    s1.Assign("GetStorageStats_Unique_1");
+    s2.Assign("GetStorageStats_Unique_1");
+
+    const ezHashedString::StorageStats after = ezHashedString::GetStorageStats();
+    EZ_TEST_INT(after.m_uiNumStrings, before.m_uiNumStrings + 1);
+    EZ_TEST_INT(after.m_uiStringBytes, before.m_uiStringBytes + 24);
+    EZ_TEST_BOOL(after.m_uiTableBytes > before.m_uiTableBytes);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multithreaded")
+  {
+    constexpr ezUInt32 uiNumStrings = 2000;
+
+    constexpr ezUInt32 uiNumCopies = 4;
+
+    ezDynamicArray<ezHashedString> results[uiNumCopies];
+    for (auto& result : results)
+    {
+      result.SetCount(uiNumStrings);
+    }
+
+    // all threads add the same strings at the same time, which also makes the storage grow concurrently to lookups
+    ezTaskSystem::ParallelForIndexed(0u, uiNumCopies * uiNumStrings,
+      [&](ezUInt32 uiStart, ezUInt32 uiEnd)
+      {
+        ezStringBuilder sTemp;
+        for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+        {
+          sTemp.SetFormat("Multithreaded_{}", i % uiNumStrings);
+          results[i / uiNumStrings][i % uiNumStrings].Assign(sTemp);
+        }
+      });
+
+    bool bAllIdentical = true;
+    for (ezUInt32 i = 0; i < uiNumStrings; ++i)
+    {
+      ezStringBuilder sExpected;
+      sExpected.SetFormat("Multithreaded_{}", i);
+
+      bAllIdentical &= (results[0][i].GetView() == sExpected);
+
+      for (ezUInt32 r = 1; r < uiNumCopies; ++r)
+      {
+        bAllIdentical &= (results[0][i] == results[r][i]);
+        bAllIdentical &= (results[0][i].GetData() == results[r][i].GetData());
+      }
+    }
+
+    EZ_TEST_BOOL(bAllIdentical);
+  }
+
 #if EZ_ENABLED(EZ_HASHED_STRING_REF_COUNTING)
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "ClearUnusedStrings")
   {
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace ezContentionTest
+{
+  template <typename Func>
+  class ezContentionThread : public ezThread
+  {
+  public:
+    ezContentionThread(const Func& func, ezUInt32 uiThreadIndex)
+      : ezThread("ContentionTest")
+      , m_Func(func)
+      , m_uiThreadIndex(uiThreadIndex)
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      m_Func(m_uiThreadIndex);
+      return 0;
+    }
+
+    const Func& m_Func;
+    ezUInt32 m_uiThreadIndex = 0;
+  };
+
+  /// \brief Runs func(uiThreadIndex) on uiNumThreads threads at the same time and returns how long it took until all of them were done.
+  template <typename Func>
+  ezTime RunOnThreads(ezUInt32 uiNumThreads, const Func& func)
+  {
+    ezDynamicArray<ezUniquePtr<ezContentionThread<Func>>> threads;
+
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      threads.PushBack(EZ_DEFAULT_NEW(ezContentionThread<Func>, func, i));
+    }
+
+    ezStopwatch sw;
+
+    for (auto& pThread : threads)
+    {
+      pThread->Start();
+    }
+
+    for (auto& pThread : threads)
+    {
+      pThread->Join();
+    }
+
+    return sw.GetRunningTotal();
+  }
+
+  /// \brief Logs the total time of one variant and the time per operation.
+  inline void LogResult(ezStringView sVariant, ezTime tDuration, ezUInt32 uiNumOperations, ezStringView sOperation)
+  {
+    ezLog::Info("[test]{}: {} ms ({} ns per {})", sVariant, ezArgF(tDuration.GetMilliseconds(), 2), ezArgF(tDuration.GetNanoseconds() / uiNumOperations, 1), sOperation);
+  }
+} // namespace ezContentionTest
@@ -0,0 +1,86 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <FoundationTest/Threading/ContentionTestHelpers.h>
+
+namespace
+{
+  static constexpr ezUInt32 s_uiNumProducers = 64;
+  static constexpr ezUInt32 s_uiTasksPerProducer = 256;
+
+  class ezTinyTask final : public ezTask
+  {
+  public:
+    ezTinyTask() { ConfigureTask("ezTinyTask", ezTaskNesting::Never); }
+
+    ezAtomicInteger32* m_pCounter = nullptr;
+
+  private:
+    virtual void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override { m_pCounter->Increment(); }
+  };
+
+  /// Every producer runs on a worker thread and schedules its own batch of tiny tasks, which is the typical pattern of nested ParallelFor calls.
+  /// With the mutex path all workers fight over the same lock, with work stealing they mostly operate on their own deques.
+  ezTime RunContentionBenchmark(ezTaskSchedulerMode::Enum mode, ezUInt32 uiRounds)
+  {
+    ezTaskSystem::SetSchedulerMode(mode);
+
+    ezAtomicInteger32 iExecuted = 0;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 round = 0; round < uiRounds; ++round)
+    {
+      ezTaskSystem::ParallelForIndexed(
+        0u, s_uiNumProducers,
+        [&](ezUInt32 uiStart, ezUInt32 uiEnd)
+        {
+          for (ezUInt32 p = uiStart; p < uiEnd; ++p)
+          {
+            ezSharedPtr<ezTinyTask> pTask = EZ_DEFAULT_NEW(ezTinyTask);
+            pTask->m_pCounter = &iExecuted;
+            pTask->SetMultiplicity(s_uiTasksPerProducer);
+
+            ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::EarlyThisFrame));
+          }
+        },
+        "ContentionProducer", ezTaskNesting::Maybe);
+    }
+
+    const ezTime tDuration = sw.GetRunningTotal();
+
+    EZ_TEST_INT(iExecuted, uiRounds * s_uiNumProducers * s_uiTasksPerProducer);
+
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::Default);
+    return tDuration;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Threading, TaskSystemContention)
+{
+  const ezUInt32 uiRounds = 10;
+
+  // use as many workers as the machine offers, contention is what we want to measure
+  const ezUInt32 uiPrevShortTaskWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks);
+  const ezUInt32 uiPrevLongTaskWorkers = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks);
+  ezTaskSystem::SetWorkerThreadCount(-1, -1);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Locked vs. WorkStealing")
+  {
+    // warm up, so that worker threads and task groups are allocated
+    RunContentionBenchmark(ezTaskSchedulerMode::Locked, 1);
+    RunContentionBenchmark(ezTaskSchedulerMode::WorkStealing, 1);
+
+    const ezTime tLocked = RunContentionBenchmark(ezTaskSchedulerMode::Locked, uiRounds);
+    const ezTime tStealing = RunContentionBenchmark(ezTaskSchedulerMode::WorkStealing, uiRounds);
+
+    const ezUInt32 uiNumTasks = uiRounds * s_uiNumProducers * s_uiTasksPerProducer;
+
+    ezLog::Info("[test]{} worker threads, {} tasks", ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks), uiNumTasks);
+    ezContentionTest::LogResult("Locked", tLocked, uiNumTasks, "task");
+    ezContentionTest::LogResult("WorkStealing", tStealing, uiNumTasks, "task");
+  }
+
+  ezTaskSystem::SetWorkerThreadCount(uiPrevShortTaskWorkers, uiPrevLongTaskWorkers);
+}
@@ -550,6 +550,123 @@ EZ_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     EZ_TEST_BOOL(t[2]->IsMultiplicityDone());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Work Stealing Scheduler")
+  {
+    EZ_TEST_INT(ezTaskSystem::GetSchedulerMode(), ezTaskSchedulerMode::Locked);
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::WorkStealing);
+    EZ_TEST_INT(ezTaskSystem::GetSchedulerMode(), ezTaskSchedulerMode::WorkStealing);
+
+    // multiplicity and dependencies
+    {
+      ezSharedPtr<ezTestTask> t[3];
+      ezTaskGroupID tg[3];
+
+      for (ezUInt32 i = 0; i < 3; ++i)
+      {
+        t[i] = EZ_DEFAULT_NEW(ezTestTask);
+        t[i]->ConfigureTask("WorkStealing", ezTaskNesting::Never);
+      }
+
+      t[0]->SetMultiplicity(1);
+      t[1]->SetMultiplicity(100);
+      t[2]->SetMultiplicity(2000); // more than fits into a single injection queue
+
+      tg[0] = ezTaskSystem::StartSingleTask(t[0], ezTaskPriority::LateThisFrame);
+      tg[1] = ezTaskSystem::StartSingleTask(t[1], ezTaskPriority::ThisFrame, tg[0]);
+      tg[2] = ezTaskSystem::StartSingleTask(t[2], ezTaskPriority::EarlyThisFrame);
+
+      ezTaskSystem::WaitForGroup(tg[1]);
+      ezTaskSystem::WaitForGroup(tg[2]);
+
+      EZ_TEST_BOOL(t[0]->IsMultiplicityDone());
+      EZ_TEST_BOOL(t[1]->IsMultiplicityDone());
+      EZ_TEST_BOOL(t[2]->IsMultiplicityDone());
+    }
+
+    // tasks that schedule more tasks from worker threads end up in the local deques and get stolen by other workers
+    {
+      ezAtomicInteger32 iExecuted = 0;
+
+      ezTaskSystem::ParallelForIndexed(0u, 64u, [&](ezUInt32 uiStart, ezUInt32 uiEnd)
+        {
+          for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+          {
+            ezTaskSystem::ParallelForIndexed(0u, 100u, [&](ezUInt32 uiStart2, ezUInt32 uiEnd2)
+              { iExecuted.Add(uiEnd2 - uiStart2); });
+          }
+        },
+        "WorkStealingOuter", ezTaskNesting::Maybe);
+
+      EZ_TEST_INT(iExecuted, 64 * 100);
+    }
+
+    // next frame tasks are only guaranteed to finish after the next FinishFrameTasks()
+    {
+      ezSharedPtr<ezTestTask> t = EZ_DEFAULT_NEW(ezTestTask);
+      t->m_uiIterations = 1;
+
+      ezTaskGroupID tg = ezTaskSystem::StartSingleTask(t, ezTaskPriority::NextFrame);
+
+      ezTaskSystem::FinishFrameTasks();
+      ezTaskSystem::FinishFrameTasks();
+      ezTaskSystem::WaitForGroup(tg);
+
+      EZ_TEST_BOOL(t->IsDone());
+    }
+
+    // canceling queued tasks
+    {
+      const ezUInt32 uiNumTasks = 20;
+      ezSharedPtr<ezTestTask> t[uiNumTasks];
+      ezTaskGroupID tg[uiNumTasks];
+
+      for (ezUInt32 i = 0; i < uiNumTasks; ++i)
+      {
+        t[i] = EZ_DEFAULT_NEW(ezTestTask);
+        t[i]->m_uiIterations = 50;
+
+        tg[i] = ezTaskSystem::StartSingleTask(t[i], ezTaskPriority::ThisFrame);
+      }
+
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+
+      ezUInt32 uiCanceled = 0;
+
+      for (ezUInt32 i0 = uiNumTasks; i0 > 0; --i0)
+      {
+        if (ezTaskSystem::CancelTask(t[i0 - 1], ezOnTaskRunning::ReturnWithoutBlocking) == EZ_SUCCESS)
+          ++uiCanceled;
+      }
+
+      ezUInt32 uiDone = 0;
+
+      for (ezUInt32 i = 0; i < uiNumTasks; ++i)
+      {
+        ezTaskSystem::WaitForGroup(tg[i]);
+        EZ_TEST_BOOL(t[i]->IsTaskFinished());
+
+        if (t[i]->IsDone())
+          ++uiDone;
+      }
+
+      EZ_TEST_BOOL(uiDone > 0);
+      EZ_TEST_BOOL(uiCanceled > 0);
+      EZ_TEST_BOOL(uiDone + uiCanceled <= uiNumTasks);
+    }
+
+    // the canceled entries are released lazily, make sure nothing is left before switching back
+    for (ezUInt32 prio = 0; prio < ezTaskPriority::ENUM_COUNT; ++prio)
+    {
+      while (ezTaskSystem::GetNumQueuedTasks((ezTaskPriority::Enum)prio) > 0)
+      {
+        ezTaskSystem::FinishFrameTasks();
+      }
+    }
+
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::Locked);
+    EZ_TEST_INT(ezTaskSystem::GetSchedulerMode(), ezTaskSchedulerMode::Locked);
+  }
+
   // capture profiling info for testing
   /*ezStringBuilder sOutputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
 
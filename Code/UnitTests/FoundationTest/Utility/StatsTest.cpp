@@ -0,0 +1,151 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Utilities/Stats.h>
+
+EZ_CREATE_SIMPLE_TEST(Utility, Stats)
+{
+  // sample manually, so that the background thread doesn't add samples in between
+  ezStats::SetAggregationInterval(ezTime::MakeZero());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "String API")
+  {
+    ezStats::SetStat("StatsTest/String", 42);
+    EZ_TEST_INT(ezStats::GetStat("StatsTest/String").ConvertTo<ezInt32>(), 42);
+
+    ezStats::RemoveStat("StatsTest/String");
+    EZ_TEST_BOOL(!ezStats::GetAllStats().Contains("StatsTest/String"));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RegisterStat / UnregisterStat")
+  {
+    ezStatHandle hStat = ezStats::RegisterStat("StatsTest/Value");
+    EZ_TEST_BOOL(hStat.IsValid());
+
+    // registering the same name again returns the same handle
+    ezStatHandle hStat2 = ezStats::RegisterStat("StatsTest/Value");
+    EZ_TEST_BOOL(hStat == hStat2);
+
+    ezStats::SetStat(hStat, 3.0);
+    EZ_TEST_DOUBLE(ezStats::GetStatValue(hStat), 3.0, 0.0);
+
+    // changed values are published to the regular stats
+    ezStats::SampleStats();
+    EZ_TEST_DOUBLE(ezStats::GetStat("StatsTest/Value").ConvertTo<double>(), 3.0, 0.0);
+
+    ezStats::UnregisterStat(hStat2);
+    EZ_TEST_BOOL(!hStat2.IsValid());
+    EZ_TEST_BOOL(ezStats::GetAllStats().Contains("StatsTest/Value"));
+
+    ezStats::UnregisterStat(hStat);
+    EZ_TEST_BOOL(!ezStats::GetAllStats().Contains("StatsTest/Value"));
+
+    // invalid handles are ignored
+    ezStats::SetStat(hStat, 1.0);
+    ezStats::AddToStat(hStat, 1.0);
+    EZ_TEST_DOUBLE(ezStats::GetStatValue(hStat), 0.0, 0.0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Aggregate")
+  {
+    ezStatHandle hStat = ezStats::RegisterStat("StatsTest/Aggregate", ezStats::StatMode::Value, 4);
+
+    ezStats::StatAggregate aggregate;
+    EZ_TEST_BOOL(ezStats::GetStatAggregate(hStat, aggregate).Failed());
+
+    // the history only keeps the last four samples, so the first one is dropped
+    const double values[] = {100.0, 1.0, 2.0, 2.0, 5.0};
+    for (double fValue : values)
+    {
+      ezStats::SetStat(hStat, fValue);
+      ezStats::SampleStats();
+    }
+
+    EZ_TEST_BOOL(ezStats::GetStatAggregate(hStat, aggregate).Succeeded());
+    EZ_TEST_INT(aggregate.m_uiNumSamples, 4);
+    EZ_TEST_DOUBLE(aggregate.m_fMin, 1.0, 0.0);
+    EZ_TEST_DOUBLE(aggregate.m_fMax, 5.0, 0.0);
+    EZ_TEST_DOUBLE(aggregate.m_fAverage, 2.5, 0.0);
+    EZ_TEST_INT(aggregate.m_Histogram[0], 1);
+    EZ_TEST_INT(aggregate.m_Histogram[4], 2);
+    EZ_TEST_INT(aggregate.m_Histogram[ezStats::StatAggregate::HistogramBuckets - 1], 1);
+
+    ezStats::UnregisterStat(hStat);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Counter")
+  {
+    ezStatHandle hStat = ezStats::RegisterStat("StatsTest/Counter", ezStats::StatMode::Counter);
+
+    constexpr ezUInt32 uiNumTasks = 8;
+    constexpr ezUInt32 uiNumIncrements = 10000;
+    constexpr double fExpectedSum = uiNumTasks * uiNumIncrements;
+
+    ezParallelForParams params;
+    params.m_uiBinSize = 1;
+    params.m_uiMaxTasksPerThread = uiNumTasks;
+
+    ezTaskSystem::ParallelForIndexed(0, uiNumTasks,
+      [hStat](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          for (ezUInt32 j = 0; j < uiNumIncrements; ++j)
+          {
+            ezStats::AddToStat(hStat, 1.0);
+          }
+        }
+      },
+      "StatsTest", ezTaskNesting::Never, params);
+
+    EZ_TEST_DOUBLE(ezStats::GetStatValue(hStat), fExpectedSum, 0.0);
+
+    ezStats::SampleStats();
+    ezStats::AddToStat(hStat, 5.0);
+    ezStats::SampleStats();
+
+    // the history of counters holds the increase per sample
+    ezStats::StatAggregate aggregate;
+    EZ_TEST_BOOL(ezStats::GetStatAggregate(hStat, aggregate).Succeeded());
+    EZ_TEST_INT(aggregate.m_uiNumSamples, 2);
+    EZ_TEST_DOUBLE(aggregate.m_fMin, 5.0, 0.0);
+    EZ_TEST_DOUBLE(aggregate.m_fMax, fExpectedSum, 0.0);
+    EZ_TEST_DOUBLE(ezStats::GetStat("StatsTest/Counter").ConvertTo<double>(), fExpectedSum + 5.0, 0.0);
+
+    ezStats::UnregisterStat(hStat);
+
+    // a new stat in the same slot starts at zero
+    hStat = ezStats::RegisterStat("StatsTest/Counter2", ezStats::StatMode::Counter);
+    EZ_TEST_DOUBLE(ezStats::GetStatValue(hStat), 0.0, 0.0);
+    ezStats::UnregisterStat(hStat);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    constexpr ezUInt32 uiNumUpdates = 100000;
+
+    ezStatHandle hStat = ezStats::RegisterStat("StatsTest/Performance");
+
+    ezStopwatch sw;
+    for (ezUInt32 i = 0; i < uiNumUpdates; ++i)
+    {
+      ezStats::SetStat(hStat, i);
+    }
+    const ezTime tHandle = sw.Checkpoint();
+
+    for (ezUInt32 i = 0; i < uiNumUpdates; ++i)
+    {
+      ezStats::SetStat("StatsTest/PerformanceString", i);
+    }
+    const ezTime tString = sw.Checkpoint();
+
+    ezLog::Info("[test]Stat update by handle: {} ns", ezArgF(tHandle.GetNanoseconds() / uiNumUpdates, 1));
+    ezLog::Info("[test]Stat update by name: {} ns", ezArgF(tString.GetNanoseconds() / uiNumUpdates, 1));
+
+    ezStats::UnregisterStat(hStat);
+    ezStats::RemoveStat("StatsTest/PerformanceString");
+  }
+
+  ezStats::SetAggregationInterval(ezTime::MakeFromMilliseconds(100));
+}
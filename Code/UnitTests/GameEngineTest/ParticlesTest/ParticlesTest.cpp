@@ -3,7 +3,15 @@
 #include "ParticlesTest.h"
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <ParticlePlugin/Behavior/ParticleBehavior_FadeOut.h>
+#include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
+#include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
 #include <ParticlePlugin/Components/ParticleComponent.h>
+#include <ParticlePlugin/Emitter/ParticleEmitter_Burst.h>
+#include <ParticlePlugin/Initializer/ParticleInitializer_SpherePosition.h>
+#include <ParticlePlugin/Initializer/ParticleInitializer_VelocityCone.h>
+#include <ParticlePlugin/Resources/ParticleEffectResource.h>
+#include <ParticlePlugin/System/ParticleSystemDescriptor.h>
 #include <RendererFoundation/Device/Device.h>
 
 static ezGameEngineTestParticles s_GameEngineTestParticles;
@@ -54,6 +62,9 @@ void ezGameEngineTestParticles::SetupSubTests()
   AddSubTest("LocalSpaceSim", SubTests::LocalSpaceSim);
 
   AddSubTest("Lighting", SubTests::Lighting);
+
+  AddSubTest("SimulationBenchmark1M", SubTests::SimulationBenchmark1M);
+  AddSubTest("SimulationBenchmark4M", SubTests::SimulationBenchmark4M);
 }
 
 ezResult ezGameEngineTestParticles::InitializeSubTest(ezInt32 iIdentifier)
@@ -98,6 +109,16 @@ ezResult ezGameEngineTestParticles::InitializeSubTest(ezInt32 iIdentifier)
     m_pOwnApplication->SetupSceneSubTest("Particles/AssetCache/Common/Lighting.ezObjectGraph");
     return EZ_SUCCESS;
   }
+  else if (iIdentifier == SubTests::SimulationBenchmark1M)
+  {
+    m_pOwnApplication->SetupSimulationBenchmark(1024 * 1024);
+    return EZ_SUCCESS;
+  }
+  else if (iIdentifier == SubTests::SimulationBenchmark4M)
+  {
+    m_pOwnApplication->SetupSimulationBenchmark(4 * 1024 * 1024);
+    return EZ_SUCCESS;
+  }
   else
   {
     const char* szEffects[] = {
@@ -136,6 +157,9 @@ ezTestAppRun ezGameEngineTestParticles::RunSubTest(ezInt32 iIdentifier, ezUInt32
 {
   ++m_iFrame;
 
+  if (iIdentifier == SubTests::SimulationBenchmark1M || iIdentifier == SubTests::SimulationBenchmark4M)
+    return m_pOwnApplication->ExecSimulationBenchmark(m_iFrame);
+
   return m_pOwnApplication->ExecParticleSubTest(m_iFrame);
 }
 
@@ -218,3 +242,108 @@ ezTestAppRun ezGameEngineTestApplication_Particles::ExecParticleSubTest(ezInt32
 
   return ezTestAppRun::Continue;
 }
+
+void ezGameEngineTestApplication_Particles::SetupSimulationBenchmark(ezUInt32 uiNumParticles)
+{
+  LoadScene("Particles/AssetCache/Common/Particles1.ezObjectGraph").IgnoreResult();
+
+  m_uiBenchmarkParticles = uiNumParticles;
+  m_hBenchmarkComponent.Invalidate();
+
+  // build the effect in code, a single burst with a long lifetime, so that all particles stay alive for the whole benchmark
+  ezParticleEffectResourceDescriptor desc;
+  desc.m_Effect.m_InvisibleUpdateRate = ezEffectInvisibleUpdateRate::FullUpdate;
+
+  ezParticleSystemDescriptor* pSystem = ezGetStaticRTTI<ezParticleSystemDescriptor>()->GetAllocator()->Allocate<ezParticleSystemDescriptor>();
+  pSystem->m_LifeTime.m_Value = ezTime::MakeFromSeconds(60);
+  desc.m_Effect.AddParticleSystem(pSystem);
+
+  {
+    ezParticleEmitterFactory_Burst* pEmitter = ezGetStaticRTTI<ezParticleEmitterFactory_Burst>()->GetAllocator()->Allocate<ezParticleEmitterFactory_Burst>();
+    pEmitter->m_uiSpawnCountMin = uiNumParticles;
+    pEmitter->m_uiSpawnCountRange = 0;
+    pSystem->AddEmitterFactory(pEmitter);
+  }
+
+  {
+    ezParticleInitializerFactory_SpherePosition* pInit = ezGetStaticRTTI<ezParticleInitializerFactory_SpherePosition>()->GetAllocator()->Allocate<ezParticleInitializerFactory_SpherePosition>();
+    pSystem->AddInitializerFactory(pInit);
+  }
+
+  {
+    ezParticleInitializerFactory_VelocityCone* pInit = ezGetStaticRTTI<ezParticleInitializerFactory_VelocityCone>()->GetAllocator()->Allocate<ezParticleInitializerFactory_VelocityCone>();
+    pSystem->AddInitializerFactory(pInit);
+  }
+
+  {
+    ezParticleBehaviorFactory_Gravity* pBehavior = ezGetStaticRTTI<ezParticleBehaviorFactory_Gravity>()->GetAllocator()->Allocate<ezParticleBehaviorFactory_Gravity>();
+    pBehavior->m_fGravityFactor = 0.1f;
+    pSystem->AddBehaviorFactory(pBehavior);
+  }
+
+  {
+    ezParticleBehaviorFactory_Velocity* pBehavior = ezGetStaticRTTI<ezParticleBehaviorFactory_Velocity>()->GetAllocator()->Allocate<ezParticleBehaviorFactory_Velocity>();
+    pBehavior->m_fRiseSpeed = 0.1f;
+    pBehavior->m_fFriction = 0.5f;
+    pSystem->AddBehaviorFactory(pBehavior);
+  }
+
+  {
+    ezParticleBehaviorFactory_FadeOut* pBehavior = ezGetStaticRTTI<ezParticleBehaviorFactory_FadeOut>()->GetAllocator()->Allocate<ezParticleBehaviorFactory_FadeOut>();
+    pSystem->AddBehaviorFactory(pBehavior);
+  }
+
+  ezStringBuilder sResourceID;
+  sResourceID.SetFormat("ParticleSimulationBenchmark{}", uiNumParticles);
+
+  ezParticleEffectResourceHandle hEffect = ezResourceManager::GetOrCreateResource<ezParticleEffectResource>(sResourceID, std::move(desc));
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  ezGameObject* pObject;
+  if (m_pWorld->TryGetObjectWithGlobalKey("Effect", pObject))
+  {
+    ezParticleComponent* pEffect;
+    m_hBenchmarkComponent = m_pWorld->GetOrCreateComponentManager<ezParticleComponentManager>()->CreateComponent(pObject, pEffect);
+    pEffect->SetParticleEffect(hEffect);
+    pEffect->m_uiRandomSeed = 42;
+  }
+}
+
+ezTestAppRun ezGameEngineTestApplication_Particles::ExecSimulationBenchmark(ezInt32 iCurFrame)
+{
+  constexpr ezInt32 iWarmupFrames = 5;
+  constexpr ezInt32 iMeasuredFrames = 60;
+
+  if (iCurFrame == iWarmupFrames)
+  {
+    m_BenchmarkTimer.StopAndReset();
+    m_BenchmarkTimer.Resume();
+  }
+
+  if (Run() == ezApplication::Execution::Quit)
+    return ezTestAppRun::Quit;
+
+  if (iCurFrame < iWarmupFrames + iMeasuredFrames - 1)
+    return ezTestAppRun::Continue;
+
+  const ezTime tTotal = m_BenchmarkTimer.GetRunningTotal();
+
+  ezUInt64 uiNumActive = 0;
+  {
+    EZ_LOCK(m_pWorld->GetReadMarker());
+
+    const ezParticleComponent* pEffect = nullptr;
+    if (m_pWorld->TryGetComponent(m_hBenchmarkComponent, pEffect))
+    {
+      uiNumActive = pEffect->m_EffectController.GetNumActiveParticles();
+    }
+  }
+
+  EZ_TEST_INT(uiNumActive, m_uiBenchmarkParticles);
+
+  const double fFrameTime = tTotal.GetMilliseconds() / iMeasuredFrames;
+  ezLog::Info("[test]{} particles: {} ms per frame, {} ns per particle", m_uiBenchmarkParticles, ezArgF(fFrameTime, 2), ezArgF(fFrameTime * 1000000.0 / m_uiBenchmarkParticles, 2));
+
+  return ezTestAppRun::Quit;
+}
@@ -3,6 +3,7 @@
 #include <GameEngineTest/GameEngineTestPCH.h>
 
 #include "../TestClass/TestClass.h"
+#include <Foundation/Time/Stopwatch.h>
 
 class ezGameEngineTestApplication_Particles : public ezGameEngineTestApplication
 {
@@ -13,7 +14,15 @@ public:
   void SetupParticleSubTest(const char* szFile);
   ezTestAppRun ExecParticleSubTest(ezInt32 iCurFrame);
 
+  void SetupSimulationBenchmark(ezUInt32 uiNumParticles);
+  ezTestAppRun ExecSimulationBenchmark(ezInt32 iCurFrame);
+
   ezUInt32 m_uiImageCompareThreshold = 110;
+
+private:
+  ezUInt32 m_uiBenchmarkParticles = 0;
+  ezComponentHandle m_hBenchmarkComponent;
+  ezStopwatch m_BenchmarkTimer;
 };
 
 class ezGameEngineTestParticles : public ezGameEngineTest
@@ -59,7 +68,10 @@ private:
     EventReactionEffect,
     LocalSpaceSim,
 
-    Lighting
+    Lighting,
+
+    SimulationBenchmark1M,
+    SimulationBenchmark4M,
   };
 
   virtual void SetupSubTests() override;
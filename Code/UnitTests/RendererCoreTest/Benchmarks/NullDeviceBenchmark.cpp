@@ -0,0 +1,401 @@
+#include <RendererCoreTest/RendererCoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/Implementation/RenderPipelineResourceLoader.h>
+#include <RendererCore/Pipeline/Passes/SourcePass.h>
+#include <RendererCore/Pipeline/Passes/TargetPass.h>
+#include <RendererCore/Pipeline/RenderPipeline.h>
+#include <RendererCore/Pipeline/RenderPipelineResource.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCoreTest/Benchmarks/NullDeviceBenchmark.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezNullBenchmarkRenderData, 1, ezRTTIDefaultAllocator<ezNullBenchmarkRenderData>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezNullBenchmarkRenderer, 1, ezRTTIDefaultAllocator<ezNullBenchmarkRenderer>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_BEGIN_COMPONENT_TYPE(ezNullBenchmarkComponent, 1, ezComponentMode::Dynamic)
+{
+  EZ_BEGIN_MESSAGEHANDLERS
+  {
+    EZ_MESSAGE_HANDLER(ezMsgExtractRenderData, OnMsgExtractRenderData),
+  }
+  EZ_END_MESSAGEHANDLERS;
+}
+EZ_END_COMPONENT_TYPE;
+
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezNullBenchmarkRenderPass, 1, ezRTTIDefaultAllocator<ezNullBenchmarkRenderPass>)
+{
+  EZ_BEGIN_PROPERTIES
+  {
+    EZ_MEMBER_PROPERTY("Color", m_PinColor),
+  }
+  EZ_END_PROPERTIES;
+}
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezHybridArray<ezNullBenchmarkRenderer::Mesh, 16> ezNullBenchmarkRenderer::s_Meshes;
+ezGALBufferHandle ezNullBenchmarkRenderer::s_hTransformBuffer;
+
+void ezNullBenchmarkRenderer::GetSupportedRenderDataTypes(ezHybridArray<const ezRTTI*, 8>& ref_types) const
+{
+  ref_types.PushBack(ezGetStaticRTTI<ezNullBenchmarkRenderData>());
+}
+
+void ezNullBenchmarkRenderer::GetSupportedRenderDataCategories(ezHybridArray<ezRenderData::Category, 8>& ref_categories) const
+{
+  ref_categories.PushBack(ezDefaultRenderDataCategories::LitOpaque);
+}
+
+void ezNullBenchmarkRenderer::RenderBatch(const ezRenderViewContext& renderViewContext, const ezRenderPipelinePass* pPass, const ezRenderDataBatch& batch) const
+{
+  ezGALRenderCommandEncoder* pCommandEncoder = renderViewContext.m_pRenderContext->GetRenderCommandEncoder();
+
+  // All render data in a batch shares the same mesh
+  const Mesh& mesh = s_Meshes[batch.GetFirstData<ezNullBenchmarkRenderData>()->m_uiMeshIndex];
+  pCommandEncoder->SetPrimitiveTopology(ezGALPrimitiveTopology::Triangles);
+  pCommandEncoder->SetVertexBuffer(0, mesh.m_hVertexBuffer);
+  pCommandEncoder->SetIndexBuffer(mesh.m_hIndexBuffer);
+
+  for (auto it = batch.GetIterator<ezNullBenchmarkRenderData>(); it.IsValid(); ++it)
+  {
+    const ezMat4 mTransform = it->m_GlobalTransform.GetAsMat4();
+    pCommandEncoder->UpdateBuffer(s_hTransformBuffer, 0, ezMakeArrayPtr(&mTransform, 1).ToByteArray());
+    pCommandEncoder->DrawIndexed(mesh.m_uiIndexCount, 0).IgnoreResult();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezNullBenchmarkComponent::ezNullBenchmarkComponent() = default;
+ezNullBenchmarkComponent::~ezNullBenchmarkComponent() = default;
+
+ezResult ezNullBenchmarkComponent::GetLocalBounds(ezBoundingBoxSphere& ref_bounds, bool& ref_bAlwaysVisible, ezMsgUpdateLocalBounds& ref_msg)
+{
+  ref_bounds = ezBoundingSphere::MakeFromCenterAndRadius(ezVec3::MakeZero(), 0.5f);
+  return EZ_SUCCESS;
+}
+
+void ezNullBenchmarkComponent::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const
+{
+  ezNullBenchmarkRenderData* pRenderData = ezCreateRenderDataForThisFrame<ezNullBenchmarkRenderData>(GetOwner());
+  {
+    pRenderData->m_GlobalTransform = GetOwner()->GetGlobalTransform();
+    pRenderData->m_GlobalBounds = GetOwner()->GetGlobalBounds();
+    pRenderData->m_uiMeshIndex = m_uiMeshIndex;
+    pRenderData->m_uiBatchId = m_uiMeshIndex;
+    pRenderData->m_uiSortingKey = m_uiMeshIndex;
+  }
+
+  msg.AddRenderData(pRenderData, ezDefaultRenderDataCategories::LitOpaque, ezRenderData::Caching::IfStatic);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezNullBenchmarkRenderPass::ezNullBenchmarkRenderPass(const char* szName)
+  : ezRenderPipelinePass(szName, true)
+{
+}
+
+ezNullBenchmarkRenderPass::~ezNullBenchmarkRenderPass() = default;
+
+bool ezNullBenchmarkRenderPass::GetRenderTargetDescriptions(const ezView& view, const ezArrayPtr<ezGALTextureCreationDescription* const> inputs, ezArrayPtr<ezGALTextureCreationDescription> outputs)
+{
+  if (inputs[m_PinColor.m_uiInputIndex] == nullptr)
+    return false;
+
+  outputs[m_PinColor.m_uiOutputIndex] = *inputs[m_PinColor.m_uiInputIndex];
+  return true;
+}
+
+void ezNullBenchmarkRenderPass::Execute(const ezRenderViewContext& renderViewContext, const ezArrayPtr<ezRenderPipelinePassConnection* const> inputs, const ezArrayPtr<ezRenderPipelinePassConnection* const> outputs)
+{
+  ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
+
+  ezGALRenderingSetup renderingSetup;
+  renderingSetup.m_RenderTargetSetup.SetRenderTarget(0, pDevice->GetDefaultRenderTargetView(inputs[m_PinColor.m_uiInputIndex]->m_TextureHandle));
+  renderingSetup.m_uiRenderTargetClearMask = 0xFFFFFFFF;
+
+  auto pCommandEncoder = ezRenderContext::BeginPassAndRenderingScope(renderViewContext, std::move(renderingSetup), GetName());
+
+  RenderDataWithCategory(renderViewContext, ezDefaultRenderDataCategories::LitOpaque);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+static ezRendererCoreTestNullDeviceBenchmark g_NullDeviceBenchmark;
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumBenchmarkMeshes = 16;
+  constexpr ezUInt32 s_uiResolution = 512;
+} // namespace
+
+void ezRendererCoreTestNullDeviceBenchmark::SetupSubTests()
+{
+  AddSubTest("01 - 10k Meshes", SubTests::ST_10kMeshes);
+  AddSubTest("02 - 100k Meshes", SubTests::ST_100kMeshes);
+  AddSubTest("03 - 1M Meshes", SubTests::ST_1MMeshes);
+}
+
+ezResult ezRendererCoreTestNullDeviceBenchmark::InitializeSubTest(ezInt32 iIdentifier)
+{
+  EZ_SUCCEED_OR_RETURN(SetupRenderer());
+
+  // Without transformed assets some built-in systems (e.g. the reflection probe visualization) would not find their materials.
+  {
+    ezMaterialResourceDescriptor desc;
+    ezMaterialResourceHandle hMaterial = ezResourceManager::GetOrCreateResource<ezMaterialResource>("NullDeviceBenchmarkMaterial", std::move(desc), "Empty material");
+    ezResourceManager::SetResourceTypeMissingFallback<ezMaterialResource>(hMaterial);
+  }
+
+  // Render what was extracted in the same frame, otherwise the timings of the stages can't be separated.
+  if (ezCVarBool* pMultithreading = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Rendering.Multithreading")))
+  {
+    m_bMultithreadedRendering = pMultithreading->GetValue();
+    *pMultithreading = false;
+  }
+
+  CreateMeshes();
+
+  const ezUInt32 uiNumMeshes = iIdentifier == ST_10kMeshes ? 10000 : (iIdentifier == ST_100kMeshes ? 100000 : 1000000);
+  CreateScene(uiNumMeshes);
+  CreateView();
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererCoreTestNullDeviceBenchmark::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  ezRenderWorld::ClearMainViews();
+  ezRenderWorld::DeleteView(m_hView);
+  m_hView.Invalidate();
+
+  m_pWorld = nullptr;
+
+  // This is also called if the initialization failed, e.g. because the null device is not available.
+  if (m_pDevice)
+  {
+    m_pDevice->DestroyTexture(m_hColorTarget);
+
+    for (auto& mesh : ezNullBenchmarkRenderer::s_Meshes)
+    {
+      m_pDevice->DestroyBuffer(mesh.m_hVertexBuffer);
+      m_pDevice->DestroyBuffer(mesh.m_hIndexBuffer);
+    }
+
+    m_pDevice->DestroyBuffer(ezNullBenchmarkRenderer::s_hTransformBuffer);
+  }
+
+  m_hColorTarget.Invalidate();
+  ezNullBenchmarkRenderer::s_Meshes.Clear();
+  ezNullBenchmarkRenderer::s_hTransformBuffer.Invalidate();
+
+  if (ezCVarBool* pMultithreading = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Rendering.Multithreading")))
+  {
+    *pMultithreading = m_bMultithreadedRendering;
+  }
+
+  ezResourceManager::SetResourceTypeMissingFallback<ezMaterialResource>(ezMaterialResourceHandle());
+
+  ShutdownRenderer();
+  return EZ_SUCCESS;
+}
+
+ezTestAppRun ezRendererCoreTestNullDeviceBenchmark::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  ezGALDeviceNull* pDeviceNull = static_cast<ezGALDeviceNull*>(m_pDevice);
+
+  const ezUInt32 uiNumFrames = iIdentifier == ST_1MMeshes ? 3 : 10;
+
+  ezTime tUpdate;
+  ezTime tExtraction;
+  ezTime tRender;
+  ezUInt64 uiNumDrawCalls = 0;
+
+  // The reflection probe visualization tries to load its material once, the empty fallback is used instead.
+  ezTestLogInterface log;
+  ezTestLogSystemScope logSystemScope(&log, true);
+  log.ExpectMessage("Missing Resource of Type 'ezMaterialResource'", ezLogMsgType::SeriousWarningMsg);
+
+  // The first frame creates the render pipeline and all of its targets, so it is not measured.
+  for (ezUInt32 uiFrame = 0; uiFrame <= uiNumFrames; ++uiFrame)
+  {
+    const ezUInt64 uiSubmittedBefore = pDeviceNull->GetNumSubmittedCommands();
+
+    ezStopwatch sw;
+
+    {
+      EZ_LOCK(m_pWorld->GetWriteMarker());
+      m_pWorld->Update();
+    }
+
+    const ezTime tFrameUpdate = sw.Checkpoint();
+
+    ezRenderWorld::ExtractMainViews();
+
+    const ezTime tFrameExtraction = sw.Checkpoint();
+
+    ezRenderWorld::BeginFrame();
+    m_pDevice->BeginFrame(ezRenderWorld::GetFrameCounter());
+    ezRenderWorld::Render(ezRenderContext::GetDefaultInstance());
+    m_pDevice->EndFrame();
+    ezRenderWorld::EndFrame();
+
+    const ezTime tFrameRender = sw.Checkpoint();
+
+    if (uiFrame > 0)
+    {
+      tUpdate += tFrameUpdate;
+      tExtraction += tFrameExtraction;
+      tRender += tFrameRender;
+      uiNumDrawCalls += pDeviceNull->GetNumSubmittedCommands() - uiSubmittedBefore;
+    }
+  }
+
+  const double fInvNumFrames = 1.0 / uiNumFrames;
+  ezLog::Info("[test]World update: {} ms per frame", ezArgF(tUpdate.GetMilliseconds() * fInvNumFrames, 2));
+  ezLog::Info("[test]Extraction: {} ms per frame", ezArgF(tExtraction.GetMilliseconds() * fInvNumFrames, 2));
+  ezLog::Info("[test]Render: {} ms per frame, {} draw calls", ezArgF(tRender.GetMilliseconds() * fInvNumFrames, 2), uiNumDrawCalls / uiNumFrames);
+
+  EZ_LOCK(m_pWorld->GetReadMarker());
+  EZ_TEST_INT(uiNumDrawCalls, m_pWorld->GetObjectCount() * uiNumFrames);
+  EZ_TEST_INT(pDeviceNull->GetNumRejectedCommands(), 0);
+
+  return ezTestAppRun::Quit;
+}
+
+void ezRendererCoreTestNullDeviceBenchmark::CreateMeshes()
+{
+  // Synthetic meshes of growing size, the null device never looks at the content.
+  ezDynamicArray<ezUInt8> data;
+  for (ezUInt32 i = 0; i < s_uiNumBenchmarkMeshes; ++i)
+  {
+    const ezUInt32 uiVertexCount = 24 * (i + 1);
+    const ezUInt32 uiIndexCount = 36 * (i + 1);
+
+    data.Clear();
+    data.SetCount(uiVertexCount * sizeof(ezVec3));
+
+    ezNullBenchmarkRenderer::Mesh& mesh = ezNullBenchmarkRenderer::s_Meshes.ExpandAndGetRef();
+    mesh.m_hVertexBuffer = m_pDevice->CreateVertexBuffer(sizeof(ezVec3), uiVertexCount, data);
+
+    data.Clear();
+    data.SetCount(uiIndexCount * sizeof(ezUInt16));
+
+    mesh.m_hIndexBuffer = m_pDevice->CreateIndexBuffer(ezGALIndexType::UShort, uiIndexCount, data);
+    mesh.m_uiIndexCount = uiIndexCount;
+  }
+
+  ezNullBenchmarkRenderer::s_hTransformBuffer = m_pDevice->CreateConstantBuffer(sizeof(ezMat4));
+}
+
+void ezRendererCoreTestNullDeviceBenchmark::CreateScene(ezUInt32 uiNumMeshes)
+{
+  ezWorldDesc worldDesc("NullDeviceBenchmark");
+  m_pWorld = EZ_DEFAULT_NEW(ezWorld, worldDesc);
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  ezNullBenchmarkComponentManager* pManager = m_pWorld->GetOrCreateComponentManager<ezNullBenchmarkComponentManager>();
+
+  // Arrange all meshes in a cube in front of the camera, so that nothing gets culled.
+  const ezUInt32 uiSide = static_cast<ezUInt32>(ezMath::Ceil(ezMath::Pow(static_cast<float>(uiNumMeshes), 1.0f / 3.0f)));
+  const float fSpacing = 2.0f;
+  const float fHalfExtent = uiSide * fSpacing * 0.5f;
+
+  ezStopwatch sw;
+
+  for (ezUInt32 i = 0; i < uiNumMeshes; ++i)
+  {
+    const ezUInt32 x = i % uiSide;
+    const ezUInt32 y = (i / uiSide) % uiSide;
+    const ezUInt32 z = i / (uiSide * uiSide);
+
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = true;
+    desc.m_LocalPosition.Set(x * fSpacing, y * fSpacing - fHalfExtent, z * fSpacing - fHalfExtent);
+
+    ezGameObject* pObject = nullptr;
+    m_pWorld->CreateObject(desc, pObject);
+
+    ezNullBenchmarkComponent* pComponent = nullptr;
+    pManager->CreateComponent(pObject, pComponent);
+    pComponent->m_uiMeshIndex = i % s_uiNumBenchmarkMeshes;
+  }
+
+  ezLog::Info("[test]Creating {} meshes: {} ms", uiNumMeshes, ezArgF(sw.GetRunningTotal().GetMilliseconds(), 2));
+
+  // With a 90 degree field of view the whole front face is visible at this distance.
+  m_Camera.LookAt(ezVec3(-2.0f * fHalfExtent, 0, 0), ezVec3::MakeZero(), ezVec3(0, 0, 1));
+  m_Camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 90.0f, 0.1f, 8.0f * fHalfExtent);
+}
+
+void ezRendererCoreTestNullDeviceBenchmark::CreateView()
+{
+  ezGALTextureCreationDescription targetDesc;
+  targetDesc.SetAsRenderTarget(s_uiResolution, s_uiResolution, ezGALResourceFormat::RGBAUByteNormalizedsRGB);
+  m_hColorTarget = m_pDevice->CreateTexture(targetDesc);
+
+  ezRenderPipelineResourceHandle hPipeline;
+  {
+    ezUniquePtr<ezRenderPipeline> pRenderPipeline = EZ_DEFAULT_NEW(ezRenderPipeline);
+
+    ezSourcePass* pColorSourcePass = nullptr;
+    {
+      ezUniquePtr<ezSourcePass> pPass = EZ_DEFAULT_NEW(ezSourcePass, "ColorSource");
+      pColorSourcePass = pPass.Borrow();
+      pRenderPipeline->AddPass(std::move(pPass));
+    }
+
+    ezNullBenchmarkRenderPass* pBenchmarkPass = nullptr;
+    {
+      ezUniquePtr<ezNullBenchmarkRenderPass> pPass = EZ_DEFAULT_NEW(ezNullBenchmarkRenderPass);
+      pBenchmarkPass = pPass.Borrow();
+      pRenderPipeline->AddPass(std::move(pPass));
+    }
+
+    ezTargetPass* pTargetPass = nullptr;
+    {
+      ezUniquePtr<ezTargetPass> pPass = EZ_DEFAULT_NEW(ezTargetPass);
+      pTargetPass = pPass.Borrow();
+      pRenderPipeline->AddPass(std::move(pPass));
+    }
+
+    EZ_VERIFY(pRenderPipeline->Connect(pColorSourcePass, "Output", pBenchmarkPass, "Color"), "Connect failed!");
+    EZ_VERIFY(pRenderPipeline->Connect(pBenchmarkPass, "Color", pTargetPass, "Color0"), "Connect failed!");
+
+    pRenderPipeline->AddExtractor(EZ_DEFAULT_NEW(ezVisibleObjectsExtractor));
+
+    ezRenderPipelineResourceDescriptor desc;
+    ezRenderPipelineResourceLoader::CreateRenderPipelineResourceDescriptor(pRenderPipeline.Borrow(), desc);
+
+    hPipeline = ezResourceManager::GetOrCreateResource<ezRenderPipelineResource>("NullDeviceBenchmarkPipeline", std::move(desc), "NullDeviceBenchmarkPipeline");
+  }
+
+  ezView* pView = nullptr;
+  m_hView = ezRenderWorld::CreateView("NullDeviceBenchmark", pView);
+  pView->SetCameraUsageHint(ezCameraUsageHint::MainView);
+  pView->SetWorld(m_pWorld.Borrow());
+  pView->SetCamera(&m_Camera);
+  pView->SetViewport(ezRectFloat(0.0f, 0.0f, (float)s_uiResolution, (float)s_uiResolution));
+
+  ezGALRenderTargets renderTargets;
+  renderTargets.m_hRTs[0] = m_hColorTarget;
+  pView->SetRenderTargets(renderTargets);
+  pView->SetRenderPipelineResource(hPipeline);
+
+  ezRenderWorld::AddMainView(m_hView);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Core/World/World.h>
+#include <RendererCore/Components/RenderComponent.h>
+#include <RendererCore/Pipeline/RenderPipelinePass.h>
+#include <RendererCore/Pipeline/Renderer.h>
+#include <RendererCoreTest/TestClass/TestClass.h>
+
+/// \brief Render data of ezNullBenchmarkComponent. Only references one of the shared benchmark meshes.
+class ezNullBenchmarkRenderData : public ezRenderData
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezNullBenchmarkRenderData, ezRenderData);
+
+public:
+  ezUInt32 m_uiMeshIndex = 0;
+};
+
+/// \brief Issues the GAL commands for ezNullBenchmarkRenderData directly, since the null device can't compile or run any shaders.
+class ezNullBenchmarkRenderer : public ezRenderer
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezNullBenchmarkRenderer, ezRenderer);
+
+public:
+  struct Mesh
+  {
+    ezGALBufferHandle m_hVertexBuffer;
+    ezGALBufferHandle m_hIndexBuffer;
+    ezUInt32 m_uiIndexCount = 0;
+  };
+
+  virtual void GetSupportedRenderDataTypes(ezHybridArray<const ezRTTI*, 8>& ref_types) const override;
+  virtual void GetSupportedRenderDataCategories(ezHybridArray<ezRenderData::Category, 8>& ref_categories) const override;
+  virtual void RenderBatch(const ezRenderViewContext& renderViewContext, const ezRenderPipelinePass* pPass, const ezRenderDataBatch& batch) const override;
+
+  static ezHybridArray<Mesh, 16> s_Meshes;
+  static ezGALBufferHandle s_hTransformBuffer;
+};
+
+using ezNullBenchmarkComponentManager = ezComponentManager<class ezNullBenchmarkComponent, ezBlockStorageType::Compact>;
+
+class ezNullBenchmarkComponent : public ezRenderComponent
+{
+  EZ_DECLARE_COMPONENT_TYPE(ezNullBenchmarkComponent, ezRenderComponent, ezNullBenchmarkComponentManager);
+
+public:
+  ezNullBenchmarkComponent();
+  ~ezNullBenchmarkComponent();
+
+  virtual ezResult GetLocalBounds(ezBoundingBoxSphere& ref_bounds, bool& ref_bAlwaysVisible, ezMsgUpdateLocalBounds& ref_msg) override;
+
+  ezUInt32 m_uiMeshIndex = 0;
+
+protected:
+  void OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const;
+};
+
+/// \brief Renders all opaque render data into the color target without any further setup.
+class ezNullBenchmarkRenderPass : public ezRenderPipelinePass
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezNullBenchmarkRenderPass, ezRenderPipelinePass);
+
+public:
+  ezNullBenchmarkRenderPass(const char* szName = "NullBenchmarkRenderPass");
+  ~ezNullBenchmarkRenderPass();
+
+  virtual bool GetRenderTargetDescriptions(const ezView& view, const ezArrayPtr<ezGALTextureCreationDescription* const> inputs, ezArrayPtr<ezGALTextureCreationDescription> outputs) override;
+  virtual void Execute(const ezRenderViewContext& renderViewContext, const ezArrayPtr<ezRenderPipelinePassConnection* const> inputs, const ezArrayPtr<ezRenderPipelinePassConnection* const> outputs) override;
+
+protected:
+  ezRenderPipelineNodePassThrougPin m_PinColor;
+};
+
+/// \brief Measures the CPU cost of world update, extraction and rendering of large scenes on the null device.
+///
+/// The null device does not need a GPU, so this runs on headless machines as well. All draw calls go through the regular
+/// ezRenderPipeline, ezRenderContext and ezRenderer code paths and end up in the validating no-op command encoder of the null device.
+class ezRendererCoreTestNullDeviceBenchmark : public ezNullDeviceTest
+{
+public:
+  virtual const char* GetTestName() const override { return "NullDeviceBenchmark"; }
+
+private:
+  enum SubTests
+  {
+    ST_10kMeshes,
+    ST_100kMeshes,
+    ST_1MMeshes,
+  };
+
+  virtual void SetupSubTests() override;
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  void CreateMeshes();
+  void CreateScene(ezUInt32 uiNumMeshes);
+  void CreateView();
+
+  ezUniquePtr<ezWorld> m_pWorld;
+  ezCamera m_Camera;
+  ezViewHandle m_hView;
+  ezGALTextureHandle m_hColorTarget;
+  bool m_bMultithreadedRendering = true;
+};
@@ -0,0 +1,387 @@
+#include <RendererCoreTest/RendererCoreTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCoreTest/Pipeline/ExtractionTest.h>
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezExtractionTestRenderData, 1, ezRTTIDefaultAllocator<ezExtractionTestRenderData>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+
+EZ_BEGIN_COMPONENT_TYPE(ezExtractionTestComponent, 1, ezComponentMode::Static)
+{
+  EZ_BEGIN_MESSAGEHANDLERS
+  {
+    EZ_MESSAGE_HANDLER(ezMsgExtractRenderData, OnMsgExtractRenderData),
+  }
+  EZ_END_MESSAGEHANDLERS;
+}
+EZ_END_COMPONENT_TYPE;
+// clang-format on
+
+ezExtractionTestComponent::ezExtractionTestComponent()
+  : m_Category(ezDefaultRenderDataCategories::LitOpaque)
+{
+}
+
+ezExtractionTestComponent::~ezExtractionTestComponent() = default;
+
+ezResult ezExtractionTestComponent::GetLocalBounds(ezBoundingBoxSphere& ref_bounds, bool& ref_bAlwaysVisible, ezMsgUpdateLocalBounds& ref_msg)
+{
+  ref_bounds = ezBoundingSphere::MakeFromCenterAndRadius(ezVec3::MakeZero(), 0.5f);
+  return EZ_SUCCESS;
+}
+
+void ezExtractionTestComponent::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const
+{
+  ++m_uiNumExtractions;
+
+  ezExtractionTestRenderData* pRenderData = ezCreateRenderDataForThisFrame<ezExtractionTestRenderData>(GetOwner());
+  {
+    pRenderData->m_GlobalTransform = GetOwner()->GetGlobalTransform();
+    pRenderData->m_GlobalBounds = GetOwner()->GetGlobalBounds();
+    pRenderData->m_uiBatchId = m_uiBatchId;
+    pRenderData->m_uiSortingKey = m_uiSortingKey;
+  }
+
+  msg.AddRenderData(pRenderData, m_Category, ezRenderData::Caching::IfStatic);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+static ezRendererCoreTestExtraction g_ExtractionTest;
+
+namespace
+{
+  struct ExtractedEntry
+  {
+    const ezRenderData* m_pRenderData = nullptr;
+    ezGameObjectHandle m_hOwner;
+    ezUInt32 m_uiBatch = 0;
+  };
+
+  // Flattens all batches of the given category in their final order.
+  void GetSortedEntries(const ezExtractedRenderData& extractedRenderData, ezRenderData::Category category, ezDynamicArray<ExtractedEntry>& out_entries)
+  {
+    out_entries.Clear();
+
+    ezRenderDataBatchList batchList = extractedRenderData.GetRenderDataBatchesWithCategory(category);
+    for (ezUInt32 uiBatch = 0; uiBatch < batchList.GetBatchCount(); ++uiBatch)
+    {
+      ezRenderDataBatch batch = batchList.GetBatch(uiBatch);
+      for (auto it = batch.GetIterator<ezRenderData>(); it.IsValid(); ++it)
+      {
+        ExtractedEntry& entry = out_entries.ExpandAndGetRef();
+        entry.m_pRenderData = &(*it);
+        entry.m_hOwner = it->m_hOwner;
+        entry.m_uiBatch = uiBatch;
+      }
+    }
+  }
+} // namespace
+
+void ezRendererCoreTestExtraction::SetupSubTests()
+{
+  AddSubTest("MergeRenderData", SubTests::ST_MergeRenderData);
+  AddSubTest("Parallel Extraction", SubTests::ST_ParallelExtraction);
+  AddSubTest("Render Data Cache", SubTests::ST_RenderDataCache);
+}
+
+ezResult ezRendererCoreTestExtraction::InitializeTest()
+{
+  return SetupRenderer();
+}
+
+ezResult ezRendererCoreTestExtraction::DeInitializeTest()
+{
+  ShutdownRenderer();
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererCoreTestExtraction::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  ezRenderWorld::DeleteView(m_hView);
+  m_hView.Invalidate();
+
+  m_pWorld = nullptr;
+  return EZ_SUCCESS;
+}
+
+ezTestAppRun ezRendererCoreTestExtraction::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  switch (iIdentifier)
+  {
+    case SubTests::ST_MergeRenderData:
+      TestMergeRenderData();
+      break;
+    case SubTests::ST_ParallelExtraction:
+      TestParallelExtraction();
+      break;
+    case SubTests::ST_RenderDataCache:
+      TestRenderDataCache();
+      break;
+  }
+
+  return ezTestAppRun::Quit;
+}
+
+void ezRendererCoreTestExtraction::TestMergeRenderData()
+{
+  const ezRenderData::Category categories[] = {ezDefaultRenderDataCategories::LitOpaque, ezDefaultRenderDataCategories::LitMasked, ezDefaultRenderDataCategories::SimpleForeground};
+
+  constexpr ezUInt32 uiNumRenderData = 60;
+  ezExtractionTestRenderData renderData[uiNumRenderData];
+
+  for (ezUInt32 i = 0; i < uiNumRenderData; ++i)
+  {
+    renderData[i].m_GlobalTransform = ezTransform::MakeIdentity();
+    renderData[i].m_GlobalTransform.m_vPosition.Set((float)(i % 11), 0, 0);
+    renderData[i].m_uiBatchId = i % 4;
+    renderData[i].m_uiSortingKey = i % 3;
+  }
+
+  ezExtractedRenderData reference;
+  reference.SetCamera(m_Camera);
+
+  // every per-thread buffer only knows the categories it has used itself, the last one is empty
+  ezExtractedRenderData perThread[4];
+  for (ezUInt32 i = 0; i < uiNumRenderData; ++i)
+  {
+    const ezUInt32 uiThread = i * 3 / uiNumRenderData;
+    const ezRenderData::Category category = categories[ezMath::Min(i % 3, uiThread)];
+
+    perThread[uiThread].SetCamera(m_Camera);
+    perThread[uiThread].AddRenderData(&renderData[i], category);
+    reference.AddRenderData(&renderData[i], category);
+  }
+
+  ezExtractedRenderData merged;
+  merged.SetCamera(m_Camera);
+  for (const ezExtractedRenderData& data : perThread)
+  {
+    merged.MergeRenderData(data);
+  }
+
+  reference.SortAndBatch();
+  merged.SortAndBatch();
+
+  ezDynamicArray<ExtractedEntry> referenceEntries;
+  ezDynamicArray<ExtractedEntry> mergedEntries;
+  ezUInt32 uiTotalCount = 0;
+
+  for (ezRenderData::Category category : categories)
+  {
+    GetSortedEntries(reference, category, referenceEntries);
+    GetSortedEntries(merged, category, mergedEntries);
+
+    EZ_TEST_BOOL(!referenceEntries.IsEmpty());
+
+    if (EZ_TEST_INT(mergedEntries.GetCount(), referenceEntries.GetCount()))
+    {
+      for (ezUInt32 i = 0; i < referenceEntries.GetCount(); ++i)
+      {
+        EZ_TEST_BOOL(mergedEntries[i].m_pRenderData == referenceEntries[i].m_pRenderData);
+        EZ_TEST_INT(mergedEntries[i].m_uiBatch, referenceEntries[i].m_uiBatch);
+      }
+    }
+
+    uiTotalCount += mergedEntries.GetCount();
+  }
+
+  EZ_TEST_INT(uiTotalCount, uiNumRenderData);
+}
+
+void ezRendererCoreTestExtraction::TestParallelExtraction()
+{
+  CreateWorldAndView("ParallelExtraction");
+
+  // enough objects for many chunks, the last one only partially filled
+  const ezUInt32 uiNumObjects = ezVisibleObjectsExtractor::ObjectsPerChunk * 9 + 17;
+
+  ezDynamicArray<const ezGameObject*> visibleObjects;
+  {
+    EZ_LOCK(m_pWorld->GetWriteMarker());
+
+    ezExtractionTestComponentManager* pManager = m_pWorld->GetOrCreateComponentManager<ezExtractionTestComponentManager>();
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = true;
+      desc.m_LocalPosition.Set((float)(i % 13), (float)(i % 7), (float)(i % 5));
+
+      ezGameObject* pObject = nullptr;
+      m_pWorld->CreateObject(desc, pObject);
+
+      ezExtractionTestComponent* pComponent = nullptr;
+      pManager->CreateComponent(pObject, pComponent);
+      pComponent->m_Category = (i % 3) == 0 ? ezDefaultRenderDataCategories::LitMasked : ezDefaultRenderDataCategories::LitOpaque;
+      pComponent->m_uiBatchId = i % 5;
+      pComponent->m_uiSortingKey = i % 4;
+
+      visibleObjects.PushBack(pObject);
+    }
+
+    // components only handle messages once they are initialized
+    m_pWorld->Update();
+  }
+
+  ezCVarBool* pMultithreaded = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Spatial.Extraction.Multithreaded"));
+  if (!EZ_TEST_BOOL(pMultithreaded != nullptr))
+    return;
+
+  const bool bMultithreaded = pMultithreaded->GetValue();
+
+  ezExtractedRenderData serial;
+  *pMultithreaded = false;
+  Extract(visibleObjects, serial);
+
+  ezExtractedRenderData parallel;
+  *pMultithreaded = true;
+  Extract(visibleObjects, parallel);
+
+  *pMultithreaded = bMultithreaded;
+
+  ezDynamicArray<ExtractedEntry> serialEntries;
+  ezDynamicArray<ExtractedEntry> parallelEntries;
+  ezUInt32 uiTotalCount = 0;
+
+  for (ezRenderData::Category category : {ezDefaultRenderDataCategories::LitOpaque, ezDefaultRenderDataCategories::LitMasked})
+  {
+    GetSortedEntries(serial, category, serialEntries);
+    GetSortedEntries(parallel, category, parallelEntries);
+
+    if (EZ_TEST_INT(parallelEntries.GetCount(), serialEntries.GetCount()))
+    {
+      for (ezUInt32 i = 0; i < serialEntries.GetCount(); ++i)
+      {
+        EZ_TEST_BOOL(parallelEntries[i].m_hOwner == serialEntries[i].m_hOwner);
+        EZ_TEST_INT(parallelEntries[i].m_uiBatch, serialEntries[i].m_uiBatch);
+      }
+    }
+
+    uiTotalCount += parallelEntries.GetCount();
+  }
+
+  EZ_TEST_INT(uiTotalCount, uiNumObjects);
+
+  // every object must have been extracted exactly once per extraction
+  const ezWorld* pWorld = m_pWorld.Borrow();
+  EZ_LOCK(pWorld->GetReadMarker());
+  for (auto it = pWorld->GetComponentManager<ezExtractionTestComponentManager>()->GetComponents(); it.IsValid(); ++it)
+  {
+    EZ_TEST_INT(it->m_uiNumExtractions, 2);
+  }
+}
+
+void ezRendererCoreTestExtraction::TestRenderDataCache()
+{
+  CreateWorldAndView("RenderDataCache");
+
+  ezView* pView = nullptr;
+  ezRenderWorld::TryGetView(m_hView, pView);
+
+  ezGameObject* pObject = nullptr;
+  ezExtractionTestComponent* pComponent = nullptr;
+  {
+    EZ_LOCK(m_pWorld->GetWriteMarker());
+
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = false;
+    m_pWorld->CreateObject(desc, pObject);
+
+    m_pWorld->GetOrCreateComponentManager<ezExtractionTestComponentManager>()->CreateComponent(pObject, pComponent);
+    m_pWorld->Update();
+  }
+
+  ezDynamicArray<const ezGameObject*> visibleObjects;
+  visibleObjects.PushBack(pObject);
+
+  ezExtractedRenderData extractedRenderData;
+  ezDynamicArray<ExtractedEntry> entries;
+
+  auto GetCachedRenderData = [&]()
+  {
+    return ezRenderWorld::GetCachedRenderData(*pView, pObject->GetHandle(), pObject->GetComponentVersion());
+  };
+
+  // new cache entries are only applied at the end of the frame
+  Extract(visibleObjects, extractedRenderData);
+  EZ_TEST_INT(pComponent->m_uiNumExtractions, 1);
+  EZ_TEST_BOOL(GetCachedRenderData().IsEmpty());
+
+  ezRenderWorld::EndFrame();
+
+  if (!EZ_TEST_INT(GetCachedRenderData().GetCount(), 1))
+    return;
+
+  // the cached render data is used instead of asking the component again
+  Extract(visibleObjects, extractedRenderData);
+  EZ_TEST_INT(pComponent->m_uiNumExtractions, 1);
+
+  GetSortedEntries(extractedRenderData, ezDefaultRenderDataCategories::LitOpaque, entries);
+  if (EZ_TEST_INT(entries.GetCount(), 1))
+  {
+    EZ_TEST_BOOL(entries[0].m_pRenderData == GetCachedRenderData()[0].m_pRenderData);
+  }
+
+  // invalidating only marks the cache as outdated, the entries stay until the end of the frame
+  ezRenderWorld::DeleteCachedRenderDataForObject(pObject);
+  EZ_TEST_BOOL(GetCachedRenderData().IsEmpty());
+
+  Extract(visibleObjects, extractedRenderData);
+  EZ_TEST_INT(pComponent->m_uiNumExtractions, 2);
+
+  ezRenderWorld::EndFrame();
+  EZ_TEST_INT(GetCachedRenderData().GetCount(), 1);
+
+  // adding a component bumps the component version, which invalidates the cache as well
+  const ezUInt16 uiOldComponentVersion = pObject->GetComponentVersion();
+
+  ezExtractionTestComponent* pComponent2 = nullptr;
+  {
+    EZ_LOCK(m_pWorld->GetWriteMarker());
+    m_pWorld->GetOrCreateComponentManager<ezExtractionTestComponentManager>()->CreateComponent(pObject, pComponent2);
+    m_pWorld->Update();
+  }
+
+  EZ_TEST_BOOL(pObject->GetComponentVersion() != uiOldComponentVersion);
+  EZ_TEST_BOOL(GetCachedRenderData().IsEmpty());
+
+  Extract(visibleObjects, extractedRenderData);
+  EZ_TEST_INT(pComponent->m_uiNumExtractions, 3);
+  EZ_TEST_INT(pComponent2->m_uiNumExtractions, 1);
+
+  ezRenderWorld::EndFrame();
+  EZ_TEST_INT(GetCachedRenderData().GetCount(), 2);
+}
+
+void ezRendererCoreTestExtraction::CreateWorldAndView(const char* szName)
+{
+  ezWorldDesc worldDesc(szName);
+  m_pWorld = EZ_DEFAULT_NEW(ezWorld, worldDesc);
+
+  m_Camera.LookAt(ezVec3(-20, 0, 0), ezVec3::MakeZero(), ezVec3(0, 0, 1));
+  m_Camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 90.0f, 0.1f, 100.0f);
+
+  ezView* pView = nullptr;
+  m_hView = ezRenderWorld::CreateView(szName, pView);
+  pView->SetWorld(m_pWorld.Borrow());
+  pView->SetCamera(&m_Camera);
+}
+
+void ezRendererCoreTestExtraction::Extract(const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& out_extractedRenderData)
+{
+  ezView* pView = nullptr;
+  ezRenderWorld::TryGetView(m_hView, pView);
+
+  out_extractedRenderData.Clear();
+  out_extractedRenderData.SetCamera(m_Camera);
+
+  ezVisibleObjectsExtractor extractor;
+  extractor.Extract(*pView, visibleObjects, out_extractedRenderData);
+
+  out_extractedRenderData.SortAndBatch();
+}
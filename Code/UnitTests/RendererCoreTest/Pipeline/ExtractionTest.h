@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Core/World/World.h>
+#include <RendererCore/Components/RenderComponent.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCoreTest/TestClass/TestClass.h>
+
+class ezExtractionTestRenderData : public ezRenderData
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezExtractionTestRenderData, ezRenderData);
+};
+
+using ezExtractionTestComponentManager = ezComponentManager<class ezExtractionTestComponent, ezBlockStorageType::Compact>;
+
+/// \brief Extracts one ezExtractionTestRenderData with the configured category, batch id and sorting key and counts how often it was asked to.
+class ezExtractionTestComponent : public ezRenderComponent
+{
+  EZ_DECLARE_COMPONENT_TYPE(ezExtractionTestComponent, ezRenderComponent, ezExtractionTestComponentManager);
+
+public:
+  ezExtractionTestComponent();
+  ~ezExtractionTestComponent();
+
+  virtual ezResult GetLocalBounds(ezBoundingBoxSphere& ref_bounds, bool& ref_bAlwaysVisible, ezMsgUpdateLocalBounds& ref_msg) override;
+
+  ezRenderData::Category m_Category;
+  ezUInt32 m_uiBatchId = 0;
+  ezUInt32 m_uiSortingKey = 0;
+
+  mutable ezUInt32 m_uiNumExtractions = 0;
+
+protected:
+  void OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const;
+};
+
+class ezRendererCoreTestExtraction : public ezNullDeviceTest
+{
+public:
+  virtual const char* GetTestName() const override { return "Extraction"; }
+
+private:
+  enum SubTests
+  {
+    ST_MergeRenderData,
+    ST_ParallelExtraction,
+    ST_RenderDataCache,
+  };
+
+  virtual void SetupSubTests() override;
+  virtual ezResult InitializeTest() override;
+  virtual ezResult DeInitializeTest() override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  void TestMergeRenderData();
+  void TestParallelExtraction();
+  void TestRenderDataCache();
+
+  void CreateWorldAndView(const char* szName);
+  void Extract(const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& out_extractedRenderData);
+
+  ezUniquePtr<ezWorld> m_pWorld;
+  ezViewHandle m_hView;
+  ezCamera m_Camera;
+};
@@ -0,0 +1 @@
+#include <RendererCoreTest/RendererCoreTestPCH.h>
@@ -0,0 +1,50 @@
+#include <RendererCoreTest/RendererCoreTestPCH.h>
+
+#include <Foundation/Configuration/Plugin.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <RendererCore/ShaderCompiler/ShaderManager.h>
+#include <RendererCoreTest/TestClass/TestClass.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+
+ezResult ezNullDeviceTest::SetupRenderer()
+{
+  ezStartup::StartupCoreSystems();
+
+  // Only inline functions of the null device are used by the tests, so its library has to be loaded explicitly to register the device factory.
+  EZ_SUCCEED_OR_RETURN(ezPlugin::LoadPlugin("ezRendererNull"));
+
+  // The render context needs the shader permutation variables of the base data directory.
+  EZ_SUCCEED_OR_RETURN(ezFileSystem::AddDataDirectory(">sdk/Data/Base/", "NullDeviceTest"));
+
+  const char* szShaderModel = "";
+  const char* szShaderCompiler = "";
+  ezGALDeviceFactory::GetShaderModelAndCompiler("Null", szShaderModel, szShaderCompiler);
+  ezShaderManager::Configure(szShaderModel, false);
+
+  ezGALDeviceCreationDescription deviceInit;
+  m_pDevice = ezGALDeviceFactory::CreateDevice("Null", ezFoundation::GetDefaultAllocator(), deviceInit);
+  if (m_pDevice == nullptr || m_pDevice->Init().Failed())
+    return EZ_FAILURE;
+
+  ezGALDevice::SetDefaultDevice(m_pDevice);
+
+  ezStartup::StartupHighLevelSystems();
+  return EZ_SUCCESS;
+}
+
+void ezNullDeviceTest::ShutdownRenderer()
+{
+  ezStartup::ShutdownHighLevelSystems();
+  ezResourceManager::FreeAllUnusedResources();
+
+  if (m_pDevice)
+  {
+    m_pDevice->Shutdown().IgnoreResult();
+    EZ_DEFAULT_DELETE(m_pDevice);
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("NullDeviceTest");
+
+  ezStartup::ShutdownCoreSystems();
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <RendererFoundation/Device/Device.h>
+#include <TestFramework/Framework/TestBaseClass.h>
+
+/// \brief Base class for tests that need the renderer but don't look at the rendered images.
+///
+/// Uses the null device, which doesn't need a GPU, so these tests also run on headless machines.
+class ezNullDeviceTest : public ezTestBaseClass
+{
+protected:
+  /// \brief Starts up the engine with the null device as the default device.
+  ezResult SetupRenderer();
+
+  /// \brief Shuts down everything that SetupRenderer() has started. Can also be called if SetupRenderer() failed.
+  void ShutdownRenderer();
+
+  ezGALDevice* m_pDevice = nullptr;
+};
@@ -0,0 +1,640 @@
+# Generated by CMake
+
+if("${CMAKE_MAJOR_VERSION}.${CMAKE_MINOR_VERSION}" LESS 2.8)
+   message(FATAL_ERROR "CMake >= 2.8.0 required")
+endif()
+if(CMAKE_VERSION VERSION_LESS "2.8.3")
+   message(FATAL_ERROR "CMake >= 2.8.3 required")
+endif()
+cmake_policy(PUSH)
+cmake_policy(VERSION 2.8.3...3.23)
+#----------------------------------------------------------------
+# Generated CMake target import file.
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Protect against multiple inclusion, which would fail when already imported targets are added once more.
+set(_cmake_targets_defined "")
+set(_cmake_targets_not_defined "")
+set(_cmake_expected_targets "")
+foreach(_cmake_expected_target IN ITEMS Duktape Imgui Jolt Kraut Lua Recast lunasvg RmlCore enet meshoptimizer mikktspace ozz stb_image tinyexr zlib zstd Core Foundation GameEngine RendererCore RendererFoundation RendererNull Texture Utilities AiPlugin FileservePlugin GameComponentsPlugin InspectorPlugin JoltCooking JoltPlugin KrautPlugin ParticlePlugin ProcGenPlugin RecastPlugin RmlUiPlugin TypeScriptPlugin VisualScriptPlugin)
+  list(APPEND _cmake_expected_targets "${_cmake_expected_target}")
+  if(TARGET "${_cmake_expected_target}")
+    list(APPEND _cmake_targets_defined "${_cmake_expected_target}")
+  else()
+    list(APPEND _cmake_targets_not_defined "${_cmake_expected_target}")
+  endif()
+endforeach()
+unset(_cmake_expected_target)
+if(_cmake_targets_defined STREQUAL _cmake_expected_targets)
+  unset(_cmake_targets_defined)
+  unset(_cmake_targets_not_defined)
+  unset(_cmake_expected_targets)
+  unset(CMAKE_IMPORT_FILE_VERSION)
+  cmake_policy(POP)
+  return()
+endif()
+if(NOT _cmake_targets_defined STREQUAL "")
+  string(REPLACE ";" ", " _cmake_targets_defined_text "${_cmake_targets_defined}")
+  string(REPLACE ";" ", " _cmake_targets_not_defined_text "${_cmake_targets_not_defined}")
+  message(FATAL_ERROR "Some (but not all) targets in this export set were already defined.\nTargets Defined: ${_cmake_targets_defined_text}\nTargets not yet defined: ${_cmake_targets_not_defined_text}\n")
+endif()
+unset(_cmake_targets_defined)
+unset(_cmake_targets_not_defined)
+unset(_cmake_expected_targets)
+
+
+# Create imported target Duktape
+add_library(Duktape SHARED IMPORTED)
+
+set_target_properties(Duktape PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_DUKTAPE_SUPPORT"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+)
+
+# Create imported target Imgui
+add_library(Imgui SHARED IMPORTED)
+
+set_target_properties(Imgui PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_IMGUI_SUPPORT"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+)
+
+# Create imported target Jolt
+add_library(Jolt SHARED IMPORTED)
+
+set_target_properties(Jolt PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;JPH_SHARED_LIBRARY;BUILDSYSTEM_ENABLE_JOLT_SUPPORT;JPH_DEBUG_RENDERER"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty;/root/repo/Code/ThirdParty/Jolt"
+)
+
+# Create imported target Kraut
+add_library(Kraut STATIC IMPORTED)
+
+set_target_properties(Kraut PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty;/root/repo/Code/ThirdParty/Kraut"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:pthread>;\$<LINK_ONLY:rt>;\$<LINK_ONLY:c>;\$<LINK_ONLY:m>;\$<LINK_ONLY:-lgcc_s>;\$<LINK_ONLY:-lgcc>"
+)
+
+# Create imported target Lua
+add_library(Lua SHARED IMPORTED)
+
+set_target_properties(Lua PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_LUA_SUPPORT"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+)
+
+# Create imported target Recast
+add_library(Recast SHARED IMPORTED)
+
+set_target_properties(Recast PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_RECAST_SUPPORT"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty;/root/repo/Code/ThirdParty/Recast/Recast/Include;/root/repo/Code/ThirdParty/Recast/Detour/Include;/root/repo/Code/ThirdParty/Recast/DetourTileCache/Include;/root/repo/Code/ThirdParty/Recast/DetourCrowd/Include"
+)
+
+# Create imported target lunasvg
+add_library(lunasvg STATIC IMPORTED)
+
+set_target_properties(lunasvg PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty/RmlUi/Dependencies;/root/repo/Code/ThirdParty/RmlUi/Dependencies/lunasvg/include"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:pthread>;\$<LINK_ONLY:rt>;\$<LINK_ONLY:c>;\$<LINK_ONLY:m>;\$<LINK_ONLY:-lgcc_s>;\$<LINK_ONLY:-lgcc>"
+)
+
+# Create imported target RmlCore
+add_library(RmlCore SHARED IMPORTED)
+
+set_target_properties(RmlCore PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_RMLUI_SUPPORT;RMLUI_USE_CUSTOM_RTTI"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty/RmlUi/Source;/root/repo/Code/ThirdParty/RmlUi/Source/Core/../../Include"
+)
+
+# Create imported target enet
+add_library(enet SHARED IMPORTED)
+
+set_target_properties(enet PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_ENET_SUPPORT"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+)
+
+# Create imported target meshoptimizer
+add_library(meshoptimizer STATIC IMPORTED)
+
+set_target_properties(meshoptimizer PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:pthread>;\$<LINK_ONLY:rt>;\$<LINK_ONLY:c>;\$<LINK_ONLY:m>;\$<LINK_ONLY:-lgcc_s>;\$<LINK_ONLY:-lgcc>"
+)
+
+# Create imported target mikktspace
+add_library(mikktspace STATIC IMPORTED)
+
+set_target_properties(mikktspace PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:pthread>;\$<LINK_ONLY:rt>;\$<LINK_ONLY:c>;\$<LINK_ONLY:m>;\$<LINK_ONLY:-lgcc_s>;\$<LINK_ONLY:-lgcc>"
+)
+
+# Create imported target ozz
+add_library(ozz SHARED IMPORTED)
+
+set_target_properties(ozz PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_OZZ_SUPPORT"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+)
+
+# Create imported target stb_image
+add_library(stb_image SHARED IMPORTED)
+
+set_target_properties(stb_image PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+)
+
+# Create imported target tinyexr
+add_library(tinyexr STATIC IMPORTED)
+
+set_target_properties(tinyexr PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:pthread>;\$<LINK_ONLY:rt>;\$<LINK_ONLY:c>;\$<LINK_ONLY:m>;\$<LINK_ONLY:-lgcc_s>;\$<LINK_ONLY:-lgcc>"
+)
+
+# Create imported target zlib
+add_library(zlib STATIC IMPORTED)
+
+set_target_properties(zlib PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_ZLIB_SUPPORT"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:pthread>;\$<LINK_ONLY:rt>;\$<LINK_ONLY:c>;\$<LINK_ONLY:m>;\$<LINK_ONLY:-lgcc_s>;\$<LINK_ONLY:-lgcc>"
+)
+
+# Create imported target zstd
+add_library(zstd SHARED IMPORTED)
+
+set_target_properties(zstd PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_ENABLE_ZSTD_SUPPORT"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/ThirdParty"
+)
+
+# Create imported target Core
+add_library(Core SHARED IMPORTED)
+
+set_target_properties(Core PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/Engine"
+  INTERFACE_LINK_LIBRARIES "Foundation;Texture;Lua;Duktape"
+)
+
+# Create imported target Foundation
+add_library(Foundation SHARED IMPORTED)
+
+set_target_properties(Foundation PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/Engine"
+  INTERFACE_LINK_LIBRARIES "enet;zstd;zlib"
+)
+
+# Create imported target GameEngine
+add_library(GameEngine SHARED IMPORTED)
+
+set_target_properties(GameEngine PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/Engine"
+  INTERFACE_LINK_LIBRARIES "RendererCore;ozz;Utilities;Imgui"
+)
+
+# Create imported target RendererCore
+add_library(RendererCore SHARED IMPORTED)
+
+set_target_properties(RendererCore PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/Engine"
+  INTERFACE_LINK_LIBRARIES "Core;RendererFoundation;Texture"
+)
+
+# Create imported target RendererFoundation
+add_library(RendererFoundation SHARED IMPORTED)
+
+set_target_properties(RendererFoundation PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/Engine"
+  INTERFACE_LINK_LIBRARIES "Foundation"
+)
+
+# Create imported target RendererNull
+add_library(RendererNull SHARED IMPORTED)
+
+set_target_properties(RendererNull PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/Engine"
+  INTERFACE_LINK_LIBRARIES "Foundation;RendererFoundation"
+)
+
+# Create imported target Texture
+add_library(Texture SHARED IMPORTED)
+
+set_target_properties(Texture PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE;BUILDSYSTEM_HAS_TEXTURE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/Engine"
+  INTERFACE_LINK_LIBRARIES "Foundation"
+)
+
+# Create imported target Utilities
+add_library(Utilities SHARED IMPORTED)
+
+set_target_properties(Utilities PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/Engine"
+  INTERFACE_LINK_LIBRARIES "Core"
+)
+
+# Create imported target AiPlugin
+add_library(AiPlugin SHARED IMPORTED)
+
+set_target_properties(AiPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "Recast;GameEngine"
+)
+
+# Create imported target FileservePlugin
+add_library(FileservePlugin SHARED IMPORTED)
+
+set_target_properties(FileservePlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "Foundation"
+)
+
+# Create imported target GameComponentsPlugin
+add_library(GameComponentsPlugin SHARED IMPORTED)
+
+set_target_properties(GameComponentsPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "GameEngine"
+)
+
+# Create imported target InspectorPlugin
+add_library(InspectorPlugin SHARED IMPORTED)
+
+set_target_properties(InspectorPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+)
+
+# Create imported target JoltCooking
+add_library(JoltCooking SHARED IMPORTED)
+
+set_target_properties(JoltCooking PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "Core;Jolt"
+)
+
+# Create imported target JoltPlugin
+add_library(JoltPlugin SHARED IMPORTED)
+
+set_target_properties(JoltPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "GameEngine;Jolt"
+)
+
+# Create imported target KrautPlugin
+add_library(KrautPlugin SHARED IMPORTED)
+
+set_target_properties(KrautPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "GameEngine;Utilities;Kraut"
+)
+
+# Create imported target ParticlePlugin
+add_library(ParticlePlugin SHARED IMPORTED)
+
+set_target_properties(ParticlePlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "GameEngine"
+)
+
+# Create imported target ProcGenPlugin
+add_library(ProcGenPlugin SHARED IMPORTED)
+
+set_target_properties(ProcGenPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "GameEngine"
+)
+
+# Create imported target RecastPlugin
+add_library(RecastPlugin SHARED IMPORTED)
+
+set_target_properties(RecastPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "Recast;GameEngine"
+)
+
+# Create imported target RmlUiPlugin
+add_library(RmlUiPlugin SHARED IMPORTED)
+
+set_target_properties(RmlUiPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "GameEngine;RmlCore"
+)
+
+# Create imported target TypeScriptPlugin
+add_library(TypeScriptPlugin SHARED IMPORTED)
+
+set_target_properties(TypeScriptPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "Core;RendererCore;GameEngine"
+)
+
+# Create imported target VisualScriptPlugin
+add_library(VisualScriptPlugin SHARED IMPORTED)
+
+set_target_properties(VisualScriptPlugin PROPERTIES
+  INTERFACE_COMPILE_DEFINITIONS "BUILDSYSTEM_COMPILE_ENGINE_AS_DLL;BUILDSYSTEM_BUILDTYPE_\$<IF:\$<STREQUAL:Dev,Debug>,Debug,\$<IF:\$<STREQUAL:Dev,Dev>,Dev,Shipping>>;UNICODE;_UNICODE"
+  INTERFACE_INCLUDE_DIRECTORIES "/root/repo/Code/EnginePlugins"
+  INTERFACE_LINK_LIBRARIES "Core"
+)
+
+# Import target "Duktape" for configuration "Dev"
+set_property(TARGET Duktape APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Duktape PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/Duktape.so"
+  IMPORTED_SONAME_DEV "Duktape.so"
+  )
+
+# Import target "Imgui" for configuration "Dev"
+set_property(TARGET Imgui APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Imgui PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/Imgui.so"
+  IMPORTED_SONAME_DEV "Imgui.so"
+  )
+
+# Import target "Jolt" for configuration "Dev"
+set_property(TARGET Jolt APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Jolt PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/Jolt.so"
+  IMPORTED_SONAME_DEV "Jolt.so"
+  )
+
+# Import target "Kraut" for configuration "Dev"
+set_property(TARGET Kraut APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Kraut PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "CXX"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Lib/LinuxMakeGccDev64/Kraut.a"
+  )
+
+# Import target "Lua" for configuration "Dev"
+set_property(TARGET Lua APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Lua PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/Lua.so"
+  IMPORTED_SONAME_DEV "Lua.so"
+  )
+
+# Import target "Recast" for configuration "Dev"
+set_property(TARGET Recast APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Recast PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/Recast.so"
+  IMPORTED_SONAME_DEV "Recast.so"
+  )
+
+# Import target "lunasvg" for configuration "Dev"
+set_property(TARGET lunasvg APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(lunasvg PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "C;CXX"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Lib/LinuxMakeGccDev64/lunasvg.a"
+  )
+
+# Import target "RmlCore" for configuration "Dev"
+set_property(TARGET RmlCore APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(RmlCore PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/RmlCore.so"
+  IMPORTED_SONAME_DEV "RmlCore.so"
+  )
+
+# Import target "enet" for configuration "Dev"
+set_property(TARGET enet APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(enet PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/enet.so"
+  IMPORTED_SONAME_DEV "enet.so"
+  )
+
+# Import target "meshoptimizer" for configuration "Dev"
+set_property(TARGET meshoptimizer APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(meshoptimizer PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "CXX"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Lib/LinuxMakeGccDev64/meshoptimizer.a"
+  )
+
+# Import target "mikktspace" for configuration "Dev"
+set_property(TARGET mikktspace APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(mikktspace PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "C"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Lib/LinuxMakeGccDev64/mikktspace.a"
+  )
+
+# Import target "ozz" for configuration "Dev"
+set_property(TARGET ozz APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(ozz PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ozz.so"
+  IMPORTED_SONAME_DEV "ozz.so"
+  )
+
+# Import target "stb_image" for configuration "Dev"
+set_property(TARGET stb_image APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(stb_image PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/stb_image.so"
+  IMPORTED_SONAME_DEV "stb_image.so"
+  )
+
+# Import target "tinyexr" for configuration "Dev"
+set_property(TARGET tinyexr APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(tinyexr PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "C;CXX"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Lib/LinuxMakeGccDev64/tinyexr.a"
+  )
+
+# Import target "zlib" for configuration "Dev"
+set_property(TARGET zlib APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(zlib PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEV "C"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Lib/LinuxMakeGccDev64/zlib.a"
+  )
+
+# Import target "zstd" for configuration "Dev"
+set_property(TARGET zstd APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(zstd PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/zstd.so"
+  IMPORTED_SONAME_DEV "zstd.so"
+  )
+
+# Import target "Core" for configuration "Dev"
+set_property(TARGET Core APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Core PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezCore.so"
+  IMPORTED_SONAME_DEV "ezCore.so"
+  )
+
+# Import target "Foundation" for configuration "Dev"
+set_property(TARGET Foundation APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Foundation PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezFoundation.so"
+  IMPORTED_SONAME_DEV "ezFoundation.so"
+  )
+
+# Import target "GameEngine" for configuration "Dev"
+set_property(TARGET GameEngine APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(GameEngine PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezGameEngine.so"
+  IMPORTED_SONAME_DEV "ezGameEngine.so"
+  )
+
+# Import target "RendererCore" for configuration "Dev"
+set_property(TARGET RendererCore APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(RendererCore PROPERTIES
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_DEV "ozz"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezRendererCore.so"
+  IMPORTED_SONAME_DEV "ezRendererCore.so"
+  )
+
+# Import target "RendererFoundation" for configuration "Dev"
+set_property(TARGET RendererFoundation APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(RendererFoundation PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezRendererFoundation.so"
+  IMPORTED_SONAME_DEV "ezRendererFoundation.so"
+  )
+
+# Import target "RendererNull" for configuration "Dev"
+set_property(TARGET RendererNull APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(RendererNull PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezRendererNull.so"
+  IMPORTED_SONAME_DEV "ezRendererNull.so"
+  )
+
+# Import target "Texture" for configuration "Dev"
+set_property(TARGET Texture APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Texture PROPERTIES
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_DEV "stb_image"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezTexture.so"
+  IMPORTED_SONAME_DEV "ezTexture.so"
+  )
+
+# Import target "Utilities" for configuration "Dev"
+set_property(TARGET Utilities APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(Utilities PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezUtilities.so"
+  IMPORTED_SONAME_DEV "ezUtilities.so"
+  )
+
+# Import target "AiPlugin" for configuration "Dev"
+set_property(TARGET AiPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(AiPlugin PROPERTIES
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_DEV "Utilities"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezAiPlugin.so"
+  IMPORTED_SONAME_DEV "ezAiPlugin.so"
+  )
+
+# Import target "FileservePlugin" for configuration "Dev"
+set_property(TARGET FileservePlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(FileservePlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezFileservePlugin.so"
+  IMPORTED_SONAME_DEV "ezFileservePlugin.so"
+  )
+
+# Import target "GameComponentsPlugin" for configuration "Dev"
+set_property(TARGET GameComponentsPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(GameComponentsPlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezGameComponentsPlugin.so"
+  IMPORTED_SONAME_DEV "ezGameComponentsPlugin.so"
+  )
+
+# Import target "InspectorPlugin" for configuration "Dev"
+set_property(TARGET InspectorPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(InspectorPlugin PROPERTIES
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_DEV "Core"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezInspectorPlugin.so"
+  IMPORTED_SONAME_DEV "ezInspectorPlugin.so"
+  )
+
+# Import target "JoltCooking" for configuration "Dev"
+set_property(TARGET JoltCooking APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(JoltCooking PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezJoltCooking.so"
+  IMPORTED_SONAME_DEV "ezJoltCooking.so"
+  )
+
+# Import target "JoltPlugin" for configuration "Dev"
+set_property(TARGET JoltPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(JoltPlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezJoltPlugin.so"
+  IMPORTED_SONAME_DEV "ezJoltPlugin.so"
+  )
+
+# Import target "KrautPlugin" for configuration "Dev"
+set_property(TARGET KrautPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(KrautPlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezKrautPlugin.so"
+  IMPORTED_SONAME_DEV "ezKrautPlugin.so"
+  )
+
+# Import target "ParticlePlugin" for configuration "Dev"
+set_property(TARGET ParticlePlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(ParticlePlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezParticlePlugin.so"
+  IMPORTED_SONAME_DEV "ezParticlePlugin.so"
+  )
+
+# Import target "ProcGenPlugin" for configuration "Dev"
+set_property(TARGET ProcGenPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(ProcGenPlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezProcGenPlugin.so"
+  IMPORTED_SONAME_DEV "ezProcGenPlugin.so"
+  )
+
+# Import target "RecastPlugin" for configuration "Dev"
+set_property(TARGET RecastPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(RecastPlugin PROPERTIES
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_DEV "Utilities"
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezRecastPlugin.so"
+  IMPORTED_SONAME_DEV "ezRecastPlugin.so"
+  )
+
+# Import target "RmlUiPlugin" for configuration "Dev"
+set_property(TARGET RmlUiPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(RmlUiPlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezRmlUiPlugin.so"
+  IMPORTED_SONAME_DEV "ezRmlUiPlugin.so"
+  )
+
+# Import target "TypeScriptPlugin" for configuration "Dev"
+set_property(TARGET TypeScriptPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(TypeScriptPlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezTypeScriptPlugin.so"
+  IMPORTED_SONAME_DEV "ezTypeScriptPlugin.so"
+  )
+
+# Import target "VisualScriptPlugin" for configuration "Dev"
+set_property(TARGET VisualScriptPlugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEV)
+set_target_properties(VisualScriptPlugin PROPERTIES
+  IMPORTED_LOCATION_DEV "/root/repo/Output/Bin/LinuxMakeGccDev64/ezVisualScriptPlugin.so"
+  IMPORTED_SONAME_DEV "ezVisualScriptPlugin.so"
+  )
+
+# This file does not depend on other imported targets which have
+# been exported from the same project but in a separate export set.
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
+cmake_policy(POP)
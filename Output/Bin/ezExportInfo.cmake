@@ -0,0 +1,5 @@
+
+set(EXPINP_OUTPUT_DIRECTORY_DLL /root/repo/Output/Bin)
+set(EXPINP_OUTPUT_DIRECTORY_LIB /root/repo/Output/Lib)
+set(EXPINP_BINARY_DIR /tmp/ezb)
+set(EXPINP_SOURCE_DIR /root/repo)